@@ -0,0 +1,411 @@
+/*******************************************************************************
+*************************keySTREAM Trusted Agent ("KTA")************************
+
+* (c) 2023-2025 Nagravision Sàrl
+
+* Subject to your compliance with these terms, you may use the Nagravision Sàrl
+* Software and any derivatives exclusively with Nagravision's products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may accompany
+* Nagravision Software.
+
+* Redistribution of this Nagravision Software in source or binary form is allowed
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+
+* THIS SOFTWARE IS SUPPLIED BY NAGRAVISION "AS IS". NO WARRANTIES, WHETHER EXPRESS,
+* IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF
+* NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE. IN NO
+* EVENT WILL NAGRAVISION BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL
+* OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF NAGRAVISION HAS BEEN ADVISED OF THE
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW,
+* NAGRAVISION 'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS
+* SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY
+* TO NAGRAVISION FOR THIS SOFTWARE.
+********************************************************************************/
+/** \brief keySTREAM Trusted Agent - Benchmark probe module.
+ *
+ *  \author Kudelski IoT
+ *
+ *  \date 2026/10/17
+ *
+ *  \file KTABench.c
+ ******************************************************************************/
+/**
+ * @brief keySTREAM Trusted Agent Benchmark probe module.
+ */
+
+#include "KTABench.h"
+/* -------------------------------------------------------------------------- */
+/* IMPORTS                                                                    */
+/* -------------------------------------------------------------------------- */
+#ifdef BENCHMARK_FEATURE
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL CONSTANTS, TYPES, ENUM                                               */
+/* -------------------------------------------------------------------------- */
+/** @brief Nanoseconds per second. */
+#define C_KTABENCH__NSEC_PER_SEC       (1000000000ull)
+
+/** @brief Nanoseconds per microsecond. */
+#define C_KTABENCH__NSEC_PER_USEC      (1000ull)
+
+/** @brief Percentiles reported. */
+#define C_KTABENCH__P50                (50u)
+#define C_KTABENCH__P99                (99u)
+
+/** @brief Start mark of a phase on one thread. */
+typedef struct
+{
+  uint64_t  wallStart;
+  /* Monotonic clock at phase start, in nanoseconds. */
+  uint64_t  cpuStart;
+  /* Thread CPU clock at phase start, in nanoseconds. */
+  bool      isStarted;
+  /* Phase is being timed. */
+} TKtaBenchMark;
+
+/** @brief Samples of one phase. */
+typedef struct
+{
+  uint64_t  aWall[C_KTABENCH__MAX_SAMPLES];
+  /* Wall clock latencies, in nanoseconds. */
+  uint64_t  aCpu[C_KTABENCH__MAX_SAMPLES];
+  /* CPU times, in nanoseconds. */
+  uint64_t  cpuTotal;
+  /* CPU time of all samples recorded since reset, in nanoseconds. */
+  uint32_t  recorded;
+  /* Samples recorded since reset, the ring holds the latest ones. */
+} TKtaBenchSamples;
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL VARIABLES                                                            */
+/* -------------------------------------------------------------------------- */
+/** @brief Protects the sample rings and the scratch buffer. */
+static pthread_mutex_t gBenchLock = PTHREAD_MUTEX_INITIALIZER;
+
+/** @brief Sample rings, one per phase. */
+static TKtaBenchSamples gaBenchSamples[E_KTABENCH_PHASE_COUNT];
+
+/** @brief Sort buffer used to compute the percentiles. */
+static uint64_t gaBenchScratch[C_KTABENCH__MAX_SAMPLES];
+
+/** @brief Phase start marks of the calling thread. */
+static C_KTA_APP__THREAD_LOCAL TKtaBenchMark gaBenchMarks[E_KTABENCH_PHASE_COUNT];
+
+/** @brief Printable phase names. */
+static const char* const gaBenchPhaseNames[E_KTABENCH_PHASE_COUNT] =
+{
+  "HANDSHAKE",
+  "STARTUP",
+  "EXCHANGE",
+  "TRANSPORT",
+  "ACT_REQUEST",
+  "KEY_DERIVATION",
+  "REGISTRATION",
+  "COMMAND",
+  "NVM_WRITE",
+  "PARSE"
+};
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL FUNCTIONS - PROTOTYPE                                                */
+/* -------------------------------------------------------------------------- */
+/**
+ * @brief Read a clock in nanoseconds.
+ *
+ * @param[in] xClock
+ *   Clock to read.
+ *
+ * @return
+ * - Clock value in nanoseconds, 0 if the clock is not available.
+ */
+static uint64_t lBenchNow
+(
+  clockid_t  xClock
+);
+
+/**
+ * @brief Compare two samples for qsort.
+ *
+ * @param[in] xpLeft
+ *   First sample.
+ * @param[in] xpRight
+ *   Second sample.
+ *
+ * @return
+ * - Negative, zero or positive as for qsort.
+ */
+static int lBenchCompare
+(
+  const void*  xpLeft,
+  const void*  xpRight
+);
+
+/**
+ * @brief Sort samples into the scratch buffer and compute the percentiles.
+ *
+ * @param[in] xpSamples
+ *   Samples to sort, in nanoseconds.
+ * @param[in] xCount
+ *   Number of samples, not 0.
+ * @param[out] xpP50
+ *   Median, in microseconds.
+ * @param[out] xpP99
+ *   99th percentile, in microseconds.
+ * @param[out] xpMax
+ *   Maximum, in microseconds.
+ */
+static void lBenchPercentiles
+(
+  const uint64_t*  xpSamples,
+  uint32_t         xCount,
+  uint64_t*        xpP50,
+  uint64_t*        xpP99,
+  uint64_t*        xpMax
+);
+
+/**
+ * @brief Nearest rank index of a percentile in a sorted set.
+ *
+ * @param[in] xCount
+ *   Number of samples, not 0.
+ * @param[in] xPercent
+ *   Percentile, 1 to 100.
+ *
+ * @return
+ * - Index of the percentile.
+ */
+static uint32_t lBenchRank
+(
+  uint32_t  xCount,
+  uint32_t  xPercent
+);
+
+/* -------------------------------------------------------------------------- */
+/* PUBLIC VARIABLES                                                           */
+/* -------------------------------------------------------------------------- */
+
+/* -------------------------------------------------------------------------- */
+/* PUBLIC FUNCTIONS - IMPLEMENTATION                                          */
+/* -------------------------------------------------------------------------- */
+/**
+ * @brief  implement ktaBench_Start
+ *
+ */
+void ktaBench_Start
+(
+  TKtaBenchPhase  xPhase
+)
+{
+  if ((unsigned int)xPhase < (unsigned int)E_KTABENCH_PHASE_COUNT)
+  {
+    gaBenchMarks[xPhase].isStarted = true;
+    gaBenchMarks[xPhase].cpuStart  = lBenchNow(CLOCK_THREAD_CPUTIME_ID);
+    gaBenchMarks[xPhase].wallStart = lBenchNow(CLOCK_MONOTONIC);
+  }
+}
+
+/**
+ * @brief  implement ktaBench_End
+ *
+ */
+void ktaBench_End
+(
+  TKtaBenchPhase  xPhase
+)
+{
+  uint64_t wallEnd = lBenchNow(CLOCK_MONOTONIC);
+  uint64_t cpuEnd  = lBenchNow(CLOCK_THREAD_CPUTIME_ID);
+  TKtaBenchSamples* pSamples = NULL;
+  uint32_t slot = 0;
+
+  if (((unsigned int)xPhase < (unsigned int)E_KTABENCH_PHASE_COUNT) &&
+      (gaBenchMarks[xPhase].isStarted))
+  {
+    gaBenchMarks[xPhase].isStarted = false;
+    pSamples = &gaBenchSamples[xPhase];
+
+    (void)pthread_mutex_lock(&gBenchLock);
+    slot = pSamples->recorded % C_KTABENCH__MAX_SAMPLES;
+    pSamples->aWall[slot] = wallEnd - gaBenchMarks[xPhase].wallStart;
+    pSamples->aCpu[slot]  = cpuEnd - gaBenchMarks[xPhase].cpuStart;
+    pSamples->cpuTotal   += pSamples->aCpu[slot];
+    pSamples->recorded++;
+    (void)pthread_mutex_unlock(&gBenchLock);
+  }
+  else if ((unsigned int)xPhase < (unsigned int)E_KTABENCH_PHASE_COUNT)
+  {
+    gaBenchMarks[xPhase].isStarted = false;
+  }
+  else
+  {
+    /* Unknown phase, nothing to record. */
+  }
+}
+
+/**
+ * @brief  implement ktaBench_Reset
+ *
+ */
+void ktaBench_Reset
+(
+  void
+)
+{
+  (void)pthread_mutex_lock(&gBenchLock);
+  (void)memset(gaBenchSamples, 0, sizeof(gaBenchSamples));
+  (void)pthread_mutex_unlock(&gBenchLock);
+}
+
+/**
+ * @brief  implement ktaBench_GetReport
+ *
+ */
+int ktaBench_GetReport
+(
+  TKtaBenchPhase    xPhase,
+  TKtaBenchReport*  xpReport
+)
+{
+  TKtaBenchSamples* pSamples = NULL;
+  uint32_t count = 0;
+  uint64_t unused = 0;
+  int status = -1;
+
+  if (((unsigned int)xPhase < (unsigned int)E_KTABENCH_PHASE_COUNT) &&
+      (NULL != xpReport))
+  {
+    (void)memset(xpReport, 0, sizeof(TKtaBenchReport));
+    pSamples = &gaBenchSamples[xPhase];
+
+    (void)pthread_mutex_lock(&gBenchLock);
+    count = (pSamples->recorded < C_KTABENCH__MAX_SAMPLES) ?
+            pSamples->recorded : C_KTABENCH__MAX_SAMPLES;
+    if (0u != count)
+    {
+      xpReport->count    = count;
+      xpReport->cpuTotal = pSamples->cpuTotal / C_KTABENCH__NSEC_PER_USEC;
+      lBenchPercentiles(pSamples->aWall, count,
+                        &xpReport->wallP50, &xpReport->wallP99, &xpReport->wallMax);
+      lBenchPercentiles(pSamples->aCpu, count,
+                        &xpReport->cpuP50, &xpReport->cpuP99, &unused);
+    }
+    (void)pthread_mutex_unlock(&gBenchLock);
+    status = 0;
+  }
+
+  return status;
+}
+
+/**
+ * @brief  implement ktaBench_PhaseName
+ *
+ */
+const char* ktaBench_PhaseName
+(
+  TKtaBenchPhase  xPhase
+)
+{
+  const char* pName = "UNKNOWN";
+
+  if ((unsigned int)xPhase < (unsigned int)E_KTABENCH_PHASE_COUNT)
+  {
+    pName = gaBenchPhaseNames[xPhase];
+  }
+
+  return pName;
+}
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL FUNCTIONS - IMPLEMENTATION                                           */
+/* -------------------------------------------------------------------------- */
+/**
+ * @implements lBenchNow
+ *
+ */
+static uint64_t lBenchNow
+(
+  clockid_t  xClock
+)
+{
+  struct timespec now = {0};
+  uint64_t value = 0;
+
+  if (0 == clock_gettime(xClock, &now))
+  {
+    value = ((uint64_t)now.tv_sec * C_KTABENCH__NSEC_PER_SEC) + (uint64_t)now.tv_nsec;
+  }
+
+  return value;
+}
+
+/**
+ * @implements lBenchCompare
+ *
+ */
+static int lBenchCompare
+(
+  const void*  xpLeft,
+  const void*  xpRight
+)
+{
+  uint64_t left  = *(const uint64_t*)xpLeft;
+  uint64_t right = *(const uint64_t*)xpRight;
+
+  return (left > right) - (left < right);
+}
+
+/**
+ * @implements lBenchPercentiles
+ *
+ */
+static void lBenchPercentiles
+(
+  const uint64_t*  xpSamples,
+  uint32_t         xCount,
+  uint64_t*        xpP50,
+  uint64_t*        xpP99,
+  uint64_t*        xpMax
+)
+{
+  (void)memcpy(gaBenchScratch, xpSamples, xCount * sizeof(uint64_t));
+  qsort(gaBenchScratch, xCount, sizeof(uint64_t), lBenchCompare);
+
+  *xpP50 = gaBenchScratch[lBenchRank(xCount, C_KTABENCH__P50)] / C_KTABENCH__NSEC_PER_USEC;
+  *xpP99 = gaBenchScratch[lBenchRank(xCount, C_KTABENCH__P99)] / C_KTABENCH__NSEC_PER_USEC;
+  *xpMax = gaBenchScratch[xCount - 1u] / C_KTABENCH__NSEC_PER_USEC;
+}
+
+/**
+ * @implements lBenchRank
+ *
+ */
+static uint32_t lBenchRank
+(
+  uint32_t  xCount,
+  uint32_t  xPercent
+)
+{
+  /* Nearest rank: ceil(p * n / 100), one based. */
+  uint32_t rank = ((xPercent * xCount) + 99u) / 100u;
+
+  if (0u == rank)
+  {
+    rank = 1u;
+  }
+
+  return rank - 1u;
+}
+
+#endif /* BENCHMARK_FEATURE */
+
+/* -------------------------------------------------------------------------- */
+/* END OF FILE                                                                */
+/* -------------------------------------------------------------------------- */
@@ -42,7 +42,6 @@
 /* -------------------------------------------------------------------------- */
 #include "k_sal_log.h"
 
-#include <time.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -62,61 +61,49 @@
 /** @brief Maximum bytes to display per line. */
 #define C_LOG_COL_SIZE (32u)
 
-/** @brief Maximum module name size. */
-#define C_MAX_MODULE_NAME_SIZE (15u)
-
 /** @brief Maximum value size. */
 #define C_MAX_VALUE_SIZE (4u)
 
-/** @brief Maximum Modules for log */
-#define C_MAX_MODULES (17u)
-
 /** @brief MAximum Log Levels */
 #define C_MAX_LOG_LEVELS (6u)
 
+/** @brief Maximum size of one conversion specification, e.g. "%-08lld". */
+#define C_MAX_SPEC_SIZE (16u)
+
 /* -------------------------------------------------------------------------- */
 /* LOCAL VARIABLES                                                            */
 /* -------------------------------------------------------------------------- */
 
-/** @brief Module level config structure. */
-typedef struct {
-  char aModuleName[C_MAX_MODULE_NAME_SIZE];
-  int level;
-} moduleLevelConfig;
-
-/* Module level configs for each module. */
-static moduleLevelConfig gaLogConfigs[C_MAX_MODULES] = {
-  {"KTAMGR", LOG_KTA_ENABLE},
-  {"KTACONFIG", LOG_KTA_ENABLE},
-  {"KTAGENERAL", LOG_KTA_ENABLE},
-  {"KTACMDHANDLER", LOG_KTA_ENABLE},
-  {"KTAREGHANDLER", LOG_KTA_ENABLE},
-  {"KTAACTHANDLER", LOG_KTA_ENABLE},
-  {"KTACRYPTO", LOG_KTA_ENABLE},
-  {"KTAICPPPARSER", LOG_KTA_ENABLE},
-  {"SALSTORAGE", LOG_KTA_ENABLE},
-  {"SALCRYPTO", LOG_KTA_ENABLE},
-  {"SALOBJECT", LOG_KTA_ENABLE},
-  {"SALTHIRDPARTY", LOG_KTA_ENABLE},
-  {"SALFOTA", LOG_KTA_ENABLE},
-  {"FOTAAGENT", LOG_KTA_ENABLE},
-  {"FOTAPROCESS", LOG_KTA_ENABLE},
-  {"FOTAPLATFORM", LOG_KTA_ENABLE},
-  {"KSALFOTASTORAGE", LOG_KTA_ENABLE}
-};
-
 /** @brief Log event info structure. */
 typedef struct {
   va_list ap;
   const char *pFmt;
   const char *pFile;
   const char *pFunc;
-  struct tm *pTime;
   int line;
   int level;
 } logEvent;
 
-typedef void (*log_LogFn)(logEvent *ev);
+/** @brief Argument class of a conversion specification. */
+typedef enum
+{
+  E_LOG_ARG_NONE,
+  /* No argument consumed (%%). */
+  E_LOG_ARG_INT,
+  /* int or smaller. */
+  E_LOG_ARG_LONG,
+  /* long. */
+  E_LOG_ARG_LLONG,
+  /* long long. */
+  E_LOG_ARG_SIZE,
+  /* size_t. */
+  E_LOG_ARG_DOUBLE,
+  /* double. */
+  E_LOG_ARG_POINTER,
+  /* Pointer. */
+  E_LOG_ARG_STRING
+  /* String, copied into the record. */
+} TLogArgClass;
 
 /* Log levels */
 static const char *gapLevelStrings[C_MAX_LOG_LEVELS] = {
@@ -128,6 +115,14 @@ static const char *gapLevelStrings[C_MAX_LOG_LEVELS] = {
                                       "ERROR"
 };
 
+#ifdef LOG_KTA_BINARY
+/** @brief Binary log ring. */
+static TKtaLogRecord gaLogRing[C_KTALOG__RING_SIZE];
+
+/** @brief Sequence number of the next record. */
+static volatile uint32_t gLogNextSequence = 0u;
+#endif /* LOG_KTA_BINARY */
+
 /* -------------------------------------------------------------------------- */
 /* LOCAL FUNCTIONS - PROTOTYPE                                                */
 /* -------------------------------------------------------------------------- */
@@ -146,19 +141,64 @@ static void logPrepare
   logEvent *xpEv
 );
 
+#ifdef LOG_KTA_BINARY
 /**
  * @brief
- *   Initializes the log event by capturing the start time.
- *   This function is intended for internal use by the log API.
- *   It captures the start time of the log event.
+ *   Find the next conversion specification of a format string.
  *
- * @param[in] ev
- *   Pointer to the logEvent structure representing the log event.
+ * @param[in] xpFmt
+ *   Format string, positioned anywhere.
+ * @param[out] xppSpec
+ *   Start of the specification ('%'), NULL when there is none left.
+ * @param[out] xpSpecLen
+ *   Length of the specification.
+ * @param[out] xpArgClass
+ *   Class of the argument the specification consumes.
+ * @param[out] xpStarCount
+ *   Number of '*' width/precision int arguments consumed before the value.
+ */
+static void lLogNextSpec
+(
+  const char*   xpFmt,
+  const char**  xppSpec,
+  size_t*       xpSpecLen,
+  TLogArgClass* xpArgClass,
+  uint32_t*     xpStarCount
+);
+
+/**
+ * @brief
+ *   Copy a string argument into the strings area of a record.
+ *
+ * @param[in,out] xpRecord
+ *   Record being written.
+ * @param[in,out] xpUsed
+ *   Bytes of xpRecord->aStrings already used.
+ * @param[in] xpString
+ *   String to copy, truncated to the room left.
+ *
+ * @return
+ *   Offset of the copy in xpRecord->aStrings.
+ */
+static uint64_t lLogCopyString
+(
+  TKtaLogRecord* xpRecord,
+  size_t*        xpUsed,
+  const char*    xpString
+);
+
+/**
+ * @brief
+ *   Format one record of the binary log ring through salPrint.
+ *
+ * @param[in] xpRecord
+ *   Record to format.
  */
-static void initEvent
+static void lLogPrintRecord
 (
-  logEvent *xpEvent
+  const TKtaLogRecord* xpRecord
 );
+#endif /* LOG_KTA_BINARY */
 
 /* -------------------------------------------------------------------------- */
 /* PUBLIC VARIABLES                                                           */
@@ -183,17 +223,12 @@ void ktaLog_Fct
   ...
 )
 {
-  /* To fix the misra-c2012-15.5-A function should have a single point of exit at the end*/
-  bool bretvalue = true;
+  M_UNUSED(xpModuleName);
 
-  if ((xLevel < 0) || (xLevel > 5)) 
+  /* Module level is resolved at compile time by M_KTALOG__IS_ENABLED. */
+  if ((xLevel > 0) && (xLevel < (int)C_MAX_LOG_LEVELS))
   {
-    bretvalue = false;
-  }
-
-  if ( bretvalue )
-  {
-      logEvent ev = {
+    logEvent ev = {
       .pFmt   = xpFmt,
       .pFile  = xpFile, /* Name of the file from which log is triggered. */
       .pFunc = xpFunc,  /* Name of the function. */
@@ -203,26 +238,11 @@ void ktaLog_Fct
                         * keep 0 for debug and so on
                         */
     };
-    int moduleLogLevel = E_KTALOG_LEVEL_DEBUG;
 
-    for (int i = 0; i < (sizeof(gaLogConfigs) / sizeof(gaLogConfigs[0])); i++)
-    {
-      if (strncmp(gaLogConfigs[i].aModuleName, xpModuleName,
-          strlen(gaLogConfigs[i].aModuleName)) == 0)
-      {
-        moduleLogLevel = gaLogConfigs[i].level;
-        break;
-      }
-    }
-
-    if (xLevel >= moduleLogLevel)
-    {
-      initEvent(&ev);
-      va_start(ev.ap, xpFmt);
-      logPrepare(&ev);
-      va_end(ev.ap);
-    }
- }
+    va_start(ev.ap, xpFmt);
+    logPrepare(&ev);
+    va_end(ev.ap);
+  }
 
   return;
 }
@@ -247,6 +267,8 @@ void ktaLog_PrintBuffer
   int             xSize
 )
 {
+  M_UNUSED(xLevel);
+  M_UNUSED(xaModuleName);
   M_UNUSED(xpFile);
   M_UNUSED(xpFunc);
   M_UNUSED(xLine);
@@ -254,41 +276,173 @@ void ktaLog_PrintBuffer
   int Index = 0;
   char aValue[C_MAX_VALUE_SIZE] = {0};
   char aBuffer[C_MAX_BUFFER_SIZE] = {0};
-  int moduleLogLevel = E_KTALOG_LEVEL_DEBUG;
 
-  for (int i = 0; i < (sizeof(gaLogConfigs) / sizeof(gaLogConfigs[0])); i++)
+  snprintf(aBuffer, C_MAX_BUFFER_SIZE, "%s : [%d]\r\n", xpFmt, xSize);
+  salPrint(aBuffer);
+
+  for (Index = 0; Index < xSize; Index++)
   {
-    if (strncmp(gaLogConfigs[i].aModuleName, xaModuleName,
-        strlen(gaLogConfigs[i].aModuleName)) == 0)
+    snprintf(aValue, C_MAX_VALUE_SIZE, "%02X ", xpBuffer[Index]);
+    salPrint(aValue);
+    if ((Index % (int32_t)C_LOG_COL_SIZE) == (C_LOG_COL_SIZE - 1u))
     {
-      moduleLogLevel = gaLogConfigs[i].level;
-      break;
+      /* Line full. */
+      salPrint("\r\n");
     }
   }
+  if ((xSize % (int32_t)C_LOG_COL_SIZE) != 0)
+  {
+    /* Last line not full. */
+    salPrint("\r\n");
+  }
+  salPrint("\r\n");
+}
 
-  if (xLevel >= moduleLogLevel)
+#ifdef LOG_KTA_BINARY
+/**
+ * @brief implement ktaLog_Record
+ *
+ */
+void ktaLog_Record
+(
+  int         xLevel,
+  const char* xpModuleName,
+  int         xLine,
+  const char* xpFmt,
+  ...
+)
+{
+  va_list        ap;
+  TKtaLogRecord* pRecord = NULL;
+  const char*    pCursor = xpFmt;
+  const char*    pSpec = NULL;
+  size_t         specLen = 0;
+  TLogArgClass   argClass = E_LOG_ARG_NONE;
+  uint32_t       starCount = 0;
+  uint32_t       sequence = 0;
+  uint8_t        argCount = 0;
+  size_t         stringsUsed = 0;
+
+#if defined(__GNUC__)
+  sequence = __atomic_fetch_add(&gLogNextSequence, 1u, __ATOMIC_RELAXED);
+#else
+  sequence = gLogNextSequence;
+  gLogNextSequence = sequence + 1u;
+#endif
+  pRecord = &gaLogRing[sequence % C_KTALOG__RING_SIZE];
+
+  va_start(ap, xpFmt);
+  for (;;)
   {
-    snprintf(aBuffer, C_MAX_BUFFER_SIZE, "%s : [%d]\r\n", xpFmt, xSize);
-    salPrint(aBuffer);
+    lLogNextSpec(pCursor, &pSpec, &specLen, &argClass, &starCount);
+    if (pSpec == NULL)
+    {
+      break;
+    }
+    pCursor = pSpec + specLen;
+
+    for (; (starCount > 0u) && (argCount < C_KTALOG__MAX_ARGS); starCount--)
+    {
+      pRecord->aArgs[argCount] = (uint64_t)(int64_t)va_arg(ap, int);
+      argCount++;
+    }
+    if ((argClass == E_LOG_ARG_NONE) || (argCount >= C_KTALOG__MAX_ARGS))
+    {
+      continue;
+    }
 
-    for (Index = 0; Index < xSize; Index++)
+    switch (argClass)
     {
-      snprintf(aValue, C_MAX_VALUE_SIZE, "%02X ", xpBuffer[Index]);
-      salPrint(aValue);
-      if ((Index % (int32_t)C_LOG_COL_SIZE) == (C_LOG_COL_SIZE - 1u))
+      case E_LOG_ARG_LONG:
+        pRecord->aArgs[argCount] = (uint64_t)(int64_t)va_arg(ap, long);
+        break;
+
+      case E_LOG_ARG_LLONG:
+        pRecord->aArgs[argCount] = (uint64_t)va_arg(ap, long long);
+        break;
+
+      case E_LOG_ARG_SIZE:
+        pRecord->aArgs[argCount] = (uint64_t)va_arg(ap, size_t);
+        break;
+
+      case E_LOG_ARG_DOUBLE:
       {
-        /* Line full. */
-        salPrint("\r\n");
+        double value = va_arg(ap, double);
+
+        (void)memcpy(&pRecord->aArgs[argCount], &value, sizeof(value));
+        break;
       }
+
+      case E_LOG_ARG_POINTER:
+        pRecord->aArgs[argCount] = (uint64_t)(uintptr_t)va_arg(ap, const void*);
+        break;
+
+      case E_LOG_ARG_STRING:
+        pRecord->aArgs[argCount] = lLogCopyString(pRecord, &stringsUsed,
+                                                  va_arg(ap, const char*));
+        break;
+
+      default:
+        pRecord->aArgs[argCount] = (uint64_t)(int64_t)va_arg(ap, int);
+        break;
     }
-    if ((xSize % (int32_t)C_LOG_COL_SIZE) != 0)
+    argCount++;
+  }
+  va_end(ap);
+
+  pRecord->pFmt = xpFmt;
+  pRecord->pModuleName = xpModuleName;
+  pRecord->line = (uint16_t)xLine;
+  pRecord->level = (uint8_t)xLevel;
+  pRecord->argCount = argCount;
+  pRecord->sequence = sequence;
+}
+
+/**
+ * @brief implement ktaLog_GetRing
+ *
+ */
+const TKtaLogRecord* ktaLog_GetRing
+(
+  uint32_t* xpNextSequence
+)
+{
+  if (xpNextSequence != NULL)
+  {
+    *xpNextSequence = gLogNextSequence;
+  }
+  return gaLogRing;
+}
+
+/**
+ * @brief implement ktaLog_DumpRing
+ *
+ */
+void ktaLog_DumpRing
+(
+  void
+)
+{
+  uint32_t nextSequence = gLogNextSequence;
+  uint32_t sequence = 0;
+
+  if (nextSequence > C_KTALOG__RING_SIZE)
+  {
+    sequence = nextSequence - C_KTALOG__RING_SIZE;
+  }
+
+  for (; sequence != nextSequence; sequence++)
+  {
+    const TKtaLogRecord* pRecord = &gaLogRing[sequence % C_KTALOG__RING_SIZE];
+
+    /* Skip records being written or already overwritten. */
+    if ((pRecord->sequence == sequence) && (pRecord->pFmt != NULL))
     {
-      /* Last line not full. */
-      salPrint("\r\n");
+      lLogPrintRecord(pRecord);
     }
-    salPrint("\r\n");
   }
 }
+#endif /* LOG_KTA_BINARY */
 
 /* -------------------------------------------------------------------------- */
 /* LOCAL FUNCTIONS - IMPLEMENTATION                                           */
@@ -325,25 +479,262 @@ static void logPrepare
   salPrint("\r\n");
 }
 
+#ifdef LOG_KTA_BINARY
 /**
- * @implements initEvent
+ * @implements lLogNextSpec
  *
  */
+static void lLogNextSpec
+(
+  const char*   xpFmt,
+  const char**  xppSpec,
+  size_t*       xpSpecLen,
+  TLogArgClass* xpArgClass,
+  uint32_t*     xpStarCount
+)
+{
+  const char*  pSpec = strchr(xpFmt, '%');
+  const char*  pCursor = NULL;
+  TLogArgClass argClass = E_LOG_ARG_INT;
+  uint32_t     starCount = 0;
+
+  *xppSpec = pSpec;
+  *xpSpecLen = 0;
+  *xpArgClass = E_LOG_ARG_NONE;
+  *xpStarCount = 0;
+
+  if (pSpec != NULL)
+  {
+    /* Flags, width and precision. */
+    pCursor = pSpec + 1;
+    while ((*pCursor != '\0') && (strchr("-+ #0123456789.*", *pCursor) != NULL))
+    {
+      if (*pCursor == '*')
+      {
+        starCount++;
+      }
+      pCursor++;
+    }
+
+    /* Length modifier. */
+    if (*pCursor == 'l')
+    {
+      pCursor++;
+      argClass = E_LOG_ARG_LONG;
+      if (*pCursor == 'l')
+      {
+        pCursor++;
+        argClass = E_LOG_ARG_LLONG;
+      }
+    }
+    else if ((*pCursor == 'z') || (*pCursor == 't'))
+    {
+      pCursor++;
+      argClass = E_LOG_ARG_SIZE;
+    }
+    else if (*pCursor == 'j')
+    {
+      pCursor++;
+      argClass = E_LOG_ARG_LLONG;
+    }
+    else
+    {
+      /* 'h' and 'hh' promote to int. */
+      while (*pCursor == 'h')
+      {
+        pCursor++;
+      }
+    }
+
+    /* Conversion. */
+    switch (*pCursor)
+    {
+      case '%':
+        argClass = E_LOG_ARG_NONE;
+        break;
+
+      case 's':
+        argClass = E_LOG_ARG_STRING;
+        break;
+
+      case 'p':
+        argClass = E_LOG_ARG_POINTER;
+        break;
+
+      case 'f':
+      case 'F':
+      case 'e':
+      case 'E':
+      case 'g':
+      case 'G':
+        argClass = E_LOG_ARG_DOUBLE;
+        break;
+
+      case '\0':
+        /* Truncated specification. */
+        argClass = E_LOG_ARG_NONE;
+        pCursor--;
+        break;
+
+      default:
+        /* d, i, u, x, X, o, c. */
+        break;
+    }
+
+    *xpSpecLen = (size_t)(pCursor - pSpec) + 1u;
+    *xpArgClass = argClass;
+    *xpStarCount = starCount;
+  }
+}
+
 /**
- * SUPPRESS: misra_c2012_rule_21.10_violation
- * Use of time library for logging purpose.
+ * @implements lLogCopyString
+ *
  */
-static void initEvent
+static uint64_t lLogCopyString
 (
-  logEvent *xpEvent
+  TKtaLogRecord* xpRecord,
+  size_t*        xpUsed,
+  const char*    xpString
 )
 {
-  if (xpEvent->pTime == NULL) {
-    time_t startTime = time(NULL);
+  const char* pString = (xpString != NULL) ? xpString : "(null)";
+  size_t      offset = *xpUsed;
+  size_t      len = 0;
 
-    xpEvent->pTime = localtime(&startTime);
+  if (offset >= C_KTALOG__STRING_SIZE)
+  {
+    /* No room left, the last byte is the terminator of the previous copy. */
+    offset = C_KTALOG__STRING_SIZE - 1u;
+  }
+  else
+  {
+    while ((pString[len] != '\0') && ((offset + len + 1u) < C_KTALOG__STRING_SIZE))
+    {
+      xpRecord->aStrings[offset + len] = pString[len];
+      len++;
+    }
+    xpRecord->aStrings[offset + len] = '\0';
+    *xpUsed = offset + len + 1u;
   }
+
+  return (uint64_t)offset;
+}
+
+/**
+ * @implements lLogPrintRecord
+ *
+ */
+/**
+ * SUPPRESS: MISRA_DEV_KTA_002 : misra_c2012_rule_17.7_violation
+ * Not using the return value of snprintf
+ */
+static void lLogPrintRecord
+(
+  const TKtaLogRecord* xpRecord
+)
+{
+  char         aBuffer[C_MAX_BUFFER_SIZE + 1] = {0};
+  char         aSpec[C_MAX_SPEC_SIZE] = {0};
+  const char*  pCursor = xpRecord->pFmt;
+  const char*  pSpec = NULL;
+  size_t       specLen = 0;
+  size_t       used = 0;
+  TLogArgClass argClass = E_LOG_ARG_NONE;
+  uint32_t     starCount = 0;
+  uint8_t      argIndex = 0;
+  uint64_t     arg = 0;
+  double       value = 0;
+
+  snprintf(aBuffer,
+           C_MAX_BUFFER_SIZE,
+           "#%lu [%s] [%s:%u] ",
+           (unsigned long)xpRecord->sequence,
+           gapLevelStrings[xpRecord->level % C_MAX_LOG_LEVELS],
+           (xpRecord->pModuleName != NULL) ? xpRecord->pModuleName : "",
+           (unsigned int)xpRecord->line);
+
+  for (;;)
+  {
+    used = strlen(aBuffer);
+    lLogNextSpec(pCursor, &pSpec, &specLen, &argClass, &starCount);
+    if ((pSpec == NULL) || (used >= C_MAX_BUFFER_SIZE))
+    {
+      break;
+    }
+
+    /* Literal text before the specification. */
+    snprintf(aBuffer + used, C_MAX_BUFFER_SIZE - used, "%.*s", (int)(pSpec - pCursor), pCursor);
+    used = strlen(aBuffer);
+    pCursor = pSpec + specLen;
+
+    /* Width/precision from '*' are not kept in the replayed specification. */
+    argIndex += (uint8_t)starCount;
+    if ((argClass == E_LOG_ARG_NONE) || (starCount != 0u) || (specLen >= C_MAX_SPEC_SIZE))
+    {
+      snprintf(aBuffer + used, C_MAX_BUFFER_SIZE - used, "%s",
+               (argClass == E_LOG_ARG_NONE) ? "%" : "?");
+      argIndex += (argClass == E_LOG_ARG_NONE) ? 0u : 1u;
+      continue;
+    }
+    if (argIndex >= xpRecord->argCount)
+    {
+      snprintf(aBuffer + used, C_MAX_BUFFER_SIZE - used, "?");
+      continue;
+    }
+
+    (void)memcpy(aSpec, pSpec, specLen);
+    aSpec[specLen] = '\0';
+    arg = xpRecord->aArgs[argIndex];
+    argIndex++;
+
+    switch (argClass)
+    {
+      case E_LOG_ARG_LONG:
+        snprintf(aBuffer + used, C_MAX_BUFFER_SIZE - used, aSpec, (long)arg);
+        break;
+
+      case E_LOG_ARG_LLONG:
+        snprintf(aBuffer + used, C_MAX_BUFFER_SIZE - used, aSpec, (long long)arg);
+        break;
+
+      case E_LOG_ARG_SIZE:
+        snprintf(aBuffer + used, C_MAX_BUFFER_SIZE - used, aSpec, (size_t)arg);
+        break;
+
+      case E_LOG_ARG_DOUBLE:
+        (void)memcpy(&value, &arg, sizeof(value));
+        snprintf(aBuffer + used, C_MAX_BUFFER_SIZE - used, aSpec, value);
+        break;
+
+      case E_LOG_ARG_POINTER:
+        snprintf(aBuffer + used, C_MAX_BUFFER_SIZE - used, aSpec,
+                 (const void*)(uintptr_t)arg);
+        break;
+
+      case E_LOG_ARG_STRING:
+        if (arg >= C_KTALOG__STRING_SIZE)
+        {
+          arg = C_KTALOG__STRING_SIZE - 1u;
+        }
+        snprintf(aBuffer + used, C_MAX_BUFFER_SIZE - used, aSpec, &xpRecord->aStrings[arg]);
+        break;
+
+      default:
+        snprintf(aBuffer + used, C_MAX_BUFFER_SIZE - used, aSpec, (int)arg);
+        break;
+    }
+  }
+
+  used = strlen(aBuffer);
+  if (used < C_MAX_BUFFER_SIZE)
+  {
+    snprintf(aBuffer + used, C_MAX_BUFFER_SIZE - used, "%s", pCursor);
+  }
+  salPrint(aBuffer);
+  salPrint("\r\n");
 }
+#endif /* LOG_KTA_BINARY */
 
 /* -------------------------------------------------------------------------- */
 /* END OF FILE                                                                */
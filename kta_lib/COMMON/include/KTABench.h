@@ -0,0 +1,207 @@
+/*******************************************************************************
+*************************keySTREAM Trusted Agent ("KTA")************************
+
+* (c) 2023-2025 Nagravision Sàrl
+
+* Subject to your compliance with these terms, you may use the Nagravision Sàrl
+* Software and any derivatives exclusively with Nagravision's products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may accompany
+* Nagravision Software.
+
+* Redistribution of this Nagravision Software in source or binary form is allowed
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+
+* THIS SOFTWARE IS SUPPLIED BY NAGRAVISION "AS IS". NO WARRANTIES, WHETHER EXPRESS,
+* IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF
+* NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE. IN NO
+* EVENT WILL NAGRAVISION BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL
+* OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF NAGRAVISION HAS BEEN ADVISED OF THE
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW,
+* NAGRAVISION 'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS
+* SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY
+* TO NAGRAVISION FOR THIS SOFTWARE.
+********************************************************************************/
+/** \brief keySTREAM Trusted Agent - Benchmark probe module.
+ *
+ *  \author Kudelski IoT
+ *
+ *  \date 2026/10/17
+ *
+ *  \file KTABench.h
+ ******************************************************************************/
+/**
+ * @brief keySTREAM Trusted Agent Benchmark probe module.
+ *
+ * Records the wall clock latency and the CPU time spent in each phase of the
+ * provisioning handshake. Probes compile to nothing unless BENCHMARK_FEATURE
+ * is defined in ktaConfig.h.
+ */
+
+#ifndef KTABENCH_H
+#define KTABENCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* C++ */
+/* --------------------------------------------------------------------------------------------- */
+/* IMPORTS                                                                                       */
+/* --------------------------------------------------------------------------------------------- */
+#include "ktaConfig.h"
+#include <stdint.h>
+
+/* --------------------------------------------------------------------------------------------- */
+/* CONSTANTS, TYPES, ENUM                                                                        */
+/* --------------------------------------------------------------------------------------------- */
+#ifndef C_KTABENCH__MAX_SAMPLES
+/** @brief Number of samples kept per phase, older samples are overwritten. */
+#define C_KTABENCH__MAX_SAMPLES        (1024u)
+#endif
+
+/** @brief Benchmarked phases. */
+typedef enum
+{
+  E_KTABENCH_PHASE_HANDSHAKE = 0,
+  /* Full provisioning handshake of one device, startup to PROVISIONED. */
+  E_KTABENCH_PHASE_STARTUP,
+  /* ktaStartup. */
+  E_KTABENCH_PHASE_EXCHANGE,
+  /* ktaExchangeMessage, message processing and building. */
+  E_KTABENCH_PHASE_TRANSPORT,
+  /* Round trip to the keySTREAM peer. */
+  E_KTABENCH_PHASE_ACT_REQUEST,
+  /* Activation request build. */
+  E_KTABENCH_PHASE_KEY_DERIVATION,
+  /* L1 and L2 key derivation. */
+  E_KTABENCH_PHASE_REGISTRATION,
+  /* Registration request build. */
+  E_KTABENCH_PHASE_COMMAND,
+  /* Object management command processing. */
+  E_KTABENCH_PHASE_NVM_WRITE,
+  /* Persistent storage write. */
+  E_KTABENCH_PHASE_PARSE,
+  /* ICPP message deserialization and response serialization. */
+  E_KTABENCH_PHASE_COUNT
+  /* Number of phases. */
+} TKtaBenchPhase;
+
+/** @brief Statistics of one phase, all durations in microseconds. */
+typedef struct
+{
+  uint32_t  count;
+  /* Number of samples the statistics are computed on. */
+  uint64_t  wallP50;
+  /* Median wall clock latency. */
+  uint64_t  wallP99;
+  /* 99th percentile wall clock latency. */
+  uint64_t  wallMax;
+  /* Maximum wall clock latency. */
+  uint64_t  cpuP50;
+  /* Median CPU time of the calling thread. */
+  uint64_t  cpuP99;
+  /* 99th percentile CPU time of the calling thread. */
+  uint64_t  cpuTotal;
+  /* Accumulated CPU time. */
+} TKtaBenchReport;
+
+#ifdef BENCHMARK_FEATURE
+/** @brief Start timing a phase on the calling thread. */
+#define M_KTABENCH__START(x_phase)    ktaBench_Start(x_phase)
+/** @brief Stop timing a phase on the calling thread and record the sample. */
+#define M_KTABENCH__END(x_phase)      ktaBench_End(x_phase)
+#else
+/** @brief Benchmark probe disabled. */
+#define M_KTABENCH__START(x_phase)
+/** @brief Benchmark probe disabled. */
+#define M_KTABENCH__END(x_phase)
+#endif /* BENCHMARK_FEATURE */
+
+/* --------------------------------------------------------------------------------------------- */
+/* VARIABLES                                                                                     */
+/* --------------------------------------------------------------------------------------------- */
+
+/* --------------------------------------------------------------------------------------------- */
+/* FUNCTIONS                                                                                     */
+/* --------------------------------------------------------------------------------------------- */
+#ifdef BENCHMARK_FEATURE
+/**
+ * @brief
+ *   Mark the start of a phase on the calling thread.
+ *
+ * @param[in] xPhase
+ *   Phase being entered.
+ */
+void ktaBench_Start
+(
+  TKtaBenchPhase  xPhase
+);
+
+/**
+ * @brief
+ *   Mark the end of a phase on the calling thread and record its sample.
+ *   Ignored if the phase was not started on this thread.
+ *
+ * @param[in] xPhase
+ *   Phase being left.
+ */
+void ktaBench_End
+(
+  TKtaBenchPhase  xPhase
+);
+
+/**
+ * @brief
+ *   Discard all recorded samples.
+ */
+void ktaBench_Reset
+(
+  void
+);
+
+/**
+ * @brief
+ *   Compute the statistics of a phase.
+ *
+ * @param[in] xPhase
+ *   Phase to report.
+ * @param[out] xpReport
+ *   Filled with the statistics, count is 0 if nothing was recorded.
+ *   Should not be NULL.
+ *
+ * @return
+ * - 0 on success.
+ * - -1 on bad parameter or out of memory.
+ */
+int ktaBench_GetReport
+(
+  TKtaBenchPhase    xPhase,
+  TKtaBenchReport*  xpReport
+);
+
+/**
+ * @brief
+ *   Get the printable name of a phase.
+ *
+ * @param[in] xPhase
+ *   Phase to name.
+ *
+ * @return
+ * - Name of the phase, "UNKNOWN" if out of range.
+ */
+const char* ktaBench_PhaseName
+(
+  TKtaBenchPhase  xPhase
+);
+#endif /* BENCHMARK_FEATURE */
+
+#ifdef __cplusplus
+}
+#endif /* C++ */
+
+#endif // KTABENCH_H
+
+/* -------------------------------------------------------------------------- */
+/* END OF FILE                                                                */
+/* -------------------------------------------------------------------------- */
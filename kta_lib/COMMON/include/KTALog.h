@@ -59,28 +59,97 @@ extern "C" {
 #define LOG_KTA_ENABLE E_KTALOG_LEVEL_NONE
 #endif
 
+#if !defined(C_KTALOG__MODULE_LEVEL)
+/**
+ * @brief Log level of the module being compiled, LOG_KTA_ENABLE unless overridden
+ * for the source file (e.g. -DC_KTALOG__MODULE_LEVEL=E_KTALOG_LEVEL_ERROR).
+ */
+#define C_KTALOG__MODULE_LEVEL LOG_KTA_ENABLE
+#endif
+
+#if !defined(C_KTALOG__RING_SIZE)
+/** @brief Number of records kept by the binary log ring. */
+#define C_KTALOG__RING_SIZE           (128u)
+#endif
+
+/** @brief Maximum number of arguments recorded per binary log record. */
+#define C_KTALOG__MAX_ARGS            (6u)
+
+#if !defined(C_KTALOG__STRING_SIZE)
+/**
+ * @brief Bytes kept per binary log record for the %s arguments, terminators included.
+ * Longer strings are truncated.
+ */
+#define C_KTALOG__STRING_SIZE         (32u)
+#endif
+
+/**
+ * @brief Constant condition, lets the compiler drop log calls below the module level
+ * while still checking their arguments.
+ */
+#define M_KTALOG__IS_ENABLED(x_level) ((int)(x_level) >= (int)(C_KTALOG__MODULE_LEVEL))
+
+#ifdef LOG_KTA_BINARY
+/** @brief Log an event in the binary log ring. */
+#define M_KTALOG__EMIT(x_level, ...)  \
+  do { if (M_KTALOG__IS_ENABLED(x_level)) { \
+    ktaLog_Record((x_level), gpModuleName, __LINE__, __VA_ARGS__); } } while (0)
+/** @brief keySTREAM Trusted Agent log in hex format, only the size is recorded. */
+#define M_KTALOG__HEX(format, x_buffer, size)  \
+  do { if (M_KTALOG__IS_ENABLED(E_KTALOG_LEVEL_DEBUG)) { M_UNUSED(x_buffer); \
+    ktaLog_Record(E_KTALOG_LEVEL_DEBUG, gpModuleName, __LINE__, "%s : [%d]", (format), (size)); } \
+  } while (0)
+#else
+/** @brief Log an event as text. */
+#define M_KTALOG__EMIT(x_level, ...)  \
+  do { if (M_KTALOG__IS_ENABLED(x_level)) { \
+    ktaLog_Fct((x_level), gpModuleName, __FILE__, __func__, __LINE__, __VA_ARGS__); } } while (0)
+/** @brief keySTREAM Trusted Agent log in hex format. */
+#define M_KTALOG__HEX(format, x_buffer, size)  \
+  do { if (M_KTALOG__IS_ENABLED(E_KTALOG_LEVEL_DEBUG)) { \
+    ktaLog_PrintBuffer(E_KTALOG_LEVEL_DEBUG, gpModuleName, __FILE__, \
+                       __func__, __LINE__, format, x_buffer, size); } } while (0)
+#endif /* LOG_KTA_BINARY */
+
 /** @brief keySTREAM Trusted Agent log level start. */
-#define M_KTALOG__START(...)          \
-    ktaLog_Fct(E_KTALOG_LEVEL_ENTRY_EXIT, gpModuleName, __FILE__, __func__, __LINE__, __VA_ARGS__)
+#define M_KTALOG__START(...)          M_KTALOG__EMIT(E_KTALOG_LEVEL_ENTRY_EXIT, __VA_ARGS__)
 /** @brief keySTREAM Trusted Agent log level end. */
-#define M_KTALOG__END(...)            \
-    ktaLog_Fct(E_KTALOG_LEVEL_ENTRY_EXIT, gpModuleName, __FILE__, __func__, __LINE__, __VA_ARGS__)
+#define M_KTALOG__END(...)            M_KTALOG__EMIT(E_KTALOG_LEVEL_ENTRY_EXIT, __VA_ARGS__)
 /** @brief keySTREAM Trusted Agent log level error. */
-#define M_KTALOG__ERR(...)             \
-    ktaLog_Fct(E_KTALOG_LEVEL_ERROR, gpModuleName, __FILE__, __func__, __LINE__, __VA_ARGS__)
+#define M_KTALOG__ERR(...)            M_KTALOG__EMIT(E_KTALOG_LEVEL_ERROR, __VA_ARGS__)
 /** @brief keySTREAM Trusted Agent log level warning. */
-#define M_KTALOG__WARN(...)              \
-    ktaLog_Fct(E_KTALOG_LEVEL_WARN, gpModuleName, __FILE__, __func__, __LINE__, __VA_ARGS__)
+#define M_KTALOG__WARN(...)           M_KTALOG__EMIT(E_KTALOG_LEVEL_WARN, __VA_ARGS__)
 /** @brief keySTREAM Trusted Agent log level info. */
-#define M_KTALOG__INFO(...)              \
-    ktaLog_Fct(E_KTALOG_LEVEL_INFO, gpModuleName, __FILE__, __func__, __LINE__, __VA_ARGS__)
+#define M_KTALOG__INFO(...)           M_KTALOG__EMIT(E_KTALOG_LEVEL_INFO, __VA_ARGS__)
 /** @brief keySTREAM Trusted Agent log level debug. */
-#define M_KTALOG__DEBUG(...)             \
-    ktaLog_Fct(E_KTALOG_LEVEL_DEBUG, gpModuleName, __FILE__, __func__, __LINE__, __VA_ARGS__)
-/** @brief keySTREAM Trusted Agent log in hex format. */
-#define M_KTALOG__HEX(format, x_buffer, size)  \
-    ktaLog_PrintBuffer(E_KTALOG_LEVEL_DEBUG, gpModuleName, __FILE__, \
-                   __func__, __LINE__, format, x_buffer, size)
+#define M_KTALOG__DEBUG(...)          M_KTALOG__EMIT(E_KTALOG_LEVEL_DEBUG, __VA_ARGS__)
+
+/**
+ * @brief Binary log record.
+ * The format string and module name are kept by address: a host decoder resolves them
+ * against the firmware image, or ktaLog_DumpRing formats them on the device.
+ * String arguments (%s) are copied into the record, the caller's buffer may be gone
+ * by the time the ring is read.
+ */
+typedef struct
+{
+  const char* pFmt;
+  /* Format string, identifies the log statement. */
+  const char* pModuleName;
+  /* Module name. */
+  uint32_t sequence;
+  /* Event counter, gaps show overwritten records. */
+  uint16_t line;
+  /* Line number in the source file. */
+  uint8_t level;
+  /* Log level. */
+  uint8_t argCount;
+  /* Number of valid entries in aArgs. */
+  uint64_t aArgs[C_KTALOG__MAX_ARGS];
+  /* Raw arguments, in format order. A %s argument holds its offset in aStrings. */
+  char aStrings[C_KTALOG__STRING_SIZE];
+  /* Copies of the %s arguments. */
+} TKtaLogRecord;
 
 /* --------------------------------------------------------------------------------------------- */
 /* VARIABLES                                                                                     */
@@ -173,6 +242,58 @@ void ktaLog_PrintBuffer
   int             xSize
 );
 
+#ifdef LOG_KTA_BINARY
+/**
+ * @brief
+ *   Record a log event in the binary log ring.
+ *   The arguments are stored raw, no formatting takes place.
+ *
+ * @param[in] xLevel
+ *   The log level of the event.
+ * @param[in] xpModuleName
+ *   The name of the module generating the log event.
+ * @param[in] xLine
+ *   The line number in the source file where the log event occurred.
+ * @param[in] xpFmt
+ *   The format string for the log message, must outlive the ring (string literal).
+ * @param[in] ...
+ *   Additional arguments for the format string.
+ */
+void ktaLog_Record
+(
+  int         xLevel,
+  const char* xpModuleName,
+  int         xLine,
+  const char* xpFmt,
+  ...
+);
+
+/**
+ * @brief
+ *   Get the binary log ring, for a host tool or a debugger to read.
+ *
+ * @param[out] xpNextSequence
+ *   Sequence number the next record will get, the ring holds the records
+ *   with sequence in [xpNextSequence - C_KTALOG__RING_SIZE, xpNextSequence).
+ *
+ * @return
+ *   Ring of C_KTALOG__RING_SIZE records, record n is at index n % C_KTALOG__RING_SIZE.
+ */
+const TKtaLogRecord* ktaLog_GetRing
+(
+  uint32_t* xpNextSequence
+);
+
+/**
+ * @brief
+ *   Format the binary log ring content, oldest record first, through salPrint.
+ */
+void ktaLog_DumpRing
+(
+  void
+);
+#endif /* LOG_KTA_BINARY */
+
 #ifdef __cplusplus
 }
 #endif /* C++ */
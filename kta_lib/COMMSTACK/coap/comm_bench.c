@@ -0,0 +1,503 @@
+/*******************************************************************************
+*************************keySTREAM Trusted Agent ("KTA")************************
+
+* (c) 2023-2025 Nagravision Sàrl
+
+* Subject to your compliance with these terms, you may use the Nagravision Sàrl
+* Software and any derivatives exclusively with Nagravision's products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may accompany
+* Nagravision Software.
+
+* Redistribution of this Nagravision Software in source or binary form is allowed
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+
+* THIS SOFTWARE IS SUPPLIED BY NAGRAVISION "AS IS". NO WARRANTIES, WHETHER EXPRESS,
+* IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF
+* NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE. IN NO
+* EVENT WILL NAGRAVISION BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL
+* OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF NAGRAVISION HAS BEEN ADVISED OF THE
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW,
+* NAGRAVISION 'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS
+* SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY
+* TO NAGRAVISION FOR THIS SOFTWARE.
+********************************************************************************/
+/** \brief Communication stack benchmark of the CoAP message lists.
+ *
+ *  \author Kudelski IoT
+ *
+ *  \date 2026/10/17
+ *
+ *  \file comm_bench.c
+ ******************************************************************************/
+/**
+ * @brief Communication stack benchmark of the CoAP message lists.
+ */
+
+#include "comm_bench.h"
+
+#ifdef BENCHMARK_FEATURE
+/* -------------------------------------------------------------------------- */
+/* IMPORTS                                                                    */
+/* -------------------------------------------------------------------------- */
+#include "comm_interface_util.h"
+#include "k_sal_os.h"
+#include "sn_coap_header.h"
+#include "sn_coap_protocol.h"
+#include "sn_config.h"
+
+#include <string.h>
+#include <time.h>
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL CONSTANTS, TYPES, ENUM                                               */
+/* -------------------------------------------------------------------------- */
+/** @brief First port of the peers whose CON are pending in the resend queue. */
+#define C_COMM_BENCH_RESEND_PORT           (20000u)
+
+/** @brief First port of the peers whose CON are kept in the duplicate list. */
+#define C_COMM_BENCH_DUPLICATE_PORT        (30000u)
+
+/** @brief Size of the packets parsed, a CoAP header without token nor option. */
+#define C_COMM_BENCH_PACKET_SIZE           (4u)
+
+/** @brief Size of the buffer receiving a built CON. */
+#define C_COMM_BENCH_BUILD_SIZE            (64u)
+
+/** @brief Set an argument/return value as unused */
+#define M_UNUSED(xArg)            (void)(xArg)
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL VARIABLES                                                            */
+/* -------------------------------------------------------------------------- */
+/** @brief IPv4 address of all the peers. */
+static uint8_t gaCommBenchPeerIp[4] = {10u, 0u, 0u, 1u};
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL FUNCTIONS - PROTOTYPE                                                */
+/* -------------------------------------------------------------------------- */
+/**
+ * @brief
+ *   Allocates memory for the CoAP library.
+ *
+ * @param[in] xSize
+ *   Size to allocate.
+ *
+ * @return
+ * - Pointer to the allocated memory or NULL.
+ */
+static void* pCommBenchMalloc
+(
+  uint16_t xSize
+);
+
+/**
+ * @brief
+ *   Frees memory allocated by pCommBenchMalloc().
+ *
+ * @param[in] xpAddr
+ *   Memory to free.
+ */
+static void commBenchFree
+(
+  void* xpAddr
+);
+
+/**
+ * @brief
+ *   CoAP transmit callback, drops the datagram.
+ *
+ * @return
+ * - 1.
+ */
+static uint8_t commBenchTxCb
+(
+  uint8_t*         xpSendBuffer,
+  uint16_t         xSendBufferSize,
+  sn_nsdl_addr_s*  xpDstAddress,
+  void*            xpUserData
+);
+
+/**
+ * @brief
+ *   CoAP receive callback, unused.
+ *
+ * @return
+ * - 0.
+ */
+static int8_t commBenchRxCb
+(
+  sn_coap_hdr_s*   xpCoapHeader,
+  sn_nsdl_addr_s*  xpDstAddress,
+  void*            xpUserData
+);
+
+/**
+ * @brief
+ *   Build a CON to a peer, which queues it for resending.
+ *
+ * @param[in] xpCoapHandle
+ *   Handle of the CoAP.
+ * @param[in] xPort
+ *   Port of the peer.
+ * @param[out] xpMessageId
+ *   Message id of the CON.
+ *
+ * @return
+ * - E_TRUE if the CON is built.
+ * - E_FALSE otherwise.
+ */
+static TBoolean commBenchBuildCon
+(
+  struct coap_s*  xpCoapHandle,
+  const uint16_t  xPort,
+  uint16_t*       xpMessageId
+);
+
+/**
+ * @brief
+ *   Parse a packet without token nor option received from a peer.
+ *
+ * @param[in] xpCoapHandle
+ *   Handle of the CoAP.
+ * @param[in] xPort
+ *   Port of the peer.
+ * @param[in] xType
+ *   CoAP message type.
+ * @param[in] xMessageId
+ *   Message id.
+ *
+ * @return
+ *   Status of the parsed message, COAP_STATUS_PARSER_ERROR_IN_HEADER if it is not returned.
+ */
+static sn_coap_status_e commBenchParse
+(
+  struct coap_s*          xpCoapHandle,
+  const uint16_t          xPort,
+  const sn_coap_msg_type_e  xType,
+  const uint16_t          xMessageId
+);
+
+/**
+ * @brief
+ *   Returns the monotonic time in ns.
+ *
+ * @return
+ * - Monotonic time in ns.
+ */
+static uint64_t getBenchTimeInNs
+(
+  void
+);
+
+/* -------------------------------------------------------------------------- */
+/* PUBLIC VARIABLES                                                           */
+/* -------------------------------------------------------------------------- */
+
+/* -------------------------------------------------------------------------- */
+/* PUBLIC FUNCTIONS - IMPLEMENTATION                                          */
+/* -------------------------------------------------------------------------- */
+/**
+ * @brief  implement commBenchIndex
+ *
+ */
+TCommIfStatus commBenchIndex
+(
+  const uint8_t           xEntries,
+  const uint32_t          xPackets,
+  TCommBenchIndexResult*  xpResult
+)
+{
+  TCommIfStatus    commStatus = E_COMM_IF_STATUS_PARAMETER;
+  struct coap_s*   pCoapHandle = NULL;
+  uint16_t         aMessageId[UINT8_MAX];
+  uint16_t         nextMessageId = 1;
+  uint64_t         startTime = 0;
+  uint32_t         packet = 0;
+  uint32_t         peer = 0;
+  uint32_t         seed = 1;
+  TBoolean         isHandled = E_TRUE;
+
+  for (;;)
+  {
+    if ((0U == xEntries) || (0U == xPackets) || (NULL == xpResult))
+    {
+      M_COMM__ERROR(("Invalid parameter"));
+      break;
+    }
+
+    pCoapHandle = sn_coap_protocol_init(pCommBenchMalloc,
+                                        commBenchFree,
+                                        commBenchTxCb,
+                                        commBenchRxCb);
+
+    if (NULL == pCoapHandle)
+    {
+      M_COMM__ERROR(("sn_coap_protocol_init failed"));
+      commStatus = E_COMM_IF_STATUS_MEMORY;
+      break;
+    }
+
+    if ((0 != sn_coap_protocol_set_retransmission_buffer(pCoapHandle, xEntries, 0)) ||
+        (0 != sn_coap_protocol_set_duplicate_buffer_size(pCoapHandle, xEntries)))
+    {
+      M_COMM__ERROR(("Lists cannot hold %u entries", xEntries));
+      break;
+    }
+
+    xpResult->hashIndexSize = SN_COAP_HASH_INDEX_SIZE;
+    commStatus = E_COMM_IF_STATUS_ERROR;
+
+    for (peer = 0; (peer < xEntries) && (E_TRUE == isHandled); peer++)
+    {
+      isHandled = commBenchBuildCon(pCoapHandle,
+                                    (uint16_t)(C_COMM_BENCH_RESEND_PORT + peer),
+                                    &aMessageId[peer]);
+    }
+
+    /* A random peer acknowledges its CON and gets a new one, the lists stay full. */
+    startTime = getBenchTimeInNs();
+
+    for (packet = 0; (packet < xPackets) && (E_TRUE == isHandled); packet++)
+    {
+      seed = (seed * 1103515245U) + 12345U;
+      peer = (seed >> 16) % xEntries;
+
+      if (COAP_STATUS_OK != commBenchParse(pCoapHandle,
+                                           (uint16_t)(C_COMM_BENCH_RESEND_PORT + peer),
+                                           COAP_MSG_TYPE_ACKNOWLEDGEMENT,
+                                           aMessageId[peer]))
+      {
+        isHandled = E_FALSE;
+      }
+      else
+      {
+        /* The sent copy kept for a block2 response is released as by the exchange owner. */
+        sn_coap_protocol_remove_sent_blockwise_message(pCoapHandle, aMessageId[peer]);
+        isHandled = commBenchBuildCon(pCoapHandle,
+                                      (uint16_t)(C_COMM_BENCH_RESEND_PORT + peer),
+                                      &aMessageId[peer]);
+      }
+    }
+
+    xpResult->ackResendNs = (uint32_t)((getBenchTimeInNs() - startTime) / xPackets);
+
+    for (peer = 0; (peer < xEntries) && (E_TRUE == isHandled); peer++)
+    {
+      isHandled = (COAP_STATUS_OK == commBenchParse(pCoapHandle,
+                                                    (uint16_t)(C_COMM_BENCH_DUPLICATE_PORT + peer),
+                                                    COAP_MSG_TYPE_CONFIRMABLE,
+                                                    nextMessageId)) ? E_TRUE : E_FALSE;
+      nextMessageId++;
+    }
+
+    /* Every CON is new, the duplicate list evicts its oldest entry. */
+    startTime = getBenchTimeInNs();
+
+    for (packet = 0; (packet < xPackets) && (E_TRUE == isHandled); packet++)
+    {
+      isHandled = (COAP_STATUS_OK == commBenchParse(pCoapHandle,
+                                                    (uint16_t)(C_COMM_BENCH_DUPLICATE_PORT +
+                                                               (packet % xEntries)),
+                                                    COAP_MSG_TYPE_CONFIRMABLE,
+                                                    nextMessageId)) ? E_TRUE : E_FALSE;
+      nextMessageId++;
+    }
+
+    xpResult->newConNs = (uint32_t)((getBenchTimeInNs() - startTime) / xPackets);
+
+    /* A random peer of the last xEntries CON sends its CON again. */
+    startTime = getBenchTimeInNs();
+
+    for (packet = 0; (packet < xPackets) && (E_TRUE == isHandled); packet++)
+    {
+      seed = (seed * 1103515245U) + 12345U;
+      peer = (seed >> 16) % xEntries;
+      isHandled = (COAP_STATUS_PARSER_DUPLICATED_MSG ==
+                   commBenchParse(pCoapHandle,
+                                  (uint16_t)(C_COMM_BENCH_DUPLICATE_PORT +
+                                             ((xPackets - xEntries + peer) % xEntries)),
+                                  COAP_MSG_TYPE_CONFIRMABLE,
+                                  (uint16_t)(nextMessageId - xEntries + peer))) ?
+                  E_TRUE : E_FALSE;
+    }
+
+    xpResult->duplicateConNs = (uint32_t)((getBenchTimeInNs() - startTime) / xPackets);
+
+    if (E_TRUE != isHandled)
+    {
+      M_COMM__ERROR(("Packet not handled as expected"));
+      break;
+    }
+
+    commStatus = E_COMM_IF_STATUS_OK;
+    break;
+  }
+
+  if (NULL != pCoapHandle)
+  {
+    (void)sn_coap_protocol_destroy(pCoapHandle);
+  }
+
+  return commStatus;
+}
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL FUNCTIONS - IMPLEMENTATION                                           */
+/* -------------------------------------------------------------------------- */
+/**
+ * @implements pCommBenchMalloc
+ *
+ */
+static void* pCommBenchMalloc
+(
+  uint16_t xSize
+)
+{
+  return kta_pSalMemoryAllocate(xSize);
+}
+
+/**
+ * @implements commBenchFree
+ *
+ */
+static void commBenchFree
+(
+  void* xpAddr
+)
+{
+  salMemoryFree(xpAddr);
+}
+
+/**
+ * @implements commBenchTxCb
+ *
+ */
+static uint8_t commBenchTxCb
+(
+  uint8_t*         xpSendBuffer,
+  uint16_t         xSendBufferSize,
+  sn_nsdl_addr_s*  xpDstAddress,
+  void*            xpUserData
+)
+{
+  M_UNUSED(xpSendBuffer);
+  M_UNUSED(xSendBufferSize);
+  M_UNUSED(xpDstAddress);
+  M_UNUSED(xpUserData);
+  return 1;
+}
+
+/**
+ * @implements commBenchRxCb
+ *
+ */
+static int8_t commBenchRxCb
+(
+  sn_coap_hdr_s*   xpCoapHeader,
+  sn_nsdl_addr_s*  xpDstAddress,
+  void*            xpUserData
+)
+{
+  M_UNUSED(xpCoapHeader);
+  M_UNUSED(xpDstAddress);
+  M_UNUSED(xpUserData);
+  return 0;
+}
+
+/**
+ * @implements commBenchBuildCon
+ *
+ */
+static TBoolean commBenchBuildCon
+(
+  struct coap_s*  xpCoapHandle,
+  const uint16_t  xPort,
+  uint16_t*       xpMessageId
+)
+{
+  sn_nsdl_addr_s  address = {0};
+  sn_coap_hdr_s   header;
+  uint8_t         aPacket[C_COMM_BENCH_BUILD_SIZE];
+  uint8_t         token = (uint8_t)xPort;
+
+  address.addr_len = (uint8_t)sizeof(gaCommBenchPeerIp);
+  address.type = SN_NSDL_ADDRESS_TYPE_IPV4;
+  address.port = xPort;
+  address.addr_ptr = gaCommBenchPeerIp;
+
+  (void)sn_coap_parser_init_message(&header);
+  header.msg_type = COAP_MSG_TYPE_CONFIRMABLE;
+  header.msg_code = COAP_MSG_CODE_REQUEST_GET;
+  header.token_ptr = &token;
+  header.token_len = 1;
+
+  if (0 >= sn_coap_protocol_build(xpCoapHandle, &address, aPacket, &header, NULL, 0))
+  {
+    return E_FALSE;
+  }
+
+  *xpMessageId = header.msg_id;
+  return E_TRUE;
+}
+
+/**
+ * @implements commBenchParse
+ *
+ */
+static sn_coap_status_e commBenchParse
+(
+  struct coap_s*          xpCoapHandle,
+  const uint16_t          xPort,
+  const sn_coap_msg_type_e  xType,
+  const uint16_t          xMessageId
+)
+{
+  sn_nsdl_addr_s    address = {0};
+  sn_coap_hdr_s*    pHeader = NULL;
+  sn_coap_status_e  status = COAP_STATUS_PARSER_ERROR_IN_HEADER;
+  uint8_t           aPacket[C_COMM_BENCH_PACKET_SIZE];
+
+  address.addr_len = (uint8_t)sizeof(gaCommBenchPeerIp);
+  address.type = SN_NSDL_ADDRESS_TYPE_IPV4;
+  address.port = xPort;
+  address.addr_ptr = gaCommBenchPeerIp;
+
+  /* Version 1, no token, an empty ACK or a CON with code 0.01. */
+  aPacket[0] = (uint8_t)(0x40U | ((uint8_t)xType));
+  aPacket[1] = (COAP_MSG_TYPE_ACKNOWLEDGEMENT == xType) ? 0x00U : 0x01U;
+  aPacket[2] = (uint8_t)(xMessageId >> 8);
+  aPacket[3] = (uint8_t)xMessageId;
+
+  pHeader = sn_coap_protocol_parse(xpCoapHandle, &address, sizeof(aPacket), aPacket, NULL);
+
+  if (NULL != pHeader)
+  {
+    status = pHeader->coap_status;
+    sn_coap_parser_release_allocated_coap_msg_mem(xpCoapHandle, pHeader);
+  }
+
+  return status;
+}
+
+/**
+ * @implements getBenchTimeInNs
+ *
+ */
+static uint64_t getBenchTimeInNs
+(
+  void
+)
+{
+  struct timespec  now = {0};
+
+  (void)clock_gettime(CLOCK_MONOTONIC, &now);
+  return ((uint64_t)now.tv_sec * 1000000000U) + (uint64_t)now.tv_nsec;
+}
+#endif /* BENCHMARK_FEATURE */
+
+/* -------------------------------------------------------------------------- */
+/* END OF FILE                                                                */
+/* -------------------------------------------------------------------------- */
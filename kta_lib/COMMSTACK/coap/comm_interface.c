@@ -41,6 +41,8 @@
 /* IMPORTS                                                                    */
 /* -------------------------------------------------------------------------- */
 #include "comm_interface_util.h"
+#include "comm_pool.h"
+#include "comm_timer.h"
 /* mbed coap headers. */
 #include "sn_coap_header.h"
 #include "sn_coap_protocol.h"
@@ -51,6 +53,10 @@
 #include <stdlib.h>
 #include <string.h>
 
+#if defined(PARALLEL_COMMANDS_FEATURE) || defined(FLEET_MANAGEMENT_FEATURE)
+#include <pthread.h>
+#endif
+
 /* -------------------------------------------------------------------------- */
 /* LOCAL CONSTANTS, TYPES, ENUM                                               */
 /* -------------------------------------------------------------------------- */
@@ -64,12 +70,44 @@
 /** @brief Coap resending interval in seconds. */
 #define C_COMM_INTERFACE_COAP_RESENDING_INTERVAL_IN_SECS     (2u)
 
-/** @brief Wait for next CoAP response from server in ms. */
+/** @brief Delay before sending again a block2 request that could not be sent, in ms. */
 #define C_COMM_INTERFACE_COAP_WAIT_FOR_RESPONSE              (200u)
 
 /** @brief Max retransmission if no response from server. */
 #define C_COMM_INTERFACE_COAP_MAX_RESENDING_RETRIES          (20u)
 
+/** @brief Max silence of the server during an exchange before it is stopped, in ms. */
+#define C_COMM_INTERFACE_COAP_EXCHANGE_IDLE_TIMEOUT \
+  (C_COMM_INTERFACE_COAP_MAX_RESENDING_RETRIES * C_COMM_INTERFACE_COAP_WAIT_FOR_RESPONSE)
+
+/** @brief Max silence of the server during an exchange, in retransmission timeouts measured to
+ *  the server, when longer than C_COMM_INTERFACE_COAP_EXCHANGE_IDLE_TIMEOUT. */
+#define C_COMM_INTERFACE_COAP_EXCHANGE_IDLE_RTO_COUNT       (2u)
+
+/** @brief Longest a commMessageExchange() caller polls, so that exchanges submitted meanwhile
+ *  by other threads get their timers looked at. */
+#define C_COMM_INTERFACE_COAP_POLL_SLICE                    (C_COMM_INTERFACE_COAP_WAIT_FOR_RESPONSE)
+
+/** @brief Length of the token identifying an exchange, in bytes. */
+#define C_COMM_INTERFACE_COAP_TOKEN_LENGTH                  (4u)
+
+/** @brief IPv4 and UDP headers of a datagram, in bytes. */
+#define C_COMM_INTERFACE_IPV4_UDP_HEADER_SIZE               (28u)
+
+/** @brief IPv6 and UDP headers of a datagram, in bytes. */
+#define C_COMM_INTERFACE_IPV6_UDP_HEADER_SIZE               (48u)
+
+/** @brief CoAP header, token, payload marker and options of a block besides the Uri-Path,
+ *  in bytes. */
+#define C_COMM_INTERFACE_COAP_BLOCK_HEADER_SIZE             (32u)
+
+/** @brief Smallest CoAP block size, in bytes. */
+#define C_COMM_INTERFACE_COAP_MIN_BLOCK_SIZE                (16u)
+
+#if (C_COMM_IF__MAX_EXCHANGES > SN_COAP_MAX_ALLOWED_RESENDING_BUFF_SIZE_MSGS)
+#error "C_COMM_IF__MAX_EXCHANGES exceeds the CoAP resending queue"
+#endif
+
 /** @brief Max IP4 address length. */
 #define C_COMM_INTERFACE_MAX_IP_ADDRESS_LENGTH              (16u)
 
@@ -79,18 +117,74 @@
 /** @brief Macro to free allocated memory */
 #define M_COMM_INTERFACE_FREE(x_ptr)        commCoapFree(x_ptr)
 
+#if defined(PARALLEL_COMMANDS_FEATURE) || defined(FLEET_MANAGEMENT_FEATURE)
+/** @brief Take gCommInterfaceLock, created on first use. */
+#define M_COMM_INTERFACE_LOCK()                                                  \
+  do                                                                            \
+  {                                                                             \
+    (void)pthread_once(&gCommInterfaceLockOnce, commCoapInitLock);              \
+    (void)pthread_mutex_lock(&gCommInterfaceLock);                              \
+  } while (0)
+
+/** @brief Release gCommInterfaceLock. */
+#define M_COMM_INTERFACE_UNLOCK()    (void)pthread_mutex_unlock(&gCommInterfaceLock)
+#else
+/* Single caller, nothing to serialize. */
+#define M_COMM_INTERFACE_LOCK()
+#define M_COMM_INTERFACE_UNLOCK()
+#endif
+
 /** @brief Set an argument/return value as unused */
 #define M_UNUSED(xArg)            (void)(xArg)
 
-/** @brief Communicaion interface object. */
+/** @brief State of one exchange, from commExchangeSubmit() to its completion callback. */
 typedef struct
 {
-  TBoolean          isInitialized;
-  /* True, if the interface is initialized successfully. */
+  TBoolean          isExchangePending;
+  /* True from commExchangeSubmit() until the completion callback is called. */
   TBoolean          isExchangeTerminated;
   /* True, if the message transfer completed or error occured. */
-  TKCommStatus          exchangeStatus;
+  TKCommStatus      exchangeStatus;
   /* Message exchange status. */
+  uint8_t           aToken[C_COMM_INTERFACE_COAP_TOKEN_LENGTH];
+  /* Token of every request of the exchange, used to route the responses. */
+  uint8_t*          pFirstPayload;
+  /* Payload of the first message received. */
+  uint16_t          firstPayloadLength;
+  /* Payload length first message in bytes. */
+  uint8_t*          pPayload;
+  /* Payload of the remaining messages received. */
+  uint16_t          payloadLength;
+  /* Payload length remaining messages in bytes. */
+  TBoolean          isPayloadFreeRequired;
+  /* True if pPayload was allocated by the CoAP stack. */
+  uint32_t          maxRetries;
+  /** Max retries for retransmission.
+   * Should not exceed C_COMM_INTERFACE_COAP_MAX_RESENDING_RETRIES.
+   */
+  uint16_t          lastRecivedMessageId;
+  /* Message id of the last response, to drop duplicates. */
+  uint8_t*          pReceiveMsgBuffer;
+  /* Buffer receiving the response. */
+  size_t            receiveMsgBufferLength;
+  /* Length of pReceiveMsgBuffer in bytes. */
+  TCommExchangeCb   exchangeCallback;
+  /* Completion callback. */
+  void*             pExchangeArg;
+  /* Argument of the completion callback. */
+  int32_t           pendingBlock2;
+  /* Block2 number to request again when block2Timer expires. */
+  TCommTimer        idleTimer;
+  /* Expires when the server stayed silent for too long. */
+  TCommTimer        block2Timer;
+  /* Expires when a block2 request that could not be sent is to be sent again. */
+} TCommExchange;
+
+/** @brief Communicaion interface object. */
+typedef struct
+{
+  TBoolean          isInitialized;
+  /* True, if the interface is initialized successfully. */
   struct coap_s*    pCoapHandle;
   /* Handle of the CoAP. */
   uint8_t*          pServerIp;
@@ -103,38 +197,79 @@ typedef struct
   /* Destination server IP in SAL socket format. */
   sn_nsdl_addr_s    dstAddress;
   /* Destination server address. */
-  uint8_t*           pFirstPayload;
-  /* Payload of the first message received. */
-  uint16_t          firstPayloadLength;
-  /* Payload length first message in bytes. */
-  uint8_t*           pPayload;
-  /* Payload of the remaining messages received. */
-  uint16_t          payloadLength;
-  /* Payload length remaining messages in bytes. */
   uint16_t          coapBlockSize;
   /* Coap Message block size. */
-  uint32_t          maxRetries;
-  /** Max retries for retransmission.
-   * Should not exceed C_COMM_INTERFACE_COAP_MAX_RESENDING_RETRIES.
-   */
   size_t            mtuSize;
   /* MTU size in bytes. */
   uint8_t*          pResponseBuffer;
-  /* Response buffer. */
+  /* Response buffer to receive the data from the socket. it should be mtu length. */
   uint8_t*          pCoapUri;
   /* Coap Server Uri. */
   uint16_t          coapUriLength;
   /* Coap Server Uri length. */
-  uint16_t          lastRecivedMessageId;
-  /* Response buffer to receive the data from the socket. it should be mtu length. */
+  TCommExchange     aExchanges[C_COMM_IF__MAX_EXCHANGES];
+  /* Exchanges sharing the socket and the CoAP handle. */
+  uint32_t          pendingCount;
+  /* Number of pending exchanges. */
+  TBoolean          isPolling;
+  /* True while a commMessageExchange() caller polls for all of them. */
+  TCommTimerWheel   timerWheel;
+  /* Timers of the pending exchanges. */
+  TCommTimer        retransmissionTimer;
+  /* Expires when the CoAP stack has a message to send again. */
 } TCommInterface;
 
+/** @brief State of commMessageExchange() waiting for its exchange to complete. */
+typedef struct
+{
+  TBoolean          isCompleted;
+  /* True once the completion callback is called. */
+  TCommIfStatus     status;
+  /* Status of the exchange. */
+  size_t            receivedLength;
+  /* Length of the response in bytes. */
+} TCommBlockingExchange;
+
+/** @brief Round-trip time estimate of a server, kept from one commInitProtocol() to the next. */
+typedef struct
+{
+  TBoolean          isValid;
+  /* True once an estimate was saved. */
+  uint8_t           aServerIp[C_COMM_INTERFACE_MAX_IP_ADDRESS_LENGTH];
+  /* IP of the server the estimate belongs to. */
+  uint8_t           serverIpLength;
+  /* Length of aServerIp in bytes. */
+  uint16_t          serverPort;
+  /* Port of the server the estimate belongs to. */
+  sn_coap_rto_s     estimate;
+  /* Estimate of the CoAP stack. */
+} TCommRttEstimate;
+
 /* -------------------------------------------------------------------------- */
 /* LOCAL VARIABLES                                                            */
 /* -------------------------------------------------------------------------- */
 /** @brief TCommInterface structure object */
 static TCommInterface gCommInterfaceObj;
 
+#ifdef ENABLE_COMM_POOL
+/** @brief Fixed-block pool of the CoAP stack allocations, guarded by gCommInterfaceLock. */
+static TCommPool gCommInterfacePool;
+#endif /* ENABLE_COMM_POOL */
+
+#if defined(PARALLEL_COMMANDS_FEATURE) || defined(FLEET_MANAGEMENT_FEATURE)
+/** @brief Serializes the access to gCommInterfaceObj, recursive for the completion callbacks. */
+static pthread_mutex_t gCommInterfaceLock;
+
+/** @brief Signaled each time the polling commMessageExchange() caller returns from a poll. */
+static pthread_cond_t gCommInterfacePolled;
+
+/** @brief Initializes gCommInterfaceLock and gCommInterfacePolled once. */
+static pthread_once_t gCommInterfaceLockOnce = PTHREAD_ONCE_INIT;
+#endif
+
+/** @brief Round-trip time estimate saved by commTerminateProtocol(), guarded by gCommInterfaceLock. */
+static TCommRttEstimate gCommInterfaceRtt;
+
 /* -------------------------------------------------------------------------- */
 /* LOCAL FUNCTIONS - PROTOTYPE                                                */
 /* -------------------------------------------------------------------------- */
@@ -267,6 +402,8 @@ static void terminateCoapProtocol
  * @brief
  *  Prepare coap message with required params.
  *
+ * @param[in]  xpExchange
+ *   Exchange the message belongs to, gives the token.
  * @param[in]  xpPayload
  *   Payload to send.
  *   Can be null, if no data to send.
@@ -279,8 +416,9 @@ static void terminateCoapProtocol
  */
 static sn_coap_hdr_s* pGetDefaultCoapHeader
 (
-  const uint16_t  xPayloadLen,
-  const uint8_t*  xpPayload
+  const TCommExchange*  xpExchange,
+  const uint16_t        xPayloadLen,
+  const uint8_t*        xpPayload
 );
 
 /**
@@ -310,6 +448,31 @@ static uint16_t getCoapBlockSizeUsingMtu
   const size_t  xMtuValue
 );
 
+/**
+ * @brief
+ *   Lower the CoAP block size of the next messages, if larger than the given one.
+ *
+ * @param[in] xBlockSize
+ *   Block size the path or the server accepts, in bytes.
+ */
+static void commCoapLowerBlockSize
+(
+  const uint16_t  xBlockSize
+);
+
+/**
+ * @brief
+ *   Adopt the block size a response of the server asks for, in its Block1 or Block2 option
+ *   or, for a 4.13 Request Entity Too Large, in its Size1 option.
+ *
+ * @param[in] xpCoapResponse
+ *   Parsed response.
+ */
+static void commCoapAdoptServerBlockSize
+(
+  const sn_coap_hdr_s*  xpCoapResponse
+);
+
 /**
  * @brief
  *  Get the coap retransmission count.
@@ -334,6 +497,37 @@ static uint8_t getCoapResendingInterval
   void
 );
 
+/**
+ * @brief
+ *  Get how long the server may stay silent during an exchange.
+ *
+ * @return
+ *  Idle timeout in ms.
+ */
+static uint32_t getExchangeIdleTimeout
+(
+  void
+);
+
+/**
+ * @brief
+ *  Save the round-trip time estimate of the server before the CoAP handle is destroyed.
+ */
+static void commCoapSaveRttEstimate
+(
+  void
+);
+
+/**
+ * @brief
+ *  Give the saved round-trip time estimate to the CoAP handle, if it was measured with the same
+ *  server.
+ */
+static void commCoapRestoreRttEstimate
+(
+  void
+);
+
 /**
  * @brief
  *  Get system relative time in sec.
@@ -350,6 +544,8 @@ static uint32_t getRelativeTimeInSec
  * @brief
  *   Build and send the coap message to the keySTREAM.
  *
+ * @param[in]  xpExchange
+ *   Exchange the message belongs to.
  * @param[in]  xpMessageToSend
  *   Payload to send, may be NULL if no data to send.
  * @param[in]  xSendSize
@@ -364,6 +560,7 @@ static uint32_t getRelativeTimeInSec
  */
 static TKCommStatus commCoapBuildAndSendMessage
 (
+  TCommExchange*  xpExchange,
   const uint8_t*  xpMessageToSend,
   const size_t    xSendSize
 );
@@ -373,6 +570,8 @@ static TKCommStatus commCoapBuildAndSendMessage
  *   Build and send the coap message with block2 option and next block of the previous message. it
  *   mustn't have the payload.
  *
+ * @param[in] xpExchange
+ *   Exchange the message belongs to.
  * @param[in] xBlock2
  *   Block number received from the previous request.
  *
@@ -385,7 +584,8 @@ static TKCommStatus commCoapBuildAndSendMessage
  */
 static TKCommStatus commCoapPrepareAndSendBlock2Message
 (
-  const int32_t  xBlock2
+  const TCommExchange*  xpExchange,
+  const int32_t         xBlock2
 );
 
 /**
@@ -402,26 +602,166 @@ static TCommIfStatus commConvertError
 
 /**
  * @brief
- *  Check and retransmit the CoAP packet and wait for milliseconds.
+ *  Arm the retransmission timer on the next resending time of the CoAP stack, or disarm it if
+ *  no message waits for an acknowledgement.
  *
- * @param[in]  xpCoapHandle
- *   Coap handle.
+ * @param[in]  xNowMs
+ *   Current relative time in ms.
  */
-static void commCoapWaitForData
+static void commCoapArmRetransmissionTimer
 (
-  struct coap_s*  xpCoapHandle
+  const uint32_t  xNowMs
+);
+
+/**
+ * @brief
+ *  Retransmit the CoAP messages which are due.
+ *
+ * @param[in]  xpArg
+ *   Unused.
+ */
+static void commCoapRetransmissionTimerCb
+(
+  void*  xpArg
+);
+
+/**
+ * @brief
+ *  Stop an exchange, the server stayed silent for too long.
+ *
+ * @param[in]  xpArg
+ *   Pointer to TCommExchange.
+ */
+static void commCoapIdleTimerCb
+(
+  void*  xpArg
+);
+
+/**
+ * @brief
+ *  Send again the block2 request that could not be sent.
+ *
+ * @param[in]  xpArg
+ *   Pointer to TCommExchange.
+ */
+static void commCoapBlock2TimerCb
+(
+  void*  xpArg
+);
+
+/**
+ * @brief
+ *  Complete an exchange: copy the response, release its CoAP buffers and timers and call the
+ *  completion callback.
+ *
+ * @param[in,out]  xpExchange
+ *   Exchange to complete.
+ */
+static void commCoapCompleteExchange
+(
+  TCommExchange*  xpExchange
+);
+
+/**
+ * @brief
+ *  Complete all pending exchanges with the same status.
+ *
+ * @param[in]  xStatus
+ *   Status of the exchanges.
+ */
+static void commCoapCompleteAllExchanges
+(
+  const TKCommStatus  xStatus
 );
 
 /**
  * @brief
- *  Retry the block2 packet sending until max retry reached.
+ *  Release the memory the CoAP stack kept for the exchanges, once none is pending.
+ */
+static void commCoapReleaseExchangesMemory
+(
+  void
+);
+
+/**
+ * @brief
+ *  Get the pending exchange owning a token.
+ *
+ * @param[in]  xpToken
+ *   Token of a received message, may be NULL.
+ * @param[in]  xTokenLength
+ *   Length of the token in bytes.
+ *
+ * @return
+ *  The exchange or NULL if none owns the token.
+ */
+static TCommExchange* pCommCoapFindExchange
+(
+  const uint8_t*  xpToken,
+  const uint8_t   xTokenLength
+);
+
+/**
+ * @brief
+ *  Wait for a datagram or the next timer, at most xTimeoutMs, then handle the received
+ *  datagrams and expired timers. Called with gCommInterfaceLock held, which is released
+ *  during the wait.
+ *
+ * @param[in]  xTimeoutMs
+ *   Maximum time to wait, in ms.
+ *
+ * @return
+ * - E_COMM_IF_STATUS_OK in case of success.
+ * - Other status if the socket cannot be polled, the pending exchanges are then completed.
+ */
+static TCommIfStatus commCoapPoll
+(
+  const uint32_t  xTimeoutMs
+);
+
+#if defined(PARALLEL_COMMANDS_FEATURE) || defined(FLEET_MANAGEMENT_FEATURE)
+/**
+ * @brief
+ *  Initialize gCommInterfaceLock and gCommInterfacePolled.
+ */
+static void commCoapInitLock
+(
+  void
+);
+#endif
+
+/**
+ * @brief
+ *  Completion callback used by commMessageExchange().
  *
+ * @param[in]  xpArg
+ *   Pointer to TCommBlockingExchange.
+ * @param[in]  xStatus
+ *   Status of the exchange.
+ * @param[in]  xReceivedLength
+ *   Length of the response in bytes.
+ */
+static void commCoapBlockingExchangeCb
+(
+  void*                xpArg,
+  const TCommIfStatus  xStatus,
+  const size_t         xReceivedLength
+);
+
+/**
+ * @brief
+ *  Send again a block2 request that could not be sent, later on from block2Timer, until max
+ *  retry reached.
+ *
+ * @param[in,out]  xpExchange
+ *  Exchange the request belongs to.
  * @param[in]  xBlock2
  *  Block number received from the previous request.
  */
 static void commCoapRetrySendBlock2
 (
-  const int32_t  xBlock2
+  TCommExchange*  xpExchange,
+  const int32_t   xBlock2
 );
 
 /**
@@ -434,22 +774,23 @@ static void commCoapRetrySendBlock2
  *   Length of the response buffer.
  * @param[in] xpCoapHandle
  *   coap handle.
- * @param[in,out] IsPayloadFreeRequired
- *   [in]Pointer to hold status.
- *   [out]Set to ture if payload free is required otherwise false.
+ *
+ * @return
+ *   The exchange the packet belongs to, NULL if none.
  */
-static void commCoapGetResponse
+static TCommExchange* pCommCoapGetResponse
 (
   uint8_t*        xpResponseBuffer,
   size_t          xResponseBufferLength,
-  struct coap_s*  xpCoapHandle,
-  TBoolean*       xpIsPayloadFreeRequired
+  struct coap_s*  xpCoapHandle
 );
 
 /**
  * @brief
  *  Copy the received payload to the destination buffer.
  *
+ * @param[in,out] xpExchange
+ *   Exchange holding the payload.
  * @param[in,out] xpDstMsgBuffer
  *   [in] Pointer to destination message buffer to copy payload in.
  *   [out] Actual destination message buffer after payload is copied.
@@ -463,6 +804,7 @@ static void commCoapGetResponse
  */
 static uint32_t copyPayloadToMessageBuffer
 (
+  TCommExchange*  xpExchange,
   uint8_t*        xpDstMsgBuffer,
   size_t          xDstMsgBufferLength,
   const TBoolean  xIsPayloadFreeRequired
@@ -518,6 +860,8 @@ TCommIfStatus commInitProtocol
 
   M_COMM__API_START();
 
+  M_COMM_INTERFACE_LOCK();
+
   for (;;)
   {
     if (
@@ -627,11 +971,29 @@ TCommIfStatus commInitProtocol
     if (0 != commStatus)
     {
       M_COMM__ERROR(("sn_coap_protocol_set_retransmission_parameters failed Status[%d]",
-                     TKCommStatus));
+                     commStatus));
+      terminateCoapProtocol();
+      break;
+    }
+
+    /* One outstanding confirmable message per exchange. */
+    commStatus = sn_coap_protocol_set_retransmission_buffer(gCommInterfaceObj.pCoapHandle,
+                                                            C_COMM_IF__MAX_EXCHANGES,
+                                                            0);
+
+    if (0 != commStatus)
+    {
+      M_COMM__ERROR(("sn_coap_protocol_set_retransmission_buffer failed Status[%d]",
+                     commStatus));
       terminateCoapProtocol();
       break;
     }
 
+    /* Retransmission timeouts follow the round-trip time measured to the server, if the CoAP
+     * stack is built with SN_COAP_ADAPTIVE_RTO. */
+    (void)sn_coap_protocol_set_rto_clock(gCommInterfaceObj.pCoapHandle, salTimeGetRelative);
+    commCoapRestoreRttEstimate();
+
     mtuSize = getMtuSize();
     gCommInterfaceObj.coapBlockSize = getCoapBlockSizeUsingMtu(mtuSize);
 
@@ -649,11 +1011,18 @@ TCommIfStatus commInitProtocol
 
     (void)memset(gCommInterfaceObj.pResponseBuffer, 0, mtuSize);
 
+    (void)memset(gCommInterfaceObj.aExchanges, 0, sizeof(gCommInterfaceObj.aExchanges));
+    gCommInterfaceObj.pendingCount = 0;
+    gCommInterfaceObj.isPolling = E_FALSE;
+    commTimerWheelInit(&gCommInterfaceObj.timerWheel, salTimeGetRelative());
+
     status = E_COMM_IF_STATUS_OK;
     gCommInterfaceObj.isInitialized = E_TRUE;
     break;
   }
 
+  M_COMM_INTERFACE_UNLOCK();
+
   M_COMM__API_END();
 
   return status;
@@ -670,7 +1039,9 @@ TCommIfStatus commTerminateProtocol
 {
   M_COMM__API_START();
 
+  M_COMM_INTERFACE_LOCK();
   terminateCoapProtocol();
+  M_COMM_INTERFACE_UNLOCK();
 
   M_COMM__API_END();
 
@@ -689,160 +1060,321 @@ TCommIfStatus commMessageExchange
   size_t*          xpReceiveMsgBufferLength
 )
 {
-  TCommIfStatus   commStatus = E_COMM_IF_STATUS_ERROR;
-  TKCommStatus    status = E_K_COMM_STATUS_OK;
-  TKSocketIp      ip = {0};
-  size_t          responseBufferLength = 0;
-  TBoolean        isPayloadFreeRequired = E_FALSE;
+  TCommIfStatus          commStatus = E_COMM_IF_STATUS_ERROR;
+  TCommBlockingExchange  blockingExchange = { E_FALSE, E_COMM_IF_STATUS_ERROR, 0 };
 
   M_COMM__API_START();
 
+  M_COMM_INTERFACE_LOCK();
+
   for (;;)
   {
-    if (
-      (NULL == xpMessageToSend) ||
-      (0U == xSendSize) ||
-      (NULL == xpReceiveMsgBuffer) ||
-      (NULL == xpReceiveMsgBufferLength) ||
-      (0 == *xpReceiveMsgBufferLength) ||
-      (E_FALSE == gCommInterfaceObj.isInitialized)
-    )
+    if (NULL == xpReceiveMsgBufferLength)
     {
       M_COMM__ERROR(("Invalid paramertes or not initialized"));
       commStatus = E_COMM_IF_STATUS_PARAMETER;
       break;
     }
 
-    gCommInterfaceObj.maxRetries = C_COMM_INTERFACE_COAP_MAX_RESENDING_RETRIES;
-    gCommInterfaceObj.lastRecivedMessageId = 0;
+    commStatus = commExchangeSubmit(xpMessageToSend,
+                                    xSendSize,
+                                    xpReceiveMsgBuffer,
+                                    *xpReceiveMsgBufferLength,
+                                    commCoapBlockingExchangeCb,
+                                    &blockingExchange);
 
-    status = commCoapBuildAndSendMessage(xpMessageToSend, xSendSize);
-
-    if (E_K_COMM_STATUS_OK != status)
+    if (E_COMM_IF_STATUS_OK != commStatus)
     {
-      M_COMM__ERROR(("commCoapBuildAndSendMessage Failed %d", status));
-      commStatus = commConvertError(status);
+      M_COMM__ERROR(("commExchangeSubmit Failed %d", commStatus));
       break;
     }
 
-    M_COMM__INFO(("First message send successfully"));
-    gCommInterfaceObj.isExchangeTerminated = E_FALSE;
-
-    do
+    /**
+     * One caller at a time polls for the exchanges of all the callers, the other ones wait
+     * until it returns and check whether their exchange was completed meanwhile. Each poll
+     * returns as soon as a datagram arrives or a timer expires.
+     */
+    while ((E_FALSE == blockingExchange.isCompleted) && (E_COMM_IF_STATUS_OK == commStatus))
     {
-      responseBufferLength = gCommInterfaceObj.mtuSize;
-      gCommInterfaceObj.exchangeStatus = E_K_COMM_STATUS_ERROR;
-      status = salSocketReceiveFrom(gCommInterfaceObj.pSocket,
-                                    gCommInterfaceObj.pResponseBuffer,
-                                    &responseBufferLength,
-                                    &ip);
-
-      switch (status)
+#if defined(PARALLEL_COMMANDS_FEATURE) || defined(FLEET_MANAGEMENT_FEATURE)
+      if (E_FALSE == gCommInterfaceObj.isPolling)
       {
-        case E_K_COMM_STATUS_OK:
-        {
-          commCoapGetResponse(gCommInterfaceObj.pResponseBuffer,
-                              responseBufferLength,
-                              gCommInterfaceObj.pCoapHandle,
-                              &isPayloadFreeRequired);
-        }
-        break;
-
-        case E_K_COMM_STATUS_NETWORK:
-        {
-          /* Network not available. */
-          M_COMM__ERROR(("salSocketReceiveFrom Failed E_K_COMM_STATUS_NETWORK"));
-          gCommInterfaceObj.exchangeStatus = E_K_COMM_STATUS_NETWORK;
-          gCommInterfaceObj.isExchangeTerminated = E_TRUE;
-        }
-        break;
-
-        case E_K_COMM_STATUS_MISSING:
-        {
-          M_COMM__ERROR(("salSocketReceiveFrom Failed E_K_COMM_STATUS_MISSING"));
-
-          /* No data available, resending */
-          if (gCommInterfaceObj.maxRetries > 0u)
-          {
-            --gCommInterfaceObj.maxRetries;
-            M_COMM__INFO(("Retry Count%d", gCommInterfaceObj.maxRetries));
-            commCoapWaitForData(gCommInterfaceObj.pCoapHandle);
-          }
-          else
-          {
-            /* Max retry reached, break the communication. */
-            gCommInterfaceObj.exchangeStatus = E_K_COMM_STATUS_RESOURCE;
-            gCommInterfaceObj.isExchangeTerminated = E_TRUE;
-            M_COMM__ERROR(("Max Retry Count reached%d Stopping.", gCommInterfaceObj.maxRetries));
-          }
-
-          M_COMM__INFO(("sn_coap_protocol_exec %d", status));
-        }
-        break;
-
-        case E_K_COMM_STATUS_ERROR:
-        default:
-        {
-          M_COMM__ERROR(("Unknow status code %d", status));
-          gCommInterfaceObj.isExchangeTerminated = E_TRUE;
-          gCommInterfaceObj.exchangeStatus = E_K_COMM_STATUS_DATA;
-        }
-        break;
+        gCommInterfaceObj.isPolling = E_TRUE;
+        commStatus = commCoapPoll(C_COMM_INTERFACE_COAP_POLL_SLICE);
+        gCommInterfaceObj.isPolling = E_FALSE;
+        (void)pthread_cond_broadcast(&gCommInterfacePolled);
       }
+      else
+      {
+        (void)pthread_cond_wait(&gCommInterfacePolled, &gCommInterfaceLock);
+      }
+#else
+      commStatus = commCoapPoll(C_COMM_INTERFACE_COAP_POLL_SLICE);
+#endif
+    }
 
-#ifdef ENABLE_COMM_COAP_PACKET_DEBUG_PRINTS
-      debugPrintBufferInHex(gCommInterfaceObj.pResponseBuffer, responseBufferLength);
-#endif /* ENABLE_COMM_COAP_PACKET_DEBUG_PRINTS */
-    } while (E_FALSE == gCommInterfaceObj.isExchangeTerminated);
-
-    commStatus = commConvertError(gCommInterfaceObj.exchangeStatus);
-
-    if (E_K_COMM_STATUS_OK == gCommInterfaceObj.exchangeStatus)
+    if (E_TRUE == blockingExchange.isCompleted)
     {
-      *xpReceiveMsgBufferLength = copyPayloadToMessageBuffer(xpReceiveMsgBuffer,
-                                                             *xpReceiveMsgBufferLength,
-                                                             isPayloadFreeRequired);
-      break;
+      commStatus = blockingExchange.status;
     }
 
-    *xpReceiveMsgBufferLength = 0;
+    *xpReceiveMsgBufferLength = blockingExchange.receivedLength;
     break;
   }
 
-  /* Free blockwise messages memory. */
-  sn_coap_protocol_clear_sent_blockwise_messages(gCommInterfaceObj.pCoapHandle);
-  sn_coap_protocol_clear_received_blockwise_messages(gCommInterfaceObj.pCoapHandle);
-  sn_coap_protocol_clear_retransmission_buffer(gCommInterfaceObj.pCoapHandle);
+  M_COMM_INTERFACE_UNLOCK();
 
   M_COMM__API_END();
 
   return commStatus;
 }
 
-/* -------------------------------------------------------------------------- */
-/* LOCAL FUNCTIONS - IMPLEMENTATION                                           */
-/* -------------------------------------------------------------------------- */
-
-#ifdef ENABLE_COMM_COAP_PACKET_DEBUG_PRINTS
 /**
- * @implements debugPrintBufferInHex
+ * @brief  implement commExchangeSubmit
  *
  */
-static void debugPrintBufferInHex
+TCommIfStatus commExchangeSubmit
 (
-  const uint8_t*  xpBuffer,
-  const size_t  xBufferLength
+  const  uint8_t*  xpMessageToSend,
+  const  size_t    xSendSize,
+  uint8_t*         xpReceiveMsgBuffer,
+  const size_t     xReceiveMsgBufferLength,
+  TCommExchangeCb  xCallback,
+  void*            xpArg
 )
 {
-  size_t loopCount;
+  TCommIfStatus   commStatus = E_COMM_IF_STATUS_ERROR;
+  TKCommStatus    status = E_K_COMM_STATUS_OK;
+  TCommExchange*  pExchange = NULL;
+  uint32_t        index = 0;
 
-  M_COMM__INFO(("======================================"));
-  M_COMM__INFO(("Hex "));
+  M_COMM__API_START();
 
-  for (loopCount = 0; loopCount < xBufferLength; loopCount++)
-  {
-    M_COMM_LOG(("%02X", (int)xpBuffer[loopCount]));
-  }
+  M_COMM_INTERFACE_LOCK();
+
+  for (;;)
+  {
+    if (
+      (NULL == xpMessageToSend) ||
+      (0U == xSendSize) ||
+      (NULL == xpReceiveMsgBuffer) ||
+      (0U == xReceiveMsgBufferLength) ||
+      (NULL == xCallback) ||
+      (E_FALSE == gCommInterfaceObj.isInitialized)
+    )
+    {
+      M_COMM__ERROR(("Invalid paramertes or not initialized"));
+      commStatus = E_COMM_IF_STATUS_PARAMETER;
+      break;
+    }
+
+    for (index = 0; index < C_COMM_IF__MAX_EXCHANGES; index++)
+    {
+      if (E_FALSE == gCommInterfaceObj.aExchanges[index].isExchangePending)
+      {
+        pExchange = &gCommInterfaceObj.aExchanges[index];
+        break;
+      }
+    }
+
+    if (NULL == pExchange)
+    {
+      M_COMM__ERROR(("Max exchanges [%d] in progress", C_COMM_IF__MAX_EXCHANGES));
+      commStatus = E_COMM_IF_STATUS_ERROR;
+      break;
+    }
+
+    /* A token no pending exchange uses, the responses are routed by it. */
+    do
+    {
+      status = salRandomGet(pExchange->aToken, C_COMM_INTERFACE_COAP_TOKEN_LENGTH);
+    } while ((E_K_COMM_STATUS_OK == status) &&
+             (NULL != pCommCoapFindExchange(pExchange->aToken,
+                                            C_COMM_INTERFACE_COAP_TOKEN_LENGTH)));
+
+    if (E_K_COMM_STATUS_OK != status)
+    {
+      M_COMM__ERROR(("salRandomGet failed"));
+      commStatus = commConvertError(status);
+      break;
+    }
+
+    pExchange->maxRetries = C_COMM_INTERFACE_COAP_MAX_RESENDING_RETRIES;
+    pExchange->lastRecivedMessageId = 0;
+    pExchange->isPayloadFreeRequired = E_FALSE;
+
+#if defined(ENABLE_COMM_POOL) && (0 == SN_COAP_DUPLICATION_MAX_MSGS_COUNT)
+    /* What the CoAP stack allocates from now on must be freed once no exchange is pending. */
+    if ((0u == gCommInterfaceObj.pendingCount) &&
+        (E_FALSE == commPoolArenaBegin(&gCommInterfacePool)))
+    {
+      M_COMM__ERROR(("Arena of the previous exchanges still open"));
+    }
+#endif /* ENABLE_COMM_POOL && SN_COAP_DUPLICATION_MAX_MSGS_COUNT */
+
+    status = commCoapBuildAndSendMessage(pExchange, xpMessageToSend, xSendSize);
+
+    if (E_K_COMM_STATUS_OK != status)
+    {
+      M_COMM__ERROR(("commCoapBuildAndSendMessage Failed %d", status));
+      commStatus = commConvertError(status);
+
+      (void)sn_coap_protocol_delete_retransmission_by_token(gCommInterfaceObj.pCoapHandle,
+                                                            pExchange->aToken,
+                                                            C_COMM_INTERFACE_COAP_TOKEN_LENGTH);
+
+      if (0u == gCommInterfaceObj.pendingCount)
+      {
+        commCoapReleaseExchangesMemory();
+      }
+
+      break;
+    }
+
+    M_COMM__INFO(("First message send successfully"));
+    pExchange->isExchangeTerminated = E_FALSE;
+    pExchange->exchangeStatus = E_K_COMM_STATUS_ERROR;
+    pExchange->pReceiveMsgBuffer = xpReceiveMsgBuffer;
+    pExchange->receiveMsgBufferLength = xReceiveMsgBufferLength;
+    pExchange->exchangeCallback = xCallback;
+    pExchange->pExchangeArg = xpArg;
+    pExchange->isExchangePending = E_TRUE;
+    gCommInterfaceObj.pendingCount++;
+
+    commTimerArm(&gCommInterfaceObj.timerWheel,
+                 &pExchange->idleTimer,
+                 salTimeGetRelative(),
+                 getExchangeIdleTimeout(),
+                 commCoapIdleTimerCb,
+                 pExchange);
+    commCoapArmRetransmissionTimer(salTimeGetRelative());
+
+    commStatus = E_COMM_IF_STATUS_OK;
+    break;
+  }
+
+  M_COMM_INTERFACE_UNLOCK();
+
+  M_COMM__API_END();
+
+  return commStatus;
+}
+
+/**
+ * @brief  implement commExchangePoll
+ *
+ */
+TCommIfStatus commExchangePoll
+(
+  const uint32_t  xTimeoutMs
+)
+{
+  TCommIfStatus   commStatus = E_COMM_IF_STATUS_ERROR;
+
+  M_COMM__API_START();
+
+  M_COMM_INTERFACE_LOCK();
+
+  if (E_FALSE == gCommInterfaceObj.isInitialized)
+  {
+    M_COMM__ERROR(("Not initialized"));
+    commStatus = E_COMM_IF_STATUS_PARAMETER;
+  }
+  else
+  {
+    commStatus = commCoapPoll(xTimeoutMs);
+  }
+
+  M_COMM_INTERFACE_UNLOCK();
+
+  M_COMM__API_END();
+
+  return commStatus;
+}
+
+/**
+ * @brief  implement commMemoryGetStats
+ *
+ */
+TCommIfStatus commMemoryGetStats
+(
+  struct SCommPoolStats*  xpStats
+)
+{
+  TCommIfStatus  commStatus = E_COMM_IF_STATUS_PARAMETER;
+
+  if (NULL != xpStats)
+  {
+#ifdef ENABLE_COMM_POOL
+    M_COMM_INTERFACE_LOCK();
+    commPoolGetStats(&gCommInterfacePool, xpStats);
+    M_COMM_INTERFACE_UNLOCK();
+#else
+    (void)memset(xpStats, 0, sizeof(TCommPoolStats));
+#endif /* ENABLE_COMM_POOL */
+    commStatus = E_COMM_IF_STATUS_OK;
+  }
+
+  return commStatus;
+}
+
+/**
+ * @brief  implement commRttGetEstimate
+ *
+ */
+TCommIfStatus commRttGetEstimate
+(
+  struct sn_coap_rto_*  xpEstimate
+)
+{
+  TCommIfStatus  commStatus = E_COMM_IF_STATUS_PARAMETER;
+
+  if (NULL != xpEstimate)
+  {
+    M_COMM_INTERFACE_LOCK();
+
+    if ((E_TRUE == gCommInterfaceObj.isInitialized) &&
+        (0 == sn_coap_protocol_get_rto(gCommInterfaceObj.pCoapHandle,
+                                       &gCommInterfaceObj.dstAddress,
+                                       xpEstimate)))
+    {
+      commStatus = E_COMM_IF_STATUS_OK;
+    }
+    else
+    {
+      commStatus = E_COMM_IF_STATUS_ERROR;
+    }
+
+    M_COMM_INTERFACE_UNLOCK();
+  }
+
+  return commStatus;
+}
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL FUNCTIONS - IMPLEMENTATION                                           */
+/* -------------------------------------------------------------------------- */
+
+#ifdef ENABLE_COMM_COAP_PACKET_DEBUG_PRINTS
+/**
+ * @implements debugPrintBufferInHex
+ *
+ */
+static void debugPrintBufferInHex
+(
+  const uint8_t*  xpBuffer,
+  const size_t  xBufferLength
+)
+{
+  size_t loopCount;
+
+  M_COMM__INFO(("======================================"));
+  M_COMM__INFO(("Hex "));
+
+  for (loopCount = 0; loopCount < xBufferLength; loopCount++)
+  {
+    M_COMM_LOG(("%02X", (int)xpBuffer[loopCount]));
+  }
 
   M_COMM__INFO(("======================================"));
 }
@@ -902,7 +1434,18 @@ static void* pCommCoapMalloc
   uint16_t xSize
 )
 {
-  return kta_pSalMemoryAllocate(xSize);
+  void*  pBlock = NULL;
+
+#ifdef ENABLE_COMM_POOL
+  pBlock = pCommPoolAlloc(&gCommInterfacePool, xSize);
+#endif /* ENABLE_COMM_POOL */
+
+  if (NULL == pBlock)
+  {
+    pBlock = kta_pSalMemoryAllocate(xSize);
+  }
+
+  return pBlock;
 }
 
 /**
@@ -914,7 +1457,14 @@ static void commCoapFree
   void* xpAddr
 )
 {
+#ifdef ENABLE_COMM_POOL
+  if (E_FALSE == commPoolFree(&gCommInterfacePool, xpAddr))
+  {
+    salMemoryFree(xpAddr);
+  }
+#else
   salMemoryFree(xpAddr);
+#endif /* ENABLE_COMM_POOL */
 }
 
 /**
@@ -942,6 +1492,14 @@ static uint8_t commCoapTxCb
                                  xpSendBuffer,
                                  xSendBufferSize,
                                  &gCommInterfaceObj.socketIP);
+
+  /* The path MTU is below the datagram, the next ones are built in smaller blocks. */
+  if (E_K_COMM_STATUS_RESOURCE == socketStatus)
+  {
+    M_COMM__ERROR(("Message too big for the path Size %d", xSendBufferSize));
+    commCoapLowerBlockSize((uint16_t)(gCommInterfaceObj.coapBlockSize >> 1));
+  }
+
   M_COMM__API_END();
   M_UNUSED(xpDstAddress);
   M_UNUSED(xpUserData);
@@ -978,8 +1536,15 @@ static void terminateCoapProtocol
 {
   M_COMM__API_START();
 
+  commCoapCompleteAllExchanges(E_K_COMM_STATUS_ERROR);
+
   if (NULL != gCommInterfaceObj.pCoapHandle)
   {
+    if (E_TRUE == gCommInterfaceObj.isInitialized)
+    {
+      commCoapSaveRttEstimate();
+    }
+
     sn_coap_protocol_destroy(gCommInterfaceObj.pCoapHandle);
     gCommInterfaceObj.pCoapHandle = NULL;
   }
@@ -1016,13 +1581,13 @@ static void terminateCoapProtocol
  */
 static sn_coap_hdr_s* pGetDefaultCoapHeader
 (
-  const uint16_t  xPayloadLen,
-  const uint8_t*  xpPayload
+  const TCommExchange*  xpExchange,
+  const uint16_t        xPayloadLen,
+  const uint8_t*        xpPayload
 )
 {
   uint8_t*        pCoapUriPath  = NULL;
   sn_coap_hdr_s*  pCoapHeader   = NULL;
-  uint32_t        coapToken     = 0;
   TKCommStatus    status        = E_K_COMM_STATUS_ERROR;
   const uint8_t*  pCoapUri      = gCommInterfaceObj.pCoapUri;
   const uint16_t  coapUriLength = gCommInterfaceObj.coapUriLength;
@@ -1031,17 +1596,6 @@ static sn_coap_hdr_s* pGetDefaultCoapHeader
 
   for (;;)
   {
-    status = salRandomGet((unsigned char*)&coapToken, sizeof(coapToken));
-
-    if (E_K_COMM_STATUS_OK != status)
-    {
-      M_COMM__ERROR(("salRandomGet failed"));
-      break;
-    }
-
-    status = E_K_COMM_STATUS_ERROR;
-
-    M_COMM__INFO(("Coap Token Value %u", coapToken));
     pCoapHeader = (sn_coap_hdr_s*)M_COMM_INTERFACE_MALLOC(sizeof(sn_coap_hdr_s));
 
     if (NULL == pCoapHeader)
@@ -1069,7 +1623,7 @@ static sn_coap_hdr_s* pGetDefaultCoapHeader
     pCoapHeader->payload_len = xPayloadLen;                 /* Body length. */
     pCoapHeader->payload_ptr = (uint8_t*)xpPayload;         /* Body pointer. */
     pCoapHeader->options_list_ptr = 0;                      /* Optional: options list. */
-    pCoapHeader->token_len = sizeof(coapToken);
+    pCoapHeader->token_len = C_COMM_INTERFACE_COAP_TOKEN_LENGTH;
     pCoapHeader->token_ptr = M_COMM_INTERFACE_MALLOC(pCoapHeader->token_len);
 
     if (NULL == pCoapHeader->token_ptr)
@@ -1078,7 +1632,8 @@ static sn_coap_hdr_s* pGetDefaultCoapHeader
       break;
     }
 
-    (void)memcpy(pCoapHeader->token_ptr, &coapToken, pCoapHeader->token_len);
+    /* Every request of an exchange carries its token, the responses are routed by it. */
+    (void)memcpy(pCoapHeader->token_ptr, xpExchange->aToken, pCoapHeader->token_len);
 
     /* Message ID is used to track request->response patterns, because we're
      * using UDP (so everything is unconfirmed).
@@ -1142,13 +1697,20 @@ static uint16_t getCoapBlockSizeUsingMtu
   uint16_t aBlockSizeArray[] = {16, 32, 64, 128, 256, 512, 1024};
   uint32_t blockIndex = 0;
   uint32_t blockEndIndex = sizeof(aBlockSizeArray) / sizeof(aBlockSizeArray[0]) - 1U;
+  size_t   overhead = C_COMM_INTERFACE_COAP_BLOCK_HEADER_SIZE + gCommInterfaceObj.coapUriLength;
+  size_t   payloadSize = 0;
 
   M_COMM__API_START();
 
-  /* Pick the nearest coap block size for the received MTU size. */
-  for (blockIndex = blockEndIndex; blockIndex >= 0U; --blockIndex)
+  /* A block travels with the IP, UDP and CoAP headers in one datagram. */
+  overhead += (SN_NSDL_ADDRESS_TYPE_IPV6 == gCommInterfaceObj.dstAddress.type) ?
+              C_COMM_INTERFACE_IPV6_UDP_HEADER_SIZE : C_COMM_INTERFACE_IPV4_UDP_HEADER_SIZE;
+  payloadSize = (xMtuValue > overhead) ? (xMtuValue - overhead) : 0U;
+
+  /* Pick the largest coap block size fitting in the payload room. */
+  for (blockIndex = blockEndIndex; blockIndex > 0U; --blockIndex)
   {
-    if (xMtuValue >= aBlockSizeArray[blockIndex])
+    if (payloadSize >= aBlockSizeArray[blockIndex])
     {
       break;
     }
@@ -1161,6 +1723,82 @@ static uint16_t getCoapBlockSizeUsingMtu
   return aBlockSizeArray[blockIndex];
 }
 
+/**
+ * @implements commCoapLowerBlockSize
+ *
+ */
+static void commCoapLowerBlockSize
+(
+  const uint16_t  xBlockSize
+)
+{
+  uint16_t blockSize = C_COMM_INTERFACE_COAP_MIN_BLOCK_SIZE;
+
+  M_COMM__API_START();
+
+  /* Round down to a valid block size. */
+  while ((blockSize << 1) <= xBlockSize)
+  {
+    blockSize <<= 1;
+  }
+
+  if (blockSize < gCommInterfaceObj.coapBlockSize)
+  {
+    M_COMM__INFO(("Block Size lowered from %d to %d", gCommInterfaceObj.coapBlockSize, blockSize));
+    gCommInterfaceObj.coapBlockSize = blockSize;
+  }
+
+  M_COMM__API_END();
+}
+
+/**
+ * @implements commCoapAdoptServerBlockSize
+ *
+ */
+static void commCoapAdoptServerBlockSize
+(
+  const sn_coap_hdr_s*  xpCoapResponse
+)
+{
+  const sn_coap_options_list_s* pOptionList = xpCoapResponse->options_list_ptr;
+
+  M_COMM__API_START();
+
+  for (;;)
+  {
+    if (NULL == pOptionList)
+    {
+      break;
+    }
+
+    if (COAP_OPTION_BLOCK_NONE != pOptionList->block1)
+    {
+      commCoapLowerBlockSize((uint16_t)(C_COMM_INTERFACE_COAP_MIN_BLOCK_SIZE <<
+                                        ((uint32_t)pOptionList->block1 & 0x07u)));
+    }
+
+    if (COAP_OPTION_BLOCK_NONE != pOptionList->block2)
+    {
+      commCoapLowerBlockSize((uint16_t)(C_COMM_INTERFACE_COAP_MIN_BLOCK_SIZE <<
+                                        ((uint32_t)pOptionList->block2 & 0x07u)));
+    }
+
+    /* Size1 of a 4.13 is the largest body the server accepts in one message. */
+    if (
+      (COAP_MSG_CODE_RESPONSE_REQUEST_ENTITY_TOO_LARGE == xpCoapResponse->msg_code) &&
+      (true == pOptionList->use_size1) &&
+      (pOptionList->size1 < gCommInterfaceObj.coapBlockSize)
+    )
+    {
+      commCoapLowerBlockSize((uint16_t)pOptionList->size1);
+    }
+
+    break;
+  }
+
+  M_COMM__API_END();
+}
+
 /**
  * @implements getCoapResendingCount
  *
@@ -1191,6 +1829,82 @@ static uint8_t getCoapResendingInterval
   return C_COMM_INTERFACE_COAP_RESENDING_INTERVAL_IN_SECS;
 }
 
+/**
+ * @implements getExchangeIdleTimeout
+ *
+ */
+static uint32_t getExchangeIdleTimeout
+(
+  void
+)
+{
+  sn_coap_rto_s  estimate;
+  uint32_t       idleTimeout = C_COMM_INTERFACE_COAP_EXCHANGE_IDLE_TIMEOUT;
+
+  /* A slow link must not stop the exchange before the server had a chance to answer. */
+  if ((0 == sn_coap_protocol_get_rto(gCommInterfaceObj.pCoapHandle,
+                                     &gCommInterfaceObj.dstAddress,
+                                     &estimate)) &&
+      (estimate.rto > (idleTimeout / C_COMM_INTERFACE_COAP_EXCHANGE_IDLE_RTO_COUNT)))
+  {
+    idleTimeout = estimate.rto * C_COMM_INTERFACE_COAP_EXCHANGE_IDLE_RTO_COUNT;
+  }
+
+  return idleTimeout;
+}
+
+/**
+ * @implements commCoapSaveRttEstimate
+ *
+ */
+static void commCoapSaveRttEstimate
+(
+  void
+)
+{
+  sn_coap_rto_s  estimate;
+
+  if ((gCommInterfaceObj.dstAddress.addr_len <= C_COMM_INTERFACE_MAX_IP_ADDRESS_LENGTH) &&
+      (0 == sn_coap_protocol_get_rto(gCommInterfaceObj.pCoapHandle,
+                                     &gCommInterfaceObj.dstAddress,
+                                     &estimate)))
+  {
+    M_COMM__INFO(("RTO %u ms, SRTT %u ms from %u samples",
+                  (unsigned int)estimate.rto,
+                  (unsigned int)estimate.srtt_strong,
+                  (unsigned int)estimate.strong_samples));
+    (void)memcpy(gCommInterfaceRtt.aServerIp,
+                 gCommInterfaceObj.dstAddress.addr_ptr,
+                 gCommInterfaceObj.dstAddress.addr_len);
+    gCommInterfaceRtt.serverIpLength = gCommInterfaceObj.dstAddress.addr_len;
+    gCommInterfaceRtt.serverPort = gCommInterfaceObj.dstAddress.port;
+    gCommInterfaceRtt.estimate = estimate;
+    gCommInterfaceRtt.isValid = E_TRUE;
+  }
+}
+
+/**
+ * @implements commCoapRestoreRttEstimate
+ *
+ */
+static void commCoapRestoreRttEstimate
+(
+  void
+)
+{
+  if ((E_TRUE == gCommInterfaceRtt.isValid) &&
+      (gCommInterfaceRtt.serverPort == gCommInterfaceObj.dstAddress.port) &&
+      (gCommInterfaceRtt.serverIpLength == gCommInterfaceObj.dstAddress.addr_len) &&
+      (0 == memcmp(gCommInterfaceRtt.aServerIp,
+                   gCommInterfaceObj.dstAddress.addr_ptr,
+                   gCommInterfaceRtt.serverIpLength)))
+  {
+    (void)sn_coap_protocol_set_rto(gCommInterfaceObj.pCoapHandle,
+                                   &gCommInterfaceObj.dstAddress,
+                                   &gCommInterfaceRtt.estimate);
+  }
+}
+
 /**
  * @implements getRelativeTimeInSec
  *
@@ -1215,6 +1929,7 @@ static uint32_t getRelativeTimeInSec
  */
 static TKCommStatus commCoapBuildAndSendMessage
 (
+  TCommExchange*  xpExchange,
   const uint8_t*  xpMessageToSend,
   const size_t    xSendSize
 )
@@ -1225,14 +1940,17 @@ static TKCommStatus commCoapBuildAndSendMessage
   uint16_t        txBufferSize = 0;
   int16_t         lengthAndStatus = -1;
   int8_t          coapStatus = -1;
+  uint16_t        sentBlockSize = 0;
+  TBoolean        isRebuilt = E_FALSE;
 
   M_COMM__API_START();
 
   for (;;)
   {
-    gCommInterfaceObj.isExchangeTerminated = E_FALSE;
+    xpExchange->isExchangeTerminated = E_FALSE;
+    sentBlockSize = gCommInterfaceObj.coapBlockSize;
 
-    pCoapResponsePtr = pGetDefaultCoapHeader(xSendSize, xpMessageToSend);
+    pCoapResponsePtr = pGetDefaultCoapHeader(xpExchange, xSendSize, xpMessageToSend);
 
     if (NULL == pCoapResponsePtr)
     {
@@ -1297,6 +2015,28 @@ static TKCommStatus commCoapBuildAndSendMessage
 
     /* Sending message to the server. */
     status = commCoapTxCb(pTxMessageBuffer, txBufferSize, NULL, NULL);
+
+    /* The path refused the datagram: forget it and build the message once more, in the
+     * smaller blocks the Tx callback has chosen. */
+    if (
+      (E_K_COMM_STATUS_RESOURCE == status) &&
+      (E_FALSE == isRebuilt) &&
+      (gCommInterfaceObj.coapBlockSize < sentBlockSize)
+    )
+    {
+      (void)sn_coap_protocol_delete_retransmission(gCommInterfaceObj.pCoapHandle,
+                                                   pCoapResponsePtr->msg_id);
+      sn_coap_protocol_remove_sent_blockwise_message(gCommInterfaceObj.pCoapHandle,
+                                                     pCoapResponsePtr->msg_id);
+      sn_coap_parser_release_allocated_coap_msg_mem(gCommInterfaceObj.pCoapHandle,
+                                                    pCoapResponsePtr);
+      pCoapResponsePtr = NULL;
+      M_COMM_INTERFACE_FREE(pTxMessageBuffer);
+      pTxMessageBuffer = NULL;
+      isRebuilt = E_TRUE;
+      continue;
+    }
+
     break;
   }
 
@@ -1315,7 +2055,8 @@ static TKCommStatus commCoapBuildAndSendMessage
  */
 static TKCommStatus commCoapPrepareAndSendBlock2Message
 (
-  const int32_t  xBlock2
+  const TCommExchange*  xpExchange,
+  const int32_t         xBlock2
 )
 {
   TKCommStatus             status = E_K_COMM_STATUS_ERROR;
@@ -1327,12 +2068,13 @@ static TKCommStatus commCoapPrepareAndSendBlock2Message
   int16_t                  coapStatus = 0;
   int16_t                  lengthAndStatus = -1;
   uint8_t                  blockTemp = 0;
+  int8_t                   ownBlockTemp = -1;
 
   M_COMM__API_START();
 
   for (;;)
   {
-    pCoapResponsePtr = pGetDefaultCoapHeader(0, NULL);
+    pCoapResponsePtr = pGetDefaultCoapHeader(xpExchange, 0, NULL);
 
     if (NULL == pCoapResponsePtr)
     {
@@ -1362,6 +2104,15 @@ static TKCommStatus commCoapPrepareAndSendBlock2Message
     blockTemp = ((uint8_t)xBlock2 & 0x07u);
     blockNumber = ((uint32_t)xBlock2 >> 4u);
     blockNumber++;
+    ownBlockTemp = sn_coap_convert_block_size(gCommInterfaceObj.coapBlockSize);
+
+    /* Ask the next blocks in our own size when the server's does not fit the path. */
+    if ((ownBlockTemp >= 0) && (blockTemp > (uint8_t)ownBlockTemp))
+    {
+      blockNumber <<= (blockTemp - (uint8_t)ownBlockTemp);
+      blockTemp = (uint8_t)ownBlockTemp;
+    }
+
     pOptionList->block2 = (blockNumber << 4) | blockTemp;
 
     txBufferSize = sn_coap_builder_calc_needed_packet_data_size_2(
@@ -1487,109 +2238,511 @@ static TCommIfStatus commConvertError
 }
 
 /**
- * @implements commCoapWaitForData
+ * @implements commCoapArmRetransmissionTimer
  *
  */
-static void commCoapWaitForData
+static void commCoapArmRetransmissionTimer
 (
-  struct coap_s*  xpCoapHandle
+  const uint32_t  xNowMs
+)
+{
+  TBoolean  isFound = E_FALSE;
+  uint32_t  resendingTime = 0;
+  uint32_t  deadlineMs = 0;
+
+#if ENABLE_RESENDINGS
+  ns_list_foreach(coap_send_msg_s,
+                  pStoredMsg,
+                  &gCommInterfaceObj.pCoapHandle->linked_list_resent_msgs)
+  {
+    if ((E_FALSE == isFound) || ((int32_t)(pStoredMsg->resending_time - resendingTime) < 0))
+    {
+      resendingTime = pStoredMsg->resending_time;
+      isFound = E_TRUE;
+    }
+  }
+#endif /* ENABLE_RESENDINGS */
+
+  if (E_TRUE == isFound)
+  {
+#if SN_COAP_ADAPTIVE_RTO
+    /* The CoAP stack counts in ms of salTimeGetRelative(). */
+    deadlineMs = resendingTime;
+#else
+    /* The CoAP stack counts in seconds, a message is due once the second is reached. */
+    deadlineMs = resendingTime * 1000u;
+#endif /* SN_COAP_ADAPTIVE_RTO */
+    commTimerArm(&gCommInterfaceObj.timerWheel,
+                 &gCommInterfaceObj.retransmissionTimer,
+                 xNowMs,
+                 ((int32_t)(deadlineMs - xNowMs) > 0) ? (deadlineMs - xNowMs) : 1u,
+                 commCoapRetransmissionTimerCb,
+                 NULL);
+  }
+  else
+  {
+    commTimerCancel(&gCommInterfaceObj.timerWheel, &gCommInterfaceObj.retransmissionTimer);
+  }
+}
+
+/**
+ * @implements commCoapRetransmissionTimerCb
+ *
+ */
+static void commCoapRetransmissionTimerCb
+(
+  void*  xpArg
+)
+{
+  int8_t  execStatus = -1;
+
+  M_COMM__API_START();
+
+  execStatus = sn_coap_protocol_exec(gCommInterfaceObj.pCoapHandle, getRelativeTimeInSec());
+
+  if (0 == execStatus)
+  {
+    commCoapArmRetransmissionTimer(salTimeGetRelative());
+  }
+  else
+  {
+    M_COMM__ERROR(("sn_coap_protocol_exec - invalid behaviour"));
+    commCoapCompleteAllExchanges(E_K_COMM_STATUS_RESOURCE);
+  }
+
+  M_UNUSED(xpArg);
+  M_COMM__API_END();
+}
+
+/**
+ * @implements commCoapIdleTimerCb
+ *
+ */
+static void commCoapIdleTimerCb
+(
+  void*  xpArg
+)
+{
+  TCommExchange*  pExchange = (TCommExchange*)xpArg;
+
+  M_COMM__ERROR(("No response for %u ms Stopping.", (unsigned int)getExchangeIdleTimeout()));
+  pExchange->exchangeStatus = E_K_COMM_STATUS_RESOURCE;
+  pExchange->isExchangeTerminated = E_TRUE;
+  commCoapCompleteExchange(pExchange);
+}
+
+/**
+ * @implements commCoapBlock2TimerCb
+ *
+ */
+static void commCoapBlock2TimerCb
+(
+  void*  xpArg
 )
 {
-  uint32_t  currentTime = 0;
-  int8_t    execStatus = -1;
+  TCommExchange*  pExchange = (TCommExchange*)xpArg;
+
+  commCoapRetrySendBlock2(pExchange, pExchange->pendingBlock2);
+
+  if (E_TRUE == pExchange->isExchangeTerminated)
+  {
+    commCoapCompleteExchange(pExchange);
+  }
+  else
+  {
+    commCoapArmRetransmissionTimer(salTimeGetRelative());
+  }
+}
+
+/**
+ * @implements commCoapCompleteExchange
+ *
+ */
+static void commCoapCompleteExchange
+(
+  TCommExchange*  xpExchange
+)
+{
+  TCommExchangeCb  callback = xpExchange->exchangeCallback;
+  void*            pArg = xpExchange->pExchangeArg;
+  TCommIfStatus    commStatus = commConvertError(xpExchange->exchangeStatus);
+  size_t           receivedLength = 0;
 
   M_COMM__API_START();
 
-  if ((NULL != xpCoapHandle) && (E_TRUE == gCommInterfaceObj.isInitialized))
+  if (E_K_COMM_STATUS_OK == xpExchange->exchangeStatus)
   {
-    currentTime = getRelativeTimeInSec();
-    execStatus = sn_coap_protocol_exec(xpCoapHandle, currentTime);
+    receivedLength = copyPayloadToMessageBuffer(xpExchange,
+                                                xpExchange->pReceiveMsgBuffer,
+                                                xpExchange->receiveMsgBufferLength,
+                                                xpExchange->isPayloadFreeRequired);
+  }
 
-    if (0 == execStatus)
+  /* A failed exchange may leave a partial response behind, the slot is reused. */
+  if (NULL != xpExchange->pFirstPayload)
+  {
+    M_COMM_INTERFACE_FREE(xpExchange->pFirstPayload);
+    xpExchange->pFirstPayload = NULL;
+  }
+
+  if ((NULL != xpExchange->pPayload) && (E_TRUE == xpExchange->isPayloadFreeRequired))
+  {
+    M_COMM_INTERFACE_FREE(xpExchange->pPayload);
+  }
+
+  xpExchange->pPayload = NULL;
+  xpExchange->firstPayloadLength = 0;
+  xpExchange->payloadLength = 0;
+
+  /* Only the messages of this exchange, the other ones are still in progress. */
+  (void)sn_coap_protocol_delete_retransmission_by_token(gCommInterfaceObj.pCoapHandle,
+                                                        xpExchange->aToken,
+                                                        C_COMM_INTERFACE_COAP_TOKEN_LENGTH);
+  commTimerCancel(&gCommInterfaceObj.timerWheel, &xpExchange->idleTimer);
+  commTimerCancel(&gCommInterfaceObj.timerWheel, &xpExchange->block2Timer);
+
+  xpExchange->isExchangePending = E_FALSE;
+  xpExchange->pReceiveMsgBuffer = NULL;
+  xpExchange->receiveMsgBufferLength = 0;
+  xpExchange->exchangeCallback = NULL;
+  xpExchange->pExchangeArg = NULL;
+  gCommInterfaceObj.pendingCount--;
+
+  if (0u == gCommInterfaceObj.pendingCount)
+  {
+    commCoapReleaseExchangesMemory();
+    commTimerCancel(&gCommInterfaceObj.timerWheel, &gCommInterfaceObj.retransmissionTimer);
+  }
+  else
+  {
+    commCoapArmRetransmissionTimer(salTimeGetRelative());
+  }
+
+  if (NULL != callback)
+  {
+    callback(pArg, commStatus, receivedLength);
+  }
+
+  M_COMM__API_END();
+}
+
+/**
+ * @implements commCoapCompleteAllExchanges
+ *
+ */
+static void commCoapCompleteAllExchanges
+(
+  const TKCommStatus  xStatus
+)
+{
+  uint32_t  index = 0;
+
+  for (index = 0; index < C_COMM_IF__MAX_EXCHANGES; index++)
+  {
+    if (E_TRUE == gCommInterfaceObj.aExchanges[index].isExchangePending)
     {
-      M_COMM__INFO(("wait for data - %d ms", C_COMM_INTERFACE_COAP_WAIT_FOR_RESPONSE));
-      salTimeMilliSleep(C_COMM_INTERFACE_COAP_WAIT_FOR_RESPONSE);
+      gCommInterfaceObj.aExchanges[index].exchangeStatus = xStatus;
+      gCommInterfaceObj.aExchanges[index].isExchangeTerminated = E_TRUE;
+      commCoapCompleteExchange(&gCommInterfaceObj.aExchanges[index]);
     }
-    else
+  }
+}
+
+/**
+ * @implements commCoapReleaseExchangesMemory
+ *
+ */
+static void commCoapReleaseExchangesMemory
+(
+  void
+)
+{
+  uint32_t  liveCount = 0;
+
+  /* mbed-coap only clears the blockwise messages for the whole handle. */
+  sn_coap_protocol_clear_sent_blockwise_messages(gCommInterfaceObj.pCoapHandle);
+  sn_coap_protocol_clear_received_blockwise_messages(gCommInterfaceObj.pCoapHandle);
+  sn_coap_protocol_clear_retransmission_buffer(gCommInterfaceObj.pCoapHandle);
+
+#if defined(ENABLE_COMM_POOL) && (0 == SN_COAP_DUPLICATION_MAX_MSGS_COUNT)
+  liveCount = commPoolArenaEnd(&gCommInterfacePool);
+#endif /* ENABLE_COMM_POOL && SN_COAP_DUPLICATION_MAX_MSGS_COUNT */
+
+  if (0u != liveCount)
+  {
+    M_COMM__ERROR(("%u blocks still allocated after the exchanges", liveCount));
+  }
+}
+
+/**
+ * @implements pCommCoapFindExchange
+ *
+ */
+static TCommExchange* pCommCoapFindExchange
+(
+  const uint8_t*  xpToken,
+  const uint8_t   xTokenLength
+)
+{
+  TCommExchange*  pExchange = NULL;
+  uint32_t        index = 0;
+
+  if ((NULL != xpToken) && (C_COMM_INTERFACE_COAP_TOKEN_LENGTH == xTokenLength))
+  {
+    for (index = 0; index < C_COMM_IF__MAX_EXCHANGES; index++)
     {
-      M_COMM__ERROR(("wait for data - invalid behaviour"));
-      gCommInterfaceObj.exchangeStatus = E_K_COMM_STATUS_RESOURCE;
-      gCommInterfaceObj.isExchangeTerminated = E_TRUE;
+      if (
+        (E_TRUE == gCommInterfaceObj.aExchanges[index].isExchangePending) &&
+        (0 == memcmp(gCommInterfaceObj.aExchanges[index].aToken,
+                     xpToken,
+                     C_COMM_INTERFACE_COAP_TOKEN_LENGTH))
+      )
+      {
+        pExchange = &gCommInterfaceObj.aExchanges[index];
+        break;
+      }
     }
   }
 
-  M_COMM__API_END();
+  return pExchange;
 }
 
 /**
- * @implements commCoapRetrySendBlock2
+ * @implements commCoapPoll
  *
  */
-static void commCoapRetrySendBlock2
+static TCommIfStatus commCoapPoll
 (
-  const int32_t  xBlock2
+  const uint32_t  xTimeoutMs
 )
 {
-  TKCommStatus  status = E_K_COMM_STATUS_ERROR;
+  TCommIfStatus   commStatus = E_COMM_IF_STATUS_OK;
+  TKCommStatus    status = E_K_COMM_STATUS_OK;
+  TKSocketIp      ip = {0};
+  TCommExchange*  pExchange = NULL;
+  TKSalSocket*    pSocket = gCommInterfaceObj.pSocket;
+  size_t          responseBufferLength = 0;
+  uint32_t        waitMs = 0;
 
   M_COMM__API_START();
 
-  gCommInterfaceObj.maxRetries = C_COMM_INTERFACE_COAP_MAX_RESENDING_RETRIES;
-
-  do
+  for (;;)
   {
-    status = commCoapPrepareAndSendBlock2Message(xBlock2);
+    if (0u == gCommInterfaceObj.pendingCount)
+    {
+      break;
+    }
+
+    /* Sleep until the socket is readable or the next timer expires, whichever comes first.
+     * Other threads may submit meanwhile, the lock is released. */
+    waitMs = commTimerWheelNextExpiry(&gCommInterfaceObj.timerWheel, salTimeGetRelative());
+    waitMs = (waitMs < xTimeoutMs) ? waitMs : xTimeoutMs;
+    M_COMM_INTERFACE_UNLOCK();
+    status = salSocketWaitReadable(pSocket, waitMs);
+    M_COMM_INTERFACE_LOCK();
+
+    if (E_FALSE == gCommInterfaceObj.isInitialized)
+    {
+      M_COMM__ERROR(("Terminated while polling"));
+      commStatus = E_COMM_IF_STATUS_ERROR;
+      break;
+    }
 
     if (E_K_COMM_STATUS_OK == status)
     {
-      M_COMM__INFO(("commCoapPrepareAndSendBlock2Message success"));
+      /* Handle every datagram already queued on the socket. */
+      do
+      {
+        responseBufferLength = gCommInterfaceObj.mtuSize;
+        status = salSocketReceiveFrom(gCommInterfaceObj.pSocket,
+                                      gCommInterfaceObj.pResponseBuffer,
+                                      &responseBufferLength,
+                                      &ip);
+
+        switch (status)
+        {
+          case E_K_COMM_STATUS_OK:
+          {
+            pExchange = pCommCoapGetResponse(gCommInterfaceObj.pResponseBuffer,
+                                             responseBufferLength,
+                                             gCommInterfaceObj.pCoapHandle);
+
+            if (NULL == pExchange)
+            {
+              /* Empty ack or late response of a completed exchange. */
+            }
+            else if (E_TRUE == pExchange->isExchangeTerminated)
+            {
+              commCoapCompleteExchange(pExchange);
+            }
+            else
+            {
+              commTimerArm(&gCommInterfaceObj.timerWheel,
+                           &pExchange->idleTimer,
+                           salTimeGetRelative(),
+                           getExchangeIdleTimeout(),
+                           commCoapIdleTimerCb,
+                           pExchange);
+            }
+
+            if (0u != gCommInterfaceObj.pendingCount)
+            {
+              commCoapArmRetransmissionTimer(salTimeGetRelative());
+            }
+          }
+          break;
+
+          case E_K_COMM_STATUS_MISSING:
+          {
+            /* Socket drained. */
+          }
+          break;
+
+          case E_K_COMM_STATUS_NETWORK:
+          {
+            /* Network not available. */
+            M_COMM__ERROR(("salSocketReceiveFrom Failed E_K_COMM_STATUS_NETWORK"));
+            commCoapCompleteAllExchanges(E_K_COMM_STATUS_NETWORK);
+          }
+          break;
+
+          case E_K_COMM_STATUS_ERROR:
+          default:
+          {
+            M_COMM__ERROR(("Unknow status code %d", status));
+            commCoapCompleteAllExchanges(E_K_COMM_STATUS_DATA);
+          }
+          break;
+        }
+
+#ifdef ENABLE_COMM_COAP_PACKET_DEBUG_PRINTS
+        debugPrintBufferInHex(gCommInterfaceObj.pResponseBuffer, responseBufferLength);
+#endif /* ENABLE_COMM_COAP_PACKET_DEBUG_PRINTS */
+      } while ((E_K_COMM_STATUS_OK == status) && (0u != gCommInterfaceObj.pendingCount));
+    }
+    else if (E_K_COMM_STATUS_MISSING != status)
+    {
+      M_COMM__ERROR(("salSocketWaitReadable Failed %d", status));
+      commCoapCompleteAllExchanges(status);
+      commStatus = commConvertError(status);
       break;
     }
+    else
+    {
+      /* Timeout, the expired timers are run below. */
+    }
+
+    commTimerWheelAdvance(&gCommInterfaceObj.timerWheel, salTimeGetRelative());
+    break;
+  }
+
+  M_COMM__API_END();
+
+  return commStatus;
+}
+
+#if defined(PARALLEL_COMMANDS_FEATURE) || defined(FLEET_MANAGEMENT_FEATURE)
+/**
+ * @implements commCoapInitLock
+ *
+ */
+static void commCoapInitLock
+(
+  void
+)
+{
+  pthread_mutexattr_t  attr;
+
+  (void)pthread_mutexattr_init(&attr);
+  (void)pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+  (void)pthread_mutex_init(&gCommInterfaceLock, &attr);
+  (void)pthread_mutexattr_destroy(&attr);
+  (void)pthread_cond_init(&gCommInterfacePolled, NULL);
+}
+#endif
+
+/**
+ * @implements commCoapBlockingExchangeCb
+ *
+ */
+static void commCoapBlockingExchangeCb
+(
+  void*                xpArg,
+  const TCommIfStatus  xStatus,
+  const size_t         xReceivedLength
+)
+{
+  TCommBlockingExchange*  pBlockingExchange = (TCommBlockingExchange*)xpArg;
+
+  pBlockingExchange->status = xStatus;
+  pBlockingExchange->receivedLength = xReceivedLength;
+  pBlockingExchange->isCompleted = E_TRUE;
+}
+
+/**
+ * @implements commCoapRetrySendBlock2
+ *
+ */
+static void commCoapRetrySendBlock2
+(
+  TCommExchange*  xpExchange,
+  const int32_t   xBlock2
+)
+{
+  TKCommStatus  status = E_K_COMM_STATUS_ERROR;
 
-    --gCommInterfaceObj.maxRetries;
-    salTimeMilliSleep(C_COMM_INTERFACE_COAP_WAIT_FOR_RESPONSE);
-  } while (gCommInterfaceObj.maxRetries > 0u);
+  M_COMM__API_START();
+
+  status = commCoapPrepareAndSendBlock2Message(xpExchange, xBlock2);
+  xpExchange->exchangeStatus = status;
 
-  if (0U == gCommInterfaceObj.maxRetries)
+  if (E_K_COMM_STATUS_OK == status)
   {
-    gCommInterfaceObj.isExchangeTerminated = E_TRUE;
-    gCommInterfaceObj.exchangeStatus = status;
-    M_COMM__ERROR(("Max Retry[%d] reached Status[%d]",
-                   C_COMM_INTERFACE_COAP_MAX_RESENDING_RETRIES, status));
+    M_COMM__INFO(("commCoapPrepareAndSendBlock2Message success"));
+    xpExchange->isExchangeTerminated = E_FALSE;
+    xpExchange->maxRetries = C_COMM_INTERFACE_COAP_MAX_RESENDING_RETRIES;
+  }
+  else if (xpExchange->maxRetries > 0u)
+  {
+    --xpExchange->maxRetries;
+    xpExchange->pendingBlock2 = xBlock2;
+    xpExchange->isExchangeTerminated = E_FALSE;
+    commTimerArm(&gCommInterfaceObj.timerWheel,
+                 &xpExchange->block2Timer,
+                 salTimeGetRelative(),
+                 C_COMM_INTERFACE_COAP_WAIT_FOR_RESPONSE,
+                 commCoapBlock2TimerCb,
+                 xpExchange);
   }
   else
   {
-    gCommInterfaceObj.isExchangeTerminated = E_FALSE;
-    gCommInterfaceObj.maxRetries = C_COMM_INTERFACE_COAP_MAX_RESENDING_RETRIES;
-    gCommInterfaceObj.exchangeStatus = status;
+    xpExchange->isExchangeTerminated = E_TRUE;
+    M_COMM__ERROR(("Max Retry[%d] reached Status[%d]",
+                   C_COMM_INTERFACE_COAP_MAX_RESENDING_RETRIES, status));
   }
 
   M_COMM__API_END();
 }
 
 /**
- * @implements commCoapGetResponse
+ * @implements pCommCoapGetResponse
  *
  */
-static void commCoapGetResponse
+static TCommExchange* pCommCoapGetResponse
 (
   uint8_t*        xpResponseBuffer,
   size_t          xResponseBufferLength,
-  struct coap_s*  xpCoapHandle,
-  TBoolean*       xpIsPayloadFreeRequired
+  struct coap_s*  xpCoapHandle
 )
 {
   sn_coap_hdr_s*  pCoapResponseData = NULL;
+  TCommExchange*  pExchange         = NULL;
   TKCommStatus    status            = E_K_COMM_STATUS_ERROR;
 
   M_COMM__API_START();
 
   for (;;)
   {
-    gCommInterfaceObj.isExchangeTerminated = E_TRUE;
-    *xpIsPayloadFreeRequired = E_FALSE;
-    gCommInterfaceObj.maxRetries = C_COMM_INTERFACE_COAP_MAX_RESENDING_RETRIES;
-
     pCoapResponseData = sn_coap_protocol_parse(xpCoapHandle,
                                                &gCommInterfaceObj.dstAddress,
                                                xResponseBufferLength,
@@ -1602,28 +2755,53 @@ static void commCoapGetResponse
       break;
     }
 
+    /* The token tells which exchange the response belongs to. */
+    pExchange = pCommCoapFindExchange(pCoapResponseData->token_ptr,
+                                       pCoapResponseData->token_len);
+
+    if (NULL == pExchange)
+    {
+      M_COMM__INFO(("No exchange for the message Ignoring"));
+      sn_coap_parser_release_allocated_coap_msg_mem(xpCoapHandle, pCoapResponseData);
+      break;
+    }
+
+    pExchange->isExchangeTerminated = E_TRUE;
+    pExchange->maxRetries = C_COMM_INTERFACE_COAP_MAX_RESENDING_RETRIES;
+
     /* Check for message duplication. */
-    if (gCommInterfaceObj.lastRecivedMessageId == pCoapResponseData->msg_id)
+    if (pExchange->lastRecivedMessageId == pCoapResponseData->msg_id)
     {
       M_COMM__ERROR(("Duplicate message detected Ignoring"));
-      gCommInterfaceObj.isExchangeTerminated = E_FALSE;
+      pExchange->isExchangeTerminated = E_FALSE;
       break;
     }
 
-    gCommInterfaceObj.lastRecivedMessageId = pCoapResponseData->msg_id;
+    pExchange->lastRecivedMessageId = pCoapResponseData->msg_id;
 
 #ifdef ENABLE_COMM_COAP_PACKET_DEBUG_PRINTS
     debugPrintCoapHeader(pCoapResponseData);
 #endif /* ENABLE_COMM_COAP_PACKET_DEBUG_PRINTS */
 
-    gCommInterfaceObj.exchangeStatus = E_K_COMM_STATUS_ERROR;
+    pExchange->exchangeStatus = E_K_COMM_STATUS_ERROR;
+    commCoapAdoptServerBlockSize(pCoapResponseData);
 
     switch (pCoapResponseData->coap_status)
     {
       case COAP_STATUS_OK:
       {
-        gCommInterfaceObj.isExchangeTerminated = E_TRUE;
-        gCommInterfaceObj.exchangeStatus = E_K_COMM_STATUS_OK;
+        pExchange->isExchangeTerminated = E_TRUE;
+        pExchange->exchangeStatus = E_K_COMM_STATUS_OK;
+
+        /* The server refused a request sent in one message, the next ones will fit its
+         * block size. */
+        if (COAP_MSG_CODE_RESPONSE_REQUEST_ENTITY_TOO_LARGE == pCoapResponseData->msg_code)
+        {
+          M_COMM__ERROR(("Request too large for the server Block Size %d",
+                         gCommInterfaceObj.coapBlockSize));
+          pExchange->exchangeStatus = E_K_COMM_STATUS_DATA;
+          break;
+        }
 
         /**
          * In some cases,the mbed-coap returns the first payload in the last response of the
@@ -1632,25 +2810,25 @@ static void commCoapGetResponse
          */
         if (pCoapResponseData->payload_len > 0)
         {
-          gCommInterfaceObj.pFirstPayload =
+          pExchange->pFirstPayload =
             (uint8_t*)M_COMM_INTERFACE_MALLOC(pCoapResponseData->payload_len);
 
-          if (NULL == gCommInterfaceObj.pFirstPayload)
+          if (NULL == pExchange->pFirstPayload)
           {
             M_COMM__ERROR(("Memory Alloc Failed Size[%d]", pCoapResponseData->payload_len));
-            gCommInterfaceObj.firstPayloadLength = 0;
-            gCommInterfaceObj.exchangeStatus = E_K_COMM_STATUS_MEMORY;
+            pExchange->firstPayloadLength = 0;
+            pExchange->exchangeStatus = E_K_COMM_STATUS_MEMORY;
           }
           else
           {
-            (void)memcpy(gCommInterfaceObj.pFirstPayload,
+            (void)memcpy(pExchange->pFirstPayload,
                          pCoapResponseData->payload_ptr,
                          pCoapResponseData->payload_len);
 
-            gCommInterfaceObj.firstPayloadLength = pCoapResponseData->payload_len;
+            pExchange->firstPayloadLength = pCoapResponseData->payload_len;
             M_COMM__INFO(("First Payload %p length %d",
-                          gCommInterfaceObj.pFirstPayload,
-                          gCommInterfaceObj.firstPayloadLength));
+                          pExchange->pFirstPayload,
+                          pExchange->firstPayloadLength));
           }
         }
 
@@ -1659,20 +2837,21 @@ static void commCoapGetResponse
           (COAP_OPTION_BLOCK_NONE != pCoapResponseData->options_list_ptr->block2)
         )
         {
-          gCommInterfaceObj.exchangeStatus = E_K_COMM_STATUS_ERROR;
+          pExchange->exchangeStatus = E_K_COMM_STATUS_ERROR;
 
           status = commCoapPrepareAndSendBlock2Message(
+                     pExchange,
                      pCoapResponseData->options_list_ptr->block2);
 
           if (E_K_COMM_STATUS_OK == status)
           {
-            gCommInterfaceObj.isExchangeTerminated = E_FALSE;
-            gCommInterfaceObj.maxRetries = C_COMM_INTERFACE_COAP_MAX_RESENDING_RETRIES;
+            pExchange->isExchangeTerminated = E_FALSE;
+            pExchange->maxRetries = C_COMM_INTERFACE_COAP_MAX_RESENDING_RETRIES;
           }
           else
           {
             M_COMM__ERROR(("commCoapPrepareAndSendBlock2Message Failed %d Retrying...", status));
-            commCoapRetrySendBlock2(pCoapResponseData->options_list_ptr->block2);
+            commCoapRetrySendBlock2(pExchange, pCoapResponseData->options_list_ptr->block2);
           }
         }
       }
@@ -1681,27 +2860,27 @@ static void commCoapGetResponse
       case COAP_STATUS_PARSER_BLOCKWISE_ACK:
       case COAP_STATUS_PARSER_BLOCKWISE_MSG_RECEIVING:
       {
-        gCommInterfaceObj.isExchangeTerminated = E_FALSE;
+        pExchange->isExchangeTerminated = E_FALSE;
       }
       break;
 
       case COAP_STATUS_PARSER_BLOCKWISE_MSG_RECEIVED:
       {
-        gCommInterfaceObj.exchangeStatus = E_K_COMM_STATUS_OK;
-        gCommInterfaceObj.isExchangeTerminated = E_TRUE;
-        *xpIsPayloadFreeRequired = E_TRUE;
-        gCommInterfaceObj.pPayload = pCoapResponseData->payload_ptr;
-        gCommInterfaceObj.payloadLength = pCoapResponseData->payload_len;
+        pExchange->exchangeStatus = E_K_COMM_STATUS_OK;
+        pExchange->isExchangeTerminated = E_TRUE;
+        pExchange->isPayloadFreeRequired = E_TRUE;
+        pExchange->pPayload = pCoapResponseData->payload_ptr;
+        pExchange->payloadLength = pCoapResponseData->payload_len;
         M_COMM__INFO(("Remaining Payload %p length %d",
-                      gCommInterfaceObj.pPayload,
-                      gCommInterfaceObj.payloadLength));
+                      pExchange->pPayload,
+                      pExchange->payloadLength));
       }
       break;
 
       default:
       {
         M_COMM__ERROR(("Unknow status code %d", pCoapResponseData->coap_status));
-        gCommInterfaceObj.isExchangeTerminated = E_TRUE;
+        pExchange->isExchangeTerminated = E_TRUE;
       }
       break;
     }
@@ -1713,6 +2892,8 @@ static void commCoapGetResponse
   }
 
   M_COMM__API_END();
+
+  return pExchange;
 }
 
 /**
@@ -1721,12 +2902,13 @@ static void commCoapGetResponse
  */
 static uint32_t copyPayloadToMessageBuffer
 (
-  uint8_t*  xpDstMsgBuffer,
-  size_t    xDstMsgBufferLength,
+  TCommExchange*  xpExchange,
+  uint8_t*        xpDstMsgBuffer,
+  size_t          xDstMsgBufferLength,
   const TBoolean  xIsPayloadFreeRequired
 )
 {
-  uint32_t  payloadLength = gCommInterfaceObj.firstPayloadLength + gCommInterfaceObj.payloadLength;
+  uint32_t  payloadLength = xpExchange->firstPayloadLength + xpExchange->payloadLength;
   uint8_t*  pDstBuffer = xpDstMsgBuffer;
   size_t    dstMsgBufferLength = xDstMsgBufferLength;
 
@@ -1734,45 +2916,45 @@ static uint32_t copyPayloadToMessageBuffer
 
   payloadLength = 0;
 
-  if ((gCommInterfaceObj.firstPayloadLength > 0u) && (NULL != gCommInterfaceObj.pFirstPayload))
+  if ((xpExchange->firstPayloadLength > 0u) && (NULL != xpExchange->pFirstPayload))
   {
-    if (dstMsgBufferLength > gCommInterfaceObj.firstPayloadLength)
+    if (dstMsgBufferLength > xpExchange->firstPayloadLength)
     {
       (void)memcpy(pDstBuffer,
-                   gCommInterfaceObj.pFirstPayload,
-                   gCommInterfaceObj.firstPayloadLength);
-      dstMsgBufferLength -= gCommInterfaceObj.firstPayloadLength;
-      pDstBuffer = &pDstBuffer[gCommInterfaceObj.firstPayloadLength];
-      payloadLength += gCommInterfaceObj.firstPayloadLength;
+                   xpExchange->pFirstPayload,
+                   xpExchange->firstPayloadLength);
+      dstMsgBufferLength -= xpExchange->firstPayloadLength;
+      pDstBuffer = &pDstBuffer[xpExchange->firstPayloadLength];
+      payloadLength += xpExchange->firstPayloadLength;
     }
     else
     {
-      (void)memcpy(pDstBuffer, gCommInterfaceObj.pFirstPayload, dstMsgBufferLength);
+      (void)memcpy(pDstBuffer, xpExchange->pFirstPayload, dstMsgBufferLength);
       payloadLength += (uint32_t)dstMsgBufferLength;
       dstMsgBufferLength = 0;
     }
 
-    M_COMM_INTERFACE_FREE(gCommInterfaceObj.pFirstPayload);
-    gCommInterfaceObj.firstPayloadLength = 0;
-    gCommInterfaceObj.pFirstPayload = NULL;
+    M_COMM_INTERFACE_FREE(xpExchange->pFirstPayload);
+    xpExchange->firstPayloadLength = 0;
+    xpExchange->pFirstPayload = NULL;
   }
 
   if (
-    (gCommInterfaceObj.payloadLength > 0u) &&
-    (NULL != gCommInterfaceObj.pPayload) &&
+    (xpExchange->payloadLength > 0u) &&
+    (NULL != xpExchange->pPayload) &&
     (dstMsgBufferLength > 0u)
   )
   {
-    (void)memcpy(pDstBuffer, gCommInterfaceObj.pPayload, dstMsgBufferLength);
+    (void)memcpy(pDstBuffer, xpExchange->pPayload, dstMsgBufferLength);
     payloadLength += (uint32_t)dstMsgBufferLength;
 
     if (E_TRUE == xIsPayloadFreeRequired)
     {
-      M_COMM_INTERFACE_FREE(gCommInterfaceObj.pPayload);
+      M_COMM_INTERFACE_FREE(xpExchange->pPayload);
     }
 
-    gCommInterfaceObj.pPayload = NULL;
-    gCommInterfaceObj.payloadLength = 0;
+    xpExchange->pPayload = NULL;
+    xpExchange->payloadLength = 0;
   }
 
 #ifdef ENABLE_COMM_COAP_PACKET_DEBUG_PRINTS
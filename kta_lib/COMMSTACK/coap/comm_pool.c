@@ -0,0 +1,446 @@
+/*******************************************************************************
+*************************keySTREAM Trusted Agent ("KTA")************************
+
+* (c) 2023-2025 Nagravision Sàrl
+
+* Subject to your compliance with these terms, you may use the Nagravision Sàrl
+* Software and any derivatives exclusively with Nagravision's products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may accompany
+* Nagravision Software.
+
+* Redistribution of this Nagravision Software in source or binary form is allowed
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+
+* THIS SOFTWARE IS SUPPLIED BY NAGRAVISION "AS IS". NO WARRANTIES, WHETHER EXPRESS,
+* IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF
+* NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE. IN NO
+* EVENT WILL NAGRAVISION BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL
+* OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF NAGRAVISION HAS BEEN ADVISED OF THE
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW,
+* NAGRAVISION 'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS
+* SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY
+* TO NAGRAVISION FOR THIS SOFTWARE.
+********************************************************************************/
+/** \brief Communication stack fixed-block memory pool.
+ *
+ *  \author Kudelski IoT
+ *
+ *  \date 2026/10/17
+ *
+ *  \file comm_pool.c
+ ******************************************************************************/
+/**
+ * @brief Communication stack fixed-block memory pool.
+ */
+
+#include "comm_pool.h"
+
+/* -------------------------------------------------------------------------- */
+/* IMPORTS                                                                    */
+/* -------------------------------------------------------------------------- */
+#include <string.h>
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL CONSTANTS, TYPES, ENUM                                               */
+/* -------------------------------------------------------------------------- */
+
+/** @brief State of a free block. */
+#define C_COMM_POOL_BLOCK_FREE             (0u)
+
+/** @brief State of an allocated block. */
+#define C_COMM_POOL_BLOCK_USED             (1u)
+
+/** @brief State of a block allocated while the arena is open. */
+#define C_COMM_POOL_BLOCK_ARENA            (2u)
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL VARIABLES                                                            */
+/* -------------------------------------------------------------------------- */
+
+/** @brief Size of the blocks, per class. */
+static const size_t gaPoolBlockSize[C_COMM_POOL__CLASS_COUNT] =
+{
+  32u, 64u, 128u, 256u, 512u, 1152u, 2048u
+};
+
+/** @brief Number of blocks, per class. */
+static const uint32_t gaPoolBlockCount[C_COMM_POOL__CLASS_COUNT] =
+{
+  C_COMM_POOL__BLOCKS_32,
+  C_COMM_POOL__BLOCKS_64,
+  C_COMM_POOL__BLOCKS_128,
+  C_COMM_POOL__BLOCKS_256,
+  C_COMM_POOL__BLOCKS_512,
+  C_COMM_POOL__BLOCKS_1152,
+  C_COMM_POOL__BLOCKS_2048
+};
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL FUNCTIONS - PROTOTYPE                                                */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief
+ *   Build the free lists of a pool.
+ *
+ * @param[in,out] xpPool
+ *   Pool.
+ */
+static void lPoolInit
+(
+  TCommPool*  xpPool
+);
+
+/**
+ * @brief
+ *   Find the class and the index of a block of the pool.
+ *
+ * @param[in] xpPool
+ *   Pool.
+ * @param[in] xpBlock
+ *   Block.
+ * @param[out] xpClass
+ *   Class of the block.
+ * @param[out] xpIndex
+ *   Index of the block in aBlockState.
+ *
+ * @return
+ * - E_TRUE if the block belongs to the pool.
+ * - E_FALSE otherwise.
+ */
+static TBoolean lPoolLocate
+(
+  const TCommPool*  xpPool,
+  const void*       xpBlock,
+  uint32_t*         xpClass,
+  uint32_t*         xpIndex
+);
+
+/**
+ * @brief
+ *   Put a block back in the free list of its class.
+ *
+ * @param[in,out] xpPool
+ *   Pool.
+ * @param[in] xpBlock
+ *   Block.
+ * @param[in] xClass
+ *   Class of the block.
+ * @param[in] xIndex
+ *   Index of the block in aBlockState.
+ */
+static void lPoolRelease
+(
+  TCommPool*      xpPool,
+  void*           xpBlock,
+  const uint32_t  xClass,
+  const uint32_t  xIndex
+);
+
+/* -------------------------------------------------------------------------- */
+/* PUBLIC VARIABLES                                                           */
+/* -------------------------------------------------------------------------- */
+
+/* -------------------------------------------------------------------------- */
+/* PUBLIC FUNCTIONS - IMPLEMENTATION                                          */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief  implement pCommPoolAlloc
+ *
+ */
+void* pCommPoolAlloc
+(
+  TCommPool*    xpPool,
+  const size_t  xSize
+)
+{
+  uint8_t*  pBlock = NULL;
+  uint32_t  classIndex = 0;
+  uint32_t  index = 0;
+
+  for (;;)
+  {
+    if ((NULL == xpPool) || (0u == xSize))
+    {
+      break;
+    }
+
+    if (E_FALSE == xpPool->isInitialized)
+    {
+      lPoolInit(xpPool);
+    }
+
+    /* Smallest class that fits, or a larger one if it is exhausted. */
+    for (classIndex = 0; classIndex < C_COMM_POOL__CLASS_COUNT; classIndex++)
+    {
+      if ((xSize <= gaPoolBlockSize[classIndex]) && (NULL != xpPool->apFreeList[classIndex]))
+      {
+        break;
+      }
+    }
+
+    if (C_COMM_POOL__CLASS_COUNT == classIndex)
+    {
+      xpPool->stats.missCount++;
+      break;
+    }
+
+    pBlock = (uint8_t*)xpPool->apFreeList[classIndex];
+    (void)memcpy(&xpPool->apFreeList[classIndex], pBlock, sizeof(void*));
+    (void)lPoolLocate(xpPool, pBlock, &classIndex, &index);
+
+    xpPool->aBlockState[index] = (E_TRUE == xpPool->isArenaOpen) ?
+                                 C_COMM_POOL_BLOCK_ARENA : C_COMM_POOL_BLOCK_USED;
+    xpPool->stats.aInUse[classIndex]++;
+
+    if (xpPool->stats.aInUse[classIndex] > xpPool->stats.aPeak[classIndex])
+    {
+      xpPool->stats.aPeak[classIndex] = xpPool->stats.aInUse[classIndex];
+    }
+
+    break;
+  }
+
+  return pBlock;
+}
+
+/**
+ * @brief  implement commPoolFree
+ *
+ */
+TBoolean commPoolFree
+(
+  TCommPool*  xpPool,
+  void*       xpBlock
+)
+{
+  TBoolean  isPoolBlock = E_FALSE;
+  uint32_t  classIndex = 0;
+  uint32_t  index = 0;
+
+  if ((NULL != xpPool) && (NULL != xpBlock))
+  {
+    isPoolBlock = lPoolLocate(xpPool, xpBlock, &classIndex, &index);
+
+    /* A block released twice is ignored. */
+    if ((E_TRUE == isPoolBlock) && (C_COMM_POOL_BLOCK_FREE != xpPool->aBlockState[index]))
+    {
+      lPoolRelease(xpPool, xpBlock, classIndex, index);
+    }
+  }
+
+  return isPoolBlock;
+}
+
+/**
+ * @brief  implement commPoolBlockSize
+ *
+ */
+size_t commPoolBlockSize
+(
+  const TCommPool*  xpPool,
+  const void*       xpBlock
+)
+{
+  size_t    blockSize = 0;
+  uint32_t  classIndex = 0;
+  uint32_t  index = 0;
+
+  if (
+    (NULL != xpPool) &&
+    (NULL != xpBlock) &&
+    (E_TRUE == lPoolLocate(xpPool, xpBlock, &classIndex, &index))
+  )
+  {
+    blockSize = gaPoolBlockSize[classIndex];
+  }
+
+  return blockSize;
+}
+
+/**
+ * @brief  implement commPoolArenaBegin
+ *
+ */
+TBoolean commPoolArenaBegin
+(
+  TCommPool*  xpPool
+)
+{
+  TBoolean  isOpened = E_FALSE;
+
+  if ((NULL != xpPool) && (E_FALSE == xpPool->isArenaOpen))
+  {
+    xpPool->isArenaOpen = E_TRUE;
+    isOpened = E_TRUE;
+  }
+
+  return isOpened;
+}
+
+/**
+ * @brief  implement commPoolArenaEnd
+ *
+ */
+uint32_t commPoolArenaEnd
+(
+  TCommPool*  xpPool
+)
+{
+  uint32_t  liveCount = 0;
+  uint32_t  index = 0;
+
+  if ((NULL != xpPool) && (E_TRUE == xpPool->isInitialized))
+  {
+    for (index = 0; index < C_COMM_POOL__BLOCK_COUNT; index++)
+    {
+      if (C_COMM_POOL_BLOCK_ARENA == xpPool->aBlockState[index])
+      {
+        /* Still referenced by its owner, released by commPoolFree() only. */
+        xpPool->aBlockState[index] = C_COMM_POOL_BLOCK_USED;
+        liveCount++;
+      }
+    }
+
+    xpPool->stats.arenaLiveCount += liveCount;
+  }
+
+  if (NULL != xpPool)
+  {
+    xpPool->isArenaOpen = E_FALSE;
+  }
+
+  return liveCount;
+}
+
+/**
+ * @brief  implement commPoolGetStats
+ *
+ */
+void commPoolGetStats
+(
+  const TCommPool*  xpPool,
+  TCommPoolStats*   xpStats
+)
+{
+  if ((NULL != xpPool) && (NULL != xpStats))
+  {
+    (void)memcpy(xpStats, &xpPool->stats, sizeof(TCommPoolStats));
+  }
+}
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL FUNCTIONS - IMPLEMENTATION                                           */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @implements lPoolInit
+ *
+ */
+static void lPoolInit
+(
+  TCommPool*  xpPool
+)
+{
+  uint8_t*  pClassStart = (uint8_t*)xpPool->aStorage;
+  uint8_t*  pBlock = NULL;
+  uint32_t  classIndex = 0;
+  uint32_t  blockIndex = 0;
+
+  (void)memset(xpPool->aBlockState, C_COMM_POOL_BLOCK_FREE, sizeof(xpPool->aBlockState));
+
+  for (classIndex = 0; classIndex < C_COMM_POOL__CLASS_COUNT; classIndex++)
+  {
+    xpPool->apFreeList[classIndex] = NULL;
+
+    /* Built backwards so that the blocks are handed out in address order. */
+    for (blockIndex = gaPoolBlockCount[classIndex]; blockIndex > 0u; blockIndex--)
+    {
+      pBlock = &pClassStart[(blockIndex - 1u) * gaPoolBlockSize[classIndex]];
+      (void)memcpy(pBlock, &xpPool->apFreeList[classIndex], sizeof(void*));
+      xpPool->apFreeList[classIndex] = pBlock;
+    }
+
+    pClassStart = &pClassStart[gaPoolBlockCount[classIndex] * gaPoolBlockSize[classIndex]];
+  }
+
+  xpPool->isInitialized = E_TRUE;
+}
+
+/**
+ * @implements lPoolLocate
+ *
+ */
+static TBoolean lPoolLocate
+(
+  const TCommPool*  xpPool,
+  const void*       xpBlock,
+  uint32_t*         xpClass,
+  uint32_t*         xpIndex
+)
+{
+  TBoolean        isPoolBlock = E_FALSE;
+  const uint8_t*  pStorage = (const uint8_t*)xpPool->aStorage;
+  uintptr_t       offset = 0;
+  uintptr_t       classSize = 0;
+  uint32_t        classIndex = 0;
+  uint32_t        firstIndex = 0;
+
+  if (
+    (E_TRUE == xpPool->isInitialized) &&
+    ((uintptr_t)xpBlock >= (uintptr_t)pStorage) &&
+    ((uintptr_t)xpBlock < ((uintptr_t)pStorage + C_COMM_POOL__STORAGE_SIZE))
+  )
+  {
+    offset = (uintptr_t)xpBlock - (uintptr_t)pStorage;
+
+    for (classIndex = 0; classIndex < C_COMM_POOL__CLASS_COUNT; classIndex++)
+    {
+      classSize = (uintptr_t)gaPoolBlockCount[classIndex] * gaPoolBlockSize[classIndex];
+
+      if (offset < classSize)
+      {
+        /* Only the start of a block is a valid pointer. */
+        if (0u == (offset % gaPoolBlockSize[classIndex]))
+        {
+          *xpClass = classIndex;
+          *xpIndex = firstIndex + (uint32_t)(offset / gaPoolBlockSize[classIndex]);
+          isPoolBlock = E_TRUE;
+        }
+
+        break;
+      }
+
+      offset -= classSize;
+      firstIndex += gaPoolBlockCount[classIndex];
+    }
+  }
+
+  return isPoolBlock;
+}
+
+/**
+ * @implements lPoolRelease
+ *
+ */
+static void lPoolRelease
+(
+  TCommPool*      xpPool,
+  void*           xpBlock,
+  const uint32_t  xClass,
+  const uint32_t  xIndex
+)
+{
+  (void)memcpy(xpBlock, &xpPool->apFreeList[xClass], sizeof(void*));
+  xpPool->apFreeList[xClass] = xpBlock;
+  xpPool->aBlockState[xIndex] = C_COMM_POOL_BLOCK_FREE;
+  xpPool->stats.aInUse[xClass]--;
+}
+
+/* -------------------------------------------------------------------------- */
+/* END OF FILE                                                                */
+/* -------------------------------------------------------------------------- */
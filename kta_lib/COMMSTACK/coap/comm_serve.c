@@ -0,0 +1,557 @@
+/*******************************************************************************
+*************************keySTREAM Trusted Agent ("KTA")************************
+
+* (c) 2023-2025 Nagravision Sàrl
+
+* Subject to your compliance with these terms, you may use the Nagravision Sàrl
+* Software and any derivatives exclusively with Nagravision's products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may accompany
+* Nagravision Software.
+
+* Redistribution of this Nagravision Software in source or binary form is allowed
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+
+* THIS SOFTWARE IS SUPPLIED BY NAGRAVISION "AS IS". NO WARRANTIES, WHETHER EXPRESS,
+* IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF
+* NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE. IN NO
+* EVENT WILL NAGRAVISION BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL
+* OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF NAGRAVISION HAS BEEN ADVISED OF THE
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW,
+* NAGRAVISION 'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS
+* SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY
+* TO NAGRAVISION FOR THIS SOFTWARE.
+********************************************************************************/
+/** \brief Communication stack loopback server.
+ *
+ *  \author Kudelski IoT
+ *
+ *  \date 2026/10/17
+ *
+ *  \file comm_serve.c
+ ******************************************************************************/
+/**
+ * @brief CoAP loopback server, answering the requests sent by commMsgExchange().
+ */
+
+#include "comm_if.h"
+/* -------------------------------------------------------------------------- */
+/* IMPORTS                                                                    */
+/* -------------------------------------------------------------------------- */
+#include "comm_interface_util.h"
+/* mbed coap headers. */
+#include "sn_coap_header.h"
+#include "sn_coap_protocol.h"
+/* Next one is needed for outgoing block-wise - prepare_blockwise_message(). */
+#include "sn_coap_protocol_internal.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL CONSTANTS, TYPES, ENUM                                               */
+/* -------------------------------------------------------------------------- */
+/** @brief Largest datagram received. */
+#define C_COMM_SERVE_COAP_MAX_DATAGRAM_SIZE        (1472u)
+
+/** @brief Largest message answered by the handler. */
+#define C_COMM_SERVE_COAP_MAX_MESSAGE_SIZE         (2048u)
+
+/** @brief Block size used for the answers. */
+#define C_COMM_SERVE_COAP_BLOCK_SIZE               (1024u)
+
+/** @brief Socket polling period in ms, bounds the reaction time to commServeStop(). */
+#define C_COMM_SERVE_COAP_POLL_PERIOD              (200)
+
+/** @brief Set an argument/return value as unused */
+#define M_UNUSED(xArg)            (void)(xArg)
+
+/** @brief CoAP loopback server object. */
+typedef struct
+{
+  struct coap_s*       pCoapHandle;
+  /* Handle of the CoAP. */
+  int                  socketId;
+  /* Bound UDP socket. */
+  TCommIfServeHandler  handler;
+  /* Handler answering the requests. */
+  void*                pHandlerArg;
+  /* Handler argument. */
+  volatile TBoolean    isStopRequested;
+  /* Set by commServeStop(). */
+  uint8_t              aAnswer[C_COMM_SERVE_COAP_MAX_MESSAGE_SIZE];
+  /* Answer built by the handler. */
+} TCommServeCoap;
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL VARIABLES                                                            */
+/* -------------------------------------------------------------------------- */
+/** @brief CoAP loopback server object. */
+static TCommServeCoap gCommServeCoap;
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL FUNCTIONS - PROTOTYPE                                                */
+/* -------------------------------------------------------------------------- */
+/**
+ * @brief
+ *   Allocates memory for the CoAP library.
+ *
+ * @param[in] xSize
+ *   Size to allocate.
+ *
+ * @return
+ * - Pointer to the allocated memory or NULL.
+ */
+static void* pCommServeMalloc
+(
+  uint16_t xSize
+);
+
+/**
+ * @brief
+ *   Frees memory allocated by pCommServeMalloc().
+ *
+ * @param[in] xpAddr
+ *   Memory to free.
+ */
+static void commServeFree
+(
+  void* xpAddr
+);
+
+/**
+ * @brief
+ *   CoAP transmit callback, sends the datagram back to the client.
+ *
+ * @param[in] xpSendBuffer
+ *   Datagram to send.
+ * @param[in] xSendBufferSize
+ *   Size of the datagram.
+ * @param[in] xpDstAddress
+ *   Client address.
+ * @param[in] xpUserData
+ *   Unused.
+ *
+ * @return
+ * - 1 if the datagram is sent, 0 otherwise.
+ */
+static uint8_t commServeTxCb
+(
+  uint8_t*         xpSendBuffer,
+  uint16_t         xSendBufferSize,
+  sn_nsdl_addr_s*  xpDstAddress,
+  void*            xpUserData
+);
+
+/**
+ * @brief
+ *   CoAP receive callback, unused as the requests are handled after parsing.
+ *
+ * @return
+ * - 0.
+ */
+static int8_t commServeRxCb
+(
+  sn_coap_hdr_s*   xpCoapHeader,
+  sn_nsdl_addr_s*  xpDstAddress,
+  void*            xpUserData
+);
+
+/**
+ * @brief
+ *   Answers a complete POST request with a piggybacked 2.04 response.
+ *
+ * @param[in] xpRequest
+ *   Parsed request, payload reassembled if it was sent block-wise.
+ * @param[in] xpSrcAddress
+ *   Client address.
+ */
+static void commServeAnswer
+(
+  sn_coap_hdr_s*   xpRequest,
+  sn_nsdl_addr_s*  xpSrcAddress
+);
+
+/**
+ * @brief
+ *   Returns the relative time in seconds for the CoAP library.
+ *
+ * @return
+ * - Relative time in seconds.
+ */
+static uint32_t getServeTimeInSec
+(
+  void
+);
+
+/* -------------------------------------------------------------------------- */
+/* PUBLIC VARIABLES                                                           */
+/* -------------------------------------------------------------------------- */
+
+/* -------------------------------------------------------------------------- */
+/* PUBLIC FUNCTIONS - IMPLEMENTATION                                          */
+/* -------------------------------------------------------------------------- */
+/**
+ * @brief  implement commServe
+ *
+ */
+TCommIfStatus commServe
+(
+  const uint16_t       xPort,
+  TCommIfServeHandler  xHandler,
+  void*                xpArg
+)
+{
+  TCommIfStatus       status = E_COMM_IF_STATUS_ERROR;
+  struct sockaddr_in  localAddr;
+  struct sockaddr_in  clientAddr;
+  socklen_t           clientAddrLen = 0;
+  struct pollfd       pollFd;
+  sn_nsdl_addr_s      srcAddress;
+  sn_coap_hdr_s*      pRequest = NULL;
+  uint8_t             aDatagram[C_COMM_SERVE_COAP_MAX_DATAGRAM_SIZE];
+  ssize_t             datagramSize = 0;
+
+  M_COMM__API_START();
+
+  for (;;)
+  {
+    if ((0U == xPort) || (NULL == xHandler))
+    {
+      M_COMM__ERROR(("Invalid parameter"));
+      status = E_COMM_IF_STATUS_PARAMETER;
+      break;
+    }
+
+    (void)memset(&gCommServeCoap, 0, sizeof(gCommServeCoap));
+    gCommServeCoap.handler = xHandler;
+    gCommServeCoap.pHandlerArg = xpArg;
+    gCommServeCoap.isStopRequested = E_FALSE;
+
+    /* The SAL socket has no bind, the loopback server uses the POSIX socket directly. */
+    gCommServeCoap.socketId = socket(AF_INET, SOCK_DGRAM, 0);
+
+    if (gCommServeCoap.socketId < 0)
+    {
+      M_COMM__ERROR(("socket failed"));
+      status = E_COMM_IF_STATUS_NETWORK;
+      break;
+    }
+
+    (void)memset(&localAddr, 0, sizeof(localAddr));
+    localAddr.sin_family = AF_INET;
+    localAddr.sin_port = htons(xPort);
+    localAddr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    if (0 != bind(gCommServeCoap.socketId, (struct sockaddr*)&localAddr, sizeof(localAddr)))
+    {
+      M_COMM__ERROR(("bind to port %u failed", xPort));
+      status = E_COMM_IF_STATUS_NETWORK;
+      break;
+    }
+
+    gCommServeCoap.pCoapHandle = sn_coap_protocol_init(pCommServeMalloc,
+                                                       commServeFree,
+                                                       commServeTxCb,
+                                                       commServeRxCb);
+
+    if (NULL == gCommServeCoap.pCoapHandle)
+    {
+      M_COMM__ERROR(("sn_coap_protocol_init failed"));
+      status = E_COMM_IF_STATUS_MEMORY;
+      break;
+    }
+
+    (void)sn_coap_protocol_set_block_size(gCommServeCoap.pCoapHandle,
+                                          C_COMM_SERVE_COAP_BLOCK_SIZE);
+
+    pollFd.fd = gCommServeCoap.socketId;
+    pollFd.events = POLLIN;
+
+    while (E_FALSE == gCommServeCoap.isStopRequested)
+    {
+      pollFd.revents = 0;
+
+      if (poll(&pollFd, 1, C_COMM_SERVE_COAP_POLL_PERIOD) <= 0)
+      {
+        /* Let the library drop stale block-wise transfers. */
+        (void)sn_coap_protocol_exec(gCommServeCoap.pCoapHandle, getServeTimeInSec());
+        continue;
+      }
+
+      clientAddrLen = sizeof(clientAddr);
+      datagramSize = recvfrom(gCommServeCoap.socketId,
+                              aDatagram,
+                              sizeof(aDatagram),
+                              0,
+                              (struct sockaddr*)&clientAddr,
+                              &clientAddrLen);
+
+      if (datagramSize <= 0)
+      {
+        continue;
+      }
+
+      srcAddress.type = SN_NSDL_ADDRESS_TYPE_IPV4;
+      srcAddress.addr_ptr = (uint8_t*)&clientAddr.sin_addr.s_addr;
+      srcAddress.addr_len = (uint8_t)sizeof(clientAddr.sin_addr.s_addr);
+      srcAddress.port = ntohs(clientAddr.sin_port);
+
+      /* Block1 uploads are acknowledged and reassembled, Block2 follow-ups are served, by the
+         library itself; only complete requests come back here. */
+      pRequest = sn_coap_protocol_parse(gCommServeCoap.pCoapHandle,
+                                        &srcAddress,
+                                        (uint16_t)datagramSize,
+                                        aDatagram,
+                                        NULL);
+
+      if (NULL == pRequest)
+      {
+        continue;
+      }
+
+      if (((COAP_STATUS_OK == pRequest->coap_status) ||
+           (COAP_STATUS_PARSER_BLOCKWISE_MSG_RECEIVED == pRequest->coap_status)) &&
+          (COAP_MSG_CODE_REQUEST_POST == pRequest->msg_code))
+      {
+        commServeAnswer(pRequest, &srcAddress);
+      }
+
+#if !SN_COAP_REDUCE_BLOCKWISE_HEAP_FOOTPRINT
+      if (COAP_STATUS_PARSER_BLOCKWISE_MSG_RECEIVED == pRequest->coap_status)
+      {
+        /* Reassembled payload is a copy owned by the caller. */
+        commServeFree(pRequest->payload_ptr);
+        pRequest->payload_ptr = NULL;
+      }
+#endif
+
+      sn_coap_parser_release_allocated_coap_msg_mem(gCommServeCoap.pCoapHandle, pRequest);
+      pRequest = NULL;
+    }
+
+    status = E_COMM_IF_STATUS_OK;
+    break;
+  }
+
+  if (NULL != gCommServeCoap.pCoapHandle)
+  {
+    (void)sn_coap_protocol_destroy(gCommServeCoap.pCoapHandle);
+    gCommServeCoap.pCoapHandle = NULL;
+  }
+
+  if (gCommServeCoap.socketId > 0)
+  {
+    (void)close(gCommServeCoap.socketId);
+    gCommServeCoap.socketId = -1;
+  }
+
+  M_COMM__API_END();
+  return status;
+}
+
+/**
+ * @brief  implement commServeStop
+ *
+ */
+TCommIfStatus commServeStop
+(
+  void
+)
+{
+  gCommServeCoap.isStopRequested = E_TRUE;
+  return E_COMM_IF_STATUS_OK;
+}
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL FUNCTIONS - IMPLEMENTATION                                           */
+/* -------------------------------------------------------------------------- */
+/**
+ * @implements pCommServeMalloc
+ *
+ */
+static void* pCommServeMalloc
+(
+  uint16_t xSize
+)
+{
+  return kta_pSalMemoryAllocate(xSize);
+}
+
+/**
+ * @implements commServeFree
+ *
+ */
+static void commServeFree
+(
+  void* xpAddr
+)
+{
+  salMemoryFree(xpAddr);
+}
+
+/**
+ * @implements commServeTxCb
+ *
+ */
+static uint8_t commServeTxCb
+(
+  uint8_t*         xpSendBuffer,
+  uint16_t         xSendBufferSize,
+  sn_nsdl_addr_s*  xpDstAddress,
+  void*            xpUserData
+)
+{
+  struct sockaddr_in  dstAddr;
+  uint8_t             isSent = 0;
+
+  M_UNUSED(xpUserData);
+
+  if ((NULL != xpDstAddress) && (NULL != xpDstAddress->addr_ptr) &&
+      (sizeof(dstAddr.sin_addr.s_addr) == xpDstAddress->addr_len))
+  {
+    (void)memset(&dstAddr, 0, sizeof(dstAddr));
+    dstAddr.sin_family = AF_INET;
+    dstAddr.sin_port = htons(xpDstAddress->port);
+    (void)memcpy(&dstAddr.sin_addr.s_addr, xpDstAddress->addr_ptr, xpDstAddress->addr_len);
+
+    if (sendto(gCommServeCoap.socketId, xpSendBuffer, xSendBufferSize, 0,
+               (struct sockaddr*)&dstAddr, sizeof(dstAddr)) == (ssize_t)xSendBufferSize)
+    {
+      isSent = 1;
+    }
+  }
+
+  return isSent;
+}
+
+/**
+ * @implements commServeRxCb
+ *
+ */
+static int8_t commServeRxCb
+(
+  sn_coap_hdr_s*   xpCoapHeader,
+  sn_nsdl_addr_s*  xpDstAddress,
+  void*            xpUserData
+)
+{
+  M_UNUSED(xpCoapHeader);
+  M_UNUSED(xpDstAddress);
+  M_UNUSED(xpUserData);
+  return 0;
+}
+
+/**
+ * @implements commServeAnswer
+ *
+ */
+static void commServeAnswer
+(
+  sn_coap_hdr_s*   xpRequest,
+  sn_nsdl_addr_s*  xpSrcAddress
+)
+{
+  sn_coap_hdr_s*  pResponse = NULL;
+  uint8_t*        pTxBuffer = NULL;
+  uint16_t        txBufferSize = 0;
+  int16_t         lengthAndStatus = -1;
+  size_t          answerSize = sizeof(gCommServeCoap.aAnswer);
+
+  for (;;)
+  {
+    if ((NULL == xpRequest->payload_ptr) || (0U == xpRequest->payload_len))
+    {
+      M_COMM__ERROR(("Empty request"));
+      break;
+    }
+
+    if (E_COMM_IF_STATUS_OK != gCommServeCoap.handler(gCommServeCoap.pHandlerArg,
+                                                      xpRequest->payload_ptr,
+                                                      xpRequest->payload_len,
+                                                      gCommServeCoap.aAnswer,
+                                                      &answerSize))
+    {
+      M_COMM__ERROR(("Handler dropped the request"));
+      break;
+    }
+
+    pResponse = sn_coap_build_response(gCommServeCoap.pCoapHandle,
+                                       xpRequest,
+                                       COAP_MSG_CODE_RESPONSE_CHANGED);
+
+    if (NULL == pResponse)
+    {
+      M_COMM__ERROR(("sn_coap_build_response failed"));
+      break;
+    }
+
+    pResponse->payload_ptr = gCommServeCoap.aAnswer;
+    pResponse->payload_len = (uint16_t)answerSize;
+    pResponse->content_format = COAP_CT_OCTET_STREAM;
+
+    if (0 != prepare_blockwise_message(gCommServeCoap.pCoapHandle, pResponse))
+    {
+      M_COMM__ERROR(("prepare_blockwise_message failed"));
+      break;
+    }
+
+    txBufferSize = sn_coap_builder_calc_needed_packet_data_size_2(pResponse,
+                   sn_coap_protocol_get_configured_blockwise_size(gCommServeCoap.pCoapHandle));
+    pTxBuffer = (uint8_t*)pCommServeMalloc(txBufferSize);
+
+    if ((0U == txBufferSize) || (NULL == pTxBuffer))
+    {
+      M_COMM__ERROR(("Memory Alloc Failed Size[%d]", txBufferSize));
+      break;
+    }
+
+    lengthAndStatus = sn_coap_protocol_build(gCommServeCoap.pCoapHandle,
+                                             xpSrcAddress,
+                                             pTxBuffer,
+                                             pResponse,
+                                             NULL,
+                                             getServeTimeInSec());
+
+    if (lengthAndStatus <= 0)
+    {
+      M_COMM__ERROR(("sn_coap_protocol_build Failed"));
+      break;
+    }
+
+    (void)commServeTxCb(pTxBuffer, (uint16_t)lengthAndStatus, xpSrcAddress, NULL);
+    break;
+  }
+
+  if (NULL != pResponse)
+  {
+    /* The payload belongs to gCommServeCoap. */
+    pResponse->payload_ptr = NULL;
+    sn_coap_parser_release_allocated_coap_msg_mem(gCommServeCoap.pCoapHandle, pResponse);
+  }
+
+  commServeFree(pTxBuffer);
+}
+
+/**
+ * @implements getServeTimeInSec
+ *
+ */
+static uint32_t getServeTimeInSec
+(
+  void
+)
+{
+  return (uint32_t)(salTimeGetRelative() / 1000);
+}
+
+/* -------------------------------------------------------------------------- */
+/* END OF FILE                                                                */
+/* -------------------------------------------------------------------------- */
@@ -0,0 +1,342 @@
+/*******************************************************************************
+*************************keySTREAM Trusted Agent ("KTA")************************
+
+* (c) 2023-2025 Nagravision Sàrl
+
+* Subject to your compliance with these terms, you may use the Nagravision Sàrl
+* Software and any derivatives exclusively with Nagravision's products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may accompany
+* Nagravision Software.
+
+* Redistribution of this Nagravision Software in source or binary form is allowed
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+
+* THIS SOFTWARE IS SUPPLIED BY NAGRAVISION "AS IS". NO WARRANTIES, WHETHER EXPRESS,
+* IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF
+* NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE. IN NO
+* EVENT WILL NAGRAVISION BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL
+* OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF NAGRAVISION HAS BEEN ADVISED OF THE
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW,
+* NAGRAVISION 'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS
+* SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY
+* TO NAGRAVISION FOR THIS SOFTWARE.
+********************************************************************************/
+/** \brief Communication stack timer wheel.
+ *
+ *  \author Kudelski IoT
+ *
+ *  \date 2026/10/17
+ *
+ *  \file comm_timer.c
+ ******************************************************************************/
+/**
+ * @brief Communication stack timer wheel.
+ */
+
+#include "comm_timer.h"
+
+/* -------------------------------------------------------------------------- */
+/* IMPORTS                                                                    */
+/* -------------------------------------------------------------------------- */
+#include <string.h>
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL CONSTANTS, TYPES, ENUM                                               */
+/* -------------------------------------------------------------------------- */
+
+/** @brief True if a timer expiring at x_expiryMs is due at x_nowMs, robust to wrap around. */
+#define M_COMM_TIMER_IS_DUE(x_expiryMs, x_nowMs) \
+  ((int32_t)((uint32_t)(x_expiryMs) - (uint32_t)(x_nowMs)) <= 0)
+
+/** @brief Slot index of a time in ms. */
+#define M_COMM_TIMER_SLOT(x_timeMs) \
+  (((x_timeMs) / C_COMM_TIMER__TICK_MS) % C_COMM_TIMER__WHEEL_SLOTS)
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL VARIABLES                                                            */
+/* -------------------------------------------------------------------------- */
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL FUNCTIONS - PROTOTYPE                                                */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief
+ *   Unlink an armed timer from its slot.
+ *
+ * @param[in,out] xpWheel
+ *   Timer wheel.
+ * @param[in,out] xpTimer
+ *   Timer to unlink.
+ */
+static void lTimerUnlink
+(
+  TCommTimerWheel*  xpWheel,
+  TCommTimer*       xpTimer
+);
+
+/**
+ * @brief
+ *   Get the first due timer of a slot.
+ *
+ * @param[in] xpWheel
+ *   Timer wheel.
+ * @param[in] xSlot
+ *   Slot index.
+ * @param[in] xNowMs
+ *   Current relative time, in ms.
+ *
+ * @return
+ *   First due timer or NULL.
+ */
+static TCommTimer* lTimerGetDue
+(
+  const TCommTimerWheel*  xpWheel,
+  const uint32_t          xSlot,
+  const uint32_t          xNowMs
+);
+
+/* -------------------------------------------------------------------------- */
+/* PUBLIC VARIABLES                                                           */
+/* -------------------------------------------------------------------------- */
+
+/* -------------------------------------------------------------------------- */
+/* PUBLIC FUNCTIONS - IMPLEMENTATION                                          */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief  implement commTimerWheelInit
+ *
+ */
+void commTimerWheelInit
+(
+  TCommTimerWheel*  xpWheel,
+  const uint32_t    xNowMs
+)
+{
+  if (NULL != xpWheel)
+  {
+    (void)memset(xpWheel, 0, sizeof(TCommTimerWheel));
+    xpWheel->currentTick = xNowMs / C_COMM_TIMER__TICK_MS;
+  }
+}
+
+/**
+ * @brief  implement commTimerArm
+ *
+ */
+void commTimerArm
+(
+  TCommTimerWheel*  xpWheel,
+  TCommTimer*       xpTimer,
+  const uint32_t    xNowMs,
+  const uint32_t    xDelayMs,
+  TCommTimerCb      xCallback,
+  void*             xpArg
+)
+{
+  uint32_t  slot = 0;
+
+  if ((NULL != xpWheel) && (NULL != xpTimer) && (NULL != xCallback))
+  {
+    commTimerCancel(xpWheel, xpTimer);
+
+    xpTimer->expiryMs = xNowMs + xDelayMs;
+    xpTimer->callback = xCallback;
+    xpTimer->pArg = xpArg;
+
+    slot = M_COMM_TIMER_SLOT(xpTimer->expiryMs);
+    xpTimer->pPrev = NULL;
+    xpTimer->pNext = xpWheel->apSlots[slot];
+
+    if (NULL != xpTimer->pNext)
+    {
+      xpTimer->pNext->pPrev = xpTimer;
+    }
+
+    xpWheel->apSlots[slot] = xpTimer;
+    xpTimer->isArmed = E_TRUE;
+    xpWheel->armedCount++;
+  }
+}
+
+/**
+ * @brief  implement commTimerCancel
+ *
+ */
+void commTimerCancel
+(
+  TCommTimerWheel*  xpWheel,
+  TCommTimer*       xpTimer
+)
+{
+  if ((NULL != xpWheel) && (NULL != xpTimer) && (E_TRUE == xpTimer->isArmed))
+  {
+    lTimerUnlink(xpWheel, xpTimer);
+  }
+}
+
+/**
+ * @brief  implement commTimerWheelNextExpiry
+ *
+ */
+uint32_t commTimerWheelNextExpiry
+(
+  const TCommTimerWheel*  xpWheel,
+  const uint32_t          xNowMs
+)
+{
+  const TCommTimer*  pTimer = NULL;
+  uint32_t           nextMs = C_COMM_TIMER__NO_EXPIRY;
+  uint32_t           leftMs = 0;
+  uint32_t           tick = 0;
+  uint32_t           i = 0;
+
+  if ((NULL != xpWheel) && (0u != xpWheel->armedCount))
+  {
+    /*
+     * Walk one rotation from the current tick, the first slot holding a timer of this rotation
+     * holds the earliest one. Timers of later rotations are only looked at if none was found.
+     */
+    for (i = 0; i < C_COMM_TIMER__WHEEL_SLOTS; i++)
+    {
+      tick = xpWheel->currentTick + i;
+
+      for (pTimer = xpWheel->apSlots[tick % C_COMM_TIMER__WHEEL_SLOTS];
+           NULL != pTimer;
+           pTimer = pTimer->pNext)
+      {
+        leftMs = M_COMM_TIMER_IS_DUE(pTimer->expiryMs, xNowMs) ? 0u : (pTimer->expiryMs - xNowMs);
+
+        if (((pTimer->expiryMs / C_COMM_TIMER__TICK_MS) <= tick) && (leftMs < nextMs))
+        {
+          nextMs = leftMs;
+        }
+      }
+
+      if (C_COMM_TIMER__NO_EXPIRY != nextMs)
+      {
+        break;
+      }
+    }
+
+    if (C_COMM_TIMER__NO_EXPIRY == nextMs)
+    {
+      for (i = 0; i < C_COMM_TIMER__WHEEL_SLOTS; i++)
+      {
+        for (pTimer = xpWheel->apSlots[i]; NULL != pTimer; pTimer = pTimer->pNext)
+        {
+          leftMs = M_COMM_TIMER_IS_DUE(pTimer->expiryMs, xNowMs) ?
+                   0u : (pTimer->expiryMs - xNowMs);
+          nextMs = (leftMs < nextMs) ? leftMs : nextMs;
+        }
+      }
+    }
+  }
+
+  return nextMs;
+}
+
+/**
+ * @brief  implement commTimerWheelAdvance
+ *
+ */
+void commTimerWheelAdvance
+(
+  TCommTimerWheel*  xpWheel,
+  const uint32_t    xNowMs
+)
+{
+  TCommTimer*  pTimer = NULL;
+  uint32_t     nowTick = xNowMs / C_COMM_TIMER__TICK_MS;
+  uint32_t     slot = 0;
+  uint32_t     count = 0;
+
+  if (NULL != xpWheel)
+  {
+    /* The current tick is walked again, it may hold timers armed after the last advance. */
+    count = nowTick - xpWheel->currentTick + 1u;
+    count = (count > C_COMM_TIMER__WHEEL_SLOTS) ? C_COMM_TIMER__WHEEL_SLOTS : count;
+    slot = xpWheel->currentTick % C_COMM_TIMER__WHEEL_SLOTS;
+
+    while ((count > 0u) && (0u != xpWheel->armedCount))
+    {
+      /* A callback may arm or cancel any timer, so the slot is searched again after each call. */
+      pTimer = lTimerGetDue(xpWheel, slot, xNowMs);
+
+      if (NULL != pTimer)
+      {
+        lTimerUnlink(xpWheel, pTimer);
+        pTimer->callback(pTimer->pArg);
+        continue;
+      }
+
+      slot = (slot + 1u) % C_COMM_TIMER__WHEEL_SLOTS;
+      count--;
+    }
+
+    xpWheel->currentTick = nowTick;
+  }
+}
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL FUNCTIONS - IMPLEMENTATION                                           */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @implements lTimerUnlink
+ *
+ */
+static void lTimerUnlink
+(
+  TCommTimerWheel*  xpWheel,
+  TCommTimer*       xpTimer
+)
+{
+  if (NULL != xpTimer->pPrev)
+  {
+    xpTimer->pPrev->pNext = xpTimer->pNext;
+  }
+  else
+  {
+    xpWheel->apSlots[M_COMM_TIMER_SLOT(xpTimer->expiryMs)] = xpTimer->pNext;
+  }
+
+  if (NULL != xpTimer->pNext)
+  {
+    xpTimer->pNext->pPrev = xpTimer->pPrev;
+  }
+
+  xpTimer->pNext = NULL;
+  xpTimer->pPrev = NULL;
+  xpTimer->isArmed = E_FALSE;
+  xpWheel->armedCount--;
+}
+
+/**
+ * @implements lTimerGetDue
+ *
+ */
+static TCommTimer* lTimerGetDue
+(
+  const TCommTimerWheel*  xpWheel,
+  const uint32_t          xSlot,
+  const uint32_t          xNowMs
+)
+{
+  TCommTimer*  pTimer = xpWheel->apSlots[xSlot];
+
+  while ((NULL != pTimer) && (!M_COMM_TIMER_IS_DUE(pTimer->expiryMs, xNowMs)))
+  {
+    pTimer = pTimer->pNext;
+  }
+
+  return pTimer;
+}
+
+/* -------------------------------------------------------------------------- */
+/* END OF FILE                                                                */
+/* -------------------------------------------------------------------------- */
@@ -0,0 +1,120 @@
+/*******************************************************************************
+*************************keySTREAM Trusted Agent ("KTA")************************
+
+* (c) 2023-2025 Nagravision Sàrl
+
+* Subject to your compliance with these terms, you may use the Nagravision Sàrl
+* Software and any derivatives exclusively with Nagravision's products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may accompany
+* Nagravision Software.
+
+* Redistribution of this Nagravision Software in source or binary form is allowed
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+
+* THIS SOFTWARE IS SUPPLIED BY NAGRAVISION "AS IS". NO WARRANTIES, WHETHER EXPRESS,
+* IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF
+* NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE. IN NO
+* EVENT WILL NAGRAVISION BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL
+* OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF NAGRAVISION HAS BEEN ADVISED OF THE
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW,
+* NAGRAVISION 'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS
+* SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY
+* TO NAGRAVISION FOR THIS SOFTWARE.
+********************************************************************************/
+/** \brief Communication stack benchmark of the CoAP message lists.
+ *
+ *  \author Kudelski IoT
+ *
+ *  \date 2026/10/17
+ *
+ *  \file comm_bench.h
+ ******************************************************************************/
+/**
+ * @brief Communication stack benchmark of the CoAP message lists.
+ */
+
+#ifndef COMM_BENCH_H
+#define COMM_BENCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* C++ */
+
+/* -------------------------------------------------------------------------- */
+/* IMPORTS                                                                    */
+/* -------------------------------------------------------------------------- */
+#include "comm_if.h"
+
+#include <stdint.h>
+
+#ifdef BENCHMARK_FEATURE
+/* -------------------------------------------------------------------------- */
+/* CONSTANTS, TYPES, ENUM                                                     */
+/* -------------------------------------------------------------------------- */
+
+/** @brief Cost of the received packets against the CoAP message lists, in ns per packet. */
+typedef struct
+{
+  uint32_t  hashIndexSize;
+  /* SN_COAP_HASH_INDEX_SIZE of the build, 0 if the lists are walked. */
+  uint32_t  ackResendNs;
+  /* ACK of a pending CON, release of its sent copy, then a new CON to the same peer. */
+  uint32_t  newConNs;
+  /* CON with a new message id, stored in the duplicate list, evicting the oldest entry. */
+  uint32_t  duplicateConNs;
+  /* CON found in the duplicate list. */
+} TCommBenchIndexResult;
+
+/* -------------------------------------------------------------------------- */
+/* VARIABLES                                                                  */
+/* -------------------------------------------------------------------------- */
+
+/* -------------------------------------------------------------------------- */
+/* FUNCTIONS                                                                  */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief
+ *   Measure the lookups of a CoAP handle whose resend queue, sent blockwise messages and
+ *   duplicate list hold xEntries entries, one peer per entry, with a private handle and no
+ *   socket. Build once with SN_COAP_HASH_INDEX_SIZE 0 and once with the index to compare.
+ *   The stack must be built with SN_COAP_DUPLICATION_MAX_MSGS_COUNT not 0, and with
+ *   SN_COAP_MAX_ALLOWED_RESENDING_BUFF_SIZE_MSGS and
+ *   SN_COAP_MAX_ALLOWED_DUPLICATION_MESSAGE_COUNT of at least xEntries.
+ *
+ * @param[in] xEntries
+ *   Number of outstanding entries in each list.
+ *   Should not be 0.
+ * @param[in] xPackets
+ *   Number of packets of each workload.
+ *   Should not be 0.
+ * @param[out] xpResult
+ *   Cost of each workload.
+ *   Should not be NULL.
+ *
+ * @return
+ * - E_COMM_IF_STATUS_OK in case of success.
+ * - E_COMM_IF_STATUS_PARAMETER for wrong input parameter(s), or lists the build cannot size.
+ * - E_COMM_IF_STATUS_MEMORY if the handle cannot be created.
+ * - E_COMM_IF_STATUS_ERROR if a packet is not handled as expected.
+ */
+TCommIfStatus commBenchIndex
+(
+  const uint8_t           xEntries,
+  const uint32_t          xPackets,
+  TCommBenchIndexResult*  xpResult
+);
+#endif /* BENCHMARK_FEATURE */
+
+#ifdef __cplusplus
+}
+#endif /* C++ */
+
+#endif // COMM_BENCH_H
+
+/* -------------------------------------------------------------------------- */
+/* END OF FILE                                                                */
+/* -------------------------------------------------------------------------- */
@@ -54,6 +54,37 @@ extern "C" {
 /* CONSTANTS, TYPES, ENUM                                                     */
 /* -------------------------------------------------------------------------- */
 
+/** @brief Memory pool statistics, see comm_pool.h. */
+struct SCommPoolStats;
+
+/** @brief Round-trip time estimate of the CoAP stack, see sn_coap_protocol.h. */
+struct sn_coap_rto_;
+
+#ifndef C_COMM_IF__MAX_EXCHANGES
+/** @brief Max exchanges in progress at the same time, sharing the socket. Each one keeps a
+ *  message in the CoAP resending queue, bounded by SN_COAP_MAX_ALLOWED_RESENDING_BUFF_SIZE_MSGS. */
+#define C_COMM_IF__MAX_EXCHANGES  (4u)
+#endif /* C_COMM_IF__MAX_EXCHANGES */
+
+/**
+ * @brief
+ *   Completion callback of an exchange submitted with commExchangeSubmit(). Runs from the
+ *   thread polling in commExchangePoll() or commMessageExchange(), with the stack locked.
+ *
+ * @param[in] xpArg
+ *   Argument given to commExchangeSubmit().
+ * @param[in] xStatus
+ *   Status of the exchange, E_COMM_IF_STATUS_OK if a response was received.
+ * @param[in] xReceivedLength
+ *   Length of the response copied to the receive buffer, in bytes.
+ */
+typedef void (*TCommExchangeCb)
+(
+  void*                xpArg,
+  const TCommIfStatus  xStatus,
+  const size_t         xReceivedLength
+);
+
 /* -------------------------------------------------------------------------- */
 /* VARIABLES                                                                  */
 /* -------------------------------------------------------------------------- */
@@ -94,6 +125,7 @@ TCommIfStatus commInitProtocol
 /**
  * @brief
  *   Sends the message to keySTREAM and receives response in return.
+ *   Can be called from several threads at once, the exchanges then share the socket.
  *
  * @param[in]  xpMessageToSend
  *   Message to send to server.
@@ -122,6 +154,99 @@ TCommIfStatus commMessageExchange
   size_t*           xpReceiveMsgBufferLength
 );
 
+/**
+ * @brief
+ *   Send a message to keySTREAM without waiting for the response. The exchange then progresses
+ *   in commExchangePoll(), which runs xCallback once it completes.
+ *
+ * @param[in]  xpMessageToSend
+ *   Message to send to server.
+ *   Should not be NULL.
+ * @param[in]   xSendSize
+ *   Size of the message, in bytes.
+ * @param[in] xpReceiveMsgBuffer
+ *   Buffer receiving the response, must stay valid until the exchange completes.
+ *   Should not be NULL.
+ * @param[in] xReceiveMsgBufferLength
+ *   Length of xpReceiveMsgBuffer, in bytes.
+ * @param[in] xCallback
+ *   Completion callback.
+ *   Should not be NULL.
+ * @param[in] xpArg
+ *   Argument passed to xCallback.
+ *
+ * @return
+ * - E_COMM_IF_STATUS_OK if the message was sent, xCallback will be called.
+ * - E_COMM_IF_STATUS_PARAMETER for wrong input parameter(s).
+ * - E_COMM_IF_STATUS_ERROR if C_COMM_IF__MAX_EXCHANGES exchanges are already in progress.
+ * - E_COMM_IF_STATUS_NETWORK if any network issue.
+ */
+TCommIfStatus commExchangeSubmit
+(
+  const  uint8_t*   xpMessageToSend,
+  const  size_t     xSendSize,
+  uint8_t*          xpReceiveMsgBuffer,
+  const size_t      xReceiveMsgBufferLength,
+  TCommExchangeCb   xCallback,
+  void*             xpArg
+);
+
+/**
+ * @brief
+ *   Process the pending exchanges: wait until a datagram arrives or a retransmission is due, at
+ *   most xTimeoutMs, then route every received datagram to its exchange by token and handle the
+ *   expired timers.
+ *
+ * @param[in] xTimeoutMs
+ *   Maximum time to wait, in ms.
+ *
+ * @return
+ * - E_COMM_IF_STATUS_OK in case of success.
+ * - E_COMM_IF_STATUS_PARAMETER if the communication stack is not initialized.
+ * - E_COMM_IF_STATUS_ERROR if the socket cannot be polled.
+ */
+TCommIfStatus commExchangePoll
+(
+  const uint32_t  xTimeoutMs
+);
+
+/**
+ * @brief
+ *   Get the usage statistics of the memory pool of the CoAP stack.
+ *
+ * @param[out] xpStats
+ *   Statistics, see comm_pool.h, all zero if ENABLE_COMM_POOL is not defined.
+ *   Should not be NULL.
+ *
+ * @return
+ * - E_COMM_IF_STATUS_OK in case of success.
+ * - E_COMM_IF_STATUS_PARAMETER for wrong input parameter(s).
+ */
+TCommIfStatus commMemoryGetStats
+(
+  struct SCommPoolStats*  xpStats
+);
+
+/**
+ * @brief
+ *   Get the round-trip time estimate of the keySTREAM server, which sets the retransmission
+ *   timeout of the CoAP stack built with SN_COAP_ADAPTIVE_RTO. The estimate is kept over
+ *   commTerminateProtocol() and reused by the next commInitProtocol() to the same server.
+ *
+ * @param[out] xpEstimate
+ *   Estimate, see sn_coap_protocol.h.
+ *   Should not be NULL.
+ *
+ * @return
+ * - E_COMM_IF_STATUS_OK in case of success.
+ * - E_COMM_IF_STATUS_PARAMETER for wrong input parameter(s).
+ * - E_COMM_IF_STATUS_ERROR if not initialized, or the CoAP stack has no estimate.
+ */
+TCommIfStatus commRttGetEstimate
+(
+  struct sn_coap_rto_*  xpEstimate
+);
+
 /**
  * @brief
  *   Terminate Communication stack.
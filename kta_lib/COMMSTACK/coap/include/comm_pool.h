@@ -0,0 +1,278 @@
+/*******************************************************************************
+*************************keySTREAM Trusted Agent ("KTA")************************
+
+* (c) 2023-2025 Nagravision Sàrl
+
+* Subject to your compliance with these terms, you may use the Nagravision Sàrl
+* Software and any derivatives exclusively with Nagravision's products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may accompany
+* Nagravision Software.
+
+* Redistribution of this Nagravision Software in source or binary form is allowed
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+
+* THIS SOFTWARE IS SUPPLIED BY NAGRAVISION "AS IS". NO WARRANTIES, WHETHER EXPRESS,
+* IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF
+* NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE. IN NO
+* EVENT WILL NAGRAVISION BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL
+* OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF NAGRAVISION HAS BEEN ADVISED OF THE
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW,
+* NAGRAVISION 'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS
+* SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY
+* TO NAGRAVISION FOR THIS SOFTWARE.
+********************************************************************************/
+/** \brief Communication stack fixed-block memory pool.
+ *
+ *  \author Kudelski IoT
+ *
+ *  \date 2026/10/17
+ *
+ *  \file comm_pool.h
+ ******************************************************************************/
+/**
+ * @brief Communication stack fixed-block memory pool.
+ */
+
+#ifndef COMM_POOL_H
+#define COMM_POOL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* C++ */
+
+/* -------------------------------------------------------------------------- */
+/* IMPORTS                                                                    */
+/* -------------------------------------------------------------------------- */
+#include "comm_interface_util.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* -------------------------------------------------------------------------- */
+/* CONSTANTS, TYPES, ENUM                                                     */
+/* -------------------------------------------------------------------------- */
+
+/*
+ * The pool instances of the CoAP stack (comm_interface.c) and of the SAL allocator
+ * (k_sal_os.c) are only built when ENABLE_COMM_POOL is defined. Each instance takes
+ * C_COMM_POOL__STORAGE_SIZE bytes of static memory, about 45 KB with the default block
+ * counts; without it, both allocate from the heap.
+ */
+
+/** @brief Number of size classes, of 32, 64, 128, 256, 512, 1152 and 2048 bytes. */
+#define C_COMM_POOL__CLASS_COUNT           (7u)
+
+#ifndef C_COMM_POOL__BLOCKS_32
+/** @brief Number of 32 bytes blocks: tokens, uri paths, small CoAP objects. */
+#define C_COMM_POOL__BLOCKS_32             (64u)
+#endif /* C_COMM_POOL__BLOCKS_32 */
+
+#ifndef C_COMM_POOL__BLOCKS_64
+/** @brief Number of 64 bytes blocks: CoAP headers, retransmission entries. */
+#define C_COMM_POOL__BLOCKS_64             (48u)
+#endif /* C_COMM_POOL__BLOCKS_64 */
+
+#ifndef C_COMM_POOL__BLOCKS_128
+/** @brief Number of 128 bytes blocks: CoAP options lists. */
+#define C_COMM_POOL__BLOCKS_128            (32u)
+#endif /* C_COMM_POOL__BLOCKS_128 */
+
+#ifndef C_COMM_POOL__BLOCKS_256
+/** @brief Number of 256 bytes blocks. */
+#define C_COMM_POOL__BLOCKS_256            (8u)
+#endif /* C_COMM_POOL__BLOCKS_256 */
+
+#ifndef C_COMM_POOL__BLOCKS_512
+/** @brief Number of 512 bytes blocks. */
+#define C_COMM_POOL__BLOCKS_512            (8u)
+#endif /* C_COMM_POOL__BLOCKS_512 */
+
+#ifndef C_COMM_POOL__BLOCKS_1152
+/** @brief Number of 1152 bytes blocks: one CoAP block with its header, packet buffers. */
+#define C_COMM_POOL__BLOCKS_1152           (12u)
+#endif /* C_COMM_POOL__BLOCKS_1152 */
+
+#ifndef C_COMM_POOL__BLOCKS_2048
+/** @brief Number of 2048 bytes blocks: reassembled responses, receive buffer. */
+#define C_COMM_POOL__BLOCKS_2048           (8u)
+#endif /* C_COMM_POOL__BLOCKS_2048 */
+
+/** @brief Number of blocks of all the classes. */
+#define C_COMM_POOL__BLOCK_COUNT                                                \
+  (C_COMM_POOL__BLOCKS_32 + C_COMM_POOL__BLOCKS_64 + C_COMM_POOL__BLOCKS_128 +  \
+   C_COMM_POOL__BLOCKS_256 + C_COMM_POOL__BLOCKS_512 + C_COMM_POOL__BLOCKS_1152 + \
+   C_COMM_POOL__BLOCKS_2048)
+
+/** @brief Size of the backing memory of a pool, in bytes. */
+#define C_COMM_POOL__STORAGE_SIZE                                               \
+  ((C_COMM_POOL__BLOCKS_32 * 32u) + (C_COMM_POOL__BLOCKS_64 * 64u) +            \
+   (C_COMM_POOL__BLOCKS_128 * 128u) + (C_COMM_POOL__BLOCKS_256 * 256u) +        \
+   (C_COMM_POOL__BLOCKS_512 * 512u) + (C_COMM_POOL__BLOCKS_1152 * 1152u) +      \
+   (C_COMM_POOL__BLOCKS_2048 * 2048u))
+
+/** @brief Usage statistics of a pool. */
+typedef struct SCommPoolStats
+{
+  uint32_t  aInUse[C_COMM_POOL__CLASS_COUNT];
+  /* Blocks currently allocated, per class. */
+  uint32_t  aPeak[C_COMM_POOL__CLASS_COUNT];
+  /* Highest number of blocks allocated at once, per class. */
+  uint32_t  missCount;
+  /* Allocations the pool could not serve, too large or class exhausted. */
+  uint32_t  arenaLiveCount;
+  /* Blocks of an arena still allocated when it was closed, left to their owner. */
+} TCommPoolStats;
+
+/**
+ * @brief
+ *   Pool of fixed size blocks in static memory. An allocation takes the first free block of
+ *   the smallest class that fits, from a free list, without any heap involved.
+ */
+typedef struct
+{
+  uint64_t        aStorage[C_COMM_POOL__STORAGE_SIZE / sizeof(uint64_t)];
+  /* Backing memory of the blocks, class after class. */
+  uint8_t         aBlockState[C_COMM_POOL__BLOCK_COUNT];
+  /* Free, allocated or allocated inside the arena, per block. */
+  void*           apFreeList[C_COMM_POOL__CLASS_COUNT];
+  /* First free block, per class, each free block points to the next one. */
+  TBoolean        isInitialized;
+  /* True once the free lists are built. */
+  TBoolean        isArenaOpen;
+  /* True between commPoolArenaBegin() and commPoolArenaEnd(). */
+  TCommPoolStats  stats;
+  /* Usage statistics. */
+} TCommPool;
+
+/* -------------------------------------------------------------------------- */
+/* VARIABLES                                                                  */
+/* -------------------------------------------------------------------------- */
+
+/* -------------------------------------------------------------------------- */
+/* FUNCTIONS                                                                  */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief
+ *   Allocate a block. A zero initialized pool is ready to use. Not thread safe, the caller
+ *   serializes the access to a pool.
+ *
+ * @param[in,out] xpPool
+ *   Pool.
+ *   Should not be NULL.
+ * @param[in] xSize
+ *   Size in bytes to allocate.
+ *   Should not be 0.
+ *
+ * @return
+ *   Pointer to the block, NULL if the pool cannot serve the size; the caller then falls back
+ *   to the heap.
+ */
+void* pCommPoolAlloc
+(
+  TCommPool*    xpPool,
+  const size_t  xSize
+);
+
+/**
+ * @brief
+ *   Release a block if it belongs to the pool.
+ *
+ * @param[in,out] xpPool
+ *   Pool.
+ *   Should not be NULL.
+ * @param[in] xpBlock
+ *   Block to release.
+ *
+ * @return
+ * - E_TRUE if the block belongs to the pool and was released.
+ * - E_FALSE otherwise, the caller then releases it to the heap.
+ */
+TBoolean commPoolFree
+(
+  TCommPool*  xpPool,
+  void*       xpBlock
+);
+
+/**
+ * @brief
+ *   Get the size of a block of the pool.
+ *
+ * @param[in] xpPool
+ *   Pool.
+ *   Should not be NULL.
+ * @param[in] xpBlock
+ *   Block.
+ *
+ * @return
+ *   Size of the block in bytes, 0 if it does not belong to the pool.
+ */
+size_t commPoolBlockSize
+(
+  const TCommPool*  xpPool,
+  const void*       xpBlock
+);
+
+/**
+ * @brief
+ *   Open the arena: the blocks allocated from now on are checked by commPoolArenaEnd().
+ *
+ * @param[in,out] xpPool
+ *   Pool.
+ *   Should not be NULL.
+ *
+ * @return
+ * - E_TRUE if the arena is opened.
+ * - E_FALSE if it is already open.
+ */
+TBoolean commPoolArenaBegin
+(
+  TCommPool*  xpPool
+);
+
+/**
+ * @brief
+ *   Close the arena. The blocks allocated since commPoolArenaBegin() are never released
+ *   here: those still allocated may be in use, they are counted and left to their owner.
+ *
+ * @param[in,out] xpPool
+ *   Pool.
+ *   Should not be NULL.
+ *
+ * @return
+ *   Number of blocks of the arena still allocated.
+ */
+uint32_t commPoolArenaEnd
+(
+  TCommPool*  xpPool
+);
+
+/**
+ * @brief
+ *   Get the usage statistics of a pool.
+ *
+ * @param[in] xpPool
+ *   Pool.
+ *   Should not be NULL.
+ * @param[out] xpStats
+ *   Statistics.
+ *   Should not be NULL.
+ */
+void commPoolGetStats
+(
+  const TCommPool*  xpPool,
+  TCommPoolStats*   xpStats
+);
+
+#ifdef __cplusplus
+}
+#endif /* C++ */
+
+#endif // COMM_POOL_H
+
+/* -------------------------------------------------------------------------- */
+/* END OF FILE                                                                */
+/* -------------------------------------------------------------------------- */
@@ -0,0 +1,221 @@
+/*******************************************************************************
+*************************keySTREAM Trusted Agent ("KTA")************************
+
+* (c) 2023-2025 Nagravision Sàrl
+
+* Subject to your compliance with these terms, you may use the Nagravision Sàrl
+* Software and any derivatives exclusively with Nagravision's products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may accompany
+* Nagravision Software.
+
+* Redistribution of this Nagravision Software in source or binary form is allowed
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+
+* THIS SOFTWARE IS SUPPLIED BY NAGRAVISION "AS IS". NO WARRANTIES, WHETHER EXPRESS,
+* IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF
+* NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE. IN NO
+* EVENT WILL NAGRAVISION BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL
+* OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF NAGRAVISION HAS BEEN ADVISED OF THE
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW,
+* NAGRAVISION 'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS
+* SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY
+* TO NAGRAVISION FOR THIS SOFTWARE.
+********************************************************************************/
+/** \brief Communication stack timer wheel.
+ *
+ *  \author Kudelski IoT
+ *
+ *  \date 2026/10/17
+ *
+ *  \file comm_timer.h
+ ******************************************************************************/
+/**
+ * @brief Communication stack timer wheel.
+ */
+
+#ifndef COMM_TIMER_H
+#define COMM_TIMER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* C++ */
+
+/* -------------------------------------------------------------------------- */
+/* IMPORTS                                                                    */
+/* -------------------------------------------------------------------------- */
+#include "comm_interface_util.h"
+
+#include <stdint.h>
+
+/* -------------------------------------------------------------------------- */
+/* CONSTANTS, TYPES, ENUM                                                     */
+/* -------------------------------------------------------------------------- */
+
+/** @brief Number of slots of the timer wheel. */
+#define C_COMM_TIMER__WHEEL_SLOTS          (64u)
+
+/** @brief Duration of one slot of the timer wheel, in ms. */
+#define C_COMM_TIMER__TICK_MS              (10u)
+
+/** @brief Returned by commTimerWheelNextExpiry() when no timer is armed. */
+#define C_COMM_TIMER__NO_EXPIRY            (0xFFFFFFFFu)
+
+/**
+ * @brief
+ *   Callback run when a timer expires. The timer is disarmed before the call, so the callback
+ *   may arm it again, with a non zero delay.
+ *
+ * @param[in] xpArg
+ *   Argument given to commTimerArm().
+ */
+typedef void (*TCommTimerCb)
+(
+  void*  xpArg
+);
+
+/** @brief Timer, owned by the caller and linked in one slot of the wheel while armed. */
+typedef struct SCommTimer
+{
+  struct SCommTimer*  pNext;
+  /* Next timer of the same slot. */
+  struct SCommTimer*  pPrev;
+  /* Previous timer of the same slot. */
+  uint32_t            expiryMs;
+  /* Absolute expiry time, in ms. */
+  TCommTimerCb        callback;
+  /* Callback run on expiry. */
+  void*               pArg;
+  /* Argument of the callback. */
+  TBoolean            isArmed;
+  /* True while the timer is linked in the wheel. */
+} TCommTimer;
+
+/** @brief Hashed timer wheel, timers are hashed on their expiry tick. */
+typedef struct
+{
+  TCommTimer*  apSlots[C_COMM_TIMER__WHEEL_SLOTS];
+  /* Timers per slot. */
+  uint32_t     currentTick;
+  /* Last tick processed by commTimerWheelAdvance(). */
+  uint32_t     armedCount;
+  /* Number of armed timers. */
+} TCommTimerWheel;
+
+/* -------------------------------------------------------------------------- */
+/* VARIABLES                                                                  */
+/* -------------------------------------------------------------------------- */
+
+/* -------------------------------------------------------------------------- */
+/* FUNCTIONS                                                                  */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief
+ *   Initialize an empty timer wheel.
+ *
+ * @param[out] xpWheel
+ *   Timer wheel to initialize.
+ *   Should not be NULL.
+ * @param[in] xNowMs
+ *   Current relative time, in ms.
+ */
+void commTimerWheelInit
+(
+  TCommTimerWheel*  xpWheel,
+  const uint32_t    xNowMs
+);
+
+/**
+ * @brief
+ *   Arm a timer, or re-arm it if already armed.
+ *
+ * @param[in,out] xpWheel
+ *   Timer wheel.
+ *   Should not be NULL.
+ * @param[in,out] xpTimer
+ *   Timer to arm.
+ *   Should not be NULL.
+ * @param[in] xNowMs
+ *   Current relative time, in ms.
+ * @param[in] xDelayMs
+ *   Delay before expiry, in ms.
+ * @param[in] xCallback
+ *   Callback run on expiry.
+ *   Should not be NULL.
+ * @param[in] xpArg
+ *   Argument of the callback.
+ */
+void commTimerArm
+(
+  TCommTimerWheel*  xpWheel,
+  TCommTimer*       xpTimer,
+  const uint32_t    xNowMs,
+  const uint32_t    xDelayMs,
+  TCommTimerCb      xCallback,
+  void*             xpArg
+);
+
+/**
+ * @brief
+ *   Disarm a timer. Nothing is done if the timer is not armed.
+ *
+ * @param[in,out] xpWheel
+ *   Timer wheel.
+ *   Should not be NULL.
+ * @param[in,out] xpTimer
+ *   Timer to disarm.
+ *   Should not be NULL.
+ */
+void commTimerCancel
+(
+  TCommTimerWheel*  xpWheel,
+  TCommTimer*       xpTimer
+);
+
+/**
+ * @brief
+ *   Get the time left before the first timer expires.
+ *
+ * @param[in] xpWheel
+ *   Timer wheel.
+ *   Should not be NULL.
+ * @param[in] xNowMs
+ *   Current relative time, in ms.
+ *
+ * @return
+ *   Time left in ms, 0 if a timer already expired, C_COMM_TIMER__NO_EXPIRY if no timer is armed.
+ */
+uint32_t commTimerWheelNextExpiry
+(
+  const TCommTimerWheel*  xpWheel,
+  const uint32_t          xNowMs
+);
+
+/**
+ * @brief
+ *   Run the callbacks of all expired timers.
+ *
+ * @param[in,out] xpWheel
+ *   Timer wheel.
+ *   Should not be NULL.
+ * @param[in] xNowMs
+ *   Current relative time, in ms.
+ */
+void commTimerWheelAdvance
+(
+  TCommTimerWheel*  xpWheel,
+  const uint32_t    xNowMs
+);
+
+#ifdef __cplusplus
+}
+#endif /* C++ */
+
+#endif // COMM_TIMER_H
+
+/* -------------------------------------------------------------------------- */
+/* END OF FILE                                                                */
+/* -------------------------------------------------------------------------- */
@@ -57,6 +57,9 @@ extern "C" {
 /* CONSTANTS, TYPES, ENUM                                                     */
 /* -------------------------------------------------------------------------- */
 
+/** @brief Memory pool statistics, see comm_pool.h. */
+struct SCommPoolStats;
+
 /* -------------------------------------------------------------------------- */
 /* VARIABLES                                                                  */
 /* -------------------------------------------------------------------------- */
@@ -103,8 +106,9 @@ K_SAL_API void salTimeMilliSleep
 
 /**
  * @brief
- *   Allocate a block of memory. The allocated memory can be taken either
- *   from the main memory heap or from a dedicated memory pool.
+ *   Allocate a block of memory. The allocated memory is taken from a fixed-block
+ *   memory pool in static memory, or from the main memory heap if the pool cannot
+ *   serve the size.
  *
  * @param[in] xSize
  *   Size in bytes to allocate;
@@ -151,6 +155,19 @@ K_SAL_API void salMemoryFree
   void*  xpBlock
 );
 
+/**
+ * @brief
+ *   Get the usage statistics of the memory pool serving the allocations before the heap.
+ *
+ * @param[out] xpStats
+ *   Statistics, all zero if ENABLE_COMM_POOL is not defined.
+ *   Should not be NULL.
+ */
+K_SAL_API void salMemoryGetStats
+(
+  struct SCommPoolStats*  xpStats
+);
+
 #ifdef __cplusplus
 }
 #endif /* C++ */
@@ -126,6 +126,7 @@ K_SAL_API TKCommStatus salSocketCreate
  * - E_K_COMM_STATUS_PARAMETER for wrong input parameter(s).
  * - E_K_COMM_STATUS_DATA for unexpected data.
  * - E_K_COMM_STATUS_NETWORK for network related error.
+ * - E_K_COMM_STATUS_RESOURCE if the data does not fit in one datagram of the path.
  * - E_K_COMM_STATUS_ERROR for other errors.
  */
 K_SAL_API TKCommStatus salSocketSendTo
@@ -171,6 +172,29 @@ K_SAL_API TKCommStatus salSocketReceiveFrom
   TKSocketIp*       xpAddress
 );
 
+/**
+ * @brief
+ *   Wait until data can be received on a socket, without consuming it.
+ *
+ * @param[in] xpSocket
+ *   Socket instance.
+ *   Should not be NULL.
+ * @param[in] xTimeoutMs
+ *   Maximum time to wait, in ms. 0 only checks the socket.
+ *
+ * @return
+ * - E_K_COMM_STATUS_OK if data can be received.
+ * - E_K_COMM_STATUS_PARAMETER for wrong input parameter(s).
+ * - E_K_COMM_STATUS_MISSING if no data arrived before the timeout.
+ * - E_K_COMM_STATUS_DATA if the socket is not created yet.
+ * - E_K_COMM_STATUS_ERROR for other errors.
+ */
+K_SAL_API TKCommStatus salSocketWaitReadable
+(
+  TKSalSocket*    xpSocket,
+  const uint32_t  xTimeoutMs
+);
+
 /**
  * @brief
  *   Dispose a socket instance.
@@ -26,8 +26,11 @@
 #include  "k_sal_log_extended.h"
 #include  "k_sal_os.h"
 #include  "k_sal_log.h"
+#include  "comm_pool.h"
+#include  <pthread.h>
 #include  <stdlib.h>
 #include  <stdio.h>
+#include  <string.h>
 #include  <time.h>
 #include  <unistd.h>
 
@@ -86,6 +89,18 @@
   #define M_SAL_OS_LOG_BUFF(x_pcBuffName, x_pucBuff, x_u16BuffSize) {}
 #endif
 
+/* -------------------------------------------------------------------------- */
+/* LOCAL VARIABLES                                                            */
+/* -------------------------------------------------------------------------- */
+
+#ifdef ENABLE_COMM_POOL
+/** @brief Fixed-block pool serving the allocations before the heap. */
+static TCommPool gSalMemoryPool;
+
+/** @brief Serializes the access to gSalMemoryPool. */
+static pthread_mutex_t gSalMemoryPoolLock = PTHREAD_MUTEX_INITIALIZER;
+#endif /* ENABLE_COMM_POOL */
+
 /* -------------------------------------------------------------------------- */
 /* PUBLIC FUNCTIONS - IMPLEMENTATION                                          */
 /* -------------------------------------------------------------------------- */
@@ -155,7 +170,18 @@ void* kta_pSalMemoryAllocate
       break;
     }
 
-    pBlock = malloc(xSize);
+#ifdef ENABLE_COMM_POOL
+    (void)pthread_mutex_lock(&gSalMemoryPoolLock);
+    pBlock = pCommPoolAlloc(&gSalMemoryPool, xSize);
+    (void)pthread_mutex_unlock(&gSalMemoryPoolLock);
+#endif /* ENABLE_COMM_POOL */
+
+    if (NULL == pBlock)
+    {
+      /* Too large or pool exhausted. */
+      pBlock = malloc(xSize);
+    }
+
     break;
   }
 
@@ -174,7 +200,8 @@ void* pSalMemoryReallocate
   const size_t  xNewSize
 )
 {
-  void* pBlock = xpBlock;
+  void*   pBlock = xpBlock;
+  size_t  blockSize = 0;
 
   M_SAL_OS_LOG_VAR("Start of %s", __func__);
 
@@ -186,7 +213,7 @@ void* pSalMemoryReallocate
      */
     if ((NULL == xpBlock) && (0 != xNewSize))
     {
-      pBlock = malloc(xNewSize);
+      pBlock = kta_pSalMemoryAllocate(xNewSize);
       break;
     }
 
@@ -204,7 +231,32 @@ void* pSalMemoryReallocate
       break;
     }
 
-    pBlock = realloc(xpBlock, xNewSize);
+#ifdef ENABLE_COMM_POOL
+    (void)pthread_mutex_lock(&gSalMemoryPoolLock);
+    blockSize = commPoolBlockSize(&gSalMemoryPool, xpBlock);
+    (void)pthread_mutex_unlock(&gSalMemoryPoolLock);
+#endif /* ENABLE_COMM_POOL */
+
+    if (0u == blockSize)
+    {
+      pBlock = realloc(xpBlock, xNewSize);
+      break;
+    }
+
+    /* Pool block, kept while the new size fits, moved otherwise. */
+    if (xNewSize <= blockSize)
+    {
+      break;
+    }
+
+    pBlock = kta_pSalMemoryAllocate(xNewSize);
+
+    if (NULL != pBlock)
+    {
+      (void)memcpy(pBlock, xpBlock, blockSize);
+      salMemoryFree(xpBlock);
+    }
+
     break;
   }
 
@@ -222,6 +274,8 @@ void salMemoryFree
   void*   xpBlock
 )
 {
+  TBoolean  isPoolBlock = E_FALSE;
+
   M_SAL_OS_LOG_VAR("Start of %s", __func__);
 
   for (;;)
@@ -232,9 +286,40 @@ void salMemoryFree
       break;
     }
 
-    free(xpBlock);
+#ifdef ENABLE_COMM_POOL
+    (void)pthread_mutex_lock(&gSalMemoryPoolLock);
+    isPoolBlock = commPoolFree(&gSalMemoryPool, xpBlock);
+    (void)pthread_mutex_unlock(&gSalMemoryPoolLock);
+#endif /* ENABLE_COMM_POOL */
+
+    if (E_FALSE == isPoolBlock)
+    {
+      free(xpBlock);
+    }
+
     break;
   }
 
   M_SAL_OS_LOG_VAR("End of %s", __func__);
 }
+
+/******************************************************************************/
+/** \implements salMemoryGetStats
+ *
+ ******************************************************************************/
+void salMemoryGetStats
+(
+  struct SCommPoolStats*  xpStats
+)
+{
+#ifdef ENABLE_COMM_POOL
+  (void)pthread_mutex_lock(&gSalMemoryPoolLock);
+  commPoolGetStats(&gSalMemoryPool, xpStats);
+  (void)pthread_mutex_unlock(&gSalMemoryPoolLock);
+#else
+  if (NULL != xpStats)
+  {
+    (void)memset(xpStats, 0, sizeof(TCommPoolStats));
+  }
+#endif /* ENABLE_COMM_POOL */
+}
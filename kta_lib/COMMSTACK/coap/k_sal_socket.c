@@ -32,8 +32,10 @@
 #include <netdb.h>
 #include <errno.h>
 #include <arpa/inet.h>
+#include <netinet/in.h>
 #include <unistd.h>
 #include <fcntl.h>
+#include <poll.h>
 
 /******************************************************************************/
 /*                                                                            */
@@ -291,6 +293,7 @@ static TKCommStatus salSocketCreateIfNeeded
   uint8_t type = 0;
   int flags = C_SAL_SOCKET_ERROR_RET;
   int ret = C_SAL_SOCKET_ERROR_RET;
+  int pmtuDiscover = 0;
 
   M_SAL_SOCKET_LOG_VAR("Start of %s", __func__);
 
@@ -380,6 +383,31 @@ static TKCommStatus salSocketCreateIfNeeded
       break;
     }
 
+    /* Don't fragment: a datagram larger than the path MTU fails with EMSGSIZE in
+    salSocketSendTo instead of being fragmented or silently lost. */
+    if (E_SAL_SOCKET_TYPE_UDP == xpThis->type)
+    {
+      if (AF_INET == address.sin_family)
+      {
+        pmtuDiscover = IP_PMTUDISC_DO;
+        ret = setsockopt(xpThis->socketId, IPPROTO_IP, IP_MTU_DISCOVER,
+                         &pmtuDiscover, sizeof(pmtuDiscover));
+      }
+      else
+      {
+        pmtuDiscover = IPV6_PMTUDISC_DO;
+        ret = setsockopt(xpThis->socketId, IPPROTO_IPV6, IPV6_MTU_DISCOVER,
+                         &pmtuDiscover, sizeof(pmtuDiscover));
+      }
+
+      if (C_SAL_SOCKET_ERROR_RET == ret)
+      {
+        M_SAL_SOCKET_LOG("ERROR: Failed to enable the path MTU discovery.");
+        status = E_K_COMM_STATUS_ERROR;
+        break;
+      }
+    }
+
     xpThis->isCreated = true;
     status = E_K_COMM_STATUS_OK;
     break; /* always */
@@ -679,6 +707,13 @@ TKCommStatus salSocketSendTo
 
     if (C_SAL_SOCKET_ERROR_RET == size)
     {
+      /* The datagram exceeds the path MTU, known from an ICMP too-big or the interface. */
+      if (EMSGSIZE == errno)
+      {
+        M_SAL_SOCKET_LOG_VAR("ERROR: Datagram too big for the path, size=%d.", (int)xBufferLength);
+        status = E_K_COMM_STATUS_RESOURCE;
+        break;
+      }
       /* With some architectures or kernel, the socket might return an 101 error
       We don't really care about this error if UDP is used */
       if (E_SAL_SOCKET_TYPE_UDP == xpThis->type)
@@ -855,6 +890,68 @@ TKCommStatus salSocketReceiveFrom
   return status;
 } /* salSocketReceiveFrom */
 
+/*
+ *  @brief    Wait until data can be received on a socket.
+ */
+TKCommStatus salSocketWaitReadable
+(
+  TKSalSocket* xpThis,
+  const uint32_t xTimeoutMs
+)
+{
+  struct pollfd pollFd;
+  int ready = 0;
+  TKCommStatus status = E_K_COMM_STATUS_ERROR;
+
+  M_SAL_SOCKET_LOG_VAR("Start of %s", __func__);
+
+  for (;;)
+  { /* pseudo-loop */
+    if (true != salSocketIsValidInstance(xpThis))
+    {
+      M_SAL_SOCKET_LOG("ERROR: Invalid socket instance");
+      status = E_K_COMM_STATUS_PARAMETER;
+      break;
+    } /* if */
+
+    if (true != xpThis->isCreated)
+    {
+      M_SAL_SOCKET_LOG("ERROR: Socket not created");
+      status = E_K_COMM_STATUS_DATA;
+      break;
+    } /* if */
+
+    pollFd.fd = xpThis->socketId;
+    pollFd.events = POLLIN;
+    pollFd.revents = 0;
+
+    do
+    {
+      ready = poll(&pollFd, 1, (xTimeoutMs > (uint32_t)INT32_MAX) ? -1 : (int)xTimeoutMs);
+    } while ((C_SAL_SOCKET_ERROR_RET == ready) && (EINTR == errno));
+
+    if (ready > 0)
+    {
+      status = E_K_COMM_STATUS_OK;
+    } /* if */
+    else if (0 == ready)
+    {
+      status = E_K_COMM_STATUS_MISSING;
+    } /* else if */
+    else
+    {
+      M_SAL_SOCKET_LOG("ERROR: poll failed.");
+      status = E_K_COMM_STATUS_ERROR;
+    } /* else */
+
+    break;
+  } /* pseudo-loop */
+
+  M_SAL_SOCKET_LOG_VAR("End of %s", __func__);
+
+  return status;
+} /* salSocketWaitReadable */
+
 /*
  *  @brief    Dispose a socket instance.
  */
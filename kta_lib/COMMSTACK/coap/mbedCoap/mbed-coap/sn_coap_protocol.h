@@ -168,6 +168,63 @@ extern int8_t sn_coap_protocol_set_duplicate_buffer_size(struct coap_s *handle,
 extern int8_t sn_coap_protocol_set_retransmission_parameters(struct coap_s *handle,
         uint8_t resending_count, uint8_t resending_interval);
 
+/**
+ * \brief Round-trip time estimate of one destination, used when SN_COAP_ADAPTIVE_RTO is enabled.
+ *
+ * Times are in milliseconds. Strong samples are taken from messages acknowledged
+ * without re-sending, weak samples from messages acknowledged after one or two re-sendings.
+ */
+typedef struct sn_coap_rto_ {
+    uint32_t    rto;            /**< Retransmission timeout of the next confirmable message, before randomization */
+    uint32_t    srtt_strong;    /**< Smoothed round-trip time of the strong samples */
+    uint32_t    rttvar_strong;  /**< Round-trip time variation of the strong samples */
+    uint32_t    srtt_weak;      /**< Smoothed round-trip time of the weak samples */
+    uint32_t    rttvar_weak;    /**< Round-trip time variation of the weak samples */
+    uint32_t    updated;        /**< Clock time of the last change of rto */
+    uint16_t    strong_samples; /**< Count of strong samples, saturates */
+    uint16_t    weak_samples;   /**< Count of weak samples, saturates */
+} sn_coap_rto_s;
+
+/**
+ * \fn int8_t sn_coap_protocol_set_rto_clock(struct coap_s *handle, uint32_t (*clock_ms)(void))
+ *
+ * \brief If the adaptive retransmission timeout is enabled, gives the clock the round-trip
+ *  times are measured with and turns the estimation on. Re-sending times are then read from
+ *  this clock instead of the time given to sn_coap_protocol_exec().
+ *
+ * \param *handle Pointer to CoAP library handle
+ * \param clock_ms Monotonic clock in milliseconds, may wrap. NULL turns the estimation off.
+ * \return  0 = success, -1 = failure
+ */
+extern int8_t sn_coap_protocol_set_rto_clock(struct coap_s *handle, uint32_t (*clock_ms)(void));
+
+/**
+ * \fn int8_t sn_coap_protocol_get_rto(struct coap_s *handle, const sn_nsdl_addr_s *addr_ptr, sn_coap_rto_s *rto_ptr)
+ *
+ * \brief Reads the round-trip time estimate of a destination, for tuning or to keep it
+ *  over sn_coap_protocol_destroy().
+ *
+ * \param *handle Pointer to CoAP library handle
+ * \param *addr_ptr Destination address and port
+ * \param *rto_ptr Filled with the estimate
+ * \return  0 = success, -1 = invalid parameter or feature disabled, -2 = no estimate for this destination
+ */
+extern int8_t sn_coap_protocol_get_rto(struct coap_s *handle, const sn_nsdl_addr_s *addr_ptr, sn_coap_rto_s *rto_ptr);
+
+/**
+ * \fn int8_t sn_coap_protocol_set_rto(struct coap_s *handle, const sn_nsdl_addr_s *addr_ptr, const sn_coap_rto_s *rto_ptr)
+ *
+ * \brief Sets the round-trip time estimate of a destination, e.g. one read back with
+ *  sn_coap_protocol_get_rto() from a previous handle. The rto is bounded to
+ *  SN_COAP_ADAPTIVE_RTO_MIN - SN_COAP_ADAPTIVE_RTO_MAX.
+ *
+ * \param *handle Pointer to CoAP library handle
+ * \param *addr_ptr Destination address and port
+ * \param *rto_ptr Estimate to use
+ * \return  0 = success, -1 = invalid parameter or feature disabled
+ */
+extern int8_t sn_coap_protocol_set_rto(struct coap_s *handle, const sn_nsdl_addr_s *addr_ptr, const sn_coap_rto_s *rto_ptr);
+
 /**
  * \fn int8_t sn_coap_protocol_set_retransmission_buffer(uint8_t buffer_size_messages, uint16_t buffer_size_bytes)
  *
@@ -300,4 +300,70 @@
 #define SN_COAP_REDUCE_BLOCKWISE_HEAP_FOOTPRINT              0   /**< Disabled by default */
 #endif
 
+/**
+ * \def SN_COAP_HASH_INDEX_SIZE
+ * \brief Number of slots of the hash index kept alongside each message list
+ * (re-sending, duplication detection, sent blockwise messages and received
+ * blockwise payloads). With the index, finding the message of a received
+ * packet costs the same whatever the number of stored messages; without it
+ * the lists are walked. Must be a power of two, each list can be indexed up
+ * to 3/4 of it and is walked above that. Every slot costs 16 bytes per list
+ * in struct coap_s on 64-bit targets.
+ * By default, this feature is disabled, 0 disables the feature.
+ */
+#ifdef MBED_CONF_MBED_CLIENT_SN_COAP_HASH_INDEX_SIZE
+#define SN_COAP_HASH_INDEX_SIZE MBED_CONF_MBED_CLIENT_SN_COAP_HASH_INDEX_SIZE
+#endif
+
+#ifndef SN_COAP_HASH_INDEX_SIZE
+#define SN_COAP_HASH_INDEX_SIZE                         0
+#endif
+
+/**
+ * \def SN_COAP_ADAPTIVE_RTO
+ * \brief Enables the CoCoA adaptive retransmission timeout (draft-ietf-core-cocoa).
+ * The round-trip time to each destination is measured from the acknowledgements of
+ * confirmable messages, and the first timeout of the next confirmable message follows
+ * it instead of the fixed re-send interval. The re-send interval is then only the
+ * timeout of destinations without measurement. Takes effect once a millisecond clock
+ * is given with 'sn_coap_protocol_set_rto_clock()' API, re-sending times are kept in
+ * milliseconds in any case.
+ * By default, this feature is enabled.
+ */
+#ifdef MBED_CONF_MBED_CLIENT_SN_COAP_ADAPTIVE_RTO
+#define SN_COAP_ADAPTIVE_RTO MBED_CONF_MBED_CLIENT_SN_COAP_ADAPTIVE_RTO
+#endif
+
+#ifndef SN_COAP_ADAPTIVE_RTO
+#define SN_COAP_ADAPTIVE_RTO                            1
+#endif
+
+/**
+ * \def SN_COAP_ADAPTIVE_RTO_PEER_COUNT
+ * \brief Number of destinations whose round-trip time estimate is kept,
+ * the least recently used one is replaced. By default value is 4.
+ */
+#ifndef SN_COAP_ADAPTIVE_RTO_PEER_COUNT
+#define SN_COAP_ADAPTIVE_RTO_PEER_COUNT                 4
+#endif
+
+/**
+ * \def SN_COAP_ADAPTIVE_RTO_MIN
+ * \brief Lower bound of the adaptive retransmission timeout in milliseconds,
+ * keeps a peer that answers from a fast link but takes time to process from
+ * being flooded. By default value is 100.
+ */
+#ifndef SN_COAP_ADAPTIVE_RTO_MIN
+#define SN_COAP_ADAPTIVE_RTO_MIN                        100
+#endif
+
+/**
+ * \def SN_COAP_ADAPTIVE_RTO_MAX
+ * \brief Upper bound of the adaptive retransmission timeout in milliseconds,
+ * also applies to every backed off timeout. By default value is 60000.
+ */
+#ifndef SN_COAP_ADAPTIVE_RTO_MAX
+#define SN_COAP_ADAPTIVE_RTO_MAX                        60000
+#endif
+
 #endif // SN_CONFIG_H
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2011-2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * \file sn_coap_hash_index.h
+ *
+ * \brief Header file for the optional hash index of the CoAP protocol lists
+ *
+ * An index is an open-addressing table kept alongside one ns_list. It only
+ * speeds up lookups: the list stays the owner of the entries and its order
+ * stays the search order, a lookup returns the same entry as a walk of the
+ * list would.
+ *
+ */
+
+#ifndef SN_COAP_HASH_INDEX_H_
+#define SN_COAP_HASH_INDEX_H_
+
+#include "ns_types.h"
+#include "ns_list.h"
+#include "mbed-coap/sn_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if SN_COAP_HASH_INDEX_SIZE
+
+#if (SN_COAP_HASH_INDEX_SIZE & (SN_COAP_HASH_INDEX_SIZE - 1))
+#error "SN_COAP_HASH_INDEX_SIZE must be a power of two"
+#endif
+
+#if (SN_COAP_HASH_INDEX_SIZE > 512)
+#error "SN_COAP_HASH_INDEX_SIZE too large, struct coap_s must stay below 64 KiB"
+#endif
+
+#define SN_COAP_HASH_INDEX_SEED     2166136261u /**< FNV-1a offset basis */
+
+/* Returns the hash of the key currently held by a list entry */
+typedef uint32_t (*sn_coap_hash_index_key_fn)(const void *entry);
+
+/* Returns true when a list entry matches the searched key */
+typedef bool (*sn_coap_hash_index_match_fn)(const void *entry, const void *key);
+
+typedef struct coap_hash_slot_ {
+    void                *entry;     /* NULL when the slot is free */
+    uint32_t            hash;
+    uint32_t            seq;        /* Order of the entry in the list, lowest is first */
+} coap_hash_slot_s;
+
+typedef struct coap_hash_index_ {
+    coap_hash_slot_s            slot[SN_COAP_HASH_INDEX_SIZE];
+    const ns_list_t             *list;          /* List the index is kept for */
+    sn_coap_hash_index_key_fn   key_fn;
+    uint32_t                    next_seq;
+    uint16_t                    count;          /* Entries in the list */
+    uint16_t                    used;           /* Slots holding an entry or a tombstone */
+    ns_list_offset_t            link_offset;
+    bool                        overflow;       /* List outgrew the table, lookups walk the list */
+} coap_hash_index_s;
+
+/* Position of an iteration over all entries matching a key */
+typedef struct coap_hash_index_cursor_ {
+    uint_fast16_t       probe;
+    void                *entry;
+} coap_hash_index_cursor_s;
+
+void sn_coap_hash_index_init(coap_hash_index_s *index, const ns_list_t *list,
+                             ns_list_offset_t link_offset, sn_coap_hash_index_key_fn key_fn);
+
+uint32_t sn_coap_hash_index_hash(uint32_t hash, const void *data, uint_fast16_t len);
+
+void sn_coap_hash_index_add(coap_hash_index_s *index, void *entry);
+
+void sn_coap_hash_index_remove(coap_hash_index_s *index, void *entry);
+
+void sn_coap_hash_index_rekey(coap_hash_index_s *index, void *entry, uint32_t old_hash);
+
+void *sn_coap_hash_index_find(const coap_hash_index_s *index, uint32_t hash,
+                              sn_coap_hash_index_match_fn match_fn, const void *key);
+
+void *sn_coap_hash_index_next(const coap_hash_index_s *index, uint32_t hash,
+                              sn_coap_hash_index_match_fn match_fn, const void *key,
+                              coap_hash_index_cursor_s *cursor);
+
+/* Binds an index to a list declared with NS_LIST_HEAD() */
+#define SN_COAP_HASH_INDEX_INIT(index, list, key_fn) \
+    sn_coap_hash_index_init((index), &(list)->slist, NS_LIST_OFFSET_(list), (key_fn))
+
+/* Called after the entry was added to the end of the list */
+#define SN_COAP_HASH_INDEX_ADD(index, entry)        sn_coap_hash_index_add((index), (entry))
+
+/* Called after the entry was removed from the list */
+#define SN_COAP_HASH_INDEX_REMOVE(index, entry)     sn_coap_hash_index_remove((index), (entry))
+
+#else
+
+#define SN_COAP_HASH_INDEX_INIT(index, list, key_fn)    ((void)0)
+#define SN_COAP_HASH_INDEX_ADD(index, entry)            ((void)0)
+#define SN_COAP_HASH_INDEX_REMOVE(index, entry)         ((void)0)
+
+#endif /* SN_COAP_HASH_INDEX_SIZE */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SN_COAP_HASH_INDEX_H_ */
@@ -27,6 +27,8 @@
 #include "ns_list.h"
 #include "sn_coap_header_internal.h"
 #include "mbed-coap/sn_config.h"
+#include "sn_coap_hash_index.h"
+#include "sn_coap_rto.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -46,7 +48,12 @@ int8_t prepare_blockwise_message(struct coap_s *handle, struct sn_coap_hdr_ *coa
 /* Structure which is stored to Linked list for message sending purposes */
 typedef struct coap_send_msg_ {
     uint_fast8_t        resending_counter;  /* Tells how many times message is still tried to resend */
-    uint32_t            resending_time;     /* Tells next resending time */
+    uint32_t            resending_time;     /* Tells next resending time, in milliseconds with SN_COAP_ADAPTIVE_RTO */
+#if SN_COAP_ADAPTIVE_RTO
+    uint32_t            sending_time;       /* Clock time of the first transmission */
+    uint32_t            resending_timeout;  /* Current timeout in milliseconds */
+    uint_fast8_t        resending_backoff;  /* Timeout multiplier after each re-sending, in halves */
+#endif
 
     sn_nsdl_transmit_s  send_msg_ptr;
 
@@ -123,15 +130,29 @@ struct coap_s {
 
     #if ENABLE_RESENDINGS /* If Message resending is not used at all, this part of code will not be compiled */
         coap_send_msg_list_t linked_list_resent_msgs; /* Active resending messages are stored to this Linked list */
+        #if SN_COAP_HASH_INDEX_SIZE
+        coap_hash_index_s    resent_msgs_index; /* Index of linked_list_resent_msgs by Message ID */
+        #endif
+        #if SN_COAP_ADAPTIVE_RTO
+        uint32_t (*sn_coap_rto_clock)(void); /* Millisecond clock, round-trip times are measured once set */
+        coap_rto_peer_s      rto_peers[SN_COAP_ADAPTIVE_RTO_PEER_COUNT]; /* Round-trip time estimates by destination */
+        #endif
     #endif
 
     #if SN_COAP_DUPLICATION_MAX_MSGS_COUNT /* If Message duplication detection is not used at all, this part of code will not be compiled */
         coap_duplication_info_list_t  linked_list_duplication_msgs; /* Messages for duplicated messages detection is stored to this Linked list */
+        #if SN_COAP_HASH_INDEX_SIZE
+        coap_hash_index_s             duplication_msgs_index; /* Index of linked_list_duplication_msgs by Message ID and port */
+        #endif
     #endif
 
     #if SN_COAP_BLOCKWISE_ENABLED || SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE /* If Message blockwise is not enabled, this part of code will not be compiled */
         coap_blockwise_msg_list_t     linked_list_blockwise_sent_msgs; /* Blockwise message to to be sent is stored to this Linked list */
         coap_blockwise_payload_list_t linked_list_blockwise_received_payloads; /* Blockwise payload to to be received is stored to this Linked list */
+        #if SN_COAP_HASH_INDEX_SIZE
+        coap_hash_index_s             blockwise_sent_msgs_index; /* Index of linked_list_blockwise_sent_msgs by Message ID */
+        coap_hash_index_s             blockwise_received_payloads_index; /* Index of linked_list_blockwise_received_payloads by port and token */
+        #endif
     #endif
 
     uint32_t system_time;    /* System time seconds */
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2011-2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * \file sn_coap_rto.h
+ *
+ * \brief Header file for the adaptive retransmission timeout of the CoAP protocol
+ *
+ * Keeps one CoCoA round-trip time estimator per destination and derives from
+ * it the timeouts of the confirmable messages sent there.
+ *
+ */
+
+#ifndef SN_COAP_RTO_H_
+#define SN_COAP_RTO_H_
+
+#include "ns_types.h"
+#include "mbed-coap/sn_config.h"
+#include "mbed-coap/sn_coap_header.h"
+#include "mbed-coap/sn_coap_protocol.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if SN_COAP_ADAPTIVE_RTO
+
+#define SN_COAP_RTO_ADDR_MAX_LEN    16  /**< Longest address remembered, IPv6 */
+
+/* Estimate of one destination */
+typedef struct coap_rto_peer_ {
+    sn_coap_rto_s       rto;
+    uint32_t            used;       /* Clock time of the last lookup, the oldest peer is replaced */
+    uint16_t            port;
+    uint8_t             addr_len;   /* 0 when the entry is free */
+    uint8_t             addr[SN_COAP_RTO_ADDR_MAX_LEN];
+} coap_rto_peer_s;
+
+/**
+ * \brief Finds the estimate of a destination.
+ *
+ * \param initial_rto is the timeout of a new destination in milliseconds, 0 to only search
+ *
+ * \return The estimate, or NULL if not found and initial_rto is 0 or the address is too long
+ */
+coap_rto_peer_s *sn_coap_rto_peer_get(coap_rto_peer_s *peers, const sn_nsdl_addr_s *addr_ptr,
+                                      uint32_t initial_rto, uint32_t now);
+
+/**
+ * \brief Returns the timeout of the next confirmable message, ages the estimate first
+ * if it was not updated for long.
+ */
+uint32_t sn_coap_rto_get(sn_coap_rto_s *rto, uint32_t now);
+
+/**
+ * \brief Adds a round-trip time sample.
+ *
+ * \param rtt is the time from the first transmission to the acknowledgement
+ * \param resendings is the count of re-sendings before the acknowledgement
+ */
+void sn_coap_rto_update(sn_coap_rto_s *rto, uint32_t rtt, uint_fast8_t resendings, uint32_t now);
+
+/**
+ * \brief Returns the variable backoff factor for a first timeout, in halves.
+ */
+uint_fast8_t sn_coap_rto_backoff(uint32_t timeout);
+
+/**
+ * \brief Bounds a timeout to SN_COAP_ADAPTIVE_RTO_MIN - SN_COAP_ADAPTIVE_RTO_MAX.
+ */
+uint32_t sn_coap_rto_bound(uint32_t timeout);
+
+#endif /* SN_COAP_ADAPTIVE_RTO */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SN_COAP_RTO_H_ */
@@ -0,0 +1,348 @@
+/*
+ * Copyright (c) 2011-2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * \file sn_coap_hash_index.c
+ *
+ * \brief Optional hash index of the CoAP protocol lists
+ *
+ * Functionality: Open-addressing table with linear probing, mapping the hash
+ * of an entry's key to the entry. Removed entries leave a tombstone until no
+ * probe sequence runs through it or the next rebuild. Every slot carries the
+ * position of its entry in the list, so a lookup returns the first match in
+ * list order even when several entries share a key. When the list holds more
+ * entries than the table can take, the index switches itself off and lookups
+ * walk the list until it has shrunk to half of the table again.
+ *
+ */
+
+/* * * * INCLUDE FILES * * * */
+#include <string.h> /* For memset() */
+
+#include "ns_types.h"
+#include "ns_list.h"
+#include "mbed-coap/sn_config.h"
+#include "sn_coap_hash_index.h"
+
+#if SN_COAP_HASH_INDEX_SIZE
+
+#define SN_COAP_HASH_INDEX_MASK         (SN_COAP_HASH_INDEX_SIZE - 1u)
+#define SN_COAP_HASH_INDEX_LOAD_LIMIT   ((SN_COAP_HASH_INDEX_SIZE * 3u) / 4u)  /**< Keeps probe sequences short */
+#define SN_COAP_HASH_INDEX_FNV_PRIME    16777619u
+#define SN_COAP_HASH_INDEX_TOMBSTONE    ((void *)&sn_coap_hash_index_tombstone)
+
+/* * * * LOCAL FUNCTION PROTOTYPES * * * */
+static uint_fast16_t     sn_coap_hash_index_start(uint32_t hash);
+static void              sn_coap_hash_index_clear(coap_hash_index_s *index);
+static void              sn_coap_hash_index_insert(coap_hash_index_s *index, void *entry, uint32_t hash, uint32_t seq);
+static coap_hash_slot_s *sn_coap_hash_index_locate(coap_hash_index_s *index, const void *entry, uint32_t hash);
+static void              sn_coap_hash_index_vacate(coap_hash_index_s *index, coap_hash_slot_s *slot_ptr);
+static void              sn_coap_hash_index_rebuild(coap_hash_index_s *index);
+
+/* Address used to mark removed slots, never a list entry */
+static uint8_t sn_coap_hash_index_tombstone;
+
+void sn_coap_hash_index_init(coap_hash_index_s *index, const ns_list_t *list,
+                             ns_list_offset_t link_offset, sn_coap_hash_index_key_fn key_fn)
+{
+    index->list = list;
+    index->link_offset = link_offset;
+    index->key_fn = key_fn;
+    sn_coap_hash_index_rebuild(index);
+}
+
+uint32_t sn_coap_hash_index_hash(uint32_t hash, const void *data, uint_fast16_t len)
+{
+    const uint8_t *byte_ptr = data;
+
+    while (len--) {
+        hash ^= *byte_ptr++;
+        hash *= SN_COAP_HASH_INDEX_FNV_PRIME;
+    }
+
+    return hash;
+}
+
+void sn_coap_hash_index_add(coap_hash_index_s *index, void *entry)
+{
+    ++index->count;
+
+    if (index->overflow) {
+        return;
+    }
+
+    if (index->count > SN_COAP_HASH_INDEX_LOAD_LIMIT) {
+        sn_coap_hash_index_clear(index);
+        index->overflow = true;
+        return;
+    }
+
+    /* Out of free slots or sequence numbers, the list already holds the new entry */
+    if ((index->used >= SN_COAP_HASH_INDEX_LOAD_LIMIT) || (index->next_seq == UINT32_MAX)) {
+        sn_coap_hash_index_rebuild(index);
+        return;
+    }
+
+    sn_coap_hash_index_insert(index, entry, index->key_fn(entry), index->next_seq++);
+}
+
+void sn_coap_hash_index_remove(coap_hash_index_s *index, void *entry)
+{
+    --index->count;
+
+    if (index->overflow) {
+        if (index->count <= (SN_COAP_HASH_INDEX_SIZE / 2u)) {
+            sn_coap_hash_index_rebuild(index);
+        }
+        return;
+    }
+
+    if (index->count == 0) {
+        sn_coap_hash_index_clear(index);
+        return;
+    }
+
+    coap_hash_slot_s *slot_ptr = sn_coap_hash_index_locate(index, entry, index->key_fn(entry));
+    if (slot_ptr) {
+        sn_coap_hash_index_vacate(index, slot_ptr);
+    }
+}
+
+void sn_coap_hash_index_rekey(coap_hash_index_s *index, void *entry, uint32_t old_hash)
+{
+    if (index->overflow) {
+        return;
+    }
+
+    coap_hash_slot_s *slot_ptr = sn_coap_hash_index_locate(index, entry, old_hash);
+    if (!slot_ptr) {
+        return;
+    }
+
+    /* Entry keeps its place in the list, so it keeps its sequence number */
+    const uint32_t seq = slot_ptr->seq;
+    sn_coap_hash_index_vacate(index, slot_ptr);
+    sn_coap_hash_index_insert(index, entry, index->key_fn(entry), seq);
+
+    if (index->used > SN_COAP_HASH_INDEX_LOAD_LIMIT) {
+        sn_coap_hash_index_rebuild(index);
+    }
+}
+
+void *sn_coap_hash_index_find(const coap_hash_index_s *index, uint32_t hash,
+                              sn_coap_hash_index_match_fn match_fn, const void *key)
+{
+    if (index->overflow) {
+        for (void *entry = index->list->first_entry; entry; entry = ns_list_get_next_(index->link_offset, entry)) {
+            if (match_fn(entry, key)) {
+                return entry;
+            }
+        }
+        return NULL;
+    }
+
+    const coap_hash_slot_s *found_ptr = NULL;
+    uint_fast16_t i = sn_coap_hash_index_start(hash);
+
+    /* Whole probe sequence is checked, an older duplicate may sit behind a newer one */
+    for (uint_fast16_t probe = 0; probe < SN_COAP_HASH_INDEX_SIZE; probe++) {
+        const coap_hash_slot_s *slot_ptr = &index->slot[i];
+
+        if (!slot_ptr->entry) {
+            break;
+        }
+
+        if ((slot_ptr->entry != SN_COAP_HASH_INDEX_TOMBSTONE) && (slot_ptr->hash == hash) &&
+                (!found_ptr || (slot_ptr->seq < found_ptr->seq)) && match_fn(slot_ptr->entry, key)) {
+            found_ptr = slot_ptr;
+        }
+
+        i = (i + 1u) & SN_COAP_HASH_INDEX_MASK;
+    }
+
+    return found_ptr ? found_ptr->entry : NULL;
+}
+
+void *sn_coap_hash_index_next(const coap_hash_index_s *index, uint32_t hash,
+                              sn_coap_hash_index_match_fn match_fn, const void *key,
+                              coap_hash_index_cursor_s *cursor)
+{
+    if (index->overflow) {
+        void *entry = cursor->entry ? ns_list_get_next_(index->link_offset, cursor->entry) : index->list->first_entry;
+
+        while (entry && !match_fn(entry, key)) {
+            entry = ns_list_get_next_(index->link_offset, entry);
+        }
+
+        cursor->entry = entry;
+        return entry;
+    }
+
+    while (cursor->probe < SN_COAP_HASH_INDEX_SIZE) {
+        const coap_hash_slot_s *slot_ptr = &index->slot[(sn_coap_hash_index_start(hash) + cursor->probe) & SN_COAP_HASH_INDEX_MASK];
+
+        if (!slot_ptr->entry) {
+            cursor->probe = SN_COAP_HASH_INDEX_SIZE;
+            break;
+        }
+
+        cursor->probe++;
+
+        if ((slot_ptr->entry != SN_COAP_HASH_INDEX_TOMBSTONE) && (slot_ptr->hash == hash) && match_fn(slot_ptr->entry, key)) {
+            return slot_ptr->entry;
+        }
+    }
+
+    return NULL;
+}
+
+/**************************************************************************//**
+ * \fn static uint_fast16_t sn_coap_hash_index_start(uint32_t hash)
+ *
+ * \brief Returns the first slot of the probe sequence of a hash
+ *****************************************************************************/
+
+static uint_fast16_t sn_coap_hash_index_start(uint32_t hash)
+{
+    return (hash ^ (hash >> 16)) & SN_COAP_HASH_INDEX_MASK;
+}
+
+/**************************************************************************//**
+ * \fn static void sn_coap_hash_index_clear(coap_hash_index_s *index)
+ *
+ * \brief Empties the table, the entry count is kept
+ *****************************************************************************/
+
+static void sn_coap_hash_index_clear(coap_hash_index_s *index)
+{
+    memset(index->slot, 0, sizeof(index->slot));
+    index->used = 0;
+    index->next_seq = 0;
+}
+
+/**************************************************************************//**
+ * \fn static void sn_coap_hash_index_insert(coap_hash_index_s *index, void *entry, uint32_t hash, uint32_t seq)
+ *
+ * \brief Stores an entry to the first free or removed slot of its probe sequence
+ *****************************************************************************/
+
+static void sn_coap_hash_index_insert(coap_hash_index_s *index, void *entry, uint32_t hash, uint32_t seq)
+{
+    uint_fast16_t i = sn_coap_hash_index_start(hash);
+
+    while (index->slot[i].entry && (index->slot[i].entry != SN_COAP_HASH_INDEX_TOMBSTONE)) {
+        i = (i + 1u) & SN_COAP_HASH_INDEX_MASK;
+    }
+
+    if (!index->slot[i].entry) {
+        ++index->used;
+    }
+
+    index->slot[i].entry = entry;
+    index->slot[i].hash = hash;
+    index->slot[i].seq = seq;
+}
+
+/**************************************************************************//**
+ * \fn static coap_hash_slot_s *sn_coap_hash_index_locate(coap_hash_index_s *index, const void *entry, uint32_t hash)
+ *
+ * \brief Finds the slot of an entry
+ *
+ * Falls back to scanning the whole table, should the key of the entry have
+ * been changed in place since it was indexed.
+ *
+ * \return Slot of the entry or NULL if the entry is not indexed
+ *****************************************************************************/
+
+static coap_hash_slot_s *sn_coap_hash_index_locate(coap_hash_index_s *index, const void *entry, uint32_t hash)
+{
+    uint_fast16_t i = sn_coap_hash_index_start(hash);
+
+    for (uint_fast16_t probe = 0; (probe < SN_COAP_HASH_INDEX_SIZE) && index->slot[i].entry; probe++) {
+        if (index->slot[i].entry == entry) {
+            return &index->slot[i];
+        }
+        i = (i + 1u) & SN_COAP_HASH_INDEX_MASK;
+    }
+
+    for (i = 0; i < SN_COAP_HASH_INDEX_SIZE; i++) {
+        if (index->slot[i].entry == entry) {
+            return &index->slot[i];
+        }
+    }
+
+    return NULL;
+}
+
+/**************************************************************************//**
+ * \fn static void sn_coap_hash_index_vacate(coap_hash_index_s *index, coap_hash_slot_s *slot_ptr)
+ *
+ * \brief Removes the entry of a slot
+ *
+ * The slot becomes a tombstone, so that probe sequences running through it
+ * still reach the entries behind. Tombstones directly in front of a free
+ * slot end no probe sequence and are freed straight away.
+ *****************************************************************************/
+
+static void sn_coap_hash_index_vacate(coap_hash_index_s *index, coap_hash_slot_s *slot_ptr)
+{
+    uint_fast16_t i = (uint_fast16_t)(slot_ptr - index->slot);
+
+    slot_ptr->entry = SN_COAP_HASH_INDEX_TOMBSTONE;
+
+    if (index->slot[(i + 1u) & SN_COAP_HASH_INDEX_MASK].entry) {
+        return;
+    }
+
+    while (index->slot[i].entry == SN_COAP_HASH_INDEX_TOMBSTONE) {
+        index->slot[i].entry = NULL;
+        --index->used;
+        i = (i - 1u) & SN_COAP_HASH_INDEX_MASK;
+    }
+}
+
+/**************************************************************************//**
+ * \fn static void sn_coap_hash_index_rebuild(coap_hash_index_s *index)
+ *
+ * \brief Indexes the list again, in list order
+ *
+ * Purges tombstones and renumbers the entries. Switches the index off if the
+ * list holds more entries than the table can take.
+ *****************************************************************************/
+
+static void sn_coap_hash_index_rebuild(coap_hash_index_s *index)
+{
+    uint_fast16_t count = 0;
+
+    sn_coap_hash_index_clear(index);
+
+    for (void *entry = index->list->first_entry; entry; entry = ns_list_get_next_(index->link_offset, entry)) {
+        ++count;
+    }
+
+    index->count = count;
+    index->overflow = (count > SN_COAP_HASH_INDEX_LOAD_LIMIT);
+
+    if (index->overflow) {
+        return;
+    }
+
+    for (void *entry = index->list->first_entry; entry; entry = ns_list_get_next_(index->link_offset, entry)) {
+        sn_coap_hash_index_insert(index, entry, index->key_fn(entry), index->next_seq++);
+    }
+}
+
+#endif /* SN_COAP_HASH_INDEX_SIZE */
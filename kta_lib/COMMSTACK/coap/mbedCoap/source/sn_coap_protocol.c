@@ -71,15 +71,22 @@ static bool                     sn_coap_handle_last_blockwise(struct coap_s *han
 static sn_coap_hdr_s            *sn_coap_protocol_copy_header(struct coap_s *handle, const sn_coap_hdr_s *source_header_ptr);
 static coap_blockwise_msg_s     *search_sent_blockwise_message(struct coap_s *handle, uint16_t msg_id);
 static int16_t                  store_blockwise_copy(struct coap_s *handle, const sn_coap_hdr_s *src_coap_msg_ptr, void *param, uint16_t original_payload_len, bool copy_payload);
+static bool                     sn_coap_protocol_send_block1(struct coap_s *handle, coap_blockwise_msg_s *stored_blockwise_msg_ptr, uint32_t block_number, uint8_t block_temp, sn_nsdl_addr_s *dst_addr_ptr, void *param);
+static uint8_t                  sn_coap_protocol_block1_smaller_size(const sn_coap_hdr_s *received_coap_msg_ptr, uint8_t sent_block_temp);
 #endif
 
 #if ENABLE_RESENDINGS
-static uint8_t               sn_coap_protocol_linked_list_send_msg_store(struct coap_s *handle, sn_nsdl_addr_s *dst_addr_ptr, uint_fast16_t send_packet_data_len, uint8_t *send_packet_data_ptr, uint32_t sending_time, void *param);
+static uint8_t               sn_coap_protocol_linked_list_send_msg_store(struct coap_s *handle, sn_nsdl_addr_s *dst_addr_ptr, uint_fast16_t send_packet_data_len, uint8_t *send_packet_data_ptr, void *param);
 static void                  sn_coap_protocol_linked_list_send_msg_remove(struct coap_s *handle, const sn_nsdl_addr_s *src_addr_ptr, uint16_t msg_id);
 static coap_send_msg_s      *sn_coap_protocol_allocate_mem_for_msg(struct coap_s *handle, sn_nsdl_addr_s *dst_addr_ptr, uint_fast16_t packet_data_len);
 static void                  sn_coap_protocol_release_allocated_send_msg_mem(struct coap_s *handle, coap_send_msg_s *freed_send_msg_ptr);
 static uint_fast16_t         sn_coap_count_linked_list_size(const coap_send_msg_list_t *linked_list_ptr);
-static uint32_t              sn_coap_calculate_new_resend_time(const uint32_t current_time, const uint8_t interval, const uint8_t counter);
+static uint32_t              sn_coap_calculate_new_resend_time(const uint32_t current_time, const uint32_t interval, const uint8_t counter);
+static uint32_t              sn_coap_protocol_resend_clock(const struct coap_s *handle);
+static void                  sn_coap_protocol_schedule_resending(struct coap_s *handle, coap_send_msg_s *msg_ptr, uint32_t current_time);
+#if SN_COAP_ADAPTIVE_RTO
+static void                  sn_coap_protocol_rto_sample(struct coap_s *handle, const coap_send_msg_s *msg_ptr);
+#endif
 #endif
 
 static uint16_t              read_packet_msg_id(const coap_send_msg_s *stored_msg);
@@ -87,6 +94,55 @@ static uint16_t              get_new_message_id(void);
 
 static bool                  compare_port(const sn_nsdl_addr_s *left, const sn_nsdl_addr_s *right);
 
+/* Search key of the re-sending and duplication detection lists, NULL address matches any port */
+typedef struct coap_msg_id_key_ {
+    const sn_nsdl_addr_s    *addr_ptr;
+    uint16_t                msg_id;
+} coap_msg_id_key_s;
+
+/* Search key of sn_coap_protocol_linked_list_duplication_info_remove() */
+typedef struct coap_duplication_key_ {
+    const uint8_t           *addr_ptr;
+    uint16_t                port;
+    uint16_t                msg_id;
+} coap_duplication_key_s;
+
+/* Search key of the received blockwise payloads */
+typedef struct coap_blockwise_payload_key_ {
+    const sn_nsdl_addr_s    *addr_ptr;
+    const uint8_t           *token_ptr;
+    uint8_t                 token_len;
+} coap_blockwise_payload_key_s;
+
+#if ENABLE_RESENDINGS
+static coap_send_msg_s      *sn_coap_protocol_linked_list_send_msg_search(const struct coap_s *handle, const coap_msg_id_key_s *key);
+static bool                  sn_coap_protocol_send_msg_match(const void *entry, const void *key);
+#endif
+#if SN_COAP_DUPLICATION_MAX_MSGS_COUNT
+static bool                  sn_coap_protocol_duplication_info_match(const void *entry, const void *key);
+static bool                  sn_coap_protocol_duplication_info_match_address(const void *entry, const void *key);
+#endif
+#if SN_COAP_BLOCKWISE_ENABLED || SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE
+static bool                  sn_coap_protocol_blockwise_msg_match(const void *entry, const void *key);
+static void                  sn_coap_protocol_blockwise_msg_set_msg_id(struct coap_s *handle, coap_blockwise_msg_s *msg_ptr, uint16_t msg_id);
+static bool                  sn_coap_protocol_blockwise_payload_match(const void *entry, const void *key);
+#endif
+
+#if SN_COAP_HASH_INDEX_SIZE
+static uint32_t              sn_coap_protocol_msg_id_hash(uint16_t msg_id, const uint16_t *port_ptr);
+#if ENABLE_RESENDINGS
+static uint32_t              sn_coap_protocol_send_msg_key(const void *entry);
+#endif
+#if SN_COAP_DUPLICATION_MAX_MSGS_COUNT
+static uint32_t              sn_coap_protocol_duplication_info_key(const void *entry);
+#endif
+#if SN_COAP_BLOCKWISE_ENABLED || SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE
+static uint32_t              sn_coap_protocol_token_hash(uint16_t port, const uint8_t *token_ptr, uint8_t token_len);
+static uint32_t              sn_coap_protocol_blockwise_msg_key(const void *entry);
+static uint32_t              sn_coap_protocol_blockwise_payload_key(const void *entry);
+#endif
+#endif /* SN_COAP_HASH_INDEX_SIZE */
+
 /* * * * * * * * * * * * * * * * * */
 /* * * * GLOBAL DECLARATIONS * * * */
 /* * * * * * * * * * * * * * * * * */
@@ -107,6 +163,7 @@ int8_t sn_coap_protocol_destroy(struct coap_s *handle)
     ns_list_foreach_safe(coap_duplication_info_s, tmp, &handle->linked_list_duplication_msgs) {
 
         ns_list_remove(&handle->linked_list_duplication_msgs, tmp);
+        SN_COAP_HASH_INDEX_REMOVE(&handle->duplication_msgs_index, tmp);
 
         sn_coap_protocol_duplication_info_free(handle, tmp);
     }
@@ -158,6 +215,7 @@ struct coap_s *sn_coap_protocol_init(void *(*used_malloc_func_ptr)(uint16_t), vo
 #if ENABLE_RESENDINGS  /* If Message resending is not used at all, this part of code will not be compiled */
     /* * * * Create Linked list for storing active resending messages  * * * */
     ns_list_init(&handle->linked_list_resent_msgs);
+    SN_COAP_HASH_INDEX_INIT(&handle->resent_msgs_index, &handle->linked_list_resent_msgs, sn_coap_protocol_send_msg_key);
     handle->sn_coap_resending_queue_msgs = SN_COAP_RESENDING_QUEUE_SIZE_MSGS;
     handle->sn_coap_resending_queue_bytes = SN_COAP_RESENDING_QUEUE_SIZE_BYTES;
     handle->sn_coap_resending_intervall = DEFAULT_RESPONSE_TIMEOUT;
@@ -169,6 +227,7 @@ struct coap_s *sn_coap_protocol_init(void *(*used_malloc_func_ptr)(uint16_t), vo
 #if SN_COAP_DUPLICATION_MAX_MSGS_COUNT /* If Message duplication detection is not used at all, this part of code will not be compiled */
     /* * * * Create Linked list for storing Duplication info * * * */
     ns_list_init(&handle->linked_list_duplication_msgs);
+    SN_COAP_HASH_INDEX_INIT(&handle->duplication_msgs_index, &handle->linked_list_duplication_msgs, sn_coap_protocol_duplication_info_key);
     handle->sn_coap_duplication_buffer_size = SN_COAP_DUPLICATION_MAX_MSGS_COUNT;
 #endif
 
@@ -176,6 +235,8 @@ struct coap_s *sn_coap_protocol_init(void *(*used_malloc_func_ptr)(uint16_t), vo
 
     ns_list_init(&handle->linked_list_blockwise_sent_msgs);
     ns_list_init(&handle->linked_list_blockwise_received_payloads);
+    SN_COAP_HASH_INDEX_INIT(&handle->blockwise_sent_msgs_index, &handle->linked_list_blockwise_sent_msgs, sn_coap_protocol_blockwise_msg_key);
+    SN_COAP_HASH_INDEX_INIT(&handle->blockwise_received_payloads_index, &handle->linked_list_blockwise_received_payloads, sn_coap_protocol_blockwise_payload_key);
     handle->sn_coap_block_data_size = SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE;
 
 #endif /* ENABLE_RESENDINGS */
@@ -279,6 +340,64 @@ int8_t sn_coap_protocol_set_retransmission_parameters(struct coap_s *handle,
     return -1;
 }
 
+int8_t sn_coap_protocol_set_rto_clock(struct coap_s *handle, uint32_t (*clock_ms)(void))
+{
+    (void) handle;
+    (void) clock_ms;
+#if ENABLE_RESENDINGS && SN_COAP_ADAPTIVE_RTO
+    if (handle == NULL) {
+        return -1;
+    }
+    handle->sn_coap_rto_clock = clock_ms;
+    return 0;
+#endif
+    return -1;
+}
+
+int8_t sn_coap_protocol_get_rto(struct coap_s *handle, const sn_nsdl_addr_s *addr_ptr, sn_coap_rto_s *rto_ptr)
+{
+    (void) handle;
+    (void) addr_ptr;
+    (void) rto_ptr;
+#if ENABLE_RESENDINGS && SN_COAP_ADAPTIVE_RTO
+    if (handle == NULL || addr_ptr == NULL || rto_ptr == NULL) {
+        return -1;
+    }
+
+    const coap_rto_peer_s *peer_ptr = sn_coap_rto_peer_get(handle->rto_peers, addr_ptr, 0, sn_coap_protocol_resend_clock(handle));
+    if (peer_ptr == NULL) {
+        return -2;
+    }
+
+    *rto_ptr = peer_ptr->rto;
+    return 0;
+#endif
+    return -1;
+}
+
+int8_t sn_coap_protocol_set_rto(struct coap_s *handle, const sn_nsdl_addr_s *addr_ptr, const sn_coap_rto_s *rto_ptr)
+{
+    (void) handle;
+    (void) addr_ptr;
+    (void) rto_ptr;
+#if ENABLE_RESENDINGS && SN_COAP_ADAPTIVE_RTO
+    if (handle == NULL || addr_ptr == NULL || rto_ptr == NULL) {
+        return -1;
+    }
+
+    coap_rto_peer_s *peer_ptr = sn_coap_rto_peer_get(handle->rto_peers, addr_ptr, handle->sn_coap_resending_intervall * 1000u,
+                                                     sn_coap_protocol_resend_clock(handle));
+    if (peer_ptr == NULL) {
+        return -1;
+    }
+
+    peer_ptr->rto = *rto_ptr;
+    peer_ptr->rto.rto = sn_coap_rto_bound(rto_ptr->rto);
+    return 0;
+#endif
+    return -1;
+}
+
 int8_t sn_coap_protocol_set_retransmission_buffer(struct coap_s *handle,
                                                   uint8_t buffer_size_messages, uint16_t buffer_size_bytes)
 {
@@ -306,6 +425,7 @@ void sn_coap_protocol_clear_retransmission_buffer(struct coap_s *handle)
     }
     ns_list_foreach_safe(coap_send_msg_s, tmp, &handle->linked_list_resent_msgs) {
         ns_list_remove(&handle->linked_list_resent_msgs, tmp);
+        SN_COAP_HASH_INDEX_REMOVE(&handle->resent_msgs_index, tmp);
         sn_coap_protocol_release_allocated_send_msg_mem(handle, tmp);
     }
     handle->count_resent_msgs = 0;
@@ -318,16 +438,14 @@ int8_t sn_coap_protocol_delete_retransmission(struct coap_s *handle, uint16_t ms
     if (handle == NULL) {
         return -1;
     }
-    ns_list_foreach_safe(coap_send_msg_s, tmp, &handle->linked_list_resent_msgs) {
-        if (tmp->send_msg_ptr.packet_ptr) {
-            uint16_t temp_msg_id = read_packet_msg_id(tmp);
-            if (temp_msg_id == msg_id) {
-                ns_list_remove(&handle->linked_list_resent_msgs, tmp);
-                --handle->count_resent_msgs;
-                sn_coap_protocol_release_allocated_send_msg_mem(handle, tmp);
-                return 0;
-            }
-        }
+    const coap_msg_id_key_s key = { NULL, msg_id };
+    coap_send_msg_s *tmp = sn_coap_protocol_linked_list_send_msg_search(handle, &key);
+    if (tmp) {
+        ns_list_remove(&handle->linked_list_resent_msgs, tmp);
+        SN_COAP_HASH_INDEX_REMOVE(&handle->resent_msgs_index, tmp);
+        --handle->count_resent_msgs;
+        sn_coap_protocol_release_allocated_send_msg_mem(handle, tmp);
+        return 0;
     }
 #endif
     return -2;
@@ -348,6 +466,7 @@ int8_t sn_coap_protocol_delete_retransmission_by_token(struct coap_s *handle, co
 
                 tr_debug("sn_coap_protocol_delete_retransmission_by_token - removed msg_id: %" PRIu16, read_packet_msg_id(stored_msg));
                 ns_list_remove(&handle->linked_list_resent_msgs, stored_msg);
+                SN_COAP_HASH_INDEX_REMOVE(&handle->resent_msgs_index, stored_msg);
                 --handle->count_resent_msgs;
 
                 /* Free memory of stored message */
@@ -464,9 +583,7 @@ int16_t sn_coap_protocol_build(struct coap_s *handle, sn_nsdl_addr_s *dst_addr_p
     /* Check if built Message type was confirmable, only these messages are resent */
     if (src_coap_msg_ptr->msg_type == COAP_MSG_TYPE_CONFIRMABLE) {
         /* Store message to Linked list for resending purposes */
-        uint32_t resend_time = sn_coap_calculate_new_resend_time(handle->system_time, handle->sn_coap_resending_intervall, 0);
         if (sn_coap_protocol_linked_list_send_msg_store(handle, dst_addr_ptr, byte_count_built, dst_packet_data_ptr,
-                                                        resend_time,
                                                         param) == 0) {
             return -4;
         }
@@ -552,6 +669,7 @@ static int16_t store_blockwise_copy(struct coap_s *handle, const sn_coap_hdr_s *
     stored_blockwise_msg_ptr->msg_id = copied_msg_ptr->msg_id;
 
     ns_list_add_to_end(&handle->linked_list_blockwise_sent_msgs, stored_blockwise_msg_ptr);
+    SN_COAP_HASH_INDEX_ADD(&handle->blockwise_sent_msgs_index, stored_blockwise_msg_ptr);
 
     return 0;
 }
@@ -852,13 +970,15 @@ int8_t sn_coap_protocol_exec(struct coap_s *handle, uint32_t current_time)
 #endif
 
 #if ENABLE_RESENDINGS
+    const uint32_t resend_clock = sn_coap_protocol_resend_clock(handle);
+
     /* Check if there is ongoing active message sendings */
     /* foreach_safe isn't sufficient because callback routine could cancel messages. */
 rescan:
     ns_list_foreach(coap_send_msg_s, stored_msg_ptr, &handle->linked_list_resent_msgs) {
         // First check that msg belongs to handle
         /* Check if it is time to send this message */
-        if (current_time >= stored_msg_ptr->resending_time) {
+        if ((int32_t)(resend_clock - stored_msg_ptr->resending_time) >= 0) {
             /* * * Increase Resending counter  * * */
             stored_msg_ptr->resending_counter++;
 
@@ -869,6 +989,7 @@ rescan:
 
                 /* Remove message from Linked list */
                 ns_list_remove(&handle->linked_list_resent_msgs, stored_msg_ptr);
+                SN_COAP_HASH_INDEX_REMOVE(&handle->resent_msgs_index, stored_msg_ptr);
                 --handle->count_resent_msgs;
 
                 /* If RX callback have been defined.. */
@@ -896,9 +1017,7 @@ rescan:
                                             stored_msg_ptr->send_msg_ptr.packet_len, &stored_msg_ptr->send_msg_ptr.dst_addr_ptr, stored_msg_ptr->param);
 
                 /* * * Count new Resending time  * * */
-                stored_msg_ptr->resending_time = sn_coap_calculate_new_resend_time(current_time,
-                                                                                   handle->sn_coap_resending_intervall,
-                                                                                   stored_msg_ptr->resending_counter);
+                sn_coap_protocol_schedule_resending(handle, stored_msg_ptr, resend_clock);
             }
             /* Callback routine could have wiped the list (eg as a response to sending failed) */
             /* Be super cautious and rescan from the start */
@@ -914,9 +1033,9 @@ rescan:
 #if ENABLE_RESENDINGS  /* If Message resending is not used at all, this part of code will not be compiled */
 
 /**************************************************************************//**
- * \fn static uint8_t sn_coap_protocol_linked_list_send_msg_store(sn_nsdl_addr_s *dst_addr_ptr, uint16_t send_packet_data_len, uint8_t *send_packet_data_ptr, uint32_t sending_time)
+ * \fn static uint8_t sn_coap_protocol_linked_list_send_msg_store(sn_nsdl_addr_s *dst_addr_ptr, uint16_t send_packet_data_len, uint8_t *send_packet_data_ptr, void *param)
  *
- * \brief Stores message to Linked list for sending purposes.
+ * \brief Stores message to Linked list for sending purposes and schedules its first re-sending.
 
  * \param *dst_addr_ptr is pointer to destination address where CoAP message will be sent
  *
@@ -924,15 +1043,13 @@ rescan:
  *
  * \param *send_packet_data_ptr is Packet data to be stored
  *
- * \param sending_time is stored sending time
- *
  * \return 0 Allocation or buffer limit reached
  *
  * \return 1 Msg stored properly
  *****************************************************************************/
 
 static uint8_t sn_coap_protocol_linked_list_send_msg_store(struct coap_s *restrict handle, sn_nsdl_addr_s *restrict dst_addr_ptr, uint_fast16_t send_packet_data_len,
-                                                           uint8_t *restrict send_packet_data_ptr, uint32_t sending_time, void *param)
+                                                           uint8_t *restrict send_packet_data_ptr, void *param)
 {
 
     coap_send_msg_s *restrict stored_msg_ptr;
@@ -967,7 +1084,6 @@ static uint8_t sn_coap_protocol_linked_list_send_msg_store(struct coap_s *restri
 
     /* Filling of coap_send_msg_s with initialization values */
     stored_msg_ptr->resending_counter = 0;
-    stored_msg_ptr->resending_time = sending_time;
 
     /* Filling of sn_nsdl_transmit_s */
     stored_msg_ptr->send_msg_ptr.protocol = SN_NSDL_PROTOCOL_COAP;
@@ -982,8 +1098,11 @@ static uint8_t sn_coap_protocol_linked_list_send_msg_store(struct coap_s *restri
 
     stored_msg_ptr->param = param;
 
+    sn_coap_protocol_schedule_resending(handle, stored_msg_ptr, sn_coap_protocol_resend_clock(handle));
+
     /* Storing Resending message to Linked list */
     ns_list_add_to_end(&handle->linked_list_resent_msgs, stored_msg_ptr);
+    SN_COAP_HASH_INDEX_ADD(&handle->resent_msgs_index, stored_msg_ptr);
     ++handle->count_resent_msgs;
     return 1;
 }
@@ -1000,36 +1119,149 @@ static uint8_t sn_coap_protocol_linked_list_send_msg_store(struct coap_s *restri
 
 static void sn_coap_protocol_linked_list_send_msg_remove(struct coap_s *restrict handle, const sn_nsdl_addr_s *restrict src_addr_ptr, uint16_t msg_id)
 {
-    /* Loop all stored resending messages in Linked list */
-    ns_list_foreach(coap_send_msg_s, stored_msg_ptr, &handle->linked_list_resent_msgs) {
-        /* Get message ID from stored resending message */
-        uint16_t temp_msg_id = read_packet_msg_id(stored_msg_ptr);
-        /* If message's Message ID is same than is searched */
-        if (temp_msg_id == msg_id) {
-            /* If message's Source address and port is same than is searched */
-
-            if (compare_port(src_addr_ptr, &stored_msg_ptr->send_msg_ptr.dst_addr_ptr)) {
-                /* * * Message found * * */
-                /* Remove message from Linked list */
-                ns_list_remove(&handle->linked_list_resent_msgs, stored_msg_ptr);
-                --handle->count_resent_msgs;
+    const coap_msg_id_key_s key = { src_addr_ptr, msg_id };
+    coap_send_msg_s *stored_msg_ptr = sn_coap_protocol_linked_list_send_msg_search(handle, &key);
 
-                /* Free memory of stored message */
-                sn_coap_protocol_release_allocated_send_msg_mem(handle, stored_msg_ptr);
+    if (stored_msg_ptr) {
+        /* * * Message found * * */
+#if SN_COAP_ADAPTIVE_RTO
+        sn_coap_protocol_rto_sample(handle, stored_msg_ptr);
+#endif
 
-                return;
-            }
+        /* Remove message from Linked list */
+        ns_list_remove(&handle->linked_list_resent_msgs, stored_msg_ptr);
+        SN_COAP_HASH_INDEX_REMOVE(&handle->resent_msgs_index, stored_msg_ptr);
+        --handle->count_resent_msgs;
+
+        /* Free memory of stored message */
+        sn_coap_protocol_release_allocated_send_msg_mem(handle, stored_msg_ptr);
+    }
+}
+
+/**************************************************************************//**
+ * \fn static coap_send_msg_s *sn_coap_protocol_linked_list_send_msg_search(const struct coap_s *handle, const coap_msg_id_key_s *key)
+ *
+ * \brief Searches stored resending message from Linked list
+ *
+ * \param *key is Message ID and address key to be searched
+ *
+ * \return Return value is the first matching message in Linked list or NULL if not found
+ *****************************************************************************/
+
+static coap_send_msg_s *sn_coap_protocol_linked_list_send_msg_search(const struct coap_s *handle, const coap_msg_id_key_s *key)
+{
+#if SN_COAP_HASH_INDEX_SIZE
+    return sn_coap_hash_index_find(&handle->resent_msgs_index, sn_coap_protocol_msg_id_hash(key->msg_id, NULL),
+                                   sn_coap_protocol_send_msg_match, key);
+#else
+    /* Loop all stored resending messages in Linked list */
+    ns_list_foreach(coap_send_msg_s, stored_msg_ptr, &handle->linked_list_resent_msgs) {
+        if (sn_coap_protocol_send_msg_match(stored_msg_ptr, key)) {
+            return stored_msg_ptr;
         }
     }
+    return NULL;
+#endif
 }
 
-uint32_t sn_coap_calculate_new_resend_time(const uint32_t current_time, const uint8_t interval, const uint8_t counter)
+uint32_t sn_coap_calculate_new_resend_time(const uint32_t current_time, const uint32_t interval, const uint8_t counter)
 {
     uint32_t resend_time = interval << counter;
     uint16_t random_factor = randLIB_get_random_in_range(100, RESPONSE_RANDOM_FACTOR * 100);
     return current_time + ((resend_time * random_factor) / 100);
 }
 
+/**************************************************************************//**
+ * \fn static uint32_t sn_coap_protocol_resend_clock(const struct coap_s *handle)
+ *
+ * \brief Returns the current time in the unit of the re-sending times
+ *
+ * \return Clock given to sn_coap_protocol_set_rto_clock() if any, else the last system time given
+ *          to the library, in milliseconds with SN_COAP_ADAPTIVE_RTO and in seconds without
+ *****************************************************************************/
+
+static uint32_t sn_coap_protocol_resend_clock(const struct coap_s *handle)
+{
+#if SN_COAP_ADAPTIVE_RTO
+    if (handle->sn_coap_rto_clock) {
+        return handle->sn_coap_rto_clock();
+    }
+    return handle->system_time * 1000;
+#else
+    return handle->system_time;
+#endif
+}
+
+/**************************************************************************//**
+ * \fn static void sn_coap_protocol_schedule_resending(struct coap_s *handle, coap_send_msg_s *msg_ptr, uint32_t current_time)
+ *
+ * \brief Sets the next re-sending time of a stored message, after its transmission number resending_counter
+ *
+ * With a round-trip time clock, the first timeout is the estimate of the destination
+ * randomized by RESPONSE_RANDOM_FACTOR, and the next ones grow by the backoff chosen from
+ * it. Otherwise the re-send interval doubles each time.
+ *
+ * \param *msg_ptr is the stored message
+ *
+ * \param current_time is the current time from sn_coap_protocol_resend_clock()
+ *****************************************************************************/
+
+static void sn_coap_protocol_schedule_resending(struct coap_s *handle, coap_send_msg_s *msg_ptr, uint32_t current_time)
+{
+#if SN_COAP_ADAPTIVE_RTO
+    if (handle->sn_coap_rto_clock) {
+        uint32_t timeout;
+
+        if (msg_ptr->resending_counter == 0) {
+            const uint32_t initial_rto = handle->sn_coap_resending_intervall * 1000u;
+            coap_rto_peer_s *peer_ptr = sn_coap_rto_peer_get(handle->rto_peers, &msg_ptr->send_msg_ptr.dst_addr_ptr,
+                                                             initial_rto, current_time);
+            uint32_t rto = peer_ptr ? sn_coap_rto_get(&peer_ptr->rto, current_time) : initial_rto;
+
+            timeout = (rto * randLIB_get_random_in_range(100, RESPONSE_RANDOM_FACTOR * 100)) / 100;
+            msg_ptr->sending_time = current_time;
+            msg_ptr->resending_backoff = sn_coap_rto_backoff(rto);
+        } else {
+            timeout = sn_coap_rto_bound((msg_ptr->resending_timeout * msg_ptr->resending_backoff) / 2);
+        }
+
+        msg_ptr->resending_timeout = timeout;
+        msg_ptr->resending_time = current_time + timeout;
+        return;
+    }
+
+    msg_ptr->resending_time = sn_coap_calculate_new_resend_time(current_time, handle->sn_coap_resending_intervall * 1000u,
+                                                                msg_ptr->resending_counter);
+#else
+    msg_ptr->resending_time = sn_coap_calculate_new_resend_time(current_time, handle->sn_coap_resending_intervall,
+                                                                msg_ptr->resending_counter);
+#endif
+}
+
+#if SN_COAP_ADAPTIVE_RTO
+/**************************************************************************//**
+ * \fn static void sn_coap_protocol_rto_sample(struct coap_s *handle, const coap_send_msg_s *msg_ptr)
+ *
+ * \brief Measures the round-trip time of an acknowledged message for the estimate of its destination
+ *
+ * \param *msg_ptr is the acknowledged message, still stored
+ *****************************************************************************/
+
+static void sn_coap_protocol_rto_sample(struct coap_s *handle, const coap_send_msg_s *msg_ptr)
+{
+    /* resending_timeout is 0 if the message was stored before the clock was given */
+    if (handle->sn_coap_rto_clock && msg_ptr->resending_timeout) {
+        const uint32_t now = handle->sn_coap_rto_clock();
+        coap_rto_peer_s *peer_ptr = sn_coap_rto_peer_get(handle->rto_peers, &msg_ptr->send_msg_ptr.dst_addr_ptr,
+                                                         handle->sn_coap_resending_intervall * 1000u, now);
+
+        if (peer_ptr) {
+            sn_coap_rto_update(&peer_ptr->rto, now - msg_ptr->sending_time, msg_ptr->resending_counter, now);
+        }
+    }
+}
+#endif
+
 #endif /* ENABLE_RESENDINGS */
 
 void sn_coap_protocol_send_rst(struct coap_s *handle, uint16_t msg_id, sn_nsdl_addr_s *addr_ptr, void *param)
@@ -1110,6 +1342,7 @@ static void sn_coap_protocol_linked_list_duplication_info_store(struct coap_s *r
     /* * * * Storing Duplication info to Linked list * * * */
 
     ns_list_add_to_end(&handle->linked_list_duplication_msgs, stored_duplication_info_ptr);
+    SN_COAP_HASH_INDEX_ADD(&handle->duplication_msgs_index, stored_duplication_info_ptr);
     ++handle->count_duplication_msgs;
 }
 
@@ -1127,18 +1360,21 @@ static void sn_coap_protocol_linked_list_duplication_info_store(struct coap_s *r
 static coap_duplication_info_s *sn_coap_protocol_linked_list_duplication_info_search(const struct coap_s *handle,
                                                                                      const sn_nsdl_addr_s *addr_ptr, const uint16_t msg_id)
 {
+    const coap_msg_id_key_s key = { addr_ptr, msg_id };
+
+#if SN_COAP_HASH_INDEX_SIZE
+    return sn_coap_hash_index_find(&handle->duplication_msgs_index, sn_coap_protocol_msg_id_hash(msg_id, &addr_ptr->port),
+                                   sn_coap_protocol_duplication_info_match, &key);
+#else
     /* Loop all nodes in Linked list for searching Message ID */
     ns_list_foreach(coap_duplication_info_s, stored_duplication_info_ptr, &handle->linked_list_duplication_msgs) {
-        /* If message's Message ID is same than is searched */
-        if (stored_duplication_info_ptr->msg_id == msg_id) {
-            /* If message's Source address & port is same than is searched */
-            if (compare_port(addr_ptr, stored_duplication_info_ptr->address)) {
-                /* * * Correct Duplication info found * * * */
-                return stored_duplication_info_ptr;
-            }
+        if (sn_coap_protocol_duplication_info_match(stored_duplication_info_ptr, &key)) {
+            /* * * Correct Duplication info found * * * */
+            return stored_duplication_info_ptr;
         }
     }
     return NULL;
+#endif
 }
 
 
@@ -1156,6 +1392,7 @@ static void sn_coap_protocol_linked_list_duplication_info_remove_old_ones(struct
         if ((handle->system_time - removed_duplication_info_ptr->timestamp)  > SN_COAP_DUPLICATION_MAX_TIME_MSGS_STORED) {
             /* * * * Old Duplication info found, remove it from Linked list * * * */
             ns_list_remove(&handle->linked_list_duplication_msgs, removed_duplication_info_ptr);
+            SN_COAP_HASH_INDEX_REMOVE(&handle->duplication_msgs_index, removed_duplication_info_ptr);
             --handle->count_duplication_msgs;
 
             /* Free memory of stored Duplication info */
@@ -1169,28 +1406,32 @@ static void sn_coap_protocol_linked_list_duplication_info_remove_old_ones(struct
 void sn_coap_protocol_linked_list_duplication_info_remove(struct coap_s *handle, const uint8_t *scr_addr_ptr, const uint16_t port, const uint16_t msg_id)
 {
 #if SN_COAP_DUPLICATION_MAX_MSGS_COUNT
+    const coap_duplication_key_s key = { scr_addr_ptr, port, msg_id };
+    coap_duplication_info_s *removed_duplication_info_ptr = NULL;
+
+#if SN_COAP_HASH_INDEX_SIZE
+    removed_duplication_info_ptr = sn_coap_hash_index_find(&handle->duplication_msgs_index, sn_coap_protocol_msg_id_hash(msg_id, &port),
+                                                            sn_coap_protocol_duplication_info_match_address, &key);
+#else
     /* Loop all stored duplication messages in Linked list */
-    ns_list_foreach(coap_duplication_info_s, removed_duplication_info_ptr, &handle->linked_list_duplication_msgs) {
-        /* If message's Address is same than is searched */
-        if (0 == memcmp(scr_addr_ptr,
-                        removed_duplication_info_ptr->address->addr_ptr,
-                        removed_duplication_info_ptr->address->addr_len)) {
-            /* If message's Address prt is same than is searched */
-            if (removed_duplication_info_ptr->address->port == port) {
-                /* If Message ID is same than is searched */
-                if (removed_duplication_info_ptr->msg_id == msg_id) {
-                    /* * * * Correct Duplication info found, remove it from Linked list * * * */
-                    tr_info("sn_coap_protocol_linked_list_duplication_info_remove - message id %d removed", msg_id);
-                    ns_list_remove(&handle->linked_list_duplication_msgs, removed_duplication_info_ptr);
-                    --handle->count_duplication_msgs;
-
-                    /* Free memory of stored Duplication info */
-                    sn_coap_protocol_duplication_info_free(handle, removed_duplication_info_ptr);
-                    return;
-                }
-            }
+    ns_list_foreach(coap_duplication_info_s, stored_duplication_info_ptr, &handle->linked_list_duplication_msgs) {
+        if (sn_coap_protocol_duplication_info_match_address(stored_duplication_info_ptr, &key)) {
+            removed_duplication_info_ptr = stored_duplication_info_ptr;
+            break;
         }
     }
+#endif
+
+    if (removed_duplication_info_ptr) {
+        /* * * * Correct Duplication info found, remove it from Linked list * * * */
+        tr_info("sn_coap_protocol_linked_list_duplication_info_remove - message id %d removed", msg_id);
+        ns_list_remove(&handle->linked_list_duplication_msgs, removed_duplication_info_ptr);
+        SN_COAP_HASH_INDEX_REMOVE(&handle->duplication_msgs_index, removed_duplication_info_ptr);
+        --handle->count_duplication_msgs;
+
+        /* Free memory of stored Duplication info */
+        sn_coap_protocol_duplication_info_free(handle, removed_duplication_info_ptr);
+    }
 #else
     (void)handle;
     (void)scr_addr_ptr;
@@ -1225,6 +1466,7 @@ static void sn_coap_protocol_duplication_info_free(struct coap_s *handle, coap_d
 static void sn_coap_protocol_linked_list_blockwise_msg_remove(struct coap_s *handle, coap_blockwise_msg_s *removed_msg_ptr)
 {
     ns_list_remove(&handle->linked_list_blockwise_sent_msgs, removed_msg_ptr);
+    SN_COAP_HASH_INDEX_REMOVE(&handle->blockwise_sent_msgs_index, removed_msg_ptr);
 
     if (removed_msg_ptr->coap_msg_ptr) {
         handle->sn_coap_protocol_free(removed_msg_ptr->coap_msg_ptr->payload_ptr);
@@ -1367,6 +1609,7 @@ static void sn_coap_protocol_linked_list_blockwise_payload_store(struct coap_s *
 
         /* * * * Storing Payload to Linked list  * * * */
         ns_list_add_to_end(&handle->linked_list_blockwise_received_payloads, stored_blockwise_payload_ptr);
+        SN_COAP_HASH_INDEX_ADD(&handle->blockwise_received_payloads_index, stored_blockwise_payload_ptr);
     }
 
     stored_blockwise_payload_ptr->block_number = block_number;
@@ -1387,22 +1630,12 @@ static void sn_coap_protocol_linked_list_blockwise_payload_store(struct coap_s *
 
 static uint8_t *sn_coap_protocol_linked_list_blockwise_payload_search(struct coap_s *handle, const sn_nsdl_addr_s *src_addr_ptr, uint16_t *payload_length, const uint8_t *token_ptr, uint8_t token_len)
 {
-    /* Loop all stored blockwise payloads in Linked list */
-    ns_list_foreach(coap_blockwise_payload_s, stored_payload_info_ptr, &handle->linked_list_blockwise_received_payloads) {
-        /* If payload's Source address and port is same than is searched */
-        if ((0 == memcmp(src_addr_ptr->addr_ptr, stored_payload_info_ptr->addr_ptr, src_addr_ptr->addr_len)) && (stored_payload_info_ptr->port == src_addr_ptr->port)) {
-            /* Check token */
-            if (token_ptr) {
-                if (!stored_payload_info_ptr->token_ptr || (token_len != stored_payload_info_ptr->token_len) || (memcmp(stored_payload_info_ptr->token_ptr, token_ptr, token_len))) {
-                    continue;
-                }
-            } else if (stored_payload_info_ptr->token_ptr) {
-                continue;
-            }
-            /* * * Correct Payload found * * * */
-            *payload_length = stored_payload_info_ptr->payload_len;
-            return stored_payload_info_ptr->payload_ptr;
-        }
+    const coap_blockwise_payload_s *stored_payload_info_ptr = sn_coap_protocol_linked_list_blockwise_search(handle, src_addr_ptr, token_ptr, token_len);
+
+    if (stored_payload_info_ptr) {
+        /* * * Correct Payload found * * * */
+        *payload_length = stored_payload_info_ptr->payload_len;
+        return stored_payload_info_ptr->payload_ptr;
     }
 
     return NULL;
@@ -1421,23 +1654,22 @@ static uint8_t *sn_coap_protocol_linked_list_blockwise_payload_search(struct coa
  *****************************************************************************/
 static coap_blockwise_payload_s *sn_coap_protocol_linked_list_blockwise_search(struct coap_s *handle, const sn_nsdl_addr_s *src_addr_ptr, const uint8_t *token_ptr, uint8_t token_len)
 {
+    const coap_blockwise_payload_key_s key = { src_addr_ptr, token_ptr, token_len };
+
+#if SN_COAP_HASH_INDEX_SIZE
+    return sn_coap_hash_index_find(&handle->blockwise_received_payloads_index,
+                                   sn_coap_protocol_token_hash(src_addr_ptr->port, token_ptr, token_len),
+                                   sn_coap_protocol_blockwise_payload_match, &key);
+#else
     /* Loop all stored blockwise payloads in Linked list */
     ns_list_foreach(coap_blockwise_payload_s, stored_payload_info_ptr, &handle->linked_list_blockwise_received_payloads) {
-        /* If payload's Source address and port is same than is searched */
-        if ((0 == memcmp(src_addr_ptr->addr_ptr, stored_payload_info_ptr->addr_ptr, src_addr_ptr->addr_len)) && (stored_payload_info_ptr->port == src_addr_ptr->port)) {
-            /* Check token */
-            if (token_ptr) {
-                if (!stored_payload_info_ptr->token_ptr || (token_len != stored_payload_info_ptr->token_len) || (memcmp(stored_payload_info_ptr->token_ptr, token_ptr, token_len))) {
-                    continue;
-                }
-            } else if (stored_payload_info_ptr->token_ptr) {
-                continue;
-            }
+        if (sn_coap_protocol_blockwise_payload_match(stored_payload_info_ptr, &key)) {
             return stored_payload_info_ptr;
         }
     }
 
     return NULL;
+#endif
 }
 
 static bool sn_coap_protocol_linked_list_blockwise_payload_search_compare_block_number(struct coap_s *handle,
@@ -1446,22 +1678,25 @@ static bool sn_coap_protocol_linked_list_blockwise_payload_search_compare_block_
                                                                                        uint8_t token_len,
                                                                                        uint32_t block_number)
 {
+    const coap_blockwise_payload_key_s key = { src_addr_ptr, token_ptr, token_len };
+
+#if SN_COAP_HASH_INDEX_SIZE
+    const uint32_t hash = sn_coap_protocol_token_hash(src_addr_ptr->port, token_ptr, token_len);
+    coap_hash_index_cursor_s cursor = { 0, NULL };
+    const coap_blockwise_payload_s *stored_payload_info_ptr;
+
+    while ((stored_payload_info_ptr = sn_coap_hash_index_next(&handle->blockwise_received_payloads_index, hash,
+                                                              sn_coap_protocol_blockwise_payload_match, &key, &cursor))) {
+#else
     /* Loop all stored blockwise payloads in Linked list */
     ns_list_foreach(coap_blockwise_payload_s, stored_payload_info_ptr, &handle->linked_list_blockwise_received_payloads) {
-        /* If payload's Source address and port is same than is searched */
-        if ((0 == memcmp(src_addr_ptr->addr_ptr, stored_payload_info_ptr->addr_ptr, src_addr_ptr->addr_len)) && (stored_payload_info_ptr->port == src_addr_ptr->port)) {
-            /* Check token number */
-            if (token_ptr) {
-                if (!stored_payload_info_ptr->token_ptr || (token_len != stored_payload_info_ptr->token_len) || (memcmp(stored_payload_info_ptr->token_ptr, token_ptr, token_len))) {
-                    continue;
-                }
-            } else if (stored_payload_info_ptr->token_ptr) {
-                continue;
-            }
-            // Check that stored block number matches to given one
-            if (block_number == stored_payload_info_ptr->block_number) {
-                return true;
-            }
+        if (!sn_coap_protocol_blockwise_payload_match(stored_payload_info_ptr, &key)) {
+            continue;
+        }
+#endif
+        // Check that stored block number matches to given one
+        if (block_number == stored_payload_info_ptr->block_number) {
+            return true;
         }
     }
 
@@ -1481,6 +1716,7 @@ static void sn_coap_protocol_linked_list_blockwise_payload_remove(struct coap_s
                                                                   coap_blockwise_payload_s *removed_payload_ptr)
 {
     ns_list_remove(&handle->linked_list_blockwise_received_payloads, removed_payload_ptr);
+    SN_COAP_HASH_INDEX_REMOVE(&handle->blockwise_received_payloads_index, removed_payload_ptr);
     /* Free memory of stored payload */
     handle->sn_coap_protocol_free(removed_payload_ptr->addr_ptr);
     handle->sn_coap_protocol_free(removed_payload_ptr->payload_ptr);
@@ -1501,22 +1737,25 @@ static void sn_coap_protocol_linked_list_blockwise_payload_remove(struct coap_s
 
 static uint32_t sn_coap_protocol_linked_list_blockwise_payloads_get_len(struct coap_s *handle, const sn_nsdl_addr_s *src_addr_ptr, const uint8_t *token_ptr, uint8_t token_len)
 {
+    const coap_blockwise_payload_key_s key = { src_addr_ptr, token_ptr, token_len };
     uint32_t ret_whole_payload_len = 0;
+
+#if SN_COAP_HASH_INDEX_SIZE
+    const uint32_t hash = sn_coap_protocol_token_hash(src_addr_ptr->port, token_ptr, token_len);
+    coap_hash_index_cursor_s cursor = { 0, NULL };
+    const coap_blockwise_payload_s *searched_payload_info_ptr;
+
+    while ((searched_payload_info_ptr = sn_coap_hash_index_next(&handle->blockwise_received_payloads_index, hash,
+                                                                sn_coap_protocol_blockwise_payload_match, &key, &cursor))) {
+#else
     /* Loop all stored blockwise payloads in Linked list */
     ns_list_foreach(coap_blockwise_payload_s, searched_payload_info_ptr, &handle->linked_list_blockwise_received_payloads) {
-        /* If payload's Source address and port is same than is searched */
-        if ((0 == memcmp(src_addr_ptr->addr_ptr, searched_payload_info_ptr->addr_ptr, src_addr_ptr->addr_len)) && (searched_payload_info_ptr->port == src_addr_ptr->port)) {
-            /* Check token */
-            if (token_ptr) {
-                if (!searched_payload_info_ptr->token_ptr || (token_len != searched_payload_info_ptr->token_len) || (memcmp(searched_payload_info_ptr->token_ptr, token_ptr, token_len))) {
-                    continue;
-                }
-            } else if (searched_payload_info_ptr->token_ptr) {
-                continue;
-            }
-            /* * * Correct Payload found * * * */
-            ret_whole_payload_len += searched_payload_info_ptr->payload_len;
+        if (!sn_coap_protocol_blockwise_payload_match(searched_payload_info_ptr, &key)) {
+            continue;
         }
+#endif
+        /* * * Correct Payload found * * * */
+        ret_whole_payload_len += searched_payload_info_ptr->payload_len;
     }
 
     return ret_whole_payload_len;
@@ -1625,13 +1864,40 @@ static uint_fast16_t sn_coap_count_linked_list_size(const coap_send_msg_list_t *
 
 static coap_blockwise_msg_s *search_sent_blockwise_message(struct coap_s *handle, uint16_t msg_id)
 {
+#if SN_COAP_HASH_INDEX_SIZE
+    return sn_coap_hash_index_find(&handle->blockwise_sent_msgs_index, sn_coap_protocol_msg_id_hash(msg_id, NULL),
+                                   sn_coap_protocol_blockwise_msg_match, &msg_id);
+#else
     ns_list_foreach(coap_blockwise_msg_s, tmp, &handle->linked_list_blockwise_sent_msgs) {
-        if (tmp->coap_msg_ptr && tmp->coap_msg_ptr->msg_id == msg_id) {
+        if (sn_coap_protocol_blockwise_msg_match(tmp, &msg_id)) {
             return tmp;
         }
     }
 
     return NULL;
+#endif
+}
+
+/**************************************************************************//**
+ * \fn static void sn_coap_protocol_blockwise_msg_set_msg_id(struct coap_s *handle, coap_blockwise_msg_s *msg_ptr, uint16_t msg_id)
+ *
+ * \brief Changes the Message ID of a stored blockwise message, which is its search key
+ *
+ * \param *msg_ptr is stored message to be changed
+ * \param msg_id is new Message ID
+ *****************************************************************************/
+
+static void sn_coap_protocol_blockwise_msg_set_msg_id(struct coap_s *handle, coap_blockwise_msg_s *msg_ptr, uint16_t msg_id)
+{
+#if SN_COAP_HASH_INDEX_SIZE
+    const uint32_t old_hash = sn_coap_protocol_blockwise_msg_key(msg_ptr);
+
+    msg_ptr->coap_msg_ptr->msg_id = msg_id;
+    sn_coap_hash_index_rekey(&handle->blockwise_sent_msgs_index, msg_ptr, old_hash);
+#else
+    (void) handle;
+    msg_ptr->coap_msg_ptr->msg_id = msg_id;
+#endif
 }
 
 void sn_coap_protocol_remove_sent_blockwise_message(struct coap_s *handle, uint16_t msg_id)
@@ -1646,6 +1912,7 @@ void sn_coap_protocol_remove_sent_blockwise_message(struct coap_s *handle, uint1
         handle->sn_coap_protocol_free(tmp->coap_msg_ptr->payload_ptr);
         sn_coap_parser_release_allocated_coap_msg_mem(handle, tmp->coap_msg_ptr);
         ns_list_remove(&handle->linked_list_blockwise_sent_msgs, tmp);
+        SN_COAP_HASH_INDEX_REMOVE(&handle->blockwise_sent_msgs_index, tmp);
         handle->sn_coap_protocol_free(tmp);
     }
 }
@@ -1717,6 +1984,7 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
     uint16_t dst_packed_data_needed_mem = 0;
     uint8_t *restrict dst_ack_packet_data_ptr = NULL;
     uint8_t block_temp = 0;
+    bool block2_follows = false;
 
     uint16_t original_payload_len = 0;
     uint8_t *original_payload_ptr = NULL;
@@ -1727,117 +1995,80 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
         if (received_coap_msg_ptr->msg_code > COAP_MSG_CODE_REQUEST_DELETE) {
 
             coap_blockwise_msg_s *stored_blockwise_msg_temp_ptr;
+            int32_t sent_block1 = COAP_OPTION_BLOCK_NONE;
             stored_blockwise_msg_temp_ptr = search_sent_blockwise_message(handle, received_coap_msg_ptr->msg_id);
 
-            if (received_coap_msg_ptr->options_list_ptr->block1 & 0x08) {
-                received_coap_msg_ptr->coap_status = COAP_STATUS_PARSER_BLOCKWISE_ACK;
+            if (stored_blockwise_msg_temp_ptr && stored_blockwise_msg_temp_ptr->coap_msg_ptr &&
+                    stored_blockwise_msg_temp_ptr->coap_msg_ptr->options_list_ptr) {
+                sent_block1 = stored_blockwise_msg_temp_ptr->coap_msg_ptr->options_list_ptr->block1;
+            }
 
-                if (stored_blockwise_msg_temp_ptr) {
-                    /* Build response message */
+            /* Only a stored request with Block1 is an upload in progress, other requests are stored without payload */
+            if (sent_block1 == COAP_OPTION_BLOCK_NONE) {
+                stored_blockwise_msg_temp_ptr = NULL;
+            }
 
-                    uint_fast16_t block_size;
-                    uint32_t block_number;
-                    uint32_t req_block_number;
+            if (received_coap_msg_ptr->msg_code == COAP_MSG_CODE_RESPONSE_REQUEST_ENTITY_TOO_LARGE) {
+                /* Block too large for the server, start again with smaller blocks if it can be */
+                block_temp = stored_blockwise_msg_temp_ptr ?
+                             sn_coap_protocol_block1_smaller_size(received_coap_msg_ptr, sent_block1 & 0x07) : 0;
 
-                    src_coap_blockwise_ack_msg_ptr = stored_blockwise_msg_temp_ptr->coap_msg_ptr;
+                if (stored_blockwise_msg_temp_ptr && block_temp < (sent_block1 & 0x07)) {
+                    tr_info("sn_coap_handle_blockwise_message - (send block1) entity too large, block size %u", 16u << block_temp);
+                    received_coap_msg_ptr->coap_status = COAP_STATUS_PARSER_BLOCKWISE_ACK;
 
-                    /* Get block option parameters from received message */
-                    block_number = received_coap_msg_ptr->options_list_ptr->block1 >> 4;
-                    block_temp = received_coap_msg_ptr->options_list_ptr->block1 & 0x07;
-                    block_size = 16u << block_temp;
+                    if (!sn_coap_protocol_send_block1(handle, stored_blockwise_msg_temp_ptr, 0, block_temp, src_addr_ptr, param)) {
+                        return NULL;
+                    }
+                } else {
+                    /* Nothing smaller to try, the user gets the response */
+                    sn_coap_protocol_remove_sent_blockwise_message(handle, received_coap_msg_ptr->msg_id);
+                    received_coap_msg_ptr->coap_status = COAP_STATUS_OK;
+                }
+            } else if (received_coap_msg_ptr->options_list_ptr->block1 & 0x08) {
+                received_coap_msg_ptr->coap_status = COAP_STATUS_PARSER_BLOCKWISE_ACK;
 
-                    if (src_coap_blockwise_ack_msg_ptr->options_list_ptr) {
-                        req_block_number =  src_coap_blockwise_ack_msg_ptr->options_list_ptr->block1 >> 4;
-                        src_coap_blockwise_ack_msg_ptr->options_list_ptr->block1 = COAP_OPTION_BLOCK_NONE;
-                        // Do not clear block2 as it might have been set in the original request to request
-                        // specific size blocks
-                    } else {
-                        if (!sn_coap_parser_alloc_options(handle, src_coap_blockwise_ack_msg_ptr)) {
-                            tr_error("sn_coap_handle_blockwise_message - (send block1) failed to allocate ack message!");
-                            return 0;
-                        }
+                if (stored_blockwise_msg_temp_ptr) {
+                    /* Get block option parameters from received message */
+                    uint32_t block_number = received_coap_msg_ptr->options_list_ptr->block1 >> 4;
+                    const uint32_t req_block_number = sent_block1 >> 4;
+                    const uint8_t sent_block_temp = sent_block1 & 0x07;
 
-                        // pass through to send a next request
-                        req_block_number = block_number;
-                    }
+                    block_temp = received_coap_msg_ptr->options_list_ptr->block1 & 0x07;
 
                     // Make sure that block number is the one we requested. If it's the old one just ignore it and wait for next response.
                     if (req_block_number == block_number) {
-
-                        /* Build next block message */
+                        /* Next block, counted in the size the server asks for. It may only be smaller
+                           than the one sent (late negotiation, RFC 7959 2.5) */
                         block_number++;
-                        src_coap_blockwise_ack_msg_ptr->options_list_ptr->block1 = (block_number << 4) | block_temp;
-
-                        original_payload_len = stored_blockwise_msg_temp_ptr->coap_msg_ptr->payload_len;
-                        original_payload_ptr = stored_blockwise_msg_temp_ptr->coap_msg_ptr->payload_ptr;
-
-                        if ((block_size * (block_number + 1)) > stored_blockwise_msg_temp_ptr->coap_msg_ptr->payload_len) {
-                            src_coap_blockwise_ack_msg_ptr->payload_len = stored_blockwise_msg_temp_ptr->coap_msg_ptr->payload_len - (block_size * (block_number));
-                            src_coap_blockwise_ack_msg_ptr->payload_ptr = src_coap_blockwise_ack_msg_ptr->payload_ptr + (block_size * block_number);
-                        }
-
-                        /* Not last block */
-                        else {
-                            /* set more - bit */
-                            src_coap_blockwise_ack_msg_ptr->options_list_ptr->block1 |= 0x08;
-                            src_coap_blockwise_ack_msg_ptr->payload_len = block_size;
-                            src_coap_blockwise_ack_msg_ptr->payload_ptr = src_coap_blockwise_ack_msg_ptr->payload_ptr + (block_size * block_number);
+                        if (block_temp < sent_block_temp) {
+                            block_number <<= (sent_block_temp - block_temp);
+                        } else {
+                            block_temp = sent_block_temp;
                         }
 
-                        /* Build and send block message */
-                        dst_packed_data_needed_mem = sn_coap_builder_calc_needed_packet_data_size_2(src_coap_blockwise_ack_msg_ptr, handle->sn_coap_block_data_size);
-
-                        dst_ack_packet_data_ptr = handle->sn_coap_protocol_malloc(dst_packed_data_needed_mem);
-                        if (!dst_ack_packet_data_ptr) {
-                            tr_error("sn_coap_handle_blockwise_message - (send block1) failed to allocate ack message!");
-                            handle->sn_coap_protocol_free(src_coap_blockwise_ack_msg_ptr->options_list_ptr);
-                            handle->sn_coap_protocol_free(original_payload_ptr);
-                            handle->sn_coap_protocol_free(src_coap_blockwise_ack_msg_ptr);
-                            stored_blockwise_msg_temp_ptr->coap_msg_ptr = NULL;
+                        if (!sn_coap_protocol_send_block1(handle, stored_blockwise_msg_temp_ptr, block_number, block_temp, src_addr_ptr, param)) {
                             return NULL;
                         }
-                        src_coap_blockwise_ack_msg_ptr->msg_id = get_new_message_id();
-
-                        sn_coap_builder_2(dst_ack_packet_data_ptr, src_coap_blockwise_ack_msg_ptr, handle->sn_coap_block_data_size);
-
-                        handle->sn_coap_tx_callback(dst_ack_packet_data_ptr, dst_packed_data_needed_mem, src_addr_ptr, param);
-
-#if ENABLE_RESENDINGS
-                        uint32_t resend_time = sn_coap_calculate_new_resend_time(handle->system_time, handle->sn_coap_resending_intervall, 0);
-
-                        if (src_coap_blockwise_ack_msg_ptr->msg_type == COAP_MSG_TYPE_CONFIRMABLE) {
-                            sn_coap_protocol_linked_list_send_msg_store(handle, src_addr_ptr,
-                                                                        dst_packed_data_needed_mem,
-                                                                        dst_ack_packet_data_ptr,
-                                                                        resend_time, param);
-                        }
-#endif
-
-                        handle->sn_coap_protocol_free(dst_ack_packet_data_ptr);
-                        dst_ack_packet_data_ptr = 0;
-
-                        stored_blockwise_msg_temp_ptr->coap_msg_ptr->payload_len = original_payload_len;
-                        stored_blockwise_msg_temp_ptr->coap_msg_ptr->payload_ptr = original_payload_ptr;
-
-                        // Remove original message from the list when last block has been sent.
-                        if (!((src_coap_blockwise_ack_msg_ptr->options_list_ptr->block1) & 0x08)) {
-                            sn_coap_protocol_remove_sent_blockwise_message(handle, stored_blockwise_msg_temp_ptr->coap_msg_ptr->msg_id);
-                        }
                     } else {
                         tr_warn("sn_coap_handle_blockwise_message - blocks not in order, requested: %"PRIu32" received: %"PRIu32"  --> ignore", req_block_number, block_number);
-                        src_coap_blockwise_ack_msg_ptr->options_list_ptr->block1 = (req_block_number << 4) | block_temp;
                         *keep_in_resend_queue = true;
                     }
                 }
+            } else if (stored_blockwise_msg_temp_ptr && (sent_block1 & 0x08)) {
+                // Last block received but some blocks are not yet sent. Ignore it and wait for next response.
+                tr_warn("sn_coap_handle_blockwise_message - last block received but some blocks are missing --> ignore");
+                received_coap_msg_ptr->coap_status = COAP_STATUS_PARSER_BLOCKWISE_ACK;
+                *keep_in_resend_queue = true;
             } else {
-                if (stored_blockwise_msg_temp_ptr) {
-                    // Last block received but some blocks are not yet sent. Ignore it and wait for next response.
-                    tr_warn("sn_coap_handle_blockwise_message - last block received but some blocks are missing --> ignore");
-                    received_coap_msg_ptr->coap_status = COAP_STATUS_PARSER_BLOCKWISE_ACK;
-                    *keep_in_resend_queue = true;
+                /* Response to the last block. The request stays stored if the response continues
+                   with Block2, the next blocks are requested with it */
+                received_coap_msg_ptr->coap_status = COAP_STATUS_OK;
+
+                if (received_coap_msg_ptr->options_list_ptr->block2 != COAP_OPTION_BLOCK_NONE) {
+                    block2_follows = true;
                 } else {
-                    // XXX what was this trying to free?
-                    received_coap_msg_ptr->coap_status = COAP_STATUS_OK;
+                    sn_coap_protocol_remove_sent_blockwise_message(handle, received_coap_msg_ptr->msg_id);
                 }
             }
         }
@@ -1991,7 +2222,7 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
 
     /* Block2 Option in a response (e.g., a 2.05 response for GET) */
     /* Message ID must be same than in received message */
-    else {
+    if (received_coap_msg_ptr->options_list_ptr->block1 == COAP_OPTION_BLOCK_NONE || block2_follows) {
         //This is response to request we made
         if (received_coap_msg_ptr->msg_code > COAP_MSG_CODE_REQUEST_DELETE) {
 #if SN_COAP_BLOCKWISE_INTERNAL_BLOCK_2_HANDLING_ENABLED
@@ -1999,7 +2230,7 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
                 uint32_t block_number = 0;
                 /* Store blockwise payload to Linked list */
                 //todo: add block number to stored values - just to make sure all packets are in order
-                uint16_t block_size = 1u << ((received_coap_msg_ptr->options_list_ptr->block1 & 0x07) + 4);
+                uint16_t block_size = 1u << ((received_coap_msg_ptr->options_list_ptr->block2 & 0x07) + 4);
                 sn_coap_protocol_linked_list_blockwise_payload_store(handle,
                                                                      src_addr_ptr,
                                                                      received_coap_msg_ptr->payload_len,
@@ -2037,6 +2268,13 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
                     block_number = received_coap_msg_ptr->options_list_ptr->block2 >> 4;
                     block_number ++;
 
+                    /* Ask the next blocks in our own size when the server's is larger (late negotiation) */
+                    const int8_t own_block_temp = sn_coap_convert_block_size(handle->sn_coap_block_data_size);
+                    if (own_block_temp >= 0 && block_temp > own_block_temp) {
+                        block_number <<= (block_temp - own_block_temp);
+                        block_temp = own_block_temp;
+                    }
+
                     src_coap_blockwise_ack_msg_ptr->options_list_ptr->block2 = (block_number << 4) | block_temp;
 
 
@@ -2104,17 +2342,17 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
                     stored_blockwise_msg_ptr->param = param;
                     stored_blockwise_msg_ptr->msg_id = stored_blockwise_msg_ptr->coap_msg_ptr->msg_id;
                     ns_list_add_to_end(&handle->linked_list_blockwise_sent_msgs, stored_blockwise_msg_ptr);
+                    SN_COAP_HASH_INDEX_ADD(&handle->blockwise_sent_msgs_index, stored_blockwise_msg_ptr);
 
                     /* * * Then release memory of CoAP Acknowledgement message * * */
                     handle->sn_coap_tx_callback(dst_ack_packet_data_ptr,
                                                 dst_packed_data_needed_mem, src_addr_ptr, param);
 
 #if ENABLE_RESENDINGS
-                    uint32_t resend_time = sn_coap_calculate_new_resend_time(handle->system_time, handle->sn_coap_resending_intervall, 0);
                     sn_coap_protocol_linked_list_send_msg_store(handle, src_addr_ptr,
                                                                 dst_packed_data_needed_mem,
                                                                 dst_ack_packet_data_ptr,
-                                                                resend_time, param);
+                                                                param);
 #endif
                     handle->sn_coap_protocol_free(dst_ack_packet_data_ptr);
                     dst_ack_packet_data_ptr = 0;
@@ -2169,7 +2407,7 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
                     }
                 }
 
-                src_coap_blockwise_ack_msg_ptr->msg_id = received_coap_msg_ptr->msg_id;
+                sn_coap_protocol_blockwise_msg_set_msg_id(handle, stored_blockwise_msg_temp_ptr, received_coap_msg_ptr->msg_id);
 
                 src_coap_blockwise_ack_msg_ptr->options_list_ptr->block2 = received_coap_msg_ptr->options_list_ptr->block2;
 
@@ -2250,7 +2488,7 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
 
                     if (handle->sn_coap_rx_callback) {
                         stored_blockwise_msg_temp_ptr->coap_msg_ptr->coap_status = COAP_STATUS_BUILDER_BLOCK_SENDING_DONE;
-                        stored_blockwise_msg_temp_ptr->coap_msg_ptr->msg_id = stored_blockwise_msg_temp_ptr->msg_id;
+                        sn_coap_protocol_blockwise_msg_set_msg_id(handle, stored_blockwise_msg_temp_ptr, stored_blockwise_msg_temp_ptr->msg_id);
                         handle->sn_coap_rx_callback(stored_blockwise_msg_temp_ptr->coap_msg_ptr, NULL, stored_blockwise_msg_temp_ptr->param);
                     }
 
@@ -2264,6 +2502,113 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
     return received_coap_msg_ptr;
 }
 
+/**************************************************************************//**
+ * \fn static bool sn_coap_protocol_send_block1(struct coap_s *handle, coap_blockwise_msg_s *stored_blockwise_msg_ptr, uint32_t block_number, uint8_t block_temp, sn_nsdl_addr_s *dst_addr_ptr, void *param)
+ *
+ * \brief Builds and sends one block of a stored Block1 request, with a new message ID
+ *
+ * \param *stored_blockwise_msg_ptr is the stored request, with its whole payload
+ * \param block_number is the number of the block, counted in blocks of block_temp size
+ * \param block_temp is the SZX of the block
+ *
+ * \return false if the block could not be allocated, the stored request is then released
+ *****************************************************************************/
+
+static bool sn_coap_protocol_send_block1(struct coap_s *handle, coap_blockwise_msg_s *stored_blockwise_msg_ptr,
+                                         uint32_t block_number, uint8_t block_temp,
+                                         sn_nsdl_addr_s *dst_addr_ptr, void *param)
+{
+    sn_coap_hdr_s *src_coap_blockwise_ack_msg_ptr = stored_blockwise_msg_ptr->coap_msg_ptr;
+    const uint_fast16_t block_size = 16u << block_temp;
+    const uint16_t original_payload_len = src_coap_blockwise_ack_msg_ptr->payload_len;
+    uint8_t *original_payload_ptr = src_coap_blockwise_ack_msg_ptr->payload_ptr;
+    uint16_t dst_packed_data_needed_mem;
+    uint8_t *dst_ack_packet_data_ptr;
+
+    src_coap_blockwise_ack_msg_ptr->options_list_ptr->block1 = (block_number << 4) | block_temp;
+    src_coap_blockwise_ack_msg_ptr->payload_ptr = original_payload_ptr + (block_size * block_number);
+
+    /* Last block */
+    if ((block_size * (block_number + 1)) >= original_payload_len) {
+        src_coap_blockwise_ack_msg_ptr->payload_len = original_payload_len - (block_size * block_number);
+    }
+
+    /* Not last block */
+    else {
+        /* set more - bit */
+        src_coap_blockwise_ack_msg_ptr->options_list_ptr->block1 |= 0x08;
+        src_coap_blockwise_ack_msg_ptr->payload_len = block_size;
+    }
+
+    /* Build and send block message */
+    dst_packed_data_needed_mem = sn_coap_builder_calc_needed_packet_data_size_2(src_coap_blockwise_ack_msg_ptr, handle->sn_coap_block_data_size);
+
+    dst_ack_packet_data_ptr = handle->sn_coap_protocol_malloc(dst_packed_data_needed_mem);
+    if (!dst_ack_packet_data_ptr) {
+        tr_error("sn_coap_protocol_send_block1 - failed to allocate block message!");
+        handle->sn_coap_protocol_free(src_coap_blockwise_ack_msg_ptr->options_list_ptr);
+        handle->sn_coap_protocol_free(original_payload_ptr);
+        handle->sn_coap_protocol_free(src_coap_blockwise_ack_msg_ptr);
+        stored_blockwise_msg_ptr->coap_msg_ptr = NULL;
+        return false;
+    }
+    sn_coap_protocol_blockwise_msg_set_msg_id(handle, stored_blockwise_msg_ptr, get_new_message_id());
+
+    sn_coap_builder_2(dst_ack_packet_data_ptr, src_coap_blockwise_ack_msg_ptr, handle->sn_coap_block_data_size);
+
+    handle->sn_coap_tx_callback(dst_ack_packet_data_ptr, dst_packed_data_needed_mem, dst_addr_ptr, param);
+
+#if ENABLE_RESENDINGS
+    if (src_coap_blockwise_ack_msg_ptr->msg_type == COAP_MSG_TYPE_CONFIRMABLE) {
+        sn_coap_protocol_linked_list_send_msg_store(handle, dst_addr_ptr,
+                                                    dst_packed_data_needed_mem,
+                                                    dst_ack_packet_data_ptr,
+                                                    param);
+    }
+#endif
+
+    handle->sn_coap_protocol_free(dst_ack_packet_data_ptr);
+
+    /* The request stays stored until its final response, which may continue with Block2 */
+    src_coap_blockwise_ack_msg_ptr->payload_len = original_payload_len;
+    src_coap_blockwise_ack_msg_ptr->payload_ptr = original_payload_ptr;
+
+    return true;
+}
+
+/**************************************************************************//**
+ * \fn static uint8_t sn_coap_protocol_block1_smaller_size(const sn_coap_hdr_s *received_coap_msg_ptr, uint8_t sent_block_temp)
+ *
+ * \brief Picks the block size to retry a Block1 request with after 4.13 Request Entity Too Large
+ *
+ * The smallest of the Block1 size of the response, the largest block fitting its Size1,
+ * and half the size sent.
+ *
+ * \return The SZX to retry with, sent_block_temp if there is no smaller one
+ *****************************************************************************/
+
+static uint8_t sn_coap_protocol_block1_smaller_size(const sn_coap_hdr_s *received_coap_msg_ptr, uint8_t sent_block_temp)
+{
+    uint8_t block_temp;
+
+    if (sent_block_temp == 0) {
+        return 0;
+    }
+
+    block_temp = sent_block_temp - 1;
+
+    if ((received_coap_msg_ptr->options_list_ptr->block1 & 0x07) < block_temp) {
+        block_temp = received_coap_msg_ptr->options_list_ptr->block1 & 0x07;
+    }
+
+    while (block_temp > 0 && received_coap_msg_ptr->options_list_ptr->size1 != 0 &&
+            (16u << block_temp) > received_coap_msg_ptr->options_list_ptr->size1) {
+        block_temp--;
+    }
+
+    return block_temp;
+}
+
 static bool sn_coap_handle_last_blockwise(struct coap_s *handle, const sn_nsdl_addr_s *src_addr_ptr, sn_coap_hdr_s *received_coap_msg_ptr)
 {
     uint16_t payload_len            = 0;
@@ -2512,3 +2857,134 @@ static uint16_t get_new_message_id(void)
     }
     return message_id;
 }
+
+#if ENABLE_RESENDINGS
+static bool sn_coap_protocol_send_msg_match(const void *entry, const void *key)
+{
+    const coap_send_msg_s *stored_msg_ptr = entry;
+    const coap_msg_id_key_s *key_ptr = key;
+
+    if (!stored_msg_ptr->send_msg_ptr.packet_ptr || (read_packet_msg_id(stored_msg_ptr) != key_ptr->msg_id)) {
+        return false;
+    }
+
+    /* If message's Source address and port is same than is searched */
+    return !key_ptr->addr_ptr || compare_port(key_ptr->addr_ptr, &stored_msg_ptr->send_msg_ptr.dst_addr_ptr);
+}
+#endif
+
+#if SN_COAP_DUPLICATION_MAX_MSGS_COUNT
+static bool sn_coap_protocol_duplication_info_match(const void *entry, const void *key)
+{
+    const coap_duplication_info_s *stored_duplication_info_ptr = entry;
+    const coap_msg_id_key_s *key_ptr = key;
+
+    /* If message's Message ID and Source address & port is same than is searched */
+    return (stored_duplication_info_ptr->msg_id == key_ptr->msg_id) &&
+           compare_port(key_ptr->addr_ptr, stored_duplication_info_ptr->address);
+}
+
+static bool sn_coap_protocol_duplication_info_match_address(const void *entry, const void *key)
+{
+    const coap_duplication_info_s *stored_duplication_info_ptr = entry;
+    const coap_duplication_key_s *key_ptr = key;
+
+    /* If message's Address, Address port and Message ID is same than is searched */
+    return (0 == memcmp(key_ptr->addr_ptr,
+                        stored_duplication_info_ptr->address->addr_ptr,
+                        stored_duplication_info_ptr->address->addr_len)) &&
+           (stored_duplication_info_ptr->address->port == key_ptr->port) &&
+           (stored_duplication_info_ptr->msg_id == key_ptr->msg_id);
+}
+#endif
+
+#if SN_COAP_BLOCKWISE_ENABLED || SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE
+static bool sn_coap_protocol_blockwise_msg_match(const void *entry, const void *key)
+{
+    const coap_blockwise_msg_s *stored_msg_ptr = entry;
+
+    return stored_msg_ptr->coap_msg_ptr && (stored_msg_ptr->coap_msg_ptr->msg_id == *(const uint16_t *)key);
+}
+
+static bool sn_coap_protocol_blockwise_payload_match(const void *entry, const void *key)
+{
+    const coap_blockwise_payload_s *stored_payload_info_ptr = entry;
+    const coap_blockwise_payload_key_s *key_ptr = key;
+
+    /* If payload's Source address and port is same than is searched */
+    if ((0 != memcmp(key_ptr->addr_ptr->addr_ptr, stored_payload_info_ptr->addr_ptr, key_ptr->addr_ptr->addr_len)) ||
+            (stored_payload_info_ptr->port != key_ptr->addr_ptr->port)) {
+        return false;
+    }
+
+    /* Check token */
+    if (key_ptr->token_ptr) {
+        return stored_payload_info_ptr->token_ptr && (key_ptr->token_len == stored_payload_info_ptr->token_len) &&
+               !memcmp(stored_payload_info_ptr->token_ptr, key_ptr->token_ptr, key_ptr->token_len);
+    }
+
+    return !stored_payload_info_ptr->token_ptr;
+}
+#endif
+
+#if SN_COAP_HASH_INDEX_SIZE
+/*
+ * Index keys only cover the fields every search of a list compares exactly:
+ * addresses are compared with the length of one side and the re-sending and
+ * duplication searches only compare ports, so addresses are left out.
+ */
+static uint32_t sn_coap_protocol_msg_id_hash(uint16_t msg_id, const uint16_t *port_ptr)
+{
+    uint8_t key[4];
+
+    key[0] = (uint8_t)(msg_id >> 8);
+    key[1] = (uint8_t)msg_id;
+    if (port_ptr) {
+        key[2] = (uint8_t)(*port_ptr >> 8);
+        key[3] = (uint8_t)*port_ptr;
+    }
+
+    return sn_coap_hash_index_hash(SN_COAP_HASH_INDEX_SEED, key, port_ptr ? 4 : 2);
+}
+
+#if ENABLE_RESENDINGS
+static uint32_t sn_coap_protocol_send_msg_key(const void *entry)
+{
+    return sn_coap_protocol_msg_id_hash(read_packet_msg_id(entry), NULL);
+}
+#endif
+
+#if SN_COAP_DUPLICATION_MAX_MSGS_COUNT
+static uint32_t sn_coap_protocol_duplication_info_key(const void *entry)
+{
+    const coap_duplication_info_s *stored_duplication_info_ptr = entry;
+
+    return sn_coap_protocol_msg_id_hash(stored_duplication_info_ptr->msg_id, &stored_duplication_info_ptr->address->port);
+}
+#endif
+
+#if SN_COAP_BLOCKWISE_ENABLED || SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE
+static uint32_t sn_coap_protocol_token_hash(uint16_t port, const uint8_t *token_ptr, uint8_t token_len)
+{
+    const uint8_t key[2] = { (uint8_t)(port >> 8), (uint8_t)port };
+    const uint32_t hash = sn_coap_hash_index_hash(SN_COAP_HASH_INDEX_SEED, key, sizeof(key));
+
+    return token_ptr ? sn_coap_hash_index_hash(hash, token_ptr, token_len) : hash;
+}
+
+static uint32_t sn_coap_protocol_blockwise_msg_key(const void *entry)
+{
+    const coap_blockwise_msg_s *stored_msg_ptr = entry;
+
+    return sn_coap_protocol_msg_id_hash(stored_msg_ptr->coap_msg_ptr ? stored_msg_ptr->coap_msg_ptr->msg_id : 0, NULL);
+}
+
+static uint32_t sn_coap_protocol_blockwise_payload_key(const void *entry)
+{
+    const coap_blockwise_payload_s *stored_payload_info_ptr = entry;
+
+    return sn_coap_protocol_token_hash(stored_payload_info_ptr->port, stored_payload_info_ptr->token_ptr,
+                                       stored_payload_info_ptr->token_len);
+}
+#endif
+#endif /* SN_COAP_HASH_INDEX_SIZE */
@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2011-2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * \file sn_coap_rto.c
+ *
+ * \brief Adaptive retransmission timeout of the CoAP protocol
+ *
+ * Functionality: CoCoA estimator (draft-ietf-core-cocoa). Two RFC 6298 style
+ * estimators are kept per destination: the strong one measures messages
+ * acknowledged without re-sending, the weak one messages acknowledged after
+ * one or two re-sendings, timed from their first transmission. Each sample
+ * moves the overall timeout towards the estimator it fed, the strong one by
+ * half and the weak one by a quarter. The backoff of a message depends on its
+ * first timeout, and an estimate left without sample for long returns towards
+ * the usual 1 - 3 s.
+ *
+ */
+
+/* * * * INCLUDE FILES * * * */
+#include <string.h> /* For memset() and memcmp() */
+
+#include "ns_types.h"
+#include "mbed-coap/sn_config.h"
+#include "sn_coap_rto.h"
+
+#if SN_COAP_ADAPTIVE_RTO
+
+#define SN_COAP_RTO_K_STRONG                4       /**< Variation multiplier of the strong estimator */
+#define SN_COAP_RTO_K_WEAK                  1       /**< Variation multiplier of the weak estimator */
+#define SN_COAP_RTO_WEAK_MAX_RESENDINGS     2       /**< Later acknowledgements are not measured */
+#define SN_COAP_RTO_SMALL                   1000    /**< Below, backoff is 3 and the estimate ages upwards */
+#define SN_COAP_RTO_LARGE                   3000    /**< Above, backoff is 1.5 and the estimate ages downwards */
+
+/* * * * LOCAL FUNCTION PROTOTYPES * * * */
+static uint32_t sn_coap_rto_estimate(uint32_t *srtt_ptr, uint32_t *rttvar_ptr, uint16_t *samples_ptr,
+                                     uint32_t rtt, uint_fast8_t k);
+
+coap_rto_peer_s *sn_coap_rto_peer_get(coap_rto_peer_s *peers, const sn_nsdl_addr_s *addr_ptr,
+                                      uint32_t initial_rto, uint32_t now)
+{
+    coap_rto_peer_s *free_ptr = NULL;
+    coap_rto_peer_s *oldest_ptr = NULL;
+    coap_rto_peer_s *peer_ptr;
+
+    if (addr_ptr->addr_ptr == NULL || addr_ptr->addr_len == 0 || addr_ptr->addr_len > SN_COAP_RTO_ADDR_MAX_LEN) {
+        return NULL;
+    }
+
+    for (peer_ptr = peers; peer_ptr < peers + SN_COAP_ADAPTIVE_RTO_PEER_COUNT; peer_ptr++) {
+        if (peer_ptr->addr_len == 0) {
+            if (free_ptr == NULL) {
+                free_ptr = peer_ptr;
+            }
+        } else if (peer_ptr->addr_len == addr_ptr->addr_len && peer_ptr->port == addr_ptr->port &&
+                   memcmp(peer_ptr->addr, addr_ptr->addr_ptr, addr_ptr->addr_len) == 0) {
+            peer_ptr->used = now;
+            return peer_ptr;
+        } else if (oldest_ptr == NULL || (int32_t)(peer_ptr->used - oldest_ptr->used) < 0) {
+            oldest_ptr = peer_ptr;
+        }
+    }
+
+    if (initial_rto == 0) {
+        return NULL;
+    }
+
+    peer_ptr = free_ptr ? free_ptr : oldest_ptr;
+    memset(peer_ptr, 0, sizeof(coap_rto_peer_s));
+    peer_ptr->rto.rto = sn_coap_rto_bound(initial_rto);
+    peer_ptr->rto.updated = now;
+    peer_ptr->used = now;
+    peer_ptr->port = addr_ptr->port;
+    peer_ptr->addr_len = addr_ptr->addr_len;
+    memcpy(peer_ptr->addr, addr_ptr->addr_ptr, addr_ptr->addr_len);
+
+    return peer_ptr;
+}
+
+uint32_t sn_coap_rto_get(sn_coap_rto_s *rto, uint32_t now)
+{
+    uint32_t idle = now - rto->updated;
+
+    /* The initial timeout is configuration, only measured ones age */
+    if (rto->strong_samples == 0 && rto->weak_samples == 0) {
+        return rto->rto;
+    }
+
+    if (rto->rto < SN_COAP_RTO_SMALL && idle > 16 * rto->rto) {
+        rto->rto = sn_coap_rto_bound(2 * rto->rto);
+        rto->updated = now;
+    } else if (rto->rto > SN_COAP_RTO_LARGE && idle > 4 * rto->rto) {
+        rto->rto = sn_coap_rto_bound(1000 + rto->rto / 2);
+        rto->updated = now;
+    }
+
+    return rto->rto;
+}
+
+void sn_coap_rto_update(sn_coap_rto_s *rto, uint32_t rtt, uint_fast8_t resendings, uint32_t now)
+{
+    uint32_t rto_new;
+
+    if (rtt > SN_COAP_ADAPTIVE_RTO_MAX) {
+        rtt = SN_COAP_ADAPTIVE_RTO_MAX;
+    }
+
+    if (resendings == 0) {
+        rto_new = sn_coap_rto_estimate(&rto->srtt_strong, &rto->rttvar_strong, &rto->strong_samples,
+                                       rtt, SN_COAP_RTO_K_STRONG);
+        rto->rto = sn_coap_rto_bound((rto->rto + rto_new) / 2);
+    } else if (resendings <= SN_COAP_RTO_WEAK_MAX_RESENDINGS) {
+        rto_new = sn_coap_rto_estimate(&rto->srtt_weak, &rto->rttvar_weak, &rto->weak_samples,
+                                       rtt, SN_COAP_RTO_K_WEAK);
+        rto->rto = sn_coap_rto_bound((3 * rto->rto + rto_new) / 4);
+    } else {
+        /* Cannot tell which transmission was acknowledged */
+        return;
+    }
+
+    rto->updated = now;
+}
+
+uint_fast8_t sn_coap_rto_backoff(uint32_t timeout)
+{
+    if (timeout < SN_COAP_RTO_SMALL) {
+        return 6;
+    }
+    if (timeout > SN_COAP_RTO_LARGE) {
+        return 3;
+    }
+    return 4;
+}
+
+uint32_t sn_coap_rto_bound(uint32_t timeout)
+{
+    if (timeout < SN_COAP_ADAPTIVE_RTO_MIN) {
+        return SN_COAP_ADAPTIVE_RTO_MIN;
+    }
+    if (timeout > SN_COAP_ADAPTIVE_RTO_MAX) {
+        return SN_COAP_ADAPTIVE_RTO_MAX;
+    }
+    return timeout;
+}
+
+/**************************************************************************//**
+ * \fn static uint32_t sn_coap_rto_estimate(uint32_t *srtt_ptr, uint32_t *rttvar_ptr, uint16_t *samples_ptr, uint32_t rtt, uint_fast8_t k)
+ *
+ * \brief Adds a sample to one estimator, as in RFC 6298 with a 1 ms clock granularity
+ *
+ * \return Timeout given by this estimator alone
+ *****************************************************************************/
+
+static uint32_t sn_coap_rto_estimate(uint32_t *srtt_ptr, uint32_t *rttvar_ptr, uint16_t *samples_ptr,
+                                     uint32_t rtt, uint_fast8_t k)
+{
+    uint32_t variation;
+
+    if (*samples_ptr == 0) {
+        *srtt_ptr = rtt;
+        *rttvar_ptr = rtt / 2;
+    } else {
+        uint32_t delta = (*srtt_ptr > rtt) ? (*srtt_ptr - rtt) : (rtt - *srtt_ptr);
+
+        *rttvar_ptr = (3 * *rttvar_ptr + delta) / 4;
+        *srtt_ptr = (7 * *srtt_ptr + rtt) / 8;
+    }
+
+    if (*samples_ptr < UINT16_MAX) {
+        ++*samples_ptr;
+    }
+
+    variation = k * *rttvar_ptr;
+    return *srtt_ptr + (variation > 0 ? variation : 1);
+}
+
+#endif /* SN_COAP_ADAPTIVE_RTO */
@@ -0,0 +1,590 @@
+/*******************************************************************************
+*************************keySTREAM Trusted Agent ("KTA")************************
+
+* (c) 2023-2025 Nagravision Sàrl
+
+* Subject to your compliance with these terms, you may use the Nagravision Sàrl
+* Software and any derivatives exclusively with Nagravision's products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may accompany
+* Nagravision Software.
+
+* Redistribution of this Nagravision Software in source or binary form is allowed
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+
+* THIS SOFTWARE IS SUPPLIED BY NAGRAVISION "AS IS". NO WARRANTIES, WHETHER EXPRESS,
+* IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF
+* NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE. IN NO
+* EVENT WILL NAGRAVISION BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL
+* OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF NAGRAVISION HAS BEEN ADVISED OF THE
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW,
+* NAGRAVISION 'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS
+* SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY
+* TO NAGRAVISION FOR THIS SOFTWARE.
+********************************************************************************/
+/** \brief Communication stack loopback server.
+ *
+ *  \author Kudelski IoT
+ *
+ *  \date 2026/10/17
+ *
+ *  \file comm_serve.c
+ ******************************************************************************/
+/**
+ * @brief HTTP loopback server, answering the POST requests sent by httpMsgExchange().
+ */
+
+#include "comm_if.h"
+/* -------------------------------------------------------------------------- */
+/* IMPORTS                                                                    */
+/* -------------------------------------------------------------------------- */
+#include "http.h"
+
+#include <arpa/inet.h>
+#include <ctype.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL CONSTANTS, TYPES, ENUM                                               */
+/* -------------------------------------------------------------------------- */
+/** @brief Maximal HTTP data length, same as the client. */
+#define C_COMM_SERVE_HTTP_MAX_DATA_LEN      (2560u)
+
+/** @brief Maximal number of keep-alive connections served together. */
+#define C_COMM_SERVE_HTTP_MAX_CLIENTS       (16u)
+
+/** @brief Socket polling period in ms, bounds the reaction time to commServeStop(). */
+#define C_COMM_SERVE_HTTP_POLL_PERIOD       (200)
+
+/** @brief Pending connections queue length. */
+#define C_COMM_SERVE_HTTP_BACKLOG           (16)
+
+/** @brief Room kept in front of the answer body for the answer header. */
+#define C_COMM_SERVE_HTTP_HEADER_ROOM       (128u)
+
+/** @brief Answer header, followed by the answer size. */
+#define C_COMM_SERVE_HTTP_OK_HEADER \
+  "HTTP/1.1 200 OK\r\n" \
+  "Content-Type: application/octet-stream\r\n" \
+  "Connection: Keep-Alive\r\n" \
+  "Content-Length: %u\r\n" \
+  "\r\n"
+
+/** @brief Answer sent when the handler drops the request. */
+#define C_COMM_SERVE_HTTP_ERROR_ANSWER \
+  "HTTP/1.1 500 Internal Server Error\r\n" \
+  "Content-Length: 0\r\n" \
+  "Connection: close\r\n" \
+  "\r\n"
+
+/******************************************************************************/
+/* LOCAL MACROS                                                               */
+/******************************************************************************/
+
+#ifdef DEBUG
+/** @brief Enable HTTP server logs. */
+#define M_INTL_HTTP_SERVE_ERROR(__PRINT__)   do { \
+                                                printf("HTTP SERVE %d> ERROR ", __LINE__); \
+                                                printf __PRINT__; \
+                                                printf("\r\n"); \
+                                              } while (0)
+#else
+#define M_INTL_HTTP_SERVE_ERROR(__PRINT__)
+#endif /* DEBUG. */
+
+/** @brief Keep-alive connection. */
+typedef struct
+{
+  int       socketId;
+  /* Connected socket, -1 if the slot is free. */
+  uint8_t   aRecvBuf[C_COMM_SERVE_HTTP_MAX_DATA_LEN];
+  /* Bytes received and not consumed yet. */
+  size_t    recvLen;
+  /* Number of bytes in aRecvBuf. */
+} TCommServeHttpClient;
+
+/** @brief HTTP loopback server object. */
+typedef struct
+{
+  TCommIfServeHandler   handler;
+  /* Handler answering the requests. */
+  void*                 pHandlerArg;
+  /* Handler argument. */
+  volatile uint8_t      isStopRequested;
+  /* Set by commServeStop(). */
+  TCommServeHttpClient  aClients[C_COMM_SERVE_HTTP_MAX_CLIENTS];
+  /* Keep-alive connections. */
+  uint8_t               aSendBuf[C_COMM_SERVE_HTTP_MAX_DATA_LEN];
+  /* Answer, header and body written at once as the client reads once. */
+} TCommServeHttp;
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL VARIABLES                                                            */
+/* -------------------------------------------------------------------------- */
+/** @brief HTTP loopback server object. */
+static TCommServeHttp gCommServeHttp;
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL FUNCTIONS - PROTOTYPE                                                */
+/* -------------------------------------------------------------------------- */
+/**
+ * @brief
+ *   Read from a connection and answer every complete request received.
+ *
+ * @param[in,out] xpClient
+ *   Connection to serve.
+ *
+ * @return
+ * - 0 to keep the connection open.
+ * - -1 to close it.
+ */
+static int commServeHttpClient
+(
+  TCommServeHttpClient*  xpClient
+);
+
+/**
+ * @brief
+ *   Look for a complete request in the received bytes.
+ *
+ * @param[in] xpClient
+ *   Connection holding the received bytes.
+ * @param[out] xpBodyOffset
+ *   Offset of the body in aRecvBuf.
+ * @param[out] xpBodyLen
+ *   Length of the body, from the Content-Length header.
+ *
+ * @return
+ * - 1 if a complete request is available.
+ * - 0 if more bytes are needed.
+ * - -1 if the request is not a valid POST request.
+ */
+static int commServeHttpParse
+(
+  const TCommServeHttpClient*  xpClient,
+  size_t*                      xpBodyOffset,
+  size_t*                      xpBodyLen
+);
+
+/**
+ * @brief
+ *   Write the whole buffer on a connection.
+ *
+ * @param[in] xSocketId
+ *   Connected socket.
+ * @param[in] xpData
+ *   Data to write.
+ * @param[in] xDataLen
+ *   Length of xpData.
+ *
+ * @return
+ * - 0 in case of success, -1 otherwise.
+ */
+static int commServeHttpWrite
+(
+  int             xSocketId,
+  const uint8_t*  xpData,
+  size_t          xDataLen
+);
+
+/* -------------------------------------------------------------------------- */
+/* PUBLIC VARIABLES                                                           */
+/* -------------------------------------------------------------------------- */
+
+/* -------------------------------------------------------------------------- */
+/* PUBLIC FUNCTIONS - IMPLEMENTATION                                          */
+/* -------------------------------------------------------------------------- */
+/**
+ * @brief  implement commServe
+ *
+ */
+TCommIfStatus commServe
+(
+  const uint16_t       xPort,
+  TCommIfServeHandler  xHandler,
+  void*                xpArg
+)
+{
+  TCommIfStatus       status = E_COMM_IF_STATUS_ERROR;
+  int                 listenId = -1;
+  int                 option = 1;
+  struct sockaddr_in  localAddr;
+  struct pollfd       aPollFds[C_COMM_SERVE_HTTP_MAX_CLIENTS + 1u];
+  uint32_t            aPollClients[C_COMM_SERVE_HTTP_MAX_CLIENTS];
+  nfds_t              pollCount = 0;
+  uint32_t            index = 0;
+  int                 socketId = -1;
+
+  (void)memset(&gCommServeHttp, 0, sizeof(gCommServeHttp));
+
+  for (index = 0; index < C_COMM_SERVE_HTTP_MAX_CLIENTS; index++)
+  {
+    gCommServeHttp.aClients[index].socketId = -1;
+  }
+
+  for (;;)
+  {
+    if ((0U == xPort) || (NULL == xHandler))
+    {
+      M_INTL_HTTP_SERVE_ERROR(("Invalid parameter"));
+      status = E_COMM_IF_STATUS_PARAMETER;
+      break;
+    }
+
+    gCommServeHttp.handler = xHandler;
+    gCommServeHttp.pHandlerArg = xpArg;
+    listenId = socket(AF_INET, SOCK_STREAM, 0);
+
+    if (listenId < 0)
+    {
+      M_INTL_HTTP_SERVE_ERROR(("socket failed"));
+      status = E_COMM_IF_STATUS_NETWORK;
+      break;
+    }
+
+    (void)setsockopt(listenId, SOL_SOCKET, SO_REUSEADDR, &option, sizeof(option));
+    (void)memset(&localAddr, 0, sizeof(localAddr));
+    localAddr.sin_family = AF_INET;
+    localAddr.sin_port = htons(xPort);
+    localAddr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    if ((0 != bind(listenId, (struct sockaddr*)&localAddr, sizeof(localAddr))) ||
+        (0 != listen(listenId, C_COMM_SERVE_HTTP_BACKLOG)))
+    {
+      M_INTL_HTTP_SERVE_ERROR(("bind/listen on port %u failed", xPort));
+      status = E_COMM_IF_STATUS_NETWORK;
+      break;
+    }
+
+    while (C_HTTP__FALSE == gCommServeHttp.isStopRequested)
+    {
+      aPollFds[0].fd = listenId;
+      aPollFds[0].events = POLLIN;
+      aPollFds[0].revents = 0;
+      pollCount = 1;
+
+      for (index = 0; index < C_COMM_SERVE_HTTP_MAX_CLIENTS; index++)
+      {
+        if (gCommServeHttp.aClients[index].socketId >= 0)
+        {
+          aPollClients[pollCount - 1u] = index;
+          aPollFds[pollCount].fd = gCommServeHttp.aClients[index].socketId;
+          aPollFds[pollCount].events = POLLIN;
+          aPollFds[pollCount].revents = 0;
+          pollCount++;
+        }
+      }
+
+      if (poll(aPollFds, pollCount, C_COMM_SERVE_HTTP_POLL_PERIOD) <= 0)
+      {
+        continue;
+      }
+
+      for (index = 1; index < pollCount; index++)
+      {
+        TCommServeHttpClient* pClient = &gCommServeHttp.aClients[aPollClients[index - 1u]];
+
+        if ((0 != aPollFds[index].revents) && (0 != commServeHttpClient(pClient)))
+        {
+          (void)close(pClient->socketId);
+          pClient->socketId = -1;
+          pClient->recvLen = 0;
+        }
+      }
+
+      if (0 != (aPollFds[0].revents & POLLIN))
+      {
+        socketId = accept(listenId, NULL, NULL);
+
+        for (index = 0; (socketId >= 0) && (index < C_COMM_SERVE_HTTP_MAX_CLIENTS); index++)
+        {
+          if (gCommServeHttp.aClients[index].socketId < 0)
+          {
+            gCommServeHttp.aClients[index].socketId = socketId;
+            gCommServeHttp.aClients[index].recvLen = 0;
+            socketId = -1;
+          }
+        }
+
+        if (socketId >= 0)
+        {
+          M_INTL_HTTP_SERVE_ERROR(("Too many connections"));
+          (void)close(socketId);
+        }
+      }
+    }
+
+    status = E_COMM_IF_STATUS_OK;
+    break;
+  }
+
+  for (index = 0; index < C_COMM_SERVE_HTTP_MAX_CLIENTS; index++)
+  {
+    if (gCommServeHttp.aClients[index].socketId >= 0)
+    {
+      (void)close(gCommServeHttp.aClients[index].socketId);
+      gCommServeHttp.aClients[index].socketId = -1;
+    }
+  }
+
+  if (listenId >= 0)
+  {
+    (void)close(listenId);
+  }
+
+  return status;
+}
+
+/**
+ * @brief  implement commServeStop
+ *
+ */
+TCommIfStatus commServeStop
+(
+  void
+)
+{
+  gCommServeHttp.isStopRequested = C_HTTP__TRUE;
+  return E_COMM_IF_STATUS_OK;
+}
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL FUNCTIONS - IMPLEMENTATION                                           */
+/* -------------------------------------------------------------------------- */
+/**
+ * @implements commServeHttpClient
+ *
+ */
+/**
+ * SUPPRESS: MISRA_DEV_KTA_005 : misra_c2012_rule_15.4_violation
+ * SUPPRESS: MISRA_DEV_KTA_004 : misra_c2012_rule_15.1_violation
+ * Using goto for breaking during the error and return cases.
+ **/
+static int commServeHttpClient
+(
+  TCommServeHttpClient*  xpClient
+)
+{
+  ssize_t  readLen = 0;
+  size_t   bodyOffset = 0;
+  size_t   bodyLen = 0;
+  size_t   requestLen = 0;
+  size_t   answerLen = 0;
+  int      headerLen = 0;
+  int      retVal = -1;
+
+  if (xpClient->recvLen >= sizeof(xpClient->aRecvBuf))
+  {
+    M_INTL_HTTP_SERVE_ERROR(("Request too large"));
+    goto end;
+  }
+
+  readLen = recv(xpClient->socketId,
+                 &xpClient->aRecvBuf[xpClient->recvLen],
+                 sizeof(xpClient->aRecvBuf) - xpClient->recvLen,
+                 0);
+
+  if (readLen <= 0)
+  {
+    /* Peer closed the keep-alive connection. */
+    goto end;
+  }
+
+  xpClient->recvLen += (size_t)readLen;
+
+  for (;;)
+  {
+    retVal = commServeHttpParse(xpClient, &bodyOffset, &bodyLen);
+
+    if (retVal <= 0)
+    {
+      break;
+    }
+
+    retVal = -1;
+    requestLen = bodyOffset + bodyLen;
+    answerLen = sizeof(gCommServeHttp.aSendBuf) - C_COMM_SERVE_HTTP_HEADER_ROOM;
+
+    if ((0U == bodyLen) ||
+        (E_COMM_IF_STATUS_OK != gCommServeHttp.handler(gCommServeHttp.pHandlerArg,
+                                          &xpClient->aRecvBuf[bodyOffset],
+                                          bodyLen,
+                                          &gCommServeHttp.aSendBuf[C_COMM_SERVE_HTTP_HEADER_ROOM],
+                                          &answerLen)))
+    {
+      (void)commServeHttpWrite(xpClient->socketId,
+                               (const uint8_t*)C_COMM_SERVE_HTTP_ERROR_ANSWER,
+                               strlen(C_COMM_SERVE_HTTP_ERROR_ANSWER));
+      goto end;
+    }
+
+    headerLen = snprintf((char*)gCommServeHttp.aSendBuf,
+                         C_COMM_SERVE_HTTP_HEADER_ROOM,
+                         C_COMM_SERVE_HTTP_OK_HEADER,
+                         (unsigned int)answerLen);
+
+    if ((headerLen <= 0) || ((size_t)headerLen >= C_COMM_SERVE_HTTP_HEADER_ROOM))
+    {
+      goto end;
+    }
+
+    /* The client reads the answer at once, header and body go out in one write. */
+    (void)memmove(&gCommServeHttp.aSendBuf[headerLen],
+                  &gCommServeHttp.aSendBuf[C_COMM_SERVE_HTTP_HEADER_ROOM],
+                  answerLen);
+
+    if (0 != commServeHttpWrite(xpClient->socketId,
+                                gCommServeHttp.aSendBuf,
+                                (size_t)headerLen + answerLen))
+    {
+      goto end;
+    }
+
+    /* Keep pipelined bytes, if any. */
+    xpClient->recvLen -= requestLen;
+    (void)memmove(xpClient->aRecvBuf, &xpClient->aRecvBuf[requestLen], xpClient->recvLen);
+  }
+
+end:
+  return (retVal < 0) ? -1 : 0;
+}
+
+/**
+ * @implements commServeHttpParse
+ *
+ */
+/**
+ * SUPPRESS: MISRA_DEV_KTA_005 : misra_c2012_rule_15.4_violation
+ * SUPPRESS: MISRA_DEV_KTA_004 : misra_c2012_rule_15.1_violation
+ * Using goto for breaking during the error and return cases.
+ **/
+static int commServeHttpParse
+(
+  const TCommServeHttpClient*  xpClient,
+  size_t*                      xpBodyOffset,
+  size_t*                      xpBodyLen
+)
+{
+  const char*  pLine = (const char*)xpClient->aRecvBuf;
+  const char*  pEnd = (const char*)&xpClient->aRecvBuf[xpClient->recvLen];
+  const char*  pEol = NULL;
+  size_t       index = 0;
+  size_t       contentLength = 0;
+  int          isLengthFound = 0;
+  int          retVal = 0;
+  const char   aLengthName[] = "content-length:";
+
+  if (xpClient->recvLen < 5u)
+  {
+    goto end;
+  }
+
+  if (0 != memcmp(pLine, "POST ", 5))
+  {
+    retVal = -1;
+    goto end;
+  }
+
+  for (;;)
+  {
+    pEol = NULL;
+
+    for (index = 0; &pLine[index + 1u] < pEnd; index++)
+    {
+      if (('\r' == pLine[index]) && ('\n' == pLine[index + 1u]))
+      {
+        pEol = &pLine[index];
+        break;
+      }
+    }
+
+    if (NULL == pEol)
+    {
+      /* Header not complete yet. */
+      goto end;
+    }
+
+    if (pEol == pLine)
+    {
+      /* Empty line, end of header. */
+      break;
+    }
+
+    if ((size_t)(pEol - pLine) > (sizeof(aLengthName) - 1u))
+    {
+      for (index = 0; index < (sizeof(aLengthName) - 1u); index++)
+      {
+        if (tolower((unsigned char)pLine[index]) != aLengthName[index])
+        {
+          break;
+        }
+      }
+
+      if ((sizeof(aLengthName) - 1u) == index)
+      {
+        contentLength = strtoul(&pLine[index], NULL, 10);
+        isLengthFound = 1;
+      }
+    }
+
+    pLine = &pEol[2];
+  }
+
+  if ((0 == isLengthFound) || (contentLength > sizeof(xpClient->aRecvBuf)))
+  {
+    retVal = -1;
+    goto end;
+  }
+
+  *xpBodyOffset = (size_t)(&pLine[2] - (const char*)xpClient->aRecvBuf);
+  *xpBodyLen = contentLength;
+
+  if ((*xpBodyOffset + contentLength) <= xpClient->recvLen)
+  {
+    retVal = 1;
+  }
+
+end:
+  return retVal;
+}
+
+/**
+ * @implements commServeHttpWrite
+ *
+ */
+static int commServeHttpWrite
+(
+  int             xSocketId,
+  const uint8_t*  xpData,
+  size_t          xDataLen
+)
+{
+  ssize_t  written = 0;
+  size_t   offset = 0;
+
+  while (offset < xDataLen)
+  {
+    written = send(xSocketId, &xpData[offset], xDataLen - offset, MSG_NOSIGNAL);
+
+    if (written <= 0)
+    {
+      return -1;
+    }
+
+    offset += (size_t)written;
+  }
+
+  return 0;
+}
+
+/* -------------------------------------------------------------------------- */
+/* END OF FILE                                                                */
+/* -------------------------------------------------------------------------- */
@@ -144,18 +144,87 @@ static int httpHeader
 
 /**
  * @brief
- *   This API fetches the HTTP body and status code.
+ *   Accumulate the bytes of a response line, up to its end.
+ *
+ * @param[in,out] xpHttpInfo
+ *   Structure with HTTP information, the line is kept in aLine.
+ * @param[in] xpData
+ *   Received bytes.
+ * @param[in] xDataLen
+ *   Number of received bytes.
+ * @param[out] xpConsumed
+ *   Number of bytes taken from xpData.
+ *
+ * @return
+ * - 1, the line is complete and '\0' terminated, without its CR LF.
+ * - 0, more bytes are needed.
+ * - -1, the line is too long.
+ */
+static int httpParseLine
+(
+  TKHttpInfo*     xpHttpInfo,
+  const uint8_t*  xpData,
+  size_t          xDataLen,
+  size_t*         xpConsumed
+);
+
+/**
+ * @brief
+ *   Take body bytes into the response buffer and account for them.
+ *
+ * @param[in,out] xpHttpInfo
+ *   Structure with HTTP information.
+ * @param[in] xpData
+ *   Received bytes. The copy is skipped when they were read in place, at the end of the
+ *   response body.
+ * @param[in] xDataLen
+ *   Number of received bytes.
+ *
+ * @return
+ *   Number of bytes taken, up to the end of the body or chunk.
+ */
+static size_t httpParseBody
+(
+  TKHttpInfo*     xpHttpInfo,
+  const uint8_t*  xpData,
+  size_t          xDataLen
+);
+
+/**
+ * @brief
+ *   Number of body bytes that can be read straight into the response buffer.
  *
  * @param[in] xpHttpInfo
  *   Structure with HTTP information.
  *
  * @return
- * - 0, in case of success.
+ *   Number of bytes, 0 if the parser does not expect body bytes or the buffer is full.
+ */
+static size_t httpBodyRoom
+(
+  const TKHttpInfo*  xpHttpInfo
+);
+
+/**
+ * @brief
+ *   Parse received response bytes, resuming where the previous call stopped.
+ *
+ * @param[in,out] xpHttpInfo
+ *   Structure with HTTP information.
+ * @param[in] xpData
+ *   Received bytes.
+ * @param[in] xDataLen
+ *   Number of received bytes.
+ *
+ * @return
+ * - 0, in case of success; xpHttpInfo->state tells whether the response is complete.
  * - -1, in case of error.
  */
 static int httpParse
 (
-  TKHttpInfo*  xpHttpInfo
+  TKHttpInfo*     xpHttpInfo,
+  const uint8_t*  xpData,
+  size_t          xDataLen
 );
 
 /**
@@ -212,6 +281,7 @@ TCommIfStatus httpInit
 {
   TKCommStatus status = E_COMM_IF_STATUS_ERROR;
   const uint8_t* pHost = NULL;
+  BOOL isHttps = C_HTTP__FALSE;
   int retVal;
 
   M_UNUSED(xIpProtocol);
@@ -224,21 +294,33 @@ TCommIfStatus httpInit
   }
   else
   {
-    retVal = strncmp((const char*)xpHost, "http://", 7);
+    retVal = strncmp((const char*)xpHost, "https://", 8);
     if (retVal == 0)
     {
-      pHost = &xpHost[7];
+      pHost = &xpHost[8];
+      isHttps = C_HTTP__TRUE;
     }
     else
     {
-      pHost = &xpHost[0];
+      retVal = strncmp((const char*)xpHost, "http://", 7);
+      if (retVal == 0)
+      {
+        pHost = &xpHost[7];
+      }
+      else
+      {
+        pHost = &xpHost[0];
+      }
     }
     (void)memset(&gHttpInfo, 0, sizeof(gHttpInfo));
     (void)strncpy((char*)gHttpInfo.url.host, (const char*)pHost, sizeof(gHttpInfo.url.host)-1UL);
     (void)snprintf((char*)gHttpInfo.url.port, sizeof(gHttpInfo.url.port), "%d", xPort);
     (void)strncpy((char*)gHttpInfo.url.path, (const char*)xpUri, sizeof(gHttpInfo.url.path)-1UL);
 
-    status = salComInit(C_HTTP_CONNECT_TIMEOUT_IN_MS,
+    /* The server authenticity is always verified over https, see C_SAL_COM_CA_FILE. */
+    status = salComInit(isHttps,
+                        isHttps,
+                        C_HTTP_CONNECT_TIMEOUT_IN_MS,
                         C_HTTP_READ_TIMEOUT_IN_MS,
                         &gHttpInfo.pTls);
     if (status == (TKCommStatus)E_COMM_IF_STATUS_OK)
@@ -311,7 +393,8 @@ TCommIfStatus httpTerm(void)
   TKCommStatus status = E_COMM_IF_STATUS_ERROR;
 
   M_INTL_HTTP_DEBUG(("Start of %s", __func__));
-  status = salComTerm(gHttpInfo.pTls);
+  /* The connection stays open for the next httpInit(), the requests ask to keep it alive. */
+  status = salComRelease(gHttpInfo.pTls);
   gHttpInfo.pTls = NULL;
   M_INTL_HTTP_DEBUG(("End of %s", __func__));
   return (TCommIfStatus)status;
@@ -521,285 +604,249 @@ end:
 }
 
 /**
- * @implements httpParse
+ * @implements httpParseLine
  *
  **/
+static int httpParseLine
+(
+  TKHttpInfo*     xpHttpInfo,
+  const uint8_t*  xpData,
+  size_t          xDataLen,
+  size_t*         xpConsumed
+)
+{
+  size_t i = 0;
+  int retVal = 0;
+
+  for (; i < xDataLen; i++)
+  {
+    if (xpData[i] == (uint8_t)'\n')
+    {
+      i++;
+      retVal = 1;
+      break;
+    }
+    if (xpHttpInfo->lineLen >= (C_HTTP__LINE_MAX_LEN - 1U))
+    {
+      M_INTL_HTTP_ERROR(("Line too long"));
+      retVal = -1;
+      break;
+    }
+    xpHttpInfo->aLine[xpHttpInfo->lineLen] = (char)xpData[i];
+    xpHttpInfo->lineLen++;
+  }
+
+  if (retVal == 1)
+  {
+    if ((xpHttpInfo->lineLen > 0U) && (xpHttpInfo->aLine[xpHttpInfo->lineLen - 1U] == '\r'))
+    {
+      xpHttpInfo->lineLen--;
+    }
+    xpHttpInfo->aLine[xpHttpInfo->lineLen] = '\0';
+    xpHttpInfo->lineLen = 0;
+  }
+
+  *xpConsumed = i;
+  return retVal;
+}
+
 /**
- * SUPPRESS: MISRA_DEV_KTA_005 : misra_c2012_rule_15.4_violation
- * SUPPRESS: MISRA_DEV_KTA_004 : misra_c2012_rule_15.1_violation
- * Using goto for breaking during the error and return cases.
+ * @implements httpParseBody
+ *
  **/
-static int httpParse
+static size_t httpParseBody
 (
-  TKHttpInfo*  xpHttpInfo
+  TKHttpInfo*     xpHttpInfo,
+  const uint8_t*  xpData,
+  size_t          xDataLen
 )
 {
-  char *pPtr1;
-  char *pPtr2;
-  long len;
-  int  retVal = -1;
-  ptrdiff_t offset = 0;
-  size_t ptrOffset;
-
-  if (xpHttpInfo->recvLen == 0U)
+  size_t len = xDataLen;
+  size_t room = (size_t)(xpHttpInfo->bodySize - xpHttpInfo->bodyLen);
+
+  if ((xpHttpInfo->state != E_HTTP__PARSE_BODY_TO_CLOSE) && (len > (size_t)xpHttpInfo->length))
   {
-    retVal = -1;
+    len = (size_t)xpHttpInfo->length;
+  }
+
+  if (len > room)
+  {
+    /* The bytes are still consumed, the connection stays usable for the next request. */
+    M_INTL_HTTP_ERROR(("Response body larger than %ld", xpHttpInfo->bodySize));
+    xpHttpInfo->bodyOverflow = C_HTTP__TRUE;
   }
   else
   {
-    pPtr1 = (char *)xpHttpInfo->pRecvBuf;
+    room = len;
+  }
+
+  if ((room > 0U) && (xpData != &xpHttpInfo->body[xpHttpInfo->bodyLen]))
+  {
+    (void)memcpy(&xpHttpInfo->body[xpHttpInfo->bodyLen], xpData, room);
+  }
+  xpHttpInfo->bodyLen += (long)room;
+
+  if (xpHttpInfo->state != E_HTTP__PARSE_BODY_TO_CLOSE)
+  {
+    xpHttpInfo->length -= (long)len;
+    if (xpHttpInfo->length == 0)
+    {
+      xpHttpInfo->state = (xpHttpInfo->state == E_HTTP__PARSE_CHUNK_DATA) ?
+                          E_HTTP__PARSE_CHUNK_END : E_HTTP__PARSE_DONE;
+    }
+  }
+
+  return len;
+}
+
+/**
+ * @implements httpBodyRoom
+ *
+ **/
+static size_t httpBodyRoom
+(
+  const TKHttpInfo*  xpHttpInfo
+)
+{
+  size_t room = 0;
+
+  if ((xpHttpInfo->state == E_HTTP__PARSE_BODY) ||
+      (xpHttpInfo->state == E_HTTP__PARSE_CHUNK_DATA) ||
+      (xpHttpInfo->state == E_HTTP__PARSE_BODY_TO_CLOSE))
+  {
+    room = (size_t)(xpHttpInfo->bodySize - xpHttpInfo->bodyLen);
+    if ((xpHttpInfo->state != E_HTTP__PARSE_BODY_TO_CLOSE) && (room > (size_t)xpHttpInfo->length))
+    {
+      room = (size_t)xpHttpInfo->length;
+    }
+  }
 
-    /* Using the variable while(C_HTTP_TRUE) instead of while(1), to resolve the misra warning
-    * Warning: 1 is not a boolean type
-    */
-    while (C_HTTP__TRUE)
+  return room;
+}
+
+/**
+ * @implements httpParse
+ *
+ **/
+static int httpParse
+(
+  TKHttpInfo*     xpHttpInfo,
+  const uint8_t*  xpData,
+  size_t          xDataLen
+)
+{
+  size_t offset = 0;
+  size_t consumed = 0;
+  int lineStatus = 0;
+  int retVal = 0;
+
+  while ((retVal == 0) && (offset < xDataLen) && (xpHttpInfo->state != E_HTTP__PARSE_DONE))
+  {
+    if ((xpHttpInfo->state == E_HTTP__PARSE_BODY) ||
+        (xpHttpInfo->state == E_HTTP__PARSE_CHUNK_DATA) ||
+        (xpHttpInfo->state == E_HTTP__PARSE_BODY_TO_CLOSE))
     {
-      if (xpHttpInfo->headerEnd == C_HTTP__FALSE)     /* Header parser. */
+      offset += httpParseBody(xpHttpInfo, &xpData[offset], xDataLen - offset);
+      continue;
+    }
+
+    lineStatus = httpParseLine(xpHttpInfo, &xpData[offset], xDataLen - offset, &consumed);
+    offset += consumed;
+    if (lineStatus < 0)
+    {
+      retVal = -1;
+      break;
+    }
+    if (lineStatus == 0)
+    {
+      break;
+    }
+
+    switch (xpHttpInfo->state)
+    {
+      case E_HTTP__PARSE_HEADER:
       {
-        pPtr2 = strstr(pPtr1, "\r\n");
-        if (pPtr2 != NULL)
+        if (xpHttpInfo->aLine[0] != '\0')
         {
-          len = (long)(pPtr2 - pPtr1);
-          *pPtr2 = '\0';
-
-          if (len > 0)
+          M_INTL_HTTP_DEBUG(("header: %s..", xpHttpInfo->aLine));
+          if (httpHeader(xpHttpInfo, xpHttpInfo->aLine) != 0)
           {
-            M_INTL_HTTP_DEBUG(("header: %s(%ld)..", pPtr1, len));
-            if (httpHeader(xpHttpInfo, pPtr1) != 0)
-            {
-              M_INTL_HTTP_ERROR(("httpHeader returned Error"));
-              retVal = -1;
-              goto end;
-            }
-            pPtr1 = &pPtr2[2];    /* Skip CR+LF. */
-          }
-          else
-          {
-
-            xpHttpInfo->headerEnd = C_HTTP__TRUE; /* Reach the header-end. */
-
-            M_INTL_HTTP_DEBUG(("header_end ...."));
-
-            pPtr1 = &pPtr2[2];    /* Skip CR+LF. */
-
-            if (xpHttpInfo->response.chunked == C_HTTP__TRUE)
-            {
-              offset = pPtr1 - (char *)xpHttpInfo->pRecvBuf;
-              len = (unsigned long)((size_t)xpHttpInfo->recvLen - (size_t)offset);
-              if (len > 0)
-              {
-                pPtr2 = strstr(pPtr1, "\r\n");
-                if (pPtr2 != NULL)
-                {
-                  *pPtr2 = '\0';
-                  errno = 0;
-                  xpHttpInfo->length = strtol(pPtr1, NULL, 16);
-                  if (0 != errno)
-                  {
-                    M_INTL_HTTP_ERROR(("Error Occured %d", errno));
-                  }
-                  if (xpHttpInfo->length == 0)
-                  {
-                      xpHttpInfo->response.chunked = C_HTTP__FALSE;
-                  }
-                  else
-                  {
-                      xpHttpInfo->response.contentLength += xpHttpInfo->length;
-                  }
-                  pPtr1 = &pPtr2[2];    /* Skip CR+LF. */
-                }
-                else
-                {
-                  /* Copy the data as chunked size. */
-                  (void)strncpy((char *)xpHttpInfo->pRecvBuf, pPtr1, (unsigned int)len);
-                  xpHttpInfo->pRecvBuf[len] = '\0';
-                  xpHttpInfo->recvLen = (size_t)len;
-                  xpHttpInfo->length = -1;
-                  retVal = 0;
-                  goto end;
-                }
-              }
-              else
-              {
-                xpHttpInfo->recvLen = 0;
-                xpHttpInfo->length = -1;
-                retVal = 0;
-                goto end;
-              }
-            }
-            else
-            {
-              xpHttpInfo->length = xpHttpInfo->response.contentLength;
-            }
+            M_INTL_HTTP_ERROR(("httpHeader returned Error"));
+            retVal = -1;
           }
         }
+        else if (xpHttpInfo->response.chunked == C_HTTP__TRUE)
+        {
+          xpHttpInfo->response.contentLength = 0;
+          xpHttpInfo->state = E_HTTP__PARSE_CHUNK_SIZE;
+        }
+        else if (xpHttpInfo->response.contentLength > 0)
+        {
+          xpHttpInfo->length = xpHttpInfo->response.contentLength;
+          xpHttpInfo->state = E_HTTP__PARSE_BODY;
+        }
+        else if (xpHttpInfo->response.contentLength == 0)
+        {
+          xpHttpInfo->state = E_HTTP__PARSE_DONE;
+        }
         else
         {
-          offset = pPtr1 - (char *)xpHttpInfo->pRecvBuf;
-          len = (unsigned long)((size_t)xpHttpInfo->recvLen - (size_t)offset);
-          if (len  > 0)
-          {
-            /* Keep the partial header data. */
-            (void)strncpy((char*)xpHttpInfo->pRecvBuf, pPtr1, (unsigned int)len);
-            xpHttpInfo->pRecvBuf[len] = '\0';
-            xpHttpInfo->recvLen = (size_t)len;
-          }
-          else
-          {
-            xpHttpInfo->recvLen = 0;
-          }
-          retVal = 0;
-          goto end;
+          /* Neither length nor chunks: the body ends with the connection. */
+          xpHttpInfo->response.close = C_HTTP__TRUE;
+          xpHttpInfo->state = E_HTTP__PARSE_BODY_TO_CLOSE;
         }
       }
-      else    /* Body parser. */
-      {
+      break;
 
-        if ((xpHttpInfo->response.chunked == C_HTTP__TRUE) && (xpHttpInfo->length == -1))
+      case E_HTTP__PARSE_CHUNK_SIZE:
+      {
+        errno = 0;
+        xpHttpInfo->length = strtol(xpHttpInfo->aLine, NULL, 16);
+        if ((0 != errno) || (xpHttpInfo->length < 0))
         {
-          offset = pPtr1 - (char *)xpHttpInfo->pRecvBuf;
-          len = (unsigned long)((size_t)xpHttpInfo->recvLen - (size_t)offset);
-          if (len > 0)
-          {
-            pPtr2 = strstr(pPtr1, "\r\n");
-            if (pPtr2 != NULL)
-            {
-              *pPtr2 = '\0';
-              errno = 0;
-              xpHttpInfo->length = strtol(pPtr1, NULL, 16);
-              if (0 != errno)
-              {
-                M_INTL_HTTP_ERROR(("Error Occured %d", errno));
-              }
-              if (xpHttpInfo->length == 0)
-              {
-                  xpHttpInfo->response.chunked = C_HTTP__FALSE;
-              }
-              else
-              {
-                  xpHttpInfo->response.contentLength += xpHttpInfo->length;
-              }
-
-              pPtr1 = &pPtr2[2];    /* Skip CR+LF */
-            }
-            else
-            {
-              /* Copy the remain data as chunked size. */
-              (void)strncpy((char*)xpHttpInfo->pRecvBuf, pPtr1, (unsigned int)len);
-              xpHttpInfo->pRecvBuf[len] = '\0';
-              xpHttpInfo->recvLen = (size_t)len;
-              xpHttpInfo->length = -1;
-              retVal = 0;
-              goto end;
-            }
-          }
-          else
-          {
-            xpHttpInfo->recvLen = 0;
-            retVal = 0;
-            goto end;
-          }
+          M_INTL_HTTP_ERROR(("Bad chunk size %s", xpHttpInfo->aLine));
+          retVal = -1;
+        }
+        else if (xpHttpInfo->length == 0)
+        {
+          xpHttpInfo->state = E_HTTP__PARSE_TRAILER;
         }
         else
         {
-            if (xpHttpInfo->length > 0)
-            {
-              offset = pPtr1 - (char *)xpHttpInfo->pRecvBuf;
-              len = (unsigned long)((size_t)xpHttpInfo->recvLen - (size_t)offset);
-
-              if (len > xpHttpInfo->length)
-              {
-                /* Copy the data for response. */
-                if (xpHttpInfo->bodyLen < xpHttpInfo->bodySize)
-                {
-                  if (xpHttpInfo->bodySize > (xpHttpInfo->bodyLen + xpHttpInfo->length))
-                  {
-                    (void)memcpy((void *)&(xpHttpInfo->body[xpHttpInfo->bodyLen]),
-                            (const void *)pPtr1,
-                            (unsigned int)xpHttpInfo->length);
-                    xpHttpInfo->bodyLen += xpHttpInfo->length;
-                  }
-                  else
-                  {
-                    (void)memcpy((void *)&(xpHttpInfo->body[xpHttpInfo->bodyLen]),
-                            (const void *)pPtr1,
-                            (unsigned int)(xpHttpInfo->bodySize - xpHttpInfo->bodyLen));
-                    xpHttpInfo->bodyLen = xpHttpInfo->bodySize;
-                  }
-                }
-
-                ptrOffset = xpHttpInfo->length;
-                pPtr1 = &pPtr1[ptrOffset];
-                len -= xpHttpInfo->length;
-
-                if ((xpHttpInfo->response.chunked == C_HTTP__TRUE) && (len >= 2))
-                {
-                  pPtr1 = &pPtr1[2];    /* Skip CR+LF. */
-                  xpHttpInfo->length = -1;
-                }
-                else
-                {
-                  retVal = -1;
-                  goto end;
-                }
-              }
-              else
-              {
-                /* Copy the data for response. */
-                if (xpHttpInfo->bodyLen < xpHttpInfo->bodySize)
-                {
-                  if (xpHttpInfo->bodySize > (xpHttpInfo->bodyLen + len))
-                  {
-                    (void)memcpy((void *)&(xpHttpInfo->body[xpHttpInfo->bodyLen]), (const void *)pPtr1, (unsigned int)len);
-                    xpHttpInfo->bodyLen += len;
-                  }
-                  else
-                  {
-                    (void)memcpy((void *)&(xpHttpInfo->body[xpHttpInfo->bodyLen]),
-                              (const void *)pPtr1,
-                              (unsigned int)(xpHttpInfo->bodySize - xpHttpInfo->bodyLen));
-                    xpHttpInfo->bodyLen = xpHttpInfo->bodySize;
-                  }
-                }
-
-                xpHttpInfo->length -= len;
-                xpHttpInfo->recvLen = 0;
-
-                if ((xpHttpInfo->response.chunked == C_HTTP__FALSE) && (xpHttpInfo->length <= 0))
-                {
-                  retVal = 1;
-                  goto end;
-                }
-                retVal = 0;
-                goto end;
-              }
-            }
-            else
-            {
-              if (xpHttpInfo->response.chunked == C_HTTP__FALSE)
-              {
-                retVal = 1;
-                goto end;
-              }
-
-              /* Chunked size check. */
-              if ((xpHttpInfo->recvLen > 2u) && (strncmp(pPtr1, "\r\n", 2) == 0))
-              {
-                pPtr1 = &pPtr1[2];
-                xpHttpInfo->length = -1;
-              }
-              else
-              {
-                xpHttpInfo->length = -1;
-                xpHttpInfo->recvLen = 0;
-              }
-            }
+          xpHttpInfo->response.contentLength += xpHttpInfo->length;
+          xpHttpInfo->state = E_HTTP__PARSE_CHUNK_DATA;
+        }
+      }
+      break;
+
+      case E_HTTP__PARSE_CHUNK_END:
+      {
+        if (xpHttpInfo->aLine[0] != '\0')
+        {
+          M_INTL_HTTP_ERROR(("Chunk data longer than its size"));
+          retVal = -1;
+        }
+        xpHttpInfo->state = E_HTTP__PARSE_CHUNK_SIZE;
+      }
+      break;
+
+      case E_HTTP__PARSE_TRAILER:
+      {
+        if (xpHttpInfo->aLine[0] == '\0')
+        {
+          xpHttpInfo->state = E_HTTP__PARSE_DONE;
         }
       }
+      break;
+
+      default:
+      {
+        retVal = -1;
+      }
+      break;
     }
-end:
-    retVal = 0;
   }
+
   return retVal;
 }
 
@@ -824,7 +871,10 @@ static int httpPost
 {
   TKCommStatus status = E_K_COMM_STATUS_ERROR;
   uint8_t aBuffer[C_HTTP_MAX_DATA_LEN] = {0};
-  unsigned int len;
+  uint8_t* pRead = NULL;
+  size_t readLen = 0;
+  TKSalComSegment aSegments[2];
+  int len;
   int retVal = -1;
 
   M_INTL_HTTP_DEBUG(("Start of %s", __func__));
@@ -835,67 +885,107 @@ static int httpPost
   }
   else
   {
-    /* Send HTTP buffer. */
-    len = (unsigned int)snprintf((char *)aBuffer, C_HTTP_MAX_DATA_LEN,
+    /* Build the HTTP header, the body is sent from the caller's buffer. */
+    len = snprintf((char *)aBuffer, C_HTTP_MAX_DATA_LEN,
                     "POST %s HTTP/1.1\r\n"
                     "Host: %s:%s\r\n"
                     "Connection: Keep-Alive\r\n"
                     "Content-Type: application/octet-stream\r\n"
-                    "Content-Length: %d\r\n"
+                    "Content-Length: %lu\r\n"
                     "Cookie: %s\r\n"
                     "\r\n",
                     (const char *)xpDir,
                     xpHttpInfo->url.host,
                     xpHttpInfo->url.port,
-                    (int)xDataLen,
+                    (unsigned long)xDataLen,
                     xpHttpInfo->request.cookie);
 
     M_INTL_HTTP_DEBUG(("Post Header len %d", len));
-    (void)memcpy(&aBuffer[len], xpData, xDataLen);
-    len = len + xDataLen;
-    if (len > C_HTTP_MAX_DATA_LEN)
+    if ((len < 0) || ((unsigned int)len >= C_HTTP_MAX_DATA_LEN))
     {
       M_INTL_HTTP_ERROR(("Buffer Overflow"));
-      (void)salComTerm(xpHttpInfo->pTls);
       retVal = -1;
       goto end;
     }
-    status = salComWrite(xpHttpInfo->pTls, aBuffer, len);
+
+    /* Reconnect if the server or an error closed the connection, else keep it. */
+    status = salComConnect(xpHttpInfo->pTls, xpHttpInfo->url.host, xpHttpInfo->url.port);
+    if (E_K_COMM_STATUS_OK != status)
+    {
+      M_INTL_HTTP_ERROR(("salComConnect Failed"));
+      retVal = -1;
+      goto end;
+    }
+
+    aSegments[0].pData = aBuffer;
+    aSegments[0].length = (size_t)len;
+    aSegments[1].pData = xpData;
+    aSegments[1].length = xDataLen;
+
+    status = salComWriteV(xpHttpInfo->pTls, aSegments, 2u);
     if (E_K_COMM_STATUS_OK != status)
     {
-      M_INTL_HTTP_ERROR(("salComWrite Failed"));
+      M_INTL_HTTP_ERROR(("salComWriteV Failed"));
       (void)salComTerm(xpHttpInfo->pTls);
       retVal = -1;
       goto end;
     }
 
     xpHttpInfo->response.status = 0;
-    xpHttpInfo->response.contentLength = 0;
+    xpHttpInfo->response.contentLength = -1;
+    xpHttpInfo->response.chunked = C_HTTP__FALSE;
     xpHttpInfo->response.close = C_HTTP__FALSE;
 
-    xpHttpInfo->recvLen = 0;
-    xpHttpInfo->headerEnd = C_HTTP__FALSE;
+    xpHttpInfo->state = E_HTTP__PARSE_HEADER;
+    xpHttpInfo->lineLen = 0;
+    xpHttpInfo->length = 0;
+    xpHttpInfo->bodyOverflow = C_HTTP__FALSE;
 
     xpHttpInfo->body = xpResponse;
     xpHttpInfo->bodySize = (long)xSize;
     xpHttpInfo->bodyLen = 0;
     xpHttpInfo->body[0] = 0;
-    xpHttpInfo->recvLen = sizeof(aBuffer);
-    xpHttpInfo->pRecvBuf = (char *)aBuffer;
 
-    status = salComRead(xpHttpInfo->pTls, aBuffer, &xpHttpInfo->recvLen);
-    if (E_K_COMM_STATUS_OK != status)
+    /* Parse the bytes as they arrive. Body bytes are read straight into the response
+     * buffer when the parser expects them, the header and chunk framing go through aBuffer. */
+    while (xpHttpInfo->state != E_HTTP__PARSE_DONE)
     {
-      M_INTL_HTTP_ERROR(("salComRead Failed"));
-      (void)salComTerm(xpHttpInfo->pTls);
-      retVal = -1;
-      goto end;
-    }
-    if (httpParse(xpHttpInfo) != 0)
-    {
-      M_INTL_HTTP_ERROR(("httpHeader returned Error"));
-      retVal = -1;
-      goto end;
+      readLen = httpBodyRoom(xpHttpInfo);
+      pRead = (readLen > 0U) ? &xpHttpInfo->body[xpHttpInfo->bodyLen] : aBuffer;
+      readLen = (readLen > 0U) ? readLen : sizeof(aBuffer);
+
+      status = salComRead(xpHttpInfo->pTls, pRead, &readLen);
+      if (E_K_COMM_STATUS_OK != status)
+      {
+        M_INTL_HTTP_ERROR(("salComRead Failed"));
+        (void)salComTerm(xpHttpInfo->pTls);
+        retVal = -1;
+        goto end;
+      }
+
+      if (readLen == 0U)
+      {
+        /* Connection closed by the server. */
+        (void)salComTerm(xpHttpInfo->pTls);
+        if (xpHttpInfo->state != E_HTTP__PARSE_BODY_TO_CLOSE)
+        {
+          M_INTL_HTTP_ERROR(("Connection closed before the end of the response"));
+          retVal = -1;
+          goto end;
+        }
+        xpHttpInfo->state = E_HTTP__PARSE_DONE;
+      }
+      else if (httpParse(xpHttpInfo, pRead, readLen) != 0)
+      {
+        M_INTL_HTTP_ERROR(("httpParse returned Error"));
+        (void)salComTerm(xpHttpInfo->pTls);
+        retVal = -1;
+        goto end;
+      }
+      else
+      {
+        /* Parsed, more bytes needed if the response is not complete. */
+      }
     }
 
     if ((int)xpHttpInfo->response.close == 1)
@@ -903,6 +993,12 @@ static int httpPost
       (void)salComTerm(xpHttpInfo->pTls);
     }
 
+    if (xpHttpInfo->bodyOverflow == C_HTTP__TRUE)
+    {
+      retVal = -1;
+      goto end;
+    }
+
     M_INTL_HTTP_DEBUG(("status  : %d", xpHttpInfo->response.status));
     M_INTL_HTTP_DEBUG(("cookie  : %s", xpHttpInfo->response.cookie));
     M_INTL_HTTP_DEBUG(("location: %s", xpHttpInfo->response.location));
@@ -96,6 +96,35 @@ typedef enum
   /* Number of supported IP protocols. */
 } TCommIfIpProtocol;
 
+/**
+ * @brief
+ *   Handler answering one message received by commServe().
+ *
+ * @param[in] xpArg
+ *   Argument given to commServe().
+ * @param[in] xpRecvMsg
+ *   Message received from the client.
+ * @param[in] xRecvSize
+ *   Size of xpRecvMsg, in bytes.
+ * @param[in,out] xpSendMsgBuffer
+ *   Buffer receiving the answer.
+ * @param[in,out] xpSendMsgBufferSize
+ *   [in] Size of xpSendMsgBuffer.
+ *   [out] Size of the answer.
+ *
+ * @return
+ * - E_COMM_IF_STATUS_OK to send the answer back.
+ * - Any other status to drop the request.
+ */
+typedef TCommIfStatus (*TCommIfServeHandler)
+(
+  void*           xpArg,
+  const uint8_t*  xpRecvMsg,
+  size_t          xRecvSize,
+  uint8_t*        xpSendMsgBuffer,
+  size_t*         xpSendMsgBufferSize
+);
+
 /* -------------------------------------------------------------------------- */
 /* VARIABLES                                                                  */
 /* -------------------------------------------------------------------------- */
@@ -168,6 +197,43 @@ TCommIfStatus commTerm
   void
 );
 
+/**
+ * @brief
+ *   Serve clients of this communication stack on the loopback interface, until commServeStop()
+ *   is called. Each message received is answered by xHandler.
+ *
+ * @param[in] xPort
+ *   Loopback port to listen on.
+ * @param[in] xHandler
+ *   Handler answering the messages.
+ *   Should not be NULL.
+ * @param[in] xpArg
+ *   Argument passed to xHandler.
+ *
+ * @return
+ * - E_COMM_IF_STATUS_OK once stopped.
+ * - E_COMM_IF_STATUS_PARAMETER for wrong input parameter(s).
+ * - E_COMM_IF_STATUS_NETWORK if the port cannot be bound.
+ */
+TCommIfStatus commServe
+(
+  const uint16_t       xPort,
+  TCommIfServeHandler  xHandler,
+  void*                xpArg
+);
+
+/**
+ * @brief
+ *   Request commServe() to return. Can be called from any thread, including the handler.
+ *
+ * @return
+ * - E_COMM_IF_STATUS_OK in case of success.
+ */
+TCommIfStatus commServeStop
+(
+  void
+);
+
 #ifdef __cplusplus
 }
 #endif /* C++ */
@@ -55,8 +55,32 @@
 /** @brief HTTP header field size. */
 #define C_HTTP__HEADER_FIELD_SIZE     (64u)
 
+/** @brief Longest response line kept by the parser: status, header or chunk size line. */
+#define C_HTTP__LINE_MAX_LEN          (512u)
+
 typedef uint8_t BOOL;
 
+/** @brief States of the HTTP response parser. */
+typedef enum
+{
+  E_HTTP__PARSE_HEADER,
+  /* Status line and header lines. */
+  E_HTTP__PARSE_BODY,
+  /* Body of known length, length bytes left. */
+  E_HTTP__PARSE_BODY_TO_CLOSE,
+  /* Body ending with the connection. */
+  E_HTTP__PARSE_CHUNK_SIZE,
+  /* Chunk size line. */
+  E_HTTP__PARSE_CHUNK_DATA,
+  /* Chunk data, length bytes left. */
+  E_HTTP__PARSE_CHUNK_END,
+  /* Line end after the chunk data. */
+  E_HTTP__PARSE_TRAILER,
+  /* Trailer lines after the last chunk. */
+  E_HTTP__PARSE_DONE
+  /* Whole response received. */
+} TKHttpParseState;
+
 /** @brief Structure to store HTTP header data. */
 typedef struct
 {
@@ -86,9 +110,10 @@ typedef struct
   TKHttpHeader  response;
   void*         pTls;
   long          length;
-  char*         pRecvBuf;
-  size_t        recvLen;
-  BOOL          headerEnd;
+  TKHttpParseState  state;
+  char          aLine[C_HTTP__LINE_MAX_LEN];
+  size_t        lineLen;
+  BOOL          bodyOverflow;
   uint8_t*      body;
   long          bodySize;
   long          bodyLen;
@@ -67,6 +67,18 @@ extern "C" {
 /* CONSTANTS, TYPES, ENUM                                                     */
 /* -------------------------------------------------------------------------- */
 
+/** @brief Maximal number of segments sent by one salComWriteV(). */
+#define C_SAL_COM_MAX_SEGMENTS  (4u)
+
+/** @brief Segment of data sent by salComWriteV(). */
+typedef struct
+{
+  const uint8_t*  pData;
+  /* Data of the segment. */
+  size_t          length;
+  /* Size of the segment, in bytes. */
+} TKSalComSegment;
+
 /* -------------------------------------------------------------------------- */
 /* VARIABLES                                                                  */
 /* -------------------------------------------------------------------------- */
@@ -81,10 +93,18 @@ extern "C" {
  *
  * @brief
  *   Initalize COM.
+ *   Com info data come from a small pool, an entry with a kept connection is taken first.
  *
  * @post
- *   Call salComTerm().
+ *   Call salComRelease().
  *
+ * @param[in] xVerify
+ *   1 to verify the server authenticity, 0 otherwise. Only used for https.
+ *   The server certificate is verified against the certificate authorities of
+ *   C_SAL_COM_CA_FILE, the connection fails if none can be loaded.
+ * @param[in] xIsHttps
+ *   1 for an https (TLS) connection, 0 for plain http.
+ *   A kept connection is only reused for the same scheme.
  * @param[in] xConnectTimeoutInMs
  *   Connection timeout in milliseconds.
  * @param[in] xReadTimeoutInMs
@@ -94,9 +114,12 @@ extern "C" {
  *
  * @return
  * - E_K_COMM_STATUS_OK or the error status.
+ * - E_K_COMM_STATUS_RESOURCE if all the com info data are in use.
  */
 K_SAL_API TKCommStatus salComInit
 (
+  uint8_t   xVerify,
+  uint8_t   xIsHttps,
   uint32_t  xConnectTimeoutInMs,
   uint32_t  xReadTimeoutInMs,
   void**    xppComInfo
@@ -108,6 +131,8 @@ K_SAL_API TKCommStatus salComInit
  *
  * @brief
  *   Establish connection with server.
+ *   A kept connection to the same server is reused if still open. A new TLS connection
+ *   resumes the last session with the server when the server accepts it.
  *
  * @param[in] xpComInfo
  *   Com Info data. Should not be NULL.
@@ -153,12 +178,41 @@ K_SAL_API TKCommStatus salComWrite
   size_t          xBufferLen
 );
 
+/**
+ * @ingroup
+ *   g_sal_com
+ *
+ * @brief
+ *   Send data segments to the server, one after the other, without gathering them in a
+ *   buffer first.
+ *
+ * @pre
+ *   salComConnect should be successfully executed prior to this function.
+ *
+ * @param[in] xpComInfo
+ *   Com info data; Should not be NULL.
+ * @param[in] xpSegments
+ *   Segments to send; must point to xSegmentCount segments.
+ * @param[in] xSegmentCount
+ *   Number of segments, from 1 to C_SAL_COM_MAX_SEGMENTS.
+ *
+ * @return
+ * - E_K_COMM_STATUS_OK or the error status.
+ */
+K_SAL_API TKCommStatus salComWriteV
+(
+  void*                   xpComInfo,
+  const TKSalComSegment*  xpSegments,
+  size_t                  xSegmentCount
+);
+
 /**
  * @ingroup
  *   g_sal_com
  *
  * @brief
  *   Receive data from the server.
+ *   Returns as soon as some data arrived, without waiting for the buffer to be filled.
  *
  * @pre
  *   salComConnect should be successfully executed prior to this function.
@@ -169,7 +223,7 @@ K_SAL_API TKCommStatus salComWrite
  *   Data buffer to fill; must point to *xpBufferLen bytes.
  * @param[in,out] xBufferLen
  *   [in] Size of the data buffer, in bytes.
- *   [out] Size of the received data, in bytes.
+ *   [out] Size of the received data, in bytes. 0 if the server closed the connection.
  *
  * @return
  * - E_K_COMM_STATUS_OK or the error status.
@@ -187,6 +241,7 @@ K_SAL_API TKCommStatus salComRead
  *
  * @brief
  *   Terminating communication.
+ *   Closes the connection, xpComInfo stays usable for salComConnect().
  *
  * @param[in] xpComInfo
  *   Com Info data. Should not be NULL.
@@ -199,6 +254,26 @@ K_SAL_API TKCommStatus salComTerm
   void*  xpComInfo
 );
 
+/**
+ * @ingroup
+ *   g_sal_com
+ *
+ * @brief
+ *   Give back com info data obtained by salComInit().
+ *   An open connection is kept, so that the next salComInit() and salComConnect() to the
+ *   same server reuse it without connecting and handshaking again.
+ *
+ * @param[in] xpComInfo
+ *   Com Info data. Should not be NULL.
+ *
+ * @return
+ * - E_K_COMM_STATUS_OK or the error status.
+ */
+K_SAL_API TKCommStatus salComRelease
+(
+  void*  xpComInfo
+);
+
 #ifdef __cplusplus
 }
 #endif /* C++ */
@@ -23,8 +23,10 @@
 /******************************************************************************/
 
 #include <errno.h>
+#include <poll.h>
 #include <signal.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <unistd.h>
 #include <string.h>
 #include <netdb.h>
@@ -38,6 +40,25 @@
 /*                                                                            */
 /******************************************************************************/
 
+/* Number of connections kept to the server. */
+#define C_SAL_COM_POOL_SIZE       (2u)
+
+/* Longest host name and port remembered for a connection, with the '\0'. */
+#define C_SAL_COM_HOST_MAX_LEN    (256u)
+#define C_SAL_COM_PORT_MAX_LEN    (8u)
+
+/* Boolean values of BOOL. */
+#define C_SAL_COM_TRUE            (1u)
+#define C_SAL_COM_FALSE           (0u)
+
+/*
+ * PEM bundle of the certificate authorities trusted to verify the server, loaded on the
+ * first verified TLS connection. Without it no https connection can be verified.
+ */
+#ifndef C_SAL_COM_CA_FILE
+#define C_SAL_COM_CA_FILE         "/etc/ssl/certs/ca-certificates.crt"
+#endif /* C_SAL_COM_CA_FILE */
+
 /******************************************************************************/
 /*                                LOCAL MACROS                                */
 /******************************************************************************/
@@ -64,6 +85,7 @@
 typedef struct
 {
     BOOL    verify;
+    BOOL    isCaLoaded;     /* cacert holds the trusted certificate authorities */
 
     mbedtls_net_context         ssl_fd;
     mbedtls_entropy_context     entropy;
@@ -79,14 +101,30 @@ typedef struct
   uint32_t  connectTimeOut;
   uint32_t  readTimeOut;
   BOOL      IsHttps;
+  BOOL      isInitialized;  /* com contexts initialized, once per pool entry */
+  BOOL      isTlsReady;     /* SSL context and configuration set up, kept between connections */
+  BOOL      isUsed;         /* Handed out by salComInit() and not released */
+  BOOL      isConnected;    /* Connection open to aHost:aPort, possibly idle in the pool */
+  char      aHost[C_SAL_COM_HOST_MAX_LEN];
+  char      aPort[C_SAL_COM_PORT_MAX_LEN];
 } TKcomInfo;
 
+typedef struct
+{
+  mbedtls_ssl_session session;
+  BOOL                isSaved;
+  char                aHost[C_SAL_COM_HOST_MAX_LEN];
+} TKcomSession;
+
 /******************************************************************************/
 /*                                                                            */
 /*                                 VARIABLES                                  */
 /*                                                                            */
 /******************************************************************************/
-static TKcomInfo gcomInfo = { 0 };
+static TKcomInfo gcomPool[C_SAL_COM_POOL_SIZE] = { 0 };
+
+/* Last TLS session with the server, resumed by the next connections. */
+static TKcomSession gcomSession = { 0 };
 
 
 
@@ -232,6 +270,145 @@ end:
     return( ret );
 }
 
+/*
+ * Save the TLS session of a connection, for the next connections to the same host
+ * to resume it instead of doing a full handshake
+ */
+static void salComSaveSession( TKcomInfo *xpcomInfo )
+{
+    int ret;
+
+    mbedtls_ssl_session_free( &gcomSession.session );
+    mbedtls_ssl_session_init( &gcomSession.session );
+    gcomSession.isSaved = C_SAL_COM_FALSE;
+
+    ret = mbedtls_ssl_get_session( &xpcomInfo->com.ssl, &gcomSession.session );
+    if( ret == 0 )
+    {
+      (void)memcpy( gcomSession.aHost, xpcomInfo->aHost, sizeof( gcomSession.aHost ) );
+      gcomSession.isSaved = C_SAL_COM_TRUE;
+    }
+    else
+    {
+      M_SAL_COM_DEBUG(("No session to save %d", ret));
+    }
+}
+
+/*
+ * Do the TLS handshake on a connected socket, resuming the saved session of the host if any.
+ * The SSL context and configuration are set up on the first connection and only reset for
+ * the next ones
+ */
+static int salComTlsHandshake( TKcomInfo *xpcomInfo, const char *xpHost )
+{
+    TKmbedtls *pTls = &xpcomInfo->com;
+    int ret = 0;
+
+    if( xpcomInfo->isTlsReady == C_SAL_COM_FALSE )
+    {
+      mbedtls_ssl_init( &pTls->ssl );
+      mbedtls_ssl_config_init( &pTls->conf );
+      mbedtls_x509_crt_init( &pTls->cacert );
+      mbedtls_ctr_drbg_init( &pTls->ctr_drbg );
+      mbedtls_entropy_init( &pTls->entropy );
+
+      ret = mbedtls_ctr_drbg_seed( &pTls->ctr_drbg, mbedtls_entropy_func, &pTls->entropy,
+                                   NULL, 0 );
+      if( ret == 0 )
+      {
+        ret = mbedtls_ssl_config_defaults( &pTls->conf,
+                                           MBEDTLS_SSL_IS_CLIENT,
+                                           MBEDTLS_SSL_TRANSPORT_STREAM,
+                                           MBEDTLS_SSL_PRESET_DEFAULT );
+      }
+      if( ret == 0 )
+      {
+        mbedtls_ssl_conf_ca_chain( &pTls->conf, &pTls->cacert, NULL );
+        mbedtls_ssl_conf_rng( &pTls->conf, mbedtls_ctr_drbg_random, &pTls->ctr_drbg );
+#if defined(MBEDTLS_SSL_SESSION_TICKETS)
+        mbedtls_ssl_conf_session_tickets( &pTls->conf, MBEDTLS_SSL_SESSION_TICKETS_ENABLED );
+#endif /* MBEDTLS_SSL_SESSION_TICKETS */
+        ret = mbedtls_ssl_setup( &pTls->ssl, &pTls->conf );
+      }
+      if( ret == 0 )
+      {
+        xpcomInfo->isTlsReady = C_SAL_COM_TRUE;
+      }
+    }
+    else
+    {
+      ret = mbedtls_ssl_session_reset( &pTls->ssl );
+    }
+
+    /* The configuration points to cacert, loading it is enough to trust its authorities. */
+    if( (ret == 0) && (pTls->verify == C_SAL_COM_TRUE) && (pTls->isCaLoaded == C_SAL_COM_FALSE) )
+    {
+      ret = mbedtls_x509_crt_parse_file( &pTls->cacert, C_SAL_COM_CA_FILE );
+      /* A positive value counts the certificates of the bundle that could not be parsed. */
+      if( (ret >= 0) && (pTls->cacert.version != 0) )
+      {
+        pTls->isCaLoaded = C_SAL_COM_TRUE;
+        ret = 0;
+      }
+      else
+      {
+        M_SAL_COM_ERROR(("No trusted certificate authority in %s: %d", C_SAL_COM_CA_FILE, ret));
+        ret = (ret < 0) ? ret : MBEDTLS_ERR_X509_FILE_IO_ERROR;
+      }
+    }
+
+    if( ret == 0 )
+    {
+      mbedtls_ssl_conf_authmode( &pTls->conf, (pTls->verify == C_SAL_COM_TRUE) ?
+                                 MBEDTLS_SSL_VERIFY_REQUIRED : MBEDTLS_SSL_VERIFY_NONE );
+      mbedtls_ssl_conf_read_timeout( &pTls->conf, xpcomInfo->readTimeOut );
+      ret = mbedtls_ssl_set_hostname( &pTls->ssl, xpHost );
+    }
+
+    if( ret == 0 )
+    {
+      mbedtls_ssl_set_bio( &pTls->ssl, &pTls->ssl_fd,
+                           mbedtls_net_send, mbedtls_net_recv, mbedtls_net_recv_timeout );
+
+      /* The server does a full handshake if it no longer knows the session. */
+      if( (gcomSession.isSaved == C_SAL_COM_TRUE) && (strcmp( gcomSession.aHost, xpHost ) == 0) )
+      {
+        if( mbedtls_ssl_set_session( &pTls->ssl, &gcomSession.session ) != 0 )
+        {
+          M_SAL_COM_DEBUG(("Session not resumable"));
+        }
+      }
+
+      do
+      {
+        ret = mbedtls_ssl_handshake( &pTls->ssl );
+      } while( (ret == MBEDTLS_ERR_SSL_WANT_READ) || (ret == MBEDTLS_ERR_SSL_WANT_WRITE) );
+    }
+
+    return( ret );
+}
+
+/*
+ * Tell if a kept connection is still usable: nothing may be pending on an idle connection,
+ * a readable socket means the server closed it or sent something unexpected
+ */
+static BOOL salComIsAlive( const TKcomInfo *xpcomInfo )
+{
+    struct pollfd pfd;
+    BOOL isAlive = C_SAL_COM_FALSE;
+
+    pfd.fd = xpcomInfo->com.ssl_fd.fd;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+
+    if( (pfd.fd >= 0) && (poll( &pfd, 1, 0 ) == 0) )
+    {
+      isAlive = C_SAL_COM_TRUE;
+    }
+
+    return( isAlive );
+}
+
 
 /******************************************************************************/
 /*                                                                            */
@@ -241,7 +418,7 @@ end:
 /**
  * @ingroup                 g_sal_com
  * @brief                   Initalize com.
- * @post                    Call salcomClose().
+ * @post                    Call salComRelease().
  * @param[in] xVerify       To verify the server authenticity
  * @param[in] xIsHttps      Set to TRUE if its https otherwise FALSE
  * @param[in] xConnectTimeoutInMs  Connection timeout in milliseconds
@@ -251,15 +428,16 @@ end:
  */
 K_SAL_API TKCommStatus salComInit
 (
-  BOOL      xVerify,
-  BOOL      xIsHttps,
+  uint8_t   xVerify,
+  uint8_t   xIsHttps,
   uint32_t  xConnectTimeoutInMs,
   uint32_t  xReadTimeoutInMs,
   void    **xppcomInfo
 )
 {
   TKCommStatus status = E_K_COMM_STATUS_ERROR;
-  TKcomInfo *pcomInfo = &gcomInfo;
+  TKcomInfo *pcomInfo = NULL;
+  size_t i;
 
   M_SAL_COM_DEBUG(("Start of %s", __func__));
   
@@ -270,14 +448,55 @@ K_SAL_API TKCommStatus salComInit
   }
   else
   {
-    memset(&pcomInfo->com, 0, sizeof(pcomInfo->com));
-    pcomInfo->connectTimeOut = xConnectTimeoutInMs;
-    pcomInfo->readTimeOut = xReadTimeoutInMs;
-    pcomInfo->IsHttps = xIsHttps;
+    /* A kept connection saves the connection and the handshake, take it first. */
+    for (i = 0; i < C_SAL_COM_POOL_SIZE; i++)
+    {
+      if ((C_SAL_COM_FALSE == gcomPool[i].isUsed) &&
+          (C_SAL_COM_TRUE == gcomPool[i].isConnected) &&
+          (xIsHttps == gcomPool[i].IsHttps))
+      {
+        pcomInfo = &gcomPool[i];
+        break;
+      }
+    }
 
-    mbedtls_net_init(&pcomInfo->com.ssl_fd);
-    *xppcomInfo = pcomInfo;
-    status = E_K_COMM_STATUS_OK;
+    for (i = 0; (NULL == pcomInfo) && (i < C_SAL_COM_POOL_SIZE); i++)
+    {
+      if (C_SAL_COM_FALSE == gcomPool[i].isUsed)
+      {
+        pcomInfo = &gcomPool[i];
+      }
+    }
+
+    if (NULL == pcomInfo)
+    {
+      K_SAL_COM_ERROR(("No free connection"));
+      status = E_K_COMM_STATUS_RESOURCE;
+    }
+    else
+    {
+      /* A connection of the other protocol is not reusable. */
+      if ((C_SAL_COM_TRUE == pcomInfo->isConnected) && (xIsHttps != pcomInfo->IsHttps))
+      {
+        salComTerm(pcomInfo);
+      }
+
+      if (C_SAL_COM_FALSE == pcomInfo->isInitialized)
+      {
+        memset(&pcomInfo->com, 0, sizeof(pcomInfo->com));
+        mbedtls_net_init(&pcomInfo->com.ssl_fd);
+        pcomInfo->isInitialized = C_SAL_COM_TRUE;
+      }
+
+      pcomInfo->com.verify = xVerify;
+      pcomInfo->connectTimeOut = xConnectTimeoutInMs;
+      pcomInfo->readTimeOut = xReadTimeoutInMs;
+      pcomInfo->IsHttps = xIsHttps;
+      pcomInfo->isUsed = C_SAL_COM_TRUE;
+
+      *xppcomInfo = pcomInfo;
+      status = E_K_COMM_STATUS_OK;
+    }
   }
 
   M_SAL_COM_DEBUG(("End of %s", __func__));
@@ -310,9 +529,26 @@ TKCommStatus salComConnect
     K_SAL_COM_ERROR(("Invalid parameter"));
     status = E_K_COMM_STATUS_PARAMETER;
   }
+  else if ((C_SAL_COM_TRUE == pcomInfo->isConnected) &&
+           (0 == strcmp(pcomInfo->aHost, (const char *)xpHost)) &&
+           (0 == strcmp(pcomInfo->aPort, (const char *)xpPort)) &&
+           (C_SAL_COM_TRUE == salComIsAlive(pcomInfo)))
+  {
+    M_SAL_COM_DEBUG(("Connection to %s:%s kept", xpHost, xpPort));
+    status = E_K_COMM_STATUS_OK;
+  }
+  else if ((strlen((const char *)xpHost) >= sizeof(pcomInfo->aHost)) ||
+           (strlen((const char *)xpPort) >= sizeof(pcomInfo->aPort)))
+  {
+    K_SAL_COM_ERROR(("Host name or port too long"));
+    status = E_K_COMM_STATUS_PARAMETER;
+  }
   else
   {
     salComTerm(pcomInfo);
+    (void)strcpy(pcomInfo->aHost, (const char *)xpHost);
+    (void)strcpy(pcomInfo->aPort, (const char *)xpPort);
+
     ret = mbedtlsNetConnectTimeout(&pcomInfo->com.ssl_fd,
                                       (const char *)xpHost,
                                       (const char *)xpPort,
@@ -325,7 +561,27 @@ TKCommStatus salComConnect
     }
     else
     {
-      status = E_K_COMM_STATUS_OK;
+      pcomInfo->isConnected = C_SAL_COM_TRUE;
+
+      if (C_SAL_COM_TRUE == pcomInfo->IsHttps)
+      {
+        ret = salComTlsHandshake(pcomInfo, (const char *)xpHost);
+      }
+
+      if( ret != 0 )
+      {
+        mbedtls_strerror(ret, err, 100);
+        K_SAL_COM_ERROR(("salComTlsHandshake failed %d %s", ret, err));
+        salComTerm(pcomInfo);
+      }
+      else
+      {
+        if (C_SAL_COM_TRUE == pcomInfo->IsHttps)
+        {
+          salComSaveSession(pcomInfo);
+        }
+        status = E_K_COMM_STATUS_OK;
+      }
     }
   }
 
@@ -366,7 +622,14 @@ TKCommStatus salcomWrite
   {
     while(1)
     {
-      ret = mbedtls_net_send(&pcomInfo->com.ssl_fd, (u_char *)&xpBuffer[slen], (size_t)(xBufferLen-slen));
+      if (C_SAL_COM_TRUE == pcomInfo->IsHttps)
+      {
+        ret = mbedtls_ssl_write(&pcomInfo->com.ssl, (u_char *)&xpBuffer[slen], (size_t)(xBufferLen-slen));
+      }
+      else
+      {
+        ret = mbedtls_net_send(&pcomInfo->com.ssl_fd, (u_char *)&xpBuffer[slen], (size_t)(xBufferLen-slen));
+      }
       if(ret == MBEDTLS_ERR_SSL_WANT_WRITE)
       {
         continue;
@@ -400,6 +663,95 @@ TKCommStatus salcomWrite
   return status;
 }
 
+/**
+ * @ingroup                   g_sal_com
+ * @brief                     Send data segments to the server, without gathering them first.
+ * @pre                       salComConnect should be successfully executed prior to this function
+ * @param[in] xpcomInfo       com Info data; Should not be NULL
+ * @param[in] xpSegments      segments to send; must point to xSegmentCount segments
+ * @param[in] xSegmentCount   number of segments, from 1 to C_SAL_COM_MAX_SEGMENTS
+ * @return                  - E_K_COMM_STATUS_OK or the error status
+ */
+TKCommStatus salComWriteV
+(
+  void                  *xpcomInfo,
+  const TKSalComSegment *xpSegments,
+  size_t                xSegmentCount
+)
+{
+  TKCommStatus status = E_K_COMM_STATUS_ERROR;
+  TKcomInfo *pcomInfo = (TKcomInfo *)xpcomInfo;
+  struct iovec aIov[C_SAL_COM_MAX_SEGMENTS];
+  size_t first = 0;
+  size_t sent = 0;
+  size_t i;
+  ssize_t ret;
+
+  M_SAL_COM_DEBUG(("Start of %s", __func__));
+
+  if ((NULL == xpcomInfo) || (NULL == xpSegments) ||
+      (0 == xSegmentCount) || (xSegmentCount > C_SAL_COM_MAX_SEGMENTS))
+  {
+    K_SAL_COM_ERROR(("Invalid parameter"));
+    status = E_K_COMM_STATUS_PARAMETER;
+  }
+  else if (C_SAL_COM_TRUE == pcomInfo->IsHttps)
+  {
+    /* TLS has no gather write: each segment goes in its own records, still without copy. */
+    status = E_K_COMM_STATUS_OK;
+    for (i = 0; (i < xSegmentCount) && (E_K_COMM_STATUS_OK == status); i++)
+    {
+      if (xpSegments[i].length > 0)
+      {
+        status = salcomWrite(pcomInfo, xpSegments[i].pData, xpSegments[i].length);
+      }
+    }
+  }
+  else
+  {
+    for (i = 0; i < xSegmentCount; i++)
+    {
+      aIov[i].iov_base = (void *)xpSegments[i].pData;
+      aIov[i].iov_len = xpSegments[i].length;
+    }
+
+    while (first < xSegmentCount)
+    {
+      ret = writev(pcomInfo->com.ssl_fd.fd, &aIov[first], (int)(xSegmentCount - first));
+      if (ret < 0)
+      {
+        if ((errno == EINTR) || (errno == EAGAIN))
+        {
+          continue;
+        }
+        K_SAL_COM_ERROR(("Write Error %d", errno));
+        break;
+      }
+
+      /* Skip the segments sent, a partial write resumes inside a segment. */
+      sent = (size_t)ret;
+      while ((first < xSegmentCount) && (sent >= aIov[first].iov_len))
+      {
+        sent -= aIov[first].iov_len;
+        first++;
+      }
+      if (first < xSegmentCount)
+      {
+        aIov[first].iov_base = (uint8_t *)aIov[first].iov_base + sent;
+        aIov[first].iov_len -= sent;
+      }
+    }
+
+    if (first == xSegmentCount)
+    {
+      status = E_K_COMM_STATUS_OK;
+    }
+  }
+
+  M_SAL_COM_DEBUG(("End of %s", __func__));
+  return status;
+}
+
 /**
  * @ingroup                 g_sal_com
  * @brief                   Receive data from the server.
@@ -407,7 +759,8 @@ TKCommStatus salcomWrite
  * @param[in] xpcomInfo     com Info data; Should not be NULL
  * @param[out] xpBuffer     data buffer to fill; must point to *xpBufferLen bytes
  * @param[in,out] xBufferLen  in:  size of the data buffer, in bytes
- *                            out: size of the received data, in bytes;
+ *                            out: size of the received data, in bytes; returns as soon as
+ *                            some data arrived, 0 if the server closed the connection
  * @return              - E_K_COMM_STATUS_OK or the error status
  */
 TKCommStatus salcomRead
@@ -434,10 +787,23 @@ TKCommStatus salcomRead
   {
     while(1)
     {
-      ret = mbedtls_net_recv_timeout( &pcomInfo->com.ssl_fd,
+      if (C_SAL_COM_TRUE == pcomInfo->IsHttps)
+      {
+        ret = mbedtls_ssl_read( &pcomInfo->com.ssl,
+                                (u_char *)xpBuffer + bytesRead,
+                                (size_t)*xpBufferLen - bytesRead);
+        if (ret == MBEDTLS_ERR_SSL_PEER_CLOSE_NOTIFY)
+        {
+          ret = 0;
+        }
+      }
+      else
+      {
+        ret = mbedtls_net_recv_timeout( &pcomInfo->com.ssl_fd,
                                         (u_char *)xpBuffer + bytesRead,
-                                        (size_t)*xpBufferLen,
+                                        (size_t)*xpBufferLen - bytesRead,
                                         pcomInfo->readTimeOut);
+      }
       if(ret == MBEDTLS_ERR_SSL_WANT_READ)
       {
         continue;
@@ -460,8 +826,10 @@ TKCommStatus salcomRead
         /* To resolve misra warning */
       }
       
+      /* Return what has arrived, the caller parses it before reading more. */
       bytesRead += ret;
       M_SAL_COM_DEBUG(("Bytes Read[%d]", bytesRead));
+      break;
     }
     *xpBufferLen = bytesRead;
   }
@@ -492,7 +860,45 @@ TKCommStatus salComTerm
   }
   else
   {
+    if ((C_SAL_COM_TRUE == pcomInfo->IsHttps) && (C_SAL_COM_TRUE == pcomInfo->isConnected))
+    {
+      /* Tickets received during the connection replace the session of the handshake. */
+      salComSaveSession(pcomInfo);
+      (void)mbedtls_ssl_close_notify(&pcomInfo->com.ssl);
+    }
     mbedtls_net_free(&pcomInfo->com.ssl_fd);
+    pcomInfo->isConnected = C_SAL_COM_FALSE;
+  }
+
+  M_SAL_COM_DEBUG(("End of %s", __func__));
+
+  return status;
+}
+
+/**
+ * @ingroup                       g_sal_com
+ * @brief                         Release com, its connection stays open for the next salComInit().
+ * @param[in] xpcomInfo           com Info data; Should not be NULL
+ * @return                      - E_K_COMM_STATUS_OK or the error status
+ */
+TKCommStatus salComRelease
+(
+  void *xpcomInfo
+)
+{
+  TKCommStatus status = E_K_COMM_STATUS_OK;
+  TKcomInfo *pcomInfo = (TKcomInfo *)xpcomInfo;
+
+  M_SAL_COM_DEBUG(("Start of %s", __func__));
+
+  if(NULL == xpcomInfo)
+  {
+    K_SAL_COM_ERROR(("Invalid parameter"));
+    status = E_K_COMM_STATUS_PARAMETER;
+  }
+  else
+  {
+    pcomInfo->isUsed = C_SAL_COM_FALSE;
   }
 
   M_SAL_COM_DEBUG(("End of %s", __func__));
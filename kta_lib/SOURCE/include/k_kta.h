@@ -112,6 +112,9 @@ typedef enum
   E_K_KTA_KS_STATUS_REFURBISH,
 } TKktaKeyStreamStatus;
 
+/** @brief Opaque keySTREAM Trusted Agent context, holds the state of one device. */
+typedef struct TKtaContext TKtaContext;
+
 /* --------------------------------------------------------------------------------------------- */
 /* VARIABLES                                                                                     */
 /* --------------------------------------------------------------------------------------------- */
@@ -445,6 +448,108 @@ TKStatus ktaKeyStreamStatus
   TKktaKeyStreamStatus*  xpKtaKSCmdStatus
 );
 
+#ifdef KEY_PAIR_POOL_FEATURE
+/**
+ * @brief
+ *   Generate key pairs ahead of time for the generate key pair commands of keySTREAM.
+ *   Call it when the device is idle, e.g. after an exchange with keySTREAM. A command
+ *   finding a pooled key pair only binds it to the requested object and produces the
+ *   attestation token.
+ *
+ * @pre
+ *   The function ktaInitialize() is called.
+ *
+ * @param[in] xMaxCount
+ *   Maximum number of key pairs generated by this call, bounds the time spent.
+ * @param[out] xpReadyCount
+ *   Number of key pairs in the pool on return, at most C_KTA_APP__KEY_PAIR_POOL_SIZE.
+ *   Should not be NULL.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_PARAMETER for wrong input parameter.
+ * - E_K_STATUS_ERROR for other errors.
+ */
+TKStatus ktaKeyPairPoolRefill
+(
+  uint32_t   xMaxCount,
+  uint32_t*  xpReadyCount
+);
+#endif /* KEY_PAIR_POOL_FEATURE */
+
+/**
+ * @brief
+ *   Allocate a new keySTREAM Trusted Agent context.
+ *   The context starts in the initial state; select it with ktaContextSelect() and
+ *   drive it through ktaInitialize(), ktaStartup(), ktaSetDeviceInformation() and
+ *   ktaExchangeMessage() as a single device would be.
+ *   The life cycle state, data and keys left in the slot by a previously released
+ *   context are erased, so the new context is onboarded as a blank device.
+ *
+ * @param[out] xppContext
+ *   Allocated context.
+ *   Should not be NULL.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_PARAMETER for wrong input parameter.
+ * - E_K_STATUS_MEMORY if all C_KTA_APP__MAX_CONTEXTS contexts are in use.
+ * - E_K_STATUS_ERROR if the data of a previous context could not be erased.
+ */
+TKStatus ktaContextCreate
+(
+  TKtaContext**  xppContext
+);
+
+/**
+ * @brief
+ *   Bind a context to the calling thread.
+ *   All keySTREAM Trusted Agent and SAL calls made afterwards from this thread operate on
+ *   this context. Threads which never select a context use the default context.
+ *
+ * @param[in] xpContext
+ *   Context returned by ktaContextCreate(), or NULL to select the default context.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_PARAMETER for wrong input parameter.
+ * - E_K_STATUS_ERROR for other errors.
+ */
+TKStatus ktaContextSelect
+(
+  TKtaContext*  xpContext
+);
+
+/**
+ * @brief
+ *   Get the context bound to the calling thread, so that helper threads can select it.
+ *
+ * @return
+ * - Context selected by the calling thread, the default context if none was selected.
+ */
+TKtaContext* ktaContextGetSelected
+(
+  void
+);
+
+/**
+ * @brief
+ *   Release a context allocated by ktaContextCreate().
+ *   The context must not be selected by any other thread.
+ *
+ * @param[in] xpContext
+ *   Context to release.
+ *   Should not be NULL.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_PARAMETER for wrong input parameter.
+ */
+TKStatus ktaContextRelease
+(
+  TKtaContext*  xpContext
+);
+
 #ifdef TEST_COVERAGE
 void ktaReset
 (
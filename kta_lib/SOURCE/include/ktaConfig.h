@@ -99,6 +99,19 @@ extern "C" {
 */
 //  #define LOG_KTA_ENABLE E_KTALOG_LEVEL_DEBUG  // <--- USER: Set your desired log level here
 
+/**
+* @brief Log levels are resolved at compile time, logs below the level cost nothing.
+*
+* A source file can override the level with C_KTALOG__MODULE_LEVEL, e.g.
+*   -DC_KTALOG__MODULE_LEVEL=E_KTALOG_LEVEL_ERROR
+*
+* Define LOG_KTA_BINARY to record logs in a RAM ring (format string address plus
+* raw arguments, no formatting) instead of printing them. The ring holds
+* C_KTALOG__RING_SIZE records; read it with ktaLog_GetRing or print it with
+* ktaLog_DumpRing.
+*/
+//#define LOG_KTA_BINARY
+
 /* -------------------------------------------------------------------------- */
 /* FOTA SERVICES                                                              */
 /* -------------------------------------------------------------------------- */
@@ -145,6 +158,150 @@ extern "C" {
  * Define this macro to enable chip certificate support.
  */
 #define DEVICE_PROVIDES_CHIP_CERT
+
+/* -------------------------------------------------------------------------- */
+/* MULTIPLE KTA CONTEXTS                                                      */
+/* -------------------------------------------------------------------------- */
+/**
+ * @brief Maximum number of keySTREAM Trusted Agent contexts.
+ * Each context holds the state of one onboarded device. Context 0 is the default
+ * context used by the legacy single device API. Set a value greater than 1 to
+ * drive several devices from one process (see ktaContextCreate), at most 32.
+ * Each context stores its data, objects and keys under its own identifiers (see
+ * salObjectSelectInstance); keySTREAM key ids must then be below 0x01000000.
+ */
+#ifndef C_KTA_APP__MAX_CONTEXTS
+#define C_KTA_APP__MAX_CONTEXTS                  (1u)
+#endif
+
+/**
+ * @brief Storage qualifier used to bind the selected context to the calling thread.
+ * Thread local storage is only used when more than one context is configured.
+ */
+#ifndef C_KTA_APP__THREAD_LOCAL
+#if (C_KTA_APP__MAX_CONTEXTS > 1u) && defined(__GNUC__)
+#define C_KTA_APP__THREAD_LOCAL                  __thread
+#else
+#define C_KTA_APP__THREAD_LOCAL
+#endif
+#endif
+
+/* -------------------------------------------------------------------------- */
+/* FLEET MANAGEMENT FEATURE                                                   */
+/* -------------------------------------------------------------------------- */
+/**
+ * @brief Enable Fleet Management Feature.
+ * Define this macro to onboard several devices concurrently with ktaFleetOnboard.
+ * Requires POSIX threads, C_KTA_APP__MAX_CONTEXTS greater than 1 and a thread safe
+ * SAL, e.g. PSA crypto built with MBEDTLS_THREADING_C and MBEDTLS_THREADING_PTHREAD.
+ */
+//#define FLEET_MANAGEMENT_FEATURE
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL SERVER FEATURE                                                       */
+/* -------------------------------------------------------------------------- */
+/**
+ * @brief Enable Local Server Feature.
+ * Define this macro to build ktaLocalServer, a loopback keySTREAM stand-in answering
+ * activation, registration and object management over the linked communication stack.
+ * Requires POSIX threads, PSA crypto and the keySTREAM secret keys matching cryptoConfig.h.
+ */
+//#define LOCAL_SERVER_FEATURE
+
+/* -------------------------------------------------------------------------- */
+/* WARM START FEATURE                                                         */
+/* -------------------------------------------------------------------------- */
+/**
+ * @brief Enable Warm Start Feature.
+ * Define this macro to keep the derived L2 keys in persistent PSA key slots and a
+ * snapshot of the decoded configuration in NVM. ktaStartup then restores both from a
+ * single storage read instead of deriving the L2 keys again on every boot.
+ * The snapshot is only used while ktaStartup gets the seed and context data it was
+ * taken with, otherwise the full startup runs and takes a new one.
+ */
+//#define WARM_START_FEATURE
+
+/* -------------------------------------------------------------------------- */
+/* PARALLEL COMMANDS FEATURE                                                  */
+/* -------------------------------------------------------------------------- */
+/**
+ * @brief Enable Parallel Commands Feature.
+ * Define this macro to run the generate key pair, set object, delete object and delete
+ * key object commands of one message concurrently when they target distinct objects.
+ * Responses keep the order of the commands.
+ * Requires POSIX threads and a thread safe SAL, e.g. PSA crypto built with
+ * MBEDTLS_THREADING_C and MBEDTLS_THREADING_PTHREAD.
+ */
+//#define PARALLEL_COMMANDS_FEATURE
+
+/**
+ * @brief Maximum number of threads running the commands of one message, the thread
+ * processing the message included. The C_KTA_APP__COMMAND_WORKERS - 1 other threads are
+ * started with the first message and kept; one message at a time uses them.
+ */
+#ifndef C_KTA_APP__COMMAND_WORKERS
+#define C_KTA_APP__COMMAND_WORKERS               (4u)
+#endif
+
+/* -------------------------------------------------------------------------- */
+/* KEY PAIR POOL FEATURE                                                      */
+/* -------------------------------------------------------------------------- */
+/**
+ * @brief Enable Key Pair Pool Feature.
+ * Define this macro to keep key pairs generated ahead of time in reserved persistent
+ * PSA key slots. The generate key pair command then binds a pooled key pair to the
+ * requested identifier and only produces the attestation token. Fill the pool when the
+ * device is idle with ktaKeyPairPoolRefill.
+ * Pooled key pairs cannot be exported; a request with export usage, or another key
+ * type, size or algorithm, is generated as before.
+ */
+//#define KEY_PAIR_POOL_FEATURE
+
+/**
+ * @brief Number of key pairs kept in the pool.
+ */
+#ifndef C_KTA_APP__KEY_PAIR_POOL_SIZE
+#define C_KTA_APP__KEY_PAIR_POOL_SIZE            (2u)
+#endif
+
+/* -------------------------------------------------------------------------- */
+/* OBJECT DIRECTORY FEATURE                                                   */
+/* -------------------------------------------------------------------------- */
+/**
+ * @brief Enable Object Directory Feature.
+ * Define this macro to keep a RAM directory of the stored objects: size and association
+ * information. ktaGetObjectWithAssociation then reads the object data straight into the
+ * caller buffer. An object enters the directory when it is set or first read, and its
+ * entry follows the set and delete commands.
+ */
+//#define OBJECT_DIRECTORY_FEATURE
+
+/**
+ * @brief Number of objects in the directory, the least recently used one is replaced.
+ */
+#ifndef C_KTA_APP__OBJECT_DIRECTORY_SIZE
+#define C_KTA_APP__OBJECT_DIRECTORY_SIZE         (8u)
+#endif
+
+/**
+ * @brief Number of objects of the directory whose content is also kept in RAM, so that
+ * getting them does not read the storage. Each costs 520 bytes, 0 disables the cache.
+ */
+#ifndef C_KTA_APP__OBJECT_CACHE_SIZE
+#define C_KTA_APP__OBJECT_CACHE_SIZE             (2u)
+#endif
+
+/* -------------------------------------------------------------------------- */
+/* BENCHMARK FEATURE                                                          */
+/* -------------------------------------------------------------------------- */
+/**
+ * @brief Enable Benchmark Feature.
+ * Define this macro to record per phase latency and CPU time of the provisioning
+ * handshake (see KTABench.h) and to build the ktaBenchmark harness.
+ * Requires POSIX threads and C_KTA_APP__MAX_CONTEXTS greater than 1.
+ */
+//#define BENCHMARK_FEATURE
+
 /* -------------------------------------------------------------------------- */
 /* VARIABLES                                                                  */
 /* -------------------------------------------------------------------------- */
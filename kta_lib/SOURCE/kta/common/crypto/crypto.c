@@ -309,6 +309,257 @@ TKStatus ktacipherRemovePadding
   return status;
 }
 
+/**
+ * @brief implement ktacipherPadEncryptAndSign
+ *
+ */
+TKStatus ktacipherPadEncryptAndSign
+(
+  uint8_t* xpMsg,
+  size_t   xHeaderLen,
+  size_t   xPayloadLen,
+  size_t   xMsgBufferSize,
+  size_t*  xpMsgLen
+)
+{
+  size_t   paddedLen = 0u;
+  TKStatus status = E_K_STATUS_ERROR;
+
+  M_KTALOG__START("Start");
+
+  if ((NULL == xpMsg) || (0u == xHeaderLen) || (0u == xPayloadLen) || (NULL == xpMsgLen))
+  {
+    status = E_K_STATUS_PARAMETER;
+    M_KTALOG__ERR("Invalid parameter passed");
+  }
+  else
+  {
+    paddedLen = M_K_CRYPTO__PADDED_LENGTH(xPayloadLen);
+
+    if ((xHeaderLen + paddedLen + C_K_KTA__HMAC_MAX_SIZE) > xMsgBufferSize)
+    {
+      M_KTALOG__ERR("Message [%d] does not fit in [%d]",
+                    (xHeaderLen + paddedLen + C_K_KTA__HMAC_MAX_SIZE), xMsgBufferSize);
+    }
+    else
+    {
+      /* The payload is already in place, only the padding bytes are written. */
+      xpMsg[xHeaderLen + xPayloadLen] = C_K_CRYPTO__PAD_START_BYTE;
+      (void)memset(&xpMsg[xHeaderLen + xPayloadLen + 1u], 0, paddedLen - xPayloadLen - 1u);
+
+      status = salCryptoAesEncHmac(C_K_KTA__VOLATILE_3_ID,
+                                   C_K_KTA__VOLATILE_2_ID,
+                                   xpMsg,
+                                   xHeaderLen,
+                                   &xpMsg[xHeaderLen],
+                                   paddedLen,
+                                   &xpMsg[xHeaderLen + paddedLen]);
+
+      if (E_K_STATUS_OK != status)
+      {
+        M_KTALOG__ERR("AES Encryption and signing failed with status : %d", status);
+      }
+      else
+      {
+        *xpMsgLen = xHeaderLen + paddedLen + C_K_KTA__HMAC_MAX_SIZE;
+      }
+    }
+  }
+
+  M_KTALOG__END("End, status : %d", status);
+  return status;
+}
+
+/**
+ * @brief implement ktacipherVerifyDecryptAndUnpad
+ *
+ */
+TKStatus ktacipherVerifyDecryptAndUnpad
+(
+  const uint8_t* xpMsg,
+  size_t         xHeaderLen,
+  size_t         xMsgLen,
+  uint8_t*       xpClearData,
+  size_t*        xpClearDataLen
+)
+{
+  size_t   macOffset = 0u;
+  TKStatus status = E_K_STATUS_ERROR;
+
+  M_KTALOG__START("Start");
+
+  if ((NULL == xpMsg) || (0u == xHeaderLen) ||
+      (xMsgLen <= (xHeaderLen + C_K_KTA__HMAC_MAX_SIZE)) ||
+      (NULL == xpClearData) || (NULL == xpClearDataLen) || (0u == *xpClearDataLen))
+  {
+    status = E_K_STATUS_PARAMETER;
+    M_KTALOG__ERR("Invalid parameter passed");
+  }
+  else
+  {
+    macOffset = xMsgLen - C_K_KTA__HMAC_MAX_SIZE;
+    status = salCryptoHmacVerifyAesDec(C_K_KTA__VOLATILE_3_ID,
+                                       C_K_KTA__VOLATILE_2_ID,
+                                       xpMsg,
+                                       xHeaderLen,
+                                       &xpMsg[xHeaderLen],
+                                       macOffset - xHeaderLen,
+                                       &xpMsg[macOffset],
+                                       xpClearData,
+                                       xpClearDataLen);
+
+    /* Only the last block is looked at, the payload is not walked again. */
+    if ((E_K_STATUS_OK == status) &&
+        (E_K_STATUS_OK != ktacipherRemovePadding(xpClearData, xpClearDataLen)))
+    {
+      status = E_K_STATUS_DECRYPTION;
+    }
+
+    if (E_K_STATUS_OK != status)
+    {
+      M_KTALOG__ERR("Verification and decryption failed with status : %d", status);
+    }
+  }
+
+  M_KTALOG__END("End, status : %d", status);
+  return status;
+}
+
+/**
+ * @brief implement ktacipherVerifyAndGetClearLength
+ *
+ */
+TKStatus ktacipherVerifyAndGetClearLength
+(
+  const uint8_t* xpMsg,
+  size_t         xHeaderLen,
+  size_t         xMsgLen,
+  uint8_t*       xpWorkBuffer,
+  size_t         xWorkBufferSize,
+  size_t*        xpClearDataLen
+)
+{
+  size_t   macOffset = 0u;
+  size_t   encryptedLen = 0u;
+  size_t   lastBlockLen = C_K_CRYPTO__AES_BLOCK_SIZE;
+  uint8_t* pLastBlock = NULL;
+  TKStatus status = E_K_STATUS_ERROR;
+
+  M_KTALOG__START("Start");
+
+  if ((NULL == xpMsg) || (0u == xHeaderLen) ||
+      (xMsgLen <= (xHeaderLen + C_K_KTA__HMAC_MAX_SIZE)) ||
+      (NULL == xpWorkBuffer) || (NULL == xpClearDataLen))
+  {
+    status = E_K_STATUS_PARAMETER;
+    M_KTALOG__ERR("Invalid parameter passed");
+  }
+  else
+  {
+    macOffset = xMsgLen - C_K_KTA__HMAC_MAX_SIZE;
+    encryptedLen = macOffset - xHeaderLen;
+    status = ktacipherVerifySignedMsg(xpMsg, macOffset, &xpMsg[macOffset]);
+
+    if ((E_K_STATUS_OK == status) && (0u != (encryptedLen % C_K_CRYPTO__AES_BLOCK_SIZE)))
+    {
+      status = E_K_STATUS_DECRYPTION;
+    }
+
+    /* Authenticated, the padding is in the last block. */
+    if (E_K_STATUS_OK == status)
+    {
+      status = ktacipherDecryptSegment(&xpMsg[xHeaderLen],
+                                       encryptedLen - C_K_CRYPTO__AES_BLOCK_SIZE,
+                                       C_K_CRYPTO__AES_BLOCK_SIZE,
+                                       xpWorkBuffer,
+                                       xWorkBufferSize,
+                                       &pLastBlock);
+
+      if ((E_K_STATUS_OK != status) ||
+          (E_K_STATUS_OK != ktacipherRemovePadding(pLastBlock, &lastBlockLen)))
+      {
+        status = E_K_STATUS_DECRYPTION;
+      }
+    }
+
+    if (E_K_STATUS_OK == status)
+    {
+      *xpClearDataLen = encryptedLen - C_K_CRYPTO__AES_BLOCK_SIZE + lastBlockLen;
+    }
+    else
+    {
+      M_KTALOG__ERR("Verification failed with status : %d", status);
+    }
+  }
+
+  M_KTALOG__END("End, status : %d", status);
+  return status;
+}
+
+/**
+ * @brief implement ktacipherDecryptSegment
+ *
+ */
+TKStatus ktacipherDecryptSegment
+(
+  const uint8_t* xpEncryptedData,
+  size_t         xOffset,
+  size_t         xLength,
+  uint8_t*       xpWorkBuffer,
+  size_t         xWorkBufferSize,
+  uint8_t**      xppClearData
+)
+{
+  size_t   firstBlock = 0u;
+  size_t   start = 0u;
+  size_t   end = 0u;
+  size_t   clearLen = 0u;
+  TKStatus status = E_K_STATUS_ERROR;
+
+  if ((NULL == xpEncryptedData) || (0u == xLength) || (NULL == xpWorkBuffer) ||
+      (NULL == xppClearData))
+  {
+    status = E_K_STATUS_PARAMETER;
+    M_KTALOG__ERR("Invalid parameter passed");
+  }
+  else
+  {
+    firstBlock = xOffset - (xOffset % C_K_CRYPTO__AES_BLOCK_SIZE);
+    /* The fixed IV only chains into the first block of the payload, any other one needs the
+       encrypted block before it. */
+    start = (0u == firstBlock) ? 0u : (firstBlock - C_K_CRYPTO__AES_BLOCK_SIZE);
+    end = xOffset + xLength;
+    end += (C_K_CRYPTO__AES_BLOCK_SIZE - (end % C_K_CRYPTO__AES_BLOCK_SIZE)) %
+           C_K_CRYPTO__AES_BLOCK_SIZE;
+    clearLen = end - start;
+
+    if (clearLen > xWorkBufferSize)
+    {
+      status = E_K_STATUS_MEMORY;
+      M_KTALOG__ERR("Segment [%d] does not fit in [%d]", clearLen, xWorkBufferSize);
+    }
+    else
+    {
+      status = salCryptoAesDec(C_K_KTA__VOLATILE_3_ID,
+                               &xpEncryptedData[start],
+                               end - start,
+                               xpWorkBuffer,
+                               &clearLen);
+
+      if (E_K_STATUS_OK == status)
+      {
+        *xppClearData = &xpWorkBuffer[xOffset - start];
+      }
+      else
+      {
+        M_KTALOG__ERR("AES Decryption failed with status : %d", status);
+      }
+    }
+  }
+
+  return status;
+}
+
 /* -------------------------------------------------------------------------- */
 /* LOCAL FUNCTIONS - IMPLEMENTATION                                           */
 /* -------------------------------------------------------------------------- */
@@ -62,6 +62,10 @@ extern "C" {
 /** @brief Padding start condition. */
 #define C_K_CRYPTO__PAD_START_BYTE (0x80u)
 
+/** @brief Length of x_length bytes once padded, padding always adds at least one byte. */
+#define M_K_CRYPTO__PADDED_LENGTH(x_length) \
+  ((x_length) + C_K_CRYPTO__AES_BLOCK_SIZE - ((x_length) % C_K_CRYPTO__AES_BLOCK_SIZE))
+
 /* -------------------------------------------------------------------------- */
 /* VARIABLES                                                                  */
 /* -------------------------------------------------------------------------- */
@@ -224,6 +228,141 @@ TKStatus ktacipherRemovePadding
   size_t*        xpDataLength
 );
 
+/**
+ * @brief
+ *   Pad, encrypt and sign a message in place, walking the payload once.
+ *   The header is signed but not encrypted, its length field must already account for
+ *   M_K_CRYPTO__PADDED_LENGTH(xPayloadLen) and the MAC.
+ *
+ * @param[in,out] xpMsg
+ *   [in] Header followed by the clear payload.
+ *   [out] Header, encrypted payload and MAC.
+ * @param[in] xHeaderLen
+ *   Header length.
+ * @param[in] xPayloadLen
+ *   Clear payload length.
+ * @param[in] xMsgBufferSize
+ *   Size of xpMsg buffer.
+ * @param[out] xpMsgLen
+ *   Length of the signed message, MAC included.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_PARAMETER for wrong input parameter.
+ * - E_K_STATUS_ERROR for other errors.
+ */
+TKStatus ktacipherPadEncryptAndSign
+(
+  uint8_t* xpMsg,
+  size_t   xHeaderLen,
+  size_t   xPayloadLen,
+  size_t   xMsgBufferSize,
+  size_t*  xpMsgLen
+);
+
+/**
+ * @brief
+ *   Verify, decrypt and unpad a signed message, walking the payload once.
+ *   Nothing is returned in xpClearData unless the MAC matches.
+ *
+ * @param[in] xpMsg
+ *   Header, encrypted payload and MAC.
+ * @param[in] xHeaderLen
+ *   Header length.
+ * @param[in] xMsgLen
+ *   Length of xpMsg, MAC included.
+ * @param[out] xpClearData
+ *   Buffer to carry the clear payload, may be the payload of xpMsg.
+ * @param[in,out] xpClearDataLen
+ *   [in] Length of xpClearData buffer.
+ *   [out] Clear payload length, padding removed.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_PARAMETER for wrong input parameter.
+ * - E_K_STATUS_ERROR if the MAC does not match.
+ * - E_K_STATUS_DECRYPTION if the MAC matches but decryption or padding removal failed.
+ */
+TKStatus ktacipherVerifyDecryptAndUnpad
+(
+  const uint8_t* xpMsg,
+  size_t         xHeaderLen,
+  size_t         xMsgLen,
+  uint8_t*       xpClearData,
+  size_t*        xpClearDataLen
+);
+
+/**
+ * @brief
+ *   Verify a signed message without decrypting it, and get the length of its clear payload.
+ *   Only the last encrypted block is decrypted, to find the padding; the payload is then
+ *   decrypted piecewise with ktacipherDecryptSegment().
+ *
+ * @param[in] xpMsg
+ *   Header, encrypted payload and MAC.
+ * @param[in] xHeaderLen
+ *   Header length.
+ * @param[in] xMsgLen
+ *   Length of xpMsg, MAC included.
+ * @param[in] xpWorkBuffer
+ *   Scratch buffer, at least three AES blocks.
+ * @param[in] xWorkBufferSize
+ *   Size of xpWorkBuffer.
+ * @param[out] xpClearDataLen
+ *   Clear payload length, padding removed.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_PARAMETER for wrong input parameter.
+ * - E_K_STATUS_ERROR if the MAC does not match.
+ * - E_K_STATUS_DECRYPTION if the MAC matches but decryption or padding removal failed.
+ */
+TKStatus ktacipherVerifyAndGetClearLength
+(
+  const uint8_t* xpMsg,
+  size_t         xHeaderLen,
+  size_t         xMsgLen,
+  uint8_t*       xpWorkBuffer,
+  size_t         xWorkBufferSize,
+  size_t*        xpClearDataLen
+);
+
+/**
+ * @brief
+ *   Decrypt a range of a CBC encrypted payload, e.g. one command of a message larger than
+ *   the working buffer. The block before the range is decrypted too, as it chains into
+ *   the first one, so xpWorkBuffer needs up to three AES blocks more than xLength.
+ *   The MAC of the message must have been verified beforehand.
+ *
+ * @param[in] xpEncryptedData
+ *   Encrypted payload, starting at its first block.
+ * @param[in] xOffset
+ *   Offset of the range in the clear payload.
+ * @param[in] xLength
+ *   Length of the range.
+ * @param[in] xpWorkBuffer
+ *   Buffer receiving the decrypted blocks.
+ * @param[in] xWorkBufferSize
+ *   Size of xpWorkBuffer.
+ * @param[out] xppClearData
+ *   Clear range, pointing into xpWorkBuffer.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_PARAMETER for wrong input parameter.
+ * - E_K_STATUS_MEMORY if the range does not fit in xpWorkBuffer.
+ * - E_K_STATUS_ERROR for other errors.
+ */
+TKStatus ktacipherDecryptSegment
+(
+  const uint8_t* xpEncryptedData,
+  size_t         xOffset,
+  size_t         xLength,
+  uint8_t*       xpWorkBuffer,
+  size_t         xWorkBufferSize,
+  uint8_t**      xppClearData
+);
+
 #ifdef __cplusplus
 }
 #endif /* C++ */
@@ -91,14 +91,11 @@ TKStatus ktaGenerateResponse
 {
   TKStatus status = E_K_STATUS_ERROR;
   uint8_t  totSteps;
-  uint8_t  aComputedMac[C_K_KTA__HMAC_MAX_SIZE] = {0};
   /* Not initialised these variable to 0 as bitmap step is coherent */
-  size_t   serializedMsgLen = C_K__ICPP_MSG_MAX_SIZE;
-  size_t   serializedPaddedMsgLen = C_K__ICPP_MSG_MAX_SIZE;
-  size_t   encMsgLen = C_K__ICPP_MSG_MAX_SIZE;
+  size_t   serializedMsgLen = 0;
 
   M_KTALOG__START("Start");
-  if ((*xpMessageToSendSize < 0u) || (*xpMessageToSendSize > C_K__ICPP_MSG_MAX_SIZE))
+  if ((0u == *xpMessageToSendSize) || (*xpMessageToSendSize > C_K__ICPP_MSG_MAX_SIZE))
   {
     M_KTALOG__ERR("Invalid xpMessageToSendSize : %d", *xpMessageToSendSize);
   }
@@ -114,6 +111,7 @@ TKStatus ktaGenerateResponse
     }
     else
     {
+      serializedMsgLen = *xpMessageToSendSize;
       totSteps = xTotalCodedSteps & C_GEN__SERIALIZE;
 
       if (C_GEN__SERIALIZE == totSteps)
@@ -136,11 +134,11 @@ TKStatus ktaGenerateResponse
         }
       }
 
-      totSteps = xTotalCodedSteps & C_GEN__PADDING;
+      totSteps = xTotalCodedSteps & (C_GEN__PADDING | C_GEN__ENCRYPT | C_GEN__SIGNING);
 
-      if (C_GEN__PADDING == totSteps)
+      if ((C_GEN__PADDING | C_GEN__ENCRYPT | C_GEN__SIGNING) == totSteps)
       {
-        /* Add required padding bytes before encryption. */
+        /* Pad, encrypt and sign the serialized message in a single pass. */
         // REQ RQ_M-KTA-REGT-FN-0040(1) : Pad Registeration Info Serialized Message
         // REQ RQ_M-KTA-OBJM-FN-0120(1) : Pad Generate key pair Serialized Message
         // REQ RQ_M-KTA-OBJM-FN-0320(1) : Pad Set Object Serialized Message
@@ -148,29 +146,6 @@ TKStatus ktaGenerateResponse
         // REQ RQ_M-KTA-OBJM-FN-0820(1) : Pad Set Object With Association Serialized Message
         // REQ RQ_M-KTA-OBJM-FN-1020(2) : Pad delete key object Serialized Message
         // REQ RQ_M-KTA-TRDP-FN-0130(1) : Pad Third party response Serialized Message
-        if (serializedMsgLen < C_K_ICPP_PARSER__HEADER_SIZE)
-        {
-          status = E_K_STATUS_ERROR;
-          M_KTALOG__ERR("Invalid serializedMsgLen : %d", serializedMsgLen);
-          goto end;
-        }
-        status = ktacipherAddPadding(&xpMessageToSend[C_K_ICPP_PARSER__HEADER_SIZE],
-                                    serializedMsgLen - C_K_ICPP_PARSER__HEADER_SIZE,
-                                    &xpMessageToSend[C_K_ICPP_PARSER__HEADER_SIZE],
-                                    &serializedPaddedMsgLen);
-
-        if (E_K_STATUS_OK != status)
-        {
-          M_KTALOG__ERR("Kta cipher padding got failed, status = [%d]", status);
-          goto end;
-        }
-      }
-
-      totSteps = xTotalCodedSteps & C_GEN__ENCRYPT;
-
-      if (C_GEN__ENCRYPT == totSteps)
-      {
-        /* Encrypt data. */
         // REQ RQ_M-KTA-REGT-FN-0050(1) : Encrypt the padded registeration info message
         // REQ RQ_M-KTA-OBJM-FN-0130(1) : Encrypt the padded Generate key pair message
         // REQ RQ_M-KTA-OBJM-FN-0330(1) : Encrypt the padded set object message
@@ -178,30 +153,6 @@ TKStatus ktaGenerateResponse
         // REQ RQ_M-KTA-OBJM-FN-0830(1) : Encrypt the padded set object with association message
         // REQ RQ_M-KTA-OBJM-FN-1030(2) : Encrypt the padded delete key object message
         // REQ RQ_M-KTA-TRDP-FN-0140(1) : Encrypt the padded Third party response message
-        status = ktacipherEncrypt(&xpMessageToSend[C_K_ICPP_PARSER__HEADER_SIZE],
-                                  serializedPaddedMsgLen,
-                                  &xpMessageToSend[C_K_ICPP_PARSER__HEADER_SIZE],
-                                  &encMsgLen);
-
-        if (E_K_STATUS_OK != status)
-        {
-          M_KTALOG__ERR("Kta cipher encryption of message failed, status = [%d]", status);
-          goto end;
-        }
-        if (E_K_ICPP_PARSER_STATUS_OK !=
-            ktaIcppParserSetHeaderLength(xpMessageToSend, encMsgLen + C_K_KTA__HMAC_MAX_SIZE))
-        {
-          M_KTALOG__ERR("Set header length failed");
-          status = E_K_STATUS_ERROR;
-          goto end;
-        }
-      }
-
-      totSteps = xTotalCodedSteps & C_GEN__SIGNING;
-
-      if (C_GEN__SIGNING == totSteps)
-      {
-        /* Calculate signature of data. */
         // REQ RQ_M-KTA-REGT-FN-0060(1) : Sign the encrypted registeration info message
         // REQ RQ_M-KTA-OBJM-FN-0140(1) : Sign the encrypted Generate key pair message
         // REQ RQ_M-KTA-OBJM-FN-0340(1) : Sign the encrypted set object message
@@ -209,20 +160,14 @@ TKStatus ktaGenerateResponse
         // REQ RQ_M-KTA-OBJM-FN-0840(1) : Sign the encrypted set object with association message
         // REQ RQ_M-KTA-OBJM-FN-1040(2) : Sign the encrypted delete key object message
         // REQ RQ_M-KTA-TRDP-FN-0150(1) : Sign the encrypted Third party response message
-        status = ktacipherSignMsg(xpMessageToSend,
-                                  encMsgLen + C_K_ICPP_PARSER__HEADER_SIZE,
-                                  aComputedMac);
+        status = ktaPadEncryptAndSignResponse(xpMessageToSend,
+                                              serializedMsgLen,
+                                              xpMessageToSendSize);
 
         if (E_K_STATUS_OK != status)
         {
-          M_KTALOG__ERR("Kta cipher signing of message failed, status = [%d]", status);
           goto end;
         }
-
-        (void)memcpy(&xpMessageToSend[encMsgLen + C_K_ICPP_PARSER__HEADER_SIZE],
-                    aComputedMac,
-                    C_K_KTA__HMAC_MAX_SIZE);
-        *xpMessageToSendSize = encMsgLen + C_K_ICPP_PARSER__HEADER_SIZE + C_K_KTA__HMAC_MAX_SIZE;
       }
 
       status = E_K_STATUS_OK;
@@ -234,6 +179,59 @@ end:
   return status;
 }
 
+/**
+ * @brief implement ktaPadEncryptAndSignResponse
+ *
+ */
+TKStatus ktaPadEncryptAndSignResponse
+(
+  uint8_t* xpMessageToSend,
+  size_t   xSerializedMsgLen,
+  size_t*  xpMessageToSendSize
+)
+{
+  TKStatus status = E_K_STATUS_ERROR;
+  size_t   payloadLen = 0;
+
+  M_KTALOG__START("Start");
+
+  if ((NULL == xpMessageToSend) || (NULL == xpMessageToSendSize) ||
+      (xSerializedMsgLen < C_K_ICPP_PARSER__HEADER_SIZE) ||
+      (xSerializedMsgLen > *xpMessageToSendSize))
+  {
+    status = E_K_STATUS_PARAMETER;
+    M_KTALOG__ERR("Invalid serializedMsgLen : %d", xSerializedMsgLen);
+  }
+  else
+  {
+    payloadLen = xSerializedMsgLen - C_K_ICPP_PARSER__HEADER_SIZE;
+
+    /* The header is signed, its length must be final before encryption starts. */
+    if (E_K_ICPP_PARSER_STATUS_OK !=
+        ktaIcppParserSetHeaderLength(xpMessageToSend,
+                                     M_K_CRYPTO__PADDED_LENGTH(payloadLen) + C_K_KTA__HMAC_MAX_SIZE))
+    {
+      M_KTALOG__ERR("Set header length failed");
+    }
+    else
+    {
+      status = ktacipherPadEncryptAndSign(xpMessageToSend,
+                                          C_K_ICPP_PARSER__HEADER_SIZE,
+                                          payloadLen,
+                                          *xpMessageToSendSize,
+                                          xpMessageToSendSize);
+
+      if (E_K_STATUS_OK != status)
+      {
+        M_KTALOG__ERR("Kta cipher pad, encrypt and sign failed, status = [%d]", status);
+      }
+    }
+  }
+
+  M_KTALOG__END("End, status : %d", status);
+  return status;
+}
+
 /* -------------------------------------------------------------------------- */
 /* LOCAL FUNCTIONS - IMPLEMENTATION                                           */
 /* -------------------------------------------------------------------------- */
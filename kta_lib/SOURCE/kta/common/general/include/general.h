@@ -107,6 +107,32 @@ TKStatus ktaGenerateResponse
   size_t*                      xpMessageToSendSize
 );
 
+/**
+ * @brief
+ *   Pad, encrypt and sign a message already serialized in place, e.g. built one command
+ *   at a time. Same as the last three steps of ktaGenerateResponse().
+ *
+ * @param[in,out] xpMessageToSend
+ *   [in] Serialized message, header first.
+ *   [out] Padded, encrypted and signed message.
+ * @param[in] xSerializedMsgLen
+ *   Length of the serialized message, header included.
+ * @param [in,out] xpMessageToSendSize
+ *   [in] Pointer to carry the xpMessageToSend buffer length.
+ *   [out] Actual signed message length.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_PARAMETER for wrong input parameter.
+ * - E_K_STATUS_ERROR for other errors.
+ */
+TKStatus ktaPadEncryptAndSignResponse
+(
+  uint8_t* xpMessageToSend,
+  size_t   xSerializedMsgLen,
+  size_t*  xpMessageToSendSize
+);
+
 #ifdef __cplusplus
 }
 #endif /* C++ */
@@ -155,22 +155,6 @@ static const char* gpModuleName = "KTAICPPPARSER";
   (((x_cmdTag) >= C_K_ICPP__1BYTE_START_WITH_FILED_RANGE_CMD_TAG) && \
    ((x_cmdTag) <= C_K_ICPP__1BYTE_END_WITHOUT_FILED_RANGE_CMD_TAG) ? 1u : 2u)
 
-/**
- * @brief Get the field length for one 1 byte.
- *
- * @param[in] x_fieldTag Field tag.
- *
- */
-#define M_K_ICPP_PARSER_GET_1_BYTE_FIELD_LENGTH(x_fieldTag)   (1u)
-
-/**
- * @brief Get the field length for two bytes.
- *
- * @param[in] x_fieldTag Field tag.
- *
- */
-#define M_K_ICPP_PARSER_GET_2_BYTE_FIELD_LENGTH(x_fieldTag)   (2u)
-
 /** @brief ICPP Tag related enum. */
 typedef enum
 {
@@ -188,9 +172,123 @@ typedef enum
   E_ICPP_PARSER_NUM_TAG_TYPE
 } TKIcppTagType;
 
+/** @brief Buffer a message is serialized into, segment after segment. */
+typedef struct
+{
+  uint8_t*  pBuffer;
+  /* Destination buffer. */
+  size_t    bufferSize;
+  /* Size of pBuffer. */
+  size_t    position;
+  /* Bytes written so far. */
+} TKIcppWriteBuffer;
+
+/** @brief Largest tag and length prefix: tag and 2 bytes of length. */
+#define C_K_ICPP_PARSER_MAX_TAG_LENGTH_SIZE         (3u)
+
+/** @brief Number of values a one byte tag can take. */
+#define C_K_ICPP_PARSER_TAG_COUNT                   (256u)
+
+/** @brief Command tag properties, looked up by tag value. */
+typedef struct
+{
+  uint8_t  tagLen;
+  /* Size of the command length, 0 if the command tag is not supported. */
+  uint8_t  hasFields;
+  /* Non zero if the command value is a list of fields. */
+} TKIcppCommandTagDescriptor;
+
+/**
+ * @brief Descriptor of a supported command tag, derived from the tag range.
+ *
+ * @param[in] x_cmdTag Command tag.
+ *
+ */
+#define M_ICPP_PARSER_COMMAND_TAG(x_cmdTag)                                  \
+  [(x_cmdTag)] = {                                                           \
+    (uint8_t)(M_K_ICPP_PARSER_GET_COMMAND_LENGTH((uint32_t)(x_cmdTag))),     \
+    (uint8_t)(M_K_ICPP_PARSER__COMMAND_TAG_HAS_FIELDS(x_cmdTag))             \
+  }
+
+/**
+ * @brief Check whether a supported command tag carries fields.
+ *
+ * @param[in] x_cmdTag Command tag.
+ *
+ */
+#define M_ICPP_PARSER_COMMAND_TAG_HAS_FIELDS(x_cmdTag)  \
+  (0u != gaIcppParserCommandTags[(uint8_t)(x_cmdTag)].hasFields)
+
 /* -------------------------------------------------------------------------- */
 /* LOCAL VARIABLES                                                            */
 /* -------------------------------------------------------------------------- */
+/**
+ * @brief Supported command tags. Commands are registered here, unlisted tags are
+ *        rejected by the parser.
+ */
+static const TKIcppCommandTagDescriptor gaIcppParserCommandTags[C_K_ICPP_PARSER_TAG_COUNT] =
+{
+  M_ICPP_PARSER_COMMAND_TAG(E_K_ICPP_PARSER_COMMAND_TAG_ACTIVATION),
+  M_ICPP_PARSER_COMMAND_TAG(E_K_ICPP_PARSER_COMMAND_TAG_REGISTERATION_INFO),
+  M_ICPP_PARSER_COMMAND_TAG(E_K_ICPP_PARSER_COMMAND_TAG_THIRD_PARTY),
+  M_ICPP_PARSER_COMMAND_TAG(E_K_ICPP_PARSER_COMMAND_TAG_PROCESSING_STATUS),
+  M_ICPP_PARSER_COMMAND_TAG(E_K_ICPP_PARSER_COMMAND_TAG_CMD_PROCESSING_ERROR),
+  M_ICPP_PARSER_COMMAND_TAG(E_K_ICPP_PARSER_COMMAND_TAG_GENERATE_KEY_PAIR),
+  M_ICPP_PARSER_COMMAND_TAG(E_K_ICPP_PARSER_COMMAND_TAG_SET_OBJECT),
+  M_ICPP_PARSER_COMMAND_TAG(E_K_ICPP_PARSER_CMD_TAG_SET_OBJ_WITH_ASSOCIATION),
+  M_ICPP_PARSER_COMMAND_TAG(E_K_ICPP_PARSER_COMMAND_TAG_DELETE_OBJECT),
+  M_ICPP_PARSER_COMMAND_TAG(E_K_ICPP_PARSER_CMD_TAG_DELETE_KEY_OBJECT),
+  M_ICPP_PARSER_COMMAND_TAG(E_K_ICPP_PARSER_CMD_TAG_GET_CHALLENGE),
+#ifdef FOTA_ENABLE
+  M_ICPP_PARSER_COMMAND_TAG(E_K_ICPP_PARSER_CMD_TAG_INSTALL_FOTA),
+  M_ICPP_PARSER_COMMAND_TAG(E_K_ICPP_PARSER_CMD_TAG_GET_FOTA_STATUS),
+  M_ICPP_PARSER_COMMAND_TAG(E_K_ICPP_PARSER_COMMAND_TAG_DEVICE_INFO),
+#endif // FOTA_ENABLE
+};
+
+/** @brief Size of the length of each supported field tag, 0 if not supported. */
+static const uint8_t gaIcppParserFieldTagLen[C_K_ICPP_PARSER_TAG_COUNT] =
+{
+  [E_K_ICPP_PARSER_FIELD_TAG_DEVPROFUID]                  = 1u,
+  [E_K_ICPP_PARSER_FIELD_TAG_MUTABLE_DEVPROFUID]          = 1u,
+  [E_K_ICPP_PARSER_FIELD_TAG_CHIP_UID]                    = 1u,
+  [E_K_ICPP_PARSER_FIELD_TAG_ROT_SOL_ID]                  = 1u,
+  [E_K_ICPP_PARSER_FIELD_TAG_ROT_PUBLIC_UID]              = 1u,
+  [E_K_ICPP_PARSER_FIELD_TAG_ACK_SEQ_CNT]                 = 1u,
+  [E_K_ICPP_PARSER_FLD_TAG_KTA_CAPABILITY]                = 1u,
+  [E_K_ICPP_PARSER_FIELD_TAG_KTA_CTX_PRO_UID]             = 1u,
+  [E_K_ICPP_PARSER_FLD_TAG_KTA_CTX_SERIAL_NO]             = 1u,
+  [E_K_ICPP_PRSR_FLD_TAG_KTA_CTX_VER]                     = 1u,
+  [E_K_ICPP_PARSER_FIELD_TAG_KTA_VER]                     = 1u,
+  [E_K_ICPP_PARSER_FIELD_TAG_DEV_SERIAL_NO]               = 1u,
+  [E_K_ICPP_PARSER_FLD_TAG_CMD_IDENTIFIER]                = 1u,
+  [E_K_ICPP_PARSER_FIELD_TAG_CMD_OBJECT_TYPE]             = 1u,
+  [E_K_ICPP_PARSER_FIELD_TAG_CMD_ATTRIBUTES]              = 1u,
+  [E_K_ICPP_PARSER_FIELD_TAG_CMD_ASSOCIATION_INFO]        = 1u,
+  [E_K_ICPP_PRSR_FLD_TAG_CMD_OBJECT_OWNER]                = 1u,
+  [E_K_ICPP_PARSER_FIELD_TAG_CMD_PROCESSING_STATUS]       = 1u,
+  [E_K_ICPP_PARSER_FIELD_TAG_CHALLENGE]                   = 1u,
+  [E_K_ICPP_PARSER_FIELD_TAG_CMD_OBJECT_UID]              = 1u,
+  [E_K_ICPP_PARSER_FIELD_TAG_CMD_CUSTOMER_METADATA]       = 1u,
+#ifdef FOTA_ENABLE
+  [E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA]                    = 1u,
+  [E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA_METADATA]           = 1u,
+  [E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA_COMPONENT_TARGET]   = 1u,
+  [E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA_COMPONENT_VERSION]  = 1u,
+  [E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA_ERROR_CODE]         = 1u,
+  [E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA_ERROR_CAUSE]        = 1u,
+#endif // FOTA_ENABLE
+  [E_K_ICPP_PARSER_FIELD_TAG_ROT_E_PK]                    = 2u,
+  [E_K_ICPP_PARSER_FLD_TAG_CHIP_CERT]                     = 2u,
+  [E_K_ICPP_PARSER_FLD_TAG_CHIP_ATTEST_CERT]              = 2u,
+  [E_K_ICPP_PARSER_FIELD_TAG_SIGNED_PUB_KEY]              = 2u,
+  [E_K_ICPP_PARSER_FIELD_TAG_KS_E_PK]                     = 2u,
+  [E_K_ICPP_PARSER_FLD_TAG_CMD_PUBLIC_KEY]                = 2u,
+  [E_K_ICPP_PARSER_FLD_TAG_CMD_DATA]                      = 2u,
+#ifdef FOTA_ENABLE
+  [E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA_COMPONENT_URL]      = 2u,
+#endif // FOTA_ENABLE
+};
 
 /* -------------------------------------------------------------------------- */
 /* LOCAL FUNCTIONS - PROTOTYPE                                                */
@@ -256,6 +354,33 @@ static void lIcppParserSetTagLength
   uint32_t  xBufferValue
 );
 
+/**
+  * @brief Read the tag and length of the command starting xpData.
+  *
+  * @param[in] xpData
+  *   Command tag and length.
+  * @param[in] xDataLen
+  *   Length of xpData, in bytes.
+  * @param[out] xpCommandTag
+  *   Command tag.
+  * @param[out] xpHeaderLen
+  *   Size of the command tag and length, in bytes.
+  * @param[out] xpCommandLength
+  *   Length of the command value.
+  *
+  * @return
+  * - E_K_ICPP_PARSER_STATUS_OK in case of success.
+  * - E_K_ICPP_PARSER_STATUS_ERROR for an invalid tag or a truncated length.
+  */
+static TKParserStatus lIcppParserReadCommandHeader
+(
+  const uint8_t*     xpData,
+  size_t             xDataLen,
+  TKIcppCommandTag*  xpCommandTag,
+  size_t*            xpHeaderLen,
+  uint32_t*          xpCommandLength
+);
+
 /**
   * @brief Deserialize the fields.
   *
@@ -303,50 +428,106 @@ static TKParserStatus lIcppParserDeserializeCommands
 );
 
 /**
-  * @brief Serialize the fields.
+  * @brief Compute the tag length width and the value length of a command.
+  *
+  * @param[in] xpCommand
+  *   Command to serialize.
+  * @param[out] xpTagLen
+  *   Number of bytes carrying the command length.
+  * @param[out] xpValueLen
+  *   Length of the command value, fields included.
+  *
+  * @return
+  * - E_K_ICPP_PARSER_STATUS_OK in case of success.
+  * - E_K_ICPP_PARSER_STATUS_ERROR for invalid tags, counts or lengths.
+  */
+static TKParserStatus lIcppParserGetCommandSize
+(
+  const TKIcppCommand*  xpCommand,
+  uint32_t*             xpTagLen,
+  size_t*               xpValueLen
+);
+
+/**
+  * @brief Write a tag and its length to the buffer.
+  *
+  * @param[in,out] xpBuffer
+  *   Buffer receiving the segment.
+  * @param[in] xTag
+  *   Command or field tag.
+  * @param[in] xTagLen
+  *   Number of bytes carrying the length.
+  * @param[in] xValueLen
+  *   Length to encode.
+  *
+  * @return
+  * - E_K_ICPP_PARSER_STATUS_OK in case of success.
+  * - E_K_ICPP_PARSER_STATUS_ERROR if the buffer is too small.
+  */
+static TKParserStatus lIcppParserWriteTagLength
+(
+  TKIcppWriteBuffer*  xpBuffer,
+  uint32_t            xTag,
+  uint32_t            xTagLen,
+  size_t              xValueLen
+);
+
+/**
+  * @brief Serialize the commands into the buffer.
+  *
+  * @param[in] xpIcppMessage
+  *   ICPP structure carrying command info, checked by lIcppParserGetCommandSize.
+  * @param[in,out] xpBuffer
+  *   Buffer receiving the segments.
   *
-  * @param[in] xpFieldList
-  *   ICPP message structure carrying info of fields.
-  * @param[in,out] xpMessageField
-  *   [in] Pointer to buffer carrying serialized message.
-  *   [out] serialized message.
-  * @param[in,out] xpMessageFieldSize
-  *   [in] Pointer to buffer carrying serialized message length.
-  *   [out] serialized message length.
   * @return
   * - E_K_ICPP_PARSER_STATUS_OK in case of success.
-  * - E_K_ICPP_PARSER_STATUS_PARAMETER for wrong input parameter.
   * - E_K_ICPP_PARSER_STATUS_ERROR for other errors.
   */
-static TKParserStatus lIcppParserSerializeFields
+static TKParserStatus lIcppParserSerializeCommands
 (
-  const TKIcppFieldList*  xpFieldList,
-  uint8_t*                xpMessageField,
-  uint32_t*               xpMessageFieldSize
+  const TKIcppProtocolMessage*  xpIcppMessage,
+  TKIcppWriteBuffer*            xpBuffer
 );
 
 /**
-  * @brief Serialize the commands.
+  * @brief Compute the serialized length of the commands.
   *
   * @param[in] xpIcppMessage
   *   ICPP structure carrying command info.
-  * @param[in,out] xpMessageCommand
-  *   [in] Pointer to buffer carrying serialized data.
-  *   [out] Actual serialzied data.
-  * @param[in,out] xpMessageCommandSize
-  *   [in] Pointer to buffer carrying serialized data length.
-  *   [out] Actual serialzied data length.
+  * @param[out] xpPayloadSize
+  *   Serialized length of the commands, header excluded.
   *
   * @return
   * - E_K_ICPP_PARSER_STATUS_OK in case of success.
   * - E_K_ICPP_PARSER_STATUS_PARAMETER for wrong input parameter.
   * - E_K_ICPP_PARSER_STATUS_ERROR for other errors.
   */
-static TKParserStatus lIcppParserSerializeCommands
+static TKParserStatus lIcppParserGetPayloadSize
 (
   const TKIcppProtocolMessage*  xpIcppMessage,
-  uint8_t*                      xpMessageCommand,
-  size_t*                      xpMessageCommandSize
+  size_t*                       xpPayloadSize
+);
+
+/**
+  * @brief Append a segment to the buffer.
+  *
+  * @param[in,out] xpBuffer
+  *   Buffer receiving the segment.
+  * @param[in] xpData
+  *   Segment to append.
+  * @param[in] xDataLen
+  *   Length of xpData.
+  *
+  * @return
+  * - E_K_ICPP_PARSER_STATUS_OK in case of success.
+  * - E_K_ICPP_PARSER_STATUS_ERROR if the buffer is too small.
+  */
+static TKParserStatus lIcppParserWrite
+(
+  TKIcppWriteBuffer*  xpBuffer,
+  const uint8_t*      xpData,
+  size_t              xDataLen
 );
 
 /**
@@ -383,6 +564,11 @@ static TKParserStatus lIcppParserDeserializeHeader
  * @brief implement ktaIcppParserSerializeMessage
  *
  */
+/**
+ * SUPPRESS: MISRA_DEV_KTA_005 : misra_c2012_rule_15.4_violation
+ * SUPPRESS: MISRA_DEV_KTA_004 : misra_c2012_rule_15.1_violation
+ * Using goto for breaking during the error and return cases.
+ **/
 TKParserStatus ktaIcppParserSerializeMessage
 (
   const TKIcppProtocolMessage* xpIcppMessage,
@@ -390,8 +576,10 @@ TKParserStatus ktaIcppParserSerializeMessage
   size_t*                      xpMessageToSendSize
 )
 {
-  TKParserStatus  status = E_K_ICPP_PARSER_STATUS_ERROR;
-  size_t          bufferSize = 0;
+  TKParserStatus     status = E_K_ICPP_PARSER_STATUS_ERROR;
+  TKIcppWriteBuffer  buffer = {0};
+  uint8_t            aHeader[C_K_ICPP_PARSER__HEADER_SIZE];
+  size_t             payloadSize = 0;
 
   M_KTALOG__START("Start");
 
@@ -400,66 +588,122 @@ TKParserStatus ktaIcppParserSerializeMessage
     (NULL == xpMessageToSend) ||
     (NULL == xpMessageToSendSize) ||
     (0u == *xpMessageToSendSize) ||
-    (*xpMessageToSendSize < C_K_ICPP_PARSER__HEADER_SIZE) ||
-    (E_K_ICPP_PARSER_MSG_TYPE_RESERVED <= (uint32_t) xpIcppMessage->msgType) ||
-    (C_K_ICPP_PARSER__MAX_COMMANDS_COUNT < xpIcppMessage->commandsCount))
+    (*xpMessageToSendSize < C_K_ICPP_PARSER__HEADER_SIZE))
+  {
+    M_KTALOG__ERR("Invalid parameters");
+    status = E_K_ICPP_PARSER_STATUS_PARAMETER;
+    goto end;
+  }
+
+  /* Sizing pass, checks the whole message before anything is written. */
+  status = lIcppParserGetPayloadSize(xpIcppMessage, &payloadSize);
+
+  if (E_K_ICPP_PARSER_STATUS_OK != status)
+  {
+    M_KTALOG__ERR("Serialization of commands got Failed %d", status);
+    goto end;
+  }
+
+  // REQ RQ_M-KTA-ICPP-FN-0070(1) : Serialize ICPP Header
+  /* ICPP prtocol version | reserved data. */
+  // REQ RQ_M-KTA-ICPP-FN-0120(1) : Check protocol version
+  aHeader[C_K_ICPP_PARSER_VERSION_INDEX] =
+    C_K_ICPP_PARSER_PROTOCOL_VERSION | C_K_ICPP_PARSER_RESERVED;
+
+  /* ICPP crypto version | encryption mode | reserved | message type. */
+  // REQ RQ_M-KTA-ICPP-FN-0130(1) : Check message type
+  aHeader[C_K_ICPP_PARSER_MESSAGE_TYPE_INDEX] =
+    (uint8_t)(((xpIcppMessage->cryptoVersion & 0x0Fu) << 4u) |
+    ((xpIcppMessage->encMode & 0x01u) << 3u) |
+    ((uint32_t)xpIcppMessage->msgType & C_K_ICPP_PARSER_MESSAGE_TYPE_BIT_MASK));
+  /* Transaction ID. */
+  (void)memcpy(&aHeader[C_K_ICPP_PARSER_TRANSACTION_ID_INDEX],
+               xpIcppMessage->transactionId,
+               C_K_ICPP_PARSER__TRANSACTION_ID_SIZE_IN_BYTES);
+
+  (void)memcpy(&aHeader[C_K_ICPP_PARSER_ROT_ID_INDEX],
+               xpIcppMessage->rotPublicUID,
+               C_K_ICPP_PARSER__ROT_PUBLIC_UID_SIZE_IN_BYTES);
+
+  aHeader[C_K_ICPP_PARSER_ROT_KEYSET_ID_INDEX] = xpIcppMessage->rotKeySetId;
+
+  /* The length is known from the sizing pass, the header goes out first. */
+  // REQ RQ_M-KTA-ICPP-FN-0210(1) : Set Header Length
+  lIcppParserSetTagLength(&aHeader[C_K_ICPP_PARSER_LENGTH_INDEX],
+                          C_K_ICPP_PARSER_LENGTH_SIZE_IN_HEADER,
+                          (uint32_t)(payloadSize + C_K_ICPP_PARSER_HMACSHA256_SIZE));
+
+  buffer.pBuffer = xpMessageToSend;
+  buffer.bufferSize = *xpMessageToSendSize;
+  status = lIcppParserWrite(&buffer, aHeader, sizeof(aHeader));
+
+  if (E_K_ICPP_PARSER_STATUS_OK != status)
+  {
+    M_KTALOG__ERR("Serialization of header got Failed %d", status);
+    goto end;
+  }
+
+  // REQ RQ_M-KTA-ICPP-FN-0040(1) : Serialize commands in message
+  status = lIcppParserSerializeCommands(xpIcppMessage, &buffer);
+
+  if (E_K_ICPP_PARSER_STATUS_OK != status)
+  {
+    M_KTALOG__ERR("Serialization of commands got Failed %d", status);
+    goto end;
+  }
+
+  *xpMessageToSendSize = payloadSize + C_K_ICPP_PARSER__HEADER_SIZE;
+  M_KTALOG__DEBUG("Buffer Size %d", (int)payloadSize);
+
+end:
+  M_KTALOG__END("End, status : %d", status);
+  return status;
+}
+
+/**
+ * @brief implement ktaIcppParserSerializeCommands
+ *
+ */
+TKParserStatus ktaIcppParserSerializeCommands
+(
+  const TKIcppProtocolMessage*  xpIcppMessage,
+  uint8_t*                      xpCommands,
+  size_t*                       xpCommandsSize
+)
+{
+  TKParserStatus     status = E_K_ICPP_PARSER_STATUS_ERROR;
+  TKIcppWriteBuffer  buffer = {0};
+  size_t             payloadSize = 0;
+
+  if ((NULL == xpCommands) || (NULL == xpCommandsSize))
   {
     M_KTALOG__ERR("Invalid parameters");
     status = E_K_ICPP_PARSER_STATUS_PARAMETER;
   }
   else
   {
-    bufferSize = *xpMessageToSendSize;
-    // REQ RQ_M-KTA-ICPP-FN-0070(1) : Serialize ICPP Header
-    /* ICPP prtocol version | reserved data. */
-    // REQ RQ_M-KTA-ICPP-FN-0120(1) : Check protocol version
-    xpMessageToSend[C_K_ICPP_PARSER_VERSION_INDEX] =
-      C_K_ICPP_PARSER_PROTOCOL_VERSION | C_K_ICPP_PARSER_RESERVED;
-
-    /* ICPP crypto version | encryption mode | reserved | message type. */
-    // REQ RQ_M-KTA-ICPP-FN-0130(1) : Check message type
-    xpMessageToSend[C_K_ICPP_PARSER_MESSAGE_TYPE_INDEX] =
-      (uint8_t)(((xpIcppMessage->cryptoVersion & 0x0Fu) << 4u) |
-      ((xpIcppMessage->encMode & 0x01u) << 3u) |
-      ((uint32_t)xpIcppMessage->msgType & C_K_ICPP_PARSER_MESSAGE_TYPE_BIT_MASK));
-    /* Transaction ID. */
-    (void)memcpy(&xpMessageToSend[C_K_ICPP_PARSER_TRANSACTION_ID_INDEX],
-                 xpIcppMessage->transactionId,
-                 C_K_ICPP_PARSER__TRANSACTION_ID_SIZE_IN_BYTES);
-
-    (void)memcpy(&xpMessageToSend[C_K_ICPP_PARSER_ROT_ID_INDEX],
-                 xpIcppMessage->rotPublicUID,
-                 C_K_ICPP_PARSER__ROT_PUBLIC_UID_SIZE_IN_BYTES);
-
-    xpMessageToSend[C_K_ICPP_PARSER_ROT_KEYSET_ID_INDEX] = xpIcppMessage->rotKeySetId;
-
-    /* Reserved 2 bytes for length, length will be updated later. */
-    bufferSize -= C_K_ICPP_PARSER__HEADER_SIZE;
-
-    // REQ RQ_M-KTA-ICPP-FN-0040(1) : Serialize commands in message
-    status = lIcppParserSerializeCommands(xpIcppMessage,
-                                          &xpMessageToSend[C_K_ICPP_PARSER__HEADER_SIZE],
-                                          &bufferSize);
+    /* Sizing pass, checks the commands before anything is written. */
+    status = lIcppParserGetPayloadSize(xpIcppMessage, &payloadSize);
 
-    if (E_K_ICPP_PARSER_STATUS_OK != status)
+    if ((E_K_ICPP_PARSER_STATUS_OK == status) && (payloadSize > *xpCommandsSize))
     {
-      M_KTALOG__ERR("Serialization of commands got Failed %d", status);
+      M_KTALOG__ERR("Size is less than required %d", (int)payloadSize);
+      status = E_K_ICPP_PARSER_STATUS_ERROR;
     }
-    else
+
+    if (E_K_ICPP_PARSER_STATUS_OK == status)
+    {
+      buffer.pBuffer = xpCommands;
+      buffer.bufferSize = *xpCommandsSize;
+      status = lIcppParserSerializeCommands(xpIcppMessage, &buffer);
+    }
+
+    if (E_K_ICPP_PARSER_STATUS_OK == status)
     {
-      /* Update the total length of the data in header. */
-      lIcppParserSetTagLength(&xpMessageToSend[C_K_ICPP_PARSER__HEADER_SIZE
-                              - C_K_ICPP_PARSER_LENGTH_SIZE_IN_HEADER],
-                              C_K_ICPP_PARSER_LENGTH_SIZE_IN_HEADER,
-                              bufferSize + C_K_ICPP_PARSER_HMACSHA256_SIZE);
-      // REQ RQ_M-KTA-ICPP-FN-0210(1) : Set Header Length
-      *xpMessageToSendSize = bufferSize + C_K_ICPP_PARSER__HEADER_SIZE;
-
-      M_KTALOG__DEBUG("Buffer Size %d", bufferSize);
+      *xpCommandsSize = payloadSize;
     }
   }
 
-  M_KTALOG__END("End, status : %d", status);
   return status;
 }
 
@@ -552,6 +796,69 @@ TKParserStatus ktaIcppParserDeserializeHeader
   return status;
 }
 
+/**
+ * @brief implement ktaIcppParserDeserializeCommands
+ *
+ */
+TKParserStatus ktaIcppParserDeserializeCommands
+(
+  const uint8_t*          xpPayload,
+  const size_t            xPayloadSize,
+  TKIcppProtocolMessage*  xpIcppMessage
+)
+{
+  TKParserStatus  status = E_K_ICPP_PARSER_STATUS_ERROR;
+
+  M_KTALOG__START("Start");
+
+  if ((NULL == xpPayload) || (NULL == xpIcppMessage) || (0u == xPayloadSize))
+  {
+    M_KTALOG__ERR("Invalid parameters");
+    status = E_K_ICPP_PARSER_STATUS_PARAMETER;
+  }
+  else
+  {
+    status = lIcppParserDeserializeCommands(xpPayload, xPayloadSize, xpIcppMessage);
+  }
+
+  M_KTALOG__END("End, status : %d", status);
+  return status;
+}
+
+/**
+ * @brief implement ktaIcppParserGetCommandSize
+ *
+ */
+TKParserStatus ktaIcppParserGetCommandSize
+(
+  const uint8_t*  xpData,
+  size_t          xDataLen,
+  size_t*         xpCommandSize
+)
+{
+  TKParserStatus    status = E_K_ICPP_PARSER_STATUS_PARAMETER;
+  TKIcppCommandTag  commandTag = E_K_ICPP_PARSER_COMMAND_TAG_ACTIVATION;
+  size_t            headerLen = 0;
+  uint32_t          commandLength = 0;
+
+  if ((NULL == xpData) || (0u == xDataLen) || (NULL == xpCommandSize))
+  {
+    M_KTALOG__ERR("Invalid parameters");
+  }
+  else
+  {
+    status = lIcppParserReadCommandHeader(xpData, xDataLen, &commandTag, &headerLen,
+                                          &commandLength);
+
+    if (E_K_ICPP_PARSER_STATUS_OK == status)
+    {
+      *xpCommandSize = headerLen + commandLength;
+    }
+  }
+
+  return status;
+}
+
 /**
  * @brief implement ktaIcppParserUpdateHeaderLength
  *
@@ -639,118 +946,44 @@ static TKParserStatus lIcppParserIsValidTag
   uint32_t*             xpTagLen
 )
 {
-  TKParserStatus  status = E_K_ICPP_PARSER_STATUS_ERROR;
+  TKParserStatus  status = E_K_ICPP_PARSER_STATUS_PARAMETER;
+  uint32_t        tagLen = 0;
 
-  if (E_ICPP_PARSER_TAG_TYPE_COMMAND == xTagType)
+  if (C_K_ICPP_PARSER_TAG_COUNT <= xTag)
   {
-    switch (xTag)
-    {
-      case E_K_ICPP_PARSER_COMMAND_TAG_ACTIVATION:
-      case E_K_ICPP_PARSER_COMMAND_TAG_REGISTERATION_INFO:
-      case E_K_ICPP_PARSER_COMMAND_TAG_THIRD_PARTY:
-      case E_K_ICPP_PARSER_COMMAND_TAG_PROCESSING_STATUS:
-      case E_K_ICPP_PARSER_COMMAND_TAG_CMD_PROCESSING_ERROR:
-      case E_K_ICPP_PARSER_COMMAND_TAG_GENERATE_KEY_PAIR:
-      case E_K_ICPP_PARSER_COMMAND_TAG_SET_OBJECT:
-      case E_K_ICPP_PARSER_CMD_TAG_SET_OBJ_WITH_ASSOCIATION:
-      case E_K_ICPP_PARSER_COMMAND_TAG_DELETE_OBJECT:
-      case E_K_ICPP_PARSER_CMD_TAG_DELETE_KEY_OBJECT:
-      case E_K_ICPP_PARSER_CMD_TAG_GET_CHALLENGE:
-#ifdef FOTA_ENABLE
-      case E_K_ICPP_PARSER_CMD_TAG_INSTALL_FOTA:
-      case E_K_ICPP_PARSER_CMD_TAG_GET_FOTA_STATUS:
-      case E_K_ICPP_PARSER_COMMAND_TAG_DEVICE_INFO:
-#endif // FOTA_ENABLE
-      {
-        if (xpTagLen != NULL)
-        {
-          *xpTagLen = (uint32_t)(M_K_ICPP_PARSER_GET_COMMAND_LENGTH(xTag));
-        }
-      }
-      status = E_K_ICPP_PARSER_STATUS_OK;
-      break;
+    M_KTALOG__ERR("Unknown xTag %u", xTag);
+  }
+  else if (E_ICPP_PARSER_TAG_TYPE_COMMAND == xTagType)
+  {
+    tagLen = gaIcppParserCommandTags[xTag].tagLen;
 
-      default:
-      {
-        M_KTALOG__ERR("Unknown command xTag %u", xTag);
-        status = E_K_ICPP_PARSER_STATUS_PARAMETER;
-      }
-      break;
+    if (0u == tagLen)
+    {
+      M_KTALOG__ERR("Unknown command xTag %u", xTag);
     }
   }
   else if (E_ICPP_PARSER_TAG_TYPE_FIELD == xTagType)
   {
-    switch (xTag)
-    {
-      case E_K_ICPP_PARSER_FIELD_TAG_DEVPROFUID:
-      case E_K_ICPP_PARSER_FIELD_TAG_MUTABLE_DEVPROFUID:
-      case E_K_ICPP_PARSER_FIELD_TAG_CHIP_UID:
-      case E_K_ICPP_PARSER_FIELD_TAG_ROT_SOL_ID:
-      case E_K_ICPP_PARSER_FIELD_TAG_ROT_PUBLIC_UID:
-      case E_K_ICPP_PARSER_FIELD_TAG_ACK_SEQ_CNT:
-      case E_K_ICPP_PARSER_FLD_TAG_KTA_CAPABILITY:
-      case E_K_ICPP_PARSER_FIELD_TAG_KTA_CTX_PRO_UID:
-      case E_K_ICPP_PARSER_FLD_TAG_KTA_CTX_SERIAL_NO:
-      case E_K_ICPP_PRSR_FLD_TAG_KTA_CTX_VER:
-      case E_K_ICPP_PARSER_FIELD_TAG_KTA_VER:
-      case E_K_ICPP_PARSER_FIELD_TAG_DEV_SERIAL_NO:
-      case E_K_ICPP_PARSER_FLD_TAG_CMD_IDENTIFIER:
-      case E_K_ICPP_PARSER_FIELD_TAG_CMD_OBJECT_TYPE:
-      case E_K_ICPP_PARSER_FIELD_TAG_CMD_ATTRIBUTES:
-      case E_K_ICPP_PARSER_FIELD_TAG_CMD_ASSOCIATION_INFO:
-      case E_K_ICPP_PRSR_FLD_TAG_CMD_OBJECT_OWNER:
-      case E_K_ICPP_PARSER_FIELD_TAG_CMD_PROCESSING_STATUS:
-      case E_K_ICPP_PARSER_FIELD_TAG_CHALLENGE:
-      case E_K_ICPP_PARSER_FIELD_TAG_CMD_OBJECT_UID:
-      case E_K_ICPP_PARSER_FIELD_TAG_CMD_CUSTOMER_METADATA:
-#ifdef FOTA_ENABLE
-      case E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA:
-      case E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA_METADATA:
-      case E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA_COMPONENT_TARGET:
-      case E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA_COMPONENT_VERSION:
-      case E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA_ERROR_CODE:
-      case E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA_ERROR_CAUSE:
-#endif // FOTA_ENABLE
-      {
-        if (xpTagLen != NULL)
-        {
-          *xpTagLen = M_K_ICPP_PARSER_GET_1_BYTE_FIELD_LENGTH(xTag);
-        }
-      }
-      status = E_K_ICPP_PARSER_STATUS_OK;
-      break;
-
-      case E_K_ICPP_PARSER_FIELD_TAG_ROT_E_PK:
-      case E_K_ICPP_PARSER_FLD_TAG_CHIP_CERT:
-      case E_K_ICPP_PARSER_FLD_TAG_CHIP_ATTEST_CERT:
-      case E_K_ICPP_PARSER_FIELD_TAG_SIGNED_PUB_KEY:
-      case E_K_ICPP_PARSER_FIELD_TAG_KS_E_PK:
-      case E_K_ICPP_PARSER_FLD_TAG_CMD_PUBLIC_KEY:
-      case E_K_ICPP_PARSER_FLD_TAG_CMD_DATA:
-#ifdef FOTA_ENABLE
-      case E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA_COMPONENT_URL:
-#endif //FOTA_ENABLE
-      {
-        if (xpTagLen != NULL)
-        {
-          *xpTagLen = M_K_ICPP_PARSER_GET_2_BYTE_FIELD_LENGTH(xTag);
-        }
-      }
-      status = E_K_ICPP_PARSER_STATUS_OK;
-      break;
+    tagLen = gaIcppParserFieldTagLen[xTag];
 
-      default:
-      {
-        M_KTALOG__ERR("Unknown field xTag %u", xTag);
-        status = E_K_ICPP_PARSER_STATUS_PARAMETER;
-      }
-      break;
+    if (0u == tagLen)
+    {
+      M_KTALOG__ERR("Unknown field xTag %u", xTag);
     }
   }
   else
   {
     M_KTALOG__ERR("Unknown  xTagType %u", xTagType);
-    status = E_K_ICPP_PARSER_STATUS_PARAMETER;
+  }
+
+  if (0u != tagLen)
+  {
+    if (xpTagLen != NULL)
+    {
+      *xpTagLen = tagLen;
+    }
+
+    status = E_K_ICPP_PARSER_STATUS_OK;
   }
 
   return status;
@@ -811,6 +1044,43 @@ static void lIcppParserSetTagLength
   }
 }
 
+/**
+ * @implements lIcppParserReadCommandHeader
+ *
+ */
+static TKParserStatus lIcppParserReadCommandHeader
+(
+  const uint8_t*     xpData,
+  size_t             xDataLen,
+  TKIcppCommandTag*  xpCommandTag,
+  size_t*            xpHeaderLen,
+  uint32_t*          xpCommandLength
+)
+{
+  TKParserStatus  status = E_K_ICPP_PARSER_STATUS_ERROR;
+  uint32_t        tagLen = 0;
+
+  if (E_K_ICPP_PARSER_STATUS_OK != lIcppParserIsValidTag(E_ICPP_PARSER_TAG_TYPE_COMMAND,
+                                                          (uint32_t)xpData[0],
+                                                          &tagLen))
+  {
+    M_KTALOG__ERR("Invalid command tag %d", xpData[0]);
+  }
+  else if ((xDataLen - C_K_ICPP_PARSER_TAG_SIZE_IN_BYTES) < tagLen)
+  {
+    M_KTALOG__ERR("Error while parsing command length");
+  }
+  else
+  {
+    *xpCommandTag = (TKIcppCommandTag)xpData[0];
+    lIcppParserGetTagLength(&xpData[C_K_ICPP_PARSER_TAG_SIZE_IN_BYTES], tagLen, xpCommandLength);
+    *xpHeaderLen = C_K_ICPP_PARSER_TAG_SIZE_IN_BYTES + tagLen;
+    status = E_K_ICPP_PARSER_STATUS_OK;
+  }
+
+  return status;
+}
+
 /**
  * @implements lIcppParserDeserializeFields
  *
@@ -827,58 +1097,59 @@ static TKParserStatus lIcppParserDeserializeFields
   uint32_t        fieldsCount = 0;
   uint32_t        fieldLength = 0;
   uint32_t        tagLen = 0;
-  uint32_t        curPosition = 0;
-  uint32_t        cmdLength = 0;
-  TKIcppField*     pField = NULL;
+  size_t          curPosition = 0;
+  size_t          cmdLength = (size_t)xCommandLength;
+  TKIcppFieldTag  fieldTag = E_K_ICPP_PARSER_FIELD_TAG_DEVPROFUID;
+  TKIcppField*    pField = NULL;
 
-  cmdLength = (uint32_t)xCommandLength;
-  while (cmdLength > 0u)
+  while (curPosition < cmdLength)
   {
-    // REQ RQ_M-KTA-ICPP-CF-0050(1) : Max field Count
-    if (fieldsCount > C_K_ICPP_PARSER__MAX_FIELDS_COUNT)
-    {
-      M_KTALOG__ERR("Exceeded the max no of fields[%u] in command", fieldsCount);
-      status = E_K_ICPP_PARSER_STATUS_ERROR;
-      break;
-    }
-    pField = &xpFieldList->fields[fieldsCount];
-    pField->fieldTag = (TKIcppFieldTag)xpMessage[curPosition];
-
-    tagLen = 0;
+    fieldTag = (TKIcppFieldTag)xpMessage[curPosition];
 
     if (E_K_ICPP_PARSER_STATUS_OK != lIcppParserIsValidTag(E_ICPP_PARSER_TAG_TYPE_FIELD,
-                                                            (uint32_t)pField->fieldTag,
+                                                            (uint32_t)fieldTag,
                                                             &tagLen))
     {
-      M_KTALOG__ERR("Invalid Field Tag %d", pField->fieldTag);
+      M_KTALOG__ERR("Invalid Field Tag %d", fieldTag);
       status = E_K_ICPP_PARSER_STATUS_ERROR;
       break;
     }
 
     curPosition += C_K_ICPP_PARSER_TAG_SIZE_IN_BYTES;
-    if ( (curPosition+tagLen ) > (uint32_t)xCommandLength)
+
+    if ((cmdLength - curPosition) < tagLen)
     {
       M_KTALOG__ERR("Error while parsing taglen");
       status = E_K_ICPP_PARSER_STATUS_ERROR;
       break;
     }
-    lIcppParserGetTagLength(&xpMessage[curPosition], tagLen, &fieldLength);
-    M_KTALOG__DEBUG("Fields Count %u", fieldsCount);
 
+    lIcppParserGetTagLength(&xpMessage[curPosition], tagLen, &fieldLength);
     curPosition += tagLen;
-    pField->fieldLen = fieldLength;
-    if (curPosition+fieldLength > (uint32_t)xCommandLength)
+
+    if ((cmdLength - curPosition) < fieldLength)
     {
       M_KTALOG__ERR("Error while parsing field length");
       status = E_K_ICPP_PARSER_STATUS_ERROR;
       break;
-    }  
+    }
+
+    // REQ RQ_M-KTA-ICPP-CF-0050(1) : Max field Count
+    if (fieldsCount >= C_K_ICPP_PARSER__MAX_FIELDS_COUNT)
+    {
+      M_KTALOG__ERR("Exceeded the max no of fields[%u] in command", fieldsCount);
+      status = E_K_ICPP_PARSER_STATUS_ERROR;
+      break;
+    }
+
+    pField = &xpFieldList->fields[fieldsCount];
+    pField->fieldTag = fieldTag;
+    pField->fieldLen = fieldLength;
     /* To fix the misra-c2012-11.4-A conversion should not be performed between a pointer to object and an integer type*/
     /* Storing the received data pointer to the field value. */
-	  pField->fieldValue = (uint8_t*)&xpMessage[curPosition];
+    pField->fieldValue = (uint8_t*)&xpMessage[curPosition];
 
     curPosition += fieldLength;
-    cmdLength -= (uint32_t)(fieldLength + C_K_ICPP_PARSER_TAG_SIZE_IN_BYTES + tagLen);
     ++fieldsCount;
     M_KTALOG__DEBUG("Fields Count %u", fieldsCount);
   }
@@ -891,10 +1162,6 @@ static TKParserStatus lIcppParserDeserializeFields
  * @implements lIcppParserDeserializeCommands
  *
  */
-/**
- * Suppression: misra-c2012-15.4 and misra-c2012-15.1
- * Using goto for breaking during the error and return cases.
- **/
 static TKParserStatus lIcppParserDeserializeCommands
 (
   const uint8_t*          xpReceivedMessage,
@@ -903,61 +1170,57 @@ static TKParserStatus lIcppParserDeserializeCommands
 )
 {
   /* status initialized to E_K_ICPP_PARSER_STATUS_OK for code size optimization */
-  TKParserStatus  status = E_K_ICPP_PARSER_STATUS_OK;
-  TKIcppCommand*   pCommand = NULL;
-  uint32_t        tagLen = 0;
-  uint32_t        commandsCount = 0;
-  uint32_t        commandLength = 0;
-  uint32_t        curPosition = 0;
+  TKParserStatus    status = E_K_ICPP_PARSER_STATUS_OK;
+  TKIcppCommandTag  commandTag = E_K_ICPP_PARSER_COMMAND_TAG_ACTIVATION;
+  TKIcppCommand*    pCommand = NULL;
+  size_t            headerLen = 0;
+  uint32_t          commandLength = 0;
+  uint32_t          commandsCount = 0;
+  size_t            curPosition = 0;
 
   while (curPosition < xReceivedMessageSize)
   {
-    // REQ RQ_M-KTA-ICPP-CF-0020(1) : Max command Count
-    if (commandsCount > C_K_ICPP_PARSER__MAX_COMMANDS_COUNT)
-    {
-      M_KTALOG__ERR("Exceeded the max no of commands %u", commandsCount);
-      status = E_K_ICPP_PARSER_STATUS_ERROR;
-      goto end;
-    }
-    /* Updating the command tag and length. */
-    pCommand = &xpIcppMessage->commands[commandsCount];
-    pCommand->commandTag = (TKIcppCommandTag)xpReceivedMessage[curPosition];
+    status = lIcppParserReadCommandHeader(&xpReceivedMessage[curPosition],
+                                          xReceivedMessageSize - curPosition,
+                                          &commandTag,
+                                          &headerLen,
+                                          &commandLength);
 
-    if (E_K_ICPP_PARSER_STATUS_OK != lIcppParserIsValidTag(E_ICPP_PARSER_TAG_TYPE_COMMAND,
-                                                            (uint32_t)pCommand->commandTag,
-                                                            &tagLen))
+    if (E_K_ICPP_PARSER_STATUS_OK != status)
     {
-      M_KTALOG__ERR("Invalid command tag %d", pCommand->commandTag);
-      status = E_K_ICPP_PARSER_STATUS_ERROR;
-      goto end;
+      break;
     }
 
-    curPosition += C_K_ICPP_PARSER_TAG_SIZE_IN_BYTES;
-    if ((xReceivedMessageSize - curPosition) < tagLen)
+    curPosition += headerLen;
+
+    if ((xReceivedMessageSize - curPosition) < commandLength)
     {
-      M_KTALOG__ERR("Error while parsing xReceivedMessageSize");
+      M_KTALOG__ERR("Command length %u exceeds the remaining data", commandLength);
       status = E_K_ICPP_PARSER_STATUS_ERROR;
-      goto end;
+      break;
     }
-    lIcppParserGetTagLength(&xpReceivedMessage[curPosition], tagLen, &commandLength);
-    curPosition += tagLen;
-    if ((xReceivedMessageSize - curPosition) < commandLength)
+
+    if ((0U == commandLength) && (E_K_ICPP_PARSER_CMD_TAG_GET_CHALLENGE != commandTag))
     {
-      M_KTALOG__ERR("Error while parsing xReceivedMessageSize");
+      M_KTALOG__ERR("Invalid command len %d", commandLength);
       status = E_K_ICPP_PARSER_STATUS_ERROR;
-      goto end;
+      break;
     }
 
-    if ((0U == commandLength) && (E_K_ICPP_PARSER_CMD_TAG_GET_CHALLENGE != pCommand->commandTag))
+    // REQ RQ_M-KTA-ICPP-CF-0020(1) : Max command Count
+    if (commandsCount >= C_K_ICPP_PARSER__MAX_COMMANDS_COUNT)
     {
-      M_KTALOG__ERR("Invalid command len %d", commandLength);
+      M_KTALOG__ERR("Exceeded the max no of commands %u", commandsCount);
       status = E_K_ICPP_PARSER_STATUS_ERROR;
-      goto end;
+      break;
     }
 
-    if ((int)M_K_ICPP_PARSER__COMMAND_TAG_HAS_FIELDS(pCommand->commandTag) != 0)
+    pCommand = &xpIcppMessage->commands[commandsCount];
+    pCommand->commandTag = commandTag;
+
+    if (M_ICPP_PARSER_COMMAND_TAG_HAS_FIELDS(commandTag))
     {
-      M_KTALOG__INFO("Command Tag[%x] Len[%d]\r\n", pCommand->commandTag, commandLength);
+      M_KTALOG__INFO("Command Tag[%x] Len[%d]\r\n", commandTag, (int)commandLength);
       /* Deserialize Fields. */
       // REQ RQ_M-KTA-ICPP-FN-0160(1) : Deserialize Fileds in Commands
       status = lIcppParserDeserializeFields(&xpReceivedMessage[curPosition],
@@ -967,7 +1230,7 @@ static TKParserStatus lIcppParserDeserializeCommands
       if (status != E_K_ICPP_PARSER_STATUS_OK)
       {
         M_KTALOG__ERR("De-serialization of fields got Failed %d", status);
-        goto end;
+        break;
       }
     }
     else
@@ -977,15 +1240,16 @@ static TKParserStatus lIcppParserDeserializeCommands
        * So that we can save 2 bytes.
        */
       pCommand->data.cmdInfo.cmdLen = commandLength;
+      /* Storing the received data pointer to the command value. */
       pCommand->data.cmdInfo.cmdValue = (uint8_t*)&xpReceivedMessage[curPosition];
     }
 
     // REQ RQ_M-KTA-ICPP-FN-0190(1) : Command processing error
-    if (pCommand->commandTag == E_K_ICPP_PARSER_COMMAND_TAG_CMD_PROCESSING_ERROR)
+    if (E_K_ICPP_PARSER_COMMAND_TAG_CMD_PROCESSING_ERROR == commandTag)
     {
       M_KTALOG__WARN("Received E_K_ICPP_PARSER_COMMAND_TAG_CMD_PROCESSING_ERROR");
       status = E_K_ICPP_PARSER_STATUS_NOTIFICATION_CPERROR;
-      goto end;
+      break;
     }
 
     curPosition += commandLength;
@@ -993,13 +1257,12 @@ static TKParserStatus lIcppParserDeserializeCommands
     M_KTALOG__DEBUG("Commands Count %d", commandsCount);
   }
 
-end:
   xpIcppMessage->commandsCount = commandsCount;
   return status;
 }
 
 /**
- * @implements lIcppParserSerializeFields
+ * @implements lIcppParserGetCommandSize
  *
  */
 /**
@@ -1007,216 +1270,254 @@ end:
  * SUPPRESS: MISRA_DEV_KTA_004 : misra_c2012_rule_15.1_violation
  * Using goto for breaking during the error and return cases.
  **/
-static TKParserStatus lIcppParserSerializeFields
+static TKParserStatus lIcppParserGetCommandSize
 (
-  const TKIcppFieldList*  xpFieldList,
-  uint8_t*                xpMessageField,
-  uint32_t*               xpMessageFieldSize
+  const TKIcppCommand*  xpCommand,
+  uint32_t*             xpTagLen,
+  size_t*               xpValueLen
 )
 {
-  /* status initialized to E_K_ICPP_PARSER_STATUS_OK for code size optimization */
-  TKParserStatus        status = E_K_ICPP_PARSER_STATUS_OK;
-  const TKIcppField*     pField = NULL;
-  uint32_t              fieldLoop = 0;
-  uint32_t              tagLen = 0;
-  uint32_t              curPosition = 0;
-  size_t                bufferSize = 0;
-
- /* Check the max field limit. */
-  if ((C_K_ICPP_PARSER__MAX_FIELDS_COUNT < xpFieldList->fieldsCount) ||
-      (0u == xpFieldList->fieldsCount))
+  TKParserStatus      status = E_K_ICPP_PARSER_STATUS_ERROR;
+  const TKIcppField*  pField = NULL;
+  uint32_t            fieldTagLen = 0;
+  size_t              valueLen = 0;
+  size_t              fieldLoop = 0;
+
+  // REQ RQ_M-KTA-ICPP-FN-0030(1) : Check Commands in message
+  if (E_K_ICPP_PARSER_STATUS_OK != lIcppParserIsValidTag(E_ICPP_PARSER_TAG_TYPE_COMMAND,
+                                                          (uint32_t)xpCommand->commandTag,
+                                                          xpTagLen))
   {
-    M_KTALOG__ERR("Invalid Parameter");
-    status = E_K_ICPP_PARSER_STATUS_PARAMETER;
+    M_KTALOG__ERR("Invalid Command Tag %d", xpCommand->commandTag);
+    goto end;
   }
-  else
+
+  if (M_ICPP_PARSER_COMMAND_TAG_HAS_FIELDS(xpCommand->commandTag))
   {
-    bufferSize = *xpMessageFieldSize;
+    /* Check the max field limit. */
+    if ((C_K_ICPP_PARSER__MAX_FIELDS_COUNT < xpCommand->data.fieldList.fieldsCount) ||
+        (0u == xpCommand->data.fieldList.fieldsCount))
+    {
+      M_KTALOG__ERR("Invalid field count %ld", xpCommand->data.fieldList.fieldsCount);
+      goto end;
+    }
 
-    /* Adding the fields data to the buffer. */
-    for (fieldLoop = 0; fieldLoop < xpFieldList->fieldsCount; fieldLoop++)
+    for (fieldLoop = 0; fieldLoop < xpCommand->data.fieldList.fieldsCount; fieldLoop++)
     {
-      pField = &xpFieldList->fields[fieldLoop];
+      pField = &xpCommand->data.fieldList.fields[fieldLoop];
 
       if (E_K_ICPP_PARSER_STATUS_OK != lIcppParserIsValidTag(E_ICPP_PARSER_TAG_TYPE_FIELD,
-                                                             (uint32_t)pField->fieldTag,
-                                                             &tagLen))
+                                                              (uint32_t)pField->fieldTag,
+                                                              &fieldTagLen))
       {
         M_KTALOG__ERR("Invalid Field Tag %d", pField->fieldTag);
-        status = E_K_ICPP_PARSER_STATUS_ERROR;
         goto end;
       }
 
-      if (0u == pField->fieldLen)
+      if ((0u == pField->fieldLen) ||
+          ((pField->fieldLen >> (fieldTagLen * C_K_ICPP_PARSER_NO_OF_BITS_IN_BYTE)) != 0u))
       {
         M_KTALOG__ERR("Invalid field length %ld", pField->fieldLen);
-        status = E_K_ICPP_PARSER_STATUS_ERROR;
         goto end;
       }
 
-      if (bufferSize < (tagLen + C_K_ICPP_PARSER_TAG_SIZE_IN_BYTES))
-      {
-        M_KTALOG__ERR("Size is less than required field %d", bufferSize);
-        status = E_K_ICPP_PARSER_STATUS_ERROR;
-        goto end;
-      }
-
-      bufferSize -= tagLen + C_K_ICPP_PARSER_TAG_SIZE_IN_BYTES;
-
-      xpMessageField[curPosition] = (uint8_t)pField->fieldTag;
-      curPosition += C_K_ICPP_PARSER_TAG_SIZE_IN_BYTES;
-      /* Set the field length. */
-      lIcppParserSetTagLength(&xpMessageField[curPosition], tagLen, pField->fieldLen);
-      curPosition += tagLen;
-
-      if (bufferSize < pField->fieldLen)
-      {
-        M_KTALOG__ERR("Size is less than required field len %d", bufferSize);
-        status = E_K_ICPP_PARSER_STATUS_ERROR;
-        goto end;
-      }
+      valueLen += C_K_ICPP_PARSER_TAG_SIZE_IN_BYTES + fieldTagLen + pField->fieldLen;
+    }
+  }
+  else
+  {
+    if (0u == xpCommand->data.cmdInfo.cmdLen)
+    {
+      M_KTALOG__ERR("Invalid command length %ld", xpCommand->data.cmdInfo.cmdLen);
+      goto end;
+    }
 
-      bufferSize -= pField->fieldLen;
+    valueLen = xpCommand->data.cmdInfo.cmdLen;
+  }
 
-      /* Copy the field data. */
-      (void)memcpy(&xpMessageField[curPosition], pField->fieldValue, pField->fieldLen);
-      curPosition += pField->fieldLen;
-    }
+  if ((valueLen >> (*xpTagLen * C_K_ICPP_PARSER_NO_OF_BITS_IN_BYTE)) != 0u)
+  {
+    M_KTALOG__ERR("Command length %ld does not fit in %u bytes", valueLen, *xpTagLen);
+    goto end;
   }
 
+  *xpValueLen = valueLen;
+  status = E_K_ICPP_PARSER_STATUS_OK;
+
 end:
-  *xpMessageFieldSize = curPosition;
   return status;
 }
 
 /**
- * @implements lIcppParserSerializeCommands
+ * @implements lIcppParserWriteTagLength
  *
  */
+static TKParserStatus lIcppParserWriteTagLength
+(
+  TKIcppWriteBuffer*  xpBuffer,
+  uint32_t            xTag,
+  uint32_t            xTagLen,
+  size_t              xValueLen
+)
+{
+  uint8_t  aTagLength[C_K_ICPP_PARSER_MAX_TAG_LENGTH_SIZE];
+
+  aTagLength[0] = (uint8_t)xTag;
+  /* Set the command or field length. */
+  lIcppParserSetTagLength(&aTagLength[C_K_ICPP_PARSER_TAG_SIZE_IN_BYTES],
+                          xTagLen,
+                          (uint32_t)xValueLen);
+
+  return lIcppParserWrite(xpBuffer, aTagLength, C_K_ICPP_PARSER_TAG_SIZE_IN_BYTES + xTagLen);
+}
+
 /**
- * Suppression: misra-c2012-15.4 and misra-c2012-15.1
- * Using goto for breaking during the error and return cases.
- **/
+ * @implements lIcppParserSerializeCommands
+ *
+ */
 static TKParserStatus lIcppParserSerializeCommands
 (
   const TKIcppProtocolMessage*  xpIcppMessage,
-  uint8_t*                      xpMessageCommand,
-  size_t*                      xpMessageCommandSize
+  TKIcppWriteBuffer*            xpBuffer
 )
 {
-  /* status initialized to E_K_ICPP_PARSER_STATUS_OK for code size optimization */
   TKParserStatus        status = E_K_ICPP_PARSER_STATUS_OK;
-  size_t                bufferSize = 0;
+  const TKIcppCommand*  pCommand = NULL;
+  const TKIcppField*    pField = NULL;
   uint32_t              tagLen = 0;
-  uint32_t              curPosition = 0;
-  uint8_t*               pCmdLengthOffset = NULL;
-  uint32_t              commandsLength = 0;
-  const TKIcppCommand*   pCommand = NULL;
-
-  if (C_K_ICPP_PARSER__MAX_COMMANDS_COUNT < xpIcppMessage->commandsCount)
+  uint32_t              fieldTagLen = 0;
+  size_t                valueLen = 0;
+  size_t                commandLoop = 0;
+  size_t                fieldLoop = 0;
+
+  /* Adding commands data to the buffer. */
+  for (commandLoop = 0; (commandLoop < xpIcppMessage->commandsCount) &&
+       (E_K_ICPP_PARSER_STATUS_OK == status); commandLoop++)
   {
-    M_KTALOG__ERR("Invalid parameters");
-    status = E_K_ICPP_PARSER_STATUS_PARAMETER;
-  }
-  else
-  {
-    bufferSize = *xpMessageCommandSize;
+    pCommand = &xpIcppMessage->commands[commandLoop];
+    status = lIcppParserGetCommandSize(pCommand, &tagLen, &valueLen);
 
-    /* Adding commands data to the buffer. */
-    for (uint32_t commandLoop = 0; commandLoop < xpIcppMessage->commandsCount; commandLoop++)
+    if (E_K_ICPP_PARSER_STATUS_OK == status)
     {
-      pCommand = &xpIcppMessage->commands[commandLoop];
+      status = lIcppParserWriteTagLength(xpBuffer, (uint32_t)pCommand->commandTag, tagLen, valueLen);
+    }
 
-      // REQ RQ_M-KTA-ICPP-FN-0030(1) : Check Commands in message
-      if (E_K_ICPP_PARSER_STATUS_OK != lIcppParserIsValidTag(E_ICPP_PARSER_TAG_TYPE_COMMAND,
-                                                             (uint32_t)pCommand->commandTag,
-                                                             &tagLen))
-      {
-        M_KTALOG__ERR("Invalid Command Tag %d", pCommand->commandTag);
-        status = E_K_ICPP_PARSER_STATUS_ERROR;
-        goto end;
-      }
+    if (E_K_ICPP_PARSER_STATUS_OK != status)
+    {
+      break;
+    }
 
-      if (bufferSize < (tagLen + C_K_ICPP_PARSER_TAG_SIZE_IN_BYTES))
+    if (M_ICPP_PARSER_COMMAND_TAG_HAS_FIELDS(pCommand->commandTag))
+    {
+      /* Adding the fields data to the buffer. */
+      // REQ RQ_M-KTA-ICPP-FN-0060(1) : Serialize Fileds in Commands
+      for (fieldLoop = 0; (fieldLoop < pCommand->data.fieldList.fieldsCount) &&
+           (E_K_ICPP_PARSER_STATUS_OK == status); fieldLoop++)
       {
-        M_KTALOG__ERR("Size is less than required command %d", bufferSize);
-        status = E_K_ICPP_PARSER_STATUS_ERROR;
-        goto end;
+        pField = &pCommand->data.fieldList.fields[fieldLoop];
+        (void)lIcppParserIsValidTag(E_ICPP_PARSER_TAG_TYPE_FIELD,
+                                    (uint32_t)pField->fieldTag,
+                                    &fieldTagLen);
+        status = lIcppParserWriteTagLength(xpBuffer,
+                                           (uint32_t)pField->fieldTag,
+                                           fieldTagLen,
+                                           pField->fieldLen);
+
+        if (E_K_ICPP_PARSER_STATUS_OK == status)
+        {
+          status = lIcppParserWrite(xpBuffer, pField->fieldValue, pField->fieldLen);
+        }
       }
-
-      bufferSize -= tagLen + C_K_ICPP_PARSER_TAG_SIZE_IN_BYTES;
-      xpMessageCommand[curPosition] = (uint8_t)pCommand->commandTag;
+    }
+    else
+    {
       /**
-       * Reserved for command length. Storing the command length address in pointer.
-       * Will update the length later.
+       * Some command has the data directly instead of field tag and length
+       * So that we can save 2 bytes.
        */
-      pCmdLengthOffset = &xpMessageCommand[curPosition + C_K_ICPP_PARSER_TAG_SIZE_IN_BYTES];
-      curPosition += tagLen + C_K_ICPP_PARSER_TAG_SIZE_IN_BYTES;
-      if ((int)M_K_ICPP_PARSER__COMMAND_TAG_HAS_FIELDS(pCommand->commandTag) != 0)
-      {
-        /* Check the max field limit. */
-        if (
-          (C_K_ICPP_PARSER__MAX_FIELDS_COUNT < pCommand->data.fieldList.fieldsCount) ||
-          (0u == pCommand->data.fieldList.fieldsCount)
-        )
-        {
-          M_KTALOG__ERR("Invalid field count %ld", pCommand->data.fieldList.fieldsCount);
-          status = E_K_ICPP_PARSER_STATUS_ERROR;
-          goto end;
-        }
+      status = lIcppParserWrite(xpBuffer,
+                                pCommand->data.cmdInfo.cmdValue,
+                                pCommand->data.cmdInfo.cmdLen);
+      M_KTALOG__DEBUG("Command without fields %u #%u", pCommand->commandTag, commandLoop);
+    }
+  }
 
-        commandsLength = bufferSize;
-        /* Adding the fields data to the buffer. */
-        // REQ RQ_M-KTA-ICPP-FN-0060(1) : Serialize Fileds in Commands
-        status = lIcppParserSerializeFields(&pCommand->data.fieldList,
-                                            &xpMessageCommand[curPosition],
-                                            &commandsLength);
+  return status;
+}
 
-        if (E_K_ICPP_PARSER_STATUS_OK != status)
-        {
-          M_KTALOG__ERR("Serialization of fields got Failed %d", status);
-          goto end;
-        }
+/**
+ * @implements lIcppParserGetPayloadSize
+ *
+ */
+static TKParserStatus lIcppParserGetPayloadSize
+(
+  const TKIcppProtocolMessage*  xpIcppMessage,
+  size_t*                       xpPayloadSize
+)
+{
+  TKParserStatus  status = E_K_ICPP_PARSER_STATUS_OK;
+  uint32_t        tagLen = 0;
+  size_t          valueLen = 0;
+  size_t          payloadSize = 0;
+  size_t          commandLoop = 0;
 
-        bufferSize -= commandsLength;
-        curPosition += commandsLength;
-      }
-      else
-      {
-        if (0u == pCommand->data.cmdInfo.cmdLen)
-        {
-          M_KTALOG__ERR("Invalid command length %ld", pCommand->data.cmdInfo.cmdLen);
-          status = E_K_ICPP_PARSER_STATUS_ERROR;
-          goto end;
-        }
+  if ((NULL == xpIcppMessage) ||
+      (E_K_ICPP_PARSER_MSG_TYPE_RESERVED <= (uint32_t)xpIcppMessage->msgType) ||
+      (C_K_ICPP_PARSER__MAX_COMMANDS_COUNT < xpIcppMessage->commandsCount))
+  {
+    M_KTALOG__ERR("Invalid parameters");
+    status = E_K_ICPP_PARSER_STATUS_PARAMETER;
+  }
+  else
+  {
+    for (commandLoop = 0; (commandLoop < xpIcppMessage->commandsCount) &&
+         (E_K_ICPP_PARSER_STATUS_OK == status); commandLoop++)
+    {
+      status = lIcppParserGetCommandSize(&xpIcppMessage->commands[commandLoop],
+                                         &tagLen,
+                                         &valueLen);
+      payloadSize += C_K_ICPP_PARSER_TAG_SIZE_IN_BYTES + tagLen + valueLen;
+    }
 
-        /**
-         * Some command has the data directly instead of field tag and length
-         * So that we can save 2 bytes.
-         */
-        if (bufferSize < pCommand->data.cmdInfo.cmdLen)
-        {
-          M_KTALOG__ERR("Size is less than required command len %d", bufferSize);
-          status = E_K_ICPP_PARSER_STATUS_ERROR;
-          goto end;
-        }
+    /* The header length also counts the MAC appended after the payload. */
+    if ((E_K_ICPP_PARSER_STATUS_OK == status) &&
+        (((payloadSize + C_K_ICPP_PARSER_HMACSHA256_SIZE) >>
+          (C_K_ICPP_PARSER_LENGTH_SIZE_IN_HEADER * C_K_ICPP_PARSER_NO_OF_BITS_IN_BYTE)) != 0u))
+    {
+      M_KTALOG__ERR("Message length %ld does not fit in the header", payloadSize);
+      status = E_K_ICPP_PARSER_STATUS_ERROR;
+    }
 
-        bufferSize -= pCommand->data.cmdInfo.cmdLen;
-        (void)memcpy(&xpMessageCommand[curPosition],
-                     pCommand->data.cmdInfo.cmdValue,
-                     pCommand->data.cmdInfo.cmdLen);
-        curPosition += pCommand->data.cmdInfo.cmdLen;
-        commandsLength = pCommand->data.cmdInfo.cmdLen;
-        M_KTALOG__DEBUG("Command without fields %u #%u", pCommand->commandTag, commandLoop);
-      }
+    *xpPayloadSize = payloadSize;
+  }
 
-      /* Update the command length. */
-      lIcppParserSetTagLength(pCmdLengthOffset, tagLen, commandsLength);
-    }
+  return status;
+}
+
+/**
+ * @implements lIcppParserWrite
+ *
+ */
+static TKParserStatus lIcppParserWrite
+(
+  TKIcppWriteBuffer*  xpBuffer,
+  const uint8_t*      xpData,
+  size_t              xDataLen
+)
+{
+  TKParserStatus  status = E_K_ICPP_PARSER_STATUS_ERROR;
+
+  if ((xpBuffer->bufferSize - xpBuffer->position) < xDataLen)
+  {
+    M_KTALOG__ERR("Size is less than required %d", (int)xDataLen);
+  }
+  else
+  {
+    (void)memcpy(&xpBuffer->pBuffer[xpBuffer->position], xpData, xDataLen);
+    xpBuffer->position += xDataLen;
+    status = E_K_ICPP_PARSER_STATUS_OK;
   }
 
-end:
-  *xpMessageCommandSize = curPosition;
   return status;
 }
 
@@ -508,6 +508,32 @@ TKParserStatus ktaIcppParserSerializeMessage
   size_t*                      xpMessageToSendSize
 );
 
+/**
+ * @brief
+ *   Serialize the commands of the ICPP message, without header.
+ *   Used to append the responses of a message processed one command at a time.
+ *
+ * @param[in] xpIcppMessage
+ *   Structure contains non serialized ICPP commands.
+ * @param[in,out] xpCommands
+ *   [in] Pointer to buffer to carry serialized commands.
+ *   [out] Actual serialized commands.
+ * @param[in,out] xpCommandsSize
+ *   [in] Pointer to buffer to carry serialized commands length.
+ *   [out] Actual serialized commands length.
+ *
+ * @return
+ * - E_K_ICPP_PARSER_STATUS_OK in case of success.
+ * - E_K_ICPP_PARSER_STATUS_PARAMETER for wrong input parameter.
+ * - E_K_ICPP_PARSER_STATUS_ERROR for other errors.
+ */
+TKParserStatus ktaIcppParserSerializeCommands
+(
+  const TKIcppProtocolMessage*  xpIcppMessage,
+  uint8_t*                      xpCommands,
+  size_t*                       xpCommandsSize
+);
+
 /**
  * @brief
  *   Deserialize the ICPP message.
@@ -556,6 +582,56 @@ TKParserStatus ktaIcppParserDeserializeHeader
   TKIcppProtocolMessage*  xpIcppMessage
 );
 
+/**
+ * @brief
+ *   Deserialize the ICPP commands following the header.
+ *   Unlike ktaIcppParserDeserializeMessage, no header check is done and nothing is stored,
+ *   so that it can be used on messages built by the keySTREAM Trusted Agent itself.
+ *
+ * @param[in] xpPayload
+ *   ICPP commands, located right after the ICPP header.
+ * @param[in] xPayloadSize
+ *   Size of xpPayload, in bytes.
+ * @param[in,out] xpIcppMessage
+ *   [in] Pointer to buffer to carry deserialized commands.
+ *   [out] Actual deserialized commands, pointing into xpPayload.
+ *
+ * @return
+ * - E_K_ICPP_PARSER_STATUS_OK in case of success.
+ * - E_K_ICPP_PARSER_STATUS_PARAMETER for wrong input parameter.
+ * - E_K_ICPP_PARSER_STATUS_ERROR for other errors.
+ */
+TKParserStatus ktaIcppParserDeserializeCommands
+(
+  const uint8_t*          xpPayload,
+  const size_t            xPayloadSize,
+  TKIcppProtocolMessage*  xpIcppMessage
+);
+
+/**
+ * @brief
+ *   Get the serialized size of the command starting xpData, from its tag and length only.
+ *   Lets a command be located before its value is available, e.g. still encrypted.
+ *
+ * @param[in] xpData
+ *   Command tag and length.
+ * @param[in] xDataLen
+ *   Length of xpData, in bytes. Three bytes are always enough.
+ * @param[out] xpCommandSize
+ *   Size of the command: tag, length and value.
+ *
+ * @return
+ * - E_K_ICPP_PARSER_STATUS_OK in case of success.
+ * - E_K_ICPP_PARSER_STATUS_PARAMETER for wrong input parameter.
+ * - E_K_ICPP_PARSER_STATUS_ERROR for an invalid tag or a truncated length.
+ */
+TKParserStatus ktaIcppParserGetCommandSize
+(
+  const uint8_t*  xpData,
+  size_t          xDataLen,
+  size_t*         xpCommandSize
+);
+
 /**
  * @brief
  *   Update ICPP header length by substracting the existing length with the given value.
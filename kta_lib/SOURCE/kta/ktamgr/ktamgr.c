@@ -54,6 +54,7 @@
 #include "k_sal_crypto.h"
 #include "cryptoConfig.h"
 #include "KTALog.h"
+#include "KTABench.h"
 
 #ifdef FOTA_ENABLE
 #include "k_sal_fota.h"
@@ -115,17 +116,39 @@ static const uint8_t gaKtaLifeCycleNVMVData[C_KTA_CONFIG__LIFE_CYCLE_MAX_STATE]
   /* INVALID */
 };
 
+/** @brief keySTREAM Trusted Agent context, holds the state of one device. */
+struct TKtaContext
+{
+  uint32_t              index;
+  /* Context index, also selects the configuration and SAL instances. */
+  uint8_t               isUsed;
+  /* Set while the context is allocated. */
+  TKtaState             ktaState;
+  /* keySTREAM Trusted Agent state. */
+  TKtaLifeCycleState    lifeCycleState;
+  /* Life cycle state of the device. */
+  uint8_t               aKtaVersion[C_K__VERSION_STORAGE_LENGTH];
+  /* keySTREAM Trusted Agent version stored in the device. */
+  uint8_t               isPreActivated;
+  /* Set once the activation response has been processed. */
+  TKktaKeyStreamStatus  commandStatus;
+  /* Last command status received from keySTREAM. */
+};
+
 /* -------------------------------------------------------------------------- */
 /* LOCAL VARIABLES                                                            */
 /* -------------------------------------------------------------------------- */
 /* Module name used for logging */
 static const char* gpModuleName = "KTAMGR";
 
-static TKtaState gKtaState                              = E_KTA_STATE_INITIAL;
-static TKtaLifeCycleState gKtaLifeCycleState            = E_LIFE_CYCLE_STATE_INIT;
-static uint8_t gaKtaVersion[C_K__VERSION_STORAGE_LENGTH] = {0};
-static uint8_t  gKtaIsPreActivated                      = 0u;
-static TKktaKeyStreamStatus gCommandStatus              = E_K_KTA_KS_STATUS_NONE;
+/* Pool of keySTREAM Trusted Agent contexts, index 0 is the default context. */
+static TKtaContext gaKtaContextPool[C_KTA_APP__MAX_CONTEXTS] =
+{
+  {0u, 1u, E_KTA_STATE_INITIAL, E_LIFE_CYCLE_STATE_INIT, {0}, 0u, E_K_KTA_KS_STATUS_NONE}
+};
+
+/* Context selected by the calling thread. */
+static C_KTA_APP__THREAD_LOCAL TKtaContext* gpKtaContext = &gaKtaContextPool[0];
 
 /* -------------------------------------------------------------------------- */
 /* LOCAL FUNCTIONS - PROTOTYPE                                                */
@@ -148,6 +171,22 @@ static TKStatus lgetNVMLifeCycleState
   size_t*  xpLifeCycleStateLen
 );
 
+/**
+ * @brief
+ *   Bring the context back to the stored state after the storage batch of an exchange
+ *   could not be committed: the life cycle state is read again and, if the device is
+ *   not activated in storage, the keys derived since are dropped and the activation
+ *   starts over.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_ERROR for other errors.
+ */
+static TKStatus lRollbackContext
+(
+  void
+);
+
 /**
  * @brief
  *   Prepare processing status message.
@@ -265,6 +304,9 @@ static TKStatus lPrepareNoOpNotificationRequest
  * @param[in,out] parserStatus
  *   [in]  parser status which should be filled in this method
  *   [out] Parser status
+ * @param[out] xpSegmentedMsg
+ *   Filled if the commands do not fit xpClearMsg once decrypted; pEncryptedData is
+ *   then not NULL and only the header is deserialized in xpRecvdProtoMessage.
  *
  * @return
  * - E_K_STATUS_OK in case of success.
@@ -280,7 +322,8 @@ static TKStatus lCheckKs2KtaMessage
   uint8_t*                xpClearMsg,
   size_t                  xClearMsgLen,
   TKIcppProtocolMessage*  xpRecvdProtoMessage,
-  TKParserStatus*         xpParserStatus
+  TKParserStatus*         xpParserStatus,
+  TKCmdSegmentedMsg*      xpSegmentedMsg
 );
 
 /* -------------------------------------------------------------------------- */
@@ -303,9 +346,9 @@ TKStatus ktaInitialize
 
   M_KTALOG__START("Start");
 
-  if (E_KTA_STATE_INITIAL == gKtaState)
+  if (E_KTA_STATE_INITIAL == gpKtaContext->ktaState)
   {
-    gKtaState = E_KTA_STATE_INITIALIZED;
+    gpKtaContext->ktaState = E_KTA_STATE_INITIALIZED;
     M_KTALOG__DEBUG("KTA initialization SUCCESS!!!");
     status = E_K_STATUS_OK;
   }
@@ -338,8 +381,10 @@ TKStatus ktaStartup
   // REQ RQ_M-KTA-LCST-FN-0010(1) : Life Cycle State Size
   size_t  lifeCycleStateLen = C_KTA_CONFIG__LIFE_CYCLE_EACH_STATE_SIZE;
   size_t  ktaVersionLen = C_K__VERSION_STORAGE_LENGTH;
+  uint8_t isWarmStarted = 0u;
 
   M_KTALOG__START("Start");
+  M_KTABENCH__START(E_KTABENCH_PHASE_STARTUP);
 
   /* MISRA Rule 2.1 for loop increment is unreachable, loop will execute only once. Other codes follow the same. */
   // REQ RQ_M-KTA-STRT-FN-0008(1) : Input Parameters Check
@@ -360,19 +405,20 @@ TKStatus ktaStartup
   else
   {
     // REQ RQ_M-KTA-STRT-FN-0002(1) : Check KTA State
-    if (E_KTA_STATE_INITIALIZED == gKtaState)
+    if (E_KTA_STATE_INITIALIZED == gpKtaContext->ktaState)
     {
       M_KTALOG__DEBUG("Reading life cycle state from NVM...");
       // REQ RQ_M-KTA-LCST-FN-0020(1) : Power off in INIT|INITIALIZED state
       // REQ RQ_M-KTA-LCST-FN-0025(1) : Power off in INIT|STARTED state
       status = lgetNVMLifeCycleState(&lifeCycleStateLen);
-      status = salStorageGetValue(C_K_KTA__VERSION_SLOT_ID, gaKtaVersion, &ktaVersionLen);
+      status = salStorageGetValue(C_K_KTA__VERSION_SLOT_ID, gpKtaContext->aKtaVersion, &ktaVersionLen);
       if (E_K_STATUS_OK != status)
       {
         M_KTALOG__DEBUG("Reading KTA Version failed with status:%d.\r\n", status);
         goto end;
       }
-      M_KTALOG__DEBUG("KTA Version in device is: %s\r\n", ktaGetDecodedVersionStr(gaKtaVersion));
+      M_KTALOG__DEBUG("KTA Version in device is: %s\r\n",
+                      ktaGetDecodedVersionStr(gpKtaContext->aKtaVersion));
 
       if ((E_K_STATUS_OK != status) || (0U == lifeCycleStateLen))
       {
@@ -380,44 +426,77 @@ TKStatus ktaStartup
         goto end;
       }
 
-      M_KTALOG__DEBUG("Setting kta context configuration data to the platform");
-      // REQ RQ_M-KTA-STRT-FN-0050(1) : Set Context Information
-      // REQ RQ_M-KTA-STRT-FN-0060(1) : Set L1 Segmentaion Seed
-      status = ktaSetContextInfoConfig(xpL1SegSeed, xpKtaContextProfileUid,
-                                      xKtaContextProfileUidLen, xpKtaContexSerialNumber,
-                                      xKtaContexSerialNumberLen, xpKtaContextVersion,
-                                      xKtaContextVersionLen, gKtaLifeCycleState);
-
-      if (E_K_STATUS_OK != status)
+#ifdef WARM_START_FEATURE
+      if ((gpKtaContext->lifeCycleState == E_LIFE_CYCLE_STATE_ACTIVATED) ||
+          (gpKtaContext->lifeCycleState == E_LIFE_CYCLE_STATE_PROVISIONED) ||
+          (gpKtaContext->lifeCycleState == E_LIFE_CYCLE_STATE_CON_REQ))
       {
-        M_KTALOG__ERR("Setting kta context config data, status = [%d]", status);
-        goto end;
+        if (E_K_STATUS_OK == ktaConfigWarmStartLoad(gpKtaContext->lifeCycleState,
+                                                    xpL1SegSeed,
+                                                    xpKtaContextProfileUid,
+                                                    xKtaContextProfileUidLen,
+                                                    xpKtaContexSerialNumber,
+                                                    xKtaContexSerialNumberLen,
+                                                    xpKtaContextVersion,
+                                                    xKtaContextVersionLen))
+        {
+          M_KTALOG__DEBUG("Warm start, context configuration and L2Keys restored");
+          isWarmStarted = 1u;
+        }
       }
+#endif /* WARM_START_FEATURE */
 
-      // REQ RQ_M-KTA-LCST-FN-0050(1) : Power off in ACTIVATED|INITIALIZED state
-      // REQ RQ_M-KTA-LCST-FN-0065(1) : Power off in PROVISIONED|INITIALIZED state
-      if ((gKtaLifeCycleState == E_LIFE_CYCLE_STATE_ACTIVATED) ||
-          (gKtaLifeCycleState == E_LIFE_CYCLE_STATE_PROVISIONED) ||
-          (gKtaLifeCycleState == E_LIFE_CYCLE_STATE_CON_REQ))
+      if (0u == isWarmStarted)
       {
-        M_KTALOG__DEBUG("gKtaLifeCycleState = [%d], deriving L2Keys", gKtaLifeCycleState);
-        // REQ RQ_M-KTA-STRT-FN-0070(1) : Derive L2 Keys
-        status = ktaActDeriveL2Keys();
+        M_KTALOG__DEBUG("Setting kta context configuration data to the platform");
+        // REQ RQ_M-KTA-STRT-FN-0050(1) : Set Context Information
+        // REQ RQ_M-KTA-STRT-FN-0060(1) : Set L1 Segmentaion Seed
+        status = ktaSetContextInfoConfig(xpL1SegSeed, xpKtaContextProfileUid,
+                                        xKtaContextProfileUidLen, xpKtaContexSerialNumber,
+                                        xKtaContexSerialNumberLen, xpKtaContextVersion,
+                                        xKtaContextVersionLen, gpKtaContext->lifeCycleState);
 
-        if (status != E_K_STATUS_OK)
+        if (E_K_STATUS_OK != status)
         {
-          M_KTALOG__ERR("Deriving L2 key got failed, status = [%d]", status);
+          M_KTALOG__ERR("Setting kta context config data, status = [%d]", status);
           goto end;
         }
+
+        // REQ RQ_M-KTA-LCST-FN-0050(1) : Power off in ACTIVATED|INITIALIZED state
+        // REQ RQ_M-KTA-LCST-FN-0065(1) : Power off in PROVISIONED|INITIALIZED state
+        if ((gpKtaContext->lifeCycleState == E_LIFE_CYCLE_STATE_ACTIVATED) ||
+            (gpKtaContext->lifeCycleState == E_LIFE_CYCLE_STATE_PROVISIONED) ||
+            (gpKtaContext->lifeCycleState == E_LIFE_CYCLE_STATE_CON_REQ))
+        {
+          M_KTALOG__DEBUG("lifeCycleState = [%d], deriving L2Keys", gpKtaContext->lifeCycleState);
+          // REQ RQ_M-KTA-STRT-FN-0070(1) : Derive L2 Keys
+          status = ktaActDeriveL2Keys();
+
+          if (status != E_K_STATUS_OK)
+          {
+            M_KTALOG__ERR("Deriving L2 key got failed, status = [%d]", status);
+            goto end;
+          }
+
+#ifdef WARM_START_FEATURE
+          /* Next boot restores instead of deriving, failing here only costs that. */
+          if (E_K_STATUS_OK != ktaConfigWarmStartSave(gpKtaContext->lifeCycleState,
+                                                      xpL1SegSeed))
+          {
+            M_KTALOG__WARN("Saving warm start data failed");
+          }
+#endif /* WARM_START_FEATURE */
+        }
       }
 
       // REQ RQ_M-KTA-STRT-FN-0003(1) : Set KTA State
-      gKtaState = E_KTA_STATE_STARTED;
+      gpKtaContext->ktaState = E_KTA_STATE_STARTED;
       M_KTALOG__DEBUG("KTA reached to STARTED state");
     }
   }
 
 end:
+  M_KTABENCH__END(E_KTABENCH_PHASE_STARTUP);
   M_KTALOG__END("End, status : %d", status);
   return status;
 }
@@ -459,9 +538,9 @@ TKStatus ktaSetDeviceInformation
   }
   else
   {
-    if (E_KTA_STATE_STARTED == gKtaState)
+    if (E_KTA_STATE_STARTED == gpKtaContext->ktaState)
     {
-      switch (gKtaLifeCycleState)
+      switch (gpKtaContext->lifeCycleState)
       {
         case E_LIFE_CYCLE_STATE_INIT:
         {
@@ -471,7 +550,7 @@ TKStatus ktaSetDeviceInformation
                                           xDeviceProfilePublicUidSize,
                                           xpDeviceSerialNum,
                                           xDeviceSerialNumSize,
-                                          gKtaLifeCycleState);
+                                          gpKtaContext->lifeCycleState);
 
           if (E_K_STATUS_OK != status)
           {
@@ -494,9 +573,9 @@ TKStatus ktaSetDeviceInformation
             goto end;
           }
 
-          gKtaLifeCycleState = E_LIFE_CYCLE_STATE_SEALED;
-          M_KTALOG__INFO("Setting life cycle state to SEALED state, gKtaLifeCycleState = [%d]",
-                          gKtaLifeCycleState);
+          gpKtaContext->lifeCycleState = E_LIFE_CYCLE_STATE_SEALED;
+          M_KTALOG__INFO("Setting life cycle state to SEALED state, lifeCycleState = [%d]",
+                          gpKtaContext->lifeCycleState);
           *xpConnectionRequest = 1;
           M_KTALOG__DEBUG("Connection Request set to TRUE");
           status = E_K_STATUS_OK;
@@ -512,7 +591,7 @@ TKStatus ktaSetDeviceInformation
                                           xDeviceProfilePublicUidSize,
                                           xpDeviceSerialNum,
                                           xDeviceSerialNumSize,
-                                          gKtaLifeCycleState);
+                                          gpKtaContext->lifeCycleState);
         } /* No break, since need to execute below cases as well. */
         case E_LIFE_CYCLE_STATE_ACTIVATED:
         case E_LIFE_CYCLE_STATE_CON_REQ:
@@ -526,7 +605,7 @@ TKStatus ktaSetDeviceInformation
         // REQ RQ_M-KTA-LCST-FN-0070(1) : Power off in PROVISIONED|STARTED state
         case E_LIFE_CYCLE_STATE_PROVISIONED:
         {
-          if (memcmp(gaKtaVersion, aKtaVersion, C_K__VERSION_STORAGE_LENGTH) < 0)
+          if (memcmp(gpKtaContext->aKtaVersion, aKtaVersion, C_K__VERSION_STORAGE_LENGTH) < 0)
           {
               M_KTALOG__DEBUG("Connection Request set to TRUE");
               *xpConnectionRequest = 1;
@@ -541,8 +620,8 @@ TKStatus ktaSetDeviceInformation
 
         default:
         {
-          M_KTALOG__ERR("Invalid state, gKtaLifeCycleState = [%d]",
-                        gKtaLifeCycleState);
+          M_KTALOG__ERR("Invalid state, lifeCycleState = [%d]",
+                        gpKtaContext->lifeCycleState);
           *xpConnectionRequest = 0;
         }
         break;
@@ -552,7 +631,7 @@ TKStatus ktaSetDeviceInformation
       // REQ RQ_M-KTA-STRT-FN-0140(1) : Set KTA State
       if (status == E_K_STATUS_OK)
       {
-        gKtaState = E_KTA_STATE_RUNNING;
+        gpKtaContext->ktaState = E_KTA_STATE_RUNNING;
         M_KTALOG__DEBUG("KTA reached to RUNNING state");
       }
     }
@@ -560,7 +639,7 @@ TKStatus ktaSetDeviceInformation
     // REQ RQ_M-KTA-STRT-FN-0120(1) : Invalid KTA State
     else
     {
-      M_KTALOG__ERR("Device in a bad state, gKtaState = [%d]", gKtaState);
+      M_KTALOG__ERR("Device in a bad state, ktaState = [%d]", gpKtaContext->ktaState);
     }
   }
 
@@ -585,9 +664,12 @@ TKStatus ktaExchangeMessage
   TKIcppProtocolMessage recvdProtoMessage = {0};
   TKStatus              status = E_K_STATUS_ERROR;
   TKParserStatus        parserStatus = E_K_ICPP_PARSER_STATUS_ERROR;
-  uint8_t               aClearMsg[C_K__ICPP_MSG_MAX_SIZE] = {0};
+  uint8_t               aClearMsg[C_K__ICPP_WORK_BUFFER_SIZE] = {0};
+  TKCmdSegmentedMsg     segmentedMsg = {0};
+  uint8_t               isBatchOpened = 0u;
 
   M_KTALOG__START("Start");
+  M_KTABENCH__START(E_KTABENCH_PHASE_EXCHANGE);
 
   // REQ RQ_M-KTA-STRT-FN-0150(1) : Input Parameters Check
   // REQ RQ_M-KTA-STRT-CF-0160(1) : ICPP Message Max Size
@@ -606,13 +688,23 @@ TKStatus ktaExchangeMessage
   else
   {
     // REQ RQ_M-KTA-STRT-FN-0170(1) : Invalid KTA State
-    if (E_KTA_STATE_RUNNING != gKtaState)
+    if (E_KTA_STATE_RUNNING != gpKtaContext->ktaState)
     {
       M_KTALOG__ERR("Invalid KTA State");
     }
     else
     {
-      switch (gKtaLifeCycleState)
+      /* Persistent data written while handling the message reach flash in one commit. */
+      if (E_K_STATUS_OK == salStorageBatchBegin())
+      {
+        isBatchOpened = 1u;
+      }
+      else
+      {
+        M_KTALOG__WARN("Storage batch not opened, writes are not coalesced");
+      }
+
+      switch (gpKtaContext->lifeCycleState)
       {
         // REQ RQ_M-KTA-LCST-FN-0030(1) : Power off in SEALED|RUNNING state
         case E_LIFE_CYCLE_STATE_SEALED:
@@ -639,7 +731,8 @@ TKStatus ktaExchangeMessage
           status = lCheckKs2KtaMessage(xpKs2ktaMsg, xKs2ktaMsgLen,
                                         xpKta2ksMsg, xpKta2ksMsgLen,
                                         aClearMsg, sizeof(aClearMsg),
-                                        &recvdProtoMessage, &parserStatus);
+                                        &recvdProtoMessage, &parserStatus,
+                                        &segmentedMsg);
 
           if ((status != E_K_STATUS_OK) || (parserStatus != E_K_ICPP_PARSER_STATUS_OK))
           {
@@ -648,7 +741,7 @@ TKStatus ktaExchangeMessage
             break;
           }
 
-          if (gKtaIsPreActivated != (uint8_t)0)
+          if (gpKtaContext->isPreActivated != (uint8_t)0)
           {
             uint8_t aL1KeyMaterial[C_KEY_CONFIG__MATERIAL_MAX_SIZE] = {0};
 
@@ -704,17 +797,28 @@ TKStatus ktaExchangeMessage
               break;
             }
 
-            gKtaLifeCycleState = E_LIFE_CYCLE_STATE_ACTIVATED;
-            M_KTALOG__INFO("Setting KTA Lifecycle state to Activated, state = [%d]", gKtaLifeCycleState);
-            gKtaIsPreActivated = 0u;
+            gpKtaContext->lifeCycleState = E_LIFE_CYCLE_STATE_ACTIVATED;
+            M_KTALOG__INFO("Setting KTA Lifecycle state to Activated, state = [%d]",
+                           gpKtaContext->lifeCycleState);
+            gpKtaContext->isPreActivated = 0u;
             M_KTALOG__DEBUG("Processing 3rd party commands...");
             // REQ RQ_M-KTA-STRT-FN-0290(1) :
             /** Process the received commands.
              */
             // REQ RQ_M-KTA-OBJM-FN-0800(1) : Set Object With Association ICPP Message
-            status = ktaCmdProcess(&recvdProtoMessage,
-                                    xpKta2ksMsg,
-                                    xpKta2ksMsgLen);
+            if (NULL != segmentedMsg.pEncryptedData)
+            {
+              status = ktaCmdProcessSegmented(&recvdProtoMessage,
+                                              &segmentedMsg,
+                                              xpKta2ksMsg,
+                                              xpKta2ksMsgLen);
+            }
+            else
+            {
+              status = ktaCmdProcess(&recvdProtoMessage,
+                                      xpKta2ksMsg,
+                                      xpKta2ksMsgLen);
+            }
 
             if (E_K_STATUS_OK != status)
             {
@@ -726,6 +830,13 @@ TKStatus ktaExchangeMessage
 
             break;
           }
+          else if (NULL != segmentedMsg.pEncryptedData)
+          {
+            *xpKta2ksMsgLen = 0;
+            status = E_K_STATUS_ERROR;
+            M_KTALOG__ERR("Activation response larger than the working buffer");
+            break;
+          }
           else
           {
             M_KTALOG__DEBUG("Deriving L1 field key...");
@@ -739,6 +850,14 @@ TKStatus ktaExchangeMessage
               break;
             }
 
+#ifdef WARM_START_FEATURE
+            /* New L1 field key, the sealed L2 keys no longer match it. */
+            if (E_K_STATUS_OK != ktaConfigWarmStartDiscard())
+            {
+              M_KTALOG__WARN("Discarding warm start data failed");
+            }
+#endif /* WARM_START_FEATURE */
+
             M_KTALOG__DEBUG("BuildL1Keys success, deriving L2 Keys...");
             status = ktaActDeriveL2Keys();
 
@@ -765,7 +884,7 @@ TKStatus ktaExchangeMessage
             }
             M_KTALOG__INFO("Sending Registration Request");
 
-            gKtaIsPreActivated = 1u;
+            gpKtaContext->isPreActivated = 1u;
           }
 
           break;
@@ -792,7 +911,7 @@ TKStatus ktaExchangeMessage
             break;
           }
 
-          if (E_LIFE_CYCLE_STATE_PROVISIONED == gKtaLifeCycleState)
+          if (E_LIFE_CYCLE_STATE_PROVISIONED == gpKtaContext->lifeCycleState)
           {
             /* Setting the state to connection request. */
             M_KTALOG__DEBUG("Life cycle state reached to CON_REQ state, "
@@ -808,14 +927,15 @@ TKStatus ktaExchangeMessage
               break;
             }
 
-            gKtaLifeCycleState = E_LIFE_CYCLE_STATE_CON_REQ;
+            gpKtaContext->lifeCycleState = E_LIFE_CYCLE_STATE_CON_REQ;
           }
 
           M_KTALOG__DEBUG("Validating the msg received from the server...");
           status = lCheckKs2KtaMessage(xpKs2ktaMsg, xKs2ktaMsgLen,
                                         xpKta2ksMsg, xpKta2ksMsgLen,
                                         aClearMsg, sizeof(aClearMsg),
-                                        &recvdProtoMessage, &parserStatus);
+                                        &recvdProtoMessage, &parserStatus,
+                                        &segmentedMsg);
 
           if ((status != E_K_STATUS_OK) || (parserStatus != E_K_ICPP_PARSER_STATUS_OK))
           {
@@ -852,7 +972,15 @@ TKStatus ktaExchangeMessage
 
           M_KTALOG__DEBUG("Processing 3rd party command...");
           // REQ RQ_M-KTA-STRT-FN-0260(1) : Process the ThirdParty/Object Commands.
-          status = ktaCmdProcess(&recvdProtoMessage, xpKta2ksMsg, xpKta2ksMsgLen);
+          if (NULL != segmentedMsg.pEncryptedData)
+          {
+            status = ktaCmdProcessSegmented(&recvdProtoMessage, &segmentedMsg,
+                                            xpKta2ksMsg, xpKta2ksMsgLen);
+          }
+          else
+          {
+            status = ktaCmdProcess(&recvdProtoMessage, xpKta2ksMsg, xpKta2ksMsgLen);
+          }
 
           if (E_K_STATUS_OK != status)
           {
@@ -865,12 +993,27 @@ TKStatus ktaExchangeMessage
 
         default:
           *xpKta2ksMsgLen = 0;
-          M_KTALOG__ERR("Invalid life cycle state, [%d]", gKtaLifeCycleState);
+          M_KTALOG__ERR("Invalid life cycle state, [%d]", gpKtaContext->lifeCycleState);
           break;
       }
+
+      /* Writes done before a failure are kept, as they were without batching. */
+      if ((1u == isBatchOpened) && (E_K_STATUS_OK != salStorageBatchCommit()))
+      {
+        M_KTALOG__ERR("Storage batch commit failed, rolling back to the stored state");
+        *xpKta2ksMsgLen = 0;
+        status = E_K_STATUS_ERROR;
+
+        if (E_K_STATUS_OK != lRollbackContext())
+        {
+          M_KTALOG__ERR("Rollback failed, the device must be started again");
+          gpKtaContext->ktaState = E_KTA_STATE_INITIAL;
+        }
+      }
     }
   }
 
+  M_KTABENCH__END(E_KTABENCH_PHASE_EXCHANGE);
   M_KTALOG__END("End, status : %d", status);
   return status;
 }
@@ -1114,15 +1257,210 @@ TKStatus ktaKeyStreamStatus
   }
   else
   {
-    cmdStatus = gCommandStatus;
+    cmdStatus = gpKtaContext->commandStatus;
     // REQ RQ_M-KTA-STRT-FN-0510(1) : Get Key Stream Status
     *xpKtaKSCmdStatus = cmdStatus;
 
-    if (gCommandStatus != E_K_KTA_KS_STATUS_REFURBISH)
+    if (gpKtaContext->commandStatus != E_K_KTA_KS_STATUS_REFURBISH)
+    {
+      gpKtaContext->commandStatus = E_K_KTA_KS_STATUS_NO_OPERATION;
+    }
+
+    status = E_K_STATUS_OK;
+  }
+
+  M_KTALOG__END("End, status : %d", status);
+  return status;
+}
+
+#ifdef KEY_PAIR_POOL_FEATURE
+/**
+ * @brief implement ktaKeyPairPoolRefill
+ *
+ */
+TKStatus ktaKeyPairPoolRefill
+(
+  uint32_t   xMaxCount,
+  uint32_t*  xpReadyCount
+)
+{
+  TKStatus  status = E_K_STATUS_ERROR;
+
+  M_KTALOG__START("Start");
+
+  if (NULL == xpReadyCount)
+  {
+    status = E_K_STATUS_PARAMETER;
+    M_KTALOG__ERR("[ktaKeyPairPoolRefill]Invalid parameter passed");
+  }
+  else
+  {
+    status = salObjectKeyPoolRefill(xMaxCount, xpReadyCount);
+  }
+
+  M_KTALOG__END("End, status : %d", status);
+  return status;
+}
+#endif /* KEY_PAIR_POOL_FEATURE */
+
+/**
+ * @brief implement ktaContextCreate
+ *
+ */
+TKStatus ktaContextCreate
+(
+  TKtaContext**  xppContext
+)
+{
+  TKStatus  status = E_K_STATUS_MEMORY;
+  uint32_t  index = 1u;
+
+  M_KTALOG__START("Start");
+
+  if (NULL == xppContext)
+  {
+    status = E_K_STATUS_PARAMETER;
+    M_KTALOG__ERR("Invalid parameter passed");
+  }
+  else
+  {
+    /* Context 0 is the default context, it is never handed out. */
+    for (; index < C_KTA_APP__MAX_CONTEXTS; index++)
+    {
+      if (0u == gaKtaContextPool[index].isUsed)
+      {
+        /*
+         * The slot may have served a previous device, erase what it left in the
+         * instance so that the new context starts its onboarding from scratch.
+         */
+        ktaConfigClearInstance(index);
+
+        if ((E_K_STATUS_OK != salStorageClearInstance(index)) ||
+            (E_K_STATUS_OK != salCryptoClearInstance(index)))
+        {
+          status = E_K_STATUS_ERROR;
+          M_KTALOG__ERR("Failed to clear instance [%d]", index);
+          break;
+        }
+
+        (void)memset(&gaKtaContextPool[index], 0, sizeof(TKtaContext));
+        gaKtaContextPool[index].index = index;
+        gaKtaContextPool[index].isUsed = 1u;
+        gaKtaContextPool[index].ktaState = E_KTA_STATE_INITIAL;
+        gaKtaContextPool[index].lifeCycleState = E_LIFE_CYCLE_STATE_INIT;
+        gaKtaContextPool[index].commandStatus = E_K_KTA_KS_STATUS_NONE;
+        *xppContext = &gaKtaContextPool[index];
+        status = E_K_STATUS_OK;
+        break;
+      }
+    }
+
+    if (E_K_STATUS_MEMORY == status)
+    {
+      M_KTALOG__ERR("No free context, maximum = [%d]", C_KTA_APP__MAX_CONTEXTS);
+    }
+  }
+
+  M_KTALOG__END("End, status : %d", status);
+  return status;
+}
+
+/**
+ * @brief implement ktaContextSelect
+ *
+ */
+TKStatus ktaContextSelect
+(
+  TKtaContext*  xpContext
+)
+{
+  TKStatus      status = E_K_STATUS_ERROR;
+  TKtaContext*  pContext = xpContext;
+
+  M_KTALOG__START("Start");
+
+  if (NULL == pContext)
+  {
+    pContext = &gaKtaContextPool[0];
+  }
+
+  if ((pContext->index >= C_KTA_APP__MAX_CONTEXTS) ||
+      (pContext != &gaKtaContextPool[pContext->index]) ||
+      (0u == pContext->isUsed))
+  {
+    status = E_K_STATUS_PARAMETER;
+    M_KTALOG__ERR("Invalid parameter passed");
+  }
+  else
+  {
+    ktaConfigSelectInstance(pContext->index);
+    status = salCryptoSelectInstance(pContext->index);
+
+    if (E_K_STATUS_OK == status)
+    {
+      status = salStorageSelectInstance(pContext->index);
+    }
+
+    if (E_K_STATUS_OK == status)
+    {
+      status = salObjectSelectInstance(pContext->index);
+    }
+
+    if (E_K_STATUS_OK == status)
+    {
+      gpKtaContext = pContext;
+    }
+    else
+    {
+      M_KTALOG__ERR("Selecting SAL instance failed, status = [%d]", status);
+    }
+  }
+
+  M_KTALOG__END("End, status : %d", status);
+  return status;
+}
+
+/**
+ * @brief implement ktaContextGetSelected
+ *
+ */
+TKtaContext* ktaContextGetSelected
+(
+  void
+)
+{
+  return gpKtaContext;
+}
+
+/**
+ * @brief implement ktaContextRelease
+ *
+ */
+TKStatus ktaContextRelease
+(
+  TKtaContext*  xpContext
+)
+{
+  TKStatus  status = E_K_STATUS_PARAMETER;
+
+  M_KTALOG__START("Start");
+
+  if ((NULL == xpContext) ||
+      (0u == xpContext->index) ||
+      (xpContext->index >= C_KTA_APP__MAX_CONTEXTS) ||
+      (xpContext != &gaKtaContextPool[xpContext->index]) ||
+      (0u == xpContext->isUsed))
+  {
+    M_KTALOG__ERR("Invalid parameter passed");
+  }
+  else
+  {
+    if (gpKtaContext == xpContext)
     {
-      gCommandStatus = E_K_KTA_KS_STATUS_NO_OPERATION;
+      (void)ktaContextSelect(NULL);
     }
 
+    xpContext->isUsed = 0u;
     status = E_K_STATUS_OK;
   }
 
@@ -1136,9 +1474,9 @@ void ktaReset
   void
 )
 {
-  gKtaState = E_KTA_STATE_INITIAL;
-  gKtaLifeCycleState = E_LIFE_CYCLE_STATE_INIT;
-  gKtaIsPreActivated = 0u;
+  gpKtaContext->ktaState = E_KTA_STATE_INITIAL;
+  gpKtaContext->lifeCycleState = E_LIFE_CYCLE_STATE_INIT;
+  gpKtaContext->isPreActivated = 0u;
   ktaResetConfig();
 }
 #endif
@@ -1189,7 +1527,7 @@ static TKStatus lgetNVMLifeCycleState
     if (0 == memcmp(gaKtaLifeCycleNVMVData[stateIndex],
                     aLifeCycleState, C_KTA_CONFIG__LIFE_CYCLE_EACH_STATE_SIZE))
     {
-      gKtaLifeCycleState = (TKtaLifeCycleState)stateIndex;
+      gpKtaContext->lifeCycleState = (TKtaLifeCycleState)stateIndex;
       break;
     }
   }
@@ -1210,17 +1548,43 @@ static TKStatus lgetNVMLifeCycleState
       goto end;
     }
 
-    gKtaLifeCycleState = E_LIFE_CYCLE_STATE_INIT;
+    gpKtaContext->lifeCycleState = E_LIFE_CYCLE_STATE_INIT;
   }
   else
   {
-    gKtaLifeCycleState = (TKtaLifeCycleState)stateIndex;
+    gpKtaContext->lifeCycleState = (TKtaLifeCycleState)stateIndex;
   }
 
 end:
   return status;
 }
 
+/**
+ * @implements lRollbackContext
+ *
+ */
+static TKStatus lRollbackContext
+(
+  void
+)
+{
+  TKStatus  status = E_K_STATUS_ERROR;
+  size_t    lifeCycleStateLen = C_KTA_CONFIG__LIFE_CYCLE_EACH_STATE_SIZE;
+
+  status = lgetNVMLifeCycleState(&lifeCycleStateLen);
+
+  if ((E_K_STATUS_OK == status) &&
+      ((E_LIFE_CYCLE_STATE_INIT == gpKtaContext->lifeCycleState) ||
+       (E_LIFE_CYCLE_STATE_SEALED == gpKtaContext->lifeCycleState)))
+  {
+    /* The L1 key material is not stored, the field and L2 keys derived from it are lost. */
+    gpKtaContext->isPreActivated = 0u;
+    status = salCryptoClearInstance(gpKtaContext->index);
+  }
+
+  return status;
+}
+
 /**
  * @implements lPrepareProcessingStatus
  *
@@ -1352,8 +1716,7 @@ static TKStatus lPrepareNoOpNotificationRequest
   size_t                rotPublicUidLen                            =  C_K_ICPP_PARSER__ROT_PUBLIC_UID_SIZE_IN_BYTES;
   uint8_t               aKtaVersion[C_K__VERSION_STORAGE_LENGTH]   =  C_K_KTA__ENCODED_VERSION;
 #ifndef FOTA_ENABLE
-  uint8_t               aSerializeBuffer[C_K__ICPP_MSG_MAX_SIZE]   = {0};
-  size_t                aSerializeBufferLen = C_K__ICPP_MSG_MAX_SIZE;
+  size_t                serializeBufferLen                         = 0;
   TKParserStatus        parserStatus = E_K_ICPP_PARSER_STATUS_ERROR;
   uint8_t               aComputedMac[C_KTA_ACT__HMACSHA256_SIZE]   = {0};
 #else
@@ -1481,11 +1844,20 @@ static TKStatus lPrepareNoOpNotificationRequest
 #else
   sendProtoMessage.commandsCount = 0;
 
+  if (*xpMessageToSendSize < C_KTA_ACT__HMACSHA256_SIZE)
+  {
+    status = E_K_STATUS_PARAMETER;
+    M_KTALOG__ERR("Output buffer too small, status = [%d]", status);
+    goto end;
+  }
+
+  /* Serialize in place, leaving room for the MAC appended after the message. */
+  serializeBufferLen = *xpMessageToSendSize - C_KTA_ACT__HMACSHA256_SIZE;
   M_KTALOG__DEBUG("ICCP parser serializing the message...");
   // REQ RQ_M-KTA-NOOP-FN-0060(1) : Serialize NoOP Message
   parserStatus = ktaIcppParserSerializeMessage(&sendProtoMessage,
-                                               aSerializeBuffer,
-                                               &aSerializeBufferLen);
+                                               xpMessageToSend,
+                                               &serializeBufferLen);
 
   if (E_K_ICPP_PARSER_STATUS_OK != parserStatus)
   {
@@ -1496,7 +1868,7 @@ static TKStatus lPrepareNoOpNotificationRequest
 
   M_KTALOG__DEBUG("KTA cipher signing the message...");
   // REQ RQ_M-KTA-NOOP-FN-0070(1) : Sign the encrypted NoOP response message
-  status = ktacipherSignMsg(aSerializeBuffer, aSerializeBufferLen, aComputedMac);
+  status = ktacipherSignMsg(xpMessageToSend, serializeBufferLen, aComputedMac);
 
   if (E_K_STATUS_OK != status)
   {
@@ -1504,9 +1876,8 @@ static TKStatus lPrepareNoOpNotificationRequest
     goto end;
   }
 
-  (void)memcpy(xpMessageToSend, aSerializeBuffer, aSerializeBufferLen);
-  (void)memcpy(&xpMessageToSend[aSerializeBufferLen], aComputedMac, C_KTA_ACT__HMACSHA256_SIZE);
-  *xpMessageToSendSize =  aSerializeBufferLen + C_KTA_ACT__HMACSHA256_SIZE;
+  (void)memcpy(&xpMessageToSend[serializeBufferLen], aComputedMac, C_KTA_ACT__HMACSHA256_SIZE);
+  *xpMessageToSendSize =  serializeBufferLen + C_KTA_ACT__HMACSHA256_SIZE;
 #endif // FOTA_ENABLE
 
   status = E_K_STATUS_OK;
@@ -1533,7 +1904,8 @@ static TKStatus lCheckKs2KtaMessage
   uint8_t*                xpClearMsg,
   size_t                  xClearMsgLen,
   TKIcppProtocolMessage*  xpRecvdProtoMessage,
-  TKParserStatus*         xpParserStatus
+  TKParserStatus*         xpParserStatus,
+  TKCmdSegmentedMsg*      xpSegmentedMsg
 )
 {
   TKStatus  status = E_K_STATUS_ERROR;
@@ -1544,24 +1916,14 @@ static TKStatus lCheckKs2KtaMessage
   uint8_t   aKtaVersion[C_K__VERSION_STORAGE_LENGTH] = C_K_KTA__ENCODED_VERSION;
 
   macOffset = xKs2ktaMsgLen - C_K_KTA__HMAC_MAX_SIZE;
-  /* Verify the signature. */
-  M_KTALOG__DEBUG("KTA cipher signature validation...");
-  // REQ RQ_M-KTA-ACTV-FN-0055(1) : Verify Activation Response Signature
-  status = ktacipherVerifySignedMsg(xpKs2ktaMsg,
-                                    macOffset,
-                                    &xpKs2ktaMsg[macOffset]);
-
-  if (E_K_STATUS_OK != status)
-  {
-    M_KTALOG__ERR("KTA cipher signature validation failed, status = [%d]", status);
-    goto end;
-  }
   (void)memcpy(aKs2ktaMsgUpdatedHeaderLenBuffer, xpKs2ktaMsg, C_K_ICPP_PARSER__HEADER_SIZE);
 
   /* We have no operation command(command with payload as 0). */
   if (C_K_ICPP_PARSER__HEADER_SIZE < macOffset)
   {
-    /* Decrypt the message. */
+    /* Verify the signature, decrypt and remove the padding in a single pass. */
+    M_KTALOG__DEBUG("KTA cipher signature validation and decryption...");
+    // REQ RQ_M-KTA-ACTV-FN-0055(1) : Verify Activation Response Signature
     // REQ RQ_M-KTA-ACTV-FN-0060(1) : Decrypt the Activation Response data.
     // REQ RQ_M-KTA-OBJM-FN-0020(1) : Decrypt the Generate Key Pair data
     // REQ RQ_M-KTA-OBJM-FN-0220(1) : Decrypt the Set Object data
@@ -1570,17 +1932,44 @@ static TKStatus lCheckKs2KtaMessage
     // REQ RQ_M-KTA-OBJM-FN-0920(2) : Decrypt the Delete Key Object data
     // REQ RQ_M-KTA-TRDP-FN-0020(1) : Decrypt the Third party data
     // REQ RQ_M-KTA-OBJM-FN-0860(1) : Decrypt Get Challenge command
+    // REQ RQ_M-KTA-ACTV-FN-0061(1)   : Remove data padding
+    // REQ RQ_M-KTA-OBJM-FN-0030(1)   : Remove data padding
+    // REQ RQ_M-KTA-OBJM-FN-0230(1)   : Remove data padding
+    // REQ RQ_M-KTA-OBJM-FN-0530(1)   : Remove data padding
+    // REQ RQ_M-KTA-OBJM-FN-0730(1)   : Remove data padding
+    // REQ RQ_M-KTA-OBJM-FN-0930(2)   : Remove data padding
+    // REQ RQ_M-KTA-TRDP-FN-0030(1)   : Remove data padding
+    // REQ RQ_M-KTA-OBJM-FN-0890_1(1) : Remove Data Padding
     clearMsgLength = clearMsgLength - C_K_ICPP_PARSER__HEADER_SIZE;
-    status = ktacipherDecrypt(&xpKs2ktaMsg[C_K_ICPP_PARSER__HEADER_SIZE],
-                              macOffset - C_K_ICPP_PARSER__HEADER_SIZE,
-                              &xpClearMsg[C_K_ICPP_PARSER__HEADER_SIZE],
-                              &clearMsgLength);
+
+    if ((macOffset - C_K_ICPP_PARSER__HEADER_SIZE) > clearMsgLength)
+    {
+      /* Too large to be decrypted at once, commands are decrypted one by one later. */
+      status = ktacipherVerifyAndGetClearLength(xpKs2ktaMsg,
+                                                C_K_ICPP_PARSER__HEADER_SIZE,
+                                                xKs2ktaMsgLen,
+                                                xpClearMsg,
+                                                xClearMsgLen,
+                                                &clearMsgLength);
+      xpSegmentedMsg->pEncryptedData = &xpKs2ktaMsg[C_K_ICPP_PARSER__HEADER_SIZE];
+    }
+    else
+    {
+      status = ktacipherVerifyDecryptAndUnpad(xpKs2ktaMsg,
+                                              C_K_ICPP_PARSER__HEADER_SIZE,
+                                              xKs2ktaMsgLen,
+                                              &xpClearMsg[C_K_ICPP_PARSER__HEADER_SIZE],
+                                              &clearMsgLength);
+    }
+
     clearMsgLength = clearMsgLength + C_K_ICPP_PARSER__HEADER_SIZE;
 
-    if (E_K_STATUS_OK != status)
+    if (E_K_STATUS_DECRYPTION == status)
     {
       // REQ RQ_M-KTA-NOOP-FN-0020(1) :
       /* Prepare error in case of decryption. */
+      // REQ RQ_M-KTA-ACTV-FN-0065(1) : Prepare error in case of decryption or remove padding
+      // error.
       // REQ RQ_M-KTA-OBJM-FN-0040(1) :
       /* Prepare error in case of decryption or remove padding error. */
       // REQ RQ_M-KTA-OBJM-FN-0240(1) :
@@ -1602,37 +1991,9 @@ static TKStatus lCheckKs2KtaMessage
       goto end;
     }
 
-    /* Remove the padding. */
-    // REQ RQ_M-KTA-ACTV-FN-0061(1)   : Remove data padding
-    // REQ RQ_M-KTA-OBJM-FN-0030(1)   : Remove data padding
-    // REQ RQ_M-KTA-OBJM-FN-0230(1)   : Remove data padding
-    // REQ RQ_M-KTA-OBJM-FN-0530(1)   : Remove data padding
-    // REQ RQ_M-KTA-OBJM-FN-0730(1)   : Remove data padding
-    // REQ RQ_M-KTA-OBJM-FN-0930(2)   : Remove data padding
-    // REQ RQ_M-KTA-TRDP-FN-0030(1)   : Remove data padding
-    // REQ RQ_M-KTA-OBJM-FN-0890_1(1) : Remove Data Padding
-    status = ktacipherRemovePadding(xpClearMsg, &clearMsgLength);
-
     if (E_K_STATUS_OK != status)
     {
-      // REQ RQ_M-KTA-ACTV-FN-0065(1) : Prepare error in case of decryption or remove padding
-      // error.
-      // REQ RQ_M-KTA-OBJM-FN-0040(1) : Prepare error in case of decryption or remove padding
-      // error.
-      // REQ RQ_M-KTA-OBJM-FN-0240(1) : Prepare error in case of decryption or remove padding
-      // error.
-      // REQ RQ_M-KTA-OBJM-FN-0540(1) : Prepare error in case of decryption or remove padding
-      // error.
-      // REQ RQ_M-KTA-OBJM-FN-0740(1) : Prepare error in case of decryption or remove padding
-      // error.
-      // REQ RQ_M-KTA-TRDP-FN-0040(1) : Prepare error in case of decryption or remove padding
-      // error.
-      status = lBuildProcessingStatusRespMsg(xpKs2ktaMsg,
-                                              xKs2ktaMsgLen,
-                                              C_MSG_AUTH_DEC_ERROR,
-                                              xpKta2ksMsg,
-                                              xpKta2ksMsgLen);
-      M_KTALOG__ERR("Processing status RespMsg failed, status = [%d]", status);
+      M_KTALOG__ERR("KTA cipher signature validation failed, status = [%d]", status);
       goto end;
     }
 
@@ -1642,32 +2003,64 @@ static TKStatus lCheckKs2KtaMessage
   }
   else
   {
+    /* Verify the signature. */
+    M_KTALOG__DEBUG("KTA cipher signature validation...");
+    // REQ RQ_M-KTA-ACTV-FN-0055(1) : Verify Activation Response Signature
+    status = ktacipherVerifySignedMsg(xpKs2ktaMsg,
+                                      macOffset,
+                                      &xpKs2ktaMsg[macOffset]);
+
+    if (E_K_STATUS_OK != status)
+    {
+      M_KTALOG__ERR("KTA cipher signature validation failed, status = [%d]", status);
+      goto end;
+    }
+
     lenWithoutMACandPadding = C_K_KTA__HMAC_MAX_SIZE;
     (void)ktaIcppParserUpdateHeaderLength(aKs2ktaMsgUpdatedHeaderLenBuffer, lenWithoutMACandPadding);
     (void)memcpy(xpClearMsg, aKs2ktaMsgUpdatedHeaderLenBuffer, xKs2ktaMsgLen);
     clearMsgLength = macOffset;
   }
 
-  /* Send the info to deserialize message. */
-  // REQ RQ_M-KTA-ACTV-FN-0070(1) : Deserialize the decrypted activation response data.
-  // REQ RQ_M-KTA-ICPP-FN-0180(1) : Deserialize the message
-  // REQ RQ_M-KTA-OBJM-FN-0050(1) :
-  /* Deserialize the decrypted generate key pair data. */
-  // REQ RQ_M-KTA-OBJM-FN-0250(1) :
-  /* Deserialize the decrypted set object data. */
-  // REQ RQ_M-KTA-OBJM-FN-0550(1) :
-  /* Deserialize the decrypted delete object data. */
-  // REQ RQ_M-KTA-OBJM-FN-0750(1) :
-  /* Deserialize the decrypted set object with association data. */
-  // REQ RQ_M-KTA-OBJM-FN-0950(2) :
-  /* Deserialize the decrypted key object data */
-  // REQ RQ_M-KTA-TRDP-FN-0050(1) :
-  /* Deserialize the decrypted Third party data. */
-  // REQ RQ_M-KTA-OBJM-FN-0870(1):
-  /* Desrialize the Get Challenge command. */
-  *xpParserStatus = ktaIcppParserDeserializeMessage(xpClearMsg,
-                                                    clearMsgLength,
-                                                    xpRecvdProtoMessage);
+  if (NULL != xpSegmentedMsg->pEncryptedData)
+  {
+    xpSegmentedMsg->clearDataLen = clearMsgLength - C_K_ICPP_PARSER__HEADER_SIZE;
+    xpSegmentedMsg->pWorkBuffer = xpClearMsg;
+    xpSegmentedMsg->workBufferSize = xClearMsgLen;
+
+    /* Commands are all checked before any is processed, as for a whole message. */
+    *xpParserStatus = ktaIcppParserDeserializeHeader(xpClearMsg,
+                                                     clearMsgLength,
+                                                     xpRecvdProtoMessage);
+
+    if (E_K_ICPP_PARSER_STATUS_OK == *xpParserStatus)
+    {
+      *xpParserStatus = ktaCmdCheckSegmented(xpSegmentedMsg, xpRecvdProtoMessage);
+    }
+  }
+  else
+  {
+    /* Send the info to deserialize message. */
+    // REQ RQ_M-KTA-ACTV-FN-0070(1) : Deserialize the decrypted activation response data.
+    // REQ RQ_M-KTA-ICPP-FN-0180(1) : Deserialize the message
+    // REQ RQ_M-KTA-OBJM-FN-0050(1) :
+    /* Deserialize the decrypted generate key pair data. */
+    // REQ RQ_M-KTA-OBJM-FN-0250(1) :
+    /* Deserialize the decrypted set object data. */
+    // REQ RQ_M-KTA-OBJM-FN-0550(1) :
+    /* Deserialize the decrypted delete object data. */
+    // REQ RQ_M-KTA-OBJM-FN-0750(1) :
+    /* Deserialize the decrypted set object with association data. */
+    // REQ RQ_M-KTA-OBJM-FN-0950(2) :
+    /* Deserialize the decrypted key object data */
+    // REQ RQ_M-KTA-TRDP-FN-0050(1) :
+    /* Deserialize the decrypted Third party data. */
+    // REQ RQ_M-KTA-OBJM-FN-0870(1):
+    /* Desrialize the Get Challenge command. */
+    *xpParserStatus = ktaIcppParserDeserializeMessage(xpClearMsg,
+                                                      clearMsgLength,
+                                                      xpRecvdProtoMessage);
+  }
 
   switch (*xpParserStatus)
   {
@@ -1694,13 +2087,13 @@ static TKStatus lCheckKs2KtaMessage
         break;
       }
 
-      if (E_LIFE_CYCLE_STATE_INIT == gKtaLifeCycleState)
+      if (E_LIFE_CYCLE_STATE_INIT == gpKtaContext->lifeCycleState)
       {
         M_KTALOG__ERR("Device received refurbish command");
-        gCommandStatus = E_K_KTA_KS_STATUS_REFURBISH;
+        gpKtaContext->commandStatus = E_K_KTA_KS_STATUS_REFURBISH;
         /* Reset the globals to inital value after refurbish. */
-        gKtaState = E_KTA_STATE_INITIAL;
-        gKtaIsPreActivated = 0;
+        gpKtaContext->ktaState = E_KTA_STATE_INITIAL;
+        gpKtaContext->isPreActivated = 0;
         M_KTALOG__DEBUG("Life cycle state reached to SEALED state, "
                         "storing in persistent memory");
         status = salStorageSetValue(C_K_KTA__LIFE_CYCLE_STATE_STORAGE_ID,
@@ -1714,10 +2107,10 @@ static TKStatus lCheckKs2KtaMessage
           break;
         }
 
-        gKtaLifeCycleState = E_LIFE_CYCLE_STATE_SEALED;
-        M_KTALOG__INFO("Setting KTA Lifecycle state to SEALED, state = [%d]", gKtaLifeCycleState);
+        gpKtaContext->lifeCycleState = E_LIFE_CYCLE_STATE_SEALED;
+        M_KTALOG__INFO("Setting KTA Lifecycle state to SEALED, state = [%d]", gpKtaContext->lifeCycleState);
       }
-      else if (E_LIFE_CYCLE_STATE_CON_REQ == gKtaLifeCycleState)
+      else if (E_LIFE_CYCLE_STATE_CON_REQ == gpKtaContext->lifeCycleState)
       {
         /* Setting the state to connection request. */
         M_KTALOG__DEBUG("Life cycle state reached to PROVISIONED state, "
@@ -1737,12 +2130,12 @@ static TKStatus lCheckKs2KtaMessage
           break;
         }
 
-        gKtaLifeCycleState = E_LIFE_CYCLE_STATE_PROVISIONED;
-        M_KTALOG__INFO("Setting KTA Lifecycle state to PROVISIONED, state = [%d]", gKtaLifeCycleState);
+        gpKtaContext->lifeCycleState = E_LIFE_CYCLE_STATE_PROVISIONED;
+        M_KTALOG__INFO("Setting KTA Lifecycle state to PROVISIONED, state = [%d]", gpKtaContext->lifeCycleState);
       }
 
       /* Break the chain no communication is needed. */
-      else if (gKtaLifeCycleState == E_LIFE_CYCLE_STATE_ACTIVATED)
+      else if (gpKtaContext->lifeCycleState == E_LIFE_CYCLE_STATE_ACTIVATED)
       {
         M_KTALOG__DEBUG("Life cycle state reached to PROVISIONED state, "
                         "storing in persist memory");
@@ -1759,7 +2152,7 @@ static TKStatus lCheckKs2KtaMessage
           break;
         }
 
-          if (memcmp(gaKtaVersion, aKtaVersion, C_K__VERSION_STORAGE_LENGTH) < 0)
+          if (memcmp(gpKtaContext->aKtaVersion, aKtaVersion, C_K__VERSION_STORAGE_LENGTH) < 0)
           {
               status = salStorageSetValue(C_K_KTA__VERSION_SLOT_ID,
                                           aKtaVersion,
@@ -1773,8 +2166,8 @@ static TKStatus lCheckKs2KtaMessage
                               ktaGetDecodedVersionStr(aKtaVersion));
           }
 
-          gKtaLifeCycleState = E_LIFE_CYCLE_STATE_PROVISIONED;
-          gCommandStatus = E_K_KTA_KS_STATUS_NO_OPERATION;
+          gpKtaContext->lifeCycleState = E_LIFE_CYCLE_STATE_PROVISIONED;
+          gpKtaContext->commandStatus = E_K_KTA_KS_STATUS_NO_OPERATION;
           M_KTALOG__DEBUG("Lifecycle provised and E_K_KTA_KS_STATUS_NO_OPERATION");
         }
         else
@@ -1822,9 +2215,9 @@ static TKStatus lCheckKs2KtaMessage
     {
       M_KTALOG__DEBUG("Received E_K_ICPP_PARSER_STATUS_OK");
 
-      if (E_LIFE_CYCLE_STATE_CON_REQ == gKtaLifeCycleState)
+      if (E_LIFE_CYCLE_STATE_CON_REQ == gpKtaContext->lifeCycleState)
       {
-        gCommandStatus = E_K_KTA_KS_STATUS_RENEW;
+        gpKtaContext->commandStatus = E_K_KTA_KS_STATUS_RENEW;
       }
 
       status = E_K_STATUS_OK;
@@ -48,6 +48,7 @@
 #include "k_sal_storage.h"
 #include "cryptoConfig.h"
 #include "KTALog.h"
+#include "KTABench.h"
 
 
 
@@ -334,8 +335,7 @@ TKStatus ktaActBuildActivationRequest
   uint8_t aEncMsg[C_K__MAX_DEVICE_PROFILES][C_DEV_PROF_PAD_MAX_LEN] = {0};
   size_t  aEncMsgLen[C_K__MAX_DEVICE_PROFILES]    =
                                                {C_DEV_PROF_PAD_MAX_LEN, C_DEV_PROF_PAD_MAX_LEN};
-  uint8_t aSerializeBuffer[C_K__ICPP_MSG_MAX_SIZE] = {0};
-  size_t serializeBufferLen                       = C_K__ICPP_MSG_MAX_SIZE;
+  size_t serializeBufferLen                       = 0;
   uint8_t aComputedMac[C_KTA_ACT__HMACSHA256_SIZE] = {0};
   size_t transactionIDLen                        = C_K_ICPP_PARSER__TRANSACTION_ID_SIZE_IN_BYTES;
   TKStatus status                                = E_K_STATUS_ERROR;
@@ -346,6 +346,7 @@ TKStatus ktaActBuildActivationRequest
   uint8_t maxDevProfiles                         = C_K__MAX_DEVICE_PROFILES;
 
   M_KTALOG__START("Start");
+  M_KTABENCH__START(E_KTABENCH_PHASE_ACT_REQUEST);
 
   if ((NULL == xpMessageToSend) ||
       (NULL == xpMessageToSendSize) ||
@@ -496,9 +497,11 @@ TKStatus ktaActBuildActivationRequest
       goto end;
     }
 
+    /* Serialize in place, leaving room for the MAC appended after the message. */
+    serializeBufferLen = *xpMessageToSendSize - C_KTA_ACT__HMACSHA256_SIZE;
     // REQ RQ_M-KTA-ICPP-FN-0100(1) : Serialize the message
     parserStatus = ktaIcppParserSerializeMessage(&protoMessage,
-                                                 aSerializeBuffer,
+                                                 xpMessageToSend,
                                                  &serializeBufferLen);
 
     if (E_K_ICPP_PARSER_STATUS_OK != parserStatus)
@@ -509,7 +512,7 @@ TKStatus ktaActBuildActivationRequest
     }
 
     // REQ RQ_M-KTA-ACTV-FN-0050(1) : Sign the ICPP format raw buffer
-    status = ktacipherSignMsg(aSerializeBuffer, serializeBufferLen, aComputedMac);
+    status = ktacipherSignMsg(xpMessageToSend, serializeBufferLen, aComputedMac);
 
     if (E_K_STATUS_OK != status)
     {
@@ -517,12 +520,12 @@ TKStatus ktaActBuildActivationRequest
       goto end;
     }
 
-    (void)memcpy(xpMessageToSend, aSerializeBuffer, serializeBufferLen);
     (void)memcpy(&(xpMessageToSend[serializeBufferLen]), aComputedMac, C_KTA_ACT__HMACSHA256_SIZE);
     *xpMessageToSendSize =  serializeBufferLen + C_KTA_ACT__HMACSHA256_SIZE;
   }
 
 end:
+  M_KTABENCH__END(E_KTABENCH_PHASE_ACT_REQUEST);
   M_KTALOG__END("End, status : %d", status);
   return status;
 }
@@ -616,6 +619,8 @@ static TKStatus lActDeriveL2Keys
   TKStatus status   = E_K_STATUS_ERROR;
 
   // REQ RQ_M-KTA-ACTV-FN-0115(1) : Generate L2 Encryption Key
+  M_KTABENCH__START(E_KTABENCH_PHASE_KEY_DERIVATION);
+
   status = salRotKeyDerivation(xKeyId, xpInDataEncDec, xInDataEncDecLen, C_K_KTA__VOLATILE_3_ID);
 
   if (E_K_STATUS_OK != status)
@@ -633,6 +638,8 @@ static TKStatus lActDeriveL2Keys
     }
   }
 
+  M_KTABENCH__END(E_KTABENCH_PHASE_KEY_DERIVATION);
+
   return status;
 }
 
@@ -668,6 +675,8 @@ static TKStatus lActReqDeriveL1Key
   const uint8_t aKssDosPk[C_KTA__KS_S_DOS_PK_SIZE] = C_KTA__KS_S_DOS_PK;
   TKStatus      status = E_K_STATUS_ERROR;
 
+  M_KTABENCH__START(E_KTABENCH_PHASE_KEY_DERIVATION);
+
   status = salRotKeyAgreement(C_K_KTA__CHIP_SK_ID, aKssDosPk, C_K_KTA__VOLATILE_2_ID, NULL);
 
   if (E_K_STATUS_OK != status)
@@ -685,6 +694,8 @@ static TKStatus lActReqDeriveL1Key
     }
   }
 
+  M_KTABENCH__END(E_KTABENCH_PHASE_KEY_DERIVATION);
+
   return status;
 }
 
@@ -993,6 +1004,8 @@ static TKStatus lActRespDeriveL1Key
   uint8_t         aInfoHkdf[C_KTA__FIELD_KEY_FIXED_INFO_SIZE] = C_KTA__FIELD_KEY_FIXED_INFO;
   uint8_t         aSharedSecretES[2 * C_K_KTA__SHARED_SECRET_KEY_MAX_SIZE] = { 0 };
 
+  M_KTABENCH__START(E_KTABENCH_PHASE_KEY_DERIVATION);
+
   /* Storing shared Secret E. */
   // REQ RQ_M-KTA-ACTV-FN-0090(1) : Generate Shared Secret E(**shs_e**)
   status = salRotKeyAgreement(C_K_KTA__VOLATILE_ID,
@@ -1044,6 +1057,8 @@ static TKStatus lActRespDeriveL1Key
     }
   }
 
+  M_KTABENCH__END(E_KTABENCH_PHASE_KEY_DERIVATION);
+
   return status;
 }
 
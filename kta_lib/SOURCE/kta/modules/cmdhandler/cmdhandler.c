@@ -50,6 +50,7 @@
 #include "k_kta.h"
 #include "k_defs.h"
 #include "KTALog.h"
+#include "KTABench.h"
 #include "general.h"
 #include "cryptoConfig.h"
 #include "kta_version.h"
@@ -57,6 +58,10 @@
 
 #include <string.h>
 #include <stdbool.h>
+#ifdef PARALLEL_COMMANDS_FEATURE
+#include "mbedtls/build_info.h"
+#include <pthread.h>
+#endif
 
 #ifdef FOTA_ENABLE
 #include "k_sal_fota.h"
@@ -87,6 +92,9 @@
 /** @brief Challenge size in bytes */
 #define C_K_ICPP_PARSER_KTA_CHALLENGE_SIZE              (32u)
 
+/** @brief Command tag and its longest length, enough to size a command. */
+#define C_K_CMD_TAG_LENGTH_MAX_SIZE                     (3u)
+
 #ifdef OBJECT_MANAGEMENT_FEATURE
 /** @brief Mandatory generate key pair fields. */
 #define C_K_CMD_GENKEYPAIR_FIELDS_MANDATORY \
@@ -211,11 +219,204 @@ typedef enum
 
 #endif
 
+/** @brief Size of the platform status returned by the SAL. */
+#define C_K_CMD_PLATFORM_STATUS_SIZE                    (4u)
+
+/** @brief State shared by the command handlers while one message is processed. */
+typedef struct
+{
+#ifdef OBJECT_MANAGEMENT_FEATURE
+  uint8_t      aCmdResponse[C_K__ICPP_CMD_RESPONSE_SIZE_VENDOR_SPECIFIC];
+  /* Response data of the commands. */
+  uint8_t      aPlatformStatus[C_K_ICPP_PARSER__MAX_COMMANDS_COUNT][C_K_CMD_PLATFORM_STATUS_SIZE];
+  /* Platform status from SAL API, per command. */
+#ifdef PARALLEL_COMMANDS_FEATURE
+  uint8_t      aKeyPairResponse[C_K_ICPP_PARSER__MAX_COMMANDS_COUNT]
+                               [C_K__ICPP_CMD_RESPONSE_SIZE_VENDOR_SPECIFIC];
+  /* Public key of each generate key pair command, generated concurrently. */
+#endif /* PARALLEL_COMMANDS_FEATURE */
+  uint8_t      aChallenge[C_K_ICPP_PARSER_KTA_CHALLENGE_SIZE];
+  /* Challenge generated for get challenge. */
+#ifdef FOTA_ENABLE
+  uint8_t      aFotaName[CURRENT_MAX_LENGTH];
+  /* Name of the FOTA campaign. */
+  uint8_t      fotaNameLen;
+  /* Length of aFotaName. */
+  uint8_t      aFotaErrorCode[sizeof(uint32_t)];
+  /* FOTA error code, ERROR_CODE_LEN bytes used; sized for fotaErrorCodeMsb. */
+  uint8_t      aFotaErrorCause[CURRENT_MAX_LENGTH];
+  /* FOTA error cause. */
+  TFotaError   fotaError;
+  /* FOTA error, pointing to aFotaErrorCode and aFotaErrorCause. */
+  TComponent   aComponents[COMPONENTS_MAX];
+  /* Components reported by the SAL. */
+  uint32_t     platformStatusMsb;
+  /* Platform status, most significant byte first. */
+  uint32_t     fotaErrorCodeMsb;
+  /* FOTA error code, most significant byte first. */
+#endif /* FOTA_ENABLE */
+#else
+  uint8_t      aCmdResponse[C_K_ICPP_PARSER_MAX_COUNT_THIRDPARTY_ERROR_SIZE];
+  /* Response data of the commands. */
+#endif /* OBJECT_MANAGEMENT_FEATURE */
+  size_t       cmdResponseLen;
+  /* Bytes of aCmdResponse used by the responses prepared so far. */
+} TKCmdContext;
+
+/**
+ * @brief
+ *   Process one command and complete its response. The response tag and, if any,
+ *   the processing status field of the response template are already set.
+ *
+ * @param[in] xpRecvdProtoMessage
+ *   ICPP structure contains data received from server.
+ * @param[in] xCommandIndex
+ *   Index of the command in xpRecvdProtoMessage.
+ * @param[in,out] xpResponse
+ *   Response of the command.
+ * @param[in,out] xpContext
+ *   Buffers shared by the commands of the message.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_PARAMETER for wrong input parameters.
+ * - E_K_STATUS_ERROR for other errors.
+ */
+typedef TKStatus (*TKCmdHandler)
+(
+  TKIcppProtocolMessage* xpRecvdProtoMessage,
+  size_t                 xCommandIndex,
+  TKIcppCommand*         xpResponse,
+  TKCmdContext*          xpContext
+);
+
+/** @brief Command processing and response template. */
+typedef struct
+{
+  TKCmdHandler  pfHandler;
+  /* Processes the command, NULL if the command is not supported. */
+  uint8_t       responseFieldsCount;
+  /* Fields of the response, processing status first; 0 for a response without fields. */
+  uint8_t       isConcurrent;
+  /* 1 if the command may run concurrently with commands on other objects. */
+} TKCmdDescriptor;
+
+/** @brief Commands processed by the keySTREAM Trusted Agent, index in gaCmdDescriptors. */
+typedef enum
+{
+  E_K_CMD_ID_NONE = 0,
+  /* Not supported. */
+#ifdef PLATFORM_PROCESS_FEATURE
+  E_K_CMD_ID_THIRD_PARTY,
+  /* Third party data. */
+#endif /* PLATFORM_PROCESS_FEATURE */
+#ifdef OBJECT_MANAGEMENT_FEATURE
+  E_K_CMD_ID_GENERATE_KEY_PAIR,
+  /* Generate key pair. */
+  E_K_CMD_ID_SET_OBJECT,
+  /* Set object. */
+  E_K_CMD_ID_DELETE_OBJECT,
+  /* Delete object. */
+  E_K_CMD_ID_DELETE_KEY_OBJECT,
+  /* Delete key object. */
+  E_K_CMD_ID_SET_OBJ_WITH_ASSOCIATION,
+  /* Set object with association. */
+  E_K_CMD_ID_GET_CHALLENGE,
+  /* Get challenge. */
+#ifdef FOTA_ENABLE
+  E_K_CMD_ID_INSTALL_FOTA,
+  /* Install FOTA. */
+  E_K_CMD_ID_GET_FOTA_STATUS,
+  /* Get FOTA status. */
+#endif /* FOTA_ENABLE */
+#endif /* OBJECT_MANAGEMENT_FEATURE */
+  E_K_CMD_ID_COUNT
+  /* Number of items in this enum. */
+} TKCmdId;
+
+/** @brief Number of values a command tag can take. */
+#define C_K_CMD_TAG_COUNT                               (256u)
+
+/** @brief Descriptor of a command tag. */
+#define M_K_CMD_GET_DESCRIPTOR(x_cmdTag) \
+  (&gaCmdDescriptors[gaCmdDescriptorIndex[(uint8_t)(x_cmdTag)]])
+
+#ifdef PARALLEL_COMMANDS_FEATURE
+#if (C_KTA_APP__COMMAND_WORKERS < 2u)
+#error "PARALLEL_COMMANDS_FEATURE requires C_KTA_APP__COMMAND_WORKERS greater than 1"
+#endif
+
+#if !defined(MBEDTLS_THREADING_C) || !defined(MBEDTLS_THREADING_PTHREAD)
+#error "PARALLEL_COMMANDS_FEATURE requires a thread safe PSA crypto, MBEDTLS_THREADING_C and MBEDTLS_THREADING_PTHREAD"
+#endif
+
+/** @brief Commands of one message run concurrently, shared by the worker threads. */
+typedef struct
+{
+  pthread_mutex_t         lock;
+  /* Protects nextIndex. */
+  TKIcppProtocolMessage*  pRecvdProtoMessage;
+  /* Received message. */
+  TKIcppProtocolMessage*  pSendProtoMessage;
+  /* Response message. */
+  TKCmdContext*           pContext;
+  /* Buffers shared by the commands of the message. */
+  TKtaContext*            pKtaContext;
+  /* keySTREAM Trusted Agent context of the thread processing the message. */
+  size_t                  aWave[C_K_ICPP_PARSER__MAX_COMMANDS_COUNT];
+  /* Indexes of the commands run concurrently, on distinct objects. */
+  size_t                  waveCount;
+  /* Number of commands in aWave. */
+  size_t                  nextIndex;
+  /* Next entry of aWave to run. */
+  TKStatus                aStatus[C_K_ICPP_PARSER__MAX_COMMANDS_COUNT];
+  /* Status of each command. */
+} TKCmdExecutor;
+
+/**
+ * @brief
+ *   Worker threads started once and kept for the life of the process, so that a wave
+ *   does not pay for creating and joining threads. One message uses them at a time.
+ */
+typedef struct
+{
+  pthread_mutex_t  ownerLock;
+  /* Held by the thread processing the message that uses the workers. */
+  pthread_mutex_t  lock;
+  /* Protects the fields below. */
+  pthread_cond_t   waveCond;
+  /* Signaled when a wave is posted. */
+  pthread_cond_t   doneCond;
+  /* Signaled when the last worker is done with the wave. */
+  TKCmdExecutor*   pExecutor;
+  /* Executor of the posted wave. */
+  uint32_t         waveId;
+  /* Incremented each time a wave is posted. */
+  size_t           busyCount;
+  /* Workers not done with the posted wave yet. */
+  size_t           workerCount;
+  /* Workers started. */
+} TKCmdWorkerPool;
+#endif /* PARALLEL_COMMANDS_FEATURE */
+
 /* -------------------------------------------------------------------------- */
 /* LOCAL VARIABLES                                                            */
 /* -------------------------------------------------------------------------- */
 static const char* gpModuleName = "KTACMDHANDLER";
 
+#ifdef PARALLEL_COMMANDS_FEATURE
+/** @brief Command workers, started by the first message with concurrent commands. */
+static TKCmdWorkerPool gCmdWorkerPool =
+{
+  PTHREAD_MUTEX_INITIALIZER, PTHREAD_MUTEX_INITIALIZER,
+  PTHREAD_COND_INITIALIZER, PTHREAD_COND_INITIALIZER,
+  NULL, 0, 0, 0
+};
+
+/** @brief Starts gCmdWorkerPool once. */
+static pthread_once_t gCmdWorkerPoolOnce = PTHREAD_ONCE_INIT;
+#endif /* PARALLEL_COMMANDS_FEATURE */
+
 /* -------------------------------------------------------------------------- */
 /* LOCAL FUNCTIONS - PROTOTYPE                                                */
 /* -------------------------------------------------------------------------- */
@@ -308,6 +509,8 @@ static TKStatus lKtaGenerateKeyPair
  *   Icpp message received from server.
  * @param[out] xpPlatformStatus
  *   Platform status from SAL API.
+ * @param[in] xCmdCount
+ *   Command count.
  *
  * @return
  * - E_K_STATUS_OK in case of success.
@@ -317,7 +520,8 @@ static TKStatus lKtaGenerateKeyPair
 static TKStatus lKtaSetObject
 (
   TKIcppProtocolMessage* xpData,
-  uint8_t*               xpPlatformStatus
+  uint8_t*               xpPlatformStatus,
+  uint32_t               xCmdCount
 );
 
 /**
@@ -446,6 +650,73 @@ static TKStatus lKtaSetThirdPartyData
 );
 #endif
 
+/**
+ * @brief
+ *   Fill the header of the response from the header of the received message.
+ *
+ * @param[in] xpRecvdProtoMessage
+ *   ICPP structure contains data received from server.
+ * @param[out] xpSendProtoMessage
+ *   Response, header filled.
+ */
+static void lPrepareResponseHeader
+(
+  const TKIcppProtocolMessage* xpRecvdProtoMessage,
+  TKIcppProtocolMessage*       xpSendProtoMessage
+);
+
+/**
+ * @brief
+ *   Process the received commands and prepare their responses, see
+ *   lProcessCmdPrepareResponse(). A failed FOTA command still gets a response.
+ *
+ * @param[in] xpRecvdProtoMessage
+ *   ICPP structure contains data received from server.
+ * @param[in,out] xpSendProtoMessage
+ *   Response, commands filled.
+ * @param[in,out] xpContext
+ *   Buffers shared by the commands of the message, referenced by the response.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_PARAMETER for wrong input parameters.
+ * - E_K_STATUS_ERROR for other errors.
+ */
+static TKStatus lProcessCommands
+(
+  TKIcppProtocolMessage* xpRecvdProtoMessage,
+  TKIcppProtocolMessage* xpSendProtoMessage,
+  TKCmdContext*          xpContext
+);
+
+/**
+ * @brief
+ *   Decrypt and deserialize the command of a segmented message starting at xOffset.
+ *
+ * @param[in] xpSegmentedMsg
+ *   Segmented message.
+ * @param[in] xOffset
+ *   Offset of the command in the clear commands.
+ * @param[in,out] xpRecvdProtoMessage
+ *   [in] Received message, header deserialized.
+ *   [out] Its only command, pointing into the working buffer.
+ * @param[out] xpCommandSize
+ *   Size of the command, tag and length included.
+ *
+ * @return
+ * - E_K_ICPP_PARSER_STATUS_OK in case of success.
+ * - E_K_ICPP_PARSER_STATUS_NOTIFICATION_CPERROR if the command is a processing error.
+ * - E_K_ICPP_PARSER_STATUS_ERROR for malformed commands, or commands larger than the
+ *   working buffer.
+ */
+static TKParserStatus lDecryptNextCommand
+(
+  const TKCmdSegmentedMsg* xpSegmentedMsg,
+  size_t                   xOffset,
+  TKIcppProtocolMessage*   xpRecvdProtoMessage,
+  size_t*                  xpCommandSize
+);
+
 /**
  * @brief
  *   Process command and prepare response message.
@@ -456,12 +727,8 @@ static TKStatus lKtaSetThirdPartyData
  *   [in] Protocol message structure to contain notification message info.
  *   [out] Filled protocol message structure with necessary info.
  *   Output structure to send to server back.
- * @param[in,out] xpCmdResponse
- *   Holds the address of buffer to store the response data.
- * @param[in] xCmdItemSize
- *   Holds the size of 2 bytes, to prepare response data for each command.
- * @param[out] xpPlatformStatus
- *   Platform status from SAL API.
+ * @param[in,out] xpContext
+ *   Buffers shared by the commands of the message, referenced by the response.
  *
  * @return
  * - E_K_STATUS_OK in case of success.
@@ -472,13 +739,281 @@ static TKStatus lProcessCmdPrepareResponse
 (
   TKIcppProtocolMessage* xpRecvdProtoMessage,
   TKIcppProtocolMessage* xpSendProtoMessage,
-  uint8_t*               xpCmdResponse,
-  uint32_t               xCmdItemSize
+  TKCmdContext*          xpContext
+);
+
+#ifdef PLATFORM_PROCESS_FEATURE
+/**
+ * @brief
+ *   Third party command handler, see TKCmdHandler.
+ */
+static TKStatus lCmdThirdParty
+(
+  TKIcppProtocolMessage* xpRecvdProtoMessage,
+  size_t                 xCommandIndex,
+  TKIcppCommand*         xpResponse,
+  TKCmdContext*          xpContext
+);
+#endif /* PLATFORM_PROCESS_FEATURE */
+
 #ifdef OBJECT_MANAGEMENT_FEATURE
-  , uint8_t*              xpPlatformStatus
-#endif
+/**
+ * @brief
+ *   Generate key pair command handler, see TKCmdHandler.
+ */
+static TKStatus lCmdGenerateKeyPair
+(
+  TKIcppProtocolMessage* xpRecvdProtoMessage,
+  size_t                 xCommandIndex,
+  TKIcppCommand*         xpResponse,
+  TKCmdContext*          xpContext
+);
+
+/**
+ * @brief
+ *   Set object command handler, see TKCmdHandler.
+ */
+static TKStatus lCmdSetObject
+(
+  TKIcppProtocolMessage* xpRecvdProtoMessage,
+  size_t                 xCommandIndex,
+  TKIcppCommand*         xpResponse,
+  TKCmdContext*          xpContext
+);
+
+/**
+ * @brief
+ *   Delete object command handler, see TKCmdHandler.
+ */
+static TKStatus lCmdDeleteObject
+(
+  TKIcppProtocolMessage* xpRecvdProtoMessage,
+  size_t                 xCommandIndex,
+  TKIcppCommand*         xpResponse,
+  TKCmdContext*          xpContext
 );
 
+/**
+ * @brief
+ *   Delete key object command handler, see TKCmdHandler.
+ */
+static TKStatus lCmdDeleteKeyObject
+(
+  TKIcppProtocolMessage* xpRecvdProtoMessage,
+  size_t                 xCommandIndex,
+  TKIcppCommand*         xpResponse,
+  TKCmdContext*          xpContext
+);
+
+/**
+ * @brief
+ *   Set object with association command handler, see TKCmdHandler.
+ */
+static TKStatus lCmdSetObjWithAssociation
+(
+  TKIcppProtocolMessage* xpRecvdProtoMessage,
+  size_t                 xCommandIndex,
+  TKIcppCommand*         xpResponse,
+  TKCmdContext*          xpContext
+);
+
+/**
+ * @brief
+ *   Get challenge command handler, see TKCmdHandler.
+ */
+static TKStatus lCmdGetChallenge
+(
+  TKIcppProtocolMessage* xpRecvdProtoMessage,
+  size_t                 xCommandIndex,
+  TKIcppCommand*         xpResponse,
+  TKCmdContext*          xpContext
+);
+
+#ifdef FOTA_ENABLE
+/**
+ * @brief
+ *   Install FOTA command handler, see TKCmdHandler.
+ */
+static TKStatus lCmdInstallFota
+(
+  TKIcppProtocolMessage* xpRecvdProtoMessage,
+  size_t                 xCommandIndex,
+  TKIcppCommand*         xpResponse,
+  TKCmdContext*          xpContext
+);
+
+/**
+ * @brief
+ *   Get FOTA status command handler, see TKCmdHandler.
+ */
+static TKStatus lCmdGetFotaStatus
+(
+  TKIcppProtocolMessage* xpRecvdProtoMessage,
+  size_t                 xCommandIndex,
+  TKIcppCommand*         xpResponse,
+  TKCmdContext*          xpContext
+);
+
+/**
+ * @brief
+ *   Complete the response of a FOTA command from the SAL outcome, common to
+ *   install FOTA and get FOTA status.
+ *
+ * @param[in] xFotaStatus
+ *   Status returned by the SAL.
+ * @param[in] xErrorCodeLen
+ *   Length of the error code field.
+ * @param[in] xpPlatformStatus
+ *   Platform status of the command.
+ * @param[in,out] xpResponse
+ *   Response of the command, processing status field set.
+ * @param[in,out] xpContext
+ *   FOTA name, error and components returned by the SAL.
+ *
+ * @return
+ * - E_K_STATUS_OK if a response is built.
+ * - E_K_STATUS_ERROR otherwise.
+ */
+static TKStatus lCmdFotaResponse
+(
+  TKFotaStatus           xFotaStatus,
+  size_t                 xErrorCodeLen,
+  const uint8_t*         xpPlatformStatus,
+  TKIcppCommand*         xpResponse,
+  TKCmdContext*          xpContext
+);
+#endif /* FOTA_ENABLE */
+#endif /* OBJECT_MANAGEMENT_FEATURE */
+
+#ifdef PARALLEL_COMMANDS_FEATURE
+/**
+ * @brief
+ *   Run the handlers of the commands whose response template is set, in waves of
+ *   commands on distinct objects. A wave runs on the calling thread and the
+ *   C_KTA_APP__COMMAND_WORKERS - 1 threads of gCmdWorkerPool, or on the calling thread
+ *   alone while another message uses them; a command which cannot run concurrently
+ *   runs alone, in order.
+ *
+ * @param[in] xpRecvdProtoMessage
+ *   ICPP structure contains data received from server.
+ * @param[in,out] xpSendProtoMessage
+ *   Response, command tags and processing status fields set.
+ * @param[in,out] xpContext
+ *   Buffers shared by the commands of the message.
+ *
+ * @return
+ * - Status of the last command, as when the commands run one after the other.
+ * - E_K_STATUS_ERROR if no command is supported.
+ */
+static TKStatus lExecuteCommands
+(
+  TKIcppProtocolMessage* xpRecvdProtoMessage,
+  TKIcppProtocolMessage* xpSendProtoMessage,
+  TKCmdContext*          xpContext
+);
+
+/**
+ * @brief
+ *   Run the commands of the current wave until none is left.
+ *
+ * @param[in,out] xpExecutor
+ *   Executor of the message.
+ */
+static void lExecuteWave
+(
+  TKCmdExecutor*  xpExecutor
+);
+
+/**
+ * @brief
+ *   Start the worker threads of gCmdWorkerPool, run once.
+ */
+static void lStartWorkers
+(
+  void
+);
+
+/**
+ * @brief
+ *   Worker thread, waits for a wave to be posted in gCmdWorkerPool, selects the
+ *   keySTREAM Trusted Agent context of its message and runs its commands.
+ *
+ * @param[in] xpArg
+ *   Unused.
+ *
+ * @return
+ * - NULL, never returns.
+ */
+static void* lExecuteWorker
+(
+  void*  xpArg
+);
+
+/**
+ * @brief
+ *   Get the identifier of the object a command operates on.
+ *
+ * @param[in] xpCommand
+ *   Received command.
+ * @param[out] xpObjectId
+ *   Object identifier.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_ERROR if the command has no identifier field.
+ */
+static TKStatus lCmdGetObjectId
+(
+  const TKIcppCommand*  xpCommand,
+  uint32_t*             xpObjectId
+);
+#endif /* PARALLEL_COMMANDS_FEATURE */
+
+/**
+ * @brief Commands processed by the keySTREAM Trusted Agent. A command is added by
+ *        registering its handler here and its tag in gaCmdDescriptorIndex.
+ */
+static const TKCmdDescriptor gaCmdDescriptors[E_K_CMD_ID_COUNT] =
+{
+  [E_K_CMD_ID_NONE]                     = { NULL, 0u, 0u },
+#ifdef PLATFORM_PROCESS_FEATURE
+  [E_K_CMD_ID_THIRD_PARTY]              = { lCmdThirdParty, 0u, 0u },
+#endif /* PLATFORM_PROCESS_FEATURE */
+#ifdef OBJECT_MANAGEMENT_FEATURE
+  [E_K_CMD_ID_GENERATE_KEY_PAIR]        = { lCmdGenerateKeyPair, 2u, 1u },
+  [E_K_CMD_ID_SET_OBJECT]               = { lCmdSetObject, 1u, 1u },
+  [E_K_CMD_ID_DELETE_OBJECT]            = { lCmdDeleteObject, 1u, 1u },
+  [E_K_CMD_ID_DELETE_KEY_OBJECT]        = { lCmdDeleteKeyObject, 1u, 1u },
+  [E_K_CMD_ID_SET_OBJ_WITH_ASSOCIATION] = { lCmdSetObjWithAssociation, 1u, 0u },
+  [E_K_CMD_ID_GET_CHALLENGE]            = { lCmdGetChallenge, 2u, 0u },
+#ifdef FOTA_ENABLE
+  [E_K_CMD_ID_INSTALL_FOTA]             = { lCmdInstallFota, 2u, 0u },
+  [E_K_CMD_ID_GET_FOTA_STATUS]          = { lCmdGetFotaStatus, 2u, 0u },
+#endif /* FOTA_ENABLE */
+#endif /* OBJECT_MANAGEMENT_FEATURE */
+};
+
+/** @brief Command of each command tag, E_K_CMD_ID_NONE if not supported. */
+static const uint8_t gaCmdDescriptorIndex[C_K_CMD_TAG_COUNT] =
+{
+#ifdef PLATFORM_PROCESS_FEATURE
+  [E_K_ICPP_PARSER_COMMAND_TAG_THIRD_PARTY]       = (uint8_t)E_K_CMD_ID_THIRD_PARTY,
+#endif /* PLATFORM_PROCESS_FEATURE */
+#ifdef OBJECT_MANAGEMENT_FEATURE
+  [E_K_ICPP_PARSER_COMMAND_TAG_GENERATE_KEY_PAIR] = (uint8_t)E_K_CMD_ID_GENERATE_KEY_PAIR,
+  [E_K_ICPP_PARSER_COMMAND_TAG_SET_OBJECT]        = (uint8_t)E_K_CMD_ID_SET_OBJECT,
+  [E_K_ICPP_PARSER_COMMAND_TAG_DELETE_OBJECT]     = (uint8_t)E_K_CMD_ID_DELETE_OBJECT,
+  [E_K_ICPP_PARSER_CMD_TAG_DELETE_KEY_OBJECT]     = (uint8_t)E_K_CMD_ID_DELETE_KEY_OBJECT,
+  [E_K_ICPP_PARSER_CMD_TAG_SET_OBJ_WITH_ASSOCIATION] =
+    (uint8_t)E_K_CMD_ID_SET_OBJ_WITH_ASSOCIATION,
+  [E_K_ICPP_PARSER_CMD_TAG_GET_CHALLENGE]         = (uint8_t)E_K_CMD_ID_GET_CHALLENGE,
+#ifdef FOTA_ENABLE
+  [E_K_ICPP_PARSER_CMD_TAG_INSTALL_FOTA]          = (uint8_t)E_K_CMD_ID_INSTALL_FOTA,
+  [E_K_ICPP_PARSER_CMD_TAG_GET_FOTA_STATUS]       = (uint8_t)E_K_CMD_ID_GET_FOTA_STATUS,
+#endif /* FOTA_ENABLE */
+#endif /* OBJECT_MANAGEMENT_FEATURE */
+};
+
 /* -------------------------------------------------------------------------- */
 /* PUBLIC VARIABLES                                                           */
 /* -------------------------------------------------------------------------- */
@@ -505,16 +1040,10 @@ TKStatus ktaCmdProcess
 {
   TKIcppProtocolMessage sendProtoMessage;
   TKStatus status           = E_K_STATUS_ERROR;
-#ifdef OBJECT_MANAGEMENT_FEATURE
-  uint8_t aPlatformStatus[4] = {0};
-  uint8_t aCmdResponse[C_K__ICPP_CMD_RESPONSE_SIZE_VENDOR_SPECIFIC] = {0};
-  size_t  cmdResponseSize = sizeof(aCmdResponse);
-#else
-  uint8_t aCmdResponse[C_K_ICPP_PARSER_MAX_COUNT_THIRDPARTY_ERROR_SIZE] = {0};
-  size_t  cmdResponseSize = C_K_ICPP_PARSER_MAX_COUNT_THIRDPARTY_ERROR_SIZE;
-#endif
+  TKCmdContext context = {0};
 
   M_KTALOG__START("Start");
+  M_KTABENCH__START(E_KTABENCH_PHASE_COMMAND);
 
   // REQ RQ_M-KTA-STRT-FN-0300(1) : Input Parameters Check.
   if ((NULL == xpRecvdProtoMessage) || (NULL == xpMessageToSend) || (NULL == xpMessageToSendSize)
@@ -533,72 +1062,15 @@ TKStatus ktaCmdProcess
       goto end;
     }
 
-    /* Fill the message type with "E_K_ICCP_PARSER_MESSAGE_TYPE_RESPONSE" to indicate it is
-       registration notification message type (client -> server). */
-    // REQ RQ_M-KTA-OBJM-FN-0100_03(1) : message type
-    // REQ RQ_M-KTA-TRDP-FN-0110_03(1) : Third Party Response message type
-    sendProtoMessage.msgType  = E_K_ICPP_PARSER_MESSAGE_TYPE_RESPONSE;
-    // REQ RQ_M-KTA-OBJM-FN-0100_01(1) : crypto version
-    // REQ RQ_M-KTA-OBJM-FN-0080(1) : Crypto version from keySTEREAM in Generate key pair.
-    // REQ RQ_M-KTA-OBJM-FN-0280(1) : Crypto version from keySTEREAM in Set Object.
-    // REQ RQ_M-KTA-OBJM-FN-0580(1) : Crypto version from keySTEREAM in Delete Object.
-    // REQ RQ_M-KTA-OBJM-FN-0780(1) : Crypto version from keySTEREAM in
-    // Set Object With Association.
-    // REQ RQ_M-KTA-OBJM-FN-0980(2) : Crypto version from keySTEREAM in Delete Key Object */
-    // REQ RQ_M-KTA-TRDP-FN-0080(1) : Crypto version from keySTEREAM in Third Party.
-    // REQ RQ_M-KTA-TRDP-FN-0110_01(1) : Third Party Response crypto version.
-    sendProtoMessage.cryptoVersion = xpRecvdProtoMessage->cryptoVersion;
-    // REQ RQ_M-KTA-OBJM-FN-0100_02(1) : partial encryption mode
-    // REQ RQ_M-KTA-TRDP-FN-0110_02(1) : Third Party Response partial encryption mode
-    sendProtoMessage.encMode = xpRecvdProtoMessage->encMode;
-    // REQ RQ_M-KTA-OBJM-FN-0100_06(1) : rot public uid
-    // REQ RQ_M-KTA-TRDP-FN-0110_06(1) : Third Party Response rot public uid
-    (void)memcpy(sendProtoMessage.rotPublicUID,
-                 xpRecvdProtoMessage->rotPublicUID,
-                 C_K_ICPP_PARSER__ROT_PUBLIC_UID_SIZE_IN_BYTES);
-    // REQ RQ_M-KTA-OBJM-FN-0100_04(1) : transaction id
-    // REQ RQ_M-KTA-TRDP-FN-0110_04(1) : Third Party Response transaction id
-    (void)memcpy(sendProtoMessage.transactionId, xpRecvdProtoMessage->transactionId,
-                 C_K_ICPP_PARSER__TRANSACTION_ID_SIZE_IN_BYTES);
-    // REQ RQ_M-KTA-OBJM-FN-0100_05(1) : rot key set id
-    // REQ RQ_M-KTA-TRDP-FN-0110_05(1) : Third Party Response rot key set id
-    sendProtoMessage.rotKeySetId = xpRecvdProtoMessage->rotKeySetId;
-
-    status = lProcessCmdPrepareResponse(xpRecvdProtoMessage,
-                                        &sendProtoMessage,
-                                        aCmdResponse,
-                                        cmdResponseSize
-#ifdef OBJECT_MANAGEMENT_FEATURE
-                                        , (uint8_t*)&aPlatformStatus
-#endif
-                                       );
-
-#ifdef FOTA_ENABLE
-    // Check for command tags A0 and A1
-    bool fotaTagFound = false;
-
-    for (size_t i = 0; i < xpRecvdProtoMessage->commandsCount; i++)
-    {
-      if ((xpRecvdProtoMessage->commands[i].commandTag == E_K_ICPP_PARSER_CMD_TAG_INSTALL_FOTA) ||
-          (xpRecvdProtoMessage->commands[i].commandTag == E_K_ICPP_PARSER_CMD_TAG_GET_FOTA_STATUS))
-      {
-        fotaTagFound = true;
-        break;
-      }
-    }
+    lPrepareResponseHeader(xpRecvdProtoMessage, &sendProtoMessage);
+    status = lProcessCommands(xpRecvdProtoMessage,
+                              &sendProtoMessage,
+                              &context);
 
-    if (E_K_STATUS_OK != status && !fotaTagFound)
-    {
-      M_KTALOG__ERR("Processing command or preparing response failed, status = [%d]", status);
-      goto end;
-    }
-#else
     if (E_K_STATUS_OK != status)
     {
-      M_KTALOG__ERR("Processing command or preparing response failed, status = [%d]", status);
       goto end;
     }
-#endif // FOTA_ENABLE
 
     status = ktaGenerateResponse((C_GEN__SERIALIZE | C_GEN__PADDING |
                                   C_GEN__ENCRYPT | C_GEN__SIGNING),
@@ -614,6 +1086,151 @@ TKStatus ktaCmdProcess
   }
 
 end:
+  M_KTABENCH__END(E_KTABENCH_PHASE_COMMAND);
+  M_KTALOG__END("End, status : %d", status);
+  return status;
+}
+
+/**
+ * @brief implement ktaCmdCheckSegmented
+ *
+ */
+TKParserStatus ktaCmdCheckSegmented
+(
+  const TKCmdSegmentedMsg* xpSegmentedMsg,
+  TKIcppProtocolMessage*   xpRecvdProtoMessage
+)
+{
+  TKParserStatus parserStatus = E_K_ICPP_PARSER_STATUS_PARAMETER;
+  size_t         offset = 0;
+  size_t         commandSize = 0;
+
+  M_KTALOG__START("Start");
+
+  if ((NULL != xpSegmentedMsg) && (NULL != xpRecvdProtoMessage))
+  {
+    parserStatus = E_K_ICPP_PARSER_STATUS_OK;
+
+    /* Nothing is processed before the whole message is known to be well formed. */
+    while ((E_K_ICPP_PARSER_STATUS_OK == parserStatus) &&
+           (offset < xpSegmentedMsg->clearDataLen))
+    {
+      parserStatus = lDecryptNextCommand(xpSegmentedMsg, offset, xpRecvdProtoMessage,
+                                         &commandSize);
+      offset += commandSize;
+    }
+  }
+
+  M_KTALOG__END("End, parserStatus : %d", parserStatus);
+  return parserStatus;
+}
+
+/**
+ * @brief implement ktaCmdProcessSegmented
+ *
+ */
+/**
+ * SUPPRESS: MISRA_DEV_KTA_005 : misra_c2012_rule_15.4_violation
+ * SUPPRESS: MISRA_DEV_KTA_004 : misra_c2012_rule_15.1_violation
+ * Using goto for breaking during the error and return cases.
+ **/
+TKStatus ktaCmdProcessSegmented
+(
+  TKIcppProtocolMessage*   xpRecvdProtoMessage,
+  const TKCmdSegmentedMsg* xpSegmentedMsg,
+  uint8_t*                 xpMessageToSend,
+  size_t*                  xpMessageToSendSize
+)
+{
+  TKIcppProtocolMessage sendProtoMessage;
+  TKStatus status           = E_K_STATUS_ERROR;
+  size_t   offset           = 0;
+  size_t   commandSize      = 0;
+  size_t   serializedLen    = 0;
+  size_t   responseLen      = 0;
+  TKCmdContext context = {0};
+
+  M_KTALOG__START("Start");
+  M_KTABENCH__START(E_KTABENCH_PHASE_COMMAND);
+
+  if ((NULL == xpRecvdProtoMessage) || (NULL == xpSegmentedMsg) ||
+      (NULL == xpMessageToSend) || (NULL == xpMessageToSendSize) ||
+      (C_K_ICPP_PARSER_HEADER_SIZE > *xpMessageToSendSize))
+  {
+    status = E_K_STATUS_PARAMETER;
+    M_KTALOG__ERR("Invalid parameter passed");
+    goto end;
+  }
+
+  if ((uint8_t)E_K_ICPP_PARSER_CRYPTO_TYPE_L2_BASED != xpRecvdProtoMessage->cryptoVersion)
+  {
+    M_KTALOG__ERR("Invalid crypto version received from the server, cryptoVersion = [%d]",
+                  xpRecvdProtoMessage->cryptoVersion);
+    goto end;
+  }
+
+  /* Header first, each response is serialized after it as soon as it is prepared. */
+  lPrepareResponseHeader(xpRecvdProtoMessage, &sendProtoMessage);
+  sendProtoMessage.commandsCount = 0;
+  responseLen = *xpMessageToSendSize;
+
+  if (E_K_ICPP_PARSER_STATUS_OK != ktaIcppParserSerializeMessage(&sendProtoMessage,
+                                                                  xpMessageToSend,
+                                                                  &responseLen))
+  {
+    M_KTALOG__ERR("ICCP parser serialization of header got failed");
+    goto end;
+  }
+
+  while (offset < xpSegmentedMsg->clearDataLen)
+  {
+    if (E_K_ICPP_PARSER_STATUS_OK != lDecryptNextCommand(xpSegmentedMsg,
+                                                         offset,
+                                                         xpRecvdProtoMessage,
+                                                         &commandSize))
+    {
+      status = E_K_STATUS_ERROR;
+      M_KTALOG__ERR("Command at [%d] could not be decrypted", offset);
+      goto end;
+    }
+
+    (void)memset(&sendProtoMessage.commands[0], 0, sizeof(sendProtoMessage.commands[0]));
+
+    /* As in ktaCmdProcess, a failed command still gets its response and the next commands
+     * are processed; the status of the last command decides whether the response is sent. */
+    status = lProcessCommands(xpRecvdProtoMessage,
+                              &sendProtoMessage,
+                              &context);
+
+    serializedLen = *xpMessageToSendSize - responseLen;
+
+    if (E_K_ICPP_PARSER_STATUS_OK != ktaIcppParserSerializeCommands(&sendProtoMessage,
+                                                                     &xpMessageToSend[responseLen],
+                                                                     &serializedLen))
+    {
+      status = E_K_STATUS_ERROR;
+      M_KTALOG__ERR("ICCP parser serialization of response got failed");
+      goto end;
+    }
+
+    responseLen += serializedLen;
+    offset += commandSize;
+  }
+
+  if (E_K_STATUS_OK != status)
+  {
+    goto end;
+  }
+
+  status = ktaPadEncryptAndSignResponse(xpMessageToSend, responseLen, xpMessageToSendSize);
+
+  if (E_K_STATUS_OK != status)
+  {
+    M_KTALOG__ERR("ktaPadEncryptAndSignResponse failed, status = [%d]", status);
+  }
+
+end:
+  M_KTABENCH__END(E_KTABENCH_PHASE_COMMAND);
   M_KTALOG__END("End, status : %d", status);
   return status;
 }
@@ -1184,7 +1801,8 @@ end:
 static TKStatus lKtaSetObject
 (
   TKIcppProtocolMessage* xpData,
-  uint8_t*               xpPlatformStatus
+  uint8_t*               xpPlatformStatus,
+  uint32_t               xCmdCount
 )
 {
   TKStatus status = E_K_STATUS_ERROR;
@@ -1193,7 +1811,7 @@ static TKStatus lKtaSetObject
   M_KTALOG__DEBUG("Processing SetObject specific data...");
 
   // REQ RQ_M-KTA-OBJM-FN-0270(1) : Check set object data
-  if (E_K_STATUS_OK != lKtaCmdValidateAndGetPayload(xpData, &resPayload, 0))
+  if (E_K_STATUS_OK != lKtaCmdValidateAndGetPayload(xpData, &resPayload, xCmdCount))
   {
     /* Original error status lost here on purpose of code size optimization. */
     M_KTALOG__ERR("Getting field identifier, data attributes and object owner failed");
@@ -1441,585 +2059,905 @@ static TKStatus lProcessCmdPrepareResponse
 (
   TKIcppProtocolMessage* xpRecvdProtoMessage,
   TKIcppProtocolMessage* xpSendProtoMessage,
-  uint8_t*               xpCmdResponse,
-  uint32_t               xCmdItemSize
-#ifdef OBJECT_MANAGEMENT_FEATURE
-  , uint8_t*              xpPlatformStatus
-#endif
+  TKCmdContext*          xpContext
 )
 {
-  TKStatus status                                       = E_K_STATUS_ERROR;
-  size_t commandCount                                   = 0;
-  size_t dataSize                                       = 0;
-  uint8_t challenge[C_K_ICPP_PARSER_KTA_CHALLENGE_SIZE] = {0};
-#ifdef FOTA_ENABLE
-  TKFotaStatus fotaStatus                               = E_K_FOTA_ERROR;
-  uint8_t fotaNameLen                                   = 0;
-  uint8_t fieldIndex                                    = 0;
-  uint8_t errorCode                                     = 0;
-  uint8_t fotaErrorCause[CURRENT_MAX_LENGTH]            = {0};
-  TFotaError fotaError                                  = {0};
-
-  fotaError.fotaErrorCause                              = (uint8_t *)&fotaErrorCause;
-  fotaError.fotaErrorCauseLen                           = sizeof(fotaErrorCause);
-  fotaError.fotaErrorCode                               = (uint8_t *)&errorCode;
-  fotaError.fotaErrorCodeLen                            = ERROR_CODE_LEN;
-  TComponent components[COMPONENTS_MAX]                 = {0};
-  uint8_t fotaName[CURRENT_MAX_LENGTH]                  = {0};
-#endif // FOTA_ENABLE
+  TKStatus               status      = E_K_STATUS_ERROR;
+  size_t                 commandCount = 0;
+  TKIcppCommandTag       commandTag  = E_K_ICPP_PARSER_COMMAND_TAG_ACTIVATION;
+  const TKCmdDescriptor* pDescriptor = NULL;
+  TKIcppCommand*         pResponse   = NULL;
 
-  if ((NULL == xpRecvdProtoMessage) || (NULL == xpSendProtoMessage) ||
-      (NULL == xpCmdResponse) || (0u == xCmdItemSize)
-#ifdef OBJECT_MANAGEMENT_FEATURE
-      || (NULL == xpPlatformStatus))
-#else
-      )
-#endif
+  if ((NULL == xpRecvdProtoMessage) || (NULL == xpSendProtoMessage) || (NULL == xpContext))
   {
     status = E_K_STATUS_PARAMETER;
   }
   else
   {
-    xpCmdResponse[0] = 0;
+    xpContext->aCmdResponse[0] = 0;
+    xpContext->cmdResponseLen = 0;
     xpSendProtoMessage->commandsCount = xpRecvdProtoMessage->commandsCount;
+
     for (commandCount = 0; commandCount < xpRecvdProtoMessage->commandsCount; commandCount++)
     {
-      switch (xpRecvdProtoMessage->commands[commandCount].commandTag)
+      commandTag = xpRecvdProtoMessage->commands[commandCount].commandTag;
+      pDescriptor = M_K_CMD_GET_DESCRIPTOR(commandTag);
+
+      if (NULL == pDescriptor->pfHandler)
       {
-#ifdef PLATFORM_PROCESS_FEATURE
+        M_KTALOG__ERR("Received invalid command tag, cmdTag = [%x]", commandTag);
+        continue;
+      }
 
-        // REQ RQ_M-KTA-TRDP-FN-0010(1) : Verify Third party Signature
-        // REQ RQ_M-KTA-TRDP-FN-0110(1) : Third party response ICPP Message
-        case E_K_ICPP_PARSER_COMMAND_TAG_THIRD_PARTY:
-        {
-          dataSize = xCmdItemSize;
-          // REQ RQ_M-KTA-TRDP-FN-0070(1) : Check third party data
-          status = lKtaSetThirdPartyData(
-                     xpRecvdProtoMessage->commands[commandCount].data.cmdInfo.cmdValue,
-                     xpRecvdProtoMessage->commands[commandCount].data.cmdInfo.cmdLen,
-                     xpCmdResponse, &dataSize);
-
-          if (E_K_STATUS_OK == status)
-          {
-            /**
-             * Set the command tag with "E_K_ICCP_PARSER_COMMAND_TAG_THIRD_PARTY_FIELD"
-             * to indicated the the command is for third party data.
-             */
-            // REQ RQ_M-KTA-TRDP-FN-0090(1) : Build Third party response
-            // REQ RQ_M-KTA-TRDP-FN-0100(1) : Third party response data order.
-            xpSendProtoMessage->commands[commandCount].commandTag =
-              E_K_ICPP_PARSER_COMMAND_TAG_THIRD_PARTY;
-            xpSendProtoMessage->commands[commandCount].data.cmdInfo.cmdValue = xpCmdResponse;
-            xpSendProtoMessage->commands[commandCount].data.cmdInfo.cmdLen = dataSize;
-            xpCmdResponse += dataSize;
-          }
-          else
-          {
-            M_KTALOG__ERR("Setting 3rd party data failed, status = [%d]", status);
-            break;
-          }
-        }
-        break;
-#endif /* PLATFORM_PROCESS_FEATURE */
+      pResponse = &xpSendProtoMessage->commands[commandCount];
+      pResponse->commandTag = commandTag;
 
 #ifdef OBJECT_MANAGEMENT_FEATURE
+      if (0u != pDescriptor->responseFieldsCount)
+      {
+        // REQ RQ_M-KTA-OBJM-FN-0090_01(1) : Command Processing Status
+        // REQ RQ_M-KTA-OBJM-FN-0290_01(1) : Command Processing Status
+        // REQ RQ_M-KTA-OBJM-FN-0590_01(1) : Command Processing Status
+        pResponse->data.fieldList.fieldsCount = pDescriptor->responseFieldsCount;
+        pResponse->data.fieldList.fields[0].fieldTag =
+          E_K_ICPP_PARSER_FIELD_TAG_CMD_PROCESSING_STATUS;
+        pResponse->data.fieldList.fields[0].fieldLen =
+          C_K_ICPP_PARSER_PROCESSING_STATUS_FIELD_LENGTH;
+        pResponse->data.fieldList.fields[0].fieldValue =
+          xpContext->aPlatformStatus[commandCount];
+      }
+#endif /* OBJECT_MANAGEMENT_FEATURE */
 
-        // REQ RQ_M-KTA-OBJM-FN-0100(1) : Generate key pair ICPP Message
-        case E_K_ICPP_PARSER_COMMAND_TAG_GENERATE_KEY_PAIR:
-        {
-          dataSize = xCmdItemSize;
-          // REQ RQ_M-KTA-OBJM-FN-0010(1) : Verify Generate Key Pair Signature
-          status = lKtaGenerateKeyPair(
-                     xpRecvdProtoMessage, xpCmdResponse,
-                     &dataSize, xpPlatformStatus, (uint8_t)commandCount);
-          /**
-           * Set the command tag with "E_K_ICPP_PARSER_COMMAND_TAG_GENERATE_KEY_PAIR"
-           * to indicate that this command is to generate the key pair.
-           */
-          // REQ RQ_M-KTA-OBJM-FN-0090(1) : Build Generate key pair response
-          xpSendProtoMessage->commands[commandCount].commandTag =
-            E_K_ICPP_PARSER_COMMAND_TAG_GENERATE_KEY_PAIR;
-          xpSendProtoMessage->commands[commandCount].data.fieldList.fieldsCount = 2;
-          xpSendProtoMessage->commands[commandCount].data.fieldList.fields[0].fieldTag =
-            E_K_ICPP_PARSER_FIELD_TAG_CMD_PROCESSING_STATUS;
-          xpSendProtoMessage->commands[commandCount].data.fieldList.fields[0].fieldLen =
-            C_K_ICPP_PARSER_PROCESSING_STATUS_FIELD_LENGTH;
-          // REQ RQ_M-KTA-OBJM-FN-0090_01(1) : Command Processing Status
-          // REQ RQ_M-KTA-OBJM-FN-0290_01(1) : Command Processing Status
-          // REQ RQ_M-KTA-OBJM-FN-0590_01(1) : Command Processing Status
-          xpSendProtoMessage->commands[commandCount].data.fieldList.fields[0].fieldValue =
-            (uint8_t*)xpPlatformStatus;
-          // REQ RQ_M-KTA-OBJM-FN-0090_02(1) : Public Key
-          // REQ RQ_M-KTA-OBJM-FN-0090_03(1) : Signed public key
-          xpSendProtoMessage->commands[commandCount].data.fieldList.fields[1].fieldTag =
-            (TKIcppFieldTag)C_K__ICPP_FIELD_TAG_PUB_KEY_VENDOR_SPECIFIC;
-
-          if (E_K_STATUS_OK == status)
-          {
-            xpSendProtoMessage->commands[commandCount].data.fieldList.fields[1].fieldLen =
-              dataSize;
-            xpSendProtoMessage->commands[commandCount].data.fieldList.fields[1].fieldValue =
-              xpCmdResponse;
-          }
-          else
-          {
-            M_KTALOG__ERR("Generate Key Pair command failed with status : [%d], setting field data to 0", status);
-            xpSendProtoMessage->commands[commandCount].data.fieldList.fields[1].fieldLen = 0;
-            xpSendProtoMessage->commands[commandCount].data.fieldList.fields[1].fieldValue = NULL;
-          }
-        }
-        break;
+#ifndef PARALLEL_COMMANDS_FEATURE
+      status = pDescriptor->pfHandler(xpRecvdProtoMessage, commandCount, pResponse, xpContext);
+#endif /* PARALLEL_COMMANDS_FEATURE */
+    }
 
-        // REQ RQ_M-KTA-OBJM-FN-0300(1) : Set Object ICPP Message
-        case E_K_ICPP_PARSER_COMMAND_TAG_SET_OBJECT:
-        {
-          // REQ RQ_M-KTA-OBJM-FN-0210(1) : Verify Set Object Signature
-          status = lKtaSetObject(xpRecvdProtoMessage, xpPlatformStatus);
-
-          /**
-           * Set the command tag with "E_K_ICPP_PARSER_COMMAND_TAG_SET_OBJECT"
-           * to indicate that this command is to set the data object.
-           */
-          // REQ RQ_M-KTA-OBJM-FN-0290(1) : Build Set Object response
-          xpSendProtoMessage->commands[commandCount].commandTag =
-            E_K_ICPP_PARSER_COMMAND_TAG_SET_OBJECT;
-          xpSendProtoMessage->commands[commandCount].data.fieldList.fieldsCount = 1;
-          xpSendProtoMessage->commands[commandCount].data.fieldList.fields[0].fieldTag =
-            E_K_ICPP_PARSER_FIELD_TAG_CMD_PROCESSING_STATUS;
-          xpSendProtoMessage->commands[commandCount].data.fieldList.fields[0].fieldLen =
-            C_K_ICPP_PARSER_PROCESSING_STATUS_FIELD_LENGTH;
-          if (E_K_STATUS_OK == status)
-          {
-            xpSendProtoMessage->commands[commandCount].data.fieldList.fields[0].fieldValue =
-            (uint8_t*)xpPlatformStatus;
-          }
-          else
-          {
-            M_KTALOG__ERR("Set object command failed with status = [%d]", status);
-          }
-        }
-        break;
+#ifdef PARALLEL_COMMANDS_FEATURE
+    status = lExecuteCommands(xpRecvdProtoMessage, xpSendProtoMessage, xpContext);
+#endif /* PARALLEL_COMMANDS_FEATURE */
+  }
+  return status;
+}
 
-        // REQ RQ_M-KTA-OBJM-FN-0600(1) : Delete Object ICPP Message
-        case E_K_ICPP_PARSER_COMMAND_TAG_DELETE_OBJECT:
-        {
-          // REQ RQ_M-KTA-OBJM-FN-0510(1) : Verify Delete Object Signature
-          status = lKtaDeleteObject(xpRecvdProtoMessage, xpPlatformStatus, commandCount);
-
-          /**
-           * Set the command tag with "E_K_ICPP_PARSER_COMMAND_TAG_DELETE_OBJECT"
-           * to indicate that this command is to delete the certificate object from device.
-           */
-          // REQ RQ_M-KTA-OBJM-FN-0590(1) : Build Delete Object response
-          xpSendProtoMessage->commands[commandCount].commandTag =
-            E_K_ICPP_PARSER_COMMAND_TAG_DELETE_OBJECT;
-          xpSendProtoMessage->commands[commandCount].data.fieldList.fieldsCount = 1;
-          xpSendProtoMessage->commands[commandCount].data.fieldList.fields[0].fieldTag =
-            E_K_ICPP_PARSER_FIELD_TAG_CMD_PROCESSING_STATUS;
-          xpSendProtoMessage->commands[commandCount].data.fieldList.fields[0].fieldLen =
-            C_K_ICPP_PARSER_PROCESSING_STATUS_FIELD_LENGTH;
-          // REQ RQ_M-KTA-OBJM-FN-0561_11(1) : Command Processing Status
-          if (E_K_STATUS_OK == status)
-          {
-            xpSendProtoMessage->commands[commandCount].data.fieldList.fields[0].fieldValue =
-            (uint8_t*)xpPlatformStatus;
-          }
-          else
-          {
-            M_KTALOG__ERR("Delete object command failed with status = [%d]", status);
-          }
-        }
-        break;
+#ifdef PLATFORM_PROCESS_FEATURE
+/**
+ * @implements lCmdThirdParty
+ *
+ */
+static TKStatus lCmdThirdParty
+(
+  TKIcppProtocolMessage* xpRecvdProtoMessage,
+  size_t                 xCommandIndex,
+  TKIcppCommand*         xpResponse,
+  TKCmdContext*          xpContext
+)
+{
+  TKStatus status   = E_K_STATUS_ERROR;
+  uint8_t* pData    = &xpContext->aCmdResponse[xpContext->cmdResponseLen];
+  size_t   dataSize = sizeof(xpContext->aCmdResponse) - xpContext->cmdResponseLen;
+
+  // REQ RQ_M-KTA-TRDP-FN-0010(1) : Verify Third party Signature
+  // REQ RQ_M-KTA-TRDP-FN-0110(1) : Third party response ICPP Message
+  // REQ RQ_M-KTA-TRDP-FN-0070(1) : Check third party data
+  status = lKtaSetThirdPartyData(
+             xpRecvdProtoMessage->commands[xCommandIndex].data.cmdInfo.cmdValue,
+             xpRecvdProtoMessage->commands[xCommandIndex].data.cmdInfo.cmdLen,
+             pData, &dataSize);
+
+  if (E_K_STATUS_OK == status)
+  {
+    /**
+     * The command tag "E_K_ICCP_PARSER_COMMAND_TAG_THIRD_PARTY_FIELD"
+     * indicates the the command is for third party data.
+     */
+    // REQ RQ_M-KTA-TRDP-FN-0090(1) : Build Third party response
+    // REQ RQ_M-KTA-TRDP-FN-0100(1) : Third party response data order.
+    xpResponse->data.cmdInfo.cmdValue = pData;
+    xpResponse->data.cmdInfo.cmdLen = dataSize;
+    xpContext->cmdResponseLen += dataSize;
+  }
+  else
+  {
+    M_KTALOG__ERR("Setting 3rd party data failed, status = [%d]", status);
+  }
 
-        // REQ RQ_M-KTA-OBJM-FN-1000(2) : Delete Key Object ICPP Message
-        case E_K_ICPP_PARSER_CMD_TAG_DELETE_KEY_OBJECT:
-        {
-          // REQ RQ_M-KTA-OBJM-FN-0910(2) : Verify Delete Key Object Signature
-          status = lKtaDeleteKeyObject(xpRecvdProtoMessage, xpPlatformStatus, commandCount);
-
-          /**
-           * Set the command tag with "E_K_ICPP_PARSER_CMD_TAG_DELETE_KEY_OBJECT"
-           * to indicate that this command is to delete the key object from device.
-           */
-          // REQ RQ_M-KTA-OBJM-FN-0990(2) : Build Delete Key Object response
-          xpSendProtoMessage->commands[commandCount].commandTag =
-            E_K_ICPP_PARSER_CMD_TAG_DELETE_KEY_OBJECT;
-          xpSendProtoMessage->commands[commandCount].data.fieldList.fieldsCount = 1;
-          xpSendProtoMessage->commands[commandCount].data.fieldList.fields[0].fieldTag =
-            E_K_ICPP_PARSER_FIELD_TAG_CMD_PROCESSING_STATUS;
-          xpSendProtoMessage->commands[commandCount].data.fieldList.fields[0].fieldLen =
-            C_K_ICPP_PARSER_PROCESSING_STATUS_FIELD_LENGTH;
-          // REQ RQ_M-KTA-OBJM-FN-0990_01(2) : Command Processing Status
-          if (E_K_STATUS_OK == status)
-          {
-            xpSendProtoMessage->commands[commandCount].data.fieldList.fields[0].fieldValue =
-            (uint8_t*)xpPlatformStatus;
-          }
-          else
-          {
-            M_KTALOG__ERR("Delete key object command failed with status = [%d]", status);
-          }
-        }
-        break;
+  return status;
+}
+#endif /* PLATFORM_PROCESS_FEATURE */
 
-        // REQ RQ_M-KTA-OBJM-FN-0800(1) : Set Object With Association ICPP Message
-        case E_K_ICPP_PARSER_CMD_TAG_SET_OBJ_WITH_ASSOCIATION:
-        {
-          // REQ RQ_M-KTA-OBJM-FN-0710(1) : Verify Set Object with Association Signature
-          status = lKtaSetObjWithAssociation(xpRecvdProtoMessage, xpPlatformStatus);
-
-          /**
-           * Set the command tag with "E_K_ICPP_PARSER_CMD_TAG_SET_OBJ_WITH_ASSOCIATION"
-           * to indicate that this command is for setting the association info data.
-           */
-          // REQ RQ_M-KTA-OBJM-FN-0790(1) : Build Set Object With Association response
-          xpSendProtoMessage->commands[commandCount].commandTag =
-            E_K_ICPP_PARSER_CMD_TAG_SET_OBJ_WITH_ASSOCIATION;
-          xpSendProtoMessage->commands[commandCount].data.fieldList.fieldsCount = 1;
-          xpSendProtoMessage->commands[commandCount].data.fieldList.fields[0].fieldTag =
-            E_K_ICPP_PARSER_FIELD_TAG_CMD_PROCESSING_STATUS;
-          xpSendProtoMessage->commands[commandCount].data.fieldList.fields[0].fieldLen =
-            C_K_ICPP_PARSER_PROCESSING_STATUS_FIELD_LENGTH;
-          // REQ RQ_M-KTA-OBJM-FN-0790_01(1) : Command Processing Status
-          if (E_K_STATUS_OK == status)
-          {
-            xpSendProtoMessage->commands[commandCount].data.fieldList.fields[0].fieldValue =
-            (uint8_t*)xpPlatformStatus;
-          }
-          else
-          {
-            M_KTALOG__ERR("Set object with association command failed with status = [%d]", status);
-          }
-        }
-        break;
+#ifdef OBJECT_MANAGEMENT_FEATURE
+/**
+ * @implements lCmdGenerateKeyPair
+ *
+ */
+static TKStatus lCmdGenerateKeyPair
+(
+  TKIcppProtocolMessage* xpRecvdProtoMessage,
+  size_t                 xCommandIndex,
+  TKIcppCommand*         xpResponse,
+  TKCmdContext*          xpContext
+)
+{
+  TKStatus status   = E_K_STATUS_ERROR;
+#ifdef PARALLEL_COMMANDS_FEATURE
+  /* Key pairs of one message may be generated concurrently, each has its own buffer. */
+  uint8_t* pData    = xpContext->aKeyPairResponse[xCommandIndex];
+  size_t   dataSize = sizeof(xpContext->aKeyPairResponse[xCommandIndex]);
+#else
+  uint8_t* pData    = &xpContext->aCmdResponse[xpContext->cmdResponseLen];
+  size_t   dataSize = sizeof(xpContext->aCmdResponse) - xpContext->cmdResponseLen;
+#endif /* PARALLEL_COMMANDS_FEATURE */
+
+  // REQ RQ_M-KTA-OBJM-FN-0100(1) : Generate key pair ICPP Message
+  // REQ RQ_M-KTA-OBJM-FN-0010(1) : Verify Generate Key Pair Signature
+  status = lKtaGenerateKeyPair(xpRecvdProtoMessage, pData, &dataSize,
+                               xpContext->aPlatformStatus[xCommandIndex], (uint8_t)xCommandIndex);
+
+  // REQ RQ_M-KTA-OBJM-FN-0090(1) : Build Generate key pair response
+  // REQ RQ_M-KTA-OBJM-FN-0090_02(1) : Public Key
+  // REQ RQ_M-KTA-OBJM-FN-0090_03(1) : Signed public key
+  xpResponse->data.fieldList.fields[1].fieldTag =
+    (TKIcppFieldTag)C_K__ICPP_FIELD_TAG_PUB_KEY_VENDOR_SPECIFIC;
+
+  if (E_K_STATUS_OK == status)
+  {
+    xpResponse->data.fieldList.fields[1].fieldLen = dataSize;
+    xpResponse->data.fieldList.fields[1].fieldValue = pData;
+#ifndef PARALLEL_COMMANDS_FEATURE
+    xpContext->cmdResponseLen += dataSize;
+#endif /* PARALLEL_COMMANDS_FEATURE */
+  }
+  else
+  {
+    M_KTALOG__ERR("Generate Key Pair command failed with status : [%d], setting field data to 0", status);
+    xpResponse->data.fieldList.fields[1].fieldLen = 0;
+    xpResponse->data.fieldList.fields[1].fieldValue = NULL;
+  }
 
-        // REQ RQ_M-KTA-OBJM-FN-0880(1) : Get challenge With ICPP Message
-        case E_K_ICPP_PARSER_CMD_TAG_GET_CHALLENGE:
-        {
-          // REQ RQ_M-KTA-OBJM-FN-0850(1) : Verify Get challenge
-          status = lKtaGetChallenge(challenge, xpPlatformStatus);
-
-          /**
-           * Set the command tag with "E_K_ICPP_PARSER_CMD_TAG_GET_CHALLENGE"
-           * to indicate that this command is for getting chalenge from device.
-           */
-          // REQ RQ_M-KTA-OBJM-FN-0890(1) : Build Get Challenege Response
-          xpSendProtoMessage->commands[commandCount].commandTag =
-            E_K_ICPP_PARSER_CMD_TAG_GET_CHALLENGE;
-          xpSendProtoMessage->commands[commandCount].data.fieldList.fieldsCount = 2;
-          xpSendProtoMessage->commands[commandCount].data.fieldList.fields[0].fieldTag =
-            E_K_ICPP_PARSER_FIELD_TAG_CMD_PROCESSING_STATUS;
-          xpSendProtoMessage->commands[commandCount].data.fieldList.fields[0].fieldLen =
-            C_K_ICPP_PARSER_PROCESSING_STATUS_FIELD_LENGTH;
-
-          xpSendProtoMessage->commands[commandCount].data.fieldList.fields[1].fieldTag =
-            E_K_ICPP_PARSER_FIELD_TAG_CHALLENGE;
-          xpSendProtoMessage->commands[commandCount].data.fieldList.fields[1].fieldLen =
-            C_K_ICPP_PARSER_KTA_CHALLENGE_SIZE;
-
-          // REQ RQ_M-KTA-OBJM-FN-0910_01(1) : Command Processing Status
-          if (E_K_STATUS_OK == status)
-          {
-            xpSendProtoMessage->commands[commandCount].data.fieldList.fields[0].fieldValue =
-            (uint8_t*)xpPlatformStatus;
-            xpSendProtoMessage->commands[commandCount].data.fieldList.fields[1].fieldValue =
-            (uint8_t*)challenge;
-          }
-          else
-          {
-            M_KTALOG__ERR("Get Challenge command failed with status = [%d]", status);
-          }
-        }
-        break;
+  return status;
+}
 
-#ifdef FOTA_ENABLE
+/**
+ * @implements lCmdSetObject
+ *
+ */
+static TKStatus lCmdSetObject
+(
+  TKIcppProtocolMessage* xpRecvdProtoMessage,
+  size_t                 xCommandIndex,
+  TKIcppCommand*         xpResponse,
+  TKCmdContext*          xpContext
+)
+{
+  TKStatus status = E_K_STATUS_ERROR;
 
-        case E_K_ICPP_PARSER_CMD_TAG_INSTALL_FOTA:
-        {
-          fotaStatus = lktaInstallFota(xpRecvdProtoMessage, fotaName, &fotaNameLen, components, &fotaError, xpPlatformStatus);
-
-          uint32_t tempStatus = *((uint32_t *)xpPlatformStatus);
-
-          // Swap LSB to MSB
-          uint32_t platformStatusMSB = ((tempStatus & 0x000000FF) << 24) |
-                                       ((tempStatus & 0x0000FF00) << 8)  |
-                                       ((tempStatus & 0x00FF0000) >> 8)  |
-                                       ((tempStatus & 0xFF000000) >> 24);
-
-          xpSendProtoMessage->commands[commandCount].commandTag = E_K_ICPP_PARSER_CMD_TAG_INSTALL_FOTA;
-          xpSendProtoMessage->commands[commandCount].data.fieldList.fieldsCount = 2;
-
-          xpSendProtoMessage->commands[commandCount].data.fieldList.fields[fieldIndex].fieldTag =
-              E_K_ICPP_PARSER_FIELD_TAG_CMD_PROCESSING_STATUS;
-          xpSendProtoMessage->commands[commandCount].data.fieldList.fields[fieldIndex].fieldLen =
-              C_K_ICPP_PARSER_PROCESSING_STATUS_FIELD_LENGTH;
-          xpSendProtoMessage->commands[commandCount].data.fieldList.fields[fieldIndex].fieldValue =
-              (uint8_t*)&platformStatusMSB;
-          fieldIndex++;
-
-          xpSendProtoMessage->commands[commandCount].data.fieldList.fields[fieldIndex].fieldTag =
-              E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA;
-          xpSendProtoMessage->commands[commandCount].data.fieldList.fields[fieldIndex].fieldValue =
-              fotaName;
-          xpSendProtoMessage->commands[commandCount].data.fieldList.fields[fieldIndex].fieldLen =
-              fotaNameLen;
-          fieldIndex++;
-
-          if (E_K_FOTA_ERROR == fotaStatus)
-          {
-            uint32_t errorCodeMSB = ((fotaError.fotaErrorCode[3] & 0x000000FF) << 24) |
-                                    ((fotaError.fotaErrorCode[2] & 0x000000FF) << 16) |
-                                    ((fotaError.fotaErrorCode[1] & 0x000000FF) << 8)  |
-                                    ((fotaError.fotaErrorCode[0] & 0x000000FF));
-
-            xpSendProtoMessage->commands[commandCount].data.fieldList.fields[fieldIndex].fieldTag =
-                E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA_ERROR_CODE;
-            xpSendProtoMessage->commands[commandCount].data.fieldList.fields[fieldIndex].fieldValue =
-                (uint8_t*)&errorCodeMSB;
-            xpSendProtoMessage->commands[commandCount].data.fieldList.fields[fieldIndex].fieldLen =
-                sizeof(fotaError.fotaErrorCode);
-            fieldIndex++;
-
-            xpSendProtoMessage->commands[commandCount].data.fieldList.fields[fieldIndex].fieldTag =
-            E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA_ERROR_CAUSE;
-            xpSendProtoMessage->commands[commandCount].data.fieldList.fields[fieldIndex].fieldValue =
-                (uint8_t*)fotaError.fotaErrorCause;
-            xpSendProtoMessage->commands[commandCount].data.fieldList.fields[fieldIndex].fieldLen =
-                fotaError.fotaErrorCauseLen;
-            fieldIndex++;
-
-            const char* ktaVersion = (const char*)ktaGetVersion();
-
-            xpSendProtoMessage->commands[commandCount].data.fieldList.fields[fieldIndex].fieldTag =
-                E_K_ICPP_PARSER_FIELD_TAG_KTA_VER;
-            xpSendProtoMessage->commands[commandCount].data.fieldList.fields[fieldIndex].fieldValue =
-                (uint8_t*)ktaVersion;
-            xpSendProtoMessage->commands[commandCount].data.fieldList.fields[fieldIndex].fieldLen =
-                strlen(ktaVersion);
-            fieldIndex++;
-
-            for (size_t i = 0; i < COMPONENTS_MAX; i++)
-            {
-              if ((components[i].componentNameLen > 0) && (components[i].componentVersionLen > 0))
-              {
-                xpSendProtoMessage->commands[commandCount].data.fieldList.fields[fieldIndex].fieldTag =
-                    E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA_COMPONENT_TARGET;
-                xpSendProtoMessage->commands[commandCount].data.fieldList.fields[fieldIndex].fieldValue =
-                    (uint8_t*)components[i].componentName;
-                xpSendProtoMessage->commands[commandCount].data.fieldList.fields[fieldIndex].fieldLen =
-                    components[i].componentNameLen;
-                fieldIndex++;
-
-                xpSendProtoMessage->commands[commandCount].data.fieldList.fields[fieldIndex].fieldTag =
-                    E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA_COMPONENT_VERSION;
-                xpSendProtoMessage->commands[commandCount].data.fieldList.fields[fieldIndex].fieldValue =
-                    (uint8_t*)components[i].componentVersion;
-                xpSendProtoMessage->commands[commandCount].data.fieldList.fields[fieldIndex].fieldLen =
-                    components[i].componentVersionLen;
-                fieldIndex++;
-              }
-            }
-            fotaStatus = status;
-          }
-          else if (E_K_FOTA_SUCCESS == fotaStatus)
-          {
-            const char* ktaVersion = (const char*)ktaGetVersion();
+  (void)xpResponse;
+  // REQ RQ_M-KTA-OBJM-FN-0300(1) : Set Object ICPP Message
+  // REQ RQ_M-KTA-OBJM-FN-0210(1) : Verify Set Object Signature
+  // REQ RQ_M-KTA-OBJM-FN-0290(1) : Build Set Object response
+  status = lKtaSetObject(xpRecvdProtoMessage, xpContext->aPlatformStatus[xCommandIndex],
+                         (uint32_t)xCommandIndex);
 
-            xpSendProtoMessage->commands[commandCount].data.fieldList.fields[fieldIndex].fieldTag =
-                E_K_ICPP_PARSER_FIELD_TAG_KTA_VER;
-            xpSendProtoMessage->commands[commandCount].data.fieldList.fields[fieldIndex].fieldValue =
-                (uint8_t*)ktaVersion;
-            xpSendProtoMessage->commands[commandCount].data.fieldList.fields[fieldIndex].fieldLen =
-                strlen(ktaVersion);
-            fieldIndex++;
+  if (E_K_STATUS_OK != status)
+  {
+    M_KTALOG__ERR("Set object command failed with status = [%d]", status);
+  }
 
-            for (size_t i = 0; i < COMPONENTS_MAX; i++)
-            {
-              if ((components[i].componentNameLen > 0) && (components[i].componentVersionLen > 0))
-              {
-                xpSendProtoMessage->commands[commandCount].data.fieldList.fields[fieldIndex].fieldTag =
-                    E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA_COMPONENT_TARGET;
-                xpSendProtoMessage->commands[commandCount].data.fieldList.fields[fieldIndex].fieldValue =
-                    (uint8_t*)components[i].componentName;
-                xpSendProtoMessage->commands[commandCount].data.fieldList.fields[fieldIndex].fieldLen =
-                    components[i].componentNameLen;
-                fieldIndex++;
-
-                xpSendProtoMessage->commands[commandCount].data.fieldList.fields[fieldIndex].fieldTag =
-                    E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA_COMPONENT_VERSION;
-                xpSendProtoMessage->commands[commandCount].data.fieldList.fields[fieldIndex].fieldValue =
-                    (uint8_t*)components[i].componentVersion;
-                xpSendProtoMessage->commands[commandCount].data.fieldList.fields[fieldIndex].fieldLen =
-                    components[i].componentVersionLen;
-                fieldIndex++;
-              }
-            }
-            fotaStatus = status;
-          }
-          else if (E_K_FOTA_IN_PROGRESS == fotaStatus)
-          {
-            M_KTALOG__INFO("FOTA IN PROGRESS\r\n");
-            fotaStatus = status;
-          }
-          else
-          {
-            M_KTALOG__ERR("Install FOTA command failed with status = [%d]\r\n", status);
-          }
+  return status;
+}
 
-          // Update the final field count
-          xpSendProtoMessage->commands[commandCount].data.fieldList.fieldsCount = fieldIndex;
-        }
-        break;
+/**
+ * @implements lCmdDeleteObject
+ *
+ */
+static TKStatus lCmdDeleteObject
+(
+  TKIcppProtocolMessage* xpRecvdProtoMessage,
+  size_t                 xCommandIndex,
+  TKIcppCommand*         xpResponse,
+  TKCmdContext*          xpContext
+)
+{
+  TKStatus status = E_K_STATUS_ERROR;
 
-        case E_K_ICPP_PARSER_CMD_TAG_GET_FOTA_STATUS:
-        {
-          fotaStatus = lktasalfotagetstatus(xpRecvdProtoMessage, fotaName, &fotaNameLen, &fotaError, xpPlatformStatus, components);
-
-          uint32_t tempStatus = *((uint32_t *)xpPlatformStatus);
-
-          // Swap LSB to MSB
-          uint32_t platformStatusMSB = ((tempStatus & 0x000000FF) << 24) |
-                                       ((tempStatus & 0x0000FF00) << 8)  |
-                                       ((tempStatus & 0x00FF0000) >> 8)  |
-                                       ((tempStatus & 0xFF000000) >> 24);
-
-          xpSendProtoMessage->commands[commandCount].commandTag = E_K_ICPP_PARSER_CMD_TAG_GET_FOTA_STATUS;
-          xpSendProtoMessage->commands[commandCount].data.fieldList.fieldsCount = 2;
-
-          xpSendProtoMessage->commands[commandCount].data.fieldList.fields[fieldIndex].fieldTag =
-              E_K_ICPP_PARSER_FIELD_TAG_CMD_PROCESSING_STATUS;
-          xpSendProtoMessage->commands[commandCount].data.fieldList.fields[fieldIndex].fieldLen =
-              C_K_ICPP_PARSER_PROCESSING_STATUS_FIELD_LENGTH;
-          xpSendProtoMessage->commands[commandCount].data.fieldList.fields[fieldIndex].fieldValue =
-              (uint8_t*)&platformStatusMSB;
-          fieldIndex++;
-
-          xpSendProtoMessage->commands[commandCount].data.fieldList.fields[fieldIndex].fieldTag =
-              E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA;
-          xpSendProtoMessage->commands[commandCount].data.fieldList.fields[fieldIndex].fieldValue =
-              fotaName;
-          xpSendProtoMessage->commands[commandCount].data.fieldList.fields[fieldIndex].fieldLen =
-              fotaNameLen;
-          fieldIndex++;
-
-          if (E_K_FOTA_ERROR == fotaStatus)
-          {
-            uint32_t errorCodeMSB = ((fotaError.fotaErrorCode[3] & 0x000000FF) << 24) |
-                                    ((fotaError.fotaErrorCode[2] & 0x000000FF) << 16) |
-                                    ((fotaError.fotaErrorCode[1] & 0x000000FF) << 8)  |
-                                    ((fotaError.fotaErrorCode[0] & 0x000000FF));
-
-            xpSendProtoMessage->commands[commandCount].data.fieldList.fields[fieldIndex].fieldTag =
-                E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA_ERROR_CODE;
-            xpSendProtoMessage->commands[commandCount].data.fieldList.fields[fieldIndex].fieldValue =
-                (uint8_t*)&errorCodeMSB;
-            xpSendProtoMessage->commands[commandCount].data.fieldList.fields[fieldIndex].fieldLen =
-                fotaError.fotaErrorCodeLen;
-            fieldIndex++;
-
-            xpSendProtoMessage->commands[commandCount].data.fieldList.fields[fieldIndex].fieldTag =
-            E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA_ERROR_CAUSE;
-            xpSendProtoMessage->commands[commandCount].data.fieldList.fields[fieldIndex].fieldValue =
-                (uint8_t*)fotaError.fotaErrorCause;
-            xpSendProtoMessage->commands[commandCount].data.fieldList.fields[fieldIndex].fieldLen =
-                fotaError.fotaErrorCauseLen;
-            fieldIndex++;
-
-            const char* ktaVersion = (const char*)ktaGetVersion();
-
-            xpSendProtoMessage->commands[commandCount].data.fieldList.fields[fieldIndex].fieldTag =
-                E_K_ICPP_PARSER_FIELD_TAG_KTA_VER;
-            xpSendProtoMessage->commands[commandCount].data.fieldList.fields[fieldIndex].fieldValue =
-                (uint8_t*)ktaVersion;
-            xpSendProtoMessage->commands[commandCount].data.fieldList.fields[fieldIndex].fieldLen =
-                strlen(ktaVersion);
-            fieldIndex++;
-
-            for (size_t i = 0; i < COMPONENTS_MAX; i++)
-            {
-              if ((components[i].componentNameLen > 0) && (components[i].componentVersionLen > 0))
-              {
-                xpSendProtoMessage->commands[commandCount].data.fieldList.fields[fieldIndex].fieldTag =
-                    E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA_COMPONENT_TARGET;
-                xpSendProtoMessage->commands[commandCount].data.fieldList.fields[fieldIndex].fieldValue =
-                    (uint8_t*)components[i].componentName;
-                xpSendProtoMessage->commands[commandCount].data.fieldList.fields[fieldIndex].fieldLen =
-                    components[i].componentNameLen;
-                fieldIndex++;
-
-                xpSendProtoMessage->commands[commandCount].data.fieldList.fields[fieldIndex].fieldTag =
-                    E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA_COMPONENT_VERSION;
-                xpSendProtoMessage->commands[commandCount].data.fieldList.fields[fieldIndex].fieldValue =
-                    (uint8_t*)components[i].componentVersion;
-                xpSendProtoMessage->commands[commandCount].data.fieldList.fields[fieldIndex].fieldLen =
-                    components[i].componentVersionLen;
-                fieldIndex++;
-              }
-            }
-            fotaStatus = status;
-          }
-          else if (E_K_FOTA_SUCCESS == fotaStatus)
-          {
-            const char* ktaVersion = (const char*)ktaGetVersion();
+  (void)xpResponse;
+  // REQ RQ_M-KTA-OBJM-FN-0600(1) : Delete Object ICPP Message
+  // REQ RQ_M-KTA-OBJM-FN-0510(1) : Verify Delete Object Signature
+  // REQ RQ_M-KTA-OBJM-FN-0590(1) : Build Delete Object response
+  // REQ RQ_M-KTA-OBJM-FN-0561_11(1) : Command Processing Status
+  status = lKtaDeleteObject(xpRecvdProtoMessage, xpContext->aPlatformStatus[xCommandIndex],
+                            (uint32_t)xCommandIndex);
+
+  if (E_K_STATUS_OK != status)
+  {
+    M_KTALOG__ERR("Delete object command failed with status = [%d]", status);
+  }
 
-            xpSendProtoMessage->commands[commandCount].data.fieldList.fields[fieldIndex].fieldTag =
-                E_K_ICPP_PARSER_FIELD_TAG_KTA_VER;
-            xpSendProtoMessage->commands[commandCount].data.fieldList.fields[fieldIndex].fieldValue =
-                (uint8_t*)ktaVersion;
-            xpSendProtoMessage->commands[commandCount].data.fieldList.fields[fieldIndex].fieldLen =
-                strlen(ktaVersion);
-            fieldIndex++;
+  return status;
+}
 
-            for (size_t i = 0; i < COMPONENTS_MAX; i++)
-            {
-              if ((components[i].componentNameLen > 0) && (components[i].componentVersionLen > 0))
-              {
-                xpSendProtoMessage->commands[commandCount].data.fieldList.fields[fieldIndex].fieldTag =
-                    E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA_COMPONENT_TARGET;
-                xpSendProtoMessage->commands[commandCount].data.fieldList.fields[fieldIndex].fieldValue =
-                    (uint8_t*)components[i].componentName;
-                xpSendProtoMessage->commands[commandCount].data.fieldList.fields[fieldIndex].fieldLen =
-                    components[i].componentNameLen;
-                fieldIndex++;
-
-                xpSendProtoMessage->commands[commandCount].data.fieldList.fields[fieldIndex].fieldTag =
-                    E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA_COMPONENT_VERSION;
-                xpSendProtoMessage->commands[commandCount].data.fieldList.fields[fieldIndex].fieldValue =
-                    (uint8_t*)components[i].componentVersion;
-                xpSendProtoMessage->commands[commandCount].data.fieldList.fields[fieldIndex].fieldLen =
-                    components[i].componentVersionLen;
-                fieldIndex++;
-              }
-            }
-            fotaStatus = status;
-          }
-          else if (E_K_FOTA_IN_PROGRESS == fotaStatus)
-          {
-            M_KTALOG__INFO("FOTA IN PROGRESS\r\n");
-            fotaStatus = status;
-          }
-          else
-          {
-            M_KTALOG__ERR("Install FOTA command failed with status = [%d]\r\n", fotaStatus);
-          }
-          // Update the final field count
-          xpSendProtoMessage->commands[commandCount].data.fieldList.fieldsCount = fieldIndex;
-        }
-        break;
+/**
+ * @implements lCmdDeleteKeyObject
+ *
+ */
+static TKStatus lCmdDeleteKeyObject
+(
+  TKIcppProtocolMessage* xpRecvdProtoMessage,
+  size_t                 xCommandIndex,
+  TKIcppCommand*         xpResponse,
+  TKCmdContext*          xpContext
+)
+{
+  TKStatus status = E_K_STATUS_ERROR;
 
-#endif //FOTA_ENABLE
-#endif /* OBJECT_MANAGEMENT_FEATURE */
+  (void)xpResponse;
+  // REQ RQ_M-KTA-OBJM-FN-1000(2) : Delete Key Object ICPP Message
+  // REQ RQ_M-KTA-OBJM-FN-0910(2) : Verify Delete Key Object Signature
+  // REQ RQ_M-KTA-OBJM-FN-0990(2) : Build Delete Key Object response
+  // REQ RQ_M-KTA-OBJM-FN-0990_01(2) : Command Processing Status
+  status = lKtaDeleteKeyObject(xpRecvdProtoMessage, xpContext->aPlatformStatus[xCommandIndex],
+                               (uint32_t)xCommandIndex);
 
-        default:
-          M_KTALOG__ERR("Received invalid command tag, cmdTag = [%x]",
-                        xpRecvdProtoMessage->commands[commandCount].commandTag);
-          break;
-      }
-    }
+  if (E_K_STATUS_OK != status)
+  {
+    M_KTALOG__ERR("Delete key object command failed with status = [%d]", status);
   }
+
   return status;
 }
 
+/**
+ * @implements lCmdSetObjWithAssociation
+ *
+ */
+static TKStatus lCmdSetObjWithAssociation
+(
+  TKIcppProtocolMessage* xpRecvdProtoMessage,
+  size_t                 xCommandIndex,
+  TKIcppCommand*         xpResponse,
+  TKCmdContext*          xpContext
+)
+{
+  TKStatus status = E_K_STATUS_ERROR;
+
+  (void)xpResponse;
+  // REQ RQ_M-KTA-OBJM-FN-0800(1) : Set Object With Association ICPP Message
+  // REQ RQ_M-KTA-OBJM-FN-0710(1) : Verify Set Object with Association Signature
+  // REQ RQ_M-KTA-OBJM-FN-0790(1) : Build Set Object With Association response
+  // REQ RQ_M-KTA-OBJM-FN-0790_01(1) : Command Processing Status
+  status = lKtaSetObjWithAssociation(xpRecvdProtoMessage,
+                                     xpContext->aPlatformStatus[xCommandIndex]);
+
+  if (E_K_STATUS_OK != status)
+  {
+    M_KTALOG__ERR("Set object with association command failed with status = [%d]", status);
+  }
+
+  return status;
+}
+
+/**
+ * @implements lCmdGetChallenge
+ *
+ */
+static TKStatus lCmdGetChallenge
+(
+  TKIcppProtocolMessage* xpRecvdProtoMessage,
+  size_t                 xCommandIndex,
+  TKIcppCommand*         xpResponse,
+  TKCmdContext*          xpContext
+)
+{
+  TKStatus status = E_K_STATUS_ERROR;
+
+  (void)xpRecvdProtoMessage;
+  // REQ RQ_M-KTA-OBJM-FN-0880(1) : Get challenge With ICPP Message
+  // REQ RQ_M-KTA-OBJM-FN-0850(1) : Verify Get challenge
+  status = lKtaGetChallenge(xpContext->aChallenge, xpContext->aPlatformStatus[xCommandIndex]);
+
+  // REQ RQ_M-KTA-OBJM-FN-0890(1) : Build Get Challenege Response
+  // REQ RQ_M-KTA-OBJM-FN-0910_01(1) : Command Processing Status
+  xpResponse->data.fieldList.fields[1].fieldTag = E_K_ICPP_PARSER_FIELD_TAG_CHALLENGE;
+  xpResponse->data.fieldList.fields[1].fieldLen = C_K_ICPP_PARSER_KTA_CHALLENGE_SIZE;
+  xpResponse->data.fieldList.fields[1].fieldValue = xpContext->aChallenge;
+
+  if (E_K_STATUS_OK != status)
+  {
+    M_KTALOG__ERR("Get Challenge command failed with status = [%d]", status);
+  }
+
+  return status;
+}
+
+#ifdef FOTA_ENABLE
+/**
+ * @implements lCmdInstallFota
+ *
+ */
+static TKStatus lCmdInstallFota
+(
+  TKIcppProtocolMessage* xpRecvdProtoMessage,
+  size_t                 xCommandIndex,
+  TKIcppCommand*         xpResponse,
+  TKCmdContext*          xpContext
+)
+{
+  TKFotaStatus fotaStatus = E_K_FOTA_ERROR;
+
+  xpContext->fotaError.fotaErrorCause = xpContext->aFotaErrorCause;
+  xpContext->fotaError.fotaErrorCauseLen = sizeof(xpContext->aFotaErrorCause);
+  xpContext->fotaError.fotaErrorCode = xpContext->aFotaErrorCode;
+  xpContext->fotaError.fotaErrorCodeLen = ERROR_CODE_LEN;
+
+  fotaStatus = lktaInstallFota(xpRecvdProtoMessage,
+                               xpContext->aFotaName,
+                               &xpContext->fotaNameLen,
+                               xpContext->aComponents,
+                               &xpContext->fotaError,
+                               xpContext->aPlatformStatus[xCommandIndex]);
+
+  return lCmdFotaResponse(fotaStatus, sizeof(xpContext->fotaError.fotaErrorCode),
+                          xpContext->aPlatformStatus[xCommandIndex], xpResponse, xpContext);
+}
+
+/**
+ * @implements lCmdGetFotaStatus
+ *
+ */
+static TKStatus lCmdGetFotaStatus
+(
+  TKIcppProtocolMessage* xpRecvdProtoMessage,
+  size_t                 xCommandIndex,
+  TKIcppCommand*         xpResponse,
+  TKCmdContext*          xpContext
+)
+{
+  TKFotaStatus fotaStatus = E_K_FOTA_ERROR;
+
+  xpContext->fotaError.fotaErrorCause = xpContext->aFotaErrorCause;
+  xpContext->fotaError.fotaErrorCauseLen = sizeof(xpContext->aFotaErrorCause);
+  xpContext->fotaError.fotaErrorCode = xpContext->aFotaErrorCode;
+  xpContext->fotaError.fotaErrorCodeLen = ERROR_CODE_LEN;
+
+  fotaStatus = lktasalfotagetstatus(xpRecvdProtoMessage,
+                                    xpContext->aFotaName,
+                                    &xpContext->fotaNameLen,
+                                    &xpContext->fotaError,
+                                    xpContext->aPlatformStatus[xCommandIndex],
+                                    xpContext->aComponents);
+
+  return lCmdFotaResponse(fotaStatus, xpContext->fotaError.fotaErrorCodeLen,
+                          xpContext->aPlatformStatus[xCommandIndex], xpResponse, xpContext);
+}
+
+/**
+ * @implements lCmdFotaResponse
+ *
+ */
+static TKStatus lCmdFotaResponse
+(
+  TKFotaStatus           xFotaStatus,
+  size_t                 xErrorCodeLen,
+  const uint8_t*         xpPlatformStatus,
+  TKIcppCommand*         xpResponse,
+  TKCmdContext*          xpContext
+)
+{
+  TKStatus     status      = E_K_STATUS_OK;
+  TKIcppField* pFields     = xpResponse->data.fieldList.fields;
+  uint8_t      fieldIndex  = 1;
+  uint32_t     tempStatus  = 0;
+  const char*  ktaVersion  = NULL;
+
+  (void)memcpy(&tempStatus, xpPlatformStatus, sizeof(tempStatus));
+
+  // Swap LSB to MSB
+  xpContext->platformStatusMsb = ((tempStatus & 0x000000FF) << 24) |
+                                 ((tempStatus & 0x0000FF00) << 8)  |
+                                 ((tempStatus & 0x00FF0000) >> 8)  |
+                                 ((tempStatus & 0xFF000000) >> 24);
+  pFields[0].fieldValue = (uint8_t*)&xpContext->platformStatusMsb;
+
+  pFields[fieldIndex].fieldTag = E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA;
+  pFields[fieldIndex].fieldValue = xpContext->aFotaName;
+  pFields[fieldIndex].fieldLen = xpContext->fotaNameLen;
+  fieldIndex++;
+
+  if (E_K_FOTA_ERROR == xFotaStatus)
+  {
+    xpContext->fotaErrorCodeMsb =
+      ((xpContext->fotaError.fotaErrorCode[3] & 0x000000FF) << 24) |
+      ((xpContext->fotaError.fotaErrorCode[2] & 0x000000FF) << 16) |
+      ((xpContext->fotaError.fotaErrorCode[1] & 0x000000FF) << 8)  |
+      ((xpContext->fotaError.fotaErrorCode[0] & 0x000000FF));
+
+    pFields[fieldIndex].fieldTag = E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA_ERROR_CODE;
+    pFields[fieldIndex].fieldValue = (uint8_t*)&xpContext->fotaErrorCodeMsb;
+    pFields[fieldIndex].fieldLen = xErrorCodeLen;
+    fieldIndex++;
+
+    pFields[fieldIndex].fieldTag = E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA_ERROR_CAUSE;
+    pFields[fieldIndex].fieldValue = (uint8_t*)xpContext->fotaError.fotaErrorCause;
+    pFields[fieldIndex].fieldLen = xpContext->fotaError.fotaErrorCauseLen;
+    fieldIndex++;
+  }
+
+  if ((E_K_FOTA_ERROR == xFotaStatus) || (E_K_FOTA_SUCCESS == xFotaStatus))
+  {
+    ktaVersion = (const char*)ktaGetVersion();
+    pFields[fieldIndex].fieldTag = E_K_ICPP_PARSER_FIELD_TAG_KTA_VER;
+    pFields[fieldIndex].fieldValue = (uint8_t*)ktaVersion;
+    pFields[fieldIndex].fieldLen = strlen(ktaVersion);
+    fieldIndex++;
+
+    for (size_t i = 0; i < COMPONENTS_MAX; i++)
+    {
+      if ((xpContext->aComponents[i].componentNameLen > 0) &&
+          (xpContext->aComponents[i].componentVersionLen > 0))
+      {
+        pFields[fieldIndex].fieldTag = E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA_COMPONENT_TARGET;
+        pFields[fieldIndex].fieldValue = (uint8_t*)xpContext->aComponents[i].componentName;
+        pFields[fieldIndex].fieldLen = xpContext->aComponents[i].componentNameLen;
+        fieldIndex++;
+
+        pFields[fieldIndex].fieldTag = E_K_ICPP_PARSER_FIELD_TAG_CMD_FOTA_COMPONENT_VERSION;
+        pFields[fieldIndex].fieldValue = (uint8_t*)xpContext->aComponents[i].componentVersion;
+        pFields[fieldIndex].fieldLen = xpContext->aComponents[i].componentVersionLen;
+        fieldIndex++;
+      }
+    }
+  }
+  else if (E_K_FOTA_IN_PROGRESS == xFotaStatus)
+  {
+    M_KTALOG__INFO("FOTA IN PROGRESS\r\n");
+  }
+  else
+  {
+    M_KTALOG__ERR("FOTA command failed with status = [%d]\r\n", xFotaStatus);
+    status = E_K_STATUS_ERROR;
+  }
+
+  // Update the final field count
+  xpResponse->data.fieldList.fieldsCount = fieldIndex;
+
+  return status;
+}
+#endif /* FOTA_ENABLE */
+#endif /* OBJECT_MANAGEMENT_FEATURE */
+
+#ifdef PARALLEL_COMMANDS_FEATURE
+/**
+ * @implements lExecuteCommands
+ *
+ */
+static TKStatus lExecuteCommands
+(
+  TKIcppProtocolMessage* xpRecvdProtoMessage,
+  TKIcppProtocolMessage* xpSendProtoMessage,
+  TKCmdContext*          xpContext
+)
+{
+  TKCmdExecutor          executor;
+  uint32_t               aObjectIds[C_K_ICPP_PARSER__MAX_COMMANDS_COUNT] = {0};
+  uint32_t               objectId = 0;
+  size_t                 commandCount = 0;
+  size_t                 waveIndex = 0;
+  const TKCmdDescriptor* pDescriptor = NULL;
+  TKStatus               status = E_K_STATUS_ERROR;
+  bool                   isConflicting = false;
+  bool                   hasWorkers = false;
+
+  (void)pthread_once(&gCmdWorkerPoolOnce, lStartWorkers);
+
+  /* Another message holding the workers runs its waves alone, this one does too. */
+  if ((0u != gCmdWorkerPool.workerCount) &&
+      (0 == pthread_mutex_trylock(&gCmdWorkerPool.ownerLock)))
+  {
+    hasWorkers = true;
+  }
+
+  (void)memset(&executor, 0, sizeof(executor));
+  (void)pthread_mutex_init(&executor.lock, NULL);
+  executor.pRecvdProtoMessage = xpRecvdProtoMessage;
+  executor.pSendProtoMessage = xpSendProtoMessage;
+  executor.pContext = xpContext;
+  executor.pKtaContext = ktaContextGetSelected();
+
+  while (commandCount < xpRecvdProtoMessage->commandsCount)
+  {
+    executor.waveCount = 0;
+    executor.nextIndex = 0;
+
+    for (; commandCount < xpRecvdProtoMessage->commandsCount; commandCount++)
+    {
+      pDescriptor = M_K_CMD_GET_DESCRIPTOR(xpRecvdProtoMessage->commands[commandCount].commandTag);
+
+      if (NULL == pDescriptor->pfHandler)
+      {
+        /* Already reported when preparing the responses. */
+        continue;
+      }
+
+      if ((0u == pDescriptor->isConcurrent) ||
+          (E_K_STATUS_OK != lCmdGetObjectId(&xpRecvdProtoMessage->commands[commandCount],
+                                            &objectId)))
+      {
+        /* Runs alone, after the commands before it and before the commands after it. */
+        if (0u == executor.waveCount)
+        {
+          executor.aWave[executor.waveCount] = commandCount;
+          executor.waveCount++;
+          commandCount++;
+        }
+
+        break;
+      }
+
+      isConflicting = false;
+
+      for (waveIndex = 0; waveIndex < executor.waveCount; waveIndex++)
+      {
+        if (aObjectIds[waveIndex] == objectId)
+        {
+          isConflicting = true;
+          break;
+        }
+      }
+
+      if (isConflicting)
+      {
+        /* Commands on the same object keep their order. */
+        break;
+      }
+
+      aObjectIds[executor.waveCount] = objectId;
+      executor.aWave[executor.waveCount] = commandCount;
+      executor.waveCount++;
+    }
+
+    if (0u == executor.waveCount)
+    {
+      break;
+    }
+
+    if (hasWorkers && (1u < executor.waveCount))
+    {
+      (void)pthread_mutex_lock(&gCmdWorkerPool.lock);
+      gCmdWorkerPool.pExecutor = &executor;
+      gCmdWorkerPool.waveId++;
+      gCmdWorkerPool.busyCount = gCmdWorkerPool.workerCount;
+      (void)pthread_cond_broadcast(&gCmdWorkerPool.waveCond);
+      (void)pthread_mutex_unlock(&gCmdWorkerPool.lock);
+    }
+
+    /* The thread processing the message runs commands too, all of them without worker. */
+    lExecuteWave(&executor);
+
+    if (hasWorkers && (1u < executor.waveCount))
+    {
+      /* The executor and the next wave must not change while a worker still reads them. */
+      (void)pthread_mutex_lock(&gCmdWorkerPool.lock);
+
+      while (0u != gCmdWorkerPool.busyCount)
+      {
+        (void)pthread_cond_wait(&gCmdWorkerPool.doneCond, &gCmdWorkerPool.lock);
+      }
+
+      gCmdWorkerPool.pExecutor = NULL;
+      (void)pthread_mutex_unlock(&gCmdWorkerPool.lock);
+    }
+
+    status = executor.aStatus[executor.aWave[executor.waveCount - 1u]];
+  }
+
+  if (hasWorkers)
+  {
+    (void)pthread_mutex_unlock(&gCmdWorkerPool.ownerLock);
+  }
+
+  (void)pthread_mutex_destroy(&executor.lock);
+  return status;
+}
+
+/**
+ * @implements lExecuteWave
+ *
+ */
+static void lExecuteWave
+(
+  TKCmdExecutor*  xpExecutor
+)
+{
+  size_t                 commandIndex = 0;
+  const TKCmdDescriptor* pDescriptor = NULL;
+
+  for (;;)
+  {
+    (void)pthread_mutex_lock(&xpExecutor->lock);
+
+    if (xpExecutor->nextIndex >= xpExecutor->waveCount)
+    {
+      (void)pthread_mutex_unlock(&xpExecutor->lock);
+      break;
+    }
+
+    commandIndex = xpExecutor->aWave[xpExecutor->nextIndex];
+    xpExecutor->nextIndex++;
+    (void)pthread_mutex_unlock(&xpExecutor->lock);
+
+    pDescriptor = M_K_CMD_GET_DESCRIPTOR(
+                    xpExecutor->pRecvdProtoMessage->commands[commandIndex].commandTag);
+    xpExecutor->aStatus[commandIndex] =
+      pDescriptor->pfHandler(xpExecutor->pRecvdProtoMessage,
+                             commandIndex,
+                             &xpExecutor->pSendProtoMessage->commands[commandIndex],
+                             xpExecutor->pContext);
+  }
+}
+
+/**
+ * @implements lStartWorkers
+ *
+ */
+static void lStartWorkers
+(
+  void
+)
+{
+  pthread_t  worker;
+  size_t     workerCount = 0;
+
+  for (workerCount = 0; workerCount < (C_KTA_APP__COMMAND_WORKERS - 1u); workerCount++)
+  {
+    if (0 != pthread_create(&worker, NULL, lExecuteWorker, NULL))
+    {
+      M_KTALOG__WARN("Only %u command workers started", (unsigned int)workerCount);
+      break;
+    }
+
+    (void)pthread_detach(worker);
+  }
+
+  /* Read without lock by lExecuteCommands, pthread_once orders it before. */
+  gCmdWorkerPool.workerCount = workerCount;
+}
+
+/**
+ * @implements lExecuteWorker
+ *
+ */
+static void* lExecuteWorker
+(
+  void*  xpArg
+)
+{
+  TKCmdExecutor*  pExecutor = NULL;
+  uint32_t        waveId = 0;
+
+  (void)xpArg;
+  (void)pthread_mutex_lock(&gCmdWorkerPool.lock);
+
+  for (;;)
+  {
+    /* A wave is only posted once all workers are done with the previous one. */
+    while (waveId == gCmdWorkerPool.waveId)
+    {
+      (void)pthread_cond_wait(&gCmdWorkerPool.waveCond, &gCmdWorkerPool.lock);
+    }
+
+    waveId = gCmdWorkerPool.waveId;
+    pExecutor = gCmdWorkerPool.pExecutor;
+    (void)pthread_mutex_unlock(&gCmdWorkerPool.lock);
+
+    /* Key and object operations go to the SAL instance of the device being processed. */
+    if (E_K_STATUS_OK == ktaContextSelect(pExecutor->pKtaContext))
+    {
+      lExecuteWave(pExecutor);
+    }
+    else
+    {
+      M_KTALOG__ERR("Selecting the context failed, commands left to the other threads");
+    }
+
+    (void)pthread_mutex_lock(&gCmdWorkerPool.lock);
+    gCmdWorkerPool.busyCount--;
+
+    if (0u == gCmdWorkerPool.busyCount)
+    {
+      (void)pthread_cond_signal(&gCmdWorkerPool.doneCond);
+    }
+  }
+
+  return NULL;
+}
+
+/**
+ * @implements lCmdGetObjectId
+ *
+ */
+static TKStatus lCmdGetObjectId
+(
+  const TKIcppCommand*  xpCommand,
+  uint32_t*             xpObjectId
+)
+{
+  TKStatus            status = E_K_STATUS_ERROR;
+  size_t              fieldIndex = 0;
+  const TKIcppField*  pField = NULL;
+
+  for (; fieldIndex < xpCommand->data.fieldList.fieldsCount; fieldIndex++)
+  {
+    pField = &xpCommand->data.fieldList.fields[fieldIndex];
+
+    if ((E_K_ICPP_PARSER_FLD_TAG_CMD_IDENTIFIER == pField->fieldTag) &&
+        (sizeof(uint32_t) == pField->fieldLen))
+    {
+      *xpObjectId = ((uint32_t)pField->fieldValue[0] << 24) |
+                    ((uint32_t)pField->fieldValue[1] << 16) |
+                    ((uint32_t)pField->fieldValue[2] << 8) |
+                    (uint32_t)pField->fieldValue[3];
+      status = E_K_STATUS_OK;
+      break;
+    }
+  }
+
+  return status;
+}
+#endif /* PARALLEL_COMMANDS_FEATURE */
+
+/**
+ * @implements lPrepareResponseHeader
+ *
+ */
+static void lPrepareResponseHeader
+(
+  const TKIcppProtocolMessage* xpRecvdProtoMessage,
+  TKIcppProtocolMessage*       xpSendProtoMessage
+)
+{
+  /* Fill the message type with "E_K_ICCP_PARSER_MESSAGE_TYPE_RESPONSE" to indicate it is
+     registration notification message type (client -> server). */
+  // REQ RQ_M-KTA-OBJM-FN-0100_03(1) : message type
+  // REQ RQ_M-KTA-TRDP-FN-0110_03(1) : Third Party Response message type
+  xpSendProtoMessage->msgType  = E_K_ICPP_PARSER_MESSAGE_TYPE_RESPONSE;
+  // REQ RQ_M-KTA-OBJM-FN-0100_01(1) : crypto version
+  // REQ RQ_M-KTA-OBJM-FN-0080(1) : Crypto version from keySTEREAM in Generate key pair.
+  // REQ RQ_M-KTA-OBJM-FN-0280(1) : Crypto version from keySTEREAM in Set Object.
+  // REQ RQ_M-KTA-OBJM-FN-0580(1) : Crypto version from keySTEREAM in Delete Object.
+  // REQ RQ_M-KTA-OBJM-FN-0780(1) : Crypto version from keySTEREAM in
+  // Set Object With Association.
+  // REQ RQ_M-KTA-OBJM-FN-0980(2) : Crypto version from keySTEREAM in Delete Key Object */
+  // REQ RQ_M-KTA-TRDP-FN-0080(1) : Crypto version from keySTEREAM in Third Party.
+  // REQ RQ_M-KTA-TRDP-FN-0110_01(1) : Third Party Response crypto version.
+  xpSendProtoMessage->cryptoVersion = xpRecvdProtoMessage->cryptoVersion;
+  // REQ RQ_M-KTA-OBJM-FN-0100_02(1) : partial encryption mode
+  // REQ RQ_M-KTA-TRDP-FN-0110_02(1) : Third Party Response partial encryption mode
+  xpSendProtoMessage->encMode = xpRecvdProtoMessage->encMode;
+  // REQ RQ_M-KTA-OBJM-FN-0100_06(1) : rot public uid
+  // REQ RQ_M-KTA-TRDP-FN-0110_06(1) : Third Party Response rot public uid
+  (void)memcpy(xpSendProtoMessage->rotPublicUID,
+               xpRecvdProtoMessage->rotPublicUID,
+               C_K_ICPP_PARSER__ROT_PUBLIC_UID_SIZE_IN_BYTES);
+  // REQ RQ_M-KTA-OBJM-FN-0100_04(1) : transaction id
+  // REQ RQ_M-KTA-TRDP-FN-0110_04(1) : Third Party Response transaction id
+  (void)memcpy(xpSendProtoMessage->transactionId, xpRecvdProtoMessage->transactionId,
+               C_K_ICPP_PARSER__TRANSACTION_ID_SIZE_IN_BYTES);
+  // REQ RQ_M-KTA-OBJM-FN-0100_05(1) : rot key set id
+  // REQ RQ_M-KTA-TRDP-FN-0110_05(1) : Third Party Response rot key set id
+  xpSendProtoMessage->rotKeySetId = xpRecvdProtoMessage->rotKeySetId;
+}
+
+/**
+ * @implements lProcessCommands
+ *
+ */
+static TKStatus lProcessCommands
+(
+  TKIcppProtocolMessage* xpRecvdProtoMessage,
+  TKIcppProtocolMessage* xpSendProtoMessage,
+  TKCmdContext*          xpContext
+)
+{
+  TKStatus status = E_K_STATUS_ERROR;
+
+  status = lProcessCmdPrepareResponse(xpRecvdProtoMessage,
+                                      xpSendProtoMessage,
+                                      xpContext);
+
+#ifdef FOTA_ENABLE
+  // Check for command tags A0 and A1
+  bool fotaTagFound = false;
+
+  for (size_t i = 0; i < xpRecvdProtoMessage->commandsCount; i++)
+  {
+    if ((xpRecvdProtoMessage->commands[i].commandTag == E_K_ICPP_PARSER_CMD_TAG_INSTALL_FOTA) ||
+        (xpRecvdProtoMessage->commands[i].commandTag == E_K_ICPP_PARSER_CMD_TAG_GET_FOTA_STATUS))
+    {
+      fotaTagFound = true;
+      break;
+    }
+  }
+
+  if (E_K_STATUS_OK != status && !fotaTagFound)
+  {
+    M_KTALOG__ERR("Processing command or preparing response failed, status = [%d]", status);
+  }
+  else
+  {
+    status = E_K_STATUS_OK;
+  }
+#else
+  if (E_K_STATUS_OK != status)
+  {
+    M_KTALOG__ERR("Processing command or preparing response failed, status = [%d]", status);
+  }
+#endif // FOTA_ENABLE
+
+  return status;
+}
+
+/**
+ * @implements lDecryptNextCommand
+ *
+ */
+static TKParserStatus lDecryptNextCommand
+(
+  const TKCmdSegmentedMsg* xpSegmentedMsg,
+  size_t                   xOffset,
+  TKIcppProtocolMessage*   xpRecvdProtoMessage,
+  size_t*                  xpCommandSize
+)
+{
+  TKParserStatus parserStatus = E_K_ICPP_PARSER_STATUS_ERROR;
+  uint8_t*       pCommand = NULL;
+  size_t         remaining = xpSegmentedMsg->clearDataLen - xOffset;
+  size_t         tagLengthSize = C_K_CMD_TAG_LENGTH_MAX_SIZE;
+  size_t         commandSize = 0;
+
+  if (remaining < tagLengthSize)
+  {
+    tagLengthSize = remaining;
+  }
+
+  /* Tag and length first, to know how far the command spans. */
+  if (E_K_STATUS_OK == ktacipherDecryptSegment(xpSegmentedMsg->pEncryptedData,
+                                               xOffset,
+                                               tagLengthSize,
+                                               xpSegmentedMsg->pWorkBuffer,
+                                               xpSegmentedMsg->workBufferSize,
+                                               &pCommand))
+  {
+    parserStatus = ktaIcppParserGetCommandSize(pCommand, tagLengthSize, &commandSize);
+  }
+
+  if ((E_K_ICPP_PARSER_STATUS_OK == parserStatus) && (commandSize > remaining))
+  {
+    M_KTALOG__ERR("Command length %d exceeds the remaining data", commandSize);
+    parserStatus = E_K_ICPP_PARSER_STATUS_ERROR;
+  }
+
+  if ((E_K_ICPP_PARSER_STATUS_OK == parserStatus) &&
+      (E_K_STATUS_OK != ktacipherDecryptSegment(xpSegmentedMsg->pEncryptedData,
+                                                xOffset,
+                                                commandSize,
+                                                xpSegmentedMsg->pWorkBuffer,
+                                                xpSegmentedMsg->workBufferSize,
+                                                &pCommand)))
+  {
+    M_KTALOG__ERR("Command of [%d] bytes does not fit in the working buffer", commandSize);
+    parserStatus = E_K_ICPP_PARSER_STATUS_ERROR;
+  }
+
+  if (E_K_ICPP_PARSER_STATUS_OK == parserStatus)
+  {
+    parserStatus = ktaIcppParserDeserializeCommands(pCommand, commandSize, xpRecvdProtoMessage);
+    *xpCommandSize = commandSize;
+  }
+
+  return parserStatus;
+}
+
 /* -------------------------------------------------------------------------- */
 /* END OF FILE                                                                */
 /* -------------------------------------------------------------------------- */
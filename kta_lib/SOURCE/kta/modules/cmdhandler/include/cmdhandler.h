@@ -56,6 +56,18 @@ extern "C" {
 /* -------------------------------------------------------------------------- */
 /* CONSTANTS, TYPES, ENUM                                                     */
 /* -------------------------------------------------------------------------- */
+/** @brief Message whose commands do not fit the working buffer once decrypted. */
+typedef struct
+{
+  const uint8_t* pEncryptedData;
+  /* Encrypted commands following the header, MAC already verified. */
+  size_t         clearDataLen;
+  /* Length of the commands once decrypted, padding removed. */
+  uint8_t*       pWorkBuffer;
+  /* Receives one decrypted command at a time. */
+  size_t         workBufferSize;
+  /* Size of pWorkBuffer. */
+} TKCmdSegmentedMsg;
 
 /* -------------------------------------------------------------------------- */
 /* VARIABLES                                                                  */
@@ -100,6 +112,62 @@ TKStatus ktaCmdProcess
   size_t*                xpMessageToSendSize
 );
 
+/**
+ * @brief
+ *   Check the commands of a segmented message before any of them is processed.
+ *   Each command is decrypted in turn in the working buffer and deserialized.
+ *
+ * @param[in] xpSegmentedMsg
+ *   Should not be NULL.
+ * @param[out] xpRecvdProtoMessage
+ *   Should not be NULL.
+ *   Header already deserialized, holds the last command checked on return.
+ *
+ * @return
+ * - E_K_ICPP_PARSER_STATUS_OK in case of success.
+ * - E_K_ICPP_PARSER_STATUS_PARAMETER for wrong input parameters.
+ * - E_K_ICPP_PARSER_STATUS_CPERROR if a command count is exceeded.
+ * - E_K_ICPP_PARSER_STATUS_ERROR for malformed commands or a command larger than
+ *   the working buffer.
+ */
+TKParserStatus ktaCmdCheckSegmented
+(
+  const TKCmdSegmentedMsg* xpSegmentedMsg,
+  TKIcppProtocolMessage*   xpRecvdProtoMessage
+);
+
+/**
+ * @brief
+ *   Same as ktaCmdProcess for a message checked by ktaCmdCheckSegmented.
+ *   Commands are decrypted and processed one at a time, the response of each is
+ *   serialized in xpMessageToSend before the next one. A failed command does not stop
+ *   the next ones.
+ *
+ * @param[in] xpRecvdProtoMessage
+ *   Should not be NULL.
+ *   Header of the message received from server.
+ * @param[in] xpSegmentedMsg
+ *   Should not be NULL.
+ * @param[out] xpMessageToSend
+ *   Should not be NULL.
+ * @param[in,out] xpMessageToSendSize
+ *   Should not be NULL.
+ *   [in] Size of buffer provided by the caller.
+ *   [out] Actual size of icpp Message to be send to keySTREAM.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_PARAMETER for wrong input parameters.
+ * - E_K_STATUS_ERROR for other errors.
+ */
+TKStatus ktaCmdProcessSegmented
+(
+  TKIcppProtocolMessage*   xpRecvdProtoMessage,
+  const TKCmdSegmentedMsg* xpSegmentedMsg,
+  uint8_t*                 xpMessageToSend,
+  size_t*                  xpMessageToSendSize
+);
+
 #ifdef __cplusplus
 }
 #endif /* C++ */
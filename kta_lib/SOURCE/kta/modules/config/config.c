@@ -45,6 +45,9 @@
 #include "kta_version.h"
 #include "KTALog.h"
 #include "k_sal.h"
+#ifdef WARM_START_FEATURE
+#include "k_sal_rot.h"
+#endif /* WARM_START_FEATURE */
 
 #include <string.h>
 #include <stdint.h>
@@ -53,15 +56,50 @@
 /* LOCAL CONSTANTS, TYPES, ENUM                                               */
 /* -------------------------------------------------------------------------- */
 
+#ifdef WARM_START_FEATURE
+/** @brief Format of the warm start data, 0 marks a discarded snapshot. */
+#define C_KTA_CONFIG__WARM_START_FORMAT           (0x02u)
+
+/** @brief Offset of the format in the warm start data. */
+#define C_KTA_CONFIG__WARM_START_FORMAT_OFFSET    (0u)
+
+/** @brief Offset of the life cycle state in the warm start data. */
+#define C_KTA_CONFIG__WARM_START_STATE_OFFSET     (1u)
+
+/** @brief Offset of the rot key set id in the warm start data. */
+#define C_KTA_CONFIG__WARM_START_KEY_SET_OFFSET   (2u)
+
+/** @brief Offset of the device info configuration in the warm start data. */
+#define C_KTA_CONFIG__WARM_START_DEVICE_OFFSET    (3u)
+
+/** @brief Offset of the context info configuration in the warm start data. */
+#define C_KTA_CONFIG__WARM_START_CONTEXT_OFFSET   \
+  (C_KTA_CONFIG__WARM_START_DEVICE_OFFSET + sizeof(TKtaDeviceInfoConfig))
+
+/** @brief Offset of the L1 segmentation seed given to ktaStartup in the warm start data. */
+#define C_KTA_CONFIG__WARM_START_SEED_OFFSET      \
+  (C_KTA_CONFIG__WARM_START_CONTEXT_OFFSET + sizeof(TKtaContextInfoConfig))
+
+/** @brief Used length of the warm start data. */
+#define C_KTA_CONFIG__WARM_START_LENGTH           \
+  (C_KTA_CONFIG__WARM_START_SEED_OFFSET + C_K__L1_SEGMENTATION_SEED_SIZE)
+#endif /* WARM_START_FEATURE */
+
 /* -------------------------------------------------------------------------- */
 /* LOCAL VARIABLES                                                            */
 /* -------------------------------------------------------------------------- */
 /* Module name used for logging. */
 static const char* gpModuleName = "KTACONFIG";
 
-/* Static variable to hold configuration info. */
-static TKtaDeviceInfoConfig gKtaDeviceInfoConfig = {0};
-static TKtaContextInfoConfig gKtaContextInfoConfig = {0};
+/* Static variable to hold configuration info, one instance per context. */
+static TKtaDeviceInfoConfig gaKtaDeviceInfoConfig[C_KTA_APP__MAX_CONTEXTS] = {0};
+static TKtaContextInfoConfig gaKtaContextInfoConfig[C_KTA_APP__MAX_CONTEXTS] = {0};
+
+/* Configuration instance selected by the calling thread. */
+static C_KTA_APP__THREAD_LOCAL TKtaDeviceInfoConfig* gpKtaDeviceInfoConfig =
+  &gaKtaDeviceInfoConfig[0];
+static C_KTA_APP__THREAD_LOCAL TKtaContextInfoConfig* gpKtaContextInfoConfig =
+  &gaKtaContextInfoConfig[0];
 
 /* -------------------------------------------------------------------------- */
 /* LOCAL FUNCTIONS - PROTOTYPE                                                */
@@ -83,6 +121,32 @@ static TKStatus lReadDeviceAndContextInfo
   const TKtaLifeCycleState xState
 );
 
+#ifdef WARM_START_FEATURE
+/**
+ * @brief
+ *   Compare a field of the context configuration with a ktaStartup argument.
+ *
+ * @param[in] xpStored
+ *   Field of the context configuration.
+ * @param[in] xStoredLen
+ *   Length of xpStored, in bytes.
+ * @param[in] xpArgument
+ *   ktaStartup argument.
+ * @param[in] xArgumentLen
+ *   Length of xpArgument, in bytes.
+ *
+ * @return
+ * - 1 if both are equal, 0 otherwise.
+ */
+static uint8_t lIsSameStartupArgument
+(
+  const uint8_t*  xpStored,
+  size_t          xStoredLen,
+  const uint8_t*  xpArgument,
+  size_t          xArgumentLen
+);
+#endif /* WARM_START_FEATURE */
+
 /* -------------------------------------------------------------------------- */
 /* PUBLIC VARIABLES                                                           */
 /* -------------------------------------------------------------------------- */
@@ -134,24 +198,24 @@ TKStatus ktaSetDeviceInfoConfig
     {
       M_KTALOG__DEBUG("Device is in init state, keeping KTA info into NVM...");
       (void)memcpy(&(aKtaInfo[ktaInfoLen]),
-                   gKtaContextInfoConfig.ktaContextProfileUid,
+                   gpKtaContextInfoConfig->ktaContextProfileUid,
                    C_K__CONTEXT_PROFILE_UID_MAX_SIZE);
       ktaInfoLen = C_K__CONTEXT_PROFILE_UID_MAX_SIZE;
-      aKtaInfo[ktaInfoLen] = gKtaContextInfoConfig.ktaContextProfileUidLength;
+      aKtaInfo[ktaInfoLen] = gpKtaContextInfoConfig->ktaContextProfileUidLength;
       ktaInfoLen += (uint8_t)1;
 
       (void)memcpy(&(aKtaInfo[ktaInfoLen]),
-                   gKtaContextInfoConfig.ktaContexSerialNumber,
+                   gpKtaContextInfoConfig->ktaContexSerialNumber,
                    C_K__CONTEXT_SERIAL_NUMBER_MAX_SIZE);
       ktaInfoLen += C_K__CONTEXT_SERIAL_NUMBER_MAX_SIZE;
-      aKtaInfo[ktaInfoLen] = gKtaContextInfoConfig.ktaContexSerialNumberLength;
+      aKtaInfo[ktaInfoLen] = gpKtaContextInfoConfig->ktaContexSerialNumberLength;
       ktaInfoLen += (uint8_t)1;
 
       (void)memcpy(&(aKtaInfo[ktaInfoLen]),
-                   gKtaContextInfoConfig.ktaContextVersion,
+                   gpKtaContextInfoConfig->ktaContextVersion,
                    C_K__CONTEXT_VERSION_MAX_SIZE);
       ktaInfoLen += C_K__CONTEXT_VERSION_MAX_SIZE;
-      aKtaInfo[ktaInfoLen] = gKtaContextInfoConfig.ktaContextVersionLength;
+      aKtaInfo[ktaInfoLen] = gpKtaContextInfoConfig->ktaContextVersionLength;
       ktaInfoLen += (uint8_t)1;
 
       (void)memcpy(&(aKtaInfo[ktaInfoLen]), ktaGetVersion(), C_KTA__VERSION_MAX_SIZE);
@@ -175,15 +239,15 @@ TKStatus ktaSetDeviceInfoConfig
         goto end;
       }
 
-      (void)memcpy(gKtaDeviceInfoConfig.deviceProfilePubUID[0],
+      (void)memcpy(gpKtaDeviceInfoConfig->deviceProfilePubUID[0],
                    xpDeviceProfilePublicUid,
                    xDeviceProfilePublicUidSize);
-      gKtaDeviceInfoConfig.deviceProfilePubUIDLength[0] = (uint8_t)xDeviceProfilePublicUidSize;
+      gpKtaDeviceInfoConfig->deviceProfilePubUIDLength[0] = (uint8_t)xDeviceProfilePublicUidSize;
 
-      (void)memcpy(gKtaDeviceInfoConfig.deviceSerailNo,
+      (void)memcpy(gpKtaDeviceInfoConfig->deviceSerailNo,
                    xpDeviceSerialNum,
                    xDeviceSerialNumSize);
-      gKtaDeviceInfoConfig.deviceSerailNoLength = (uint8_t)xDeviceSerialNumSize;
+      gpKtaDeviceInfoConfig->deviceSerailNoLength = (uint8_t)xDeviceSerialNumSize;
     }
     else if (xState > E_LIFE_CYCLE_STATE_INIT)
     {
@@ -196,21 +260,21 @@ TKStatus ktaSetDeviceInfoConfig
       }
 
       /* Find max size of devProfileUID to compare. */
-      maxDevProfSize = gKtaDeviceInfoConfig.deviceProfilePubUIDLength[0];
-      if (gKtaDeviceInfoConfig.deviceProfilePubUIDLength[1] > maxDevProfSize)
+      maxDevProfSize = gpKtaDeviceInfoConfig->deviceProfilePubUIDLength[0];
+      if (gpKtaDeviceInfoConfig->deviceProfilePubUIDLength[1] > maxDevProfSize)
       {
-        maxDevProfSize = gKtaDeviceInfoConfig.deviceProfilePubUIDLength[1];
+        maxDevProfSize = gpKtaDeviceInfoConfig->deviceProfilePubUIDLength[1];
       }
 
-      if (0 != memcmp(xpDeviceProfilePublicUid, gKtaDeviceInfoConfig.deviceProfilePubUID[0],
+      if (0 != memcmp(xpDeviceProfilePublicUid, gpKtaDeviceInfoConfig->deviceProfilePubUID[0],
                         maxDevProfSize))
       {
         /* Fill the mutable device profile info. */
-        (void)memcpy(gKtaDeviceInfoConfig.deviceProfilePubUID[1],
+        (void)memcpy(gpKtaDeviceInfoConfig->deviceProfilePubUID[1],
                     xpDeviceProfilePublicUid,
                     xDeviceProfilePublicUidSize);
 
-        gKtaDeviceInfoConfig.deviceProfilePubUIDLength[1] = (uint8_t)xDeviceProfilePublicUidSize;
+        gpKtaDeviceInfoConfig->deviceProfilePubUIDLength[1] = (uint8_t)xDeviceProfilePublicUidSize;
       }
     }
     else
@@ -246,24 +310,24 @@ TKStatus ktaGetDeviceInfoConfig
   {
     /* Fill device specific info. */
     (void)memcpy(xpDeviceInfoConfig->deviceProfilePubUID[0],
-                 gKtaDeviceInfoConfig.deviceProfilePubUID[0],
-                 gKtaDeviceInfoConfig.deviceProfilePubUIDLength[0]);
+                 gpKtaDeviceInfoConfig->deviceProfilePubUID[0],
+                 gpKtaDeviceInfoConfig->deviceProfilePubUIDLength[0]);
     xpDeviceInfoConfig->deviceProfilePubUIDLength[0] =
-        gKtaDeviceInfoConfig.deviceProfilePubUIDLength[0];
+        gpKtaDeviceInfoConfig->deviceProfilePubUIDLength[0];
 
-    if (gKtaDeviceInfoConfig.deviceProfilePubUIDLength[1] != 0u)
+    if (gpKtaDeviceInfoConfig->deviceProfilePubUIDLength[1] != 0u)
     {
       (void)memcpy(xpDeviceInfoConfig->deviceProfilePubUID[1],
-                   gKtaDeviceInfoConfig.deviceProfilePubUID[1],
-                   gKtaDeviceInfoConfig.deviceProfilePubUIDLength[1]);
+                   gpKtaDeviceInfoConfig->deviceProfilePubUID[1],
+                   gpKtaDeviceInfoConfig->deviceProfilePubUIDLength[1]);
       xpDeviceInfoConfig->deviceProfilePubUIDLength[1] =
-          gKtaDeviceInfoConfig.deviceProfilePubUIDLength[1];
+          gpKtaDeviceInfoConfig->deviceProfilePubUIDLength[1];
     }
 
     (void)memcpy(xpDeviceInfoConfig->deviceSerailNo,
-                 gKtaDeviceInfoConfig.deviceSerailNo,
-                 gKtaDeviceInfoConfig.deviceSerailNoLength);
-    xpDeviceInfoConfig->deviceSerailNoLength = gKtaDeviceInfoConfig.deviceSerailNoLength;
+                 gpKtaDeviceInfoConfig->deviceSerailNo,
+                 gpKtaDeviceInfoConfig->deviceSerailNoLength);
+    xpDeviceInfoConfig->deviceSerailNoLength = gpKtaDeviceInfoConfig->deviceSerailNoLength;
     status = E_K_STATUS_OK;
   }
 
@@ -300,36 +364,36 @@ TKStatus ktaSetContextInfoConfig
   if (xState == E_LIFE_CYCLE_STATE_INIT)
   {
     M_KTALOG__DEBUG("Setting kta context configuration data to the platform");
-    (void)memset(gKtaContextInfoConfig.ktaContextProfileUid,
+    (void)memset(gpKtaContextInfoConfig->ktaContextProfileUid,
                   0x00,
                   C_K__CONTEXT_PROFILE_UID_MAX_SIZE);
-    (void)memcpy(gKtaContextInfoConfig.ktaContextProfileUid, xpKtaContextProfileUid,
+    (void)memcpy(gpKtaContextInfoConfig->ktaContextProfileUid, xpKtaContextProfileUid,
                   xKtaContextProfileUidLen);
-    gKtaContextInfoConfig.ktaContextProfileUidLength = (uint8_t)xKtaContextProfileUidLen;
+    gpKtaContextInfoConfig->ktaContextProfileUidLength = (uint8_t)xKtaContextProfileUidLen;
 
-    (void)memset(gKtaContextInfoConfig.ktaContexSerialNumber,
+    (void)memset(gpKtaContextInfoConfig->ktaContexSerialNumber,
                   0x00,
                   C_K__CONTEXT_SERIAL_NUMBER_MAX_SIZE);
-    (void)memcpy(gKtaContextInfoConfig.ktaContexSerialNumber, xpKtaContexSerialNumber,
+    (void)memcpy(gpKtaContextInfoConfig->ktaContexSerialNumber, xpKtaContexSerialNumber,
                   xKtaContexSerialNumberLen);
-    gKtaContextInfoConfig.ktaContexSerialNumberLength = (uint8_t)xKtaContexSerialNumberLen;
+    gpKtaContextInfoConfig->ktaContexSerialNumberLength = (uint8_t)xKtaContexSerialNumberLen;
 
-    (void)memset(gKtaContextInfoConfig.ktaContextVersion,
+    (void)memset(gpKtaContextInfoConfig->ktaContextVersion,
                   0x00,
                   C_K__CONTEXT_VERSION_MAX_SIZE);
-    (void)memcpy(gKtaContextInfoConfig.ktaContextVersion,
+    (void)memcpy(gpKtaContextInfoConfig->ktaContextVersion,
                   xpKtaContextVersion,
                   xKtaContextVersionLen);
-    gKtaContextInfoConfig.ktaContextVersionLength = (uint8_t)xKtaContextVersionLen;
+    gpKtaContextInfoConfig->ktaContextVersionLength = (uint8_t)xKtaContextVersionLen;
 
     /* Loading kta version. */
-    (void)memset(gKtaContextInfoConfig.ktaVersion, 0, C_KTA__VERSION_MAX_SIZE);
-    (void)memcpy(gKtaContextInfoConfig.ktaVersion,
+    (void)memset(gpKtaContextInfoConfig->ktaVersion, 0, C_KTA__VERSION_MAX_SIZE);
+    (void)memcpy(gpKtaContextInfoConfig->ktaVersion,
                   ktaGetVersion(),
                   strnlen((const char*)ktaGetVersion(), C_KTA__VERSION_MAX_SIZE));
 
-    (void)memcpy(gKtaContextInfoConfig.l1SegSeed, xpL1SegSeed, C_K__L1_SEGMENTATION_SEED_SIZE);
-    gKtaContextInfoConfig.rotKeySetId = 0;
+    (void)memcpy(gpKtaContextInfoConfig->l1SegSeed, xpL1SegSeed, C_K__L1_SEGMENTATION_SEED_SIZE);
+    gpKtaContextInfoConfig->rotKeySetId = 0;
     status = E_K_STATUS_OK;
   }
   else
@@ -339,7 +403,7 @@ TKStatus ktaSetContextInfoConfig
     handles the error scenario. */
     if (xState == E_LIFE_CYCLE_STATE_SEALED)
     {
-      (void)memcpy(gKtaContextInfoConfig.l1SegSeed,
+      (void)memcpy(gpKtaContextInfoConfig->l1SegSeed,
                     xpL1SegSeed, C_K__L1_SEGMENTATION_SEED_SIZE);
     }
   }
@@ -371,26 +435,26 @@ TKStatus ktaGetContextInfoConfig
     /* Fill context specific platform data. */
     M_KTALOG__DEBUG("Getting kta context specific data");
     (void)memcpy(xpContextInfoConfig->l1SegSeed,
-                 gKtaContextInfoConfig.l1SegSeed,
-                 sizeof(gKtaContextInfoConfig.l1SegSeed));
+                 gpKtaContextInfoConfig->l1SegSeed,
+                 sizeof(gpKtaContextInfoConfig->l1SegSeed));
 
     (void)memcpy(xpContextInfoConfig->ktaContextProfileUid,
-                 gKtaContextInfoConfig.ktaContextProfileUid,
-                 sizeof(gKtaContextInfoConfig.ktaContextProfileUid));
+                 gpKtaContextInfoConfig->ktaContextProfileUid,
+                 sizeof(gpKtaContextInfoConfig->ktaContextProfileUid));
 
     (void)memcpy(xpContextInfoConfig->ktaContexSerialNumber,
-                 gKtaContextInfoConfig.ktaContexSerialNumber,
-                 sizeof(gKtaContextInfoConfig.ktaContexSerialNumber));
+                 gpKtaContextInfoConfig->ktaContexSerialNumber,
+                 sizeof(gpKtaContextInfoConfig->ktaContexSerialNumber));
 
     (void)memcpy(xpContextInfoConfig->ktaContextVersion,
-                 gKtaContextInfoConfig.ktaContextVersion,
-                 sizeof(gKtaContextInfoConfig.ktaContextVersion));
+                 gpKtaContextInfoConfig->ktaContextVersion,
+                 sizeof(gpKtaContextInfoConfig->ktaContextVersion));
 
     (void)memcpy(xpContextInfoConfig->ktaVersion,
-                 gKtaContextInfoConfig.ktaVersion,
-                 sizeof(gKtaContextInfoConfig.ktaVersion));
+                 gpKtaContextInfoConfig->ktaVersion,
+                 sizeof(gpKtaContextInfoConfig->ktaVersion));
 
-    xpContextInfoConfig->rotKeySetId = gKtaContextInfoConfig.rotKeySetId;
+    xpContextInfoConfig->rotKeySetId = gpKtaContextInfoConfig->rotKeySetId;
 
     status = E_K_STATUS_OK;
   }
@@ -419,7 +483,7 @@ TKStatus ktaGetL1SegSeed
   }
   else
   {
-    (void)memcpy(xpL1SegSeed, gKtaContextInfoConfig.l1SegSeed, C_K__L1_SEGMENTATION_SEED_SIZE);
+    (void)memcpy(xpL1SegSeed, gpKtaContextInfoConfig->l1SegSeed, C_K__L1_SEGMENTATION_SEED_SIZE);
     status = E_K_STATUS_OK;
   }
 
@@ -447,7 +511,7 @@ TKStatus ktaGetRotKeySetId
   }
   else
   {
-    *xpRotKeySetId = gKtaContextInfoConfig.rotKeySetId;
+    *xpRotKeySetId = gpKtaContextInfoConfig->rotKeySetId;
     status = E_K_STATUS_OK;
   }
 
@@ -475,7 +539,7 @@ TKStatus ktaSetRotKeySetId
   }
   else
   {
-    gKtaContextInfoConfig.rotKeySetId = xRotKeySetId;
+    gpKtaContextInfoConfig->rotKeySetId = xRotKeySetId;
     status = E_K_STATUS_OK;
   }
 
@@ -483,11 +547,241 @@ TKStatus ktaSetRotKeySetId
   return status;
 }
 
+/**
+ * @brief implement ktaConfigSelectInstance
+ *
+ */
+void ktaConfigSelectInstance
+(
+  uint32_t xInstance
+)
+{
+  if (xInstance < C_KTA_APP__MAX_CONTEXTS)
+  {
+    gpKtaDeviceInfoConfig = &gaKtaDeviceInfoConfig[xInstance];
+    gpKtaContextInfoConfig = &gaKtaContextInfoConfig[xInstance];
+  }
+}
+
+/**
+ * @brief implement ktaConfigClearInstance
+ *
+ */
+void ktaConfigClearInstance
+(
+  uint32_t xInstance
+)
+{
+  if (xInstance < C_KTA_APP__MAX_CONTEXTS)
+  {
+    (void)memset(&gaKtaDeviceInfoConfig[xInstance], 0, sizeof(TKtaDeviceInfoConfig));
+    (void)memset(&gaKtaContextInfoConfig[xInstance], 0, sizeof(TKtaContextInfoConfig));
+  }
+}
+
+#ifdef WARM_START_FEATURE
+/**
+ * @brief implement ktaConfigWarmStartSave
+ *
+ */
+TKStatus ktaConfigWarmStartSave
+(
+  const TKtaLifeCycleState  xState,
+  const uint8_t*            xpL1SegSeed
+)
+{
+  TKStatus status = E_K_STATUS_ERROR;
+  uint8_t  aWarmStart[C_K_KTA__WARM_START_DATA_SIZE] = {0};
+
+  M_KTALOG__START("Start");
+
+  for (;;)
+  {
+    if (C_KTA_CONFIG__WARM_START_LENGTH > C_K_KTA__WARM_START_DATA_SIZE)
+    {
+      M_KTALOG__ERR("Configuration does not fit the warm start data");
+      break;
+    }
+
+    if (0u == gpKtaContextInfoConfig->rotKeySetId)
+    {
+      M_KTALOG__ERR("No rot key set id");
+      status = E_K_STATUS_STATE;
+      break;
+    }
+
+    status = salRotL2KeysSeal();
+
+    if (E_K_STATUS_OK != status)
+    {
+      M_KTALOG__ERR("salRotL2KeysSeal failed[%d]", status);
+      break;
+    }
+
+    aWarmStart[C_KTA_CONFIG__WARM_START_FORMAT_OFFSET] = C_KTA_CONFIG__WARM_START_FORMAT;
+    aWarmStart[C_KTA_CONFIG__WARM_START_STATE_OFFSET] = (uint8_t)xState;
+    aWarmStart[C_KTA_CONFIG__WARM_START_KEY_SET_OFFSET] = gpKtaContextInfoConfig->rotKeySetId;
+    (void)memcpy(&aWarmStart[C_KTA_CONFIG__WARM_START_DEVICE_OFFSET],
+                 gpKtaDeviceInfoConfig,
+                 sizeof(TKtaDeviceInfoConfig));
+    (void)memcpy(&aWarmStart[C_KTA_CONFIG__WARM_START_CONTEXT_OFFSET],
+                 gpKtaContextInfoConfig,
+                 sizeof(TKtaContextInfoConfig));
+    (void)memcpy(&aWarmStart[C_KTA_CONFIG__WARM_START_SEED_OFFSET],
+                 xpL1SegSeed,
+                 C_K__L1_SEGMENTATION_SEED_SIZE);
+
+    status = salStorageSetValue(C_K_KTA__WARM_START_STORAGE_ID,
+                                aWarmStart,
+                                C_K_KTA__WARM_START_DATA_SIZE);
+
+    if (E_K_STATUS_OK != status)
+    {
+      M_KTALOG__ERR("salStorageSetValue failed[%d]", status);
+    }
+
+    break;
+  }
+
+  M_KTALOG__END("End, status : %d", status);
+  return status;
+}
+
+/**
+ * @brief implement ktaConfigWarmStartLoad
+ *
+ */
+TKStatus ktaConfigWarmStartLoad
+(
+  const TKtaLifeCycleState  xState,
+  const uint8_t*            xpL1SegSeed,
+  const uint8_t*            xpKtaContextProfileUid,
+  size_t                    xKtaContextProfileUidLen,
+  const uint8_t*            xpKtaContexSerialNumber,
+  size_t                    xKtaContexSerialNumberLen,
+  const uint8_t*            xpKtaContextVersion,
+  size_t                    xKtaContextVersionLen
+)
+{
+  TKStatus              status = E_K_STATUS_MISSING;
+  uint8_t               aWarmStart[C_K_KTA__WARM_START_DATA_SIZE] = {0};
+  size_t                warmStartLen = C_K_KTA__WARM_START_DATA_SIZE;
+  uint8_t               aKtaVersion[C_KTA__VERSION_MAX_SIZE] = {0};
+  TKtaContextInfoConfig contextInfoConfig;
+
+  M_KTALOG__START("Start");
+
+  for (;;)
+  {
+    if (C_KTA_CONFIG__WARM_START_LENGTH > C_K_KTA__WARM_START_DATA_SIZE)
+    {
+      M_KTALOG__ERR("Configuration does not fit the warm start data");
+      status = E_K_STATUS_ERROR;
+      break;
+    }
+
+    if ((E_K_STATUS_OK != salStorageGetValue(C_K_KTA__WARM_START_STORAGE_ID,
+                                             aWarmStart,
+                                             &warmStartLen)) ||
+        (C_KTA_CONFIG__WARM_START_FORMAT != aWarmStart[C_KTA_CONFIG__WARM_START_FORMAT_OFFSET]))
+    {
+      M_KTALOG__DEBUG("No warm start data");
+      break;
+    }
+
+    (void)memcpy(&contextInfoConfig,
+                 &aWarmStart[C_KTA_CONFIG__WARM_START_CONTEXT_OFFSET],
+                 sizeof(TKtaContextInfoConfig));
+    (void)memcpy(aKtaVersion,
+                 ktaGetVersion(),
+                 strnlen((const char*)ktaGetVersion(), C_KTA__VERSION_MAX_SIZE));
+
+    /* The snapshot only holds for the state, key set and KTA version it was taken with. */
+    if (((uint8_t)xState != aWarmStart[C_KTA_CONFIG__WARM_START_STATE_OFFSET]) ||
+        (0u == aWarmStart[C_KTA_CONFIG__WARM_START_KEY_SET_OFFSET]) ||
+        (contextInfoConfig.rotKeySetId != aWarmStart[C_KTA_CONFIG__WARM_START_KEY_SET_OFFSET]) ||
+        (0 != memcmp(contextInfoConfig.ktaVersion, aKtaVersion, C_KTA__VERSION_MAX_SIZE)))
+    {
+      M_KTALOG__DEBUG("Warm start data outdated, state[%d]",
+                      aWarmStart[C_KTA_CONFIG__WARM_START_STATE_OFFSET]);
+      break;
+    }
+
+    /* Nor does it hold if ktaStartup is now given other context data. */
+    if ((0 != memcmp(&aWarmStart[C_KTA_CONFIG__WARM_START_SEED_OFFSET],
+                     xpL1SegSeed,
+                     C_K__L1_SEGMENTATION_SEED_SIZE)) ||
+        (1u != lIsSameStartupArgument(contextInfoConfig.ktaContextProfileUid,
+                                      contextInfoConfig.ktaContextProfileUidLength,
+                                      xpKtaContextProfileUid,
+                                      xKtaContextProfileUidLen)) ||
+        (1u != lIsSameStartupArgument(contextInfoConfig.ktaContexSerialNumber,
+                                      contextInfoConfig.ktaContexSerialNumberLength,
+                                      xpKtaContexSerialNumber,
+                                      xKtaContexSerialNumberLen)) ||
+        (1u != lIsSameStartupArgument(contextInfoConfig.ktaContextVersion,
+                                      contextInfoConfig.ktaContextVersionLength,
+                                      xpKtaContextVersion,
+                                      xKtaContextVersionLen)))
+    {
+      M_KTALOG__WARN("Warm start data taken with other startup arguments");
+      break;
+    }
+
+    status = salRotL2KeysRestore();
+
+    if (E_K_STATUS_OK != status)
+    {
+      M_KTALOG__ERR("salRotL2KeysRestore failed[%d]", status);
+      status = E_K_STATUS_MISSING;
+      break;
+    }
+
+    (void)memcpy(gpKtaDeviceInfoConfig,
+                 &aWarmStart[C_KTA_CONFIG__WARM_START_DEVICE_OFFSET],
+                 sizeof(TKtaDeviceInfoConfig));
+    (void)memcpy(gpKtaContextInfoConfig, &contextInfoConfig, sizeof(TKtaContextInfoConfig));
+    break;
+  }
+
+  M_KTALOG__END("End, status : %d", status);
+  return status;
+}
+
+/**
+ * @brief implement ktaConfigWarmStartDiscard
+ *
+ */
+TKStatus ktaConfigWarmStartDiscard
+(
+  void
+)
+{
+  TKStatus status = E_K_STATUS_ERROR;
+  uint8_t  aWarmStart[C_K_KTA__WARM_START_DATA_SIZE] = {0};
+
+  M_KTALOG__START("Start");
+
+  /* A zero format marks the snapshot as discarded. */
+  status = salStorageSetValue(C_K_KTA__WARM_START_STORAGE_ID,
+                              aWarmStart,
+                              C_K_KTA__WARM_START_DATA_SIZE);
+
+  if (E_K_STATUS_OK == status)
+  {
+    status = salRotL2KeysDiscard();
+  }
+
+  M_KTALOG__END("End, status : %d", status);
+  return status;
+}
+#endif /* WARM_START_FEATURE */
+
 #ifdef TEST_COVERAGE
 void ktaResetConfig(void)
 {
-  memset(&gKtaDeviceInfoConfig, 0, sizeof(TKtaDeviceInfoConfig));
-  memset(&gKtaContextInfoConfig, 0, sizeof(TKtaContextInfoConfig));
+  memset(gpKtaDeviceInfoConfig, 0, sizeof(TKtaDeviceInfoConfig));
+  memset(gpKtaContextInfoConfig, 0, sizeof(TKtaContextInfoConfig));
 }
 #endif
 /* -------------------------------------------------------------------------- */
@@ -524,47 +818,47 @@ static TKStatus lReadDeviceAndContextInfo
     }
 
     ktaInfoLen = 0;
-    (void)memcpy(gKtaContextInfoConfig.ktaContextProfileUid,
+    (void)memcpy(gpKtaContextInfoConfig->ktaContextProfileUid,
                   &aKtaInfo[ktaInfoLen],
                   C_K__CONTEXT_PROFILE_UID_MAX_SIZE);
     ktaInfoLen += C_K__CONTEXT_PROFILE_UID_MAX_SIZE;
-    gKtaContextInfoConfig.ktaContextProfileUidLength = aKtaInfo[ktaInfoLen];
+    gpKtaContextInfoConfig->ktaContextProfileUidLength = aKtaInfo[ktaInfoLen];
     ktaInfoLen++;
 
-    (void)memcpy(gKtaContextInfoConfig.ktaContexSerialNumber,
+    (void)memcpy(gpKtaContextInfoConfig->ktaContexSerialNumber,
                   &(aKtaInfo[ktaInfoLen]),
                   C_K__CONTEXT_SERIAL_NUMBER_MAX_SIZE);
     ktaInfoLen += C_K__CONTEXT_SERIAL_NUMBER_MAX_SIZE;
-    gKtaContextInfoConfig.ktaContexSerialNumberLength = aKtaInfo[ktaInfoLen];
+    gpKtaContextInfoConfig->ktaContexSerialNumberLength = aKtaInfo[ktaInfoLen];
     ktaInfoLen++;
 
-    (void)memcpy(gKtaContextInfoConfig.ktaContextVersion,
+    (void)memcpy(gpKtaContextInfoConfig->ktaContextVersion,
                   &(aKtaInfo[ktaInfoLen]),
                   C_K__CONTEXT_VERSION_MAX_SIZE);
     ktaInfoLen += C_K__CONTEXT_VERSION_MAX_SIZE;
-    gKtaContextInfoConfig.ktaContextVersionLength = aKtaInfo[ktaInfoLen];
+    gpKtaContextInfoConfig->ktaContextVersionLength = aKtaInfo[ktaInfoLen];
     ktaInfoLen++;
 
     /* KTA version should not be read from NVM. */
     // REQ RQ_M-KTA-REGT-CF-0070(1) : KTA Version
-    (void)memset(gKtaContextInfoConfig.ktaVersion, 0, C_KTA__VERSION_MAX_SIZE);
-    (void)memcpy(gKtaContextInfoConfig.ktaVersion,
+    (void)memset(gpKtaContextInfoConfig->ktaVersion, 0, C_KTA__VERSION_MAX_SIZE);
+    (void)memcpy(gpKtaContextInfoConfig->ktaVersion,
                   ktaGetVersion(),
                   strnlen((const char*)ktaGetVersion(), C_KTA__VERSION_MAX_SIZE));
     ktaInfoLen += C_KTA__VERSION_MAX_SIZE;
 
-    (void)memcpy(gKtaDeviceInfoConfig.deviceProfilePubUID[0],
+    (void)memcpy(gpKtaDeviceInfoConfig->deviceProfilePubUID[0],
                   &aKtaInfo[ktaInfoLen],
                   C_K__DEVICE_PROFILE_PUBLIC_UID_MAX_SIZE);
     ktaInfoLen += C_K__DEVICE_PROFILE_PUBLIC_UID_MAX_SIZE;
-    gKtaDeviceInfoConfig.deviceProfilePubUIDLength[0] = aKtaInfo[ktaInfoLen];
+    gpKtaDeviceInfoConfig->deviceProfilePubUIDLength[0] = aKtaInfo[ktaInfoLen];
     ktaInfoLen++;
 
-    (void)memcpy(gKtaDeviceInfoConfig.deviceSerailNo,
+    (void)memcpy(gpKtaDeviceInfoConfig->deviceSerailNo,
                   &aKtaInfo[ktaInfoLen],
                   C_K__DEVICE_SERIAL_NUM_MAX_SIZE);
     ktaInfoLen += C_K__DEVICE_SERIAL_NUM_MAX_SIZE;
-    gKtaDeviceInfoConfig.deviceSerailNoLength = aKtaInfo[ktaInfoLen];
+    gpKtaDeviceInfoConfig->deviceSerailNoLength = aKtaInfo[ktaInfoLen];
   }
 
   if ((xState == E_LIFE_CYCLE_STATE_ACTIVATED) ||
@@ -586,14 +880,38 @@ static TKStatus lReadDeviceAndContextInfo
       goto end;
     }
 
-    (void)memcpy(gKtaContextInfoConfig.l1SegSeed, aL1KeyMaterial, C_K__L1_SEGMENTATION_SEED_SIZE);
-    gKtaContextInfoConfig.rotKeySetId = aL1KeyMaterial[C_K__L1_SEGMENTATION_SEED_SIZE];
+    (void)memcpy(gpKtaContextInfoConfig->l1SegSeed, aL1KeyMaterial, C_K__L1_SEGMENTATION_SEED_SIZE);
+    gpKtaContextInfoConfig->rotKeySetId = aL1KeyMaterial[C_K__L1_SEGMENTATION_SEED_SIZE];
   }
 
 end:
   return status;
 }
 
+#ifdef WARM_START_FEATURE
+/**
+ * @implements lIsSameStartupArgument
+ *
+ */
+static uint8_t lIsSameStartupArgument
+(
+  const uint8_t*  xpStored,
+  size_t          xStoredLen,
+  const uint8_t*  xpArgument,
+  size_t          xArgumentLen
+)
+{
+  uint8_t isSame = 0u;
+
+  if ((xStoredLen == xArgumentLen) && (0 == memcmp(xpStored, xpArgument, xArgumentLen)))
+  {
+    isSame = 1u;
+  }
+
+  return isSame;
+}
+#endif /* WARM_START_FEATURE */
+
 /* -------------------------------------------------------------------------- */
 /* END OF FILE                                                                */
 /* -------------------------------------------------------------------------- */
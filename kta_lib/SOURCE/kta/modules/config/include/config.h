@@ -314,6 +314,108 @@ TKStatus ktaSetRotKeySetId
   uint8_t xRotKeySetId
 );
 
+/**
+ * @brief
+ *   Select the configuration instance used by the calling thread.
+ *
+ * @param[in] xInstance
+ *   Instance index, lower than C_KTA_APP__MAX_CONTEXTS.
+ */
+void ktaConfigSelectInstance
+(
+  uint32_t xInstance
+);
+
+/**
+ * @brief
+ *   Reset a configuration instance, so that it is blank for the next context using it.
+ *
+ * @param[in] xInstance
+ *   Instance index, lower than C_KTA_APP__MAX_CONTEXTS.
+ */
+void ktaConfigClearInstance
+(
+  uint32_t xInstance
+);
+
+#ifdef WARM_START_FEATURE
+/**
+ * @brief
+ *   Seal the L2 keys and save the decoded device and context configuration,
+ *   to be restored by ktaConfigWarmStartLoad on the next boot.
+ *
+ * @param[in] xState
+ *   keySTREAM Trusted Agent Life cycle state the snapshot is valid for.
+ * @param[in] xpL1SegSeed
+ *   L1 segmentation seed given to ktaStartup, the snapshot is only valid for it.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_STATE if no rot key set id is known yet.
+ * - E_K_STATUS_ERROR for other errors.
+ */
+TKStatus ktaConfigWarmStartSave
+(
+  const TKtaLifeCycleState  xState,
+  const uint8_t*            xpL1SegSeed
+);
+
+/**
+ * @brief
+ *   Restore the device and context configuration and the L2 keys saved by
+ *   ktaConfigWarmStartSave, replacing the NVM reads and the L2 key derivation.
+ *   The snapshot is rejected unless the ktaStartup arguments match the ones it
+ *   was taken with.
+ *
+ * @param[in] xState
+ *   keySTREAM Trusted Agent Life cycle state read from NVM.
+ * @param[in] xpL1SegSeed
+ *   L1 segmentation seed given to ktaStartup.
+ * @param[in] xpKtaContextProfileUid
+ *   Context profile uid given to ktaStartup.
+ * @param[in] xKtaContextProfileUidLen
+ *   Length of xpKtaContextProfileUid, in bytes.
+ * @param[in] xpKtaContexSerialNumber
+ *   Context serial number given to ktaStartup.
+ * @param[in] xKtaContexSerialNumberLen
+ *   Length of xpKtaContexSerialNumber, in bytes.
+ * @param[in] xpKtaContextVersion
+ *   Context version given to ktaStartup.
+ * @param[in] xKtaContextVersionLen
+ *   Length of xpKtaContextVersion, in bytes.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_MISSING if no valid snapshot matches xState and the arguments.
+ * - E_K_STATUS_ERROR for other errors.
+ */
+TKStatus ktaConfigWarmStartLoad
+(
+  const TKtaLifeCycleState  xState,
+  const uint8_t*            xpL1SegSeed,
+  const uint8_t*            xpKtaContextProfileUid,
+  size_t                    xKtaContextProfileUidLen,
+  const uint8_t*            xpKtaContexSerialNumber,
+  size_t                    xKtaContexSerialNumberLen,
+  const uint8_t*            xpKtaContextVersion,
+  size_t                    xKtaContextVersionLen
+);
+
+/**
+ * @brief
+ *   Invalidate the warm start snapshot and destroy the sealed L2 keys.
+ *   To be called whenever the L1 field key changes.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_ERROR for other errors.
+ */
+TKStatus ktaConfigWarmStartDiscard
+(
+  void
+);
+#endif /* WARM_START_FEATURE */
+
 #ifdef TEST_COVERAGE
 void ktaResetConfig(void);
 #endif
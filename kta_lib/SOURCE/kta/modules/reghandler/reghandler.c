@@ -48,6 +48,7 @@
 #include "k_crypto.h"
 #include "general.h"
 #include "KTALog.h"
+#include "KTABench.h"
 #include "cryptoConfig.h"
 
 #include <string.h>
@@ -178,6 +179,7 @@ TKStatus ktaregBuildRegistrationRequest
   TKRegInfoPayload      xpRegInfo = {0};
 
   M_KTALOG__START("Start");
+  M_KTABENCH__START(E_KTABENCH_PHASE_REGISTRATION);
 
   if ((NULL == xpRecvdProtoMessage) ||
       (NULL == xpMessageToSend) ||
@@ -262,6 +264,7 @@ TKStatus ktaregBuildRegistrationRequest
   }
 
 end:
+  M_KTABENCH__END(E_KTABENCH_PHASE_REGISTRATION);
   M_KTALOG__END("End, status : %d", status);
   return status;
 }
@@ -155,13 +155,41 @@ extern "C" {
 #define C_KTA__FIELD_KEY_FIXED_INFO_L1SEGSEED_POS 55
 
 // Vendor specific maximum buffer size for icpp messages
+// May be raised up to C_K__ICPP_MSG_LIMIT so that e.g. a full certificate chain comes in
+// one exchange; messages larger than C_K__ICPP_WORK_BUFFER_SIZE are then decrypted and
+// processed one command at a time.
+// Decryption is incremental, each command is chained from the previous cipher block, but
+// salCryptoHmacVerify() takes the whole message, so the encrypted message is kept in full.
+// Raising this value costs RAM in every buffer sized by it, not in the working buffer:
+// - the application receive and send buffers given to ktaExchangeMessage();
+// - with the fleet hook, one received message per slot (static) and one message to send
+//   on the stack of each worker;
+// - with the field hook, one static message buffer.
+// The transport must also be able to carry such a message.
+#ifndef C_K__ICPP_MSG_MAX_SIZE
 #define C_K__ICPP_MSG_MAX_SIZE          1400U
+#endif
+
+// Largest icpp message: header, then up to 0xFFFF bytes as counted by its length field
+#define C_K__ICPP_MSG_LIMIT             (21U + 0xFFFFU)
+
+#if (C_K__ICPP_MSG_MAX_SIZE > C_K__ICPP_MSG_LIMIT)
+#error "C_K__ICPP_MSG_MAX_SIZE exceeds what the icpp header can describe"
+#endif
+
+// Vendor specific working buffer holding a decrypted icpp message, or a single command of
+// a larger one; the largest command keySTREAM sends must fit in it
+#ifndef C_K__ICPP_WORK_BUFFER_SIZE
+#define C_K__ICPP_WORK_BUFFER_SIZE      1400U
+#endif
 
 // Vendor specific chip certificate size
 #define C_K__CHIP_CERT_MAX_SIZE_VENDOR_SPECIFIC  1400
 
 // Vendor specific command response size (Obj Mgnt)
+#ifndef C_K__ICPP_CMD_RESPONSE_SIZE_VENDOR_SPECIFIC
 #define C_K__ICPP_CMD_RESPONSE_SIZE_VENDOR_SPECIFIC  (512U)
+#endif
 
 // chip attestation certificate tag as per icpp_parser.h
 #define C_K__ICPP_FIELD_TAG_PUB_KEY_VENDOR_SPECIFIC  0xF9
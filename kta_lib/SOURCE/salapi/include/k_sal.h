@@ -111,6 +111,8 @@ extern "C" {
 #define C_K_KTA__CUSTOMER_TRUST_ANCHOR_DATA_ID        (0X400Fu)
 /** @brief slot 14 clear data ID **/
 #define C_K_KTA__ENC_TEMPKEY_ID                       (0X4010u)
+/** @brief Warm start data ID, configuration snapshot restored by ktaStartup. **/
+#define C_K_KTA__WARM_START_STORAGE_ID                (0X4011u)
 
 
 /**
@@ -149,6 +151,9 @@ extern "C" {
 /** @brief Maximal size of Rot public uid field, in bytes. */
 #define C_K_KTA__ROT_PUBLIC_UID_MAX_SIZE      (8u)
 
+/** @brief Size of the warm start data, in bytes. */
+#define C_K_KTA__WARM_START_DATA_SIZE         (208u)
+
 /** @brief Maximal size of command field , in bytes. */
 #define C_K_KTA__CMD_FIELD_MAX_SIZE           (2000u)
 
@@ -192,6 +192,94 @@ K_SAL_API TKStatus salCryptoAesDec
   size_t*         xpOutputDataLen
 );
 
+/**
+ * @brief
+ *   Encrypt data in place based on AES-128 CBC and compute HMAC SHA256 over the
+ *   associated data followed by the encrypted data, in a single pass.
+ *   The keys are always located inside the secure platform and addressed by an identifier.
+ *   The computed MAC is always exported to Host.
+ *
+ * @param[in] xCipherKeyId
+ *   AES key identifier.
+ * @param[in] xMacKeyId
+ *   HMAC key identifier.
+ * @param[in] xpAad
+ *   Data authenticated but not encrypted (e.g. message header). Should not be NULL.
+ * @param[in] xAadLen
+ *   Length of xpAad.
+ * @param[in,out] xpData
+ *   [in] Plain data, multiple of the AES block size. Should not be NULL.
+ *   [out] Encrypted data.
+ * @param[in] xDataLen
+ *   Length of xpData.
+ * @param[out] xpMac
+ *   Buffer to carry the computed MAC.
+ *   Length is fixed to 16-Bytes(C_K_KTA__HMAC_MAX_SIZE),
+ *   the caller shall allocate sufficient memory.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_PARAMETER for wrong input parameter.
+ * - E_K_STATUS_ERROR for other errors.
+ */
+K_SAL_API TKStatus salCryptoAesEncHmac
+(
+  uint32_t        xCipherKeyId,
+  uint32_t        xMacKeyId,
+  const uint8_t*  xpAad,
+  size_t          xAadLen,
+  uint8_t*        xpData,
+  size_t          xDataLen,
+  uint8_t*        xpMac
+);
+
+/**
+ * @brief
+ *   Verify HMAC SHA256 over the associated data followed by the encrypted data
+ *   and decrypt it based on AES-128 CBC, in a single pass.
+ *   The keys are always located inside the secure platform and addressed by an identifier.
+ *   The output buffer is cleared when the MAC does not match.
+ *
+ * @param[in] xCipherKeyId
+ *   AES key identifier.
+ * @param[in] xMacKeyId
+ *   HMAC key identifier.
+ * @param[in] xpAad
+ *   Data authenticated but not encrypted (e.g. message header). Should not be NULL.
+ * @param[in] xAadLen
+ *   Length of xpAad.
+ * @param[in] xpInputData
+ *   Encrypted data, multiple of the AES block size. Should not be NULL.
+ * @param[in] xInputDataLen
+ *   Length of xpInputData.
+ * @param[in] xpMac
+ *   MAC to verify, 16-Bytes(C_K_KTA__HMAC_MAX_SIZE). Should not be NULL.
+ * @param[out] xpOutputData
+ *   Plain output data buffer, may be xpInputData. Should not be NULL.
+ * @param[in,out] xpOutputDataLen
+ *   [in] Length of xpOutputData buffer.
+ *   [out] Length of filled output data.
+ *   Should not be NULL.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_PARAMETER for wrong input parameter.
+ * - E_K_STATUS_ERROR if the MAC does not match.
+ * - E_K_STATUS_DECRYPTION if the MAC matches but decryption failed.
+ */
+K_SAL_API TKStatus salCryptoHmacVerifyAesDec
+(
+  uint32_t        xCipherKeyId,
+  uint32_t        xMacKeyId,
+  const uint8_t*  xpAad,
+  size_t          xAadLen,
+  const uint8_t*  xpInputData,
+  size_t          xInputDataLen,
+  const uint8_t*  xpMac,
+  uint8_t*        xpOutputData,
+  size_t*         xpOutputDataLen
+);
+
 /**
  * @brief
  *   Get random value.
@@ -248,6 +336,43 @@ TKStatus salSignHash
   size_t*   xpActualSignedHashOutLen
 );
 
+/**
+ * @brief
+ *   Select the crypto instance used by the calling thread.
+ *   Each instance keeps its own session keys, so that several keySTREAM Trusted Agent
+ *   contexts can run concurrently.
+ *
+ * @param[in] xInstance
+ *   Instance index, lower than C_KTA_APP__MAX_CONTEXTS.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_PARAMETER for wrong input parameter.
+ */
+K_SAL_API TKStatus salCryptoSelectInstance
+(
+  uint32_t  xInstance
+);
+
+/**
+ * @brief
+ *   Destroy the keys held by a crypto instance, including its persistent L1 field key
+ *   and sealed L2 keys, and reset its session, so that the instance is blank for the
+ *   next context using it.
+ *
+ * @param[in] xInstance
+ *   Instance index, lower than C_KTA_APP__MAX_CONTEXTS.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_PARAMETER for wrong input parameter.
+ * - E_K_STATUS_ERROR if a key could not be destroyed.
+ */
+K_SAL_API TKStatus salCryptoClearInstance
+(
+  uint32_t  xInstance
+);
+
 /** @} g_sal_api */
 #ifdef __cplusplus
 }
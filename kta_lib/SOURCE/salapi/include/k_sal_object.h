@@ -54,6 +54,7 @@ extern "C" {
 /* IMPORTS                                                                    */
 /* -------------------------------------------------------------------------- */
 #include "k_defs.h"
+#include "ktaConfig.h"
 
 #include <stddef.h>
 #include <stdint.h>
@@ -449,6 +450,54 @@ K_SAL_API TKStatus salGetChallenge
   uint8_t* xpPlatformStatus
 );
 
+/**
+ * @brief
+ *   Select the object instance used by the calling thread.
+ *   Each instance stores its objects and keys under its own identifiers, so that
+ *   several keySTREAM Trusted Agent contexts do not overwrite each other:
+ *   - the storage uid of an object carries the instance in its upper 32 bits;
+ *   - the PSA key id of a key is the keySTREAM key id plus 0x02000000 per instance.
+ *   Instance 0 keeps the keySTREAM identifiers. With several contexts, keySTREAM key
+ *   ids must be below 0x01000000.
+ *
+ * @param[in] xInstance
+ *   Instance index, lower than C_KTA_APP__MAX_CONTEXTS.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_PARAMETER for wrong input parameter.
+ */
+K_SAL_API TKStatus salObjectSelectInstance
+(
+  uint32_t  xInstance
+);
+
+#ifdef KEY_PAIR_POOL_FEATURE
+/**
+ * @brief
+ *    Generates key pairs ahead of time into the free slots of the key pair pool.
+ *    salObjectKeyGen binds a pooled key pair to the requested identifier instead of
+ *    generating one, when the requested type, size and algorithm match the pool and
+ *    the requested usage is within the pool usage.
+ *
+ * @param[in] xMaxCount
+ *   Maximum number of key pairs generated by this call.
+ * @param[out] xpReadyCount
+ *   Number of key pairs in the pool on return.
+ *   Should not be NULL.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_PARAMETER for wrong input parameter(s).
+ * - E_K_STATUS_ERROR for other errors.
+ */
+K_SAL_API TKStatus salObjectKeyPoolRefill
+(
+  uint32_t  xMaxCount,
+  uint32_t* xpReadyCount
+);
+#endif /* KEY_PAIR_POOL_FEATURE */
+
 /** @} g_sal_api */
 
 #ifdef __cplusplus
@@ -246,6 +246,52 @@ K_SAL_API TKStatus salRotGetChipCertificate
   size_t*   xpChipCertLen
 );
 
+#ifdef WARM_START_FEATURE
+/**
+ * @brief
+ *   Seal the L2 keys derived from the L1 field key (C_K_KTA__VOLATILE_2_ID and
+ *   C_K_KTA__VOLATILE_3_ID) in persistent key slots of the secure platform,
+ *   so that salRotL2KeysRestore can bring them back on the next boot.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_STATE if the L2 keys are not derived.
+ * - E_K_STATUS_ERROR for other errors.
+ */
+K_SAL_API TKStatus salRotL2KeysSeal
+(
+  void
+);
+
+/**
+ * @brief
+ *   Bind C_K_KTA__VOLATILE_2_ID and C_K_KTA__VOLATILE_3_ID to the L2 keys sealed by
+ *   salRotL2KeysSeal, no key derivation takes place.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_MISSING if no sealed L2 keys are available.
+ * - E_K_STATUS_ERROR for other errors.
+ */
+K_SAL_API TKStatus salRotL2KeysRestore
+(
+  void
+);
+
+/**
+ * @brief
+ *   Destroy the L2 keys sealed by salRotL2KeysSeal, e.g. when the L1 field key changes.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_ERROR for other errors.
+ */
+K_SAL_API TKStatus salRotL2KeysDiscard
+(
+  void
+);
+#endif /* WARM_START_FEATURE */
+
 /** @} g_sal_api */
 
 #ifdef __cplusplus
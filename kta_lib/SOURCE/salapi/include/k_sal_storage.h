@@ -147,6 +147,108 @@ K_SAL_API TKStatus salStorageGetValue
   size_t*   xpDataLen
 );
 
+/**
+ * @brief
+ *   Select the storage instance used by the calling thread.
+ *   Each instance stores its data under its own identifiers, so that several
+ *   keySTREAM Trusted Agent contexts do not overwrite each other.
+ *
+ * @param[in] xInstance
+ *   Instance index, lower than C_KTA_APP__MAX_CONTEXTS.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_PARAMETER for wrong input parameter.
+ */
+K_SAL_API TKStatus salStorageSelectInstance
+(
+  uint32_t  xInstance
+);
+
+/**
+ * @brief
+ *   Erase the data stored by an instance and forget its cached record,
+ *   so that the instance is blank for the next context using it.
+ *
+ * @param[in] xInstance
+ *   Instance index, lower than C_KTA_APP__MAX_CONTEXTS.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_PARAMETER for wrong input parameter.
+ * - E_K_STATUS_ERROR if a data could not be erased.
+ */
+K_SAL_API TKStatus salStorageClearInstance
+(
+  uint32_t  xInstance
+);
+
+/**
+ * @brief
+ *   Open a storage batch for the calling thread on the selected instance.
+ *   Until salStorageBatchCommit, salStorageSetValue and salStorageSetAndLockValue
+ *   stage the life cycle state, the L1 key material and the rot public UID in RAM
+ *   instead of writing them, and salStorageGetValue returns the staged values.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_STATE if a batch is already open.
+ * - E_K_STATUS_ERROR for other errors.
+ */
+K_SAL_API TKStatus salStorageBatchBegin
+(
+  void
+);
+
+/**
+ * @brief
+ *   Stage a data in the batch opened by the calling thread.
+ *
+ * @param[in] xStorageDataId
+ *   C_K_KTA__LIFE_CYCLE_STATE_STORAGE_ID, C_K_KTA__L1_KEY_MATERIAL_DATA_ID or
+ *   C_K_KTA__ROT_PUBLIC_UID_STORAGE_ID.
+ * @param[in] xpData
+ *   Address of buffer containing the input data.
+ *   Should not be NULL.
+ * @param[in] xDataLen
+ *   Length of xpData buffer in bytes.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_PARAMETER for wrong input parameter(s).
+ * - E_K_STATUS_STATE if no batch is open.
+ */
+K_SAL_API TKStatus salStorageBatchStage
+(
+  uint32_t        xStorageDataId,
+  const uint8_t*  xpData,
+  size_t          xDataLen
+);
+
+/**
+ * @brief
+ *   Write every staged data in a single atomic storage write and close the batch.
+ *   Nothing is written when no data was staged.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_STATE if no batch is open.
+ * - E_K_STATUS_ERROR for other errors.
+ */
+K_SAL_API TKStatus salStorageBatchCommit
+(
+  void
+);
+
+/**
+ * @brief
+ *   Close the batch of the calling thread, dropping the staged data.
+ */
+K_SAL_API void salStorageBatchAbort
+(
+  void
+);
+
 /** @} g_sal_api */
 
 #ifdef __cplusplus
@@ -58,9 +58,16 @@
 /* LOCAL CONSTANTS, TYPES, ENUM                                               */
 /* -------------------------------------------------------------------------- */
 
-/** @brief L1 field key id. */
+/** @brief Persistent PSA key id of the L1 field key, for instance 0. */
 #define C_SAL_CRYPTO_PSA_L1_FIELD_KEY_ID        (0x01000100u)
 
+/** @brief Distance between the L1 field key ids of two consecutive instances. */
+#define C_SAL_CRYPTO_PSA_L1_FIELD_KEY_ID_STEP   (0x1u)
+
+#if ((C_KTA_APP__MAX_CONTEXTS * C_SAL_CRYPTO_PSA_L1_FIELD_KEY_ID_STEP) > 0x100u)
+#error "The L1 field key ids of all contexts must stay below the sealed L2 key ids"
+#endif
+
 /** @brief Attestation Certificate Maximum Length. */
 #define C_SAL_CRYPTO_ATTEST_CERT_MAX_LENGTH     (512u)
 
@@ -110,6 +117,26 @@
 /** @brief Birth certificate TAG. */
 #define C_BIRTH_CERT_TAG                        (0xF3u)
 
+/** @brief AES block size. */
+#define C_SAL_CRYPTO_AES_BLOCK_SIZE             (16u)
+
+/**
+ * @brief Chunk processed by the cipher and the MAC in turn in single pass operations.
+ * Small enough for the chunk to stay in cache between both, multiple of the AES block size.
+ */
+#define C_SAL_CRYPTO_STREAM_CHUNK_SIZE          (256u)
+
+#ifdef WARM_START_FEATURE
+/** @brief Persistent PSA key id of the sealed L2 auth key, for instance 0. */
+#define C_SAL_CRYPTO_PSA_SEALED_L2_AUTH_KEY_ID  (0x01000200u)
+
+/** @brief Persistent PSA key id of the sealed L2 encryption key, for instance 0. */
+#define C_SAL_CRYPTO_PSA_SEALED_L2_ENC_KEY_ID   (0x01000201u)
+
+/** @brief Distance between the sealed L2 key ids of two consecutive instances. */
+#define C_SAL_CRYPTO_PSA_SEALED_KEY_ID_STEP     (0x10u)
+#endif /* WARM_START_FEATURE */
+
 
 /** @brief Sal ID Map Object. */
 typedef struct
@@ -123,6 +150,36 @@ typedef struct
   /* Session obj ID buffer. */
 } TKSalObjectIdMap;
 
+/** @brief Number of entries in the Sal ID map table. */
+#define C_SAL_CRYPTO_OBJECT_ID_MAP_SIZE         (5u)
+
+/**
+ * @brief Crypto session, alive as long as the L2 session keys.
+ * Key ids are resolved once when the keys are derived instead of on every message.
+ */
+typedef struct
+{
+  psa_key_id_t macKeyId;
+  /* PSA key behind C_K_KTA__VOLATILE_2_ID, 0 when not derived. */
+  psa_key_id_t cipherKeyId;
+  /* PSA key behind C_K_KTA__VOLATILE_3_ID, 0 when not derived. */
+  psa_cipher_operation_t cipherOp;
+  /* Cipher operation object reused by every AES operation. */
+} TKSalCryptoSession;
+
+/** @brief Sal crypto instance, one per keySTREAM Trusted Agent context. */
+typedef struct
+{
+  TKSalObjectIdMap aObjectIdMap[C_SAL_CRYPTO_OBJECT_ID_MAP_SIZE];
+  /* Sal object ID map table. */
+  uint8_t aSharedSecret[C_SHARED_SECRET_KEY_LEN];
+  /* Shared secret key. */
+  TKSalCryptoSession session;
+  /* L2 session crypto state. */
+  uint8_t isInitialized;
+  /* Set once the map table has been loaded with its default content. */
+} TKSalCryptoInstance;
+
 /** @brief Cipher Operation types. */
 typedef enum
 {
@@ -141,8 +198,8 @@ typedef enum
 /** @brief Macro to enable debug logs. */
 static const char* gpModuleName = "SALCRYPTO";
 
-/** @brief Sal object ID map table. */
-static TKSalObjectIdMap gaSalObjectIdMapTable[] =
+/** @brief Default content of the Sal object ID map table. */
+static const TKSalObjectIdMap gaSalObjectIdMapTable[C_SAL_CRYPTO_OBJECT_ID_MAP_SIZE] =
 {
   {C_K_KTA__CHIP_SK_ID, {{[0] = 0x01}}},
   {C_K_KTA__VOLATILE_ID, {{0}}},
@@ -151,11 +208,24 @@ static TKSalObjectIdMap gaSalObjectIdMapTable[] =
   {C_K_KTA__L1_FIELD_KEY_ID, {{0}}}
 };
 
-/* Shared secret key. */
-static uint8_t      gaSharedSecret[C_SHARED_SECRET_KEY_LEN] = {0};
+/* Sal crypto instances, one per keySTREAM Trusted Agent context. */
+static TKSalCryptoInstance gaSalCryptoInstance[C_KTA_APP__MAX_CONTEXTS];
+
+/* Sal crypto instance selected by the calling thread. */
+static C_KTA_APP__THREAD_LOCAL TKSalCryptoInstance* gpSalCryptoInstance = &gaSalCryptoInstance[0];
 
 /* Psa return status. */
-static psa_status_t gPsaStatus;
+static C_KTA_APP__THREAD_LOCAL psa_status_t gPsaStatus;
+
+/** @brief Fixed IV used by AES-128 CBC operations. */
+static const uint8_t gaCbcIv[C_SAL_CRYPTO_AES_BLOCK_SIZE] =
+{
+  0xA9, 0x32, 0x30, 0x31, 0x38, 0x4E, 0x61, 0x67,
+  0x72, 0x61, 0x76, 0x69, 0x73, 0x69, 0x6F, 0x6E
+};
+
+/* Set once psa_crypto_init succeeded, the PSA core is shared by all contexts. */
+static volatile uint8_t gIsPsaInitialized = 0u;
 /* -------------------------------------------------------------------------- */
 /* LOCAL FUNCTIONS - PROTOTYPE                                                */
 /* -------------------------------------------------------------------------- */
@@ -182,6 +252,19 @@ static TKStatus lSetValueById
   size_t    xValueLen
 );
 
+/**
+ * @brief
+ *   Get the crypto instance selected by the calling thread.
+ *   The instance map table is loaded with its default content on first use.
+ *
+ * @return
+ * - Selected crypto instance.
+ */
+static TKSalCryptoInstance* lGetInstance
+(
+  void
+);
+
 /**
  * @brief
  *   Get the value using the ID
@@ -204,6 +287,19 @@ static TKStatus lGetValueById
   size_t    xValueLen
 );
 
+/**
+ * @brief
+ *   Initialize the PSA core on first use only.
+ *
+ * @return
+ * - PSA_SUCCESS in case of success.
+ * - Status of psa_crypto_init otherwise.
+ */
+static psa_status_t lPsaCryptoInit
+(
+  void
+);
+
 /**
  * @brief
  *   Generic function to encrypt/decrypt  data based on AES-128 CBC.
@@ -239,6 +335,40 @@ static TKStatus lDoCipherOps
   size_t*         xpOutputDataLen
 );
 
+/**
+ * @brief
+ *   Run AES-128 CBC over the input with the session cipher key, feeding the MAC
+ *   operation with the encrypted side of each chunk while it is still in cache.
+ *
+ * @param[in] xOps
+ *   Input operation type.
+ * @param[in,out] xpMacOp
+ *   MAC operation, already set up. Should not be NULL.
+ * @param[in] xpInputData
+ *   Input data. Should not be NULL.
+ * @param[in] xInputDataLen
+ *   Length of xpInputData.
+ * @param[out] xpOutputData
+ *   Output data, may be xpInputData. Should not be NULL.
+ * @param[in,out] xpOutputDataLen
+ *   [in]  Length of xpOutputData buffer.
+ *   [out] Length of filled output data.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_ERROR if the MAC operation failed.
+ * - E_K_STATUS_DECRYPTION if only the cipher operation failed, the MAC covers the whole input.
+ */
+static TKStatus lStreamCipherMac
+(
+  TKCipherOps           xOps,
+  psa_mac_operation_t*  xpMacOp,
+  const uint8_t*        xpInputData,
+  size_t                xInputDataLen,
+  uint8_t*              xpOutputData,
+  size_t*               xpOutputDataLen
+);
+
 /**
  * @brief
  *   Destory the psa key based on the object Id.
@@ -251,6 +381,35 @@ static psa_status_t lPsaDestoryKey
   uint32_t  xObjectId
 );
 
+/**
+ * @brief
+ *   Get the persistent PSA key id of the L1 field key of the selected instance.
+ *
+ * @return
+ *   Persistent PSA key id.
+ */
+static psa_key_id_t lGetL1FieldKeyId
+(
+  void
+);
+
+#ifdef WARM_START_FEATURE
+/**
+ * @brief
+ *   Get the persistent PSA key id sealing an L2 key of the selected instance.
+ *
+ * @param[in] xObjectId
+ *   C_K_KTA__VOLATILE_2_ID or C_K_KTA__VOLATILE_3_ID.
+ *
+ * @return
+ *   Persistent PSA key id.
+ */
+static psa_key_id_t lGetSealedKeyId
+(
+  uint32_t  xObjectId
+);
+#endif /* WARM_START_FEATURE */
+
 /**
  * @brief
  *   Convert little endien to big endien.
@@ -531,7 +690,14 @@ K_SAL_API TKStatus salRotKeyAgreement
     aPeerKey[0] = 0x04;
     (void)memcpy(&aPeerKey[1], xpPeerPublicKey, C_K_KTA__PUBLIC_KEY_MAX_SIZE);
 
-    psa_crypto_init();
+    gPsaStatus = lPsaCryptoInit();
+
+    if (PSA_SUCCESS != gPsaStatus)
+    {
+      M_KTALOG__ERR("psa_crypto_init failed[%d]", gPsaStatus);
+      break;
+    }
+
     gPsaStatus = psa_raw_key_agreement(PSA_ALG_ECDH,
                                        keyId,
                                        aPeerKey,
@@ -548,7 +714,7 @@ K_SAL_API TKStatus salRotKeyAgreement
 
     if (exposeSecret == 0u)
     {
-      (void)memcpy(gaSharedSecret, aSharedSecret, C_K_KTA__SHARED_SECRET_KEY_MAX_SIZE);
+      (void)memcpy(lGetInstance()->aSharedSecret, aSharedSecret, C_K_KTA__SHARED_SECRET_KEY_MAX_SIZE);
     }
     else
     {
@@ -637,7 +803,7 @@ K_SAL_API TKStatus salRotHkdfExtractAndExpand
 
     if (xMode == C_K_KTA__HKDF_ACT_MODE)
     {
-      (void)memcpy(aSec, gaSharedSecret, 32);
+      (void)memcpy(aSec, lGetInstance()->aSharedSecret, 32);
       (void)memcpy(aSalt, xpSalt, C_MAX_SIG_MSG_SIZE);
       saltLen = C_MAX_SIG_MSG_SIZE;
       secLen = 32;
@@ -648,12 +814,12 @@ K_SAL_API TKStatus salRotHkdfExtractAndExpand
       (void)memcpy(aSalt, xpSalt, C_MAX_SECRET_SIZE);
       saltLen = C_MAX_SECRET_SIZE;
       secLen = C_MAX_SIG_MSG_SIZE;
-      gPsaStatus = psa_get_key_attributes(C_SAL_CRYPTO_PSA_L1_FIELD_KEY_ID, &outputKeyAttr);
+      gPsaStatus = psa_get_key_attributes(lGetL1FieldKeyId(), &outputKeyAttr);
 
       if (gPsaStatus == PSA_SUCCESS)
       {
         /* Key identifier already exists. */
-        psa_destroy_key(C_SAL_CRYPTO_PSA_L1_FIELD_KEY_ID);
+        psa_destroy_key(lGetL1FieldKeyId());
       }
     }
 
@@ -739,7 +905,7 @@ K_SAL_API TKStatus salRotHkdfExtractAndExpand
       lifetime = PSA_KEY_LIFETIME_FROM_PERSISTENCE_AND_LOCATION(PSA_KEY_LIFETIME_PERSISTENT,
                                                                 PSA_KEY_LOCATION_LOCAL_STORAGE);
       psa_set_key_lifetime(&keyAttr, lifetime);
-      psa_set_key_id(&outputKeyAttr, C_SAL_CRYPTO_PSA_L1_FIELD_KEY_ID);
+      psa_set_key_id(&outputKeyAttr, lGetL1FieldKeyId());
       gPsaStatus = psa_key_derivation_output_key(&outputKeyAttr,  &operation,
                                                  &l1ActKey);
 
@@ -821,7 +987,7 @@ K_SAL_API TKStatus salRotKeyDerivation
     }
     else if (xKeyId == C_K_KTA__L1_FIELD_KEY_ID)
     {
-      psaKeyId = C_SAL_CRYPTO_PSA_L1_FIELD_KEY_ID;
+      psaKeyId = lGetL1FieldKeyId();
     }
     else
     {
@@ -829,7 +995,14 @@ K_SAL_API TKStatus salRotKeyDerivation
       break;
     }
 
-    psa_crypto_init();
+    gPsaStatus = lPsaCryptoInit();
+
+    if (PSA_SUCCESS != gPsaStatus)
+    {
+      M_KTALOG__ERR("psa_crypto_init failed[%d]", gPsaStatus);
+      break;
+    }
+
     gPsaStatus = psa_mac_compute(psaKeyId, PSA_ALG_HMAC(PSA_ALG_SHA_256),
                                  xpInputData, xInputDataLen,
                                  aActMac32, actMac32Len, &actMac32Len);
@@ -861,6 +1034,14 @@ K_SAL_API TKStatus salRotKeyDerivation
       break;
     }
 
+#ifdef WARM_START_FEATURE
+    if (C_K_KTA__L1_FIELD_KEY_ID == xKeyId)
+    {
+      /* Field L2 keys can be copied to a persistent slot by salRotL2KeysSeal. */
+      psaKeyUsage |= PSA_KEY_USAGE_COPY;
+    }
+#endif /* WARM_START_FEATURE */
+
     psa_set_key_type(&keyAttr, psaKeyType);
     psa_set_key_bits(&keyAttr, psaKeyBits);
     psa_set_key_usage_flags(&keyAttr, psaKeyUsage);
@@ -925,15 +1106,22 @@ K_SAL_API TKStatus salCryptoHmac
       break;
     }
 
-    if (lGetValueById(xKeyId,
-                      (uint8_t*)&keyId,
-                      sizeof(keyId)) != E_K_STATUS_OK)
+    keyId = lGetInstance()->session.macKeyId;
+
+    if (0u == (uint32_t)keyId)
     {
-      M_KTALOG__ERR("lGetValueById Failed");
+      M_KTALOG__ERR("Session MAC key not derived");
+      break;
+    }
+
+    gPsaStatus = lPsaCryptoInit();
+
+    if (PSA_SUCCESS != gPsaStatus)
+    {
+      M_KTALOG__ERR("psa_crypto_init failed[%d]", gPsaStatus);
       break;
     }
 
-    psa_crypto_init();
     gPsaStatus = psa_mac_compute(keyId, PSA_ALG_HMAC(PSA_ALG_SHA_256),
                                  xpInputData, xInputDataLen,
                                  aMac, macLength, &macLength);
@@ -987,15 +1175,22 @@ K_SAL_API TKStatus salCryptoHmacVerify
       break;
     }
 
-    if (lGetValueById(xKeyId,
-                      (uint8_t*)&keyId,
-                      sizeof(keyId)) != E_K_STATUS_OK)
+    keyId = lGetInstance()->session.macKeyId;
+
+    if (0u == (uint32_t)keyId)
     {
-      M_KTALOG__ERR("lGetValueById Failed");
+      M_KTALOG__ERR("Session MAC key not derived");
+      break;
+    }
+
+    gPsaStatus = lPsaCryptoInit();
+
+    if (PSA_SUCCESS != gPsaStatus)
+    {
+      M_KTALOG__ERR("psa_crypto_init failed[%d]", gPsaStatus);
       break;
     }
 
-    psa_crypto_init();
     gPsaStatus = psa_mac_compute(keyId, PSA_ALG_HMAC(PSA_ALG_SHA_256),
                                  xpInputData, xInputDataLen,
                                  aMac, macLength, &macLength);
@@ -1075,26 +1270,40 @@ K_SAL_API TKStatus salCryptoAesDec
 }
 
 /**
- * @brief  implement salCryptoGetRandom
+ * @brief  implement salCryptoAesEncHmac
  *
  */
-K_SAL_API TKStatus salCryptoGetRandom
+K_SAL_API TKStatus salCryptoAesEncHmac
 (
-  uint8_t*  xpRandomData,
-  size_t*   xpRandomDataLen
+  uint32_t        xCipherKeyId,
+  uint32_t        xMacKeyId,
+  const uint8_t*  xpAad,
+  size_t          xAadLen,
+  uint8_t*        xpData,
+  size_t          xDataLen,
+  uint8_t*        xpMac
 )
 {
-  TKStatus status = E_K_STATUS_ERROR;
+  TKSalCryptoSession*  pSession = NULL;
+  psa_mac_operation_t  macOp = PSA_MAC_OPERATION_INIT;
+  uint8_t              aMac[C_MAX_ACT_MAC_LENGTH] = {0};
+  size_t               macLength = C_MAX_ACT_MAC_LENGTH;
+  size_t               outputLength = xDataLen;
+  TKStatus             status = E_K_STATUS_ERROR;
 
   M_KTALOG__START("Start");
 
   for (;;)
   {
     if (
-      (NULL == xpRandomData) ||
-      (NULL == xpRandomDataLen) ||
-      (0 == *xpRandomDataLen) ||
-      (C_K_KTA__RANDOM_MAX_SIZE < *xpRandomDataLen)
+      (C_K_KTA__VOLATILE_3_ID != xCipherKeyId) ||
+      (C_K_KTA__VOLATILE_2_ID != xMacKeyId) ||
+      (NULL == xpAad) ||
+      (0U == xAadLen) ||
+      (NULL == xpData) ||
+      (0U == xDataLen) ||
+      (0U != (xDataLen % C_SAL_CRYPTO_AES_BLOCK_SIZE)) ||
+      (NULL == xpMac)
     )
     {
       M_KTALOG__ERR("Invalid paramertes");
@@ -1102,210 +1311,760 @@ K_SAL_API TKStatus salCryptoGetRandom
       break;
     }
 
-    gPsaStatus = psa_generate_random(xpRandomData, *xpRandomDataLen);
+    pSession = &lGetInstance()->session;
 
-    if (PSA_SUCCESS != gPsaStatus)
+    if ((0u == (uint32_t)pSession->macKeyId) || (0u == (uint32_t)pSession->cipherKeyId))
     {
-      M_KTALOG__ERR("psa_generate_random failed[%d]", gPsaStatus);
+      M_KTALOG__ERR("Session keys not derived");
       break;
     }
 
-    status = E_K_STATUS_OK;
-    break;
-  }
+    gPsaStatus = lPsaCryptoInit();
 
-  M_KTALOG__END("End, status : %d", status);
-  return status;
-}
+    if (PSA_SUCCESS != gPsaStatus)
+    {
+      M_KTALOG__ERR("psa_crypto_init failed[%d]", gPsaStatus);
+      break;
+    }
 
-/**
- * @brief  implement salSignHash
- *
- */
-K_SAL_API TKStatus salSignHash
-(
-  uint32_t  xKeyId,
-  uint8_t*  xpMsgTohash,
-  size_t    xMsgTohashLen,
-  uint8_t*  xpSignedHashOutBuff,
-  uint32_t  xSignedHashOutBuffLen,
-  size_t*   xpActualSignedHashOutLen
-)
-{
-  TKStatus      status = E_K_STATUS_ERROR;
-  psa_key_id_t  keyHandle;
+    gPsaStatus = psa_mac_sign_setup(&macOp, pSession->macKeyId, PSA_ALG_HMAC(PSA_ALG_SHA_256));
 
-  M_KTALOG__START("Start");
+    if (PSA_SUCCESS == gPsaStatus)
+    {
+      gPsaStatus = psa_mac_update(&macOp, xpAad, xAadLen);
+    }
 
-  for (;;)
-  {
-    if (
-      (0U == xKeyId) ||
-      (NULL == xpMsgTohash) ||
-      (NULL == xpSignedHashOutBuff) ||
-      (NULL == xpActualSignedHashOutLen) ||
-      (0U == xMsgTohashLen) ||
-      (0U == xSignedHashOutBuffLen)
-    )
+    if (PSA_SUCCESS != gPsaStatus)
     {
-      M_KTALOG__ERR("Invalid parameters");
-      status = E_K_STATUS_PARAMETER;
+      M_KTALOG__ERR("psa_mac setup failed[%d]", gPsaStatus);
       break;
     }
 
-    gPsaStatus = psa_open_key(xKeyId, &keyHandle);
-
-    if (gPsaStatus != PSA_SUCCESS)
+    if (E_K_STATUS_OK != lStreamCipherMac(E_K_SAL_ENCRYPT,
+                                          &macOp,
+                                          xpData,
+                                          xDataLen,
+                                          xpData,
+                                          &outputLength))
     {
-      M_KTALOG__ERR("psa_open_key failed[%d]", gPsaStatus);
       break;
     }
 
-    gPsaStatus = psa_sign_hash(keyHandle,
-                               PSA_ALG_ECDSA(PSA_ALG_SHA_256),
-                               xpMsgTohash,
-                               xMsgTohashLen,
-                               xpSignedHashOutBuff,
-                               xSignedHashOutBuffLen,
-                               xpActualSignedHashOutLen);
+    gPsaStatus = psa_mac_sign_finish(&macOp, aMac, sizeof(aMac), &macLength);
 
-    if (gPsaStatus != PSA_SUCCESS)
+    if (PSA_SUCCESS != gPsaStatus)
     {
-      M_KTALOG__ERR("psa_sign_hash failed! (Error: %d)", gPsaStatus);
+      M_KTALOG__ERR("psa_mac_sign_finish failed[%d]", gPsaStatus);
       break;
     }
 
+    (void)memcpy(xpMac, aMac, C_MAX_SECRET_SIZE);
     status = E_K_STATUS_OK;
     break;
   }
 
-  M_KTALOG__END("End, status : %d", status);
-  return status;
-}
-
-/* -------------------------------------------------------------------------- */
-/* LOCAL FUNCTIONS - IMPLEMENTATION                                           */
-/* -------------------------------------------------------------------------- */
-
-/**
- * @implements lSetValueById
- *
- **/
-static TKStatus lSetValueById
-(
-  uint32_t  xObjectId,
-  uint8_t*  xpValue,
-  size_t    xValueLen
-)
-{
-  TKStatus  status = E_K_STATUS_ERROR;
-  uint32_t  loopCount = 0;
-  uint32_t  noOfItems = sizeof(gaSalObjectIdMapTable) / sizeof(gaSalObjectIdMapTable[0]);
-
-  for (; loopCount < noOfItems; loopCount++)
-  {
-    if (gaSalObjectIdMapTable[loopCount].virutalObjId == xObjectId)
-    {
-      (void)memset(gaSalObjectIdMapTable[loopCount].data.aSessionObjId,
-                   0,
-                   C_SAL_CRYPTO_MAX_KEY_LENGTH);
-      (void)memcpy(gaSalObjectIdMapTable[loopCount].data.aSessionObjId,
-                   xpValue,
-                   xValueLen);
-      status = E_K_STATUS_OK;
-      break;
-    }
-  }
-
-  return status;
-}
-
-/**
- * @implements lGetValueById
- *
- **/
-static TKStatus lGetValueById
-(
-  uint32_t  xObjectId,
-  uint8_t*  xpValue,
-  size_t    xValueLen
-)
-{
-  TKStatus  status = E_K_STATUS_ERROR;
-  uint32_t  loopCount = 0;
-  uint32_t  noOfItems = sizeof(gaSalObjectIdMapTable) / sizeof(gaSalObjectIdMapTable[0]);
-
-  for (; loopCount < noOfItems; loopCount++)
+  if (E_K_STATUS_OK != status)
   {
-    if (gaSalObjectIdMapTable[loopCount].virutalObjId == xObjectId)
-    {
-      (void)memcpy(xpValue,
-                   gaSalObjectIdMapTable[loopCount].data.aSessionObjId,
-                   xValueLen);
-      status = E_K_STATUS_OK;
-      break;
-    }
+    (void)psa_mac_abort(&macOp);
   }
 
+  M_KTALOG__END("End, status : %d", status);
   return status;
 }
 
 /**
- * @implements lDoCipherOps
+ * @brief  implement salCryptoHmacVerifyAesDec
  *
- **/
-static TKStatus lDoCipherOps
+ */
+K_SAL_API TKStatus salCryptoHmacVerifyAesDec
 (
-  TKCipherOps     xOps,
-  uint32_t        xKeyId,
+  uint32_t        xCipherKeyId,
+  uint32_t        xMacKeyId,
+  const uint8_t*  xpAad,
+  size_t          xAadLen,
   const uint8_t*  xpInputData,
   size_t          xInputDataLen,
+  const uint8_t*  xpMac,
   uint8_t*        xpOutputData,
   size_t*         xpOutputDataLen
 )
 {
-
-  psa_key_id_t                   keyId = 0;
-  struct psa_cipher_operation_s  cipherOp = PSA_CIPHER_OPERATION_INIT;
-  const uint8_t                  aIvBuf[] = { 0xA9, 0x32, 0x30, 0x31, 0x38, 0x4E, 0x61, 0x67,
-                                              0x72, 0x61, 0x76, 0x69, 0x73, 0x69, 0x6F, 0x6E
-                                            };
-  size_t                         outputLength = 0;
-  TKStatus                       status = E_K_STATUS_ERROR;
+  TKSalCryptoSession*  pSession = NULL;
+  psa_mac_operation_t  macOp = PSA_MAC_OPERATION_INIT;
+  uint8_t              aMac[C_MAX_ACT_MAC_LENGTH] = {0};
+  size_t               macLength = C_MAX_ACT_MAC_LENGTH;
+  size_t               outputLength = 0;
+  uint8_t              macDiff = 0;
+  TKStatus             cipherStatus = E_K_STATUS_ERROR;
+  TKStatus             status = E_K_STATUS_ERROR;
+  size_t               index = 0;
 
   M_KTALOG__START("Start");
 
   for (;;)
   {
     if (
-      (C_K_KTA__VOLATILE_3_ID != xKeyId) ||
-      (0U == xInputDataLen) ||
+      (C_K_KTA__VOLATILE_3_ID != xCipherKeyId) ||
+      (C_K_KTA__VOLATILE_2_ID != xMacKeyId) ||
+      (NULL == xpAad) ||
+      (0U == xAadLen) ||
       (NULL == xpInputData) ||
-      (NULL == xpOutputDataLen) ||
-      (0U == *xpOutputDataLen) ||
+      (0U == xInputDataLen) ||
+      (NULL == xpMac) ||
       (NULL == xpOutputData) ||
+      (NULL == xpOutputDataLen) ||
       (*xpOutputDataLen < xInputDataLen)
     )
     {
+      M_KTALOG__ERR("Invalid paramertes");
       status = E_K_STATUS_PARAMETER;
       break;
     }
 
-    if (lGetValueById(xKeyId, (uint8_t*)&keyId, sizeof(keyId)) != E_K_STATUS_OK)
+    pSession = &lGetInstance()->session;
+
+    if ((0u == (uint32_t)pSession->macKeyId) || (0u == (uint32_t)pSession->cipherKeyId))
+    {
+      M_KTALOG__ERR("Session keys not derived");
+      break;
+    }
+
+    gPsaStatus = lPsaCryptoInit();
+
+    if (PSA_SUCCESS != gPsaStatus)
+    {
+      M_KTALOG__ERR("psa_crypto_init failed[%d]", gPsaStatus);
+      break;
+    }
+
+    gPsaStatus = psa_mac_sign_setup(&macOp, pSession->macKeyId, PSA_ALG_HMAC(PSA_ALG_SHA_256));
+
+    if (PSA_SUCCESS == gPsaStatus)
+    {
+      gPsaStatus = psa_mac_update(&macOp, xpAad, xAadLen);
+    }
+
+    if (PSA_SUCCESS != gPsaStatus)
+    {
+      M_KTALOG__ERR("psa_mac setup failed[%d]", gPsaStatus);
+      break;
+    }
+
+    /* The MAC is fed with each encrypted chunk before it is decrypted, in place or not. */
+    outputLength = *xpOutputDataLen;
+    cipherStatus = lStreamCipherMac(E_K_SAL_DECRYPT,
+                                    &macOp,
+                                    xpInputData,
+                                    xInputDataLen,
+                                    xpOutputData,
+                                    &outputLength);
+
+    if (E_K_STATUS_ERROR == cipherStatus)
+    {
+      break;
+    }
+
+    gPsaStatus = psa_mac_sign_finish(&macOp, aMac, sizeof(aMac), &macLength);
+
+    if (PSA_SUCCESS != gPsaStatus)
+    {
+      M_KTALOG__ERR("psa_mac_sign_finish failed[%d]", gPsaStatus);
+      break;
+    }
+
+    for (index = 0; index < C_MAX_SECRET_SIZE; index++)
+    {
+      macDiff |= (uint8_t)(xpMac[index] ^ aMac[index]);
+    }
+
+    if (0u != macDiff)
+    {
+      M_KTALOG__ERR("MAC mismatch");
+      break;
+    }
+
+    /* Authenticated, only now is a decryption failure reported as such. */
+    status = cipherStatus;
+
+    if (E_K_STATUS_OK == status)
+    {
+      *xpOutputDataLen = outputLength;
+    }
+
+    break;
+  }
+
+  if ((E_K_STATUS_OK != status) && (E_K_STATUS_PARAMETER != status))
+  {
+    (void)psa_mac_abort(&macOp);
+    /* Never hand out plain data that was not authenticated. */
+    (void)memset(xpOutputData, 0, xInputDataLen);
+  }
+
+  M_KTALOG__END("End, status : %d", status);
+  return status;
+}
+
+/**
+ * @brief  implement salCryptoGetRandom
+ *
+ */
+K_SAL_API TKStatus salCryptoGetRandom
+(
+  uint8_t*  xpRandomData,
+  size_t*   xpRandomDataLen
+)
+{
+  TKStatus status = E_K_STATUS_ERROR;
+
+  M_KTALOG__START("Start");
+
+  for (;;)
+  {
+    if (
+      (NULL == xpRandomData) ||
+      (NULL == xpRandomDataLen) ||
+      (0 == *xpRandomDataLen) ||
+      (C_K_KTA__RANDOM_MAX_SIZE < *xpRandomDataLen)
+    )
+    {
+      M_KTALOG__ERR("Invalid paramertes");
+      status = E_K_STATUS_PARAMETER;
+      break;
+    }
+
+    gPsaStatus = psa_generate_random(xpRandomData, *xpRandomDataLen);
+
+    if (PSA_SUCCESS != gPsaStatus)
+    {
+      M_KTALOG__ERR("psa_generate_random failed[%d]", gPsaStatus);
+      break;
+    }
+
+    status = E_K_STATUS_OK;
+    break;
+  }
+
+  M_KTALOG__END("End, status : %d", status);
+  return status;
+}
+
+/**
+ * @brief  implement salSignHash
+ *
+ */
+K_SAL_API TKStatus salSignHash
+(
+  uint32_t  xKeyId,
+  uint8_t*  xpMsgTohash,
+  size_t    xMsgTohashLen,
+  uint8_t*  xpSignedHashOutBuff,
+  uint32_t  xSignedHashOutBuffLen,
+  size_t*   xpActualSignedHashOutLen
+)
+{
+  TKStatus      status = E_K_STATUS_ERROR;
+  psa_key_id_t  keyHandle;
+
+  M_KTALOG__START("Start");
+
+  for (;;)
+  {
+    if (
+      (0U == xKeyId) ||
+      (NULL == xpMsgTohash) ||
+      (NULL == xpSignedHashOutBuff) ||
+      (NULL == xpActualSignedHashOutLen) ||
+      (0U == xMsgTohashLen) ||
+      (0U == xSignedHashOutBuffLen)
+    )
+    {
+      M_KTALOG__ERR("Invalid parameters");
+      status = E_K_STATUS_PARAMETER;
+      break;
+    }
+
+    gPsaStatus = psa_open_key(xKeyId, &keyHandle);
+
+    if (gPsaStatus != PSA_SUCCESS)
+    {
+      M_KTALOG__ERR("psa_open_key failed[%d]", gPsaStatus);
+      break;
+    }
+
+    gPsaStatus = psa_sign_hash(keyHandle,
+                               PSA_ALG_ECDSA(PSA_ALG_SHA_256),
+                               xpMsgTohash,
+                               xMsgTohashLen,
+                               xpSignedHashOutBuff,
+                               xSignedHashOutBuffLen,
+                               xpActualSignedHashOutLen);
+
+    if (gPsaStatus != PSA_SUCCESS)
+    {
+      M_KTALOG__ERR("psa_sign_hash failed! (Error: %d)", gPsaStatus);
+      break;
+    }
+
+    status = E_K_STATUS_OK;
+    break;
+  }
+
+  M_KTALOG__END("End, status : %d", status);
+  return status;
+}
+
+/**
+ * @brief  implement salCryptoSelectInstance
+ *
+ */
+K_SAL_API TKStatus salCryptoSelectInstance
+(
+  uint32_t  xInstance
+)
+{
+  TKStatus  status = E_K_STATUS_PARAMETER;
+
+  if (xInstance < C_KTA_APP__MAX_CONTEXTS)
+  {
+    gpSalCryptoInstance = &gaSalCryptoInstance[xInstance];
+    status = E_K_STATUS_OK;
+  }
+
+  return status;
+}
+
+/**
+ * @brief  implement salCryptoClearInstance
+ *
+ */
+K_SAL_API TKStatus salCryptoClearInstance
+(
+  uint32_t  xInstance
+)
+{
+  TKStatus              status = E_K_STATUS_PARAMETER;
+  TKSalCryptoInstance*  pSelected = gpSalCryptoInstance;
+
+  M_KTALOG__START("Start");
+
+  for (;;)
+  {
+    if (xInstance >= C_KTA_APP__MAX_CONTEXTS)
+    {
+      M_KTALOG__ERR("Invalid instance %u", xInstance);
+      break;
+    }
+
+    status = E_K_STATUS_ERROR;
+    gPsaStatus = lPsaCryptoInit();
+
+    if (PSA_SUCCESS != gPsaStatus)
+    {
+      M_KTALOG__ERR("psa_crypto_init failed[%d]", gPsaStatus);
+      break;
+    }
+
+    /* Key ids are resolved against the selected instance, select the one to clear. */
+    gpSalCryptoInstance = &gaSalCryptoInstance[xInstance];
+    status = E_K_STATUS_OK;
+
+    (void)lPsaDestoryKey(C_K_KTA__VOLATILE_ID);
+    (void)lPsaDestoryKey(C_K_KTA__VOLATILE_2_ID);
+    (void)lPsaDestoryKey(C_K_KTA__VOLATILE_3_ID);
+    (void)psa_cipher_abort(&lGetInstance()->session.cipherOp);
+
+    gPsaStatus = psa_destroy_key(lGetL1FieldKeyId());
+
+    if ((PSA_SUCCESS != gPsaStatus) && (PSA_ERROR_INVALID_HANDLE != gPsaStatus) &&
+        (PSA_ERROR_DOES_NOT_EXIST != gPsaStatus))
+    {
+      M_KTALOG__ERR("psa_destroy_key failed[%d]", gPsaStatus);
+      status = E_K_STATUS_ERROR;
+    }
+
+#ifdef WARM_START_FEATURE
+    if (E_K_STATUS_OK != salRotL2KeysDiscard())
+    {
+      status = E_K_STATUS_ERROR;
+    }
+#endif /* WARM_START_FEATURE */
+
+    /* Back to the default map table and an empty session on next use. */
+    (void)memset(&gaSalCryptoInstance[xInstance], 0, sizeof(TKSalCryptoInstance));
+    gpSalCryptoInstance = pSelected;
+    break;
+  }
+
+  M_KTALOG__END("End, status : %d", status);
+  return status;
+}
+
+#ifdef WARM_START_FEATURE
+/**
+ * @brief  implement salRotL2KeysSeal
+ *
+ */
+K_SAL_API TKStatus salRotL2KeysSeal
+(
+  void
+)
+{
+  TKStatus              status = E_K_STATUS_ERROR;
+  const uint32_t        aObjectId[2] = {C_K_KTA__VOLATILE_2_ID, C_K_KTA__VOLATILE_3_ID};
+  psa_key_id_t          keyId = 0;
+  psa_key_id_t          sealedKeyId = 0;
+  psa_key_attributes_t  keyAttr = PSA_KEY_ATTRIBUTES_INIT;
+  uint32_t              loopCount = 0;
+
+  M_KTALOG__START("Start");
+
+  for (; loopCount < 2u; loopCount++)
+  {
+    status = E_K_STATUS_ERROR;
+    sealedKeyId = lGetSealedKeyId(aObjectId[loopCount]);
+
+    if (lGetValueById(aObjectId[loopCount], (uint8_t*)&keyId, sizeof(keyId)) != E_K_STATUS_OK)
+    {
+      M_KTALOG__ERR("lGetValueById Failed");
+      break;
+    }
+
+    if (0u == (uint32_t)keyId)
+    {
+      M_KTALOG__ERR("L2 key %d not derived", aObjectId[loopCount]);
+      status = E_K_STATUS_STATE;
+      break;
+    }
+
+    if (keyId == sealedKeyId)
+    {
+      /* Restored from the sealed slot, nothing to do. */
+      status = E_K_STATUS_OK;
+      continue;
+    }
+
+    /* Replace any previously sealed key. */
+    (void)psa_destroy_key(sealedKeyId);
+
+    gPsaStatus = psa_get_key_attributes(keyId, &keyAttr);
+
+    if (PSA_SUCCESS != gPsaStatus)
+    {
+      M_KTALOG__ERR("psa_get_key_attributes failed[%d]", gPsaStatus);
+      break;
+    }
+
+    psa_set_key_id(&keyAttr, sealedKeyId);
+    gPsaStatus = psa_copy_key(keyId, &keyAttr, &sealedKeyId);
+    psa_reset_key_attributes(&keyAttr);
+
+    if (PSA_SUCCESS != gPsaStatus)
+    {
+      M_KTALOG__ERR("psa_copy_key failed[%d]", gPsaStatus);
+      break;
+    }
+
+    status = E_K_STATUS_OK;
+  }
+
+  M_KTALOG__END("End, status : %d", status);
+  return status;
+}
+
+/**
+ * @brief  implement salRotL2KeysRestore
+ *
+ */
+K_SAL_API TKStatus salRotL2KeysRestore
+(
+  void
+)
+{
+  TKStatus              status = E_K_STATUS_ERROR;
+  const uint32_t        aObjectId[2] = {C_K_KTA__VOLATILE_2_ID, C_K_KTA__VOLATILE_3_ID};
+  psa_key_id_t          keyId = 0;
+  psa_key_id_t          sealedKeyId = 0;
+  psa_key_attributes_t  keyAttr = PSA_KEY_ATTRIBUTES_INIT;
+  uint32_t              loopCount = 0;
+
+  M_KTALOG__START("Start");
+
+  for (;;)
+  {
+    gPsaStatus = lPsaCryptoInit();
+
+    if (PSA_SUCCESS != gPsaStatus)
+    {
+      M_KTALOG__ERR("psa_crypto_init failed[%d]", gPsaStatus);
+      break;
+    }
+
+    /* Check both keys first, a partial restore would mix two key generations. */
+    for (loopCount = 0; loopCount < 2u; loopCount++)
+    {
+      gPsaStatus = psa_get_key_attributes(lGetSealedKeyId(aObjectId[loopCount]), &keyAttr);
+      psa_reset_key_attributes(&keyAttr);
+
+      if (PSA_SUCCESS != gPsaStatus)
+      {
+        break;
+      }
+    }
+
+    if (PSA_SUCCESS != gPsaStatus)
+    {
+      M_KTALOG__DEBUG("No sealed L2 keys[%d]", gPsaStatus);
+      status = E_K_STATUS_MISSING;
+      break;
+    }
+
+    for (loopCount = 0; loopCount < 2u; loopCount++)
     {
-      M_KTALOG__ERR("lGetValueById Failed");
+      sealedKeyId = lGetSealedKeyId(aObjectId[loopCount]);
+      (void)lGetValueById(aObjectId[loopCount], (uint8_t*)&keyId, sizeof(keyId));
+
+      if (keyId != sealedKeyId)
+      {
+        /* Drop the volatile key being replaced. */
+        (void)lPsaDestoryKey(aObjectId[loopCount]);
+      }
+
+      if (lSetValueById(aObjectId[loopCount],
+                        (uint8_t*)&sealedKeyId,
+                        sizeof(sealedKeyId)) != E_K_STATUS_OK)
+      {
+        M_KTALOG__ERR("lSetValueById Failed");
+        break;
+      }
+    }
+
+    if (loopCount == 2u)
+    {
+      status = E_K_STATUS_OK;
+    }
+
+    break;
+  }
+
+  M_KTALOG__END("End, status : %d", status);
+  return status;
+}
+
+/**
+ * @brief  implement salRotL2KeysDiscard
+ *
+ */
+K_SAL_API TKStatus salRotL2KeysDiscard
+(
+  void
+)
+{
+  TKStatus        status = E_K_STATUS_OK;
+  const uint32_t  aObjectId[2] = {C_K_KTA__VOLATILE_2_ID, C_K_KTA__VOLATILE_3_ID};
+  psa_key_id_t    keyId = 0;
+  psa_key_id_t    sealedKeyId = 0;
+  uint32_t        loopCount = 0;
+
+  M_KTALOG__START("Start");
+
+  for (; loopCount < 2u; loopCount++)
+  {
+    sealedKeyId = lGetSealedKeyId(aObjectId[loopCount]);
+    (void)lGetValueById(aObjectId[loopCount], (uint8_t*)&keyId, sizeof(keyId));
+
+    if (keyId == sealedKeyId)
+    {
+      /* The sealed key is in use, unbind it as it is about to disappear. */
+      keyId = 0;
+      (void)lSetValueById(aObjectId[loopCount], (uint8_t*)&keyId, sizeof(keyId));
+    }
+
+    gPsaStatus = psa_destroy_key(sealedKeyId);
+
+    if ((PSA_SUCCESS != gPsaStatus) && (PSA_ERROR_INVALID_HANDLE != gPsaStatus) &&
+        (PSA_ERROR_DOES_NOT_EXIST != gPsaStatus))
+    {
+      M_KTALOG__ERR("psa_destroy_key failed[%d]", gPsaStatus);
+      status = E_K_STATUS_ERROR;
+    }
+  }
+
+  M_KTALOG__END("End, status : %d", status);
+  return status;
+}
+#endif /* WARM_START_FEATURE */
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL FUNCTIONS - IMPLEMENTATION                                           */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @implements lSetValueById
+ *
+ **/
+static TKStatus lSetValueById
+(
+  uint32_t  xObjectId,
+  uint8_t*  xpValue,
+  size_t    xValueLen
+)
+{
+  TKStatus          status = E_K_STATUS_ERROR;
+  uint32_t          loopCount = 0;
+  TKSalObjectIdMap* pMapTable = lGetInstance()->aObjectIdMap;
+
+  for (; loopCount < C_SAL_CRYPTO_OBJECT_ID_MAP_SIZE; loopCount++)
+  {
+    if (pMapTable[loopCount].virutalObjId == xObjectId)
+    {
+      (void)memset(pMapTable[loopCount].data.aSessionObjId,
+                   0,
+                   C_SAL_CRYPTO_MAX_KEY_LENGTH);
+      (void)memcpy(pMapTable[loopCount].data.aSessionObjId,
+                   xpValue,
+                   xValueLen);
+      status = E_K_STATUS_OK;
+      break;
+    }
+  }
+
+  /* Keep the session key ids in step with the L2 session key slots. */
+  if ((E_K_STATUS_OK == status) && (sizeof(psa_key_id_t) == xValueLen))
+  {
+    if (C_K_KTA__VOLATILE_2_ID == xObjectId)
+    {
+      (void)memcpy(&lGetInstance()->session.macKeyId, xpValue, xValueLen);
+    }
+    else if (C_K_KTA__VOLATILE_3_ID == xObjectId)
+    {
+      (void)memcpy(&lGetInstance()->session.cipherKeyId, xpValue, xValueLen);
+    }
+    else
+    {
+      /* Not a session key. */
+    }
+  }
+
+  return status;
+}
+
+/**
+ * @implements lGetInstance
+ *
+ **/
+static TKSalCryptoInstance* lGetInstance
+(
+  void
+)
+{
+  TKSalCryptoInstance* pInstance = gpSalCryptoInstance;
+
+  if (0u == pInstance->isInitialized)
+  {
+    (void)memcpy(pInstance->aObjectIdMap, gaSalObjectIdMapTable, sizeof(gaSalObjectIdMapTable));
+    (void)memset(pInstance->aSharedSecret, 0, C_SHARED_SECRET_KEY_LEN);
+    pInstance->session.macKeyId = 0;
+    pInstance->session.cipherKeyId = 0;
+    pInstance->session.cipherOp = psa_cipher_operation_init();
+    pInstance->isInitialized = 1u;
+  }
+
+  return pInstance;
+}
+
+/**
+ * @implements lGetValueById
+ *
+ **/
+static TKStatus lGetValueById
+(
+  uint32_t  xObjectId,
+  uint8_t*  xpValue,
+  size_t    xValueLen
+)
+{
+  TKStatus                status = E_K_STATUS_ERROR;
+  uint32_t                loopCount = 0;
+  const TKSalObjectIdMap* pMapTable = lGetInstance()->aObjectIdMap;
+
+  for (; loopCount < C_SAL_CRYPTO_OBJECT_ID_MAP_SIZE; loopCount++)
+  {
+    if (pMapTable[loopCount].virutalObjId == xObjectId)
+    {
+      (void)memcpy(xpValue,
+                   pMapTable[loopCount].data.aSessionObjId,
+                   xValueLen);
+      status = E_K_STATUS_OK;
+      break;
+    }
+  }
+
+  return status;
+}
+
+/**
+ * @implements lDoCipherOps
+ *
+ **/
+static TKStatus lDoCipherOps
+(
+  TKCipherOps     xOps,
+  uint32_t        xKeyId,
+  const uint8_t*  xpInputData,
+  size_t          xInputDataLen,
+  uint8_t*        xpOutputData,
+  size_t*         xpOutputDataLen
+)
+{
+  TKSalCryptoSession*  pSession = &lGetInstance()->session;
+  size_t               outputLength = 0;
+  TKStatus             status = E_K_STATUS_ERROR;
+
+  M_KTALOG__START("Start");
+
+  for (;;)
+  {
+    if (
+      (C_K_KTA__VOLATILE_3_ID != xKeyId) ||
+      (0U == xInputDataLen) ||
+      (NULL == xpInputData) ||
+      (NULL == xpOutputDataLen) ||
+      (0U == *xpOutputDataLen) ||
+      (NULL == xpOutputData) ||
+      (*xpOutputDataLen < xInputDataLen)
+    )
+    {
+      status = E_K_STATUS_PARAMETER;
+      break;
+    }
+
+    if (0u == (uint32_t)pSession->cipherKeyId)
+    {
+      M_KTALOG__ERR("Session cipher key not derived");
+      break;
+    }
+
+    gPsaStatus = lPsaCryptoInit();
+
+    if (PSA_SUCCESS != gPsaStatus)
+    {
+      M_KTALOG__ERR("psa_crypto_init failed[%d]", gPsaStatus);
       break;
     }
 
-    psa_crypto_init();
 
     if (xOps == E_K_SAL_ENCRYPT)
     {
-      gPsaStatus = psa_cipher_encrypt_setup(&cipherOp, keyId, PSA_ALG_CBC_NO_PADDING);
+      gPsaStatus = psa_cipher_encrypt_setup(&pSession->cipherOp,
+                                            pSession->cipherKeyId,
+                                            PSA_ALG_CBC_NO_PADDING);
     }
     else
     {
-      gPsaStatus = psa_cipher_decrypt_setup(&cipherOp, keyId, PSA_ALG_CBC_NO_PADDING);
+      gPsaStatus = psa_cipher_decrypt_setup(&pSession->cipherOp,
+                                            pSession->cipherKeyId,
+                                            PSA_ALG_CBC_NO_PADDING);
     }
 
     if (PSA_SUCCESS != gPsaStatus)
@@ -1315,7 +2074,7 @@ static TKStatus lDoCipherOps
       break;
     }
 
-    gPsaStatus = psa_cipher_set_iv(&cipherOp, aIvBuf, sizeof(aIvBuf));
+    gPsaStatus = psa_cipher_set_iv(&pSession->cipherOp, gaCbcIv, sizeof(gaCbcIv));
 
     if (PSA_SUCCESS != gPsaStatus)
     {
@@ -1323,7 +2082,7 @@ static TKStatus lDoCipherOps
       break;
     }
 
-    gPsaStatus = psa_cipher_update(&cipherOp,
+    gPsaStatus = psa_cipher_update(&pSession->cipherOp,
                                    xpInputData,
                                    xInputDataLen,
                                    xpOutputData,
@@ -1336,7 +2095,7 @@ static TKStatus lDoCipherOps
       break;
     }
 
-    gPsaStatus = psa_cipher_finish(&cipherOp,
+    gPsaStatus = psa_cipher_finish(&pSession->cipherOp,
                                    &xpOutputData[outputLength],
                                    *xpOutputDataLen - outputLength,
                                    &outputLength);
@@ -1352,10 +2111,156 @@ static TKStatus lDoCipherOps
     break;
   }
 
+  if ((E_K_STATUS_OK != status) && (E_K_STATUS_PARAMETER != status))
+  {
+    /* Return the operation object to its inactive state for the next message. */
+    (void)psa_cipher_abort(&pSession->cipherOp);
+  }
+
   M_KTALOG__END("End, status : %d", status);
   return status;
 }
 
+/**
+ * @implements lPsaCryptoInit
+ *
+ **/
+static psa_status_t lPsaCryptoInit
+(
+  void
+)
+{
+  psa_status_t  psaStatus = PSA_SUCCESS;
+
+  if (0u == gIsPsaInitialized)
+  {
+    /* psa_crypto_init is idempotent, concurrent first calls are harmless. */
+    psaStatus = psa_crypto_init();
+
+    if (PSA_SUCCESS == psaStatus)
+    {
+      gIsPsaInitialized = 1u;
+    }
+  }
+
+  return psaStatus;
+}
+
+/**
+ * @implements lStreamCipherMac
+ *
+ **/
+static TKStatus lStreamCipherMac
+(
+  TKCipherOps           xOps,
+  psa_mac_operation_t*  xpMacOp,
+  const uint8_t*        xpInputData,
+  size_t                xInputDataLen,
+  uint8_t*              xpOutputData,
+  size_t*               xpOutputDataLen
+)
+{
+  TKSalCryptoSession*  pSession = &lGetInstance()->session;
+  psa_status_t         cipherStatus = PSA_ERROR_BAD_STATE;
+  psa_status_t         macStatus = PSA_SUCCESS;
+  size_t               offset = 0;
+  size_t               produced = 0;
+  size_t               chunkLen = 0;
+  size_t               outputLength = 0;
+  TKStatus             status = E_K_STATUS_ERROR;
+
+  if (xOps == E_K_SAL_ENCRYPT)
+  {
+    cipherStatus = psa_cipher_encrypt_setup(&pSession->cipherOp,
+                                            pSession->cipherKeyId,
+                                            PSA_ALG_CBC_NO_PADDING);
+  }
+  else
+  {
+    cipherStatus = psa_cipher_decrypt_setup(&pSession->cipherOp,
+                                            pSession->cipherKeyId,
+                                            PSA_ALG_CBC_NO_PADDING);
+  }
+
+  if (PSA_SUCCESS == cipherStatus)
+  {
+    cipherStatus = psa_cipher_set_iv(&pSession->cipherOp, gaCbcIv, sizeof(gaCbcIv));
+  }
+
+  /* On decryption the MAC keeps covering the input even once the cipher failed. */
+  while ((offset < xInputDataLen) && (PSA_SUCCESS == macStatus))
+  {
+    chunkLen = xInputDataLen - offset;
+
+    if (chunkLen > C_SAL_CRYPTO_STREAM_CHUNK_SIZE)
+    {
+      chunkLen = C_SAL_CRYPTO_STREAM_CHUNK_SIZE;
+    }
+
+    if (xOps == E_K_SAL_DECRYPT)
+    {
+      macStatus = psa_mac_update(xpMacOp, &xpInputData[offset], chunkLen);
+    }
+
+    if (PSA_SUCCESS == cipherStatus)
+    {
+      cipherStatus = psa_cipher_update(&pSession->cipherOp,
+                                       &xpInputData[offset],
+                                       chunkLen,
+                                       &xpOutputData[produced],
+                                       *xpOutputDataLen - produced,
+                                       &outputLength);
+
+      if ((PSA_SUCCESS == cipherStatus) && (xOps == E_K_SAL_ENCRYPT))
+      {
+        macStatus = psa_mac_update(xpMacOp, &xpOutputData[produced], outputLength);
+      }
+
+      produced += outputLength;
+      outputLength = 0;
+    }
+
+    offset += chunkLen;
+  }
+
+  if (PSA_SUCCESS == cipherStatus)
+  {
+    cipherStatus = psa_cipher_finish(&pSession->cipherOp,
+                                     &xpOutputData[produced],
+                                     *xpOutputDataLen - produced,
+                                     &outputLength);
+
+    if ((PSA_SUCCESS == cipherStatus) && (xOps == E_K_SAL_ENCRYPT) && (0u != outputLength))
+    {
+      macStatus = psa_mac_update(xpMacOp, &xpOutputData[produced], outputLength);
+    }
+
+    produced += outputLength;
+  }
+
+  if (PSA_SUCCESS != macStatus)
+  {
+    M_KTALOG__ERR("psa_mac_update failed[%d]", macStatus);
+  }
+  else if (PSA_SUCCESS != cipherStatus)
+  {
+    M_KTALOG__ERR("psa_cipher failed[%d]", cipherStatus);
+    status = E_K_STATUS_DECRYPTION;
+  }
+  else
+  {
+    *xpOutputDataLen = produced;
+    status = E_K_STATUS_OK;
+  }
+
+  if (PSA_SUCCESS != cipherStatus)
+  {
+    (void)psa_cipher_abort(&pSession->cipherOp);
+  }
+
+  return status;
+}
+
 /**
  * @implements lPsaDestoryKey
  *
@@ -1394,6 +2299,43 @@ static psa_status_t lPsaDestoryKey
   return gPsaStatus;
 }
 
+/**
+ * @implements lGetL1FieldKeyId
+ *
+ **/
+static psa_key_id_t lGetL1FieldKeyId
+(
+  void
+)
+{
+  uint32_t  instance = (uint32_t)(lGetInstance() - gaSalCryptoInstance);
+
+  return (psa_key_id_t)(C_SAL_CRYPTO_PSA_L1_FIELD_KEY_ID +
+                        (instance * C_SAL_CRYPTO_PSA_L1_FIELD_KEY_ID_STEP));
+}
+
+#ifdef WARM_START_FEATURE
+/**
+ * @implements lGetSealedKeyId
+ *
+ **/
+static psa_key_id_t lGetSealedKeyId
+(
+  uint32_t  xObjectId
+)
+{
+  uint32_t  instance = (uint32_t)(lGetInstance() - gaSalCryptoInstance);
+  uint32_t  keyId = C_SAL_CRYPTO_PSA_SEALED_L2_ENC_KEY_ID;
+
+  if (C_K_KTA__VOLATILE_2_ID == xObjectId)
+  {
+    keyId = C_SAL_CRYPTO_PSA_SEALED_L2_AUTH_KEY_ID;
+  }
+
+  return (psa_key_id_t)(keyId + (instance * C_SAL_CRYPTO_PSA_SEALED_KEY_ID_STEP));
+}
+#endif /* WARM_START_FEATURE */
+
 /**
  * @implements lConvertToBigEndien
  *
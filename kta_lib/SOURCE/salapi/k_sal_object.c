@@ -45,6 +45,11 @@
 
 #include "log_api.h"
 
+#if (defined(KEY_PAIR_POOL_FEATURE) || defined(OBJECT_DIRECTORY_FEATURE)) && \
+    (defined(PARALLEL_COMMANDS_FEATURE) || defined(FLEET_MANAGEMENT_FEATURE))
+#include <pthread.h>
+#endif
+
 /* -------------------------------------------------------------------------- */
 /* LOCAL CONSTANTS, TYPES, ENUM                                               */
 /* -------------------------------------------------------------------------- */
@@ -61,15 +66,178 @@
 #define C_SAL_OBJ_ASSOC_INFO_OFFSET_VALUE            (4U)
 /* Macro to max association info buffer size */
 #define C_SAL_OBJ_ASSOC_INFO_MAX_BUFFER_SIZE         (520U)
+/* Bit position of the instance index in the storage uid of an object. */
+#define C_SAL_OBJ_INSTANCE_UID_SHIFT                 (32U)
+/**
+ * Distance between the persistent key ids of two consecutive instances. Instance 0 keeps
+ * the keySTREAM key ids, the ids of the KTA own keys (0x01xxxxxx) are never reached.
+ */
+#define C_SAL_OBJ_INSTANCE_KEY_ID_STEP               (0x02000000U)
+/* keySTREAM key ids stay below this limit when several instances share the key store. */
+#define C_SAL_OBJ_INSTANCE_KEY_ID_LIMIT              (0x01000000U)
+
+#if (C_KTA_APP__MAX_CONTEXTS > 32u)
+#error "C_KTA_APP__MAX_CONTEXTS above 32 runs the key ids out of the PSA user range"
+#endif
+
+/* Storage uid of an object for the instance selected by the calling thread. */
+#define M_SAL_OBJ_INSTANCE_UID(x_objectId) \
+  ((psa_storage_uid_t)(x_objectId) | \
+   ((psa_storage_uid_t)gSalObjInstance << C_SAL_OBJ_INSTANCE_UID_SHIFT))
+
+#ifdef KEY_PAIR_POOL_FEATURE
+/**
+ * Persistent PSA key id of the first pool slot, the next slots follow.
+ * Kept clear of the sealed L2 key ids of the crypto SAL.
+ */
+#define C_SAL_OBJ_KEY_POOL_FIRST_ID                  (0x01000400U)
+/* Key type of the pooled key pairs, requests for another type are generated. */
+#ifndef C_SAL_OBJ_KEY_POOL_TYPE
+#define C_SAL_OBJ_KEY_POOL_TYPE                      PSA_KEY_TYPE_ECC_KEY_PAIR(PSA_ECC_FAMILY_SECP_R1)
+#endif
+/* Key size of the pooled key pairs. */
+#ifndef C_SAL_OBJ_KEY_POOL_BITS
+#define C_SAL_OBJ_KEY_POOL_BITS                      (256U)
+#endif
+/* Algorithm of the pooled key pairs, a copy cannot change it. */
+#ifndef C_SAL_OBJ_KEY_POOL_ALG
+#define C_SAL_OBJ_KEY_POOL_ALG                       PSA_ALG_ECDSA(PSA_ALG_SHA_256)
+#endif
+/**
+ * Usage of the pooled key pairs. The copy keeps the usage both keys have, so only a
+ * request within this usage is served from the pool. No export of a private key at
+ * rest; COPY is needed by psa_copy_key.
+ */
+#define C_SAL_OBJ_KEY_POOL_USAGE                     (PSA_KEY_USAGE_COPY           | \
+                                                      PSA_KEY_USAGE_ENCRYPT        | \
+                                                      PSA_KEY_USAGE_DECRYPT        | \
+                                                      PSA_KEY_USAGE_SIGN_MESSAGE   | \
+                                                      PSA_KEY_USAGE_VERIFY_MESSAGE | \
+                                                      PSA_KEY_USAGE_SIGN_HASH      | \
+                                                      PSA_KEY_USAGE_VERIFY_HASH    | \
+                                                      PSA_KEY_USAGE_DERIVE)
+
+#if defined(PARALLEL_COMMANDS_FEATURE) || defined(FLEET_MANAGEMENT_FEATURE)
+#define M_SAL_OBJ_KEY_POOL_LOCK()                    (void)pthread_mutex_lock(&gKeyPoolMutex)
+#define M_SAL_OBJ_KEY_POOL_UNLOCK()                  (void)pthread_mutex_unlock(&gKeyPoolMutex)
+#else
+#define M_SAL_OBJ_KEY_POOL_LOCK()
+#define M_SAL_OBJ_KEY_POOL_UNLOCK()
+#endif
+
+/** @brief State of a pool slot. */
+typedef enum
+{
+  E_SAL_OBJ_KEY_POOL_UNKNOWN = 0,
+  /* Not looked up in the PSA key store since startup. */
+  E_SAL_OBJ_KEY_POOL_EMPTY,
+  /* No key pair. */
+  E_SAL_OBJ_KEY_POOL_READY,
+  /* Holds a key pair of the pool type. */
+  E_SAL_OBJ_KEY_POOL_BUSY
+  /* Being generated or bound, owned by one thread. */
+} TSalObjKeyPoolState;
+#endif /* KEY_PAIR_POOL_FEATURE */
+
+#ifdef OBJECT_DIRECTORY_FEATURE
+/* Largest object record kept in a cache line, as staged by the association functions. */
+#define C_SAL_OBJ_CACHE_LINE_SIZE                    C_SAL_OBJ_ASSOC_INFO_MAX_BUFFER_SIZE
+/* Cache line of a directory entry whose record is not cached. */
+#define C_SAL_OBJ_CACHE_NO_LINE                      (0xFFU)
+
+#if (C_KTA_APP__OBJECT_DIRECTORY_SIZE == 0u) || (C_KTA_APP__OBJECT_CACHE_SIZE >= C_SAL_OBJ_CACHE_NO_LINE)
+#error "OBJECT_DIRECTORY_FEATURE requires 1 to 254 cache lines and a directory entry at least"
+#endif
+
+#if defined(PARALLEL_COMMANDS_FEATURE) || defined(FLEET_MANAGEMENT_FEATURE)
+#define M_SAL_OBJ_DIR_LOCK()                         (void)pthread_mutex_lock(&gObjDirMutex)
+#define M_SAL_OBJ_DIR_UNLOCK()                       (void)pthread_mutex_unlock(&gObjDirMutex)
+#else
+#define M_SAL_OBJ_DIR_LOCK()
+#define M_SAL_OBJ_DIR_UNLOCK()
+#endif
+
+/** @brief Directory entry of a stored object. */
+typedef struct
+{
+  psa_storage_uid_t       uid;
+  /* Storage uid of the object, instance included, 0 when the entry is free. */
+  size_t                  recordLen;
+  /* Length of the ITS record, association header included. */
+  TKSalObjAssociationInfo associationInfo;
+  /* Association information, valid when hasAssociation is set. */
+  uint8_t                 hasAssociation;
+  /* The record starts with the association header. */
+  uint8_t                 cacheLine;
+  /* Cache line holding the record, C_SAL_OBJ_CACHE_NO_LINE if none. */
+  uint32_t                lastUse;
+  /* Directory tick of the last access, the oldest entry is replaced. */
+} TSalObjDirEntry;
+
+/** @brief Result of a directory lookup. */
+typedef enum
+{
+  E_SAL_OBJ_DIR_MISS,
+  /* Unknown object, read the storage. */
+  E_SAL_OBJ_DIR_KNOWN,
+  /* Entry copied, the data must be read from the storage. */
+  E_SAL_OBJ_DIR_CACHED
+  /* Entry and data copied from the cache. */
+} TSalObjDirLookup;
+#endif /* OBJECT_DIRECTORY_FEATURE */
 
 /* -------------------------------------------------------------------------- */
 /* LOCAL VARIABLES                                                            */
 /* -------------------------------------------------------------------------- */
+/* Object instance selected by the calling thread, 0 keeps the legacy uids and key ids. */
+static C_KTA_APP__THREAD_LOCAL uint32_t gSalObjInstance = 0U;
+
+#ifdef KEY_PAIR_POOL_FEATURE
+/* State of the pool slots, shared by all KTA contexts. */
+static TSalObjKeyPoolState gaKeyPoolState[C_KTA_APP__KEY_PAIR_POOL_SIZE];
+#if defined(PARALLEL_COMMANDS_FEATURE) || defined(FLEET_MANAGEMENT_FEATURE)
+/* Protects gaKeyPoolState. */
+static pthread_mutex_t gKeyPoolMutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+#endif /* KEY_PAIR_POOL_FEATURE */
+
+#ifdef OBJECT_DIRECTORY_FEATURE
+/* Directory of the stored objects, shared by all KTA contexts. */
+static TSalObjDirEntry gaObjDir[C_KTA_APP__OBJECT_DIRECTORY_SIZE];
+/* Incremented by each directory access, orders the entries by use. */
+static uint32_t gObjDirTick = 0;
+/* Incremented by each object write, a read started before it must not be recorded. */
+static uint32_t gObjDirGeneration = 0;
+#if (C_KTA_APP__OBJECT_CACHE_SIZE > 0u)
+/* Records of the most used objects. */
+static uint8_t gaObjCache[C_KTA_APP__OBJECT_CACHE_SIZE][C_SAL_OBJ_CACHE_LINE_SIZE];
+/* Directory entry owning each cache line, NULL when free. */
+static TSalObjDirEntry* gapObjCacheOwner[C_KTA_APP__OBJECT_CACHE_SIZE];
+#endif
+#if defined(PARALLEL_COMMANDS_FEATURE) || defined(FLEET_MANAGEMENT_FEATURE)
+/* Protects the directory and the cache. */
+static pthread_mutex_t gObjDirMutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+#endif /* OBJECT_DIRECTORY_FEATURE */
 
 /* -------------------------------------------------------------------------- */
 /* LOCAL FUNCTIONS - PROTOTYPE                                                */
 /* -------------------------------------------------------------------------- */
 static void lDataSerializer(uint8_t* xpDataBuffer, uint32_t xInData, uint8_t xOffset);
+static psa_key_id_t lGetInstanceKeyId(uint32_t xKeyId);
+#ifdef KEY_PAIR_POOL_FEATURE
+static void lKeyPoolScan(void);
+static psa_status_t lKeyPoolTake(const psa_key_attributes_t* xpKeyAttr, psa_key_id_t* xpKeyId);
+#endif /* KEY_PAIR_POOL_FEATURE */
+#ifdef OBJECT_DIRECTORY_FEATURE
+static TSalObjDirLookup lObjDirLookup(psa_storage_uid_t xUid, uint8_t xNeedAssociation,
+                                      size_t xOffset, uint8_t* xpOut, size_t xOutLen,
+                                      TSalObjDirEntry* xpEntry, uint32_t* xpGeneration);
+static void lObjDirStore(psa_storage_uid_t xUid, const uint32_t* xpGeneration,
+                         const uint8_t* xpRecord, size_t xRecordLen,
+                         const TKSalObjAssociationInfo* xpAssociationInfo);
+static void lObjDirRemove(psa_storage_uid_t xUid);
+#endif /* OBJECT_DIRECTORY_FEATURE */
 
 /* -------------------------------------------------------------------------- */
 /* PUBLIC VARIABLES                                                           */
@@ -95,6 +263,7 @@ K_SAL_API TKStatus salObjectKeyGen
   TKStatus              status                               = E_K_STATUS_ERROR;
   psa_status_t          lpsaStatus                           = PSA_ERROR_GENERIC_ERROR;
   psa_key_id_t          keyId                                = {0};
+  psa_key_id_t          psaKeyId                             = 0;
   uint8_t               aPublicKey[C_SAL_OBJ_PUBLIC_KEY_SIZE] = {0};
   size_t                publicKeyLen = C_SAL_OBJ_PUBLIC_KEY_SIZE;
   size_t                sizeOut = 0;
@@ -134,6 +303,15 @@ K_SAL_API TKStatus salObjectKeyGen
                (xpPsaKeyAttributes[10] << 8) | xpPsaKeyAttributes[11];
     usage    = (xpPsaKeyAttributes[12] << 24) | (xpPsaKeyAttributes[13] << 16) |
                (xpPsaKeyAttributes[14] << 8)  | xpPsaKeyAttributes[15];
+    id       = lGetInstanceKeyId(id);
+    psaKeyId = lGetInstanceKeyId(xPsaKeyId);
+
+    if ((0U == id) || (0U == psaKeyId))
+    {
+      devLogErr("ERROR - Key id out of the instance range");
+      status = E_K_STATUS_PARAMETER;
+      break;
+    } // if
 
     keyAttr = psa_key_attributes_init();
     psa_set_key_type(&keyAttr, type);
@@ -143,8 +321,18 @@ K_SAL_API TKStatus salObjectKeyGen
     psa_set_key_id(&keyAttr, id);
     psa_set_key_lifetime(&keyAttr, lifetime);
     psa_destroy_key(id);
+#ifdef KEY_PAIR_POOL_FEATURE
+    // Bind a pooled key pair when one matches, generate otherwise
+    lpsaStatus = lKeyPoolTake(&keyAttr, &keyId);
+
+    if (PSA_SUCCESS != lpsaStatus)
+    {
+      lpsaStatus = psa_generate_key(&keyAttr, &keyId);
+    } // if
+#else
     // Generate a random persistent wrapped key
     lpsaStatus = psa_generate_key(&keyAttr, &keyId);
+#endif /* KEY_PAIR_POOL_FEATURE */
 
     if ((PSA_SUCCESS != lpsaStatus) && (PSA_ERROR_ALREADY_EXISTS != lpsaStatus))
     {
@@ -152,14 +340,14 @@ K_SAL_API TKStatus salObjectKeyGen
       break;
     } // if
 
-    if (keyId != xPsaKeyId)
+    if (keyId != psaKeyId)
     {
       devLogErr("ERROR -  psa_generate_key failed[%d], ID not matched", lpsaStatus);
       break;
     } // if
 
     // Export a public key from a persistent private wrapped key
-    lpsaStatus = psa_export_public_key(xPsaKeyId, aPublicKey, publicKeyLen, &publicKeyLen);
+    lpsaStatus = psa_export_public_key(psaKeyId, aPublicKey, publicKeyLen, &publicKeyLen);
 
     if ((PSA_SUCCESS != lpsaStatus) && (PSA_ERROR_ALREADY_EXISTS != lpsaStatus))
     {
@@ -225,6 +413,7 @@ K_SAL_API TKStatus salObjectSet
   TKStatus status = E_K_STATUS_ERROR;
   psa_status_t  psaStatus = PSA_ERROR_GENERIC_ERROR;
   uint32_t createFlags =  0U;
+  psa_storage_uid_t uid = M_SAL_OBJ_INSTANCE_UID(xIdentifier);
 
   devLog("start");
 
@@ -251,7 +440,7 @@ K_SAL_API TKStatus salObjectSet
                      (xpDataAttributes[6] << 8) | xpDataAttributes[7];
     } // if
 
-    psaStatus = psa_its_set(xIdentifier,
+    psaStatus = psa_its_set(uid,
                             (size_t) xpObject->dataLen,
                             (void*) xpObject->data,
                             createFlags);
@@ -259,9 +448,15 @@ K_SAL_API TKStatus salObjectSet
     if (PSA_SUCCESS != psaStatus)
     {
       devLogErr("PSA write failed[%d]\n", psaStatus);
+#ifdef OBJECT_DIRECTORY_FEATURE
+      lObjDirRemove(uid);
+#endif
       break;
     } // if
 
+#ifdef OBJECT_DIRECTORY_FEATURE
+    lObjDirStore(uid, NULL, xpObject->data, xpObject->dataLen, NULL);
+#endif
     status = E_K_STATUS_OK;
     break;
   } // for (;;)
@@ -312,6 +507,12 @@ K_SAL_API TKStatus salObjectGet
 {
   psa_status_t  retStatus = !PSA_SUCCESS;
   TKStatus    status = E_K_STATUS_ERROR;    // Status from sal layer
+  size_t      bufferLen = 0;
+  psa_storage_uid_t uid = M_SAL_OBJ_INSTANCE_UID(xObjectId);
+#ifdef OBJECT_DIRECTORY_FEATURE
+  TSalObjDirEntry entry = {0};
+  uint32_t        generation = 0;
+#endif
 
   devLog("start");
 
@@ -328,7 +529,19 @@ K_SAL_API TKStatus salObjectGet
       break;
     } // if
 
-    retStatus = psa_its_get(xObjectId, 0, (size_t) xpObject->dataLen, (void*)xpObject->data, (size_t*) xpObject->dataLen);
+#ifdef OBJECT_DIRECTORY_FEATURE
+    if (E_SAL_OBJ_DIR_CACHED == lObjDirLookup(uid, 0U, 0U, xpObject->data, xpObject->dataLen,
+                                              &entry, &generation))
+    {
+      xpObject->dataLen = entry.recordLen;
+      retStatus = PSA_SUCCESS;
+      status = E_K_STATUS_OK;
+      break;
+    } // if
+#endif
+
+    bufferLen = xpObject->dataLen;
+    retStatus = psa_its_get(uid, 0, bufferLen, (void*)xpObject->data, &xpObject->dataLen);
 
     if (PSA_SUCCESS != retStatus)
     {
@@ -336,6 +549,13 @@ K_SAL_API TKStatus salObjectGet
       break;
     } // if
 
+#ifdef OBJECT_DIRECTORY_FEATURE
+    // A record filling the whole buffer may be truncated
+    if (xpObject->dataLen < bufferLen)
+    {
+      lObjDirStore(uid, &generation, xpObject->data, xpObject->dataLen, NULL);
+    } // if
+#endif
     status = E_K_STATUS_OK;
     break;
   } // for (;;)
@@ -362,6 +582,7 @@ K_SAL_API TKStatus salObjectDelete
 {
   psa_status_t  retStatus = !PSA_SUCCESS;
   TKStatus    status = E_K_STATUS_ERROR;    // Status from sal layer
+  psa_storage_uid_t uid = M_SAL_OBJ_INSTANCE_UID(xObjectId);
 
   devLog("start");
 
@@ -375,7 +596,10 @@ K_SAL_API TKStatus salObjectDelete
       break;
     } // if
 
-    retStatus = psa_its_remove(xObjectId);
+    retStatus = psa_its_remove(uid);
+#ifdef OBJECT_DIRECTORY_FEATURE
+    lObjDirRemove(uid);
+#endif
 
     if (PSA_SUCCESS != retStatus)
     {
@@ -408,19 +632,20 @@ K_SAL_API TKStatus salObjectKeyDelete
 {
   psa_status_t  retStatus = !PSA_SUCCESS;
   TKStatus      status = E_K_STATUS_ERROR;    // Status from sal layer
+  psa_key_id_t  psaKeyId = lGetInstanceKeyId(xKeyId);
 
   devLog("start");
 
   for (;;)
   {
-    if ((0U == xKeyId)  || (NULL == xpPlatformStatus))
+    if ((0U == psaKeyId)  || (NULL == xpPlatformStatus))
     {
       devLogErr("Parameter validation failed...!");
       status = E_K_STATUS_PARAMETER;
       break;
     } // if
 
-    retStatus = psa_destroy_key(xKeyId);
+    retStatus = psa_destroy_key(psaKeyId);
 
     if (PSA_SUCCESS != retStatus)
     {
@@ -462,6 +687,7 @@ K_SAL_API TKStatus salObjectSetWithAssociation
   uint8_t      aObjDataWithAssociation[C_SAL_OBJ_ASSOC_INFO_MAX_BUFFER_SIZE] = {0};
   uint8_t      dataOffset   = 0;
   size_t       totalDataLen = 0;
+  psa_storage_uid_t uid     = M_SAL_OBJ_INSTANCE_UID(xObjectWithAssociationId);
 
   devLog("start");
 
@@ -502,15 +728,22 @@ K_SAL_API TKStatus salObjectSetWithAssociation
     /* Concatinating both association info length + Input data length */
     totalDataLen = xDataLen + C_SAL_OBJ_ASSOC_INFO_SIZE;
 
-    pstatus = psa_its_set(xObjectWithAssociationId, totalDataLen, aObjDataWithAssociation, 0);
+    pstatus = psa_its_set(uid, totalDataLen, aObjDataWithAssociation, 0);
 
     if (PSA_SUCCESS != pstatus)
     {
       devLogErr("ERROR - PSA write failed[%d]\n", pstatus);
+#ifdef OBJECT_DIRECTORY_FEATURE
+      lObjDirRemove(uid);
+#endif
       status = E_K_STATUS_ERROR;
       break;
     } // if
 
+#ifdef OBJECT_DIRECTORY_FEATURE
+    lObjDirStore(uid, NULL, aObjDataWithAssociation, totalDataLen,
+                 xpAssociationInfo);
+#endif
     pstatus = PSA_SUCCESS;
     status = E_K_STATUS_OK;
     break;
@@ -542,6 +775,14 @@ K_SAL_API TKStatus salObjectGetWithAssociation
   TKStatus status = E_K_STATUS_ERROR;
   psa_status_t pstatus = !PSA_SUCCESS;
   uint8_t aObjDataWithAssociation[C_SAL_OBJ_ASSOC_INFO_MAX_BUFFER_SIZE] = {0};
+  size_t readLen = 0;
+  size_t dataLen = 0;
+  psa_storage_uid_t uid = M_SAL_OBJ_INSTANCE_UID(xObjectWithAssociationId);
+#ifdef OBJECT_DIRECTORY_FEATURE
+  TSalObjDirLookup lookup = E_SAL_OBJ_DIR_MISS;
+  TSalObjDirEntry  entry = {0};
+  uint32_t         generation = 0;
+#endif
 
   devLog("start");
 
@@ -559,11 +800,52 @@ K_SAL_API TKStatus salObjectGetWithAssociation
       break;
     } // if
 
-    pstatus = psa_its_get(xObjectWithAssociationId,
+#ifdef OBJECT_DIRECTORY_FEATURE
+    lookup = lObjDirLookup(uid, 1U, C_SAL_OBJ_ASSOC_INFO_SIZE,
+                           (uint8_t*)xpData, *xpDataLen, &entry, &generation);
+
+    if (E_SAL_OBJ_DIR_MISS != lookup)
+    {
+      readLen = entry.recordLen - C_SAL_OBJ_ASSOC_INFO_SIZE;
+
+      if (E_SAL_OBJ_DIR_KNOWN == lookup)
+      {
+        if (readLen > *xpDataLen)
+        {
+          devLogErr("ERROR - Buffer too small for %u bytes\n", (unsigned int)readLen);
+          pstatus = PSA_ERROR_BUFFER_TOO_SMALL;
+          status = E_K_STATUS_ERROR;
+          break;
+        } // if
+
+        // The header is known, read the data only, straight into the caller buffer
+        pstatus = psa_its_get(uid,
+                              C_SAL_OBJ_ASSOC_INFO_SIZE,
+                              readLen,
+                              (void*)xpData,
+                              &readLen);
+
+        if (PSA_SUCCESS != pstatus)
+        {
+          devLogErr("ERROR - PSA read failed[%d]\n", pstatus);
+          status = E_K_STATUS_ERROR;
+          break;
+        } // if
+      } // if
+
+      *xpAssociationInfo = entry.associationInfo;
+      *xpDataLen = readLen;
+      pstatus = PSA_SUCCESS;
+      status = E_K_STATUS_OK;
+      break;
+    } // if
+#endif
+
+    pstatus = psa_its_get(uid,
                           0,
-                          *xpDataLen,
+                          sizeof(aObjDataWithAssociation),
                           (void*)aObjDataWithAssociation,
-                          xpDataLen);
+                          &readLen);
 
     if (PSA_SUCCESS != pstatus)
     {
@@ -572,6 +854,25 @@ K_SAL_API TKStatus salObjectGetWithAssociation
       break;
     } // if
 
+    dataLen = (aObjDataWithAssociation[17] << 8) | aObjDataWithAssociation[18];
+
+    if ((readLen < C_SAL_OBJ_ASSOC_INFO_SIZE) ||
+        (dataLen > (readLen - C_SAL_OBJ_ASSOC_INFO_SIZE)))
+    {
+      devLogErr("ERROR - Object record of %u bytes is corrupt\n", (unsigned int)readLen);
+      pstatus = PSA_ERROR_DATA_CORRUPT;
+      status = E_K_STATUS_ERROR;
+      break;
+    } // if
+
+    if (dataLen > *xpDataLen)
+    {
+      devLogErr("ERROR - Buffer too small for %u bytes\n", (unsigned int)dataLen);
+      pstatus = PSA_ERROR_BUFFER_TOO_SMALL;
+      status = E_K_STATUS_ERROR;
+      break;
+    } // if
+
     xpAssociationInfo->associatedKeyId =
       (aObjDataWithAssociation[0] << 24) | (aObjDataWithAssociation[1] << 16) |
       (aObjDataWithAssociation[2] << 8) | aObjDataWithAssociation[3];
@@ -587,9 +888,17 @@ K_SAL_API TKStatus salObjectGetWithAssociation
 
     xpAssociationInfo->associatedObjectType = aObjDataWithAssociation[16];
 
-    *xpDataLen  = (aObjDataWithAssociation[17] << 8) | aObjDataWithAssociation[18];
+    *xpDataLen  = dataLen;
 
     (void)memcpy(xpData, &aObjDataWithAssociation[C_SAL_OBJ_ASSOC_INFO_SIZE], *xpDataLen);
+#ifdef OBJECT_DIRECTORY_FEATURE
+    // A record longer than the staging buffer is not recorded
+    if ((dataLen + C_SAL_OBJ_ASSOC_INFO_SIZE) == readLen)
+    {
+      lObjDirStore(uid, &generation, aObjDataWithAssociation, readLen,
+                   xpAssociationInfo);
+    } // if
+#endif
     pstatus = PSA_SUCCESS;
     status = E_K_STATUS_OK;
     break;
@@ -619,6 +928,135 @@ K_SAL_API TKStatus salGetChallenge
   return E_K_STATUS_OK;
 } //salGetChallenge
 
+/******************************************************************************/
+/** \implements salObjectSelectInstance
+ *
+ ******************************************************************************/
+K_SAL_API TKStatus salObjectSelectInstance
+(
+  uint32_t  xInstance
+)
+{
+  TKStatus  status = E_K_STATUS_PARAMETER;
+
+  if (xInstance < C_KTA_APP__MAX_CONTEXTS)
+  {
+    gSalObjInstance = xInstance;
+    status = E_K_STATUS_OK;
+  } // if
+
+  return status;
+} //salObjectSelectInstance
+
+#ifdef KEY_PAIR_POOL_FEATURE
+/******************************************************************************/
+/** \implements salObjectKeyPoolRefill
+ *
+ ******************************************************************************/
+K_SAL_API TKStatus salObjectKeyPoolRefill
+(
+  uint32_t  xMaxCount,
+  uint32_t* xpReadyCount
+)
+{
+  TKStatus              status     = E_K_STATUS_ERROR;
+  psa_status_t          psaStatus  = PSA_ERROR_GENERIC_ERROR;
+  psa_key_attributes_t  keyAttr    = PSA_KEY_ATTRIBUTES_INIT;
+  psa_key_id_t          keyId      = 0;
+  uint32_t              slot       = 0;
+  uint32_t              generated  = 0;
+  uint32_t              readyCount = 0;
+
+  devLog("start");
+
+  for (;;)
+  {
+    if (NULL == xpReadyCount)
+    {
+      devLogErr("ERROR - Parameter validation failed...!");
+      status = E_K_STATUS_PARAMETER;
+      break;
+    } // if
+
+    psaStatus = psa_crypto_init();
+
+    if (PSA_SUCCESS != psaStatus)
+    {
+      devLogErr("ERROR - psa_crypto_init failed[%d]", psaStatus);
+      break;
+    } // if
+
+    status = E_K_STATUS_OK;
+
+    while (generated < xMaxCount)
+    {
+      // Claim an empty slot, generation runs without the lock
+      M_SAL_OBJ_KEY_POOL_LOCK();
+      lKeyPoolScan();
+
+      for (slot = 0; slot < C_KTA_APP__KEY_PAIR_POOL_SIZE; slot++)
+      {
+        if (E_SAL_OBJ_KEY_POOL_EMPTY == gaKeyPoolState[slot])
+        {
+          gaKeyPoolState[slot] = E_SAL_OBJ_KEY_POOL_BUSY;
+          break;
+        } // if
+      } // for
+
+      M_SAL_OBJ_KEY_POOL_UNLOCK();
+
+      if (C_KTA_APP__KEY_PAIR_POOL_SIZE == slot)
+      {
+        break;
+      } // if
+
+      psa_set_key_type(&keyAttr, C_SAL_OBJ_KEY_POOL_TYPE);
+      psa_set_key_bits(&keyAttr, C_SAL_OBJ_KEY_POOL_BITS);
+      psa_set_key_usage_flags(&keyAttr, C_SAL_OBJ_KEY_POOL_USAGE);
+      psa_set_key_algorithm(&keyAttr, C_SAL_OBJ_KEY_POOL_ALG);
+      psa_set_key_id(&keyAttr, C_SAL_OBJ_KEY_POOL_FIRST_ID + slot);
+      psa_set_key_lifetime(&keyAttr,
+                           PSA_KEY_LIFETIME_FROM_PERSISTENCE_AND_LOCATION(PSA_KEY_LIFETIME_PERSISTENT,
+                                                                          PSA_KEY_LOCATION_LOCAL_STORAGE));
+      psaStatus = psa_generate_key(&keyAttr, &keyId);
+
+      M_SAL_OBJ_KEY_POOL_LOCK();
+      gaKeyPoolState[slot] = (PSA_SUCCESS == psaStatus) ? E_SAL_OBJ_KEY_POOL_READY :
+                                                          E_SAL_OBJ_KEY_POOL_EMPTY;
+      M_SAL_OBJ_KEY_POOL_UNLOCK();
+
+      if (PSA_SUCCESS != psaStatus)
+      {
+        devLogErr("ERROR - psa_generate_key failed[%d]", psaStatus);
+        status = E_K_STATUS_ERROR;
+        break;
+      } // if
+
+      generated++;
+    } // while
+
+    M_SAL_OBJ_KEY_POOL_LOCK();
+    lKeyPoolScan();
+
+    for (slot = 0; slot < C_KTA_APP__KEY_PAIR_POOL_SIZE; slot++)
+    {
+      if (E_SAL_OBJ_KEY_POOL_READY == gaKeyPoolState[slot])
+      {
+        readyCount++;
+      } // if
+    } // for
+
+    M_SAL_OBJ_KEY_POOL_UNLOCK();
+    *xpReadyCount = readyCount;
+    break;
+  } // for (;;)
+
+  psa_reset_key_attributes(&keyAttr);
+  devLogKStatus(status, "end");
+  return status;
+} //salObjectKeyPoolRefill
+#endif /* KEY_PAIR_POOL_FEATURE */
+
 /* -------------------------------------------------------------------------- */
 /* LOCAL FUNCTIONS - IMPLEMENTATION                                                */
 /* -------------------------------------------------------------------------- */
@@ -647,6 +1085,431 @@ static void lDataSerializer(uint8_t* xpDataBuffer, uint32_t xInData, uint8_t xOf
   xpDataBuffer[xOffset + 3U] = (xInData & 0xFFu);
 } //lDataSerializer
 
+/**
+ * @brief
+ *    Maps a keySTREAM key id to the persistent PSA key id of the selected instance.
+ *
+ * @param[in]       xKeyId
+ *                  keySTREAM key id.
+ *
+ * @return The PSA key id, 0 if xKeyId cannot be mapped.
+ */
+static psa_key_id_t lGetInstanceKeyId(uint32_t xKeyId)
+{
+  psa_key_id_t keyId = 0U;
+
+#if (C_KTA_APP__MAX_CONTEXTS > 1u)
+  if (xKeyId < C_SAL_OBJ_INSTANCE_KEY_ID_LIMIT)
+  {
+    keyId = (psa_key_id_t)(xKeyId + (gSalObjInstance * C_SAL_OBJ_INSTANCE_KEY_ID_STEP));
+  } // if
+#else
+  keyId = (psa_key_id_t)xKeyId;
+#endif
+
+  return keyId;
+} //lGetInstanceKeyId
+
+#ifdef KEY_PAIR_POOL_FEATURE
+/**
+ * @brief
+ *    Looks up the pool slots not seen since startup in the PSA key store.
+ *    Key pairs of another type or usage, e.g. left by a previous configuration, are
+ *    destroyed.
+ *    Called with the pool lock held.
+ *
+ */
+static void lKeyPoolScan(void)
+{
+  psa_key_attributes_t keyAttr = PSA_KEY_ATTRIBUTES_INIT;
+  uint32_t             slot    = 0;
+
+  for (slot = 0; slot < C_KTA_APP__KEY_PAIR_POOL_SIZE; slot++)
+  {
+    if (E_SAL_OBJ_KEY_POOL_UNKNOWN != gaKeyPoolState[slot])
+    {
+      continue;
+    } // if
+
+    gaKeyPoolState[slot] = E_SAL_OBJ_KEY_POOL_EMPTY;
+
+    if (PSA_SUCCESS == psa_get_key_attributes(C_SAL_OBJ_KEY_POOL_FIRST_ID + slot, &keyAttr))
+    {
+      if ((C_SAL_OBJ_KEY_POOL_TYPE == psa_get_key_type(&keyAttr)) &&
+          (C_SAL_OBJ_KEY_POOL_BITS == psa_get_key_bits(&keyAttr)) &&
+          (C_SAL_OBJ_KEY_POOL_ALG == psa_get_key_algorithm(&keyAttr)) &&
+          (C_SAL_OBJ_KEY_POOL_USAGE == psa_get_key_usage_flags(&keyAttr)))
+      {
+        gaKeyPoolState[slot] = E_SAL_OBJ_KEY_POOL_READY;
+      }
+      else
+      {
+        (void)psa_destroy_key(C_SAL_OBJ_KEY_POOL_FIRST_ID + slot);
+      } // if
+    } // if
+
+    psa_reset_key_attributes(&keyAttr);
+  } // for
+} //lKeyPoolScan
+
+/**
+ * @brief
+ *    Binds a pooled key pair to the identifier of the key attributes.
+ *    The pooled key pair is copied with the requested attributes, then its slot
+ *    is freed so that a key pair is never handed out twice.
+ *
+ * @param[in]       xpKeyAttr
+ *                  Attributes of the requested key, identifier included.
+ * @param[out]      xpKeyId
+ *                  Identifier of the bound key.
+ *
+ * @return PSA_SUCCESS, or an error when no pooled key pair matches the request
+ *         or could be copied. The caller then generates the key pair.
+ */
+static psa_status_t lKeyPoolTake(const psa_key_attributes_t* xpKeyAttr, psa_key_id_t* xpKeyId)
+{
+  psa_status_t psaStatus = PSA_ERROR_DOES_NOT_EXIST;
+  uint32_t     slot      = 0;
+
+  for (;;)
+  {
+    // A usage outside the pool usage would be silently dropped by the copy
+    if ((C_SAL_OBJ_KEY_POOL_TYPE != psa_get_key_type(xpKeyAttr)) ||
+        (C_SAL_OBJ_KEY_POOL_BITS != psa_get_key_bits(xpKeyAttr)) ||
+        (C_SAL_OBJ_KEY_POOL_ALG != psa_get_key_algorithm(xpKeyAttr)) ||
+        (0U != (psa_get_key_usage_flags(xpKeyAttr) &
+                ~(psa_key_usage_t)C_SAL_OBJ_KEY_POOL_USAGE)))
+    {
+      break;
+    } // if
+
+    M_SAL_OBJ_KEY_POOL_LOCK();
+    lKeyPoolScan();
+
+    for (slot = 0; slot < C_KTA_APP__KEY_PAIR_POOL_SIZE; slot++)
+    {
+      if (E_SAL_OBJ_KEY_POOL_READY == gaKeyPoolState[slot])
+      {
+        gaKeyPoolState[slot] = E_SAL_OBJ_KEY_POOL_BUSY;
+        break;
+      } // if
+    } // for
+
+    M_SAL_OBJ_KEY_POOL_UNLOCK();
+
+    if (C_KTA_APP__KEY_PAIR_POOL_SIZE == slot)
+    {
+      devLog("Key pair pool empty");
+      break;
+    } // if
+
+    psaStatus = psa_copy_key(C_SAL_OBJ_KEY_POOL_FIRST_ID + slot, xpKeyAttr, xpKeyId);
+
+    if (PSA_SUCCESS != psaStatus)
+    {
+      devLogErr("ERROR - psa_copy_key failed[%d]", psaStatus);
+    } // if
+
+    (void)psa_destroy_key(C_SAL_OBJ_KEY_POOL_FIRST_ID + slot);
+
+    M_SAL_OBJ_KEY_POOL_LOCK();
+    gaKeyPoolState[slot] = E_SAL_OBJ_KEY_POOL_EMPTY;
+    M_SAL_OBJ_KEY_POOL_UNLOCK();
+    break;
+  } // for (;;)
+
+  return psaStatus;
+} //lKeyPoolTake
+#endif /* KEY_PAIR_POOL_FEATURE */
+
+#ifdef OBJECT_DIRECTORY_FEATURE
+#if (C_KTA_APP__OBJECT_CACHE_SIZE > 0u)
+/**
+ * @brief
+ *    Frees the cache line of a directory entry, if it owns one.
+ *    Called with the directory lock held.
+ *
+ * @param[in, out]  xpEntry
+ *                  Directory entry.
+ *
+ */
+static void lObjCacheRelease(TSalObjDirEntry* xpEntry)
+{
+  if ((xpEntry->cacheLine < C_KTA_APP__OBJECT_CACHE_SIZE) &&
+      (xpEntry == gapObjCacheOwner[xpEntry->cacheLine]))
+  {
+    gapObjCacheOwner[xpEntry->cacheLine] = NULL;
+  } // if
+
+  xpEntry->cacheLine = C_SAL_OBJ_CACHE_NO_LINE;
+} //lObjCacheRelease
+
+/**
+ * @brief
+ *    Keeps the record of a directory entry in a cache line, a free one or else the
+ *    line of the least recently used entry.
+ *    Called with the directory lock held.
+ *
+ * @param[in, out]  xpEntry
+ *                  Directory entry.
+ * @param[in]       xpRecord
+ *                  Record of the object.
+ * @param[in]       xRecordLen
+ *                  Length of the record.
+ *
+ */
+static void lObjCacheFill(TSalObjDirEntry* xpEntry, const uint8_t* xpRecord, size_t xRecordLen)
+{
+  uint32_t line = 0;
+  uint32_t victim = 0;
+
+  if (xRecordLen > C_SAL_OBJ_CACHE_LINE_SIZE)
+  {
+    lObjCacheRelease(xpEntry);
+  }
+  else if (C_SAL_OBJ_CACHE_NO_LINE == xpEntry->cacheLine)
+  {
+    for (line = 0; line < C_KTA_APP__OBJECT_CACHE_SIZE; line++)
+    {
+      if (NULL == gapObjCacheOwner[line])
+      {
+        break;
+      } // if
+
+      if ((int32_t)(gapObjCacheOwner[line]->lastUse - gapObjCacheOwner[victim]->lastUse) < 0)
+      {
+        victim = line;
+      } // if
+    } // for
+
+    if (C_KTA_APP__OBJECT_CACHE_SIZE == line)
+    {
+      line = victim;
+      gapObjCacheOwner[line]->cacheLine = C_SAL_OBJ_CACHE_NO_LINE;
+    } // if
+
+    gapObjCacheOwner[line] = xpEntry;
+    xpEntry->cacheLine = (uint8_t)line;
+  }
+  else
+  {
+    // Keeps its line
+  } // if
+
+  if (C_SAL_OBJ_CACHE_NO_LINE != xpEntry->cacheLine)
+  {
+    (void)memcpy(gaObjCache[xpEntry->cacheLine], xpRecord, xRecordLen);
+  } // if
+} //lObjCacheFill
+#else
+#define lObjCacheRelease(xpEntry)                    ((xpEntry)->cacheLine = C_SAL_OBJ_CACHE_NO_LINE)
+#define lObjCacheFill(xpEntry, xpRecord, xRecordLen) \
+  do { M_UNUSED(xpEntry); M_UNUSED(xpRecord); M_UNUSED(xRecordLen); } while (0)
+#endif /* C_KTA_APP__OBJECT_CACHE_SIZE */
+
+/**
+ * @brief
+ *    Looks up an object in the directory.
+ *
+ * @param[in]       xUid
+ *                  Storage uid of the object.
+ * @param[in]       xNeedAssociation
+ *                  1 if the association information is needed, an entry without
+ *                  it is then reported as unknown.
+ * @param[in]       xOffset
+ *                  Offset of the data to copy in the record.
+ * @param[out]      xpOut
+ *                  Receives the record from xOffset when cached.
+ * @param[in]       xOutLen
+ *                  Length of xpOut, a longer record is not copied.
+ * @param[out]      xpEntry
+ *                  Copy of the directory entry, when known.
+ * @param[out]      xpGeneration
+ *                  Directory generation, to pass to lObjDirStore after reading the storage.
+ *
+ * @return E_SAL_OBJ_DIR_CACHED when the data were copied, E_SAL_OBJ_DIR_KNOWN when
+ *         only the entry was, E_SAL_OBJ_DIR_MISS otherwise.
+ */
+static TSalObjDirLookup lObjDirLookup(psa_storage_uid_t xUid, uint8_t xNeedAssociation,
+                                      size_t xOffset, uint8_t* xpOut, size_t xOutLen,
+                                      TSalObjDirEntry* xpEntry, uint32_t* xpGeneration)
+{
+  TSalObjDirLookup lookup = E_SAL_OBJ_DIR_MISS;
+  TSalObjDirEntry* pEntry = NULL;
+  uint32_t         index = 0;
+
+  M_SAL_OBJ_DIR_LOCK();
+  *xpGeneration = gObjDirGeneration;
+
+  for (index = 0; index < C_KTA_APP__OBJECT_DIRECTORY_SIZE; index++)
+  {
+    if (xUid == gaObjDir[index].uid)
+    {
+      pEntry = &gaObjDir[index];
+      break;
+    } // if
+  } // for
+
+  if ((NULL != pEntry) && ((0U == xNeedAssociation) || (0U != pEntry->hasAssociation)) &&
+      (pEntry->recordLen >= xOffset))
+  {
+    gObjDirTick++;
+    pEntry->lastUse = gObjDirTick;
+    *xpEntry = *pEntry;
+    lookup = E_SAL_OBJ_DIR_KNOWN;
+
+#if (C_KTA_APP__OBJECT_CACHE_SIZE > 0u)
+    if ((C_SAL_OBJ_CACHE_NO_LINE != pEntry->cacheLine) &&
+        ((pEntry->recordLen - xOffset) <= xOutLen))
+    {
+      (void)memcpy(xpOut, &gaObjCache[pEntry->cacheLine][xOffset], pEntry->recordLen - xOffset);
+      lookup = E_SAL_OBJ_DIR_CACHED;
+    } // if
+#else
+    M_UNUSED(xpOut);
+    M_UNUSED(xOutLen);
+#endif
+  } // if
+
+  M_SAL_OBJ_DIR_UNLOCK();
+  return lookup;
+} //lObjDirLookup
+
+/**
+ * @brief
+ *    Records an object in the directory, and its record in the cache.
+ *
+ * @param[in]       xUid
+ *                  Storage uid of the object.
+ * @param[in]       xpGeneration
+ *                  Generation returned by lObjDirLookup before reading the storage,
+ *                  nothing is recorded if an object was written since. NULL for a write.
+ * @param[in]       xpRecord
+ *                  Record of the object as stored.
+ * @param[in]       xRecordLen
+ *                  Length of the record.
+ * @param[in]       xpAssociationInfo
+ *                  Association information when the record has the association header,
+ *                  NULL otherwise.
+ *
+ */
+static void lObjDirStore(psa_storage_uid_t xUid, const uint32_t* xpGeneration,
+                         const uint8_t* xpRecord, size_t xRecordLen,
+                         const TKSalObjAssociationInfo* xpAssociationInfo)
+{
+  TSalObjDirEntry* pEntry = NULL;
+  TSalObjDirEntry* pFree = NULL;
+  TSalObjDirEntry* pOldest = &gaObjDir[0];
+  uint32_t         index = 0;
+
+  M_SAL_OBJ_DIR_LOCK();
+
+  for (;;)
+  {
+    if (NULL == xpGeneration)
+    {
+      gObjDirGeneration++;
+    }
+    else if (*xpGeneration != gObjDirGeneration)
+    {
+      // Written meanwhile, the record read may be stale
+      break;
+    }
+    else
+    {
+      // Nothing to do
+    } // if
+
+    for (index = 0; index < C_KTA_APP__OBJECT_DIRECTORY_SIZE; index++)
+    {
+      if (xUid == gaObjDir[index].uid)
+      {
+        pEntry = &gaObjDir[index];
+        break;
+      } // if
+
+      if (0U == gaObjDir[index].uid)
+      {
+        if (NULL == pFree)
+        {
+          pFree = &gaObjDir[index];
+        } // if
+      }
+      else if ((0U != pOldest->uid) &&
+               ((int32_t)(gaObjDir[index].lastUse - pOldest->lastUse) < 0))
+      {
+        pOldest = &gaObjDir[index];
+      }
+      else
+      {
+        // Not older
+      } // if
+    } // for
+
+    if (NULL == pEntry)
+    {
+      pEntry = (NULL != pFree) ? pFree : pOldest;
+      lObjCacheRelease(pEntry);
+      (void)memset(&pEntry->associationInfo, 0, sizeof(pEntry->associationInfo));
+      pEntry->hasAssociation = 0U;
+      pEntry->uid = xUid;
+    } // if
+
+    gObjDirTick++;
+    pEntry->lastUse = gObjDirTick;
+    pEntry->recordLen = xRecordLen;
+
+    if (NULL != xpAssociationInfo)
+    {
+      pEntry->associationInfo = *xpAssociationInfo;
+      pEntry->hasAssociation = 1U;
+    }
+    else if (NULL == xpGeneration)
+    {
+      // Written without association header
+      pEntry->hasAssociation = 0U;
+    }
+    else
+    {
+      // Read as raw data, the header is still described by the entry
+    } // if
+
+    lObjCacheFill(pEntry, xpRecord, xRecordLen);
+    break;
+  } // for (;;)
+
+  M_SAL_OBJ_DIR_UNLOCK();
+} //lObjDirStore
+
+/**
+ * @brief
+ *    Removes an object from the directory after a delete or a failed write.
+ *
+ * @param[in]       xUid
+ *                  Storage uid of the object.
+ *
+ */
+static void lObjDirRemove(psa_storage_uid_t xUid)
+{
+  uint32_t index = 0;
+
+  M_SAL_OBJ_DIR_LOCK();
+  gObjDirGeneration++;
+
+  for (index = 0; index < C_KTA_APP__OBJECT_DIRECTORY_SIZE; index++)
+  {
+    if (xUid == gaObjDir[index].uid)
+    {
+      lObjCacheRelease(&gaObjDir[index]);
+      gaObjDir[index].uid = 0U;
+      break;
+    } // if
+  } // for
+
+  M_SAL_OBJ_DIR_UNLOCK();
+} //lObjDirRemove
+#endif /* OBJECT_DIRECTORY_FEATURE */
+
 /* -------------------------------------------------------------------------- */
 /* END OF FILE                                                                */
 /* -------------------------------------------------------------------------- */
@@ -42,6 +42,7 @@
 /* -------------------------------------------------------------------------- */
 #include "psa/internal_trusted_storage.h"
 #include "KTALog.h"
+#include "KTABench.h"
 
 #include <stdio.h>
 #include <string.h>
@@ -62,6 +63,9 @@
 /** @brief L1 material data key id. */
 #define C_PSA_L1_KEY_MATERIAL_DATA_KEY_ID           (0x00008004u)
 
+/** @brief Warm start data key id. */
+#define C_PSA_WARM_START_KEY_ID                     (0x00008006u)
+
 /** @brief Maximum sealed data key id length. */
 #define C_K_KTA_SEALED_DATA_STORAGE_ID_LENGTH       (133u)
 
@@ -74,6 +78,68 @@
 /** @brief Rot public UID storage id length. */
 #define C_K_KTA_ROT_PUBLIC_UID_STORAGE_ID_LENGTH    (8u)
 
+/** @brief Batch record key id, holds the data committed together by a storage batch. */
+#define C_PSA_BATCH_RECORD_KEY_ID                   (0x00008005u)
+
+/** @brief Life cycle state bit in the batch record presence mask. */
+#define C_SAL_STORAGE_RECORD_LIFE_CYCLE_STATE       (0x01u)
+
+/** @brief L1 key material bit in the batch record presence mask. */
+#define C_SAL_STORAGE_RECORD_L1_KEY_MATERIAL        (0x02u)
+
+/** @brief Rot public UID bit in the batch record presence mask. */
+#define C_SAL_STORAGE_RECORD_ROT_PUBLIC_UID         (0x04u)
+
+/** @brief Bit position of the instance index in the storage uid. */
+#define C_SAL_STORAGE_INSTANCE_UID_SHIFT            (32u)
+
+/** @brief Storage uid of a data key id for a given instance. */
+#define M_SAL_STORAGE_UID(x_keyId, x_instance) \
+  ((psa_storage_uid_t)(x_keyId) | \
+   ((psa_storage_uid_t)(x_instance) << C_SAL_STORAGE_INSTANCE_UID_SHIFT))
+
+/** @brief Storage uid of a data key id for the instance selected by the calling thread. */
+#define M_SAL_STORAGE_INSTANCE_UID(x_keyId) \
+  M_SAL_STORAGE_UID((x_keyId), gSalStorageInstance)
+
+/**
+ * @brief Batch record, data written through a batch is kept in this single ITS object.
+ * Once a data is held by the record, the record takes precedence over its own uid.
+ */
+typedef struct
+{
+  uint32_t presentMask;
+  /* C_SAL_STORAGE_RECORD_* bits of the data held by the record. */
+  uint8_t aLifeCycleState[C_K_KTA_LIFE_CYCLE_STATE_STORAGE_ID_LENGTH];
+  /* Life cycle state. */
+  uint8_t aL1KeyMaterial[C_K_KTA_L1_KEY_MATERIAL_DATA_ID_LENGTH];
+  /* L1 key material. */
+  uint8_t aRotPublicUid[C_K_KTA_ROT_PUBLIC_UID_STORAGE_ID_LENGTH];
+  /* Rot public UID. */
+} TKSalStorageRecord;
+
+/** @brief RAM copy of the batch record committed for an instance. */
+typedef struct
+{
+  uint8_t isLoaded;
+  /* Set once the record has been read from storage. */
+  TKSalStorageRecord record;
+  /* Committed record, empty if none was ever committed. */
+} TKSalStorageRecordCache;
+
+/** @brief Storage batch opened by the calling thread. */
+typedef struct
+{
+  uint8_t isActive;
+  /* Set between salStorageBatchBegin and salStorageBatchCommit/Abort. */
+  uint8_t isDirty;
+  /* Set once a data has been staged. */
+  uint32_t instance;
+  /* Storage instance the batch was opened on. */
+  TKSalStorageRecord record;
+  /* Stored record updated with the staged data. */
+} TKSalStorageBatch;
+
 /* -------------------------------------------------------------------------- */
 /* LOCAL VARIABLES                                                            */
 /* -------------------------------------------------------------------------- */
@@ -81,6 +147,18 @@
 /** @brief Macro to enable debug logs. */
 static const char* gpModuleName = "SALSTORAGE";
 
+/** @brief Storage instance selected by the calling thread, 0 keeps the legacy uids. */
+static C_KTA_APP__THREAD_LOCAL uint32_t gSalStorageInstance = 0u;
+
+/** @brief Storage batch of the calling thread. */
+static C_KTA_APP__THREAD_LOCAL TKSalStorageBatch gSalStorageBatch;
+
+/**
+ * @brief Committed batch record of each instance, so that reads and writes
+ * outside a batch do not read it back from storage.
+ */
+static TKSalStorageRecordCache gaSalStorageRecordCache[C_KTA_APP__MAX_CONTEXTS];
+
 /* -------------------------------------------------------------------------- */
 /* LOCAL FUNCTIONS - PROTOTYPE                                                */
 /* -------------------------------------------------------------------------- */
@@ -105,6 +183,98 @@ static TKStatus lValidateDataLen
   size_t    xLength
 );
 
+/**
+ * @brief
+ *   Get the location of a data inside the batch record.
+ *
+ * @param[in] xpRecord
+ *   Batch record.
+ * @param[in] xDataId
+ *   Data Id.
+ * @param[out] xpMask
+ *   Presence bit of the data.
+ *
+ * @return
+ * - Location of the data, NULL if the data can not be held by the record.
+ */
+static uint8_t* lGetRecordSlot
+(
+  TKSalStorageRecord*  xpRecord,
+  uint32_t             xDataId,
+  uint32_t*            xpMask
+);
+
+/**
+ * @brief
+ *   Get the batch record of the selected instance, empty if never committed.
+ *   Storage is only read the first time, then the RAM copy is returned.
+ *
+ * @param[out] xpRecord
+ *   Batch record.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_ERROR for other errors.
+ */
+static TKStatus lLoadRecord
+(
+  TKSalStorageRecord*  xpRecord
+);
+
+/**
+ * @brief
+ *   Write the batch record of the selected instance and update its RAM copy.
+ *
+ * @param[in] xpRecord
+ *   Batch record.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_ERROR for other errors.
+ */
+static TKStatus lStoreRecord
+(
+  const TKSalStorageRecord*  xpRecord
+);
+
+/**
+ * @brief
+ *   Write a data: staged if a batch is open and the record can hold it, into the
+ *   record if it already holds it, under its own uid otherwise.
+ *
+ * @param[in] xStorageDataId
+ *   Storage data Identifier.
+ * @param[in] xPsaKeyId
+ *   Own uid of the data.
+ * @param[in] xpData
+ *   Data to write.
+ * @param[in] xDataLen
+ *   Length of xpData, in bytes.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_ERROR for other errors.
+ */
+static TKStatus lWriteValue
+(
+  uint32_t        xStorageDataId,
+  uint32_t        xPsaKeyId,
+  const uint8_t*  xpData,
+  size_t          xDataLen
+);
+
+/**
+ * @brief
+ *   Tell whether the batch of the calling thread applies to the selected instance.
+ *
+ * @return
+ * - 1 if a batch is open on the selected instance, 0 otherwise.
+ */
+static uint8_t lIsBatchActive
+(
+  void
+);
+
 /* -------------------------------------------------------------------------- */
 /* PUBLIC VARIABLES                                                           */
 /* -------------------------------------------------------------------------- */
@@ -124,11 +294,11 @@ K_SAL_API TKStatus salStorageSetAndLockValue
   size_t          xDataLen
 )
 {
-  TKStatus      status = E_K_STATUS_ERROR;
-  psa_status_t  retStatus = !PSA_SUCCESS;
-  size_t        psaKeyId = C_PSA_ROT_PUBLIC_UID_KEY_ID;
+  TKStatus  status = E_K_STATUS_ERROR;
+  uint32_t  psaKeyId = C_PSA_ROT_PUBLIC_UID_KEY_ID;
 
   M_KTALOG__START("Start");
+  M_KTABENCH__START(E_KTABENCH_PHASE_NVM_WRITE);
 
   for (;;)
   {
@@ -157,18 +327,11 @@ K_SAL_API TKStatus salStorageSetAndLockValue
       break;
     }
 
-    retStatus = psa_its_set(psaKeyId, xDataLen, xpData, 0);
-
-    if (PSA_SUCCESS != E_K_STATUS_OK)
-    {
-      M_KTALOG__ERR("psa_write failed %d", retStatus);
-      break;
-    }
-
-    status = E_K_STATUS_OK;
+    status = lWriteValue(xStorageDataId, psaKeyId, xpData, xDataLen);
     break;
   }
 
+  M_KTABENCH__END(E_KTABENCH_PHASE_NVM_WRITE);
   M_KTALOG__END("End, status : %d", status);
 
   return status;
@@ -186,11 +349,11 @@ K_SAL_API TKStatus salStorageSetValue
   size_t          xDataLen
 )
 {
-  TKStatus      status = E_K_STATUS_ERROR;
-  psa_status_t  retStatus = PSA_SUCCESS;
-  size_t        psaKeyId = C_PSA_ROT_PUBLIC_UID_KEY_ID;
+  TKStatus  status = E_K_STATUS_ERROR;
+  uint32_t  psaKeyId = C_PSA_ROT_PUBLIC_UID_KEY_ID;
 
   M_KTALOG__START("Start");
+  M_KTABENCH__START(E_KTABENCH_PHASE_NVM_WRITE);
 
   for (;;)
   {
@@ -219,6 +382,10 @@ K_SAL_API TKStatus salStorageSetValue
     {
       psaKeyId = C_PSA_LIFE_CYCLE_STATE_KEY_ID;
     }
+    else if (xStorageDataId == C_K_KTA__WARM_START_STORAGE_ID)
+    {
+      psaKeyId = C_PSA_WARM_START_KEY_ID;
+    }
     else
     {
       M_KTALOG__ERR("Invalid Id %d", xStorageDataId);
@@ -226,18 +393,11 @@ K_SAL_API TKStatus salStorageSetValue
       break;
     }
 
-    retStatus = psa_its_set(psaKeyId, xDataLen, xpData, 0);
-
-    if (retStatus != PSA_SUCCESS)
-    {
-      M_KTALOG__ERR("psa_write failed %d", retStatus);
-      break;
-    }
-
-    status = E_K_STATUS_OK;
+    status = lWriteValue(xStorageDataId, psaKeyId, xpData, xDataLen);
     break;
   }
 
+  M_KTABENCH__END(E_KTABENCH_PHASE_NVM_WRITE);
   M_KTALOG__END("End, status : %d", status);
 
   return status;
@@ -255,11 +415,15 @@ K_SAL_API TKStatus salStorageGetValue
   size_t*   xpDataLen
 )
 {
-  TKStatus      status = E_K_STATUS_OK;
-  psa_status_t  retStatus = !PSA_SUCCESS;
-  uint16_t      key = 0;
-  size_t        len = 0;
-  size_t        actualSize = 0;
+  TKStatus            status = E_K_STATUS_OK;
+  psa_status_t        retStatus = !PSA_SUCCESS;
+  uint16_t            key = 0;
+  size_t              len = 0;
+  size_t              actualSize = 0;
+  TKSalStorageRecord  record;
+  TKSalStorageRecord* pRecord = &record;
+  const uint8_t*      pSlot = NULL;
+  uint32_t            mask = 0;
 
   M_KTALOG__START("Start");
 
@@ -310,6 +474,12 @@ K_SAL_API TKStatus salStorageGetValue
       }
       break;
 
+      case C_K_KTA__WARM_START_STORAGE_ID:
+      {
+        key = C_PSA_WARM_START_KEY_ID;
+      }
+      break;
+
       default:
       {
         M_KTALOG__ERR("Invalid mode %d", xStorageDataId);
@@ -318,9 +488,32 @@ K_SAL_API TKStatus salStorageGetValue
       break;
     }
 
+    if ((E_K_STATUS_OK == status) &&
+        (NULL != lGetRecordSlot(&record, xStorageDataId, &mask)))
+    {
+      /* Staged data first, then the committed record, then the data own uid. */
+      if (1u == lIsBatchActive())
+      {
+        pRecord = &gSalStorageBatch.record;
+      }
+      else
+      {
+        status = lLoadRecord(&record);
+      }
+
+      pSlot = lGetRecordSlot(pRecord, xStorageDataId, &mask);
+
+      if ((E_K_STATUS_OK == status) && (0u != (pRecord->presentMask & mask)))
+      {
+        (void)memcpy(xpData, pSlot, *xpDataLen);
+        break;
+      }
+    }
+
     if (E_K_STATUS_OK == status)
     {
-      retStatus = psa_its_get(key, 0, *xpDataLen, (void*)xpData, &actualSize);
+      retStatus = psa_its_get(M_SAL_STORAGE_INSTANCE_UID(key), 0, *xpDataLen,
+                              (void*)xpData, &actualSize);
 
       if (retStatus != PSA_SUCCESS)
       {
@@ -336,6 +529,200 @@ K_SAL_API TKStatus salStorageGetValue
   M_KTALOG__END("End, status : %d", status);
   return status;
 }
+
+/**
+ * @brief  implement salStorageSelectInstance
+ *
+ */
+K_SAL_API TKStatus salStorageSelectInstance
+(
+  uint32_t  xInstance
+)
+{
+  TKStatus  status = E_K_STATUS_PARAMETER;
+
+  if (xInstance < C_KTA_APP__MAX_CONTEXTS)
+  {
+    gSalStorageInstance = xInstance;
+    status = E_K_STATUS_OK;
+  }
+
+  return status;
+}
+
+/**
+ * @brief  implement salStorageClearInstance
+ *
+ */
+K_SAL_API TKStatus salStorageClearInstance
+(
+  uint32_t  xInstance
+)
+{
+  static const uint32_t aKeyIds[] =
+  {
+    C_PSA_SEALED_DATA_KEY_ID,
+    C_PSA_ROT_PUBLIC_UID_KEY_ID,
+    C_PSA_LIFE_CYCLE_STATE_KEY_ID,
+    C_PSA_L1_KEY_MATERIAL_DATA_KEY_ID,
+    C_PSA_BATCH_RECORD_KEY_ID,
+    C_PSA_WARM_START_KEY_ID
+  };
+  TKStatus      status = E_K_STATUS_PARAMETER;
+  psa_status_t  retStatus = PSA_SUCCESS;
+  size_t        i = 0;
+
+  M_KTALOG__START("Start");
+
+  if (xInstance < C_KTA_APP__MAX_CONTEXTS)
+  {
+    status = E_K_STATUS_OK;
+
+    for (i = 0; i < (sizeof(aKeyIds) / sizeof(aKeyIds[0])); i++)
+    {
+      retStatus = psa_its_remove(M_SAL_STORAGE_UID(aKeyIds[i], xInstance));
+
+      if ((PSA_SUCCESS != retStatus) && (PSA_ERROR_DOES_NOT_EXIST != retStatus))
+      {
+        M_KTALOG__ERR("psa_its_remove failed %d", retStatus);
+        status = E_K_STATUS_ERROR;
+      }
+    }
+
+    /* Forget the cached record, whatever has been removed. */
+    (void)memset(&gaSalStorageRecordCache[xInstance], 0, sizeof(TKSalStorageRecordCache));
+
+    if ((1u == gSalStorageBatch.isActive) && (gSalStorageBatch.instance == xInstance))
+    {
+      gSalStorageBatch.isActive = 0u;
+      gSalStorageBatch.isDirty = 0u;
+    }
+  }
+
+  M_KTALOG__END("End, status : %d", status);
+  return status;
+}
+
+/**
+ * @brief  implement salStorageBatchBegin
+ *
+ */
+K_SAL_API TKStatus salStorageBatchBegin
+(
+  void
+)
+{
+  TKStatus  status = E_K_STATUS_STATE;
+
+  M_KTALOG__START("Start");
+
+  if (0u == gSalStorageBatch.isActive)
+  {
+    status = lLoadRecord(&gSalStorageBatch.record);
+
+    if (E_K_STATUS_OK == status)
+    {
+      gSalStorageBatch.instance = gSalStorageInstance;
+      gSalStorageBatch.isDirty = 0u;
+      gSalStorageBatch.isActive = 1u;
+    }
+  }
+
+  M_KTALOG__END("End, status : %d", status);
+  return status;
+}
+
+/**
+ * @brief  implement salStorageBatchStage
+ *
+ */
+K_SAL_API TKStatus salStorageBatchStage
+(
+  uint32_t        xStorageDataId,
+  const uint8_t*  xpData,
+  size_t          xDataLen
+)
+{
+  TKStatus  status = E_K_STATUS_PARAMETER;
+  uint8_t*  pSlot = NULL;
+  uint32_t  mask = 0;
+
+  if (1u != lIsBatchActive())
+  {
+    M_KTALOG__ERR("No batch open");
+    status = E_K_STATUS_STATE;
+  }
+  else if ((NULL != xpData) &&
+           (E_K_STATUS_OK == lValidateDataLen(xStorageDataId, xDataLen)))
+  {
+    pSlot = lGetRecordSlot(&gSalStorageBatch.record, xStorageDataId, &mask);
+
+    if ((NULL != pSlot) && (0u != (gSalStorageBatch.record.presentMask & mask)) &&
+        (0 == memcmp(pSlot, xpData, xDataLen)))
+    {
+      /* Unchanged, e.g. the rot public UID carried by every message. */
+      status = E_K_STATUS_OK;
+    }
+    else if (NULL != pSlot)
+    {
+      (void)memcpy(pSlot, xpData, xDataLen);
+      gSalStorageBatch.record.presentMask |= mask;
+      gSalStorageBatch.isDirty = 1u;
+      status = E_K_STATUS_OK;
+    }
+  }
+  else
+  {
+    M_KTALOG__ERR("Invalid parameters");
+  }
+
+  return status;
+}
+
+/**
+ * @brief  implement salStorageBatchCommit
+ *
+ */
+K_SAL_API TKStatus salStorageBatchCommit
+(
+  void
+)
+{
+  TKStatus  status = E_K_STATUS_STATE;
+
+  M_KTALOG__START("Start");
+
+  if (1u == lIsBatchActive())
+  {
+    status = E_K_STATUS_OK;
+
+    if (1u == gSalStorageBatch.isDirty)
+    {
+      M_KTABENCH__START(E_KTABENCH_PHASE_NVM_WRITE);
+      /* A single ITS object, so the staged data reach flash together or not at all. */
+      status = lStoreRecord(&gSalStorageBatch.record);
+      M_KTABENCH__END(E_KTABENCH_PHASE_NVM_WRITE);
+    }
+
+    gSalStorageBatch.isActive = 0u;
+  }
+
+  M_KTALOG__END("End, status : %d", status);
+  return status;
+}
+
+/**
+ * @brief  implement salStorageBatchAbort
+ *
+ */
+K_SAL_API void salStorageBatchAbort
+(
+  void
+)
+{
+  gSalStorageBatch.isActive = 0u;
+  gSalStorageBatch.isDirty = 0u;
+}
 /* -------------------------------------------------------------------------- */
 /* LOCAL FUNCTIONS - IMPLEMENTATION                                           */
 /* -------------------------------------------------------------------------- */
@@ -379,6 +766,12 @@ static TKStatus lValidateDataLen
     }
     break;
 
+    case C_K_KTA__WARM_START_STORAGE_ID:
+    {
+      dataLen = C_K_KTA__WARM_START_DATA_SIZE;
+    }
+    break;
+
     default:
     {
       M_KTALOG__ERR("Invalid Id %d", xDataId);
@@ -396,6 +789,195 @@ static TKStatus lValidateDataLen
   return status;
 }
 
+/**
+ * @implements lGetRecordSlot
+ *
+ **/
+static uint8_t* lGetRecordSlot
+(
+  TKSalStorageRecord*  xpRecord,
+  uint32_t             xDataId,
+  uint32_t*            xpMask
+)
+{
+  uint8_t*  pSlot = NULL;
+
+  if (C_K_KTA__LIFE_CYCLE_STATE_STORAGE_ID == xDataId)
+  {
+    pSlot = xpRecord->aLifeCycleState;
+    *xpMask = C_SAL_STORAGE_RECORD_LIFE_CYCLE_STATE;
+  }
+  else if (C_K_KTA__L1_KEY_MATERIAL_DATA_ID == xDataId)
+  {
+    pSlot = xpRecord->aL1KeyMaterial;
+    *xpMask = C_SAL_STORAGE_RECORD_L1_KEY_MATERIAL;
+  }
+  else if (C_K_KTA__ROT_PUBLIC_UID_STORAGE_ID == xDataId)
+  {
+    pSlot = xpRecord->aRotPublicUid;
+    *xpMask = C_SAL_STORAGE_RECORD_ROT_PUBLIC_UID;
+  }
+  else
+  {
+    *xpMask = 0u;
+  }
+
+  return pSlot;
+}
+
+/**
+ * @implements lLoadRecord
+ *
+ **/
+static TKStatus lLoadRecord
+(
+  TKSalStorageRecord*  xpRecord
+)
+{
+  TKStatus                  status = E_K_STATUS_OK;
+  psa_status_t              retStatus = PSA_SUCCESS;
+  size_t                    actualSize = 0;
+  TKSalStorageRecordCache*  pCache = &gaSalStorageRecordCache[gSalStorageInstance];
+
+  if (0u == pCache->isLoaded)
+  {
+    (void)memset(&pCache->record, 0, sizeof(TKSalStorageRecord));
+    retStatus = psa_its_get(M_SAL_STORAGE_INSTANCE_UID(C_PSA_BATCH_RECORD_KEY_ID),
+                            0,
+                            sizeof(TKSalStorageRecord),
+                            &pCache->record,
+                            &actualSize);
+
+    if (PSA_ERROR_DOES_NOT_EXIST == retStatus)
+    {
+      /* No batch committed yet, every data lives under its own uid. */
+      pCache->isLoaded = 1u;
+    }
+    else if ((PSA_SUCCESS == retStatus) && (sizeof(TKSalStorageRecord) == actualSize))
+    {
+      pCache->isLoaded = 1u;
+    }
+    else
+    {
+      M_KTALOG__ERR("Batch record read failed %d", retStatus);
+      (void)memset(&pCache->record, 0, sizeof(TKSalStorageRecord));
+      status = E_K_STATUS_ERROR;
+    }
+  }
+
+  (void)memcpy(xpRecord, &pCache->record, sizeof(TKSalStorageRecord));
+
+  return status;
+}
+
+/**
+ * @implements lStoreRecord
+ *
+ **/
+static TKStatus lStoreRecord
+(
+  const TKSalStorageRecord*  xpRecord
+)
+{
+  TKStatus      status = E_K_STATUS_ERROR;
+  psa_status_t  retStatus = PSA_SUCCESS;
+
+  retStatus = psa_its_set(M_SAL_STORAGE_INSTANCE_UID(C_PSA_BATCH_RECORD_KEY_ID),
+                          sizeof(TKSalStorageRecord),
+                          xpRecord,
+                          0);
+
+  if (PSA_SUCCESS == retStatus)
+  {
+    (void)memcpy(&gaSalStorageRecordCache[gSalStorageInstance].record,
+                 xpRecord,
+                 sizeof(TKSalStorageRecord));
+    gaSalStorageRecordCache[gSalStorageInstance].isLoaded = 1u;
+    status = E_K_STATUS_OK;
+  }
+  else
+  {
+    M_KTALOG__ERR("psa_write failed %d", retStatus);
+  }
+
+  return status;
+}
+
+/**
+ * @implements lWriteValue
+ *
+ **/
+static TKStatus lWriteValue
+(
+  uint32_t        xStorageDataId,
+  uint32_t        xPsaKeyId,
+  const uint8_t*  xpData,
+  size_t          xDataLen
+)
+{
+  TKStatus            status = E_K_STATUS_ERROR;
+  psa_status_t        retStatus = PSA_SUCCESS;
+  TKSalStorageRecord  record;
+  uint8_t*            pSlot = NULL;
+  uint32_t            mask = 0;
+
+  if ((1u == lIsBatchActive()) &&
+      (NULL != lGetRecordSlot(&gSalStorageBatch.record, xStorageDataId, &mask)))
+  {
+    /* Written to flash by salStorageBatchCommit. */
+    status = salStorageBatchStage(xStorageDataId, xpData, xDataLen);
+  }
+  else if (E_K_STATUS_OK == lLoadRecord(&record))
+  {
+    pSlot = lGetRecordSlot(&record, xStorageDataId, &mask);
+
+    if (0u != (record.presentMask & mask))
+    {
+      /* The record holds this data, update it there. */
+      (void)memcpy(pSlot, xpData, xDataLen);
+      status = lStoreRecord(&record);
+    }
+    else
+    {
+      retStatus = psa_its_set(M_SAL_STORAGE_INSTANCE_UID(xPsaKeyId), xDataLen, xpData, 0);
+
+      if (PSA_SUCCESS == retStatus)
+      {
+        status = E_K_STATUS_OK;
+      }
+      else
+      {
+        M_KTALOG__ERR("psa_write failed %d", retStatus);
+      }
+    }
+  }
+  else
+  {
+    M_KTALOG__ERR("Batch record not available");
+  }
+
+  return status;
+}
+
+/**
+ * @implements lIsBatchActive
+ *
+ **/
+static uint8_t lIsBatchActive
+(
+  void
+)
+{
+  uint8_t  isActive = 0u;
+
+  if ((1u == gSalStorageBatch.isActive) && (gSalStorageBatch.instance == gSalStorageInstance))
+  {
+    isActive = 1u;
+  }
+
+  return isActive;
+}
+
 /* -------------------------------------------------------------------------- */
 /* END OF FILE                                                                */
 /* -------------------------------------------------------------------------- */
@@ -0,0 +1,576 @@
+/*******************************************************************************
+*************************keySTREAM Trusted Agent ("KTA")************************
+
+* (c) 2023-2025 Nagravision Sàrl
+
+* Subject to your compliance with these terms, you may use the Nagravision Sàrl
+* Software and any derivatives exclusively with Nagravision's products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may accompany
+* Nagravision Software.
+
+* Redistribution of this Nagravision Software in source or binary form is allowed
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+
+* THIS SOFTWARE IS SUPPLIED BY NAGRAVISION "AS IS". NO WARRANTIES, WHETHER EXPRESS,
+* IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF
+* NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE. IN NO
+* EVENT WILL NAGRAVISION BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL
+* OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF NAGRAVISION HAS BEEN ADVISED OF THE
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW,
+* NAGRAVISION 'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS
+* SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY
+* TO NAGRAVISION FOR THIS SOFTWARE.
+********************************************************************************/
+/** \brief  keySTREAM Trusted Agent - Benchmark of the provisioning handshake.
+ *
+ *  \author Kudelski IoT
+ *
+ *  \date 2026/10/17
+ *
+ *  \file ktaBenchmark.c
+ ******************************************************************************/
+/**
+ * @brief   keySTREAM Trusted Agent - Benchmark of the provisioning handshake.
+ */
+
+#include "ktaBenchmark.h"
+/* -------------------------------------------------------------------------- */
+/* IMPORTS                                                                    */
+/* -------------------------------------------------------------------------- */
+#include "k_kta.h"
+#include "ktaConfig.h"
+
+#ifdef BENCHMARK_FEATURE
+#include "KTABench.h"
+#include "icpp_parser.h"
+#include "k_sal.h"
+#ifdef LOCAL_SERVER_FEATURE
+#include "ktaLocalServer.h"
+#else
+#include "comm_if.h"
+#include "cryptoConfig.h"
+#endif /* LOCAL_SERVER_FEATURE */
+
+#include <stdbool.h>
+#include <stdio.h>
+
+#if (C_KTA_APP__MAX_CONTEXTS < 2u)
+#error "BENCHMARK_FEATURE requires C_KTA_APP__MAX_CONTEXTS greater than 1"
+#endif
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL CONSTANTS, TYPES, ENUM                                               */
+/* -------------------------------------------------------------------------- */
+/** @brief Size of the data field of the parser benchmark commands. */
+#define C_KTA_BENCHMARK__PARSER_DATA_SIZE        (96u)
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL VARIABLES                                                            */
+/* -------------------------------------------------------------------------- */
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL FUNCTIONS - PROTOTYPE                                                */
+/* -------------------------------------------------------------------------- */
+/**
+ * @brief
+ *   Run one provisioning handshake in a fresh context.
+ *
+ * @param[in] xpConfig
+ *   Benchmark configuration.
+ * @param[in] xExchange
+ *   Transport to the keySTREAM peer.
+ *
+ * @return
+ * - E_K_STATUS_OK if the handshake completed.
+ * - The failing status otherwise.
+ */
+static TKStatus lBenchmarkIteration
+(
+  const TKtaBenchmarkConfig*  xpConfig,
+  TKtaBenchmarkExchange       xExchange
+);
+
+/**
+ * @brief
+ *   Build the message deserialized by the parser benchmark.
+ *
+ * @param[out] xpMessage
+ *   Serialized message.
+ * @param[in,out] xpMessageSize
+ *   [in] Size of xpMessage.
+ *   [out] Size of the serialized message.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_ERROR for other errors.
+ */
+static TKStatus lBenchmarkParserMessage
+(
+  uint8_t*  xpMessage,
+  size_t*   xpMessageSize
+);
+
+#ifndef LOCAL_SERVER_FEATURE
+/**
+ * @brief
+ *   Default transport, exchange one message through the communication stack.
+ *
+ * @param[in] xpArg
+ *   Unused.
+ * @param[in] xpMsgToSend
+ *   Message to send to keySTREAM.
+ * @param[in] xSendSize
+ *   Size of xpMsgToSend, in bytes.
+ * @param[in,out] xpRecvMsg
+ *   Buffer receiving the keySTREAM response.
+ * @param[in,out] xpRecvMsgSize
+ *   [in] Size of xpRecvMsg.
+ *   [out] Size of the response.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_ERROR for other errors.
+ */
+static TKStatus lBenchmarkCommExchange
+(
+  void*           xpArg,
+  const uint8_t*  xpMsgToSend,
+  size_t          xSendSize,
+  uint8_t*        xpRecvMsg,
+  size_t*         xpRecvMsgSize
+);
+#endif /* LOCAL_SERVER_FEATURE */
+
+/* -------------------------------------------------------------------------- */
+/* PUBLIC VARIABLES                                                           */
+/* -------------------------------------------------------------------------- */
+
+/* -------------------------------------------------------------------------- */
+/* PUBLIC FUNCTIONS - IMPLEMENTATION                                          */
+/* -------------------------------------------------------------------------- */
+/**
+ * @brief  implement ktaBenchmarkRun
+ *
+ */
+/**
+ * SUPPRESS: MISRA_DEV_KTA_004 : misra_c2012_rule_15.1_violation
+ * Using goto for breaking during the error and return cases.
+ **/
+TKStatus ktaBenchmarkRun
+(
+  const TKtaBenchmarkConfig*  xpConfig,
+  uint32_t*                   xpCompleted
+)
+{
+  TKtaBenchmarkExchange  exchange = NULL;
+  uint32_t               iteration = 0;
+  TKStatus               retStatus = E_K_STATUS_ERROR;
+  bool                   isCommInitialized = false;
+
+  C_KTA_APP__LOG("[INFO] ktaBenchmarkRun Start\r\n");
+
+  if ((NULL == xpConfig) || (NULL == xpCompleted) || (0u == xpConfig->iterations))
+  {
+    C_KTA_APP__LOG("[ERROR] Invalid parameter\r\n");
+    retStatus = E_K_STATUS_PARAMETER;
+    goto end;
+  }
+
+  *xpCompleted = 0;
+  exchange = xpConfig->exchange;
+
+  if (NULL == exchange)
+  {
+#ifdef LOCAL_SERVER_FEATURE
+    exchange = ktaLocalServerExchange;
+#else
+    if (E_COMM_IF_STATUS_OK != commInit(C_K_COMM__SERVER_HOST,
+                                        C_K_COMM__SERVER_PORT,
+                                        (const uint8_t*)C_K_COMM__SERVER_URI))
+    {
+      C_KTA_APP__LOG("[ERROR] commInit failed\r\n");
+      goto end;
+    }
+
+    isCommInitialized = true;
+    exchange = lBenchmarkCommExchange;
+#endif /* LOCAL_SERVER_FEATURE */
+  }
+
+  ktaBench_Reset();
+  retStatus = E_K_STATUS_OK;
+
+  for (iteration = 0; iteration < xpConfig->iterations; iteration++)
+  {
+    if (E_K_STATUS_OK == lBenchmarkIteration(xpConfig, exchange))
+    {
+      (*xpCompleted)++;
+    }
+    else
+    {
+      C_KTA_APP__LOG("[ERROR] Handshake %u failed\r\n", (unsigned int)iteration);
+      retStatus = E_K_STATUS_ERROR;
+    }
+  }
+
+end:
+#ifndef LOCAL_SERVER_FEATURE
+  if (isCommInitialized && (E_COMM_IF_STATUS_OK != commTerm()))
+  {
+    C_KTA_APP__LOG("[FAIL] Communication Stack Termination failed \r\n");
+    retStatus = E_K_STATUS_ERROR;
+  }
+#else
+  (void)isCommInitialized;
+#endif /* LOCAL_SERVER_FEATURE */
+
+  C_KTA_APP__LOG("[INFO] ktaBenchmarkRun end, status[%d]\r\n", retStatus);
+  return retStatus;
+}
+
+/**
+ * @brief  implement ktaBenchmarkPrintReport
+ *
+ */
+void ktaBenchmarkPrintReport
+(
+  void
+)
+{
+  TKtaBenchReport  report = {0};
+  uint32_t         phase = 0;
+
+  C_KTA_APP__LOG("%-16s %8s %10s %10s %10s %10s %10s %12s\r\n",
+                 "phase (us)", "count", "wall p50", "wall p99", "wall max",
+                 "cpu p50", "cpu p99", "cpu total");
+
+  for (phase = 0; phase < (uint32_t)E_KTABENCH_PHASE_COUNT; phase++)
+  {
+    if ((0 == ktaBench_GetReport((TKtaBenchPhase)phase, &report)) && (0u != report.count))
+    {
+      C_KTA_APP__LOG("%-16s %8u %10llu %10llu %10llu %10llu %10llu %12llu\r\n",
+                     ktaBench_PhaseName((TKtaBenchPhase)phase),
+                     (unsigned int)report.count,
+                     (unsigned long long)report.wallP50,
+                     (unsigned long long)report.wallP99,
+                     (unsigned long long)report.wallMax,
+                     (unsigned long long)report.cpuP50,
+                     (unsigned long long)report.cpuP99,
+                     (unsigned long long)report.cpuTotal);
+    }
+  }
+}
+
+/**
+ * @brief  implement ktaBenchmarkParserRun
+ *
+ */
+/**
+ * SUPPRESS: MISRA_DEV_KTA_004 : misra_c2012_rule_15.1_violation
+ * Using goto for breaking during the error and return cases.
+ **/
+TKStatus ktaBenchmarkParserRun
+(
+  uint32_t  xIterations
+)
+{
+  static TKIcppProtocolMessage  message;
+  uint8_t         aMessage[C_K__ICPP_MSG_MAX_SIZE];
+  size_t          messageSize = sizeof(aMessage);
+  uint8_t         aResponse[C_K__ICPP_MSG_MAX_SIZE];
+  size_t          responseSize = 0;
+  uint32_t        iteration = 0;
+  TKParserStatus  parserStatus = E_K_ICPP_PARSER_STATUS_ERROR;
+  TKStatus        retStatus = E_K_STATUS_ERROR;
+
+  C_KTA_APP__LOG("[INFO] ktaBenchmarkParserRun Start\r\n");
+
+  if (0u == xIterations)
+  {
+    C_KTA_APP__LOG("[ERROR] Invalid parameter\r\n");
+    retStatus = E_K_STATUS_PARAMETER;
+    goto end;
+  }
+
+  retStatus = lBenchmarkParserMessage(aMessage, &messageSize);
+
+  if (E_K_STATUS_OK != retStatus)
+  {
+    goto end;
+  }
+
+  ktaBench_Reset();
+
+  for (iteration = 0; iteration < xIterations; iteration++)
+  {
+    responseSize = sizeof(aResponse);
+
+    M_KTABENCH__START(E_KTABENCH_PHASE_PARSE);
+    parserStatus = ktaIcppParserDeserializeMessage(aMessage, messageSize, &message);
+
+    if (E_K_ICPP_PARSER_STATUS_OK == parserStatus)
+    {
+      parserStatus = ktaIcppParserSerializeMessage(&message, aResponse, &responseSize);
+    }
+    M_KTABENCH__END(E_KTABENCH_PHASE_PARSE);
+
+    if ((E_K_ICPP_PARSER_STATUS_OK != parserStatus) || (responseSize != messageSize))
+    {
+      C_KTA_APP__LOG("[ERROR] Parser round %u failed, status[%d]\r\n",
+                     (unsigned int)iteration, parserStatus);
+      retStatus = E_K_STATUS_ERROR;
+    }
+  }
+
+end:
+  C_KTA_APP__LOG("[INFO] ktaBenchmarkParserRun end, status[%d]\r\n", retStatus);
+  return retStatus;
+}
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL FUNCTIONS - IMPLEMENTATION                                           */
+/* -------------------------------------------------------------------------- */
+/**
+ * @implements lBenchmarkIteration
+ *
+ */
+/**
+ * SUPPRESS: MISRA_DEV_KTA_004 : misra_c2012_rule_15.1_violation
+ * Using goto for breaking during the error and return cases.
+ **/
+static TKStatus lBenchmarkIteration
+(
+  const TKtaBenchmarkConfig*  xpConfig,
+  TKtaBenchmarkExchange       xExchange
+)
+{
+  uint8_t        aKta2KsMsg[C_K__ICPP_MSG_MAX_SIZE];
+  size_t         kta2KsMsgSize = 0;
+  uint8_t        aKs2KtaMsg[C_K__ICPP_MSG_MAX_SIZE];
+  size_t         ks2KtaMsgSize = 0;
+  uint8_t        connectionReq = 0;
+  uint32_t       exchangeCount = 0;
+  TKtaContext*   pContext = NULL;
+  TKStatus       retStatus = E_K_STATUS_ERROR;
+  bool           isCompleted = false;
+
+  retStatus = ktaContextCreate(&pContext);
+
+  if (E_K_STATUS_OK != retStatus)
+  {
+    goto end;
+  }
+
+  retStatus = ktaContextSelect(pContext);
+
+  if (E_K_STATUS_OK != retStatus)
+  {
+    goto end;
+  }
+
+  M_KTABENCH__START(E_KTABENCH_PHASE_HANDSHAKE);
+
+  retStatus = ktaInitialize();
+
+  if (E_K_STATUS_OK != retStatus)
+  {
+    goto end;
+  }
+
+  retStatus = ktaStartup(xpConfig->pL1SegSeed,
+                         xpConfig->pContextProfileUid,
+                         xpConfig->contextProfileUidLen,
+                         xpConfig->pContextSerialNum,
+                         xpConfig->contextSerialNumLen,
+                         xpConfig->pContextVersion,
+                         xpConfig->contextVersionLen);
+
+  if (E_K_STATUS_OK != retStatus)
+  {
+    goto end;
+  }
+
+  retStatus = ktaSetDeviceInformation(xpConfig->pDeviceProfilePublicUid,
+                                      xpConfig->deviceProfilePublicUidLen,
+                                      xpConfig->pDeviceSerialNum,
+                                      xpConfig->deviceSerialNumLen,
+                                      &connectionReq);
+
+  if ((E_K_STATUS_OK != retStatus) || (1u != connectionReq))
+  {
+    retStatus = E_K_STATUS_ERROR;
+    goto end;
+  }
+
+  for (; exchangeCount < C_KTA_BENCHMARK__MAX_EXCHANGES; exchangeCount++)
+  {
+    kta2KsMsgSize = sizeof(aKta2KsMsg);
+    retStatus = ktaExchangeMessage(aKs2KtaMsg, ks2KtaMsgSize, aKta2KsMsg, &kta2KsMsgSize);
+
+    if (E_K_STATUS_OK != retStatus)
+    {
+      break;
+    }
+
+    if (0u == kta2KsMsgSize)
+    {
+      isCompleted = true;
+      break;
+    }
+
+    ks2KtaMsgSize = sizeof(aKs2KtaMsg);
+    M_KTABENCH__START(E_KTABENCH_PHASE_TRANSPORT);
+    retStatus = xExchange(xpConfig->pExchangeArg,
+                          aKta2KsMsg,
+                          kta2KsMsgSize,
+                          aKs2KtaMsg,
+                          &ks2KtaMsgSize);
+    M_KTABENCH__END(E_KTABENCH_PHASE_TRANSPORT);
+
+    if ((E_K_STATUS_OK != retStatus) || (0u == ks2KtaMsgSize))
+    {
+      retStatus = E_K_STATUS_ERROR;
+      break;
+    }
+  }
+
+  if (isCompleted)
+  {
+    M_KTABENCH__END(E_KTABENCH_PHASE_HANDSHAKE);
+  }
+  else if (E_K_STATUS_OK == retStatus)
+  {
+    C_KTA_APP__LOG("[ERROR] No end of handshake after %u messages\r\n",
+                   (unsigned int)exchangeCount);
+    retStatus = E_K_STATUS_ERROR;
+  }
+  else
+  {
+    /* Failing status already set. */
+  }
+
+end:
+  if (E_K_STATUS_OK != retStatus)
+  {
+    C_KTA_APP__LOG("[ERROR] Benchmark handshake failed, exchanges[%u] status[%d]\r\n",
+                   (unsigned int)exchangeCount, retStatus);
+  }
+
+  if (NULL != pContext)
+  {
+    (void)ktaContextRelease(pContext);
+  }
+
+  return retStatus;
+}
+
+/**
+ * @implements lBenchmarkParserMessage
+ *
+ */
+static TKStatus lBenchmarkParserMessage
+(
+  uint8_t*  xpMessage,
+  size_t*   xpMessageSize
+)
+{
+  static TKIcppProtocolMessage  message;
+  static uint8_t  aIdentifier[4] = {0x00, 0x00, 0x10, 0x01};
+  static uint8_t  aObjectType[1] = {0x01};
+  static uint8_t  aAttributes[2] = {0x00, 0x03};
+  static uint8_t  aOwner[4] = {0x00, 0x00, 0x00, 0x01};
+  static uint8_t  aData[C_KTA_BENCHMARK__PARSER_DATA_SIZE] = {0};
+  const TKIcppField  aSetFields[] =
+  {
+    { E_K_ICPP_PARSER_FLD_TAG_CMD_IDENTIFIER,        sizeof(aIdentifier), aIdentifier },
+    { E_K_ICPP_PARSER_FIELD_TAG_CMD_OBJECT_TYPE,     sizeof(aObjectType), aObjectType },
+    { E_K_ICPP_PARSER_FIELD_TAG_CMD_ATTRIBUTES,      sizeof(aAttributes), aAttributes },
+    { E_K_ICPP_PRSR_FLD_TAG_CMD_OBJECT_OWNER,        sizeof(aOwner),      aOwner },
+    { E_K_ICPP_PARSER_FLD_TAG_CMD_DATA,              sizeof(aData),       aData }
+  };
+  const TKIcppField  aDeleteFields[] =
+  {
+    { E_K_ICPP_PARSER_FLD_TAG_CMD_IDENTIFIER,        sizeof(aIdentifier), aIdentifier }
+  };
+  size_t          commandIndex = 0;
+  size_t          fieldIndex = 0;
+  TKIcppCommand*  pCommand = NULL;
+  TKStatus        retStatus = E_K_STATUS_ERROR;
+
+  message.cryptoVersion = (uint8_t)E_K_ICPP_PARSER_CRYPTO_TYPE_FULL_CLEAR;
+  message.encMode = (uint8_t)E_K_ICPP_PARSER_FULL_ENC_MODE;
+  message.msgType = E_K_ICPP_PARSER_MESSAGE_TYPE_COMMAND;
+  message.commandsCount = C_K_ICPP_PARSER__MAX_COMMANDS_COUNT;
+
+  /* Set object and delete object commands alternate, as in a provisioning campaign. */
+  for (commandIndex = 0; commandIndex < message.commandsCount; commandIndex++)
+  {
+    pCommand = &message.commands[commandIndex];
+
+    if (0u == (commandIndex % 2u))
+    {
+      pCommand->commandTag = E_K_ICPP_PARSER_COMMAND_TAG_SET_OBJECT;
+      pCommand->data.fieldList.fieldsCount = sizeof(aSetFields) / sizeof(aSetFields[0]);
+
+      for (fieldIndex = 0; fieldIndex < pCommand->data.fieldList.fieldsCount; fieldIndex++)
+      {
+        pCommand->data.fieldList.fields[fieldIndex] = aSetFields[fieldIndex];
+      }
+    }
+    else
+    {
+      pCommand->commandTag = E_K_ICPP_PARSER_COMMAND_TAG_DELETE_OBJECT;
+      pCommand->data.fieldList.fieldsCount = sizeof(aDeleteFields) / sizeof(aDeleteFields[0]);
+      pCommand->data.fieldList.fields[0] = aDeleteFields[0];
+    }
+  }
+
+  /* The header length of a received message no longer counts the MAC. */
+  if ((E_K_ICPP_PARSER_STATUS_OK == ktaIcppParserSerializeMessage(&message,
+                                                                  xpMessage,
+                                                                  xpMessageSize)) &&
+      (E_K_ICPP_PARSER_STATUS_OK == ktaIcppParserSetHeaderLength(
+                                      xpMessage,
+                                      *xpMessageSize - C_K_ICPP_PARSER__HEADER_SIZE)))
+  {
+    retStatus = E_K_STATUS_OK;
+  }
+  else
+  {
+    C_KTA_APP__LOG("[ERROR] Parser benchmark message build failed\r\n");
+  }
+
+  return retStatus;
+}
+
+#ifndef LOCAL_SERVER_FEATURE
+/**
+ * @implements lBenchmarkCommExchange
+ *
+ */
+static TKStatus lBenchmarkCommExchange
+(
+  void*           xpArg,
+  const uint8_t*  xpMsgToSend,
+  size_t          xSendSize,
+  uint8_t*        xpRecvMsg,
+  size_t*         xpRecvMsgSize
+)
+{
+  TCommIfStatus  commStatus = E_COMM_IF_STATUS_ERROR;
+
+  (void)xpArg;
+  commStatus = commMsgExchange(xpMsgToSend, xSendSize, xpRecvMsg, xpRecvMsgSize);
+
+  return (E_COMM_IF_STATUS_OK == commStatus) ? E_K_STATUS_OK : E_K_STATUS_ERROR;
+}
+#endif /* LOCAL_SERVER_FEATURE */
+
+#endif /* BENCHMARK_FEATURE */
+
+/* -------------------------------------------------------------------------- */
+/* END OF FILE                                                                */
+/* -------------------------------------------------------------------------- */
@@ -0,0 +1,210 @@
+/*******************************************************************************
+*************************keySTREAM Trusted Agent ("KTA")************************
+
+* (c) 2023-2025 Nagravision Sàrl
+
+* Subject to your compliance with these terms, you may use the Nagravision Sàrl
+* Software and any derivatives exclusively with Nagravision's products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may accompany
+* Nagravision Software.
+
+* Redistribution of this Nagravision Software in source or binary form is allowed
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+
+* THIS SOFTWARE IS SUPPLIED BY NAGRAVISION "AS IS". NO WARRANTIES, WHETHER EXPRESS,
+* IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF
+* NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE. IN NO
+* EVENT WILL NAGRAVISION BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL
+* OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF NAGRAVISION HAS BEEN ADVISED OF THE
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW,
+* NAGRAVISION 'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS
+* SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY
+* TO NAGRAVISION FOR THIS SOFTWARE.
+********************************************************************************/
+/** \brief  keySTREAM Trusted Agent - Benchmark of the provisioning handshake.
+ *
+ *  \author Kudelski IoT
+ *
+ *  \date 2026/10/17
+ *
+ *  \file ktaBenchmark.h
+ ******************************************************************************/
+
+/**
+ * @brief     Interface apis for benchmarking the provisioning handshake.
+ * @ingroup   g_kta_hook
+ */
+/** @addtogroup g_kta_hook
+ * @{
+ */
+
+#ifndef K_KTA_BENCHMARK_H
+#define K_KTA_BENCHMARK_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* C++ */
+
+/* --------------------------------------------------------------------------------------------- */
+/* IMPORTS                                                                                       */
+/* --------------------------------------------------------------------------------------------- */
+#include <stddef.h>
+#include <stdint.h>
+#include "k_defs.h"
+#include "k_kta.h"
+
+#ifdef BENCHMARK_FEATURE
+/* --------------------------------------------------------------------------------------------- */
+/* CONSTANTS, TYPES, ENUM                                                                        */
+/* --------------------------------------------------------------------------------------------- */
+/** @brief Maximum number of messages exchanged in one handshake before giving up. */
+#define C_KTA_BENCHMARK__MAX_EXCHANGES           (64u)
+
+/**
+ * @brief
+ *   Transport used to exchange one message with the keySTREAM peer, same signature
+ *   as TKtaFleetExchange.
+ *
+ * @param[in] xpArg
+ *   Argument given in TKtaBenchmarkConfig.
+ * @param[in] xpMsgToSend
+ *   Message to send to keySTREAM.
+ * @param[in] xSendSize
+ *   Size of xpMsgToSend, in bytes.
+ * @param[in,out] xpRecvMsg
+ *   Buffer receiving the keySTREAM response.
+ * @param[in,out] xpRecvMsgSize
+ *   [in] Size of xpRecvMsg.
+ *   [out] Size of the response.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_ERROR for other errors.
+ */
+typedef TKStatus (*TKtaBenchmarkExchange)
+(
+  void*           xpArg,
+  const uint8_t*  xpMsgToSend,
+  size_t          xSendSize,
+  uint8_t*        xpRecvMsg,
+  size_t*         xpRecvMsgSize
+);
+
+/** @brief Benchmark configuration. */
+typedef struct
+{
+  const uint8_t*         pL1SegSeed;
+  /* L1 segmentation seed, C_K__L1_SEGMENTATION_SEED_SIZE bytes. */
+  const uint8_t*         pContextProfileUid;
+  /* Context profile uid. */
+  size_t                 contextProfileUidLen;
+  /* Length of pContextProfileUid. */
+  const uint8_t*         pContextSerialNum;
+  /* Context serial number. */
+  size_t                 contextSerialNumLen;
+  /* Length of pContextSerialNum. */
+  const uint8_t*         pContextVersion;
+  /* Context version. */
+  size_t                 contextVersionLen;
+  /* Length of pContextVersion. */
+  const uint8_t*         pDeviceProfilePublicUid;
+  /* Device profile public uid. */
+  size_t                 deviceProfilePublicUidLen;
+  /* Length of pDeviceProfilePublicUid. */
+  const uint8_t*         pDeviceSerialNum;
+  /* Device serial number. */
+  size_t                 deviceSerialNumLen;
+  /* Length of pDeviceSerialNum. */
+  uint32_t               iterations;
+  /* Number of full handshakes to run. */
+  TKtaBenchmarkExchange  exchange;
+  /* Transport to the keySTREAM peer, NULL for the default one. */
+  void*                  pExchangeArg;
+  /* Transport argument. */
+} TKtaBenchmarkConfig;
+
+/* --------------------------------------------------------------------------------------------- */
+/* VARIABLES                                                                                     */
+/* --------------------------------------------------------------------------------------------- */
+
+/* --------------------------------------------------------------------------------------------- */
+/* FUNCTIONS                                                                                     */
+/* --------------------------------------------------------------------------------------------- */
+/**
+ * @ingroup g_kta_hook
+ * @brief
+ *   Run the provisioning handshake of one device several times and record the time
+ *   spent in each phase (see KTABench.h).
+ *   Every iteration uses a fresh keySTREAM Trusted Agent context whose life cycle state
+ *   is reset in storage, then goes through ktaStartup, ktaSetDeviceInformation and the
+ *   SEALED, ACTIVATED and PROVISIONED transitions of ktaExchangeMessage.
+ *   Previously recorded samples are discarded.
+ *
+ * @param[in] xpConfig
+ *   Benchmark configuration. If exchange is NULL, ktaLocalServerExchange() is used when
+ *   LOCAL_SERVER_FEATURE is defined (ktaLocalServerInit() must have been called), the
+ *   communication stack otherwise.
+ *   Should not be NULL.
+ * @param[out] xpCompleted
+ *   Number of iterations which reached the end of the handshake.
+ *   Should not be NULL.
+ *
+ * @return
+ * - E_K_STATUS_OK if all iterations completed.
+ * - E_K_STATUS_PARAMETER for wrong input parameter(s).
+ * - E_K_STATUS_ERROR if at least one iteration failed.
+ */
+TKStatus ktaBenchmarkRun
+(
+  const TKtaBenchmarkConfig*  xpConfig,
+  uint32_t*                   xpCompleted
+);
+
+/**
+ * @ingroup g_kta_hook
+ * @brief
+ *   Deserialize a canned clear ICPP message, one full command set of object
+ *   management commands, and serialize it back several times, recording the time of
+ *   each round in E_KTABENCH_PHASE_PARSE.
+ *   No key or storage is needed, command processing itself is measured by
+ *   ktaBenchmarkRun() in E_KTABENCH_PHASE_COMMAND.
+ *   Previously recorded samples are discarded.
+ *
+ * @param[in] xIterations
+ *   Number of rounds to run.
+ *
+ * @return
+ * - E_K_STATUS_OK if all rounds completed.
+ * - E_K_STATUS_PARAMETER for wrong input parameter(s).
+ * - E_K_STATUS_ERROR if at least one round failed.
+ */
+TKStatus ktaBenchmarkParserRun
+(
+  uint32_t  xIterations
+);
+
+/**
+ * @ingroup g_kta_hook
+ * @brief
+ *   Print the p50/p99 latency and CPU time of every phase with C_KTA_APP__LOG.
+ */
+void ktaBenchmarkPrintReport
+(
+  void
+);
+#endif /* BENCHMARK_FEATURE */
+
+#ifdef __cplusplus
+}
+#endif /* C++ */
+
+/** @} g_kta_hook */
+
+#endif // K_KTA_BENCHMARK_H
+
+/* -------------------------------------------------------------------------- */
+/* END OF FILE                                                                */
+/* -------------------------------------------------------------------------- */
@@ -237,6 +237,9 @@ TKStatus ktaKeyStreamFieldMgmt
 )
 {
   TKStatus  retStatus = E_K_STATUS_ERROR;
+#ifdef KEY_PAIR_POOL_FEATURE
+  uint32_t  poolReadyCount = 0;
+#endif
 
   C_KTA_APP__LOG("[INFO] ktaKeyStreamFieldMgmt Start\r\n");
 
@@ -276,6 +279,18 @@ TKStatus ktaKeyStreamFieldMgmt
     gKtaInitialized = 0;
   }
 
+#ifdef KEY_PAIR_POOL_FEATURE
+  /* The exchange is over, replace the key pairs it consumed while idle. */
+  if (E_K_STATUS_OK == ktaKeyPairPoolRefill(C_KTA_APP__KEY_PAIR_POOL_SIZE, &poolReadyCount))
+  {
+    C_KTA_APP__LOG("[INFO] Key pair pool holds %u key pairs\r\n", (unsigned int)poolReadyCount);
+  }
+  else
+  {
+    C_KTA_APP__LOG("[WARN] ktaKeyPairPoolRefill failed\r\n");
+  }
+#endif /* KEY_PAIR_POOL_FEATURE */
+
   goto end;
 
 end:
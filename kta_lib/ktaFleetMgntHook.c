@@ -0,0 +1,564 @@
+/*******************************************************************************
+*************************keySTREAM Trusted Agent ("KTA")************************
+
+* (c) 2023-2025 Nagravision Sàrl
+
+* Subject to your compliance with these terms, you may use the Nagravision Sàrl
+* Software and any derivatives exclusively with Nagravision's products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may accompany
+* Nagravision Software.
+
+* Redistribution of this Nagravision Software in source or binary form is allowed
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+
+* THIS SOFTWARE IS SUPPLIED BY NAGRAVISION "AS IS". NO WARRANTIES, WHETHER EXPRESS,
+* IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF
+* NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE. IN NO
+* EVENT WILL NAGRAVISION BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL
+* OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF NAGRAVISION HAS BEEN ADVISED OF THE
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW,
+* NAGRAVISION 'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS
+* SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY
+* TO NAGRAVISION FOR THIS SOFTWARE.
+********************************************************************************/
+/** \brief  keySTREAM Trusted Agent - Hook for onboarding a fleet of devices
+ *          from one gateway process.
+ *
+ *  \author Kudelski IoT
+ *
+ *  \date 2026/10/17
+ *
+ *  \file ktaFleetMgntHook.c
+ ******************************************************************************/
+/**
+ * @brief   keySTREAM Trusted Agent - Hook for fleet onboarding.
+ */
+
+#include "ktaFleetMgntHook.h"
+/* -------------------------------------------------------------------------- */
+/* IMPORTS                                                                    */
+/* -------------------------------------------------------------------------- */
+#include "k_kta.h"
+#include "ktaConfig.h"
+
+#ifdef FLEET_MANAGEMENT_FEATURE
+#include "comm_if.h"
+#include "cryptoConfig.h"
+#include "mbedtls/build_info.h"
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <string.h>
+
+#if (C_KTA_APP__MAX_CONTEXTS < 2u)
+#error "FLEET_MANAGEMENT_FEATURE requires C_KTA_APP__MAX_CONTEXTS greater than 1"
+#endif
+
+#if !defined(MBEDTLS_THREADING_C) || !defined(MBEDTLS_THREADING_PTHREAD)
+#error "FLEET_MANAGEMENT_FEATURE requires a thread safe PSA crypto, MBEDTLS_THREADING_C and MBEDTLS_THREADING_PTHREAD"
+#endif
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL CONSTANTS, TYPES, ENUM                                               */
+/* -------------------------------------------------------------------------- */
+/** @brief Number of device slots, context 0 stays reserved for the single device API. */
+#define C_KTA_FLEET__MAX_SLOTS    (C_KTA_APP__MAX_CONTEXTS - 1u)
+
+/** @brief Device in flight, bound to one keySTREAM Trusted Agent context. */
+typedef struct
+{
+  TKtaContext*      pContext;
+  /* Context allocated to the device. */
+  TKtaFleetDevice*  pDevice;
+  /* Device driven through this slot. */
+  uint8_t           aKs2KtaMsg[C_K__ICPP_MSG_MAX_SIZE];
+  /* Last message received from keySTREAM. */
+  size_t            ks2KtaMsgSize;
+  /* Size of aKs2KtaMsg. */
+} TKtaFleetSlot;
+
+/** @brief Fleet engine shared by the worker threads. */
+typedef struct
+{
+  pthread_mutex_t    lock;
+  /* Protects the fields below and the context allocation. */
+  pthread_cond_t     ready;
+  /* Signaled when a slot is queued or released. */
+  TKtaFleetDevice*   pDevices;
+  /* Devices to onboard. */
+  size_t             deviceCount;
+  /* Number of devices. */
+  size_t             nextDevice;
+  /* Index of the next device to admit. */
+  uint32_t           activeCount;
+  /* Number of slots in flight. */
+  uint32_t           aQueue[C_KTA_FLEET__MAX_SLOTS];
+  /* Ring of slot indexes ready to run. */
+  uint32_t           queueHead;
+  /* Ring read index. */
+  uint32_t           queueCount;
+  /* Number of queued slots. */
+  TKtaFleetExchange  exchange;
+  /* Transport to keySTREAM. */
+  void*              pExchangeArg;
+  /* Transport argument. */
+} TKtaFleetEngine;
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL VARIABLES                                                            */
+/* -------------------------------------------------------------------------- */
+/** @brief  Device slots. */
+static TKtaFleetSlot gaFleetSlots[C_KTA_FLEET__MAX_SLOTS];
+
+/** @brief  Fleet engine. */
+static TKtaFleetEngine gFleetEngine;
+
+#ifndef C_K_COMM__CONCURRENT_EXCHANGES
+/** @brief  Serializes the default transport, the communication stack is single instance. */
+static pthread_mutex_t gFleetCommLock = PTHREAD_MUTEX_INITIALIZER;
+#endif /* C_K_COMM__CONCURRENT_EXCHANGES */
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL FUNCTIONS - PROTOTYPE                                                */
+/* -------------------------------------------------------------------------- */
+/**
+ * @brief
+ *   Worker thread, runs device steps until every device is done.
+ *
+ * @param[in] xpArg
+ *   Unused.
+ *
+ * @return
+ * - NULL.
+ */
+static void* lFleetWorker
+(
+  void*  xpArg
+);
+
+/**
+ * @brief
+ *   Admit pending devices into free slots. Called with the engine lock held.
+ */
+static void lFleetAdmit
+(
+  void
+);
+
+/**
+ * @brief
+ *   Run one step of the device state machine bound to a slot.
+ *
+ * @param[in,out] xpSlot
+ *   Slot to run.
+ *
+ * @return
+ * - true if the device reached a final state.
+ * - false if the slot has to be queued again.
+ */
+static bool lFleetStep
+(
+  TKtaFleetSlot*  xpSlot
+);
+
+/**
+ * @brief
+ *   Default transport, exchanges the message through the communication stack.
+ *
+ * @param[in] xpArg
+ *   Unused.
+ * @param[in] xpMsgToSend
+ *   Message to send to keySTREAM.
+ * @param[in] xSendSize
+ *   Size of xpMsgToSend, in bytes.
+ * @param[in,out] xpRecvMsg
+ *   Buffer receiving the keySTREAM response.
+ * @param[in,out] xpRecvMsgSize
+ *   [in] Size of xpRecvMsg.
+ *   [out] Size of the response.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_ERROR for other errors.
+ */
+static TKStatus lFleetCommExchange
+(
+  void*           xpArg,
+  const uint8_t*  xpMsgToSend,
+  size_t          xSendSize,
+  uint8_t*        xpRecvMsg,
+  size_t*         xpRecvMsgSize
+);
+
+/* -------------------------------------------------------------------------- */
+/* PUBLIC VARIABLES                                                           */
+/* -------------------------------------------------------------------------- */
+
+/* -------------------------------------------------------------------------- */
+/* PUBLIC FUNCTIONS - IMPLEMENTATION                                          */
+/* -------------------------------------------------------------------------- */
+/**
+ * @brief  implement ktaFleetOnboard
+ *
+ */
+/**
+ * SUPPRESS: MISRA_DEV_KTA_005 : misra_c2012_rule_15.4_violation
+ * SUPPRESS: MISRA_DEV_KTA_004 : misra_c2012_rule_15.1_violation
+ * Using goto for breaking during the error and return cases.
+ **/
+TKStatus ktaFleetOnboard
+(
+  TKtaFleetDevice*   xpDevices,
+  size_t             xDeviceCount,
+  uint32_t           xWorkerCount,
+  TKtaFleetExchange  xExchange,
+  void*              xpExchangeArg
+)
+{
+  pthread_t  aWorkers[C_KTA_FLEET__MAX_WORKERS];
+  uint32_t   startedCount = 0;
+  size_t     index = 0;
+  TKStatus   retStatus = E_K_STATUS_ERROR;
+  bool       isCommInitialized = false;
+
+  C_KTA_APP__LOG("[INFO] ktaFleetOnboard Start\r\n");
+
+  if ((NULL == xpDevices) || (0u == xDeviceCount) || (0u == xWorkerCount) ||
+      (C_KTA_FLEET__MAX_WORKERS < xWorkerCount))
+  {
+    C_KTA_APP__LOG("[ERROR] Invalid parameter\r\n");
+    retStatus = E_K_STATUS_PARAMETER;
+    goto end;
+  }
+
+  if (NULL == xExchange)
+  {
+    if (E_COMM_IF_STATUS_OK != commInit(C_K_COMM__SERVER_HOST,
+                                        C_K_COMM__SERVER_PORT,
+                                        (const uint8_t*)C_K_COMM__SERVER_URI))
+    {
+      C_KTA_APP__LOG("[ERROR] commInit failed\r\n");
+      goto end;
+    }
+
+    isCommInitialized = true;
+    xExchange = lFleetCommExchange;
+  }
+
+  for (index = 0; index < xDeviceCount; index++)
+  {
+    xpDevices[index].state = E_KTA_FLEET_DEVICE_STATE_PENDING;
+    xpDevices[index].status = E_K_STATUS_OK;
+    xpDevices[index].keyStreamStatus = E_K_KTA_KS_STATUS_NONE;
+    xpDevices[index].exchangeCount = 0;
+  }
+
+  (void)memset(&gFleetEngine, 0, sizeof(gFleetEngine));
+  (void)pthread_mutex_init(&gFleetEngine.lock, NULL);
+  (void)pthread_cond_init(&gFleetEngine.ready, NULL);
+  gFleetEngine.pDevices = xpDevices;
+  gFleetEngine.deviceCount = xDeviceCount;
+  gFleetEngine.exchange = xExchange;
+  gFleetEngine.pExchangeArg = xpExchangeArg;
+
+  (void)pthread_mutex_lock(&gFleetEngine.lock);
+  lFleetAdmit();
+  (void)pthread_mutex_unlock(&gFleetEngine.lock);
+
+  for (; startedCount < xWorkerCount; startedCount++)
+  {
+    if (0 != pthread_create(&aWorkers[startedCount], NULL, lFleetWorker, NULL))
+    {
+      C_KTA_APP__LOG("[WARN] Only %u workers started\r\n", (unsigned int)startedCount);
+      break;
+    }
+  }
+
+  if (0u == startedCount)
+  {
+    /* No worker could be started, drive the fleet from the calling thread. */
+    (void)lFleetWorker(NULL);
+  }
+
+  for (index = 0; index < startedCount; index++)
+  {
+    (void)pthread_join(aWorkers[index], NULL);
+  }
+
+  (void)pthread_cond_destroy(&gFleetEngine.ready);
+  (void)pthread_mutex_destroy(&gFleetEngine.lock);
+
+  retStatus = E_K_STATUS_OK;
+
+  for (index = 0; index < xDeviceCount; index++)
+  {
+    if (E_KTA_FLEET_DEVICE_STATE_DONE != xpDevices[index].state)
+    {
+      retStatus = E_K_STATUS_ERROR;
+    }
+  }
+
+end:
+  if (isCommInitialized && (E_COMM_IF_STATUS_OK != commTerm()))
+  {
+    C_KTA_APP__LOG("[FAIL] Communication Stack Termination failed \r\n");
+    retStatus = E_K_STATUS_ERROR;
+  }
+
+  C_KTA_APP__LOG("[INFO] ktaFleetOnboard end, status[%d]\r\n", retStatus);
+  return retStatus;
+}
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL FUNCTIONS - IMPLEMENTATION                                           */
+/* -------------------------------------------------------------------------- */
+/**
+ * @implements lFleetWorker
+ *
+ */
+static void* lFleetWorker
+(
+  void*  xpArg
+)
+{
+  uint32_t  slotIndex = 0;
+  bool      isFinal = false;
+
+  (void)xpArg;
+  (void)pthread_mutex_lock(&gFleetEngine.lock);
+
+  for (;;)
+  {
+    if (0u == gFleetEngine.queueCount)
+    {
+      if ((0u == gFleetEngine.activeCount) &&
+          (gFleetEngine.nextDevice >= gFleetEngine.deviceCount))
+      {
+        break;
+      }
+
+      (void)pthread_cond_wait(&gFleetEngine.ready, &gFleetEngine.lock);
+      continue;
+    }
+
+    slotIndex = gFleetEngine.aQueue[gFleetEngine.queueHead];
+    gFleetEngine.queueHead = (gFleetEngine.queueHead + 1u) % C_KTA_FLEET__MAX_SLOTS;
+    gFleetEngine.queueCount--;
+    (void)pthread_mutex_unlock(&gFleetEngine.lock);
+
+    isFinal = lFleetStep(&gaFleetSlots[slotIndex]);
+
+    (void)pthread_mutex_lock(&gFleetEngine.lock);
+
+    if (isFinal)
+    {
+      (void)ktaContextRelease(gaFleetSlots[slotIndex].pContext);
+      gaFleetSlots[slotIndex].pContext = NULL;
+      gaFleetSlots[slotIndex].pDevice = NULL;
+      gFleetEngine.activeCount--;
+      lFleetAdmit();
+      /* Wake up idle workers, either to run admitted devices or to exit. */
+      (void)pthread_cond_broadcast(&gFleetEngine.ready);
+    }
+    else
+    {
+      gFleetEngine.aQueue[(gFleetEngine.queueHead + gFleetEngine.queueCount) %
+                          C_KTA_FLEET__MAX_SLOTS] = slotIndex;
+      gFleetEngine.queueCount++;
+      (void)pthread_cond_signal(&gFleetEngine.ready);
+    }
+  }
+
+  (void)pthread_mutex_unlock(&gFleetEngine.lock);
+  return NULL;
+}
+
+/**
+ * @implements lFleetAdmit
+ *
+ */
+static void lFleetAdmit
+(
+  void
+)
+{
+  uint32_t      slotIndex = 0;
+  TKtaContext*  pContext = NULL;
+
+  for (; slotIndex < C_KTA_FLEET__MAX_SLOTS; slotIndex++)
+  {
+    if (gFleetEngine.nextDevice >= gFleetEngine.deviceCount)
+    {
+      break;
+    }
+
+    if (NULL != gaFleetSlots[slotIndex].pDevice)
+    {
+      continue;
+    }
+
+    if (E_K_STATUS_OK != ktaContextCreate(&pContext))
+    {
+      break;
+    }
+
+    gaFleetSlots[slotIndex].pContext = pContext;
+    gaFleetSlots[slotIndex].pDevice = &gFleetEngine.pDevices[gFleetEngine.nextDevice];
+    gaFleetSlots[slotIndex].ks2KtaMsgSize = 0;
+    gaFleetSlots[slotIndex].pDevice->state = E_KTA_FLEET_DEVICE_STATE_STARTUP;
+    gFleetEngine.nextDevice++;
+    gFleetEngine.activeCount++;
+
+    gFleetEngine.aQueue[(gFleetEngine.queueHead + gFleetEngine.queueCount) %
+                        C_KTA_FLEET__MAX_SLOTS] = slotIndex;
+    gFleetEngine.queueCount++;
+  }
+}
+
+/**
+ * @implements lFleetStep
+ *
+ */
+/**
+ * SUPPRESS: MISRA_DEV_KTA_005 : misra_c2012_rule_15.4_violation
+ * SUPPRESS: MISRA_DEV_KTA_004 : misra_c2012_rule_15.1_violation
+ * Using goto for breaking during the error and return cases.
+ **/
+static bool lFleetStep
+(
+  TKtaFleetSlot*  xpSlot
+)
+{
+  uint8_t           aKta2KsMsg[C_K__ICPP_MSG_MAX_SIZE];
+  size_t            kta2ksMsgSize = sizeof(aKta2KsMsg);
+  uint8_t           connectionReq = 0;
+  TKtaFleetDevice*  pDevice = xpSlot->pDevice;
+  TKStatus          retStatus = E_K_STATUS_ERROR;
+
+  /* Bind the device context to this worker for the whole step. */
+  retStatus = ktaContextSelect(xpSlot->pContext);
+
+  if (E_K_STATUS_OK != retStatus)
+  {
+    goto end;
+  }
+
+  if (E_KTA_FLEET_DEVICE_STATE_STARTUP == pDevice->state)
+  {
+    retStatus = ktaInitialize();
+
+    if (E_K_STATUS_OK != retStatus)
+    {
+      goto end;
+    }
+
+    retStatus = ktaStartup(pDevice->pL1SegSeed,
+                           pDevice->pContextProfileUid,
+                           pDevice->contextProfileUidLen,
+                           pDevice->pContextSerialNum,
+                           pDevice->contextSerialNumLen,
+                           pDevice->pContextVersion,
+                           pDevice->contextVersionLen);
+
+    if (E_K_STATUS_OK != retStatus)
+    {
+      goto end;
+    }
+
+    retStatus = ktaSetDeviceInformation(pDevice->pDeviceProfilePublicUid,
+                                        pDevice->deviceProfilePublicUidLen,
+                                        pDevice->pDeviceSerialNum,
+                                        pDevice->deviceSerialNumLen,
+                                        &connectionReq);
+
+    if (E_K_STATUS_OK != retStatus)
+    {
+      goto end;
+    }
+
+    pDevice->state = (1u == connectionReq) ? E_KTA_FLEET_DEVICE_STATE_EXCHANGE :
+                     E_KTA_FLEET_DEVICE_STATE_DONE;
+    goto end;
+  }
+
+  retStatus = ktaExchangeMessage(xpSlot->aKs2KtaMsg,
+                                 xpSlot->ks2KtaMsgSize,
+                                 aKta2KsMsg,
+                                 &kta2ksMsgSize);
+
+  if (E_K_STATUS_OK != retStatus)
+  {
+    goto end;
+  }
+
+  if (0u == kta2ksMsgSize)
+  {
+    retStatus = ktaKeyStreamStatus(&pDevice->keyStreamStatus);
+    pDevice->state = E_KTA_FLEET_DEVICE_STATE_DONE;
+    goto end;
+  }
+
+  xpSlot->ks2KtaMsgSize = sizeof(xpSlot->aKs2KtaMsg);
+  retStatus = gFleetEngine.exchange(gFleetEngine.pExchangeArg,
+                                    aKta2KsMsg,
+                                    kta2ksMsgSize,
+                                    xpSlot->aKs2KtaMsg,
+                                    &xpSlot->ks2KtaMsgSize);
+
+  if ((E_K_STATUS_OK == retStatus) && (0u == xpSlot->ks2KtaMsgSize))
+  {
+    retStatus = E_K_STATUS_ERROR;
+  }
+
+  pDevice->exchangeCount++;
+
+end:
+  pDevice->status = retStatus;
+
+  if (E_K_STATUS_OK != retStatus)
+  {
+    C_KTA_APP__LOG("[ERROR] Fleet device step failed, state[%d] status[%d]\r\n",
+                   pDevice->state, retStatus);
+    pDevice->state = E_KTA_FLEET_DEVICE_STATE_FAILED;
+  }
+
+  return ((E_KTA_FLEET_DEVICE_STATE_DONE == pDevice->state) ||
+          (E_KTA_FLEET_DEVICE_STATE_FAILED == pDevice->state));
+}
+
+/**
+ * @implements lFleetCommExchange
+ *
+ */
+static TKStatus lFleetCommExchange
+(
+  void*           xpArg,
+  const uint8_t*  xpMsgToSend,
+  size_t          xSendSize,
+  uint8_t*        xpRecvMsg,
+  size_t*         xpRecvMsgSize
+)
+{
+  TCommIfStatus  commStatus = E_COMM_IF_STATUS_ERROR;
+
+  (void)xpArg;
+#ifdef C_K_COMM__CONCURRENT_EXCHANGES
+  /* The devices exchanges share the socket, routed by CoAP token. */
+  commStatus = commMsgExchange(xpMsgToSend, xSendSize, xpRecvMsg, xpRecvMsgSize);
+#else
+  (void)pthread_mutex_lock(&gFleetCommLock);
+  commStatus = commMsgExchange(xpMsgToSend, xSendSize, xpRecvMsg, xpRecvMsgSize);
+  (void)pthread_mutex_unlock(&gFleetCommLock);
+#endif /* C_K_COMM__CONCURRENT_EXCHANGES */
+
+  return (E_COMM_IF_STATUS_OK == commStatus) ? E_K_STATUS_OK : E_K_STATUS_ERROR;
+}
+
+#endif /* FLEET_MANAGEMENT_FEATURE */
+
+/* -------------------------------------------------------------------------- */
+/* END OF FILE                                                                */
+/* -------------------------------------------------------------------------- */
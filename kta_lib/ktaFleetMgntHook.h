@@ -0,0 +1,211 @@
+/*******************************************************************************
+*************************keySTREAM Trusted Agent ("KTA")************************
+
+* (c) 2023-2025 Nagravision Sàrl
+
+* Subject to your compliance with these terms, you may use the Nagravision Sàrl
+* Software and any derivatives exclusively with Nagravision's products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may accompany
+* Nagravision Software.
+
+* Redistribution of this Nagravision Software in source or binary form is allowed
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+
+* THIS SOFTWARE IS SUPPLIED BY NAGRAVISION "AS IS". NO WARRANTIES, WHETHER EXPRESS,
+* IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF
+* NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE. IN NO
+* EVENT WILL NAGRAVISION BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL
+* OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF NAGRAVISION HAS BEEN ADVISED OF THE
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW,
+* NAGRAVISION 'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS
+* SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY
+* TO NAGRAVISION FOR THIS SOFTWARE.
+********************************************************************************/
+/** \brief  keySTREAM Trusted Agent - Hook for onboarding a fleet of devices
+ *          from one gateway process.
+ *
+ *  \author Kudelski IoT
+ *
+ *  \date 2026/10/17
+ *
+ *  \file ktaFleetMgntHook.h
+ ******************************************************************************/
+
+/**
+ * @brief     Interface apis for fleet onboarding.
+ * @ingroup   g_kta_hook
+ */
+/** @addtogroup g_kta_hook
+ * @{
+ */
+
+#ifndef K_KTA_FLEET_HOOK_H
+#define K_KTA_FLEET_HOOK_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* C++ */
+
+/* --------------------------------------------------------------------------------------------- */
+/* IMPORTS                                                                                       */
+/* --------------------------------------------------------------------------------------------- */
+#include <stddef.h>
+#include <stdint.h>
+#include "k_defs.h"
+#include "k_kta.h"
+
+#ifdef FLEET_MANAGEMENT_FEATURE
+/* --------------------------------------------------------------------------------------------- */
+/* CONSTANTS, TYPES, ENUM                                                                        */
+/* --------------------------------------------------------------------------------------------- */
+/** @brief Maximum number of worker threads driving the fleet. */
+#define C_KTA_FLEET__MAX_WORKERS                 (32u)
+
+/** @brief Onboarding state of one device of the fleet. */
+typedef enum
+{
+  /**
+   * Device waits for a free keySTREAM Trusted Agent context.
+   */
+  E_KTA_FLEET_DEVICE_STATE_PENDING,
+  /**
+   * Context allocated, ktaInitialize/ktaStartup/ktaSetDeviceInformation to be called.
+   */
+  E_KTA_FLEET_DEVICE_STATE_STARTUP,
+  /**
+   * Device exchanges messages with keySTREAM.
+   */
+  E_KTA_FLEET_DEVICE_STATE_EXCHANGE,
+  /**
+   * Onboarding done, keyStreamStatus holds the last keySTREAM command status.
+   */
+  E_KTA_FLEET_DEVICE_STATE_DONE,
+  /**
+   * Onboarding failed, status holds the failing status.
+   */
+  E_KTA_FLEET_DEVICE_STATE_FAILED
+} TKtaFleetDeviceState;
+
+/** @brief Identity and onboarding result of one device of the fleet. */
+typedef struct
+{
+  const uint8_t*        pL1SegSeed;
+  /* L1 segmentation seed, C_K__L1_SEGMENTATION_SEED_SIZE bytes. */
+  const uint8_t*        pContextProfileUid;
+  /* Context profile uid. */
+  size_t                contextProfileUidLen;
+  /* Length of pContextProfileUid. */
+  const uint8_t*        pContextSerialNum;
+  /* Context serial number. */
+  size_t                contextSerialNumLen;
+  /* Length of pContextSerialNum. */
+  const uint8_t*        pContextVersion;
+  /* Context version. */
+  size_t                contextVersionLen;
+  /* Length of pContextVersion. */
+  const uint8_t*        pDeviceProfilePublicUid;
+  /* Device profile public uid. */
+  size_t                deviceProfilePublicUidLen;
+  /* Length of pDeviceProfilePublicUid. */
+  const uint8_t*        pDeviceSerialNum;
+  /* Device serial number. */
+  size_t                deviceSerialNumLen;
+  /* Length of pDeviceSerialNum. */
+  TKtaFleetDeviceState  state;
+  /* [out] Onboarding state. */
+  TKStatus              status;
+  /* [out] Status of the last step. */
+  TKktaKeyStreamStatus  keyStreamStatus;
+  /* [out] Command status received from keySTREAM. */
+  uint32_t              exchangeCount;
+  /* [out] Number of messages exchanged with keySTREAM. */
+} TKtaFleetDevice;
+
+/**
+ * @brief
+ *   Transport used to exchange one message with keySTREAM on behalf of a device.
+ *   Called concurrently from several worker threads.
+ *
+ * @param[in] xpArg
+ *   Argument given to ktaFleetOnboard().
+ * @param[in] xpMsgToSend
+ *   Message to send to keySTREAM.
+ * @param[in] xSendSize
+ *   Size of xpMsgToSend, in bytes.
+ * @param[in,out] xpRecvMsg
+ *   Buffer receiving the keySTREAM response.
+ * @param[in,out] xpRecvMsgSize
+ *   [in] Size of xpRecvMsg.
+ *   [out] Size of the response.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_ERROR for other errors.
+ */
+typedef TKStatus (*TKtaFleetExchange)
+(
+  void*           xpArg,
+  const uint8_t*  xpMsgToSend,
+  size_t          xSendSize,
+  uint8_t*        xpRecvMsg,
+  size_t*         xpRecvMsgSize
+);
+
+/* --------------------------------------------------------------------------------------------- */
+/* VARIABLES                                                                                     */
+/* --------------------------------------------------------------------------------------------- */
+
+/* --------------------------------------------------------------------------------------------- */
+/* FUNCTIONS                                                                                     */
+/* --------------------------------------------------------------------------------------------- */
+/**
+ * @ingroup g_kta_hook
+ * @brief
+ *   Hook API for onboarding a fleet of devices.
+ *   Each device runs its own activation, registration and provisioning state machine in its
+ *   own keySTREAM Trusted Agent context. Up to C_KTA_APP__MAX_CONTEXTS - 1 devices are in
+ *   flight at a time; every step of a device (startup or one message exchange) is scheduled on
+ *   the worker pool, so that devices waiting on the network do not block the others.
+ *
+ * @param[in,out] xpDevices
+ *   Devices to onboard, their state and status fields are updated.
+ *   Should not be NULL.
+ * @param[in] xDeviceCount
+ *   Number of devices in xpDevices.
+ * @param[in] xWorkerCount
+ *   Number of worker threads, from 1 to C_KTA_FLEET__MAX_WORKERS.
+ * @param[in] xExchange
+ *   Transport to keySTREAM. If NULL, the communication stack is used and its exchanges
+ *   are serialized.
+ * @param[in] xpExchangeArg
+ *   Argument passed to xExchange.
+ *
+ * @return
+ * - E_K_STATUS_OK if all devices reached E_KTA_FLEET_DEVICE_STATE_DONE.
+ * - E_K_STATUS_PARAMETER for wrong input parameter(s).
+ * - E_K_STATUS_ERROR if at least one device failed.
+ */
+TKStatus ktaFleetOnboard
+(
+  TKtaFleetDevice*   xpDevices,
+  size_t             xDeviceCount,
+  uint32_t           xWorkerCount,
+  TKtaFleetExchange  xExchange,
+  void*              xpExchangeArg
+);
+#endif /* FLEET_MANAGEMENT_FEATURE */
+
+#ifdef __cplusplus
+}
+#endif /* C++ */
+
+/** @} g_kta_hook */
+
+#endif // K_KTA_FLEET_HOOK_H
+
+/* -------------------------------------------------------------------------- */
+/* END OF FILE                                                                */
+/* -------------------------------------------------------------------------- */
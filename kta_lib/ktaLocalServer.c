@@ -0,0 +1,1788 @@
+/*******************************************************************************
+*************************keySTREAM Trusted Agent ("KTA")************************
+
+* (c) 2023-2025 Nagravision Sàrl
+
+* Subject to your compliance with these terms, you may use the Nagravision Sàrl
+* Software and any derivatives exclusively with Nagravision's products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may accompany
+* Nagravision Software.
+
+* Redistribution of this Nagravision Software in source or binary form is allowed
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+
+* THIS SOFTWARE IS SUPPLIED BY NAGRAVISION "AS IS". NO WARRANTIES, WHETHER EXPRESS,
+* IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF
+* NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE. IN NO
+* EVENT WILL NAGRAVISION BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL
+* OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF NAGRAVISION HAS BEEN ADVISED OF THE
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW,
+* NAGRAVISION 'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS
+* SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY
+* TO NAGRAVISION FOR THIS SOFTWARE.
+********************************************************************************/
+/** \brief  keySTREAM Trusted Agent - Loopback keySTREAM stand-in.
+ *
+ *  \author Kudelski IoT
+ *
+ *  \date 2026/10/17
+ *
+ *  \file ktaLocalServer.c
+ ******************************************************************************/
+/**
+ * @brief   keySTREAM Trusted Agent - Local keySTREAM stand-in answering ICPP messages.
+ */
+
+#include "ktaLocalServer.h"
+/* -------------------------------------------------------------------------- */
+/* IMPORTS                                                                    */
+/* -------------------------------------------------------------------------- */
+#include "k_kta.h"
+#include "ktaConfig.h"
+
+#ifdef LOCAL_SERVER_FEATURE
+#include "comm_if.h"
+#include "cryptoConfig.h"
+#include "icpp_parser.h"
+#include "k_crypto.h"
+#include "k_sal.h"
+#include "psa/crypto.h"
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <string.h>
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL CONSTANTS, TYPES, ENUM                                               */
+/* -------------------------------------------------------------------------- */
+/** @brief Size of a PSA exported public key, 0x04 || x || y. */
+#define C_KTA_LOCAL_SERVER__PSA_PUBLIC_KEY_SIZE  (C_K_KTA__PUBLIC_KEY_MAX_SIZE + 1u)
+
+/** @brief Size of a secp256r1 key, in bits. */
+#define C_KTA_LOCAL_SERVER__ECC_KEY_BITS         (256u)
+
+/** @brief Size of the L1 key, in bits. */
+#define C_KTA_LOCAL_SERVER__L1_KEY_BITS          (256u)
+
+/** @brief Size of the L2 keys, in bytes. */
+#define C_KTA_LOCAL_SERVER__L2_KEY_SIZE          (16u)
+
+/** @brief Size of a full HMAC-SHA256, in bytes. */
+#define C_KTA_LOCAL_SERVER__SHA256_SIZE          (32u)
+
+/** @brief Size of the identifier field, in bytes. */
+#define C_KTA_LOCAL_SERVER__IDENTIFIER_SIZE      (4u)
+
+/** @brief Position of the device counter in an allocated rot public uid. */
+#define C_KTA_LOCAL_SERVER__UID_COUNTER_POS      (4u)
+
+/** @brief Offset of the crypto version and message type byte in the ICPP header. */
+#define C_KTA_LOCAL_SERVER__MSG_TYPE_INDEX       (1u)
+
+/** @brief Offset of the rot public uid in the ICPP header. */
+#define C_KTA_LOCAL_SERVER__ROT_ID_INDEX         (10u)
+
+/** @brief Offset of the length in the ICPP header. */
+#define C_KTA_LOCAL_SERVER__LENGTH_INDEX         (19u)
+
+/** @brief Smallest answer buffer: header, one padded block and the MAC. */
+#define C_KTA_LOCAL_SERVER__MIN_RESPONSE_SIZE    \
+  (C_K_ICPP_PARSER__HEADER_SIZE + C_K_CRYPTO__AES_BLOCK_SIZE + C_K_KTA__HMAC_MAX_SIZE)
+
+/** @brief Session state of one device. */
+typedef enum
+{
+  /**
+   * Slot not used.
+   */
+  E_KTA_LOCAL_SERVER_SESSION_FREE,
+  /**
+   * Activation answered, registration expected.
+   */
+  E_KTA_LOCAL_SERVER_SESSION_REGISTRATION,
+  /**
+   * Registered, configured commands being pushed.
+   */
+  E_KTA_LOCAL_SERVER_SESSION_PROVISIONING,
+  /**
+   * All commands done, NoOp answered.
+   */
+  E_KTA_LOCAL_SERVER_SESSION_PROVISIONED
+} TKtaLocalServerSessionState;
+
+/** @brief Server side view of one device. */
+typedef struct
+{
+  TKtaLocalServerSessionState  state;
+  /* Session state. */
+  uint8_t                      aRotPublicUid[C_K_ICPP_PARSER__ROT_PUBLIC_UID_SIZE_IN_BYTES];
+  /* Rot public uid of the device. */
+  psa_key_id_t                 encKeyId;
+  /* L2 encryption key, activation or field. */
+  psa_key_id_t                 authKeyId;
+  /* L2 authentication key, activation or field. */
+  size_t                       nextCommand;
+  /* Index of the next command to push. */
+  uint32_t                     pendingTag;
+  /* Tag of the command waiting for its response, 0 if none. */
+  uint32_t                     lastUse;
+  /* Use stamp, for eviction. */
+  bool                         isBusy;
+  /* A message of this device is being processed. */
+} TKtaLocalServerSession;
+
+/** @brief Local server shared by the transports. */
+typedef struct
+{
+  pthread_mutex_t         lock;
+  /* Protects the fields below, key material excepted. */
+  bool                    isInitialized;
+  /* ktaLocalServerInit succeeded. */
+  TKtaLocalServerConfig   config;
+  /* Server configuration. */
+  uint8_t                 aChipPublicKey[C_K_KTA__PUBLIC_KEY_MAX_SIZE];
+  /* Configured chip public key. */
+  uint8_t                 aL1SegSeed[C_K__L1_SEGMENTATION_SEED_SIZE];
+  /* L1 segmentation seed. */
+  psa_key_id_t            ksDosKeyId;
+  /* keySTREAM DOS secret key. */
+  psa_key_id_t            ksKeyId;
+  /* keySTREAM secret key. */
+  uint32_t                uidCounter;
+  /* Last allocated device number. */
+  uint32_t                useCounter;
+  /* Session use stamp. */
+  TKtaLocalServerStats    stats;
+  /* Counters. */
+  TKtaLocalServerSession  aSessions[C_KTA_LOCAL_SERVER__MAX_SESSIONS];
+  /* Device sessions. */
+} TKtaLocalServer;
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL VARIABLES                                                            */
+/* -------------------------------------------------------------------------- */
+/** @brief  Local server. */
+static TKtaLocalServer gLocalServer = { .lock = PTHREAD_MUTEX_INITIALIZER };
+
+/** @brief  Initialization vector of the ICPP AES-CBC encryption. */
+static const uint8_t gaLocalServerIv[C_K_CRYPTO__AES_BLOCK_SIZE] =
+{
+  0xA9, 0x32, 0x30, 0x31, 0x38, 0x4E, 0x61, 0x67,
+  0x72, 0x61, 0x76, 0x69, 0x73, 0x69, 0x6F, 0x6E
+};
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL FUNCTIONS - PROTOTYPE                                                */
+/* -------------------------------------------------------------------------- */
+/**
+ * @brief
+ *   Answer an activation request (DOS based) and switch the session to the field keys.
+ *
+ * @param[in] xpRequest
+ *   Activation request.
+ * @param[in] xRequestSize
+ *   Size of xpRequest.
+ * @param[in,out] xpResponse
+ *   Buffer receiving the activation response.
+ * @param[in,out] xpResponseSize
+ *   [in] Size of xpResponse.
+ *   [out] Size of the activation response.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_ERROR for other errors.
+ */
+static TKStatus lLocalServerActivate
+(
+  const uint8_t*  xpRequest,
+  size_t          xRequestSize,
+  uint8_t*        xpResponse,
+  size_t*         xpResponseSize
+);
+
+/**
+ * @brief
+ *   Answer a message protected by the field keys with the next command or a NoOp.
+ *
+ * @param[in] xpRequest
+ *   Registration request, command response or NoOp notification.
+ * @param[in] xRequestSize
+ *   Size of xpRequest.
+ * @param[in,out] xpResponse
+ *   Buffer receiving the answer.
+ * @param[in,out] xpResponseSize
+ *   [in] Size of xpResponse.
+ *   [out] Size of the answer.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_ERROR for other errors.
+ */
+static TKStatus lLocalServerProceed
+(
+  const uint8_t*  xpRequest,
+  size_t          xRequestSize,
+  uint8_t*        xpResponse,
+  size_t*         xpResponseSize
+);
+
+/**
+ * @brief
+ *   Find the session of a device and mark it busy.
+ *   For an activation, a new session is allocated when none exists and a rot public uid is
+ *   assigned when the device has none.
+ *
+ * @param[in] xpRotPublicUid
+ *   Rot public uid found in the request header.
+ * @param[in] xIsActivation
+ *   true for an activation request.
+ *
+ * @return
+ * - The busy session, NULL if none.
+ */
+static TKtaLocalServerSession* lLocalServerAcquire
+(
+  const uint8_t*  xpRotPublicUid,
+  bool            xIsActivation
+);
+
+/**
+ * @brief
+ *   Release a session acquired with lLocalServerAcquire().
+ *
+ * @param[in,out] xpSession
+ *   Session to release.
+ */
+static void lLocalServerRelease
+(
+  TKtaLocalServerSession*  xpSession
+);
+
+/**
+ * @brief
+ *   Destroy the L2 keys of a session.
+ *
+ * @param[in,out] xpSession
+ *   Session owning the keys.
+ */
+static void lLocalServerDestroyKeys
+(
+  TKtaLocalServerSession*  xpSession
+);
+
+/**
+ * @brief
+ *   Increment one counter of the server.
+ *
+ * @param[in,out] xpCounter
+ *   Counter in gLocalServer.stats.
+ */
+static void lLocalServerCount
+(
+  uint32_t*  xpCounter
+);
+
+/**
+ * @brief
+ *   Import a keySTREAM secret key and check it against the expected public key.
+ *
+ * @param[in] xpSecretKey
+ *   Secret key, C_KTA_LOCAL_SERVER__SECRET_KEY_SIZE bytes.
+ * @param[in] xpExpectedPublicKey
+ *   Public key the keySTREAM Trusted Agent is built with (x || y).
+ * @param[out] xpKeyId
+ *   Imported key.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_PARAMETER if the keys do not match.
+ * - E_K_STATUS_ERROR for other errors.
+ */
+static TKStatus lLocalServerImportSecretKey
+(
+  const uint8_t*  xpSecretKey,
+  const uint8_t*  xpExpectedPublicKey,
+  psa_key_id_t*   xpKeyId
+);
+
+/**
+ * @brief
+ *   Get the chip public key, from the configuration or from the attestation token whose
+ *   challenge is the chip public key.
+ *
+ * @param[in] xpCommand
+ *   Activation command.
+ * @param[out] xpChipPublicKey
+ *   Chip public key (x || y).
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_ERROR if not found.
+ */
+static TKStatus lLocalServerGetChipPublicKey
+(
+  const TKIcppCommand*  xpCommand,
+  uint8_t*              xpChipPublicKey
+);
+
+/**
+ * @brief
+ *   Compute an ECDH shared secret.
+ *
+ * @param[in] xKeyId
+ *   Own secret key.
+ * @param[in] xpPeerPublicKey
+ *   Peer public key (x || y).
+ * @param[out] xpSharedSecret
+ *   Shared secret, C_K_KTA__SHARED_SECRET_KEY_MAX_SIZE bytes.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_ERROR for other errors.
+ */
+static TKStatus lLocalServerEcdh
+(
+  psa_key_id_t    xKeyId,
+  const uint8_t*  xpPeerPublicKey,
+  uint8_t*        xpSharedSecret
+);
+
+/**
+ * @brief
+ *   Derive the L1 key with HKDF-SHA256, then the L2 keys of a session from it.
+ *
+ * @param[in] xpSecret
+ *   HKDF secret.
+ * @param[in] xSecretLen
+ *   Length of xpSecret.
+ * @param[in] xpSalt
+ *   HKDF salt.
+ * @param[in] xSaltLen
+ *   Length of xpSalt.
+ * @param[in] xpInfo
+ *   HKDF info.
+ * @param[in] xInfoLen
+ *   Length of xpInfo.
+ * @param[in] xIsActivation
+ *   true for the activation L2 keys, false for the field L2 keys.
+ * @param[in,out] xpSession
+ *   Session receiving the L2 keys, previous keys are destroyed.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_ERROR for other errors.
+ */
+static TKStatus lLocalServerDeriveKeys
+(
+  const uint8_t*           xpSecret,
+  size_t                   xSecretLen,
+  const uint8_t*           xpSalt,
+  size_t                   xSaltLen,
+  const uint8_t*           xpInfo,
+  size_t                   xInfoLen,
+  bool                     xIsActivation,
+  TKtaLocalServerSession*  xpSession
+);
+
+/**
+ * @brief
+ *   Compute the truncated HMAC-SHA256 of a message.
+ *
+ * @param[in] xKeyId
+ *   L2 authentication key.
+ * @param[in] xpData
+ *   Data to sign.
+ * @param[in] xDataLen
+ *   Length of xpData.
+ * @param[out] xpMac
+ *   MAC, C_K_KTA__HMAC_MAX_SIZE bytes.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_ERROR for other errors.
+ */
+static TKStatus lLocalServerSign
+(
+  psa_key_id_t    xKeyId,
+  const uint8_t*  xpData,
+  size_t          xDataLen,
+  uint8_t*        xpMac
+);
+
+/**
+ * @brief
+ *   AES-128-CBC encryption or decryption with the ICPP initialization vector.
+ *
+ * @param[in] xKeyId
+ *   L2 encryption key.
+ * @param[in] xIsEncrypt
+ *   true to encrypt, false to decrypt.
+ * @param[in] xpInput
+ *   Input data, multiple of C_K_CRYPTO__AES_BLOCK_SIZE.
+ * @param[in] xInputLen
+ *   Length of xpInput.
+ * @param[out] xpOutput
+ *   Output data, xInputLen bytes, should not overlap xpInput.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_ERROR for other errors.
+ */
+static TKStatus lLocalServerCipher
+(
+  psa_key_id_t    xKeyId,
+  bool            xIsEncrypt,
+  const uint8_t*  xpInput,
+  size_t          xInputLen,
+  uint8_t*        xpOutput
+);
+
+/**
+ * @brief
+ *   Verify the MAC of a received message, then decrypt its payload and remove the padding.
+ *
+ * @param[in] xpSession
+ *   Session holding the L2 keys.
+ * @param[in] xpRequest
+ *   Received message.
+ * @param[in] xRequestSize
+ *   Size of xpRequest.
+ * @param[out] xpPayload
+ *   Clear payload, C_K__ICPP_MSG_MAX_SIZE bytes.
+ * @param[out] xpPayloadSize
+ *   Size of the clear payload, 0 for a NoOp.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_ERROR for other errors.
+ */
+static TKStatus lLocalServerOpenMessage
+(
+  const TKtaLocalServerSession*  xpSession,
+  const uint8_t*                 xpRequest,
+  size_t                         xRequestSize,
+  uint8_t*                       xpPayload,
+  size_t*                        xpPayloadSize
+);
+
+/**
+ * @brief
+ *   Serialize, pad, encrypt and sign a message for a device.
+ *
+ * @param[in] xpSession
+ *   Session holding the L2 keys and the rot public uid.
+ * @param[in] xCryptoVersion
+ *   E_K_ICPP_PARSER_CRYPTO_TYPE_DOS_BASED or E_K_ICPP_PARSER_CRYPTO_TYPE_L2_BASED.
+ * @param[in,out] xpMessage
+ *   Commands to send, the header is filled.
+ * @param[out] xpResponse
+ *   Buffer receiving the message.
+ * @param[in,out] xpResponseSize
+ *   [in] Size of xpResponse.
+ *   [out] Size of the message.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_ERROR for other errors.
+ */
+static TKStatus lLocalServerBuildMessage
+(
+  const TKtaLocalServerSession*  xpSession,
+  uint8_t                        xCryptoVersion,
+  TKIcppProtocolMessage*         xpMessage,
+  uint8_t*                       xpResponse,
+  size_t*                        xpResponseSize
+);
+
+/**
+ * @brief
+ *   Fill an ICPP command from a configured command.
+ *
+ * @param[in] xpConfigCommand
+ *   Configured command.
+ * @param[out] xpIdentifier
+ *   Buffer carrying the serialized identifier, C_KTA_LOCAL_SERVER__IDENTIFIER_SIZE bytes.
+ * @param[out] xpCommand
+ *   ICPP command.
+ */
+static void lLocalServerSetCommand
+(
+  const TKtaLocalServerCommand*  xpConfigCommand,
+  uint8_t*                       xpIdentifier,
+  TKIcppCommand*                 xpCommand
+);
+
+/**
+ * @brief
+ *   Communication stack handler, forwards to ktaLocalServerExchange().
+ *
+ * @param[in] xpArg
+ *   Unused.
+ * @param[in] xpRecvMsg
+ *   Message received from the device.
+ * @param[in] xRecvSize
+ *   Size of xpRecvMsg.
+ * @param[in,out] xpSendMsgBuffer
+ *   Buffer receiving the answer.
+ * @param[in,out] xpSendMsgBufferSize
+ *   [in] Size of xpSendMsgBuffer.
+ *   [out] Size of the answer.
+ *
+ * @return
+ * - E_COMM_IF_STATUS_OK in case of success.
+ * - E_COMM_IF_STATUS_ERROR for other errors.
+ */
+static TCommIfStatus lLocalServerServe
+(
+  void*           xpArg,
+  const uint8_t*  xpRecvMsg,
+  size_t          xRecvSize,
+  uint8_t*        xpSendMsgBuffer,
+  size_t*         xpSendMsgBufferSize
+);
+
+/* -------------------------------------------------------------------------- */
+/* PUBLIC VARIABLES                                                           */
+/* -------------------------------------------------------------------------- */
+
+/* -------------------------------------------------------------------------- */
+/* PUBLIC FUNCTIONS - IMPLEMENTATION                                          */
+/* -------------------------------------------------------------------------- */
+/**
+ * @brief  implement ktaLocalServerInit
+ *
+ */
+/**
+ * SUPPRESS: MISRA_DEV_KTA_005 : misra_c2012_rule_15.4_violation
+ * SUPPRESS: MISRA_DEV_KTA_004 : misra_c2012_rule_15.1_violation
+ * Using goto for breaking during the error and return cases.
+ **/
+TKStatus ktaLocalServerInit
+(
+  const TKtaLocalServerConfig*  xpConfig
+)
+{
+  const uint8_t  aKsDosPk[C_KTA__KS_S_DOS_PK_SIZE] = C_KTA__KS_S_DOS_PK;
+  const uint8_t  aKsPk[C_KTA__KS_S_PK_SIZE] = C_KTA__KS_S_PK;
+  psa_key_id_t   ksDosKeyId = PSA_KEY_ID_NULL;
+  psa_key_id_t   ksKeyId = PSA_KEY_ID_NULL;
+  TKStatus       status = E_K_STATUS_ERROR;
+  size_t         index = 0;
+
+  C_KTA_APP__LOG("[INFO] ktaLocalServerInit Start\r\n");
+
+  if ((NULL == xpConfig) || (NULL == xpConfig->pKsDosSecretKey) ||
+      (NULL == xpConfig->pKsSecretKey) || (NULL == xpConfig->pL1SegSeed) ||
+      (NULL == xpConfig->pCommands) || (0u == xpConfig->commandCount))
+  {
+    C_KTA_APP__LOG("[ERROR] Invalid parameter\r\n");
+    status = E_K_STATUS_PARAMETER;
+    goto end;
+  }
+
+  for (index = 0; index < xpConfig->commandCount; index++)
+  {
+    const TKtaLocalServerCommand* pCommand = &xpConfig->pCommands[index];
+
+    if (((E_K_ICPP_PARSER_COMMAND_TAG_SET_OBJECT != pCommand->commandTag) &&
+         (E_K_ICPP_PARSER_COMMAND_TAG_GENERATE_KEY_PAIR != pCommand->commandTag) &&
+         (E_K_ICPP_PARSER_COMMAND_TAG_DELETE_OBJECT != pCommand->commandTag) &&
+         (E_K_ICPP_PARSER_CMD_TAG_DELETE_KEY_OBJECT != pCommand->commandTag)) ||
+        ((E_K_ICPP_PARSER_COMMAND_TAG_SET_OBJECT == pCommand->commandTag) &&
+         ((NULL == pCommand->pData) || (0u == pCommand->dataLen))) ||
+        ((NULL == pCommand->pAttributes) && (0u != pCommand->attributesLen)))
+    {
+      C_KTA_APP__LOG("[ERROR] Invalid command #%u\r\n", (unsigned int)index);
+      status = E_K_STATUS_PARAMETER;
+      goto end;
+    }
+  }
+
+  if (PSA_SUCCESS != psa_crypto_init())
+  {
+    C_KTA_APP__LOG("[ERROR] psa_crypto_init failed\r\n");
+    goto end;
+  }
+
+  status = lLocalServerImportSecretKey(xpConfig->pKsDosSecretKey, aKsDosPk, &ksDosKeyId);
+
+  if (E_K_STATUS_OK != status)
+  {
+    C_KTA_APP__LOG("[ERROR] keySTREAM DOS secret key rejected, status[%d]\r\n", status);
+    goto end;
+  }
+
+  status = lLocalServerImportSecretKey(xpConfig->pKsSecretKey, aKsPk, &ksKeyId);
+
+  if (E_K_STATUS_OK != status)
+  {
+    C_KTA_APP__LOG("[ERROR] keySTREAM secret key rejected, status[%d]\r\n", status);
+    goto end;
+  }
+
+  (void)pthread_mutex_lock(&gLocalServer.lock);
+
+  if (gLocalServer.isInitialized)
+  {
+    (void)pthread_mutex_unlock(&gLocalServer.lock);
+    C_KTA_APP__LOG("[ERROR] Local server already initialized\r\n");
+    status = E_K_STATUS_ERROR;
+    goto end;
+  }
+
+  (void)memset(gLocalServer.aSessions, 0, sizeof(gLocalServer.aSessions));
+  (void)memset(&gLocalServer.stats, 0, sizeof(gLocalServer.stats));
+  gLocalServer.config = *xpConfig;
+  (void)memcpy(gLocalServer.aL1SegSeed, xpConfig->pL1SegSeed, C_K__L1_SEGMENTATION_SEED_SIZE);
+
+  if (NULL != xpConfig->pChipPublicKey)
+  {
+    (void)memcpy(gLocalServer.aChipPublicKey, xpConfig->pChipPublicKey,
+                 C_K_KTA__PUBLIC_KEY_MAX_SIZE);
+  }
+
+  gLocalServer.ksDosKeyId = ksDosKeyId;
+  gLocalServer.ksKeyId = ksKeyId;
+  gLocalServer.uidCounter = 0;
+  gLocalServer.useCounter = 0;
+  gLocalServer.isInitialized = true;
+  (void)pthread_mutex_unlock(&gLocalServer.lock);
+
+  ksDosKeyId = PSA_KEY_ID_NULL;
+  ksKeyId = PSA_KEY_ID_NULL;
+
+end:
+  if (PSA_KEY_ID_NULL != ksDosKeyId)
+  {
+    (void)psa_destroy_key(ksDosKeyId);
+  }
+
+  if (PSA_KEY_ID_NULL != ksKeyId)
+  {
+    (void)psa_destroy_key(ksKeyId);
+  }
+
+  C_KTA_APP__LOG("[INFO] ktaLocalServerInit end, status[%d]\r\n", status);
+  return status;
+}
+
+/**
+ * @brief  implement ktaLocalServerExchange
+ *
+ */
+TKStatus ktaLocalServerExchange
+(
+  void*           xpArg,
+  const uint8_t*  xpRequest,
+  size_t          xRequestSize,
+  uint8_t*        xpResponse,
+  size_t*         xpResponseSize
+)
+{
+  uint32_t  cryptoVersion = 0;
+  size_t    headerLength = 0;
+  bool      isInitialized = false;
+  TKStatus  status = E_K_STATUS_ERROR;
+
+  (void)xpArg;
+  (void)pthread_mutex_lock(&gLocalServer.lock);
+  isInitialized = gLocalServer.isInitialized;
+  (void)pthread_mutex_unlock(&gLocalServer.lock);
+
+  if ((!isInitialized) || (NULL == xpRequest) || (NULL == xpResponse) ||
+      (NULL == xpResponseSize) ||
+      ((C_K_ICPP_PARSER__HEADER_SIZE + C_K_KTA__HMAC_MAX_SIZE) > xRequestSize) ||
+      (C_K__ICPP_MSG_MAX_SIZE < xRequestSize) ||
+      (C_KTA_LOCAL_SERVER__MIN_RESPONSE_SIZE > *xpResponseSize))
+  {
+    C_KTA_APP__LOG("[ERROR] Invalid parameter\r\n");
+    status = E_K_STATUS_PARAMETER;
+  }
+  else
+  {
+    cryptoVersion = (uint32_t)xpRequest[C_KTA_LOCAL_SERVER__MSG_TYPE_INDEX] >> 4u;
+    headerLength = ((size_t)xpRequest[C_KTA_LOCAL_SERVER__LENGTH_INDEX] << 8u) |
+                   xpRequest[C_KTA_LOCAL_SERVER__LENGTH_INDEX + 1u];
+
+    if ((C_K_ICPP_PARSER__HEADER_SIZE + headerLength) != xRequestSize)
+    {
+      C_KTA_APP__LOG("[ERROR] Header length %u mismatch\r\n", (unsigned int)headerLength);
+    }
+    else if ((uint32_t)E_K_ICPP_PARSER_CRYPTO_TYPE_DOS_BASED == cryptoVersion)
+    {
+      status = lLocalServerActivate(xpRequest, xRequestSize, xpResponse, xpResponseSize);
+    }
+    else if ((uint32_t)E_K_ICPP_PARSER_CRYPTO_TYPE_L2_BASED == cryptoVersion)
+    {
+      status = lLocalServerProceed(xpRequest, xRequestSize, xpResponse, xpResponseSize);
+    }
+    else
+    {
+      C_KTA_APP__LOG("[ERROR] Unsupported crypto version %u\r\n", (unsigned int)cryptoVersion);
+    }
+  }
+
+  if (E_K_STATUS_OK != status)
+  {
+    lLocalServerCount(&gLocalServer.stats.failures);
+  }
+
+  return status;
+}
+
+/**
+ * @brief  implement ktaLocalServerRun
+ *
+ */
+TKStatus ktaLocalServerRun
+(
+  uint16_t  xPort
+)
+{
+  TCommIfStatus  commStatus = E_COMM_IF_STATUS_ERROR;
+  bool           isInitialized = false;
+  TKStatus       status = E_K_STATUS_ERROR;
+
+  (void)pthread_mutex_lock(&gLocalServer.lock);
+  isInitialized = gLocalServer.isInitialized;
+  (void)pthread_mutex_unlock(&gLocalServer.lock);
+
+  if ((!isInitialized) || (0u == xPort))
+  {
+    C_KTA_APP__LOG("[ERROR] Invalid parameter\r\n");
+    status = E_K_STATUS_PARAMETER;
+  }
+  else
+  {
+    C_KTA_APP__LOG("[INFO] Local server listening on port %u\r\n", (unsigned int)xPort);
+    commStatus = commServe(xPort, lLocalServerServe, NULL);
+
+    if (E_COMM_IF_STATUS_OK == commStatus)
+    {
+      status = E_K_STATUS_OK;
+    }
+    else
+    {
+      C_KTA_APP__LOG("[ERROR] commServe failed, status[%d]\r\n", commStatus);
+      status = (E_COMM_IF_STATUS_PARAMETER == commStatus) ?
+               E_K_STATUS_PARAMETER : E_K_STATUS_ERROR;
+    }
+  }
+
+  return status;
+}
+
+/**
+ * @brief  implement ktaLocalServerStop
+ *
+ */
+TKStatus ktaLocalServerStop
+(
+  void
+)
+{
+  return (E_COMM_IF_STATUS_OK == commServeStop()) ? E_K_STATUS_OK : E_K_STATUS_ERROR;
+}
+
+/**
+ * @brief  implement ktaLocalServerGetStats
+ *
+ */
+TKStatus ktaLocalServerGetStats
+(
+  TKtaLocalServerStats*  xpStats
+)
+{
+  TKStatus  status = E_K_STATUS_PARAMETER;
+
+  if (NULL != xpStats)
+  {
+    (void)pthread_mutex_lock(&gLocalServer.lock);
+    *xpStats = gLocalServer.stats;
+    (void)pthread_mutex_unlock(&gLocalServer.lock);
+    status = E_K_STATUS_OK;
+  }
+
+  return status;
+}
+
+/**
+ * @brief  implement ktaLocalServerTerm
+ *
+ */
+TKStatus ktaLocalServerTerm
+(
+  void
+)
+{
+  TKStatus  status = E_K_STATUS_ERROR;
+  size_t    index = 0;
+
+  (void)pthread_mutex_lock(&gLocalServer.lock);
+
+  if (gLocalServer.isInitialized)
+  {
+    for (index = 0; index < C_KTA_LOCAL_SERVER__MAX_SESSIONS; index++)
+    {
+      lLocalServerDestroyKeys(&gLocalServer.aSessions[index]);
+      gLocalServer.aSessions[index].state = E_KTA_LOCAL_SERVER_SESSION_FREE;
+    }
+
+    (void)psa_destroy_key(gLocalServer.ksDosKeyId);
+    (void)psa_destroy_key(gLocalServer.ksKeyId);
+    gLocalServer.ksDosKeyId = PSA_KEY_ID_NULL;
+    gLocalServer.ksKeyId = PSA_KEY_ID_NULL;
+    gLocalServer.isInitialized = false;
+    status = E_K_STATUS_OK;
+  }
+
+  (void)pthread_mutex_unlock(&gLocalServer.lock);
+  return status;
+}
+
+/* -------------------------------------------------------------------------- */
+/* LOCAL FUNCTIONS - IMPLEMENTATION                                           */
+/* -------------------------------------------------------------------------- */
+/**
+ * @implements lLocalServerActivate
+ *
+ */
+/**
+ * SUPPRESS: MISRA_DEV_KTA_005 : misra_c2012_rule_15.4_violation
+ * SUPPRESS: MISRA_DEV_KTA_004 : misra_c2012_rule_15.1_violation
+ * Using goto for breaking during the error and return cases.
+ **/
+static TKStatus lLocalServerActivate
+(
+  const uint8_t*  xpRequest,
+  size_t          xRequestSize,
+  uint8_t*        xpResponse,
+  size_t*         xpResponseSize
+)
+{
+  const uint8_t            aActKeyFixInfo[C_KTA__ACT_KEY_FIXED_INFO_SIZE] =
+                             C_KTA__ACT_KEY_FIXED_INFO;
+  const uint8_t            aFieldKeySalt[C_KTA__FIELD_KEY_SALT_SIZE] = C_KTA__FIELD_KEY_SALT;
+  uint8_t                  aFieldKeyInfo[C_KTA__FIELD_KEY_FIXED_INFO_SIZE] =
+                             C_KTA__FIELD_KEY_FIXED_INFO;
+  TKIcppProtocolMessage    message;
+  TKIcppFieldList*         pFieldList = NULL;
+  const uint8_t*           pRotEpk = NULL;
+  TKtaLocalServerSession*  pSession = NULL;
+  uint8_t                  aChipPublicKey[C_K_KTA__PUBLIC_KEY_MAX_SIZE];
+  uint8_t                  aKsEpk[C_KTA_LOCAL_SERVER__PSA_PUBLIC_KEY_SIZE];
+  size_t                   ksEpkLen = 0;
+  uint8_t                  aSecret[2u * C_K_KTA__SHARED_SECRET_KEY_MAX_SIZE];
+  uint8_t                  aMac[C_K_KTA__HMAC_MAX_SIZE];
+  psa_key_attributes_t     keyAttr = PSA_KEY_ATTRIBUTES_INIT;
+  psa_key_id_t             ksEKeyId = PSA_KEY_ID_NULL;
+  size_t                   macOffset = xRequestSize - C_K_KTA__HMAC_MAX_SIZE;
+  TKStatus                 status = E_K_STATUS_ERROR;
+  size_t                   index = 0;
+
+  (void)memset(&message, 0, sizeof(message));
+
+  if ((macOffset == C_K_ICPP_PARSER__HEADER_SIZE) ||
+      (E_K_ICPP_PARSER_STATUS_OK !=
+       ktaIcppParserDeserializeCommands(&xpRequest[C_K_ICPP_PARSER__HEADER_SIZE],
+                                        macOffset - C_K_ICPP_PARSER__HEADER_SIZE,
+                                        &message)) ||
+      (0u == message.commandsCount) ||
+      (E_K_ICPP_PARSER_COMMAND_TAG_ACTIVATION != message.commands[0].commandTag))
+  {
+    C_KTA_APP__LOG("[ERROR] Invalid activation request\r\n");
+    goto end;
+  }
+
+  pFieldList = &message.commands[0].data.fieldList;
+
+  for (index = 0; index < pFieldList->fieldsCount; index++)
+  {
+    if ((E_K_ICPP_PARSER_FIELD_TAG_ROT_E_PK == pFieldList->fields[index].fieldTag) &&
+        (C_K_KTA__PUBLIC_KEY_MAX_SIZE == pFieldList->fields[index].fieldLen))
+    {
+      pRotEpk = pFieldList->fields[index].fieldValue;
+    }
+  }
+
+  if ((NULL == pRotEpk) ||
+      (E_K_STATUS_OK != lLocalServerGetChipPublicKey(&message.commands[0], aChipPublicKey)))
+  {
+    C_KTA_APP__LOG("[ERROR] rot_e_pk or chip public key missing\r\n");
+    goto end;
+  }
+
+  pSession = lLocalServerAcquire(&xpRequest[C_KTA_LOCAL_SERVER__ROT_ID_INDEX], true);
+
+  if (NULL == pSession)
+  {
+    C_KTA_APP__LOG("[ERROR] No session available\r\n");
+    goto end;
+  }
+
+  /* Activation L2 keys: HKDF(ECDH(ks_s_dos_sk, chip_pk), rot_e_pk, act fixed info). */
+  if ((E_K_STATUS_OK != lLocalServerEcdh(gLocalServer.ksDosKeyId, aChipPublicKey, aSecret)) ||
+      (E_K_STATUS_OK != lLocalServerDeriveKeys(aSecret, C_K_KTA__SHARED_SECRET_KEY_MAX_SIZE,
+                                               pRotEpk, C_K_KTA__PUBLIC_KEY_MAX_SIZE,
+                                               aActKeyFixInfo, C_KTA__ACT_KEY_FIXED_INFO_SIZE,
+                                               true, pSession)))
+  {
+    C_KTA_APP__LOG("[ERROR] Activation key derivation failed\r\n");
+    goto end;
+  }
+
+  if ((E_K_STATUS_OK != lLocalServerSign(pSession->authKeyId, xpRequest, macOffset, aMac)) ||
+      (0 != memcmp(aMac, &xpRequest[macOffset], C_K_KTA__HMAC_MAX_SIZE)))
+  {
+    C_KTA_APP__LOG("[ERROR] Activation request signature mismatch\r\n");
+    goto end;
+  }
+
+  /* keySTREAM ephemeral key pair, ks_e. */
+  psa_set_key_type(&keyAttr, PSA_KEY_TYPE_ECC_KEY_PAIR(PSA_ECC_FAMILY_SECP_R1));
+  psa_set_key_bits(&keyAttr, C_KTA_LOCAL_SERVER__ECC_KEY_BITS);
+  psa_set_key_usage_flags(&keyAttr, PSA_KEY_USAGE_DERIVE);
+  psa_set_key_algorithm(&keyAttr, PSA_ALG_ECDH);
+
+  if ((PSA_SUCCESS != psa_generate_key(&keyAttr, &ksEKeyId)) ||
+      (PSA_SUCCESS != psa_export_public_key(ksEKeyId, aKsEpk, sizeof(aKsEpk), &ksEpkLen)) ||
+      (C_KTA_LOCAL_SERVER__PSA_PUBLIC_KEY_SIZE != ksEpkLen))
+  {
+    C_KTA_APP__LOG("[ERROR] ks_e generation failed\r\n");
+    goto end;
+  }
+
+  message.commandsCount = 1;
+  message.commands[0].commandTag = E_K_ICPP_PARSER_COMMAND_TAG_ACTIVATION;
+  pFieldList->fieldsCount = 2;
+  pFieldList->fields[0].fieldTag = E_K_ICPP_PARSER_FIELD_TAG_ROT_PUBLIC_UID;
+  pFieldList->fields[0].fieldLen = C_K_ICPP_PARSER__ROT_PUBLIC_UID_SIZE_IN_BYTES;
+  pFieldList->fields[0].fieldValue = pSession->aRotPublicUid;
+  pFieldList->fields[1].fieldTag = E_K_ICPP_PARSER_FIELD_TAG_KS_E_PK;
+  pFieldList->fields[1].fieldLen = C_K_KTA__PUBLIC_KEY_MAX_SIZE;
+  pFieldList->fields[1].fieldValue = &aKsEpk[1];
+
+  if (E_K_STATUS_OK != lLocalServerBuildMessage(pSession,
+                                                (uint8_t)E_K_ICPP_PARSER_CRYPTO_TYPE_DOS_BASED,
+                                                &message, xpResponse, xpResponseSize))
+  {
+    C_KTA_APP__LOG("[ERROR] Activation response build failed\r\n");
+    goto end;
+  }
+
+  /* Field L2 keys: HKDF(ECDH(ks_e_sk, rot_e_pk) || ECDH(ks_s_sk, chip_pk), salt, info). */
+  (void)memcpy(&aFieldKeyInfo[C_KTA__FIELD_KEY_FIXED_INFO_L1SEGSEED_POS],
+               gLocalServer.aL1SegSeed, C_K__L1_SEGMENTATION_SEED_SIZE);
+
+  if ((E_K_STATUS_OK != lLocalServerEcdh(ksEKeyId, pRotEpk, aSecret)) ||
+      (E_K_STATUS_OK != lLocalServerEcdh(gLocalServer.ksKeyId, aChipPublicKey,
+                                         &aSecret[C_K_KTA__SHARED_SECRET_KEY_MAX_SIZE])) ||
+      (E_K_STATUS_OK != lLocalServerDeriveKeys(aSecret, sizeof(aSecret),
+                                               aFieldKeySalt, C_KTA__FIELD_KEY_SALT_SIZE,
+                                               aFieldKeyInfo, C_KTA__FIELD_KEY_FIXED_INFO_SIZE,
+                                               false, pSession)))
+  {
+    C_KTA_APP__LOG("[ERROR] Field key derivation failed\r\n");
+    goto end;
+  }
+
+  pSession->state = E_KTA_LOCAL_SERVER_SESSION_REGISTRATION;
+  pSession->nextCommand = 0;
+  pSession->pendingTag = 0;
+  lLocalServerCount(&gLocalServer.stats.activations);
+  status = E_K_STATUS_OK;
+
+end:
+  (void)memset(aSecret, 0, sizeof(aSecret));
+
+  if (PSA_KEY_ID_NULL != ksEKeyId)
+  {
+    (void)psa_destroy_key(ksEKeyId);
+  }
+
+  if (NULL != pSession)
+  {
+    if (E_K_STATUS_OK != status)
+    {
+      lLocalServerDestroyKeys(pSession);
+      pSession->state = E_KTA_LOCAL_SERVER_SESSION_FREE;
+    }
+
+    lLocalServerRelease(pSession);
+  }
+
+  return status;
+}
+
+/**
+ * @implements lLocalServerProceed
+ *
+ */
+/**
+ * SUPPRESS: MISRA_DEV_KTA_005 : misra_c2012_rule_15.4_violation
+ * SUPPRESS: MISRA_DEV_KTA_004 : misra_c2012_rule_15.1_violation
+ * Using goto for breaking during the error and return cases.
+ **/
+static TKStatus lLocalServerProceed
+(
+  const uint8_t*  xpRequest,
+  size_t          xRequestSize,
+  uint8_t*        xpResponse,
+  size_t*         xpResponseSize
+)
+{
+  TKIcppProtocolMessage    message;
+  TKtaLocalServerSession*  pSession = NULL;
+  uint8_t                  aPayload[C_K__ICPP_MSG_MAX_SIZE];
+  size_t                   payloadSize = 0;
+  uint8_t                  aIdentifier[C_KTA_LOCAL_SERVER__IDENTIFIER_SIZE];
+  uint32_t*                pCounter = NULL;
+  TKStatus                 status = E_K_STATUS_ERROR;
+
+  (void)memset(&message, 0, sizeof(message));
+  pSession = lLocalServerAcquire(&xpRequest[C_KTA_LOCAL_SERVER__ROT_ID_INDEX], false);
+
+  if (NULL == pSession)
+  {
+    C_KTA_APP__LOG("[ERROR] Unknown device\r\n");
+    goto end;
+  }
+
+  if ((E_K_STATUS_OK != lLocalServerOpenMessage(pSession, xpRequest, xRequestSize,
+                                                aPayload, &payloadSize)) ||
+      ((0u != payloadSize) &&
+       (E_K_ICPP_PARSER_STATUS_OK != ktaIcppParserDeserializeCommands(aPayload, payloadSize,
+                                                                      &message))))
+  {
+    C_KTA_APP__LOG("[ERROR] Invalid message\r\n");
+    goto end;
+  }
+
+  if (E_KTA_LOCAL_SERVER_SESSION_REGISTRATION == pSession->state)
+  {
+    if ((0u == message.commandsCount) ||
+        (E_K_ICPP_PARSER_COMMAND_TAG_REGISTERATION_INFO != message.commands[0].commandTag))
+    {
+      C_KTA_APP__LOG("[ERROR] Registration expected\r\n");
+      goto end;
+    }
+
+    pSession->state = E_KTA_LOCAL_SERVER_SESSION_PROVISIONING;
+    lLocalServerCount(&gLocalServer.stats.registrations);
+  }
+  else if ((0u != message.commandsCount) && (0u != pSession->pendingTag) &&
+           (pSession->pendingTag != (uint32_t)message.commands[0].commandTag))
+  {
+    C_KTA_APP__LOG("[ERROR] Response to 0x%02x expected\r\n", (unsigned int)pSession->pendingTag);
+    goto end;
+  }
+  else
+  {
+    /* Command response or NoOp notification. */
+  }
+
+  (void)memset(&message, 0, sizeof(message));
+  pSession->pendingTag = 0;
+
+  if ((E_KTA_LOCAL_SERVER_SESSION_PROVISIONING == pSession->state) &&
+      (pSession->nextCommand < gLocalServer.config.commandCount))
+  {
+    message.commandsCount = 1;
+    lLocalServerSetCommand(&gLocalServer.config.pCommands[pSession->nextCommand],
+                           aIdentifier, &message.commands[0]);
+    pSession->pendingTag = (uint32_t)message.commands[0].commandTag;
+    pSession->nextCommand++;
+    pCounter = &gLocalServer.stats.commands;
+  }
+  else
+  {
+    /* NoOp: header and MAC only. */
+    pSession->state = E_KTA_LOCAL_SERVER_SESSION_PROVISIONED;
+    pCounter = &gLocalServer.stats.noOps;
+  }
+
+  if (E_K_STATUS_OK != lLocalServerBuildMessage(pSession,
+                                                (uint8_t)E_K_ICPP_PARSER_CRYPTO_TYPE_L2_BASED,
+                                                &message, xpResponse, xpResponseSize))
+  {
+    C_KTA_APP__LOG("[ERROR] Response build failed\r\n");
+    goto end;
+  }
+
+  lLocalServerCount(pCounter);
+  status = E_K_STATUS_OK;
+
+end:
+  if (NULL != pSession)
+  {
+    lLocalServerRelease(pSession);
+  }
+
+  return status;
+}
+
+/**
+ * @implements lLocalServerAcquire
+ *
+ */
+static TKtaLocalServerSession* lLocalServerAcquire
+(
+  const uint8_t*  xpRotPublicUid,
+  bool            xIsActivation
+)
+{
+  const uint8_t            aRotSolId[C_KTA__ROT_SOL_ID_SIZE] = C_KTA__ROT_SOL_ID;
+  uint8_t                  aRotPublicUid[C_K_ICPP_PARSER__ROT_PUBLIC_UID_SIZE_IN_BYTES] = {0};
+  TKtaLocalServerSession*  pSession = NULL;
+  TKtaLocalServerSession*  pCandidate = NULL;
+  bool                     isNewDevice = true;
+  size_t                   index = 0;
+
+  (void)pthread_mutex_lock(&gLocalServer.lock);
+
+  for (index = C_KTA__ROT_SOL_ID_SIZE; index < sizeof(aRotPublicUid); index++)
+  {
+    if (0u != xpRotPublicUid[index])
+    {
+      isNewDevice = false;
+    }
+  }
+
+  if (xIsActivation && isNewDevice)
+  {
+    /* Sol id, two reserved bytes then a device number. */
+    gLocalServer.uidCounter++;
+    (void)memcpy(aRotPublicUid, aRotSolId, C_KTA__ROT_SOL_ID_SIZE);
+    aRotPublicUid[C_KTA_LOCAL_SERVER__UID_COUNTER_POS] = (uint8_t)(gLocalServer.uidCounter >> 24u);
+    aRotPublicUid[C_KTA_LOCAL_SERVER__UID_COUNTER_POS + 1u] =
+      (uint8_t)(gLocalServer.uidCounter >> 16u);
+    aRotPublicUid[C_KTA_LOCAL_SERVER__UID_COUNTER_POS + 2u] =
+      (uint8_t)(gLocalServer.uidCounter >> 8u);
+    aRotPublicUid[C_KTA_LOCAL_SERVER__UID_COUNTER_POS + 3u] = (uint8_t)gLocalServer.uidCounter;
+  }
+  else
+  {
+    (void)memcpy(aRotPublicUid, xpRotPublicUid, sizeof(aRotPublicUid));
+  }
+
+  for (index = 0; index < C_KTA_LOCAL_SERVER__MAX_SESSIONS; index++)
+  {
+    TKtaLocalServerSession* pCurrent = &gLocalServer.aSessions[index];
+
+    if ((E_KTA_LOCAL_SERVER_SESSION_FREE != pCurrent->state) &&
+        (0 == memcmp(pCurrent->aRotPublicUid, aRotPublicUid, sizeof(aRotPublicUid))))
+    {
+      pSession = pCurrent->isBusy ? NULL : pCurrent;
+      pCandidate = NULL;
+      break;
+    }
+
+    if (xIsActivation && (!pCurrent->isBusy) &&
+        ((NULL == pCandidate) ||
+         ((E_KTA_LOCAL_SERVER_SESSION_FREE != pCandidate->state) &&
+          ((E_KTA_LOCAL_SERVER_SESSION_FREE == pCurrent->state) ||
+           (pCurrent->lastUse < pCandidate->lastUse)))))
+    {
+      /* Free slot first, least recently used otherwise. */
+      pCandidate = pCurrent;
+    }
+  }
+
+  if (NULL != pCandidate)
+  {
+    pSession = pCandidate;
+  }
+
+  if (NULL != pSession)
+  {
+    pSession->isBusy = true;
+    (void)memcpy(pSession->aRotPublicUid, aRotPublicUid, sizeof(aRotPublicUid));
+  }
+
+  (void)pthread_mutex_unlock(&gLocalServer.lock);
+  return pSession;
+}
+
+/**
+ * @implements lLocalServerRelease
+ *
+ */
+static void lLocalServerRelease
+(
+  TKtaLocalServerSession*  xpSession
+)
+{
+  (void)pthread_mutex_lock(&gLocalServer.lock);
+  gLocalServer.useCounter++;
+  xpSession->lastUse = gLocalServer.useCounter;
+  xpSession->isBusy = false;
+  (void)pthread_mutex_unlock(&gLocalServer.lock);
+}
+
+/**
+ * @implements lLocalServerDestroyKeys
+ *
+ */
+static void lLocalServerDestroyKeys
+(
+  TKtaLocalServerSession*  xpSession
+)
+{
+  if (PSA_KEY_ID_NULL != xpSession->encKeyId)
+  {
+    (void)psa_destroy_key(xpSession->encKeyId);
+    xpSession->encKeyId = PSA_KEY_ID_NULL;
+  }
+
+  if (PSA_KEY_ID_NULL != xpSession->authKeyId)
+  {
+    (void)psa_destroy_key(xpSession->authKeyId);
+    xpSession->authKeyId = PSA_KEY_ID_NULL;
+  }
+}
+
+/**
+ * @implements lLocalServerCount
+ *
+ */
+static void lLocalServerCount
+(
+  uint32_t*  xpCounter
+)
+{
+  (void)pthread_mutex_lock(&gLocalServer.lock);
+  (*xpCounter)++;
+  (void)pthread_mutex_unlock(&gLocalServer.lock);
+}
+
+/**
+ * @implements lLocalServerImportSecretKey
+ *
+ */
+static TKStatus lLocalServerImportSecretKey
+(
+  const uint8_t*  xpSecretKey,
+  const uint8_t*  xpExpectedPublicKey,
+  psa_key_id_t*   xpKeyId
+)
+{
+  psa_key_attributes_t  keyAttr = PSA_KEY_ATTRIBUTES_INIT;
+  uint8_t               aPublicKey[C_KTA_LOCAL_SERVER__PSA_PUBLIC_KEY_SIZE];
+  size_t                publicKeyLen = 0;
+  TKStatus              status = E_K_STATUS_ERROR;
+
+  *xpKeyId = PSA_KEY_ID_NULL;
+  psa_set_key_type(&keyAttr, PSA_KEY_TYPE_ECC_KEY_PAIR(PSA_ECC_FAMILY_SECP_R1));
+  psa_set_key_bits(&keyAttr, C_KTA_LOCAL_SERVER__ECC_KEY_BITS);
+  psa_set_key_usage_flags(&keyAttr, PSA_KEY_USAGE_DERIVE);
+  psa_set_key_algorithm(&keyAttr, PSA_ALG_ECDH);
+
+  if ((PSA_SUCCESS == psa_import_key(&keyAttr, xpSecretKey,
+                                     C_KTA_LOCAL_SERVER__SECRET_KEY_SIZE, xpKeyId)) &&
+      (PSA_SUCCESS == psa_export_public_key(*xpKeyId, aPublicKey, sizeof(aPublicKey),
+                                            &publicKeyLen)))
+  {
+    status = ((sizeof(aPublicKey) == publicKeyLen) &&
+              (0 == memcmp(&aPublicKey[1], xpExpectedPublicKey, C_K_KTA__PUBLIC_KEY_MAX_SIZE))) ?
+             E_K_STATUS_OK : E_K_STATUS_PARAMETER;
+  }
+
+  if ((E_K_STATUS_OK != status) && (PSA_KEY_ID_NULL != *xpKeyId))
+  {
+    (void)psa_destroy_key(*xpKeyId);
+    *xpKeyId = PSA_KEY_ID_NULL;
+  }
+
+  return status;
+}
+
+/**
+ * @implements lLocalServerGetChipPublicKey
+ *
+ */
+static TKStatus lLocalServerGetChipPublicKey
+(
+  const TKIcppCommand*  xpCommand,
+  uint8_t*              xpChipPublicKey
+)
+{
+  /* Challenge claim, EAT nonce (10) or PSA challenge (-75008), holding a 64 byte string. */
+  const uint8_t           aEatNonce[] = { 0x0Au, 0x58u, 0x40u };
+  const uint8_t           aPsaChallenge[] = { 0x3Au, 0x00u, 0x01u, 0x24u, 0xFFu, 0x58u, 0x40u };
+  const TKIcppFieldList*  pFieldList = &xpCommand->data.fieldList;
+  TKStatus                status = E_K_STATUS_ERROR;
+  size_t                  field = 0;
+  size_t                  pos = 0;
+
+  if (NULL != gLocalServer.config.pChipPublicKey)
+  {
+    (void)memcpy(xpChipPublicKey, gLocalServer.aChipPublicKey, C_K_KTA__PUBLIC_KEY_MAX_SIZE);
+    status = E_K_STATUS_OK;
+  }
+
+  for (field = 0; (field < pFieldList->fieldsCount) && (E_K_STATUS_OK != status); field++)
+  {
+    const uint8_t* pValue = pFieldList->fields[field].fieldValue;
+    size_t         valueLen = pFieldList->fields[field].fieldLen;
+
+    for (pos = 0; (pos < valueLen) && (E_K_STATUS_OK != status); pos++)
+    {
+      size_t prefixLen = 0;
+
+      if (((valueLen - pos) >= (sizeof(aPsaChallenge) + C_K_KTA__PUBLIC_KEY_MAX_SIZE)) &&
+          (0 == memcmp(&pValue[pos], aPsaChallenge, sizeof(aPsaChallenge))))
+      {
+        prefixLen = sizeof(aPsaChallenge);
+      }
+      else if (((valueLen - pos) >= (sizeof(aEatNonce) + C_K_KTA__PUBLIC_KEY_MAX_SIZE)) &&
+               (0 == memcmp(&pValue[pos], aEatNonce, sizeof(aEatNonce))))
+      {
+        prefixLen = sizeof(aEatNonce);
+      }
+      else
+      {
+        /* Not a challenge claim. */
+      }
+
+      if (0u != prefixLen)
+      {
+        (void)memcpy(xpChipPublicKey, &pValue[pos + prefixLen], C_K_KTA__PUBLIC_KEY_MAX_SIZE);
+        status = E_K_STATUS_OK;
+      }
+    }
+  }
+
+  return status;
+}
+
+/**
+ * @implements lLocalServerEcdh
+ *
+ */
+static TKStatus lLocalServerEcdh
+(
+  psa_key_id_t    xKeyId,
+  const uint8_t*  xpPeerPublicKey,
+  uint8_t*        xpSharedSecret
+)
+{
+  uint8_t  aPeerKey[C_KTA_LOCAL_SERVER__PSA_PUBLIC_KEY_SIZE];
+  size_t   outputLen = 0;
+
+  aPeerKey[0] = 0x04u;
+  (void)memcpy(&aPeerKey[1], xpPeerPublicKey, C_K_KTA__PUBLIC_KEY_MAX_SIZE);
+
+  return ((PSA_SUCCESS == psa_raw_key_agreement(PSA_ALG_ECDH, xKeyId,
+                                                aPeerKey, sizeof(aPeerKey),
+                                                xpSharedSecret,
+                                                C_K_KTA__SHARED_SECRET_KEY_MAX_SIZE,
+                                                &outputLen)) &&
+          (C_K_KTA__SHARED_SECRET_KEY_MAX_SIZE == outputLen)) ? E_K_STATUS_OK : E_K_STATUS_ERROR;
+}
+
+/**
+ * @implements lLocalServerDeriveKeys
+ *
+ */
+/**
+ * SUPPRESS: MISRA_DEV_KTA_005 : misra_c2012_rule_15.4_violation
+ * SUPPRESS: MISRA_DEV_KTA_004 : misra_c2012_rule_15.1_violation
+ * Using goto for breaking during the error and return cases.
+ **/
+static TKStatus lLocalServerDeriveKeys
+(
+  const uint8_t*           xpSecret,
+  size_t                   xSecretLen,
+  const uint8_t*           xpSalt,
+  size_t                   xSaltLen,
+  const uint8_t*           xpInfo,
+  size_t                   xInfoLen,
+  bool                     xIsActivation,
+  TKtaLocalServerSession*  xpSession
+)
+{
+  const uint8_t                aActEncInput[C_KTA__ACT_L2_ENC_INPUT_DATA_SIZE] =
+                                 C_KTA__ACT_L2_ENC_INPUT_DATA;
+  const uint8_t                aActAuthInput[C_KTA__ACT_L2_AUTH_INPUT_DATA_SIZE] =
+                                 C_KTA__ACT_L2_AUTH_INPUT_DATA;
+  const uint8_t                aFieldEncInput[C_KTA__FIELD_L2_ENC_INPUT_DATA_SIZE] =
+                                 C_KTA__FIELD_L2_ENC_INPUT_DATA;
+  const uint8_t                aFieldAuthInput[C_KTA__FIELD_L2_AUTH_IN_DATA_SIZE] =
+                                 C_KTA__FIELD_L2_AUTH_INPUT_DATA;
+  psa_key_derivation_operation_t operation = PSA_KEY_DERIVATION_OPERATION_INIT;
+  psa_key_attributes_t         keyAttr = PSA_KEY_ATTRIBUTES_INIT;
+  psa_key_id_t                 secretKeyId = PSA_KEY_ID_NULL;
+  psa_key_id_t                 l1KeyId = PSA_KEY_ID_NULL;
+  uint8_t                      aL2Key[C_KTA_LOCAL_SERVER__SHA256_SIZE];
+  size_t                       l2KeyLen = 0;
+  TKStatus                     status = E_K_STATUS_ERROR;
+
+  lLocalServerDestroyKeys(xpSession);
+
+  /* L1 key, HMAC-SHA256 key out of HKDF-SHA256. */
+  psa_set_key_usage_flags(&keyAttr, PSA_KEY_USAGE_DERIVE);
+  psa_set_key_algorithm(&keyAttr, PSA_ALG_HKDF(PSA_ALG_SHA_256));
+  psa_set_key_type(&keyAttr, PSA_KEY_TYPE_DERIVE);
+
+  if ((PSA_SUCCESS != psa_import_key(&keyAttr, xpSecret, xSecretLen, &secretKeyId)) ||
+      (PSA_SUCCESS != psa_key_derivation_setup(&operation, PSA_ALG_HKDF(PSA_ALG_SHA_256))) ||
+      (PSA_SUCCESS != psa_key_derivation_input_bytes(&operation, PSA_KEY_DERIVATION_INPUT_SALT,
+                                                     xpSalt, xSaltLen)) ||
+      (PSA_SUCCESS != psa_key_derivation_input_key(&operation, PSA_KEY_DERIVATION_INPUT_SECRET,
+                                                   secretKeyId)) ||
+      (PSA_SUCCESS != psa_key_derivation_input_bytes(&operation, PSA_KEY_DERIVATION_INPUT_INFO,
+                                                     xpInfo, xInfoLen)))
+  {
+    goto end;
+  }
+
+  keyAttr = psa_key_attributes_init();
+  psa_set_key_usage_flags(&keyAttr, PSA_KEY_USAGE_SIGN_MESSAGE);
+  psa_set_key_algorithm(&keyAttr, PSA_ALG_HMAC(PSA_ALG_SHA_256));
+  psa_set_key_type(&keyAttr, PSA_KEY_TYPE_HMAC);
+  psa_set_key_bits(&keyAttr, C_KTA_LOCAL_SERVER__L1_KEY_BITS);
+
+  if (PSA_SUCCESS != psa_key_derivation_output_key(&keyAttr, &operation, &l1KeyId))
+  {
+    goto end;
+  }
+
+  /* L2 encryption key, AES-128-CBC. */
+  keyAttr = psa_key_attributes_init();
+  psa_set_key_type(&keyAttr, PSA_KEY_TYPE_AES);
+  psa_set_key_bits(&keyAttr, C_KTA_LOCAL_SERVER__L2_KEY_SIZE * 8u);
+  psa_set_key_usage_flags(&keyAttr, PSA_KEY_USAGE_ENCRYPT | PSA_KEY_USAGE_DECRYPT);
+  psa_set_key_algorithm(&keyAttr, PSA_ALG_CBC_NO_PADDING);
+
+  if ((PSA_SUCCESS != psa_mac_compute(l1KeyId, PSA_ALG_HMAC(PSA_ALG_SHA_256),
+                                      xIsActivation ? aActEncInput : aFieldEncInput,
+                                      xIsActivation ? sizeof(aActEncInput) :
+                                                      sizeof(aFieldEncInput),
+                                      aL2Key, sizeof(aL2Key), &l2KeyLen)) ||
+      (PSA_SUCCESS != psa_import_key(&keyAttr, aL2Key, C_KTA_LOCAL_SERVER__L2_KEY_SIZE,
+                                     &xpSession->encKeyId)))
+  {
+    goto end;
+  }
+
+  /* L2 authentication key, HMAC-SHA256 truncated to C_K_KTA__HMAC_MAX_SIZE. */
+  keyAttr = psa_key_attributes_init();
+  psa_set_key_type(&keyAttr, PSA_KEY_TYPE_HMAC);
+  psa_set_key_bits(&keyAttr, C_KTA_LOCAL_SERVER__L2_KEY_SIZE * 8u);
+  psa_set_key_usage_flags(&keyAttr, PSA_KEY_USAGE_SIGN_MESSAGE | PSA_KEY_USAGE_VERIFY_MESSAGE);
+  psa_set_key_algorithm(&keyAttr, PSA_ALG_HMAC(PSA_ALG_SHA_256));
+
+  if ((PSA_SUCCESS != psa_mac_compute(l1KeyId, PSA_ALG_HMAC(PSA_ALG_SHA_256),
+                                      xIsActivation ? aActAuthInput : aFieldAuthInput,
+                                      xIsActivation ? sizeof(aActAuthInput) :
+                                                      sizeof(aFieldAuthInput),
+                                      aL2Key, sizeof(aL2Key), &l2KeyLen)) ||
+      (PSA_SUCCESS != psa_import_key(&keyAttr, aL2Key, C_KTA_LOCAL_SERVER__L2_KEY_SIZE,
+                                     &xpSession->authKeyId)))
+  {
+    goto end;
+  }
+
+  status = E_K_STATUS_OK;
+
+end:
+  (void)memset(aL2Key, 0, sizeof(aL2Key));
+  (void)psa_key_derivation_abort(&operation);
+
+  if (PSA_KEY_ID_NULL != secretKeyId)
+  {
+    (void)psa_destroy_key(secretKeyId);
+  }
+
+  if (PSA_KEY_ID_NULL != l1KeyId)
+  {
+    (void)psa_destroy_key(l1KeyId);
+  }
+
+  if (E_K_STATUS_OK != status)
+  {
+    lLocalServerDestroyKeys(xpSession);
+  }
+
+  return status;
+}
+
+/**
+ * @implements lLocalServerSign
+ *
+ */
+static TKStatus lLocalServerSign
+(
+  psa_key_id_t    xKeyId,
+  const uint8_t*  xpData,
+  size_t          xDataLen,
+  uint8_t*        xpMac
+)
+{
+  uint8_t   aMac[C_KTA_LOCAL_SERVER__SHA256_SIZE];
+  size_t    macLen = 0;
+  TKStatus  status = E_K_STATUS_ERROR;
+
+  if (PSA_SUCCESS == psa_mac_compute(xKeyId, PSA_ALG_HMAC(PSA_ALG_SHA_256), xpData, xDataLen,
+                                     aMac, sizeof(aMac), &macLen))
+  {
+    (void)memcpy(xpMac, aMac, C_K_KTA__HMAC_MAX_SIZE);
+    status = E_K_STATUS_OK;
+  }
+
+  return status;
+}
+
+/**
+ * @implements lLocalServerCipher
+ *
+ */
+static TKStatus lLocalServerCipher
+(
+  psa_key_id_t    xKeyId,
+  bool            xIsEncrypt,
+  const uint8_t*  xpInput,
+  size_t          xInputLen,
+  uint8_t*        xpOutput
+)
+{
+  psa_cipher_operation_t  operation = PSA_CIPHER_OPERATION_INIT;
+  psa_status_t            psaStatus = PSA_ERROR_GENERIC_ERROR;
+  size_t                  outputLen = 0;
+  size_t                  finishLen = 0;
+
+  psaStatus = xIsEncrypt ?
+              psa_cipher_encrypt_setup(&operation, xKeyId, PSA_ALG_CBC_NO_PADDING) :
+              psa_cipher_decrypt_setup(&operation, xKeyId, PSA_ALG_CBC_NO_PADDING);
+
+  if (PSA_SUCCESS == psaStatus)
+  {
+    psaStatus = psa_cipher_set_iv(&operation, gaLocalServerIv, sizeof(gaLocalServerIv));
+  }
+
+  if (PSA_SUCCESS == psaStatus)
+  {
+    psaStatus = psa_cipher_update(&operation, xpInput, xInputLen, xpOutput, xInputLen,
+                                  &outputLen);
+  }
+
+  if (PSA_SUCCESS == psaStatus)
+  {
+    psaStatus = psa_cipher_finish(&operation, &xpOutput[outputLen], xInputLen - outputLen,
+                                  &finishLen);
+  }
+
+  (void)psa_cipher_abort(&operation);
+
+  return (PSA_SUCCESS == psaStatus) ? E_K_STATUS_OK : E_K_STATUS_ERROR;
+}
+
+/**
+ * @implements lLocalServerOpenMessage
+ *
+ */
+static TKStatus lLocalServerOpenMessage
+(
+  const TKtaLocalServerSession*  xpSession,
+  const uint8_t*                 xpRequest,
+  size_t                         xRequestSize,
+  uint8_t*                       xpPayload,
+  size_t*                        xpPayloadSize
+)
+{
+  uint8_t   aMac[C_K_KTA__HMAC_MAX_SIZE];
+  uint8_t   difference = 0;
+  size_t    macOffset = xRequestSize - C_K_KTA__HMAC_MAX_SIZE;
+  size_t    cipherLen = macOffset - C_K_ICPP_PARSER__HEADER_SIZE;
+  TKStatus  status = E_K_STATUS_ERROR;
+  size_t    index = 0;
+
+  if (E_K_STATUS_OK == lLocalServerSign(xpSession->authKeyId, xpRequest, macOffset, aMac))
+  {
+    for (index = 0; index < C_K_KTA__HMAC_MAX_SIZE; index++)
+    {
+      difference |= aMac[index] ^ xpRequest[macOffset + index];
+    }
+
+    status = (0u == difference) ? E_K_STATUS_OK : E_K_STATUS_ERROR;
+  }
+
+  *xpPayloadSize = 0;
+
+  if ((E_K_STATUS_OK == status) && (0u != cipherLen))
+  {
+    status = E_K_STATUS_ERROR;
+
+    if ((0u == (cipherLen % C_K_CRYPTO__AES_BLOCK_SIZE)) &&
+        (E_K_STATUS_OK == lLocalServerCipher(xpSession->encKeyId, false,
+                                             &xpRequest[C_K_ICPP_PARSER__HEADER_SIZE],
+                                             cipherLen, xpPayload)))
+    {
+      *xpPayloadSize = cipherLen;
+      status = ktacipherRemovePadding(xpPayload, xpPayloadSize);
+    }
+  }
+
+  return status;
+}
+
+/**
+ * @implements lLocalServerBuildMessage
+ *
+ */
+static TKStatus lLocalServerBuildMessage
+(
+  const TKtaLocalServerSession*  xpSession,
+  uint8_t                        xCryptoVersion,
+  TKIcppProtocolMessage*         xpMessage,
+  uint8_t*                       xpResponse,
+  size_t*                        xpResponseSize
+)
+{
+  uint8_t   aMessage[C_K__ICPP_MSG_MAX_SIZE];
+  size_t    messageSize = sizeof(aMessage) - C_K_CRYPTO__AES_BLOCK_SIZE - C_K_KTA__HMAC_MAX_SIZE;
+  size_t    payloadSize = 0;
+  TKStatus  status = E_K_STATUS_ERROR;
+
+  xpMessage->cryptoVersion = xCryptoVersion;
+  xpMessage->encMode = (uint8_t)E_K_ICPP_PARSER_FULL_ENC_MODE;
+  xpMessage->msgType = E_K_ICPP_PARSER_MESSAGE_TYPE_COMMAND;
+  (void)memcpy(xpMessage->rotPublicUID, xpSession->aRotPublicUid,
+               C_K_ICPP_PARSER__ROT_PUBLIC_UID_SIZE_IN_BYTES);
+  xpMessage->rotKeySetId = gLocalServer.config.rotKeySetId;
+
+  if ((PSA_SUCCESS != psa_generate_random(xpMessage->transactionId,
+                                          C_K_ICPP_PARSER__TRANSACTION_ID_SIZE_IN_BYTES)) ||
+      (E_K_ICPP_PARSER_STATUS_OK != ktaIcppParserSerializeMessage(xpMessage, aMessage,
+                                                                  &messageSize)))
+  {
+    C_KTA_APP__LOG("[ERROR] Serialization failed\r\n");
+    goto end;
+  }
+
+  payloadSize = messageSize - C_K_ICPP_PARSER__HEADER_SIZE;
+
+  if (0u != payloadSize)
+  {
+    messageSize = sizeof(aMessage) - C_K_ICPP_PARSER__HEADER_SIZE - C_K_KTA__HMAC_MAX_SIZE;
+
+    if (E_K_STATUS_OK != ktacipherAddPadding(&aMessage[C_K_ICPP_PARSER__HEADER_SIZE],
+                                             payloadSize,
+                                             &aMessage[C_K_ICPP_PARSER__HEADER_SIZE],
+                                             &messageSize))
+    {
+      goto end;
+    }
+
+    payloadSize = messageSize;
+  }
+
+  if ((C_K_ICPP_PARSER__HEADER_SIZE + payloadSize + C_K_KTA__HMAC_MAX_SIZE) > *xpResponseSize)
+  {
+    C_KTA_APP__LOG("[ERROR] Response buffer too small\r\n");
+    goto end;
+  }
+
+  (void)memcpy(xpResponse, aMessage, C_K_ICPP_PARSER__HEADER_SIZE);
+
+  if ((E_K_ICPP_PARSER_STATUS_OK !=
+       ktaIcppParserSetHeaderLength(xpResponse, payloadSize + C_K_KTA__HMAC_MAX_SIZE)) ||
+      ((0u != payloadSize) &&
+       (E_K_STATUS_OK != lLocalServerCipher(xpSession->encKeyId, true,
+                                            &aMessage[C_K_ICPP_PARSER__HEADER_SIZE],
+                                            payloadSize,
+                                            &xpResponse[C_K_ICPP_PARSER__HEADER_SIZE]))) ||
+      (E_K_STATUS_OK != lLocalServerSign(xpSession->authKeyId, xpResponse,
+                                         C_K_ICPP_PARSER__HEADER_SIZE + payloadSize,
+                                         &xpResponse[C_K_ICPP_PARSER__HEADER_SIZE +
+                                                     payloadSize])))
+  {
+    goto end;
+  }
+
+  *xpResponseSize = C_K_ICPP_PARSER__HEADER_SIZE + payloadSize + C_K_KTA__HMAC_MAX_SIZE;
+  status = E_K_STATUS_OK;
+
+end:
+  return status;
+}
+
+/**
+ * @implements lLocalServerSetCommand
+ *
+ */
+static void lLocalServerSetCommand
+(
+  const TKtaLocalServerCommand*  xpConfigCommand,
+  uint8_t*                       xpIdentifier,
+  TKIcppCommand*                 xpCommand
+)
+{
+  TKIcppFieldList*  pFieldList = &xpCommand->data.fieldList;
+  size_t            fieldPos = 0;
+
+  xpIdentifier[0] = (uint8_t)(xpConfigCommand->identifier >> 24u);
+  xpIdentifier[1] = (uint8_t)(xpConfigCommand->identifier >> 16u);
+  xpIdentifier[2] = (uint8_t)(xpConfigCommand->identifier >> 8u);
+  xpIdentifier[3] = (uint8_t)xpConfigCommand->identifier;
+
+  xpCommand->commandTag = (TKIcppCommandTag)xpConfigCommand->commandTag;
+  pFieldList->fields[fieldPos].fieldTag = E_K_ICPP_PARSER_FLD_TAG_CMD_IDENTIFIER;
+  pFieldList->fields[fieldPos].fieldLen = C_KTA_LOCAL_SERVER__IDENTIFIER_SIZE;
+  pFieldList->fields[fieldPos].fieldValue = xpIdentifier;
+  fieldPos++;
+
+  if ((E_K_ICPP_PARSER_COMMAND_TAG_SET_OBJECT == xpConfigCommand->commandTag) ||
+      (E_K_ICPP_PARSER_COMMAND_TAG_DELETE_OBJECT == xpConfigCommand->commandTag))
+  {
+    pFieldList->fields[fieldPos].fieldTag = E_K_ICPP_PARSER_FIELD_TAG_CMD_OBJECT_TYPE;
+    pFieldList->fields[fieldPos].fieldLen = sizeof(xpConfigCommand->objectType);
+    pFieldList->fields[fieldPos].fieldValue = (uint8_t*)&xpConfigCommand->objectType;
+    fieldPos++;
+  }
+
+  if (0u != xpConfigCommand->attributesLen)
+  {
+    pFieldList->fields[fieldPos].fieldTag = E_K_ICPP_PARSER_FIELD_TAG_CMD_ATTRIBUTES;
+    pFieldList->fields[fieldPos].fieldLen = xpConfigCommand->attributesLen;
+    pFieldList->fields[fieldPos].fieldValue = (uint8_t*)xpConfigCommand->pAttributes;
+    fieldPos++;
+  }
+
+  if (0u != xpConfigCommand->dataLen)
+  {
+    pFieldList->fields[fieldPos].fieldTag = E_K_ICPP_PARSER_FLD_TAG_CMD_DATA;
+    pFieldList->fields[fieldPos].fieldLen = xpConfigCommand->dataLen;
+    pFieldList->fields[fieldPos].fieldValue = (uint8_t*)xpConfigCommand->pData;
+    fieldPos++;
+  }
+
+  pFieldList->fieldsCount = fieldPos;
+}
+
+/**
+ * @implements lLocalServerServe
+ *
+ */
+static TCommIfStatus lLocalServerServe
+(
+  void*           xpArg,
+  const uint8_t*  xpRecvMsg,
+  size_t          xRecvSize,
+  uint8_t*        xpSendMsgBuffer,
+  size_t*         xpSendMsgBufferSize
+)
+{
+  return (E_K_STATUS_OK == ktaLocalServerExchange(xpArg, xpRecvMsg, xRecvSize,
+                                                  xpSendMsgBuffer, xpSendMsgBufferSize)) ?
+         E_COMM_IF_STATUS_OK : E_COMM_IF_STATUS_ERROR;
+}
+
+#endif /* LOCAL_SERVER_FEATURE */
+
+/* -------------------------------------------------------------------------- */
+/* END OF FILE                                                                */
+/* -------------------------------------------------------------------------- */
@@ -0,0 +1,262 @@
+/*******************************************************************************
+*************************keySTREAM Trusted Agent ("KTA")************************
+
+* (c) 2023-2025 Nagravision Sàrl
+
+* Subject to your compliance with these terms, you may use the Nagravision Sàrl
+* Software and any derivatives exclusively with Nagravision's products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may accompany
+* Nagravision Software.
+
+* Redistribution of this Nagravision Software in source or binary form is allowed
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+
+* THIS SOFTWARE IS SUPPLIED BY NAGRAVISION "AS IS". NO WARRANTIES, WHETHER EXPRESS,
+* IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF
+* NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE. IN NO
+* EVENT WILL NAGRAVISION BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL
+* OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF NAGRAVISION HAS BEEN ADVISED OF THE
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW,
+* NAGRAVISION 'S TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS
+* SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY
+* TO NAGRAVISION FOR THIS SOFTWARE.
+********************************************************************************/
+/** \brief  keySTREAM Trusted Agent - Loopback keySTREAM stand-in.
+ *
+ *  \author Kudelski IoT
+ *
+ *  \date 2026/10/17
+ *
+ *  \file ktaLocalServer.h
+ ******************************************************************************/
+
+/**
+ * @brief     Interface apis for the local keySTREAM stand-in server.
+ * @ingroup   g_kta_hook
+ */
+/** @addtogroup g_kta_hook
+ * @{
+ */
+
+#ifndef K_KTA_LOCAL_SERVER_H
+#define K_KTA_LOCAL_SERVER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* C++ */
+
+/* --------------------------------------------------------------------------------------------- */
+/* IMPORTS                                                                                       */
+/* --------------------------------------------------------------------------------------------- */
+#include <stddef.h>
+#include <stdint.h>
+#include "k_defs.h"
+#include "k_kta.h"
+
+#ifdef LOCAL_SERVER_FEATURE
+/* --------------------------------------------------------------------------------------------- */
+/* CONSTANTS, TYPES, ENUM                                                                        */
+/* --------------------------------------------------------------------------------------------- */
+/** @brief Maximum number of devices tracked at a time, the least recently used is evicted. */
+#define C_KTA_LOCAL_SERVER__MAX_SESSIONS         (64u)
+
+/** @brief Size of a keySTREAM secret key (secp256r1 scalar), in bytes. */
+#define C_KTA_LOCAL_SERVER__SECRET_KEY_SIZE      (32u)
+
+/** @brief Object management command pushed to every registered device. */
+typedef struct
+{
+  uint8_t         commandTag;
+  /* E_K_ICPP_PARSER_COMMAND_TAG_SET_OBJECT, E_K_ICPP_PARSER_COMMAND_TAG_GENERATE_KEY_PAIR,
+     E_K_ICPP_PARSER_COMMAND_TAG_DELETE_OBJECT or E_K_ICPP_PARSER_CMD_TAG_DELETE_KEY_OBJECT. */
+  uint32_t        identifier;
+  /* Object identifier. */
+  uint8_t         objectType;
+  /* Object type, sent for SET_OBJECT and DELETE_OBJECT. */
+  const uint8_t*  pAttributes;
+  /* Optional object attributes, may be NULL. */
+  size_t          attributesLen;
+  /* Length of pAttributes. */
+  const uint8_t*  pData;
+  /* Object data, mandatory for SET_OBJECT. */
+  size_t          dataLen;
+  /* Length of pData. */
+} TKtaLocalServerCommand;
+
+/** @brief Local server configuration. */
+typedef struct
+{
+  const uint8_t*                 pKsDosSecretKey;
+  /* Secret key matching C_KTA__KS_S_DOS_PK, C_KTA_LOCAL_SERVER__SECRET_KEY_SIZE bytes. */
+  const uint8_t*                 pKsSecretKey;
+  /* Secret key matching C_KTA__KS_S_PK, C_KTA_LOCAL_SERVER__SECRET_KEY_SIZE bytes. */
+  const uint8_t*                 pChipPublicKey;
+  /* Chip public key (x || y), C_K_KTA__PUBLIC_KEY_MAX_SIZE bytes. If NULL, it is read from
+     the attestation token sent in the activation request. */
+  const uint8_t*                 pL1SegSeed;
+  /* L1 segmentation seed given to the devices, C_K__L1_SEGMENTATION_SEED_SIZE bytes. */
+  uint8_t                        rotKeySetId;
+  /* Rot key set id sent to the devices. */
+  const TKtaLocalServerCommand*  pCommands;
+  /* Commands pushed to each device after registration, one per message. */
+  size_t                         commandCount;
+  /* Number of commands, at least 1. */
+} TKtaLocalServerConfig;
+
+/** @brief Local server counters. */
+typedef struct
+{
+  uint32_t  activations;
+  /* Activation requests answered. */
+  uint32_t  registrations;
+  /* Registration requests answered. */
+  uint32_t  commands;
+  /* Object management commands pushed. */
+  uint32_t  noOps;
+  /* NoOp messages sent, one per provisioned device. */
+  uint32_t  failures;
+  /* Rejected messages. */
+} TKtaLocalServerStats;
+
+/* --------------------------------------------------------------------------------------------- */
+/* VARIABLES                                                                                     */
+/* --------------------------------------------------------------------------------------------- */
+
+/* --------------------------------------------------------------------------------------------- */
+/* FUNCTIONS                                                                                     */
+/* --------------------------------------------------------------------------------------------- */
+/**
+ * @ingroup g_kta_hook
+ * @brief
+ *   Initialize the local server.
+ *   The secret keys are checked against the keySTREAM public keys the keySTREAM Trusted Agent
+ *   is built with. Configuration buffers must stay valid until ktaLocalServerTerm().
+ *
+ * @param[in] xpConfig
+ *   Server configuration.
+ *   Should not be NULL.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_PARAMETER for wrong input parameter(s) or keys not matching cryptoConfig.h.
+ * - E_K_STATUS_ERROR for other errors.
+ */
+TKStatus ktaLocalServerInit
+(
+  const TKtaLocalServerConfig*  xpConfig
+);
+
+/**
+ * @ingroup g_kta_hook
+ * @brief
+ *   Answer one ICPP message sent by a keySTREAM Trusted Agent.
+ *   Activation requests get the keySTREAM ephemeral key, registration requests and command
+ *   responses get the next configured command, a NoOp is sent once all commands are done.
+ *   Matches TKtaFleetExchange, so that it can be used as an in-process transport.
+ *
+ * @param[in] xpArg
+ *   Unused.
+ * @param[in] xpRequest
+ *   Message sent by the device.
+ * @param[in] xRequestSize
+ *   Size of xpRequest, in bytes.
+ * @param[in,out] xpResponse
+ *   Buffer receiving the answer.
+ * @param[in,out] xpResponseSize
+ *   [in] Size of xpResponse.
+ *   [out] Size of the answer.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_PARAMETER for wrong input parameter(s).
+ * - E_K_STATUS_ERROR for other errors.
+ */
+TKStatus ktaLocalServerExchange
+(
+  void*           xpArg,
+  const uint8_t*  xpRequest,
+  size_t          xRequestSize,
+  uint8_t*        xpResponse,
+  size_t*         xpResponseSize
+);
+
+/**
+ * @ingroup g_kta_hook
+ * @brief
+ *   Serve devices on the loopback interface with the linked communication stack,
+ *   until ktaLocalServerStop() is called.
+ *
+ * @param[in] xPort
+ *   Port to listen on.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_PARAMETER for wrong input parameter(s).
+ * - E_K_STATUS_ERROR for other errors.
+ */
+TKStatus ktaLocalServerRun
+(
+  uint16_t  xPort
+);
+
+/**
+ * @ingroup g_kta_hook
+ * @brief
+ *   Make ktaLocalServerRun() return. Can be called from any thread.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_ERROR for other errors.
+ */
+TKStatus ktaLocalServerStop
+(
+  void
+);
+
+/**
+ * @ingroup g_kta_hook
+ * @brief
+ *   Get the local server counters.
+ *
+ * @param[out] xpStats
+ *   Counters since ktaLocalServerInit().
+ *   Should not be NULL.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_PARAMETER for wrong input parameter(s).
+ */
+TKStatus ktaLocalServerGetStats
+(
+  TKtaLocalServerStats*  xpStats
+);
+
+/**
+ * @ingroup g_kta_hook
+ * @brief
+ *   Release the keys and sessions of the local server.
+ *
+ * @return
+ * - E_K_STATUS_OK in case of success.
+ * - E_K_STATUS_ERROR for other errors.
+ */
+TKStatus ktaLocalServerTerm
+(
+  void
+);
+#endif /* LOCAL_SERVER_FEATURE */
+
+#ifdef __cplusplus
+}
+#endif /* C++ */
+
+/** @} g_kta_hook */
+
+#endif // K_KTA_LOCAL_SERVER_H
+
+/* -------------------------------------------------------------------------- */
+/* END OF FILE                                                                */
+/* -------------------------------------------------------------------------- */